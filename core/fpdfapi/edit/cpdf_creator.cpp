@@ -12,28 +12,38 @@
 #include <array>
 #include <map>
 #include <set>
+#include <sstream>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/edit/cpdf_fontsubsetter.h"
+#include "core/fpdfapi/edit/cpdf_parallelstreamencoder.h"
+#include "core/fpdfapi/edit/cpdf_stringarchivestream.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_crypto_handler.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_encryptor.h"
 #include "core/fpdfapi/parser/cpdf_flateencoder.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fpdfapi/parser/cpdf_reference.h"
 #include "core/fpdfapi/parser/cpdf_security_handler.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fpdfapi/parser/object_tree_traversal_util.h"
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/check_op.h"
 #include "core/fxcrt/containers/contains.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fixed_size_data_vector.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_random.h"
 #include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/fx_string_wrappers.h"
 #include "core/fxcrt/mask.h"
 #include "core/fxcrt/raw_span.h"
 #include "core/fxcrt/span_util.h"
@@ -43,11 +53,23 @@ namespace {
 
 const size_t kArchiveBufferSize = 32768;
 
+// When saving with several threads, at most this many objects wait for the
+// streams before them to be encoded.
+constexpr size_t kMaxPendingObjects = 4096;
+
+// Saving uses at most this many threads, even on machines with more.
+constexpr size_t kMaxThreadCount = 64;
+
+// Object streams hold up to this many objects. Larger streams compress a little
+// better, but a reader must decompress the whole stream to get at any object.
+constexpr size_t kMaxObjectsPerObjectStream = 100;
+
 constexpr Mask<CPDF_Creator::CreateFlags> kAllValidFlags{
     CPDF_Creator::CreateFlags::kIncremental,
     CPDF_Creator::CreateFlags::kNoOriginal,
     CPDF_Creator::CreateFlags::kRemoveSecurity,
-    CPDF_Creator::CreateFlags::kSubsetNewFonts};
+    CPDF_Creator::CreateFlags::kSubsetNewFonts,
+    CPDF_Creator::CreateFlags::kCompressObjects};
 constexpr Mask<CPDF_Creator::CreateFlags> kConflictingFlags{
     CPDF_Creator::CreateFlags::kIncremental,
     CPDF_Creator::CreateFlags::kNoOriginal};
@@ -119,8 +141,63 @@ bool OutputIndex(IFX_ArchiveStream* archive, FX_FILESIZE offset) {
          archive->WriteByte(0);
 }
 
+// Appends `value` to `dest` as a big-endian field of `width` bytes.
+void AppendField(DataVector<uint8_t>& dest, uint64_t value, int width) {
+  for (int i = width - 1; i >= 0; --i) {
+    dest.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
 }  // namespace
 
+// Collects non-stream objects, to be written together as one compressed
+// object stream. See ISO 32000-1:2008 section 7.5.7.
+class CPDF_Creator::ObjectStream {
+ public:
+  ObjectStream() : archive_(&data_) {}
+  ~ObjectStream() = default;
+
+  bool empty() const { return objnums_.empty(); }
+  bool IsFull() const { return objnums_.size() >= kMaxObjectsPerObjectStream; }
+  const std::vector<uint32_t>& objnums() const { return objnums_; }
+
+  bool Add(uint32_t objnum, const CPDF_Object* obj) {
+    objnums_.push_back(objnum);
+    offsets_.push_back(static_cast<size_t>(data_.tellp()));
+    // Objects in object streams are encrypted along with the whole stream, so
+    // they are written without an encryptor.
+    return obj->WriteTo(&archive_, nullptr) && archive_.WriteString("\n");
+  }
+
+  // Returns the object stream for the objects added so far, and starts over.
+  RetainPtr<CPDF_Stream> Take(CPDF_Document* doc) {
+    fxcrt::ostringstream header;
+    for (size_t i = 0; i < objnums_.size(); ++i) {
+      header << objnums_[i] << " " << offsets_[i] << " ";
+    }
+    const fxcrt::string header_str = header.str();
+    const fxcrt::string data_str = data_.str();
+    DataVector<uint8_t> data(header_str.begin(), header_str.end());
+    data.insert(data.end(), data_str.begin(), data_str.end());
+
+    auto dict = doc->New<CPDF_Dictionary>();
+    dict->SetNewFor<CPDF_Name>("Type", "ObjStm");
+    dict->SetNewFor<CPDF_Number>("N", static_cast<int>(objnums_.size()));
+    dict->SetNewFor<CPDF_Number>("First", static_cast<int>(header_str.size()));
+
+    objnums_.clear();
+    offsets_.clear();
+    data_.str("");
+    return pdfium::MakeRetain<CPDF_Stream>(std::move(data), std::move(dict));
+  }
+
+ private:
+  fxcrt::ostringstream data_;
+  CPDF_StringArchiveStream archive_;
+  std::vector<uint32_t> objnums_;
+  std::vector<size_t> offsets_;
+};
+
 CPDF_Creator::CPDF_Creator(CPDF_Document* doc,
                            RetainPtr<IFX_RetainableWriteStream> archive)
     : document_(doc),
@@ -132,6 +209,27 @@ CPDF_Creator::CPDF_Creator(CPDF_Document* doc,
 
 CPDF_Creator::~CPDF_Creator() = default;
 
+void CPDF_Creator::SetThreadCount(size_t thread_count) {
+  // hardware_concurrency() returns 0 when it cannot tell.
+  size_t max_thread_count = std::thread::hardware_concurrency();
+  if (max_thread_count == 0 || max_thread_count > kMaxThreadCount) {
+    max_thread_count = kMaxThreadCount;
+  }
+  thread_count_ = std::clamp<size_t>(thread_count, 1, max_thread_count);
+}
+
+CPDF_Creator::PendingObject::PendingObject(uint32_t objnum,
+                                           RetainPtr<const CPDF_Object> obj,
+                                           bool encoded_ahead)
+    : objnum(objnum), obj(std::move(obj)), encoded_ahead(encoded_ahead) {}
+
+CPDF_Creator::PendingObject::PendingObject(PendingObject&&) noexcept = default;
+
+CPDF_Creator::PendingObject& CPDF_Creator::PendingObject::operator=(
+    PendingObject&&) noexcept = default;
+
+CPDF_Creator::PendingObject::~PendingObject() = default;
+
 bool CPDF_Creator::WriteIndirectObj(uint32_t objnum, const CPDF_Object* pObj) {
   if (!archive_->WriteDWord(objnum) || !archive_->WriteString(" 0 obj\r\n")) {
     return false;
@@ -154,15 +252,12 @@ bool CPDF_Creator::WriteOldIndirectObject(uint32_t objnum) {
     return true;
   }
 
-  object_offsets_[objnum] = archive_->CurrentOffset();
-
   bool bExistInMap = !!document_->GetIndirectObject(objnum);
   RetainPtr<CPDF_Object> pObj = document_->GetOrParseIndirectObject(objnum);
   if (!pObj) {
-    object_offsets_.erase(objnum);
     return true;
   }
-  if (!WriteIndirectObj(pObj->GetObjNum(), pObj.Get())) {
+  if (!WriteObject(pObj->GetObjNum(), pObj.Get())) {
     return false;
   }
   if (!bExistInMap) {
@@ -213,26 +308,213 @@ bool CPDF_Creator::WriteNewObjs() {
       continue;
     }
 
-    object_offsets_[objnum] = archive_->CurrentOffset();
-
     auto it = font_obj_overrides.find(objnum);
     const CPDF_Object* obj_to_write =
         it != font_obj_overrides.end() ? it->second.Get() : obj.Get();
-    if (!WriteIndirectObj(objnum, obj_to_write)) {
+    if (!WriteObject(objnum, obj_to_write)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CPDF_Creator::WriteObject(uint32_t objnum, const CPDF_Object* obj) {
+  // Streams, and the encryption dictionary, cannot go in object streams.
+  const bool is_encrypt_dict =
+      encrypt_dict_ &&
+      (obj == encrypt_dict_ || objnum == encrypt_dict_->GetObjNum());
+  if (!object_stream_ || obj->IsStream() || is_encrypt_dict) {
+    return WriteIndirectObjInOrder(objnum, obj);
+  }
+
+  if (!object_stream_->Add(objnum, obj)) {
+    return false;
+  }
+  return !object_stream_->IsFull() || FlushObjectStream();
+}
+
+bool CPDF_Creator::FlushObjectStream() {
+  if (!object_stream_ || object_stream_->empty()) {
+    return true;
+  }
+
+  const uint32_t stream_objnum = next_object_stream_num_++;
+  const std::vector<uint32_t>& objnums = object_stream_->objnums();
+  for (size_t i = 0; i < objnums.size(); ++i) {
+    compressed_objects_[objnums[i]] = {stream_objnum,
+                                       static_cast<uint32_t>(i)};
+  }
+  RetainPtr<CPDF_Stream> stream = object_stream_->Take(document_);
+  return WriteIndirectObjInOrder(stream_objnum, stream.Get());
+}
+
+bool CPDF_Creator::WriteIndirectObjInOrder(uint32_t objnum,
+                                           const CPDF_Object* obj) {
+  if (!stream_encoder_) {
+    object_offsets_[objnum] = archive_->CurrentOffset();
+    return WriteIndirectObj(objnum, obj);
+  }
+
+  const CPDF_Stream* stream = obj->AsStream();
+  const bool encode_ahead =
+      stream && CPDF_ParallelStreamEncoder::CanEncode(stream);
+  if (encode_ahead) {
+    stream_encoder_->Submit(objnum, pdfium::WrapRetain(stream));
+  }
+  pending_objects_.emplace_back(objnum, pdfium::WrapRetain(obj),
+                                encode_ahead);
+  while (stream_encoder_->IsFull() ||
+         pending_objects_.size() > kMaxPendingObjects) {
+    if (!WritePendingObject()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CPDF_Creator::WritePendingObject() {
+  PendingObject pending = std::move(pending_objects_.front());
+  pending_objects_.pop_front();
+  object_offsets_[pending.objnum] = archive_->CurrentOffset();
+  if (!pending.encoded_ahead) {
+    return WriteIndirectObj(pending.objnum, pending.obj.Get());
+  }
+
+  std::unique_ptr<CPDF_FlateEncoder> encoder = stream_encoder_->TakeNext();
+  if (!archive_->WriteDWord(pending.objnum) ||
+      !archive_->WriteString(" 0 obj\r\n")) {
+    return false;
+  }
+
+  std::unique_ptr<CPDF_Encryptor> encryptor;
+  if (GetCryptoHandler()) {
+    encryptor =
+        std::make_unique<CPDF_Encryptor>(GetCryptoHandler(), pending.objnum);
+  }
+  return encoder->WriteStreamTo(archive_.get(), encryptor.get(),
+                                /*encrypt_data=*/true) &&
+         archive_->WriteString("\r\nendobj\r\n");
+}
+
+bool CPDF_Creator::WritePendingObjects() {
+  while (!pending_objects_.empty()) {
+    if (!WritePendingObject()) {
       return false;
     }
   }
   return true;
 }
 
+bool CPDF_Creator::WriteXRefStream() {
+  // The cross reference stream is the last object, and has an entry of its
+  // own.
+  const uint32_t xref_objnum = last_obj_num_ + 1;
+  object_offsets_[xref_objnum] = xref_start_;
+  const uint32_t size = xref_objnum + 1;
+
+  // The second field holds offsets and object stream numbers. Use as few
+  // bytes as they need.
+  const uint64_t max_field = std::max<uint64_t>(xref_start_, size);
+  int field_width = 1;
+  while (field_width < 8 && (max_field >> (8 * field_width)) != 0) {
+    ++field_width;
+  }
+
+  DataVector<uint8_t> entries;
+  entries.reserve(size * (field_width + 3));
+  for (uint32_t objnum = 0; objnum < size; ++objnum) {
+    auto offset_it = object_offsets_.find(objnum);
+    if (offset_it != object_offsets_.end()) {
+      AppendField(entries, 1, 1);
+      AppendField(entries, offset_it->second, field_width);
+      AppendField(entries, 0, 2);
+      continue;
+    }
+    auto compressed_it = compressed_objects_.find(objnum);
+    if (compressed_it != compressed_objects_.end()) {
+      AppendField(entries, 2, 1);
+      AppendField(entries, compressed_it->second.stream_objnum, field_width);
+      AppendField(entries, compressed_it->second.index, 2);
+      continue;
+    }
+    AppendField(entries, 0, 1);
+    AppendField(entries, 0, field_width);
+    AppendField(entries, objnum == 0 ? 0xFFFF : 0, 2);
+  }
+
+  auto dict = document_->New<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Name>("Type", "XRef");
+  dict->SetNewFor<CPDF_Number>("Size", static_cast<int>(size));
+  auto widths = dict->SetNewFor<CPDF_Array>("W");
+  widths->AppendNew<CPDF_Number>(1);
+  widths->AppendNew<CPDF_Number>(field_width);
+  widths->AppendNew<CPDF_Number>(2);
+  if (parser_) {
+    CPDF_DictionaryLocker locker(parser_->GetCombinedTrailer());
+    for (const auto& it : locker) {
+      const ByteString& key = it.first;
+      if (key == "Encrypt" || key == "Size" || key == "Filter" ||
+          key == "Index" || key == "Length" || key == "Prev" || key == "W" ||
+          key == "XRefStm" || key == "ID" || key == "DecodeParms" ||
+          key == "Type") {
+        continue;
+      }
+      dict->SetFor(key, it.second->Clone());
+    }
+  } else {
+    dict->SetNewFor<CPDF_Reference>("Root", document_,
+                                    document_->GetRoot()->GetObjNum());
+    if (document_->GetInfo()) {
+      dict->SetNewFor<CPDF_Reference>("Info", document_,
+                                      document_->GetInfo()->GetObjNum());
+    }
+  }
+  if (encrypt_dict_) {
+    uint32_t encrypt_objnum = encrypt_dict_->GetObjNum();
+    if (encrypt_objnum == 0) {
+      encrypt_objnum = last_obj_num_;
+    }
+    dict->SetNewFor<CPDF_Reference>("Encrypt", document_, encrypt_objnum);
+  }
+  if (id_array_) {
+    dict->SetFor("ID", id_array_->Clone());
+  }
+
+  // Cross reference streams are never encrypted.
+  auto stream =
+      pdfium::MakeRetain<CPDF_Stream>(std::move(entries), std::move(dict));
+  return archive_->WriteDWord(xref_objnum) &&
+         archive_->WriteString(" 0 obj\r\n") &&
+         stream->WriteTo(archive_.get(), nullptr) &&
+         archive_->WriteString("\r\nendobj\r\n");
+}
+
+bool CPDF_Creator::WriteStartXRef() {
+  return archive_->WriteString("\r\nstartxref\r\n") &&
+         archive_->WriteFilesize(xref_start_) &&
+         archive_->WriteString("\r\n%%EOF\r\n");
+}
+
 void CPDF_Creator::InitNewObjNumOffsets() {
+  if (is_incremental_) {
+    // Only objects changed since loading need to be appended, which saves
+    // looking at the rest of the document. Deleted objects are left as they
+    // are in the original.
+    for (uint32_t objnum : document_->GetChangedObjNums()) {
+      if (document_->GetIndirectObject(objnum)) {
+        new_obj_num_array_.push_back(objnum);
+      }
+    }
+    return;
+  }
+
   for (const auto& pair : *document_) {
     const uint32_t objnum = pair.first;
     if (pair.second->GetObjNum() == CPDF_Object::kInvalidObjNum) {
       continue;
     }
 
-    if (!is_incremental_ && parser_ && parser_->IsValidObjectNumber(objnum) &&
+    if (parser_ && parser_->IsValidObjectNumber(objnum) &&
         !parser_->IsObjectFree(objnum)) {
       continue;
     }
@@ -247,6 +529,19 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage1() {
     if (!parser_ || (security_changed_ && is_original_)) {
       is_incremental_ = false;
     }
+    // Incremental updates keep the cross reference format of the original.
+    if (is_incremental_) {
+      compress_objects_ = false;
+    }
+    if (compress_objects_) {
+      object_stream_ = std::make_unique<ObjectStream>();
+      next_object_stream_num_ = document_->GetLastObjNum() + 1;
+    }
+    if (thread_count_ > 1) {
+      stream_encoder_ = std::make_unique<CPDF_ParallelStreamEncoder>(
+          thread_count_ - 1, GetCryptoHandler(),
+          CPDF_ParallelStreamEncoder::kDefaultMemoryBudget);
+    }
 
     stage_ = Stage::kWriteHeader10;
   }
@@ -262,6 +557,10 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage1() {
       } else if (parser_) {
         version = parser_->GetFileVersion();
       }
+      // Object streams and cross reference streams need PDF 1.5.
+      if (compress_objects_ && version % 10 < 5) {
+        version = 15;
+      }
 
       if (!archive_->WriteDWord(version % 10) ||
           !archive_->WriteString("\r\n%\xA1\xB3\xC5\xD7\r\n")) {
@@ -317,9 +616,12 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage2() {
     stage_ = Stage::kWriteNewObjs26;
   }
   if (stage_ == Stage::kWriteNewObjs26) {
-    if (!WriteNewObjs()) {
+    if (!WriteNewObjs() || !FlushObjectStream() || !WritePendingObjects()) {
       return Stage::kInvalid;
     }
+    if (next_object_stream_num_ > document_->GetLastObjNum() + 1) {
+      last_obj_num_ = std::max(last_obj_num_, next_object_stream_num_ - 1);
+    }
 
     stage_ = Stage::kWriteEncryptDict27;
   }
@@ -347,8 +649,18 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage3() {
 
   uint32_t dwLastObjNum = last_obj_num_;
   if (stage_ == Stage::kInitWriteXRefs80) {
+    if (is_incremental_ && new_obj_num_array_.empty() &&
+        parser_->GetLastXRefOffset() != 0) {
+      // Nothing changed, so the original is complete as it is. An update
+      // section would need at least one cross reference entry.
+      stage_ = Stage::kComplete100;
+      return stage_;
+    }
     xref_start_ = archive_->CurrentOffset();
-    if (!is_incremental_ || !parser_->IsXRefStream()) {
+    if (compress_objects_) {
+      // The cross reference stream is written along with the trailer.
+      stage_ = Stage::kWriteTrailerAndFinish90;
+    } else if (!is_incremental_ || !parser_->IsXRefStream()) {
       if (!is_incremental_ || parser_->GetLastXRefOffset() == 0) {
         ByteString str;
         str = pdfium::Contains(object_offsets_, 1)
@@ -456,6 +768,14 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage3() {
 CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage4() {
   DCHECK_GE(stage_, Stage::kWriteTrailerAndFinish90);
 
+  if (compress_objects_) {
+    if (!WriteXRefStream() || !WriteStartXRef()) {
+      return Stage::kInvalid;
+    }
+    stage_ = Stage::kComplete100;
+    return stage_;
+  }
+
   bool bXRefStream = is_incremental_ && parser_->IsXRefStream();
   if (!bXRefStream) {
     if (!archive_->WriteString("trailer\r\n<<")) {
@@ -592,9 +912,7 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage4() {
     }
   }
 
-  if (!archive_->WriteString("\r\nstartxref\r\n") ||
-      !archive_->WriteFilesize(xref_start_) ||
-      !archive_->WriteString("\r\n%%EOF\r\n")) {
+  if (!WriteStartXRef()) {
     return Stage::kInvalid;
   }
 
@@ -619,6 +937,7 @@ bool CPDF_Creator::Create(Mask<CreateFlags> flags, int32_t file_version) {
   is_incremental_ = !!(flags & CreateFlags::kIncremental);
   is_original_ = !(flags & CreateFlags::kNoOriginal);
   subset_new_fonts_ = !!(flags & CreateFlags::kSubsetNewFonts);
+  compress_objects_ = !!(flags & CreateFlags::kCompressObjects);
 
   if (file_version >= 10 && file_version <= 17) {
     file_version_ = file_version;
@@ -627,6 +946,7 @@ bool CPDF_Creator::Create(Mask<CreateFlags> flags, int32_t file_version) {
   stage_ = Stage::kInit0;
   last_obj_num_ = document_->GetLastObjNum();
   object_offsets_.clear();
+  compressed_objects_.clear();
   new_obj_num_array_.clear();
 
   InitID();
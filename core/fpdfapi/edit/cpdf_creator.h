@@ -7,8 +7,10 @@
 #ifndef CORE_FPDFAPI_EDIT_CPDF_CREATOR_H_
 #define CORE_FPDFAPI_EDIT_CPDF_CREATOR_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <deque>
 #include <map>
 #include <memory>
 #include <vector>
@@ -24,6 +26,7 @@ class CPDF_SecurityHandler;
 class CPDF_Dictionary;
 class CPDF_Document;
 class CPDF_Object;
+class CPDF_ParallelStreamEncoder;
 class CPDF_Parser;
 
 class CPDF_Creator {
@@ -35,15 +38,45 @@ class CPDF_Creator {
     kRemoveSecurityDeprecated = 3,
     kRemoveSecurity = (1 << 2),
     kSubsetNewFonts = (1 << 3),
+    kCompressObjects = (1 << 4),
   };
 
   CPDF_Creator(CPDF_Document* doc,
                RetainPtr<IFX_RetainableWriteStream> archive);
   ~CPDF_Creator();
 
+  // Sets the maximum number of threads to save with, including the calling
+  // thread. With more than one, stream data is compressed on the other
+  // threads. The output does not depend on the number of threads. Counts
+  // above the number of hardware threads, or above 64, are reduced to that.
+  void SetThreadCount(size_t thread_count);
+
   bool Create(Mask<CreateFlags> flags, int32_t file_version);
 
  private:
+  class ObjectStream;
+
+  // Where an object written into an object stream is.
+  struct CompressedObjectPosition {
+    uint32_t stream_objnum;
+    uint32_t index;
+  };
+
+  // An object waiting to be written while streams before it are encoded.
+  struct PendingObject {
+    PendingObject(uint32_t objnum,
+                  RetainPtr<const CPDF_Object> obj,
+                  bool encoded_ahead);
+    PendingObject(PendingObject&&) noexcept;
+    PendingObject& operator=(PendingObject&&) noexcept;
+    ~PendingObject();
+
+    uint32_t objnum;
+    RetainPtr<const CPDF_Object> obj;
+    // Whether `stream_encoder_` has the data of `obj`.
+    bool encoded_ahead;
+  };
+
   enum class Stage {
     kInvalid = -1,
     kInit0 = 0,
@@ -76,6 +109,18 @@ class CPDF_Creator {
   bool WriteOldObjs();
   bool WriteNewObjs();
   bool WriteIndirectObj(uint32_t objnum, const CPDF_Object* pObj);
+  // Writes `obj` as indirect object `objnum` and records its offset. When
+  // saving with several threads, it may be queued and written later instead,
+  // after the objects queued before it.
+  bool WriteIndirectObjInOrder(uint32_t objnum, const CPDF_Object* obj);
+  bool WritePendingObject();
+  bool WritePendingObjects();
+  // Writes `obj` as indirect object `objnum`, or adds it to the pending object
+  // stream when compressing objects.
+  bool WriteObject(uint32_t objnum, const CPDF_Object* obj);
+  bool FlushObjectStream();
+  bool WriteXRefStream();
+  bool WriteStartXRef();
 
   void RemoveSecurity();
 
@@ -93,6 +138,9 @@ class CPDF_Creator {
   uint32_t cur_obj_num_ = 0;
   FX_FILESIZE xref_start_ = 0;
   std::map<uint32_t, FX_FILESIZE> object_offsets_;
+  std::map<uint32_t, CompressedObjectPosition> compressed_objects_;
+  std::unique_ptr<ObjectStream> object_stream_;
+  uint32_t next_object_stream_num_ = 0;
   std::vector<uint32_t> new_obj_num_array_;  // Sorted, ascending.
   RetainPtr<CPDF_Array> id_array_;
   int32_t file_version_ = 0;
@@ -100,6 +148,11 @@ class CPDF_Creator {
   bool is_incremental_ = false;
   bool is_original_ = false;
   bool subset_new_fonts_ = false;
+  bool compress_objects_ = false;
+  size_t thread_count_ = 1;
+  std::deque<PendingObject> pending_objects_;
+  // Destroyed first, as its workers use the crypto handler.
+  std::unique_ptr<CPDF_ParallelStreamEncoder> stream_encoder_;
 };
 
 #endif  // CORE_FPDFAPI_EDIT_CPDF_CREATOR_H_
@@ -0,0 +1,222 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/edit/cpdf_objectdeduplicator.h"
+
+#include <optional>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "core/fpdfapi/edit/cpdf_stringarchivestream.h"
+#include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_reference.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_stream_acc.h"
+#include "core/fpdfapi/parser/object_tree_traversal_util.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/fx_string_wrappers.h"
+#include "core/fxcrt/retain_ptr.h"
+
+namespace {
+
+// Types of dictionaries that page resources commonly share, and that are
+// safe to share between pages of different origin.
+constexpr const char* kMergeableDictTypes[] = {"Encoding", "ExtGState", "Font",
+                                               "FontDescriptor"};
+
+bool IsMergeableDict(const CPDF_Dictionary* dict) {
+  const ByteString type = dict->GetNameFor("Type");
+  for (const char* mergeable_type : kMergeableDictTypes) {
+    if (type == mergeable_type) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Only objects that saving the document writes out matter. This also keeps
+// duplicates removed by an earlier pass from coming back from the parser.
+std::vector<std::pair<uint32_t, RetainPtr<CPDF_Object>>> GetObjects(
+    CPDF_Document* doc) {
+  std::vector<std::pair<uint32_t, RetainPtr<CPDF_Object>>> objects;
+  for (uint32_t objnum : GetObjectsWithReferences(doc)) {
+    RetainPtr<CPDF_Object> obj = doc->GetOrParseIndirectObject(objnum);
+    if (obj) {
+      objects.emplace_back(objnum, std::move(obj));
+    }
+  }
+  return objects;
+}
+
+// Returns the object number that `obj` has to refer to instead, or 0 if `obj`
+// is not a reference to a removed duplicate.
+uint32_t GetReplacement(const CPDF_Object* obj,
+                        const std::map<uint32_t, uint32_t>& replacements) {
+  const CPDF_Reference* reference = obj->AsReference();
+  if (!reference) {
+    return 0;
+  }
+  auto it = replacements.find(reference->GetRefObjNum());
+  return it != replacements.end() ? it->second : 0;
+}
+
+}  // namespace
+
+CPDF_ObjectDeduplicator::CPDF_ObjectDeduplicator(CPDF_Document* doc)
+    : doc_(doc) {}
+
+CPDF_ObjectDeduplicator::~CPDF_ObjectDeduplicator() = default;
+
+CPDF_ObjectDeduplicator::Result CPDF_ObjectDeduplicator::Deduplicate() {
+  // Merging objects can make the objects that refer to them identical, so
+  // repeat until nothing changes.
+  Result result;
+  while (true) {
+    std::map<uint32_t, uint32_t> replacements =
+        FindDuplicates(&result.bytes_saved);
+    if (replacements.empty()) {
+      return result;
+    }
+
+    ReplaceReferences(replacements);
+    for (const auto& it : replacements) {
+      doc_->DeleteIndirectObject(it.first);
+      stream_digests_.erase(it.first);
+    }
+    result.objects_removed += replacements.size();
+  }
+}
+
+std::optional<ByteString> CPDF_ObjectDeduplicator::GetKey(
+    uint32_t objnum,
+    const CPDF_Object* obj,
+    size_t* size) {
+  const CPDF_Stream* stream = obj->AsStream();
+  const CPDF_Dictionary* dict = stream ? stream->GetDict().Get()
+                                       : obj->AsDictionary();
+  if (!dict) {
+    return std::nullopt;
+  }
+  if (stream) {
+    const ByteString type = dict->GetNameFor("Type");
+    if (type == "ObjStm" || type == "XRef") {
+      return std::nullopt;
+    }
+  } else if (!IsMergeableDict(dict)) {
+    return std::nullopt;
+  }
+
+  fxcrt::ostringstream buffer;
+  CPDF_StringArchiveStream archive(&buffer);
+  if (!dict->WriteTo(&archive, nullptr)) {
+    return std::nullopt;
+  }
+  *size = static_cast<size_t>(buffer.tellp());
+  if (!stream) {
+    return ByteString(buffer);
+  }
+
+  // The raw data of a stream does not change, so only hash it once.
+  auto it = stream_digests_.find(objnum);
+  if (it == stream_digests_.end()) {
+    auto acc = pdfium::MakeRetain<CPDF_StreamAcc>(pdfium::WrapRetain(stream));
+    acc->LoadAllDataRaw();
+    StreamDigest digest = {acc->ComputeDigest(), acc->GetSize()};
+    it = stream_digests_.emplace(objnum, std::move(digest)).first;
+  }
+  *size += it->second.raw_size;
+  archive.WriteString("stream");
+  archive.WriteBlock(it->second.digest);
+  return ByteString(buffer);
+}
+
+std::map<uint32_t, uint32_t> CPDF_ObjectDeduplicator::FindDuplicates(
+    size_t* bytes_saved) {
+  std::map<ByteString, uint32_t> canonical_objnums;
+  std::map<uint32_t, uint32_t> replacements;
+  for (const auto& [objnum, obj] : GetObjects(doc_)) {
+    size_t size = 0;
+    std::optional<ByteString> key = GetKey(objnum, obj.Get(), &size);
+    if (!key.has_value()) {
+      continue;
+    }
+
+    auto [it, inserted] =
+        canonical_objnums.emplace(std::move(key.value()), objnum);
+    if (!inserted) {
+      replacements[objnum] = it->second;
+      *bytes_saved += size;
+    }
+  }
+  return replacements;
+}
+
+void CPDF_ObjectDeduplicator::ReplaceReferences(
+    const std::map<uint32_t, uint32_t>& replacements) {
+  for (const auto& [objnum, obj] : GetObjects(doc_)) {
+    if (!replacements.contains(objnum)) {
+      ReplaceReferencesInObject(obj.Get(), replacements);
+    }
+  }
+}
+
+void CPDF_ObjectDeduplicator::ReplaceReferencesInObject(
+    CPDF_Object* obj,
+    const std::map<uint32_t, uint32_t>& replacements) {
+  // References in containers are replaced rather than changed in place, so the
+  // containers record the change for incremental saves.
+  switch (obj->GetType()) {
+    case CPDF_Object::kReference: {
+      const uint32_t new_objnum = GetReplacement(obj, replacements);
+      if (new_objnum) {
+        obj->AsMutableReference()->SetRef(doc_, new_objnum);
+      }
+      return;
+    }
+    case CPDF_Object::kDictionary: {
+      CPDF_Dictionary* dict = obj->AsMutableDictionary();
+      std::vector<std::pair<ByteString, uint32_t>> new_refs;
+      {
+        CPDF_DictionaryLocker locker(dict);
+        for (const auto& it : locker) {
+          const uint32_t new_objnum =
+              GetReplacement(it.second.Get(), replacements);
+          if (new_objnum) {
+            new_refs.emplace_back(it.first, new_objnum);
+          } else {
+            ReplaceReferencesInObject(it.second.Get(), replacements);
+          }
+        }
+      }
+      for (const auto& [key, new_objnum] : new_refs) {
+        dict->SetNewFor<CPDF_Reference>(key, doc_.get(), new_objnum);
+      }
+      return;
+    }
+    case CPDF_Object::kArray: {
+      CPDF_Array* array = obj->AsMutableArray();
+      for (size_t i = 0; i < array->size(); ++i) {
+        RetainPtr<CPDF_Object> element = array->GetMutableObjectAt(i);
+        const uint32_t new_objnum =
+            GetReplacement(element.Get(), replacements);
+        if (new_objnum) {
+          array->SetNewAt<CPDF_Reference>(i, doc_.get(), new_objnum);
+        } else {
+          ReplaceReferencesInObject(element.Get(), replacements);
+        }
+      }
+      return;
+    }
+    case CPDF_Object::kStream:
+      ReplaceReferencesInObject(obj->AsMutableStream()->GetMutableDict().Get(),
+                                replacements);
+      return;
+    default:
+      return;
+  }
+}
@@ -0,0 +1,71 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_EDIT_CPDF_OBJECTDEDUPLICATOR_H_
+#define CORE_FPDFAPI_EDIT_CPDF_OBJECTDEDUPLICATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <optional>
+
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/unowned_ptr.h"
+
+class CPDF_Document;
+class CPDF_Object;
+
+// Merges identical indirect objects in a document into one, such as the
+// copies of the same image, ICC profile or embedded font that importing pages
+// from several documents leaves behind. Streams are identical when their
+// dictionaries and their raw data are. Font, font descriptor, encoding and
+// graphics state dictionaries are identical when they are written out the
+// same, so fonts become identical once the font files they use are merged.
+class CPDF_ObjectDeduplicator {
+ public:
+  struct Result {
+    size_t objects_removed = 0;
+    // The size of the removed objects, counting stream data as stored in the
+    // document. Saving compresses streams that have no filter, so the saved
+    // file may shrink by less.
+    size_t bytes_saved = 0;
+  };
+
+  explicit CPDF_ObjectDeduplicator(CPDF_Document* doc);
+  ~CPDF_ObjectDeduplicator();
+
+  // Replaces all references to duplicate objects with references to the
+  // object with the lowest object number among them, and removes the
+  // duplicates from the document.
+  Result Deduplicate();
+
+ private:
+  struct StreamDigest {
+    DataVector<uint8_t> digest;
+    size_t raw_size;
+  };
+
+  // Returns a key that is the same for identical objects, or nullopt if `obj`
+  // is not to be merged. Sets `size` to the size of `obj` once saved.
+  std::optional<ByteString> GetKey(uint32_t objnum,
+                                   const CPDF_Object* obj,
+                                   size_t* size);
+
+  // Finds duplicates among the document's objects. Returns a map of duplicate
+  // object numbers to the object numbers that replace them, and adds the
+  // size of the duplicates to `bytes_saved`.
+  std::map<uint32_t, uint32_t> FindDuplicates(size_t* bytes_saved);
+
+  void ReplaceReferences(const std::map<uint32_t, uint32_t>& replacements);
+  void ReplaceReferencesInObject(
+      CPDF_Object* obj,
+      const std::map<uint32_t, uint32_t>& replacements);
+
+  UnownedPtr<CPDF_Document> const doc_;
+  std::map<uint32_t, StreamDigest> stream_digests_;
+};
+
+#endif  // CORE_FPDFAPI_EDIT_CPDF_OBJECTDEDUPLICATOR_H_
@@ -0,0 +1,122 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/edit/cpdf_objectdeduplicator.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+
+#include "core/fpdfapi/page/test_with_page_module.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_reference.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_test_document.h"
+#include "core/fxcrt/data_vector.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+RetainPtr<CPDF_Stream> NewStream(CPDF_Document* doc, uint8_t value) {
+  return doc->NewIndirect<CPDF_Stream>(DataVector<uint8_t>(1000, value),
+                                       doc->New<CPDF_Dictionary>());
+}
+
+// Adds a font whose font file holds `value`, and returns its object number.
+uint32_t AddFont(CPDF_Document* doc, uint8_t value) {
+  RetainPtr<CPDF_Stream> font_file = NewStream(doc, value);
+  auto descriptor = doc->NewIndirect<CPDF_Dictionary>();
+  descriptor->SetNewFor<CPDF_Name>("Type", "FontDescriptor");
+  descriptor->SetNewFor<CPDF_Reference>("FontFile2", doc,
+                                        font_file->GetObjNum());
+  auto font = doc->NewIndirect<CPDF_Dictionary>();
+  font->SetNewFor<CPDF_Name>("Type", "Font");
+  font->SetNewFor<CPDF_Name>("Subtype", "TrueType");
+  font->SetNewFor<CPDF_Reference>("FontDescriptor", doc,
+                                  descriptor->GetObjNum());
+  return font->GetObjNum();
+}
+
+uint32_t GetRefObjNum(const CPDF_Dictionary* dict, ByteStringView key) {
+  RetainPtr<const CPDF_Reference> ref = ToReference(dict->GetObjectFor(key));
+  return ref ? ref->GetRefObjNum() : 0;
+}
+
+}  // namespace
+
+using CPDFObjectDeduplicatorTest = TestWithPageModule;
+
+TEST_F(CPDFObjectDeduplicatorTest, MergesStreamsAndFonts) {
+  auto doc = std::make_unique<CPDF_TestDocument>();
+  doc->CreateNewDoc();
+  const uint32_t font1 = AddFont(doc.get(), 1);
+  const uint32_t font2 = AddFont(doc.get(), 1);
+  const uint32_t font3 = AddFont(doc.get(), 2);
+  const uint32_t image = NewStream(doc.get(), 1)->GetObjNum();
+
+  auto fonts = doc->New<CPDF_Dictionary>();
+  fonts->SetNewFor<CPDF_Reference>("F1", doc.get(), font1);
+  fonts->SetNewFor<CPDF_Reference>("F2", doc.get(), font2);
+  fonts->SetNewFor<CPDF_Reference>("F3", doc.get(), font3);
+  auto resources =
+      doc->CreateNewPage(0)->SetNewFor<CPDF_Dictionary>("Resources");
+  resources->SetFor("Font", fonts);
+  resources->SetNewFor<CPDF_Reference>("Image", doc.get(), image);
+
+  CPDF_ObjectDeduplicator deduplicator(doc.get());
+  CPDF_ObjectDeduplicator::Result result = deduplicator.Deduplicate();
+
+  // The second font, its descriptor and its font file go. The image has the
+  // same data as the first font file, but the first font file came first.
+  EXPECT_EQ(4u, result.objects_removed);
+  EXPECT_GT(result.bytes_saved, 2000u);
+  EXPECT_EQ(font1, GetRefObjNum(fonts.Get(), "F1"));
+  EXPECT_EQ(font1, GetRefObjNum(fonts.Get(), "F2"));
+  EXPECT_EQ(font3, GetRefObjNum(fonts.Get(), "F3"));
+  EXPECT_NE(image, GetRefObjNum(resources.Get(), "Image"));
+  EXPECT_FALSE(doc->GetIndirectObject(font2));
+  EXPECT_FALSE(doc->GetIndirectObject(image));
+  EXPECT_TRUE(doc->GetIndirectObject(font3));
+
+  // Nothing is left to merge.
+  result = deduplicator.Deduplicate();
+  EXPECT_EQ(0u, result.objects_removed);
+  EXPECT_EQ(0u, result.bytes_saved);
+}
+
+TEST_F(CPDFObjectDeduplicatorTest, KeepsOtherDictionaries) {
+  auto doc = std::make_unique<CPDF_TestDocument>();
+  doc->CreateNewDoc();
+  RetainPtr<CPDF_Dictionary> page1 = doc->CreateNewPage(0);
+  RetainPtr<CPDF_Dictionary> page2 = doc->CreateNewPage(1);
+
+  // Streams differ in their dictionaries as well as in their data.
+  RetainPtr<CPDF_Stream> stream1 = NewStream(doc.get(), 1);
+  RetainPtr<CPDF_Stream> stream2 = NewStream(doc.get(), 1);
+  stream2->GetMutableDict()->SetNewFor<CPDF_Name>("Subtype", "Image");
+  auto xobjects = page1->SetNewFor<CPDF_Dictionary>("Resources")
+                      ->SetNewFor<CPDF_Dictionary>("XObject");
+  xobjects->SetNewFor<CPDF_Reference>("X1", doc.get(), stream1->GetObjNum());
+  xobjects->SetNewFor<CPDF_Reference>("X2", doc.get(), stream2->GetObjNum());
+
+  CPDF_ObjectDeduplicator deduplicator(doc.get());
+  CPDF_ObjectDeduplicator::Result result = deduplicator.Deduplicate();
+  EXPECT_EQ(0u, result.objects_removed);
+  EXPECT_TRUE(doc->GetIndirectObject(page2->GetObjNum()));
+  EXPECT_TRUE(doc->GetIndirectObject(stream2->GetObjNum()));
+}
+
+TEST_F(CPDFObjectDeduplicatorTest, IgnoresUnreachableObjects) {
+  auto doc = std::make_unique<CPDF_TestDocument>();
+  doc->CreateNewDoc();
+  RetainPtr<CPDF_Stream> stream1 = NewStream(doc.get(), 1);
+  RetainPtr<CPDF_Stream> stream2 = NewStream(doc.get(), 1);
+
+  CPDF_ObjectDeduplicator deduplicator(doc.get());
+  CPDF_ObjectDeduplicator::Result result = deduplicator.Deduplicate();
+  EXPECT_EQ(0u, result.objects_removed);
+  EXPECT_TRUE(doc->GetIndirectObject(stream2->GetObjNum()));
+}
@@ -161,14 +161,15 @@ void CPDF_PageContentManager::UpdateStream(size_t stream_index,
     return;
   }
 
-  RetainPtr<CPDF_Reference> stream_reference =
-      ToReference(contents_array->GetMutableObjectAt(stream_index));
-  if (!stream_reference) {
+  if (!ToReference(contents_array->GetObjectAt(stream_index))) {
     return;
   }
 
+  // Replace the reference rather than changing it in place, so the change to
+  // `contents_array` gets recorded for incremental saves.
   auto new_stream = document_->NewIndirect<CPDF_Stream>(buf);
-  stream_reference->SetRef(document_, new_stream->GetObjNum());
+  contents_array->SetNewAt<CPDF_Reference>(stream_index, document_,
+                                           new_stream->GetObjNum());
 }
 
 void CPDF_PageContentManager::ScheduleRemoveStreamByIndex(size_t stream_index) {
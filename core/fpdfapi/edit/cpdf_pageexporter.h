@@ -15,7 +15,8 @@
 class CPDF_Document;
 
 // Copies pages from a source document into a destination document.
-// This class is intended to be used once via ExportPages() and then destroyed.
+// ExportPages() may be called several times. Objects that pages exported by an
+// earlier call refer to are not copied again.
 class CPDF_PageExporter final : public CPDF_PageOrganizer {
  public:
   CPDF_PageExporter(CPDF_Document* dest_doc, CPDF_Document* src_doc);
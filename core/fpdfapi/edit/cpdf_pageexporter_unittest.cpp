@@ -0,0 +1,106 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/edit/cpdf_pageexporter.h"
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "core/fpdfapi/page/test_with_page_module.h"
+#include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_reference.h"
+#include "core/fpdfapi/parser/cpdf_test_document.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+std::unique_ptr<CPDF_TestDocument> CreateDocument() {
+  auto doc = std::make_unique<CPDF_TestDocument>();
+  doc->CreateNewDoc();
+  return doc;
+}
+
+// Adds a page whose font resource /F1 is the object `font_obj_num`.
+void AddPageWithFont(CPDF_Document* doc, int index, uint32_t font_obj_num) {
+  RetainPtr<CPDF_Dictionary> page = doc->CreateNewPage(index);
+  page->SetNewFor<CPDF_Dictionary>("Resources")
+      ->SetNewFor<CPDF_Dictionary>("Font")
+      ->SetNewFor<CPDF_Reference>("F1", doc, font_obj_num);
+}
+
+uint32_t GetFontObjNum(CPDF_Document* doc, int index) {
+  RetainPtr<const CPDF_Dictionary> fonts =
+      doc->GetPageDictionary(index)->GetDictFor("Resources")->GetDictFor(
+          "Font");
+  return ToReference(fonts->GetObjectFor("F1"))->GetRefObjNum();
+}
+
+}  // namespace
+
+using CPDFPageExporterTest = TestWithPageModule;
+
+TEST_F(CPDFPageExporterTest, ReusesCopiesAcrossCalls) {
+  std::unique_ptr<CPDF_TestDocument> src_doc = CreateDocument();
+  auto font = src_doc->NewIndirect<CPDF_Dictionary>();
+  font->SetNewFor<CPDF_Name>("Type", "Font");
+  AddPageWithFont(src_doc.get(), 0, font->GetObjNum());
+  AddPageWithFont(src_doc.get(), 1, font->GetObjNum());
+
+  std::unique_ptr<CPDF_TestDocument> dest_doc = CreateDocument();
+  {
+    CPDF_PageExporter exporter(dest_doc.get(), src_doc.get());
+    static constexpr uint32_t kFirstPage[] = {0};
+    static constexpr uint32_t kSecondPage[] = {1};
+    ASSERT_TRUE(exporter.ExportPages(kFirstPage, 0));
+    ASSERT_TRUE(exporter.ExportPages(kSecondPage, 1));
+  }
+  {
+    CPDF_PageExporter exporter(dest_doc.get(), src_doc.get());
+    static constexpr uint32_t kFirstPage[] = {0};
+    ASSERT_TRUE(exporter.ExportPages(kFirstPage, 2));
+  }
+  ASSERT_EQ(3, dest_doc->GetPageCount());
+
+  // Only a new exporter copies the font again.
+  EXPECT_EQ(GetFontObjNum(dest_doc.get(), 0), GetFontObjNum(dest_doc.get(), 1));
+  EXPECT_NE(GetFontObjNum(dest_doc.get(), 0), GetFontObjNum(dest_doc.get(), 2));
+}
+
+TEST_F(CPDFPageExporterTest, DeeplyNestedObjects) {
+  // A chain of arrays, each referring to the next, deeper than the call stack
+  // could handle if every level took a few stack frames.
+  static constexpr int kDepth = 200000;
+  std::unique_ptr<CPDF_TestDocument> src_doc = CreateDocument();
+  auto last = src_doc->NewIndirect<CPDF_Array>();
+  last->AppendNew<CPDF_Number>(kDepth);
+  uint32_t next_obj_num = last->GetObjNum();
+  for (int i = 1; i < kDepth; ++i) {
+    auto array = src_doc->NewIndirect<CPDF_Array>();
+    array->AppendNew<CPDF_Reference>(src_doc.get(), next_obj_num);
+    next_obj_num = array->GetObjNum();
+  }
+  src_doc->CreateNewPage(0)->SetNewFor<CPDF_Reference>("Chain", src_doc.get(),
+                                                       next_obj_num);
+
+  std::unique_ptr<CPDF_TestDocument> dest_doc = CreateDocument();
+  CPDF_PageExporter exporter(dest_doc.get(), src_doc.get());
+  static constexpr uint32_t kPages[] = {0};
+  ASSERT_TRUE(exporter.ExportPages(kPages, 0));
+
+  RetainPtr<const CPDF_Array> array =
+      dest_doc->GetPageDictionary(0)->GetArrayFor("Chain");
+  int depth = 1;
+  while (array && array->GetObjectAt(0)->IsReference()) {
+    array = array->GetArrayAt(0);
+    ++depth;
+  }
+  ASSERT_TRUE(array);
+  EXPECT_EQ(array, dest_doc->GetIndirectObject(array->GetObjNum()));
+  EXPECT_EQ(kDepth, depth);
+  EXPECT_EQ(kDepth, array->GetIntegerAt(0));
+}
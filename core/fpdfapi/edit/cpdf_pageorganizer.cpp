@@ -6,6 +6,7 @@
 
 #include "core/fpdfapi/edit/cpdf_pageorganizer.h"
 
+#include <optional>
 #include <set>
 #include <utility>
 #include <vector>
@@ -24,6 +25,14 @@
 #include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/check.h"
 
+CPDF_PageOrganizer::UpdateFrame::UpdateFrame(RetainPtr<CPDF_Object> obj)
+    : obj(std::move(obj)) {}
+
+CPDF_PageOrganizer::UpdateFrame::UpdateFrame(UpdateFrame&&) noexcept =
+    default;
+
+CPDF_PageOrganizer::UpdateFrame::~UpdateFrame() = default;
+
 CPDF_PageOrganizer::CPDF_PageOrganizer(CPDF_Document* dest_doc,
                                        CPDF_Document* src_doc)
     : dest_doc_(dest_doc), src_doc_(src_doc) {}
@@ -76,55 +85,101 @@ bool CPDF_PageOrganizer::InitDestDoc() {
 }
 
 bool CPDF_PageOrganizer::UpdateReference(RetainPtr<CPDF_Object> obj) {
-  switch (obj->GetType()) {
-    case CPDF_Object::kReference: {
-      CPDF_Reference* reference = obj->AsMutableReference();
-      uint32_t newobjnum = GetNewObjId(reference);
-      if (newobjnum == 0) {
-        return false;
-      }
-      reference->SetRef(dest(), newobjnum);
-      return true;
-    }
-    case CPDF_Object::kDictionary: {
-      CPDF_Dictionary* dict = obj->AsMutableDictionary();
-      std::vector<ByteString> bad_keys;
-      {
-        CPDF_DictionaryLocker locker(dict);
-        for (const auto& it : locker) {
-          const ByteString& key = it.first;
-          if (key == "Parent" || key == "Prev" || key == "First") {
-            continue;
+  // Copied objects can nest and refer to each other arbitrarily deep, so walk
+  // them with an explicit stack instead of recursing. A frame is revisited
+  // each time one of its children finishes, with `child_result` set to the
+  // outcome for that child.
+  std::vector<UpdateFrame> stack;
+  stack.emplace_back(std::move(obj));
+  std::optional<bool> child_result;
+  while (true) {
+    UpdateFrame& frame = stack.back();
+    RetainPtr<CPDF_Object> child;
+    bool result = true;
+    switch (frame.obj->GetType()) {
+      case CPDF_Object::kReference: {
+        CPDF_Reference* reference = frame.obj->AsMutableReference();
+        if (child_result.has_value()) {
+          // The copy of the referenced object has been updated.
+          result = child_result.value();
+          if (result) {
+            reference->SetRef(dest(), frame.new_obj_num);
           }
-          RetainPtr<CPDF_Object> next_obj = it.second;
-          if (!UpdateReference(next_obj)) {
-            bad_keys.push_back(key);
+          break;
+        }
+        RetainPtr<CPDF_Object> copy;
+        frame.new_obj_num = GetNewObjId(reference, &copy);
+        if (frame.new_obj_num == 0) {
+          result = false;
+          break;
+        }
+        if (copy) {
+          child = std::move(copy);
+          break;
+        }
+        reference->SetRef(dest(), frame.new_obj_num);
+        break;
+      }
+      case CPDF_Object::kDictionary: {
+        if (!child_result.has_value()) {
+          CPDF_DictionaryLocker locker(frame.obj->AsDictionary());
+          for (const auto& it : locker) {
+            const ByteString& key = it.first;
+            if (key != "Parent" && key != "Prev" && key != "First") {
+              frame.entries.emplace_back(key, it.second);
+            }
           }
+        } else if (!child_result.value()) {
+          frame.bad_keys.push_back(frame.entries[frame.next - 1].first);
+        }
+        if (frame.next < frame.entries.size()) {
+          child = frame.entries[frame.next++].second;
+          break;
         }
+        CPDF_Dictionary* dict = frame.obj->AsMutableDictionary();
+        for (const auto& key : frame.bad_keys) {
+          dict->RemoveFor(key.AsStringView());
+        }
+        break;
       }
-      for (const auto& key : bad_keys) {
-        dict->RemoveFor(key.AsStringView());
+      case CPDF_Object::kArray: {
+        if (child_result.has_value() && !child_result.value()) {
+          result = false;
+          break;
+        }
+        CPDF_Array* array = frame.obj->AsMutableArray();
+        if (frame.next < array->size()) {
+          child = array->GetMutableObjectAt(frame.next++);
+        }
+        break;
       }
-      return true;
-    }
-    case CPDF_Object::kArray: {
-      CPDF_Array* array = obj->AsMutableArray();
-      for (size_t i = 0; i < array->size(); ++i) {
-        if (!UpdateReference(array->GetMutableObjectAt(i))) {
-          return false;
+      case CPDF_Object::kStream: {
+        if (child_result.has_value()) {
+          result = child_result.value();
+          break;
         }
+        child = frame.obj->AsMutableStream()->GetMutableDict();
+        break;
       }
-      return true;
+      default:
+        break;
     }
-    case CPDF_Object::kStream: {
-      return UpdateReference(obj->AsMutableStream()->GetMutableDict());
+
+    if (child) {
+      child_result.reset();
+      stack.emplace_back(std::move(child));
+      continue;
     }
-    default:
-      return true;
+    stack.pop_back();
+    if (stack.empty()) {
+      return result;
+    }
+    child_result = result;
   }
 }
 
-uint32_t CPDF_PageOrganizer::GetNewObjId(CPDF_Reference* ref) {
+uint32_t CPDF_PageOrganizer::GetNewObjId(CPDF_Reference* ref,
+                                         RetainPtr<CPDF_Object>* copy) {
   if (!ref) {
     return 0;
   }
@@ -158,10 +213,7 @@ uint32_t CPDF_PageOrganizer::GetNewObjId(CPDF_Reference* ref) {
 
   new_obj_num = dest()->AddIndirectObject(clone);
   AddObjectMapping(obj_num, new_obj_num);
-  if (!UpdateReference(std::move(clone))) {
-    return 0;
-  }
-
+  *copy = std::move(clone);
   return new_obj_num;
 }
 
@@ -7,9 +7,12 @@
 #ifndef CORE_FPDFAPI_EDIT_CPDF_PAGEORGANIZER_H_
 #define CORE_FPDFAPI_EDIT_CPDF_PAGEORGANIZER_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <map>
+#include <utility>
+#include <vector>
 
 #include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/retain_ptr.h"
@@ -28,6 +31,9 @@ class CPDF_PageOrganizer {
   // Must be called after construction before doing anything else.
   bool Init();
 
+  // Points the references in `obj`, and in the objects it refers to, at
+  // copies in the destination document, copying objects that have not been
+  // copied yet. Copies made by earlier calls are reused.
   bool UpdateReference(RetainPtr<CPDF_Object> obj);
 
   CPDF_Document* dest() { return dest_doc_; }
@@ -51,9 +57,29 @@ class CPDF_PageOrganizer {
       ByteStringView src_tag);
 
  private:
+  // An object that UpdateReference() is working on.
+  struct UpdateFrame {
+    explicit UpdateFrame(RetainPtr<CPDF_Object> obj);
+    UpdateFrame(UpdateFrame&&) noexcept;
+    ~UpdateFrame();
+
+    RetainPtr<CPDF_Object> obj;
+    // For dictionaries, the entries to update. For dictionaries and arrays,
+    // the index of the next entry or element to update.
+    std::vector<std::pair<ByteString, RetainPtr<CPDF_Object>>> entries;
+    size_t next = 0;
+    // For dictionaries, the entries to remove once all are updated.
+    std::vector<ByteString> bad_keys;
+    // For references, the object number of the referenced object's copy.
+    uint32_t new_obj_num = 0;
+  };
+
   bool InitDestDoc();
 
-  uint32_t GetNewObjId(CPDF_Reference* ref);
+  // Returns the object number of the copy of the object `ref` refers to, or 0
+  // if it cannot be copied. Sets `copy` if this makes a new copy, whose
+  // references the caller still has to update.
+  uint32_t GetNewObjId(CPDF_Reference* ref, RetainPtr<CPDF_Object>* copy);
 
   UnownedPtr<CPDF_Document> const dest_doc_;
   UnownedPtr<CPDF_Document> const src_doc_;
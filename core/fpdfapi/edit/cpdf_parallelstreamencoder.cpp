@@ -0,0 +1,130 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/edit/cpdf_parallelstreamencoder.h"
+
+#include <utility>
+
+#include "core/fpdfapi/parser/cpdf_crypto_handler.h"
+#include "core/fpdfapi/parser/cpdf_encryptor.h"
+#include "core/fpdfapi/parser/cpdf_flateencoder.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_stream_acc.h"
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/check_op.h"
+
+CPDF_ParallelStreamEncoder::Job::Job(uint32_t objnum,
+                                     RetainPtr<CPDF_StreamAcc> raw_acc,
+                                     bool has_filter)
+    : objnum(objnum), has_filter(has_filter), raw_acc(std::move(raw_acc)) {}
+
+CPDF_ParallelStreamEncoder::Job::~Job() = default;
+
+// static
+bool CPDF_ParallelStreamEncoder::CanEncode(const CPDF_Stream* stream) {
+  return !stream->IsMetadataStream();
+}
+
+CPDF_ParallelStreamEncoder::CPDF_ParallelStreamEncoder(
+    size_t worker_count,
+    const CPDF_CryptoHandler* crypto_handler,
+    size_t memory_budget)
+    : crypto_handler_(crypto_handler),
+      encrypt_on_workers_(!crypto_handler || !crypto_handler->IsCipherAES()),
+      memory_budget_(memory_budget) {
+  for (size_t i = 0; i < worker_count; ++i) {
+    workers_.emplace_back(&CPDF_ParallelStreamEncoder::WorkerMain, this);
+  }
+}
+
+CPDF_ParallelStreamEncoder::~CPDF_ParallelStreamEncoder() {
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    shutting_down_ = true;
+  }
+  job_queued_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+bool CPDF_ParallelStreamEncoder::IsFull() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return submitted_bytes_ >= memory_budget_;
+}
+
+void CPDF_ParallelStreamEncoder::Submit(uint32_t objnum,
+                                        RetainPtr<const CPDF_Stream> stream) {
+  // File-based streams read through the document's file access, which only
+  // the document's thread may use.
+  const bool has_filter = stream->HasFilter();
+  auto raw_acc = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(stream));
+  raw_acc->LoadAllDataRaw();
+  const size_t size = raw_acc->GetSize();
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    jobs_.push_back(
+        std::make_unique<Job>(objnum, std::move(raw_acc), has_filter));
+    submitted_bytes_ += size;
+  }
+  job_queued_.notify_one();
+}
+
+std::unique_ptr<CPDF_FlateEncoder> CPDF_ParallelStreamEncoder::TakeNext() {
+  std::unique_ptr<Job> job;
+  {
+    std::unique_lock<std::mutex> lock(lock_);
+    CHECK(!jobs_.empty());
+    Job* front = jobs_.front().get();
+    if (front->state == Job::State::kQueued) {
+      DCHECK_EQ(next_job_, 0u);
+      ++next_job_;
+      front->state = Job::State::kRunning;
+      lock.unlock();
+      Encode(*front);
+      lock.lock();
+      front->state = Job::State::kDone;
+    } else {
+      job_done_.wait(lock,
+                     [front] { return front->state == Job::State::kDone; });
+    }
+    job = std::move(jobs_.front());
+    jobs_.pop_front();
+    --next_job_;
+    submitted_bytes_ -= job->raw_acc->GetSize();
+  }
+
+  // Cloning the stream dictionary is only safe on the calling thread.
+  return std::make_unique<CPDF_FlateEncoder>(
+      job->raw_acc->GetStream(), std::move(job->data), job->data_encrypted);
+}
+
+void CPDF_ParallelStreamEncoder::WorkerMain() {
+  std::unique_lock<std::mutex> lock(lock_);
+  while (true) {
+    job_queued_.wait(
+        lock, [this] { return shutting_down_ || next_job_ < jobs_.size(); });
+    if (shutting_down_) {
+      return;
+    }
+
+    Job* job = jobs_[next_job_++].get();
+    job->state = Job::State::kRunning;
+    lock.unlock();
+    Encode(*job);
+    lock.lock();
+    job->state = Job::State::kDone;
+    job_done_.notify_all();
+  }
+}
+
+void CPDF_ParallelStreamEncoder::Encode(Job& job) const {
+  job.data =
+      CPDF_FlateEncoder::EncodeData(job.raw_acc->GetSpan(), job.has_filter);
+  if (crypto_handler_ && encrypt_on_workers_) {
+    CPDF_Encryptor encryptor(crypto_handler_, job.objnum);
+    job.data = encryptor.Encrypt(job.data);
+    job.data_encrypted = true;
+  }
+}
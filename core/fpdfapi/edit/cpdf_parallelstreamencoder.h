@@ -0,0 +1,105 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_EDIT_CPDF_PARALLELSTREAMENCODER_H_
+#define CORE_FPDFAPI_EDIT_CPDF_PARALLELSTREAMENCODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/unowned_ptr.h"
+
+class CPDF_CryptoHandler;
+class CPDF_FlateEncoder;
+class CPDF_Stream;
+class CPDF_StreamAcc;
+
+// Compresses stream data on worker threads, ahead of CPDF_Creator writing the
+// streams out one at a time in document order. Streams are taken back in the
+// order they were submitted, so the output is the same as writing each stream
+// with CPDF_Stream::WriteTo().
+//
+// The workers only see the raw bytes of each stream. Everything that touches
+// the document's objects, such as cloning the stream dictionary, happens on
+// the calling thread.
+//
+// The data is also encrypted on the workers, unless the cipher is AES. AES
+// encryption uses a random IV and a context shared by the whole document, so
+// it is left to the writer, which encrypts streams in order as before.
+class CPDF_ParallelStreamEncoder {
+ public:
+  // Raw stream data that may be submitted but not yet taken.
+  static constexpr size_t kDefaultMemoryBudget = 64 * 1024 * 1024;
+
+  // Whether CPDF_Stream::WriteTo() would Flate encode `stream` the way this
+  // class does. Metadata streams are written uncompressed, and are not.
+  static bool CanEncode(const CPDF_Stream* stream);
+
+  // Starts `worker_count` threads. `crypto_handler` is what the streams are to
+  // be encrypted with, or nullptr, and must outlive this object.
+  CPDF_ParallelStreamEncoder(size_t worker_count,
+                             const CPDF_CryptoHandler* crypto_handler,
+                             size_t memory_budget);
+  CPDF_ParallelStreamEncoder(const CPDF_ParallelStreamEncoder&) = delete;
+  CPDF_ParallelStreamEncoder& operator=(const CPDF_ParallelStreamEncoder&) =
+      delete;
+  ~CPDF_ParallelStreamEncoder();
+
+  // Whether the submitted streams use up the memory budget. Callers should
+  // take streams before submitting more.
+  bool IsFull() const;
+
+  // Queues `stream`, to be written as object `objnum`. Reads the raw data of
+  // `stream` on the calling thread, which must be the one using the document.
+  void Submit(uint32_t objnum, RetainPtr<const CPDF_Stream> stream);
+
+  // Returns the encoder of the oldest stream not taken yet. Waits for a worker
+  // to finish it, or encodes it on the calling thread if no worker has started
+  // it yet.
+  std::unique_ptr<CPDF_FlateEncoder> TakeNext();
+
+ private:
+  struct Job {
+    enum class State { kQueued, kRunning, kDone };
+
+    Job(uint32_t objnum, RetainPtr<CPDF_StreamAcc> raw_acc, bool has_filter);
+    ~Job();
+
+    const uint32_t objnum;
+    const bool has_filter;
+    RetainPtr<CPDF_StreamAcc> const raw_acc;
+    State state = State::kQueued;
+    DataVector<uint8_t> data;
+    bool data_encrypted = false;
+  };
+
+  void WorkerMain();
+  void Encode(Job& job) const;
+
+  UnownedPtr<const CPDF_CryptoHandler> const crypto_handler_;
+  const bool encrypt_on_workers_;
+  const size_t memory_budget_;
+
+  mutable std::mutex lock_;
+  std::condition_variable job_queued_;
+  std::condition_variable job_done_;
+  // Oldest first. Jobs before `next_job_` have been started.
+  std::deque<std::unique_ptr<Job>> jobs_;
+  size_t next_job_ = 0;
+  size_t submitted_bytes_ = 0;
+  bool shutting_down_ = false;
+
+  std::vector<std::thread> workers_;
+};
+
+#endif  // CORE_FPDFAPI_EDIT_CPDF_PARALLELSTREAMENCODER_H_
@@ -0,0 +1,156 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/edit/cpdf_parallelstreamencoder.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "core/fpdfapi/edit/cpdf_stringarchivestream.h"
+#include "core/fpdfapi/parser/cpdf_crypto_handler.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_encryptor.h"
+#include "core/fpdfapi/parser/cpdf_flateencoder.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/fx_string_wrappers.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr uint8_t kKey[16] = {1, 2,  3,  4,  5,  6,  7,  8,
+                              9, 10, 11, 12, 13, 14, 15, 16};
+
+// Makes `count` streams of different sizes. Every third one is already
+// filtered, and every fifth one is a metadata stream.
+std::vector<RetainPtr<CPDF_Stream>> MakeStreams(size_t count) {
+  std::vector<RetainPtr<CPDF_Stream>> streams;
+  for (size_t i = 0; i < count; ++i) {
+    DataVector<uint8_t> data(100 + i * 97);
+    for (size_t j = 0; j < data.size(); ++j) {
+      data[j] = static_cast<uint8_t>((i + j / 7) % 13);
+    }
+    auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+    if (i % 3 == 1) {
+      dict->SetNewFor<CPDF_Name>("Filter", "RunLengthDecode");
+    }
+    if (i % 5 == 2) {
+      dict->SetNewFor<CPDF_Name>("Type", "Metadata");
+      dict->SetNewFor<CPDF_Name>("Subtype", "XML");
+    }
+    streams.push_back(
+        pdfium::MakeRetain<CPDF_Stream>(std::move(data), std::move(dict)));
+  }
+  return streams;
+}
+
+// Writes `streams` one after the other, the way CPDF_Creator does without
+// worker threads.
+fxcrt::string WriteSerially(
+    const std::vector<RetainPtr<CPDF_Stream>>& streams,
+    const CPDF_CryptoHandler* crypto_handler) {
+  fxcrt::ostringstream output;
+  CPDF_StringArchiveStream archive(&output);
+  for (size_t i = 0; i < streams.size(); ++i) {
+    std::unique_ptr<CPDF_Encryptor> encryptor;
+    if (crypto_handler) {
+      encryptor = std::make_unique<CPDF_Encryptor>(crypto_handler, i + 1);
+    }
+    EXPECT_TRUE(streams[i]->WriteTo(&archive, encryptor.get()));
+  }
+  return output.str();
+}
+
+// Same as WriteSerially(), but with the streams CPDF_ParallelStreamEncoder
+// can encode going through `encoder`.
+fxcrt::string WriteInParallel(
+    const std::vector<RetainPtr<CPDF_Stream>>& streams,
+    const CPDF_CryptoHandler* crypto_handler,
+    CPDF_ParallelStreamEncoder& encoder) {
+  for (size_t i = 0; i < streams.size(); ++i) {
+    if (CPDF_ParallelStreamEncoder::CanEncode(streams[i].Get())) {
+      encoder.Submit(i + 1, streams[i]);
+    }
+  }
+
+  fxcrt::ostringstream output;
+  CPDF_StringArchiveStream archive(&output);
+  for (size_t i = 0; i < streams.size(); ++i) {
+    std::unique_ptr<CPDF_Encryptor> encryptor;
+    if (crypto_handler) {
+      encryptor = std::make_unique<CPDF_Encryptor>(crypto_handler, i + 1);
+    }
+    if (!CPDF_ParallelStreamEncoder::CanEncode(streams[i].Get())) {
+      EXPECT_TRUE(streams[i]->WriteTo(&archive, encryptor.get()));
+      continue;
+    }
+    std::unique_ptr<CPDF_FlateEncoder> stream_encoder = encoder.TakeNext();
+    EXPECT_TRUE(stream_encoder->WriteStreamTo(&archive, encryptor.get(),
+                                              /*encrypt_data=*/true));
+  }
+  return output.str();
+}
+
+}  // namespace
+
+TEST(CPDFParallelStreamEncoderTest, CanEncode) {
+  std::vector<RetainPtr<CPDF_Stream>> streams = MakeStreams(3);
+  EXPECT_TRUE(CPDF_ParallelStreamEncoder::CanEncode(streams[0].Get()));
+  EXPECT_TRUE(CPDF_ParallelStreamEncoder::CanEncode(streams[1].Get()));
+  EXPECT_FALSE(CPDF_ParallelStreamEncoder::CanEncode(streams[2].Get()));
+}
+
+TEST(CPDFParallelStreamEncoderTest, SameAsSerial) {
+  std::vector<RetainPtr<CPDF_Stream>> streams = MakeStreams(50);
+  const fxcrt::string expected = WriteSerially(streams, nullptr);
+  for (size_t worker_count : {0, 1, 4}) {
+    CPDF_ParallelStreamEncoder encoder(
+        worker_count, nullptr,
+        CPDF_ParallelStreamEncoder::kDefaultMemoryBudget);
+    EXPECT_EQ(expected, WriteInParallel(streams, nullptr, encoder));
+  }
+}
+
+TEST(CPDFParallelStreamEncoderTest, SameAsSerialWithRC4) {
+  CPDF_CryptoHandler crypto_handler(CPDF_CryptoHandler::Cipher::kRC4, kKey);
+  std::vector<RetainPtr<CPDF_Stream>> streams = MakeStreams(50);
+  const fxcrt::string expected = WriteSerially(streams, &crypto_handler);
+  CPDF_ParallelStreamEncoder encoder(
+      4, &crypto_handler, CPDF_ParallelStreamEncoder::kDefaultMemoryBudget);
+  EXPECT_EQ(expected, WriteInParallel(streams, &crypto_handler, encoder));
+}
+
+TEST(CPDFParallelStreamEncoderTest, SameSizeWithAES) {
+  // AES output depends on a random IV, so only compare the sizes.
+  CPDF_CryptoHandler crypto_handler(CPDF_CryptoHandler::Cipher::kAES, kKey);
+  std::vector<RetainPtr<CPDF_Stream>> streams = MakeStreams(50);
+  const fxcrt::string expected = WriteSerially(streams, &crypto_handler);
+  CPDF_ParallelStreamEncoder encoder(
+      4, &crypto_handler, CPDF_ParallelStreamEncoder::kDefaultMemoryBudget);
+  EXPECT_EQ(expected.size(),
+            WriteInParallel(streams, &crypto_handler, encoder).size());
+}
+
+TEST(CPDFParallelStreamEncoderTest, MemoryBudget) {
+  std::vector<RetainPtr<CPDF_Stream>> streams = MakeStreams(3);
+  const size_t budget = streams[0]->GetRawSize() + streams[1]->GetRawSize();
+  CPDF_ParallelStreamEncoder encoder(2, nullptr, budget);
+  EXPECT_FALSE(encoder.IsFull());
+  encoder.Submit(1, streams[0]);
+  EXPECT_FALSE(encoder.IsFull());
+  encoder.Submit(2, streams[1]);
+  EXPECT_TRUE(encoder.IsFull());
+
+  EXPECT_TRUE(encoder.TakeNext());
+  EXPECT_FALSE(encoder.IsFull());
+  encoder.Submit(3, streams[2]);
+  EXPECT_TRUE(encoder.IsFull());
+  EXPECT_TRUE(encoder.TakeNext());
+  EXPECT_TRUE(encoder.TakeNext());
+  EXPECT_FALSE(encoder.IsFull());
+}
@@ -64,6 +64,7 @@ void CPDF_FontGlobals::LoadEmbeddedMaps() {
 
 RetainPtr<CPDF_Font> CPDF_FontGlobals::Find(CPDF_Document* doc,
                                             CFX_StandardFont::Index index) {
+  std::lock_guard<std::mutex> lock(lock_);
   auto it = stock_map_.find(doc);
   if (it == stock_map_.end() || !it->second) {
     return nullptr;
@@ -75,6 +76,7 @@ RetainPtr<CPDF_Font> CPDF_FontGlobals::Find(CPDF_Document* doc,
 void CPDF_FontGlobals::Set(CPDF_Document* doc,
                            CFX_StandardFont::Index index,
                            RetainPtr<CPDF_Font> font) {
+  std::lock_guard<std::mutex> lock(lock_);
   UnownedPtr<CPDF_Document> pKey(doc);
   if (!pdfium::Contains(stock_map_, pKey)) {
     stock_map_[pKey] = std::make_unique<CPDF_StockFontArray>();
@@ -83,6 +85,7 @@ void CPDF_FontGlobals::Set(CPDF_Document* doc,
 }
 
 void CPDF_FontGlobals::Clear(CPDF_Document* doc) {
+  std::lock_guard<std::mutex> lock(lock_);
   // Avoid constructing smart-pointer key as erase() doesn't invoke
   // transparent lookup in the same way find() does.
   auto it = stock_map_.find(doc);
@@ -113,6 +116,7 @@ void CPDF_FontGlobals::LoadEmbeddedKorea1CMaps() {
 
 RetainPtr<const CPDF_CMap> CPDF_FontGlobals::GetPredefinedCMap(
     const ByteString& name) {
+  std::lock_guard<std::mutex> lock(lock_);
   auto it = cmaps_.find(name);
   if (it != cmaps_.end()) {
     return it->second;
@@ -128,6 +132,7 @@ RetainPtr<const CPDF_CMap> CPDF_FontGlobals::GetPredefinedCMap(
 
 CPDF_CID2UnicodeMap* CPDF_FontGlobals::GetCID2UnicodeMap(CIDSet charset) {
   uint8_t idx = fxcrt::to_underlying(charset);
+  std::lock_guard<std::mutex> lock(lock_);
   if (!cid2unicode_maps_[idx]) {
     cid2unicode_maps_[idx] = std::make_unique<CPDF_CID2UnicodeMap>(charset);
   }
@@ -11,6 +11,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include "core/fpdfapi/cmaps/fpdf_cmaps.h"
 #include "core/fpdfapi/font/cpdf_cidfont.h"
@@ -64,6 +65,9 @@ class CPDF_FontGlobals {
   void LoadEmbeddedJapan1CMaps();
   void LoadEmbeddedKorea1CMaps();
 
+  // Guards the caches below, which are shared by all documents and may be
+  // accessed from several threads at once.
+  std::mutex lock_;
   std::map<ByteString, RetainPtr<const CPDF_CMap>> cmaps_;
   std::array<std::unique_ptr<CPDF_CID2UnicodeMap>,
              fxcrt::to_underlying(CIDSet::kNumSets)>
@@ -30,6 +30,7 @@
 #include "core/fpdfapi/parser/fpdf_parser_decode.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fxcodec/basic/basicmodule.h"
+#include "core/fxcodec/binning_decoder.h"
 #include "core/fxcodec/icc/icc_transform.h"
 #include "core/fxcodec/jbig2/jbig2_decoder.h"
 #include "core/fxcodec/jpeg/jpegmodule.h"
@@ -290,8 +291,9 @@ CPDF_DIB::LoadState CPDF_DIB::ContinueLoadDIBBase(PauseIndicatorIface* pPause) {
     }
     const bool reject_large_regions_when_fuzzing = false;
     iDecodeStatus = Jbig2Decoder::StartDecode(
-        jbig_2context_.get(), document_->GetOrCreateCodecContext(), GetWidth(),
-        GetHeight(), pSrcSpan, nSrcKey, pGlobalSpan, nGlobalKey,
+        jbig_2context_.get(), document_->GetOrCreateCodecContext(),
+        cached_bitmap_->GetWidth(), cached_bitmap_->GetHeight(), pSrcSpan,
+        nSrcKey, pGlobalSpan, nGlobalKey,
         cached_bitmap_->GetWritableBuffer(), cached_bitmap_->GetPitch(), pPause,
         reject_large_regions_when_fuzzing);
   } else {
@@ -307,6 +309,12 @@ CPDF_DIB::LoadState CPDF_DIB::ContinueLoadDIBBase(PauseIndicatorIface* pPause) {
   if (iDecodeStatus == FXCODEC_STATUS::kDecodeToBeContinued) {
     return LoadState::kContinue;
   }
+  if (binning_shift_ && !BinJbig2Bitmap()) {
+    jbig_2context_.reset();
+    cached_bitmap_.Reset();
+    global_acc_.Reset();
+    return LoadState::kFail;
+  }
 
   LoadState iContinueStatus = LoadState::kSuccess;
   if (has_mask_) {
@@ -483,6 +491,11 @@ CPDF_DIB::LoadState CPDF_DIB::CreateDecoder(uint8_t resolution_levels_to_skip) {
       cached_bitmap_.Reset();
       return LoadState::kFail;
     }
+    // JBIG2 regions can only be decoded at full size. BinJbig2Bitmap() bins
+    // the result once decoding finishes, so only the binned size is kept.
+    if (resolution_levels_to_skip > 0 && CanBin()) {
+      SetBinning(resolution_levels_to_skip);
+    }
     status_ = LoadState::kSuccess;
     return LoadState::kContinue;
   }
@@ -519,9 +532,77 @@ CPDF_DIB::LoadState CPDF_DIB::CreateDecoder(uint8_t resolution_levels_to_skip) {
   if (provided_pitch.value() < requested_pitch.value()) {
     return LoadState::kFail;
   }
+
+  // Decoders for DCTDecode scale themselves. See CreateDCTDecoder().
+  if (decoder != "DCTDecode" && resolution_levels_to_skip > 0 && CanBin() &&
+      decoder_->GetBPC() == static_cast<int>(bpc_) &&
+      decoder_->CountComps() == static_cast<int>(components_)) {
+    std::unique_ptr<ScanlineDecoder> binning_decoder = BinningDecoder::Create(
+        std::move(decoder_), std::min<int>(resolution_levels_to_skip, 3));
+    if (!binning_decoder) {
+      return LoadState::kFail;
+    }
+    decoder_ = std::move(binning_decoder);
+    SetBinning(resolution_levels_to_skip);
+  }
   return LoadState::kSuccess;
 }
 
+bool CPDF_DIB::CanBin() const {
+  // Averaging does not work for palette indices, or for values that get
+  // compared against a color key.
+  if (color_key_) {
+    return false;
+  }
+  if (image_mask_) {
+    return bpc_ == 1;
+  }
+  if (!color_space_ || family_ == CPDF_ColorSpace::Family::kIndexed ||
+      family_ == CPDF_ColorSpace::Family::kPattern) {
+    return false;
+  }
+  if (bpc_ == 1) {
+    return components_ == 1 && color_space_->ComponentCount() == 1;
+  }
+  return bpc_ == 8 && RowBinner::IsSupportedFormat(components_, bpc_);
+}
+
+void CPDF_DIB::SetBinning(uint8_t resolution_levels_to_skip) {
+  binning_shift_ = std::min<int>(resolution_levels_to_skip, 3);
+  SetWidth(RowBinner::GetBinnedSize(GetWidth(), binning_shift_));
+  SetHeight(RowBinner::GetBinnedSize(GetHeight(), binning_shift_));
+  if (bpc_ == 1) {
+    // Binned 1 bpc samples are coverage values from 0 to 255.
+    bpc_ = 8;
+    for (DIB_COMP_DATA& data : comp_data_) {
+      data.decode_step_ /= 255;
+    }
+  }
+}
+
+bool CPDF_DIB::BinJbig2Bitmap() {
+  auto binned_bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  if (!binned_bitmap->Create(
+          GetWidth(), GetHeight(),
+          image_mask_ ? FXDIB_Format::k8bppMask : FXDIB_Format::k8bppRgb)) {
+    return false;
+  }
+
+  const int src_height = cached_bitmap_->GetHeight();
+  RowBinner binner(cached_bitmap_->GetWidth(), 1, 1, binning_shift_);
+  for (int row = 0; row < GetHeight(); ++row) {
+    const int first_line = row << binning_shift_;
+    const int end_line = std::min(first_line + (1 << binning_shift_),
+                                  src_height);
+    for (int line = first_line; line < end_line; ++line) {
+      binner.AddRow(cached_bitmap_->GetScanline(line));
+    }
+    binner.TakeRow(binned_bitmap->GetWritableScanline(row));
+  }
+  cached_bitmap_ = std::move(binned_bitmap);
+  return true;
+}
+
 bool CPDF_DIB::CreateDCTDecoder(pdfium::span<const uint8_t> src_span,
                                 const CPDF_Dictionary* pParams,
                                 uint8_t resolution_levels_to_skip) {
@@ -1193,6 +1274,20 @@ pdfium::span<const uint8_t> CPDF_DIB::GetScanline(int line) const {
   }
   if (bpc_ * components_ <= 8) {
     pdfium::span<uint8_t> result = line_buf_;
+    if (image_mask_) {
+      // Only binned image masks get here. Each sample has the share of 1 bits
+      // in its box.
+      pdfium::span<const uint8_t> src_span = src_line.first(src_pitch_value);
+      result = result.first(src_pitch_value);
+      if (default_decode_) {
+        for (auto [src, dest] : fxcrt::Zip(src_span, result)) {
+          dest = ~src;
+        }
+      } else {
+        fxcrt::Copy(src_span, result);
+      }
+      return result;
+    }
     if (bpc_ == 8) {
       fxcrt::Copy(src_line.first(src_pitch_value), result);
       result = result.first(src_pitch_value);
@@ -1309,8 +1404,13 @@ bool CPDF_DIB::TransMask() const {
 }
 
 void CPDF_DIB::SetMaskProperties() {
-  bpc_ = 1;
   components_ = 1;
+  if (binning_shift_) {
+    // Binned image masks hold coverage values. See SetBinning().
+    SetFormat(FXDIB_Format::k8bppMask);
+    return;
+  }
+  bpc_ = 1;
   SetFormat(FXDIB_Format::k1bppMask);
 }
 
@@ -97,6 +97,12 @@ class CPDF_DIB final : public CFX_DIBBase {
       uint32_t height);
   void LoadPalette();
   LoadState CreateDecoder(uint8_t resolution_levels_to_skip);
+  // Whether samples can be averaged when decoding at a reduced size.
+  bool CanBin() const;
+  // Halves the size `resolution_levels_to_skip` times, up to 3 times, and
+  // adjusts the sample format to what RowBinner produces.
+  void SetBinning(uint8_t resolution_levels_to_skip);
+  bool BinJbig2Bitmap();
   bool CreateDCTDecoder(pdfium::span<const uint8_t> src_span,
                         const CPDF_Dictionary* pParams,
                         uint8_t resolution_levels_to_skip);
@@ -131,6 +137,9 @@ class CPDF_DIB final : public CFX_DIBBase {
   bool color_key_ = false;
   bool has_mask_ = false;
   bool std_cs_ = false;
+  // Non-zero when decoding at 1 / 2^binning_shift_ of the size in the
+  // dictionary. Only set for codecs without their own scaling.
+  int binning_shift_ = 0;
   std::vector<DIB_COMP_DATA> comp_data_;
   mutable DataVector<uint8_t> line_buf_;
   mutable DataVector<uint8_t> mask_buf_;
@@ -0,0 +1,227 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_dib.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "core/fpdfapi/page/cpdf_docpagedata.h"
+#include "core/fpdfapi/page/test_with_page_module.h"
+#include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_boolean.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_null.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/render/cpdf_docrenderdata.h"
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// A 44x46 CCITT group 4 image, from testing/resources/pixel/bug_1746.in.
+constexpr char kFaxData[] =
+    "26a08680de081e11e187840830f4137a4df0ef4dbedbffff6ffdaf0c2f1f"
+    "fff21b34c82e33044e7c11a09c205e105e97a5e97a5ffa5fe0a3f5ffafff"
+    "b5c9aaa30bed27adb4ad70da4da5b6128f0c426b216818500100100a";
+
+// The same image as a JBIG2 generic region with MMR coding, after a page
+// information segment.
+constexpr char kJbig2Data[] =
+    "00000000300001000000130000002c0000002e000000000000000000000000000001260001"
+    "0000006a0000002c0000002e0000000000000000000126a08680de081e11e187840830f413"
+    "7a4df0ef4dbedbffff6ffdaf0c2f1ffff21b34c82e33044e7c11a09c205e105e97a5e97a5f"
+    "fa5fe0a3f5ffafffb5c9aaa30bed27adb4ad70da4da5b6128f0c426b216818500100100a";
+
+enum class ImageType { kGray, kGrayInverted, kMask, kMaskInverted };
+
+RetainPtr<CPDF_Stream> CreateImageStream(ImageType type,
+                                         const char* hex_data,
+                                         int width,
+                                         int height,
+                                         RetainPtr<CPDF_Object> filter,
+                                         RetainPtr<CPDF_Object> parms) {
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Name>("Type", "XObject");
+  dict->SetNewFor<CPDF_Name>("Subtype", "Image");
+  dict->SetNewFor<CPDF_Number>("Width", width);
+  dict->SetNewFor<CPDF_Number>("Height", height);
+  dict->SetNewFor<CPDF_Number>("BitsPerComponent", 1);
+  auto filters = dict->SetNewFor<CPDF_Array>("Filter");
+  filters->AppendNew<CPDF_Name>("ASCIIHexDecode");
+  filters->Append(std::move(filter));
+  if (parms) {
+    auto decode_parms = dict->SetNewFor<CPDF_Array>("DecodeParms");
+    decode_parms->AppendNew<CPDF_Null>();
+    decode_parms->Append(std::move(parms));
+  }
+  if (type == ImageType::kMask || type == ImageType::kMaskInverted) {
+    dict->SetNewFor<CPDF_Boolean>("ImageMask", true);
+  } else {
+    dict->SetNewFor<CPDF_Name>("ColorSpace", "DeviceGray");
+  }
+  if (type == ImageType::kGrayInverted || type == ImageType::kMaskInverted) {
+    auto decode = dict->SetNewFor<CPDF_Array>("Decode");
+    decode->AppendNew<CPDF_Number>(1);
+    decode->AppendNew<CPDF_Number>(0);
+  }
+  auto data = pdfium::as_bytes(pdfium::span(hex_data, strlen(hex_data)));
+  return pdfium::MakeRetain<CPDF_Stream>(
+      DataVector<uint8_t>(data.begin(), data.end()), std::move(dict));
+}
+
+RetainPtr<CPDF_Stream> CreateFaxImage(ImageType type) {
+  auto parms = pdfium::MakeRetain<CPDF_Dictionary>();
+  parms->SetNewFor<CPDF_Number>("Columns", 44);
+  parms->SetNewFor<CPDF_Number>("K", -1);
+  return CreateImageStream(
+      type, kFaxData, 44, 46,
+      pdfium::MakeRetain<CPDF_Name>(nullptr, "CCITTFaxDecode"),
+      std::move(parms));
+}
+
+RetainPtr<CPDF_Stream> CreateJbig2Image(ImageType type) {
+  return CreateImageStream(
+      type, kJbig2Data, 44, 46,
+      pdfium::MakeRetain<CPDF_Name>(nullptr, "JBIG2Decode"), nullptr);
+}
+
+// Returns the gray level, or for masks the coverage, of a pixel in a 1 or
+// 8 bpp bitmap.
+int GetLevel(const CFX_DIBBase& bitmap, int x, int y) {
+  pdfium::span<const uint8_t> scanline = bitmap.GetScanline(y);
+  const int value = bitmap.GetBPP() == 1
+                        ? (scanline[x / 8] >> (7 - x % 8)) & 1
+                        : scanline[x];
+  if (bitmap.HasPalette()) {
+    return FXARGB_B(bitmap.GetPaletteSpan()[value]);
+  }
+  return bitmap.GetBPP() == 1 ? value * 255 : value;
+}
+
+class CPDFDIBTest : public TestWithPageModule {
+ public:
+  void SetUp() override {
+    TestWithPageModule::SetUp();
+    doc_ = std::make_unique<CPDF_Document>(
+        std::make_unique<CPDF_DocRenderData>(),
+        std::make_unique<CPDF_DocPageData>());
+  }
+
+  void TearDown() override {
+    doc_.reset();
+    TestWithPageModule::TearDown();
+  }
+
+  RetainPtr<CPDF_DIB> LoadDIB(RetainPtr<const CPDF_Stream> stream,
+                              const CFX_Size& max_size_required) {
+    auto dib = pdfium::MakeRetain<CPDF_DIB>(doc_.get(), std::move(stream));
+    CPDF_DIB::LoadState state = dib->StartLoadDIBBase(
+        false, nullptr, nullptr, false, CPDF_ColorSpace::Family::kUnknown,
+        false, max_size_required);
+    while (state == CPDF_DIB::LoadState::kContinue) {
+      state = dib->ContinueLoadDIBBase(nullptr);
+    }
+    if (state != CPDF_DIB::LoadState::kSuccess) {
+      return nullptr;
+    }
+    return dib;
+  }
+
+  // Checks that decoding `stream` at 1 / 2^shift of its size gives the
+  // average of each box of pixels of the full size image.
+  void CheckBinnedMatchesFullSize(RetainPtr<const CPDF_Stream> stream,
+                                  const CFX_Size& max_size_required,
+                                  int shift) {
+    RetainPtr<CPDF_DIB> full = LoadDIB(stream, {0, 0});
+    ASSERT_TRUE(full);
+    ASSERT_EQ(1, full->GetBPP());
+    RetainPtr<CPDF_DIB> binned = LoadDIB(stream, max_size_required);
+    ASSERT_TRUE(binned);
+    ASSERT_EQ(8, binned->GetBPP());
+    EXPECT_EQ(full->IsMaskFormat(), binned->IsMaskFormat());
+
+    const int box_size = 1 << shift;
+    ASSERT_EQ((full->GetWidth() + box_size - 1) / box_size,
+              binned->GetWidth());
+    ASSERT_EQ((full->GetHeight() + box_size - 1) / box_size,
+              binned->GetHeight());
+    int min_level = 255;
+    int max_level = 0;
+    for (int y = 0; y < binned->GetHeight(); ++y) {
+      for (int x = 0; x < binned->GetWidth(); ++x) {
+        int sum = 0;
+        int count = 0;
+        for (int full_y = y * box_size;
+             full_y < std::min((y + 1) * box_size, full->GetHeight());
+             ++full_y) {
+          for (int full_x = x * box_size;
+               full_x < std::min((x + 1) * box_size, full->GetWidth());
+               ++full_x) {
+            sum += GetLevel(*full, full_x, full_y);
+            ++count;
+          }
+        }
+        const int level = GetLevel(*binned, x, y);
+        EXPECT_NEAR(static_cast<double>(sum) / count, level, 1.0)
+            << " at " << x << ", " << y;
+        min_level = std::min(min_level, level);
+        max_level = std::max(max_level, level);
+      }
+    }
+    // Make sure the image is not blank.
+    EXPECT_LT(min_level, max_level);
+  }
+
+ private:
+  std::unique_ptr<CPDF_Document> doc_;
+};
+
+}  // namespace
+
+TEST_F(CPDFDIBTest, FullSizeWithoutMaxSize) {
+  RetainPtr<CPDF_DIB> dib = LoadDIB(CreateFaxImage(ImageType::kGray), {0, 0});
+  ASSERT_TRUE(dib);
+  EXPECT_EQ(44, dib->GetWidth());
+  EXPECT_EQ(46, dib->GetHeight());
+  EXPECT_EQ(1, dib->GetBPP());
+}
+
+TEST_F(CPDFDIBTest, BinFaxGray) {
+  CheckBinnedMatchesFullSize(CreateFaxImage(ImageType::kGray), {11, 11}, 2);
+}
+
+TEST_F(CPDFDIBTest, BinFaxGrayWithDecode) {
+  CheckBinnedMatchesFullSize(CreateFaxImage(ImageType::kGrayInverted),
+                             {11, 11}, 2);
+}
+
+TEST_F(CPDFDIBTest, BinFaxImageMask) {
+  CheckBinnedMatchesFullSize(CreateFaxImage(ImageType::kMask), {22, 23}, 1);
+}
+
+TEST_F(CPDFDIBTest, BinFaxInvertedImageMask) {
+  CheckBinnedMatchesFullSize(CreateFaxImage(ImageType::kMaskInverted),
+                             {5, 5}, 3);
+}
+
+TEST_F(CPDFDIBTest, BinJbig2Gray) {
+  CheckBinnedMatchesFullSize(CreateJbig2Image(ImageType::kGrayInverted),
+                             {11, 11}, 2);
+}
+
+TEST_F(CPDFDIBTest, BinJbig2ImageMask) {
+  CheckBinnedMatchesFullSize(CreateJbig2Image(ImageType::kMask), {5, 5}, 3);
+}
@@ -169,6 +169,41 @@ RetainPtr<CPDF_Dictionary> CalculateFontDesc(CPDF_Document* doc,
   return font_desc;
 }
 
+// Rough sizes of cached objects, for CFX_CacheBudget. Fonts are dominated by
+// embedded font files, and ICC profiles by the profile data.
+size_t EstimateFontSize(const CPDF_Font* font) {
+  size_t size = sizeof(CPDF_Font);
+  if (font->IsEmbedded()) {
+    size += font->GetFont()->GetFontSpan().size();
+  }
+  return size;
+}
+
+size_t EstimateIccProfileSize(const CPDF_StreamAcc* profile_data) {
+  return sizeof(CPDF_IccProfile) + profile_data->GetSize();
+}
+
+// Drops the entries of `map` flagged by CFX_CacheBudget that only the map
+// refers to. Flagged entries that are still in use are marked as used
+// instead.
+template <typename Map>
+void ReleaseEvictedEntries(Map& map, CFX_CacheBudget::CacheType type) {
+  for (auto it = map.begin(); it != map.end();) {
+    auto& entry = it->second;
+    if (!entry.charge.IsEvictionRequested()) {
+      ++it;
+      continue;
+    }
+    if (entry.object && !entry.object->HasOneRef()) {
+      entry.charge.Touch();
+      ++it;
+      continue;
+    }
+    it = map.erase(it);
+    CFX_CacheBudget::Get()->RecordEviction(type);
+  }
+}
+
 }  // namespace
 
 // static
@@ -183,7 +218,7 @@ CPDF_DocPageData::~CPDF_DocPageData() {
     it.second->WillBeDestroyed();
   }
   for (auto& it : font_map_) {
-    it.second->WillBeDestroyed();
+    it.second.object->WillBeDestroyed();
   }
 }
 
@@ -215,17 +250,23 @@ RetainPtr<CPDF_Font> CPDF_DocPageData::GetFont(
     return nullptr;
   }
 
+  ReleaseEvictedObjects();
+  CFX_CacheBudget* budget = CFX_CacheBudget::Get();
   auto it = font_map_.find(font_dict);
-  if (it != font_map_.end() && it->second) {
-    return pdfium::WrapRetain(it->second.Get());
+  if (it != font_map_.end() && it->second.object) {
+    budget->RecordHit(CFX_CacheBudget::CacheType::kFont);
+    it->second.charge.Touch();
+    return it->second.object;
   }
 
+  budget->RecordMiss(CFX_CacheBudget::CacheType::kFont);
   RetainPtr<CPDF_Font> font = CPDF_Font::Create(GetDocument(), font_dict, this);
   if (!font) {
     return nullptr;
   }
 
-  font_map_[std::move(font_dict)].Reset(font.Get());
+  font_map_[std::move(font_dict)] = CreateCachedObject(
+      font, CFX_CacheBudget::CacheType::kFont, EstimateFontSize(font.Get()));
   return font;
 }
 
@@ -236,8 +277,10 @@ RetainPtr<CPDF_Font> CPDF_DocPageData::GetStandardFont(
     return nullptr;
   }
 
+  ReleaseEvictedObjects();
+  CFX_CacheBudget* budget = CFX_CacheBudget::Get();
   for (auto& it : font_map_) {
-    CPDF_Font* font = it.second.Get();
+    CPDF_Font* font = it.second.object.Get();
     if (!font) {
       continue;
     }
@@ -259,9 +302,12 @@ RetainPtr<CPDF_Font> CPDF_DocPageData::GetStandardFont(
       continue;
     }
 
+    budget->RecordHit(CFX_CacheBudget::CacheType::kFont);
+    it.second.charge.Touch();
     return pdfium::WrapRetain(font);
   }
 
+  budget->RecordMiss(CFX_CacheBudget::CacheType::kFont);
   auto dict = GetDocument()->NewIndirect<CPDF_Dictionary>();
   dict->SetNewFor<CPDF_Name>("Type", "Font");
   dict->SetNewFor<CPDF_Name>("Subtype", "Type1");
@@ -277,13 +323,15 @@ RetainPtr<CPDF_Font> CPDF_DocPageData::GetStandardFont(
     return nullptr;
   }
 
-  font_map_[std::move(dict)].Reset(font.Get());
+  font_map_[std::move(dict)] = CreateCachedObject(
+      font, CFX_CacheBudget::CacheType::kFont, EstimateFontSize(font.Get()));
   return font;
 }
 
 RetainPtr<CPDF_ColorSpace> CPDF_DocPageData::GetColorSpace(
     const CPDF_Object* pCSObj,
     const CPDF_Dictionary* pResources) {
+  ReleaseEvictedObjects();
   std::set<const CPDF_Object*> visited;
   return GetColorSpaceGuarded(pCSObj, pResources, &visited);
 }
@@ -365,18 +413,24 @@ RetainPtr<CPDF_ColorSpace> CPDF_DocPageData::GetColorSpaceInternal(
                                  pVisited, pVisitedInternal);
   }
 
+  CFX_CacheBudget* budget = CFX_CacheBudget::Get();
   auto it = color_space_map_.find(pArray);
-  if (it != color_space_map_.end() && it->second) {
-    return pdfium::WrapRetain(it->second.Get());
+  if (it != color_space_map_.end() && it->second.object) {
+    budget->RecordHit(CFX_CacheBudget::CacheType::kColorSpace);
+    it->second.charge.Touch();
+    return it->second.object;
   }
 
+  budget->RecordMiss(CFX_CacheBudget::CacheType::kColorSpace);
   RetainPtr<CPDF_ColorSpace> pCS =
       CPDF_ColorSpace::Load(GetDocument(), pArray.Get(), pVisited);
   if (!pCS) {
     return nullptr;
   }
 
-  color_space_map_[std::move(pArray)].Reset(pCS.Get());
+  color_space_map_[std::move(pArray)] =
+      CreateCachedObject(pCS, CFX_CacheBudget::CacheType::kColorSpace,
+                         sizeof(CPDF_ColorSpace));
   return pCS;
 }
 
@@ -447,9 +501,13 @@ RetainPtr<CPDF_IccProfile> CPDF_DocPageData::GetIccProfile(
     RetainPtr<const CPDF_Stream> pProfileStream) {
   CHECK(pProfileStream);
 
+  ReleaseEvictedObjects();
+  CFX_CacheBudget* budget = CFX_CacheBudget::Get();
   auto it = icc_profile_map_.find(pProfileStream);
   if (it != icc_profile_map_.end()) {
-    return it->second;
+    budget->RecordHit(CFX_CacheBudget::CacheType::kIccProfile);
+    it->second.charge.Touch();
+    return it->second.object;
   }
 
   auto pAccessor = pdfium::MakeRetain<CPDF_StreamAcc>(pProfileStream);
@@ -468,12 +526,17 @@ RetainPtr<CPDF_IccProfile> CPDF_DocPageData::GetIccProfile(
   if (hash_it != hash_icc_profile_map_.end()) {
     auto it_copied_stream = icc_profile_map_.find(hash_it->second);
     if (it_copied_stream != icc_profile_map_.end()) {
-      return it_copied_stream->second;
+      budget->RecordHit(CFX_CacheBudget::CacheType::kIccProfile);
+      it_copied_stream->second.charge.Touch();
+      return it_copied_stream->second.object;
     }
   }
+  budget->RecordMiss(CFX_CacheBudget::CacheType::kIccProfile);
   auto pProfile =
       pdfium::MakeRetain<CPDF_IccProfile>(pAccessor, expected_components);
-  icc_profile_map_[pProfileStream] = pProfile;
+  icc_profile_map_[pProfileStream] =
+      CreateCachedObject(pProfile, CFX_CacheBudget::CacheType::kIccProfile,
+                         EstimateIccProfileSize(pAccessor.Get()));
   hash_icc_profile_map_[hash_profile_key] = std::move(pProfileStream);
   return pProfile;
 }
@@ -522,6 +585,30 @@ void CPDF_DocPageData::MaybePurgeFontFileStreamAcc(
   }
 }
 
+template <typename T>
+CPDF_DocPageData::CachedObject<T> CPDF_DocPageData::CreateCachedObject(
+    RetainPtr<T> object,
+    CFX_CacheBudget::CacheType type,
+    size_t bytes) {
+  CachedObject<T> cached;
+  cached.object = std::move(object);
+  cached.charge = CFX_CacheBudget::Get()->CreateCharge(type, this);
+  cached.charge.SetSize(bytes);
+  return cached;
+}
+
+void CPDF_DocPageData::ReleaseEvictedObjects() {
+  if (!TakeEvictionRequest()) {
+    return;
+  }
+
+  ReleaseEvictedEntries(font_map_, CFX_CacheBudget::CacheType::kFont);
+  ReleaseEvictedEntries(color_space_map_,
+                        CFX_CacheBudget::CacheType::kColorSpace);
+  ReleaseEvictedEntries(icc_profile_map_,
+                        CFX_CacheBudget::CacheType::kIccProfile);
+}
+
 std::unique_ptr<CPDF_Font::FormIface> CPDF_DocPageData::CreateForm(
     CPDF_Document* document,
     RetainPtr<CPDF_Dictionary> pPageResources,
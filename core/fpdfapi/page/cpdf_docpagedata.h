@@ -15,6 +15,7 @@
 #include "core/fpdfapi/page/cpdf_colorspace.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/cfx_cachebudget.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_codepage_forward.h"
 #include "core/fxcrt/fx_coordinates.h"
@@ -31,7 +32,8 @@ class CPDF_Stream;
 class CPDF_StreamAcc;
 
 class CPDF_DocPageData final : public CPDF_Document::PageDataIface,
-                               public CPDF_Font::FormFactoryIface {
+                               public CPDF_Font::FormFactoryIface,
+                               public CFX_CacheBudget::Client {
  public:
   static CPDF_DocPageData* FromDocument(const CPDF_Document* doc);
 
@@ -54,6 +56,11 @@ class CPDF_DocPageData final : public CPDF_Document::PageDataIface,
 
   bool IsForceClear() const { return force_clear_; }
 
+  // Drops the objects CFX_CacheBudget asked to evict, where possible. Called
+  // on each lookup, and when a page closes so that an idle document does not
+  // keep them.
+  void ReleaseEvictedObjects();
+
   RetainPtr<CPDF_Font> AddFont(std::unique_ptr<CFX_Font> font,
                                FX_Charset charset);
   RetainPtr<CPDF_Font> GetFont(RetainPtr<CPDF_Dictionary> font_dict);
@@ -88,6 +95,14 @@ class CPDF_DocPageData final : public CPDF_Document::PageDataIface,
       RetainPtr<const CPDF_Stream> pProfileStream);
 
  private:
+  // A cached object and the memory charged for it. Fonts, colorspaces and
+  // ICC profiles are evicted once nothing but the cache refers to them.
+  template <typename T>
+  struct CachedObject {
+    RetainPtr<T> object;
+    CFX_CacheBudget::Charge charge;
+  };
+
   struct HashIccProfileKey {
     HashIccProfileKey(DataVector<uint8_t> digest, uint32_t components);
     HashIccProfileKey(const HashIccProfileKey& that);
@@ -110,6 +125,11 @@ class CPDF_DocPageData final : public CPDF_Document::PageDataIface,
       std::set<const CPDF_Object*>* pVisited,
       std::set<const CPDF_Object*>* pVisitedInternal);
 
+  template <typename T>
+  CachedObject<T> CreateCachedObject(RetainPtr<T> object,
+                                     CFX_CacheBudget::CacheType type,
+                                     size_t bytes);
+
   size_t CalculateEncodingDict(FX_Charset charset, CPDF_Dictionary* pBaseDict);
   RetainPtr<CPDF_Dictionary> ProcessbCJK(
       RetainPtr<CPDF_Dictionary> pBaseDict,
@@ -122,15 +142,16 @@ class CPDF_DocPageData final : public CPDF_Document::PageDataIface,
   // Specific destruction order may be required between maps.
   std::map<HashIccProfileKey, RetainPtr<const CPDF_Stream>>
       hash_icc_profile_map_;
-  std::map<RetainPtr<const CPDF_Array>, RetainPtr<CPDF_ColorSpace>>
+  std::map<RetainPtr<const CPDF_Array>, CachedObject<CPDF_ColorSpace>>
       color_space_map_;
   std::map<RetainPtr<const CPDF_Stream>, RetainPtr<CPDF_StreamAcc>>
       font_file_map_;
-  std::map<RetainPtr<const CPDF_Stream>, RetainPtr<CPDF_IccProfile>>
+  std::map<RetainPtr<const CPDF_Stream>, CachedObject<CPDF_IccProfile>>
       icc_profile_map_;
   std::map<RetainPtr<const CPDF_Object>, RetainPtr<CPDF_Pattern>> pattern_map_;
   std::map<uint32_t, RetainPtr<CPDF_Image>> image_map_;
-  std::map<RetainPtr<const CPDF_Dictionary>, RetainPtr<CPDF_Font>> font_map_;
+  std::map<RetainPtr<const CPDF_Dictionary>, CachedObject<CPDF_Font>>
+      font_map_;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_DOCPAGEDATA_H_
@@ -69,3 +69,25 @@ bool CPDF_ExpIntFunc::v_Call(pdfium::span<const float> inputs,
   }
   return true;
 }
+
+bool CPDF_ExpIntFunc::v_CallBatch(pdfium::span<const float> inputs,
+                                  pdfium::span<float> results) const {
+  // Each input, whichever set it is in, gives the next `orig_outputs_`
+  // results. Raise all of them to the exponent first, so the loop below only
+  // does multiply-adds.
+  DataVector<float> factors(inputs.begin(), inputs.end());
+  if (exponent_ != 1.0f) {
+    for (float& factor : factors) {
+      factor = powf(factor, exponent_);
+    }
+  }
+  for (size_t i = 0; i < factors.size(); i++) {
+    pdfium::span<float> group =
+        results.subspan(i * orig_outputs_, orig_outputs_);
+    for (uint32_t j = 0; j < orig_outputs_; j++) {
+      group[j] =
+          begin_values_[j] + factors[i] * (end_values_[j] - begin_values_[j]);
+    }
+  }
+  return true;
+}
@@ -23,6 +23,8 @@ class CPDF_ExpIntFunc final : public CPDF_Function {
   bool v_Init(const CPDF_Object* pObj, VisitedSet* pVisited) override;
   bool v_Call(pdfium::span<const float> inputs,
               pdfium::span<float> results) const override;
+  bool v_CallBatch(pdfium::span<const float> inputs,
+                   pdfium::span<float> results) const override;
 
   uint32_t GetOrigOutputs() const { return orig_outputs_; }
   float GetExponent() const { return exponent_; }
@@ -173,6 +173,63 @@ std::optional<uint32_t> CPDF_Function::Call(pdfium::span<const float> inputs,
   return outputs_;
 }
 
+std::optional<uint32_t> CPDF_Function::CallBatch(
+    pdfium::span<const float> inputs,
+    pdfium::span<float> results) const {
+  if (inputs_ == 0 || inputs.size() % inputs_ != 0) {
+    return std::nullopt;
+  }
+  const size_t count = inputs.size() / inputs_;
+  if (results.size() < count * outputs_) {
+    return std::nullopt;
+  }
+
+  std::vector<float> clamped_inputs(inputs.begin(), inputs.end());
+  for (uint32_t i = 0; i < inputs_; i++) {
+    float domain1 = domains_[i * 2];
+    float domain2 = domains_[i * 2 + 1];
+    if (domain1 > domain2) {
+      return std::nullopt;
+    }
+
+    for (size_t j = i; j < clamped_inputs.size(); j += inputs_) {
+      clamped_inputs[j] = std::clamp(clamped_inputs[j], domain1, domain2);
+    }
+  }
+  if (!v_CallBatch(clamped_inputs, results.first(count * outputs_))) {
+    return std::nullopt;
+  }
+
+  if (ranges_.empty()) {
+    return outputs_;
+  }
+
+  for (uint32_t i = 0; i < outputs_; i++) {
+    float range1 = ranges_[i * 2];
+    float range2 = ranges_[i * 2 + 1];
+    if (range1 > range2) {
+      return std::nullopt;
+    }
+
+    for (size_t j = i; j < count * outputs_; j += outputs_) {
+      results[j] = std::clamp(results[j], range1, range2);
+    }
+  }
+  return outputs_;
+}
+
+bool CPDF_Function::v_CallBatch(pdfium::span<const float> inputs,
+                                pdfium::span<float> results) const {
+  const size_t count = inputs.size() / inputs_;
+  for (size_t i = 0; i < count; i++) {
+    if (!v_Call(inputs.subspan(i * inputs_, inputs_),
+                results.subspan(i * outputs_, outputs_))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // See PDF Reference 1.7, page 170.
 float CPDF_Function::Interpolate(float x,
                                  float xmin,
@@ -38,6 +38,12 @@ class CPDF_Function {
 
   std::optional<uint32_t> Call(pdfium::span<const float> inputs,
                                pdfium::span<float> results) const;
+
+  // Same as Call() for `inputs.size() / InputCount()` sets of inputs stored
+  // one after another. Writes OutputCount() results for each set to
+  // `results`. Returns std::nullopt if any set fails.
+  std::optional<uint32_t> CallBatch(pdfium::span<const float> inputs,
+                                    pdfium::span<float> results) const;
   uint32_t InputCount() const { return inputs_; }
   uint32_t OutputCount() const { return outputs_; }
   float GetDomain(int i) const { return domains_[i]; }
@@ -66,6 +72,10 @@ class CPDF_Function {
   virtual bool v_Init(const CPDF_Object* pObj, VisitedSet* pVisited) = 0;
   virtual bool v_Call(pdfium::span<const float> inputs,
                       pdfium::span<float> results) const = 0;
+  // Called by CallBatch() with clamped inputs. The default implementation
+  // calls v_Call() for each set.
+  virtual bool v_CallBatch(pdfium::span<const float> inputs,
+                           pdfium::span<float> results) const;
 
   const Type type_;
   uint32_t inputs_ = 0;
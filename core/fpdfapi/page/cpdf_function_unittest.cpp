@@ -4,12 +4,63 @@
 
 #include "core/fpdfapi/page/cpdf_function.h"
 
+#include <utility>
+#include <vector>
+
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+namespace {
+
+RetainPtr<CPDF_Array> MakeArray(std::initializer_list<float> values) {
+  auto array = pdfium::MakeRetain<CPDF_Array>();
+  for (float value : values) {
+    array->AppendNew<CPDF_Number>(value);
+  }
+  return array;
+}
+
+RetainPtr<CPDF_Dictionary> MakeExponentialFunction(float c0,
+                                                   float c1,
+                                                   float exponent) {
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Number>("FunctionType", 2);
+  dict->SetFor("Domain", MakeArray({0.0f, 1.0f}));
+  dict->SetFor("C0", MakeArray({c0, c1}));
+  dict->SetFor("C1", MakeArray({c1, c0}));
+  dict->SetNewFor<CPDF_Number>("N", exponent);
+  return dict;
+}
+
+// Checks that CallBatch() gives the same results as Call() for each set.
+void CheckCallBatchSameAsCall(const CPDF_Function& func,
+                              const std::vector<float>& inputs) {
+  const uint32_t input_count = func.InputCount();
+  const uint32_t output_count = func.OutputCount();
+  const size_t count = inputs.size() / input_count;
+  std::vector<float> results(count * output_count);
+  ASSERT_EQ(output_count, func.CallBatch(inputs, results));
+  std::vector<float> expected(output_count);
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(output_count,
+              func.Call(pdfium::span(inputs).subspan(i * input_count,
+                                                     input_count),
+                        expected));
+    for (uint32_t j = 0; j < output_count; ++j) {
+      EXPECT_EQ(expected[j], results[i * output_count + j])
+          << "set " << i << " output " << j;
+    }
+  }
+}
+
+}  // namespace
+
 TEST(CPDFFunction, BadFunctionType) {
   auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
   dict->SetNewFor<CPDF_Number>("FunctionType", -2);
@@ -41,3 +92,104 @@ TEST(CPDFFunction, NoRange) {
   pArray->AppendNew<CPDF_Number>(10);
   EXPECT_FALSE(CPDF_Function::Load(dict));
 }
+
+TEST(CPDFFunction, CallBatch) {
+  // The second program rolls by a computed amount, so it runs in the
+  // interpreter instead of being compiled.
+  for (ByteStringView code : {"{ 2 copy add 3 1 roll sub }",
+                              "{ 2 copy add 3 1 roll sub 1 1 index 0 mul cvi "
+                              "roll }"}) {
+    auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+    dict->SetNewFor<CPDF_Number>("FunctionType", 4);
+    auto domain = dict->SetNewFor<CPDF_Array>("Domain");
+    for (float value : {0.0f, 1.0f, 0.0f, 1.0f}) {
+      domain->AppendNew<CPDF_Number>(value);
+    }
+    auto range = dict->SetNewFor<CPDF_Array>("Range");
+    for (float value : {0.0f, 1.5f, -0.25f, 1.0f}) {
+      range->AppendNew<CPDF_Number>(value);
+    }
+    auto stream = pdfium::MakeRetain<CPDF_Stream>(
+        DataVector<uint8_t>(code.unsigned_span().begin(),
+                            code.unsigned_span().end()),
+        std::move(dict));
+    std::unique_ptr<CPDF_Function> func = CPDF_Function::Load(stream);
+    ASSERT_TRUE(func);
+
+    // Includes inputs outside the domain, and results outside the range.
+    const std::vector<float> inputs = {0.5f, 0.25f, 2.0f, -1.0f, 0.0f,
+                                       1.0f, 1.0f,  1.0f, 0.1f, 0.9f};
+    std::vector<float> results(inputs.size());
+    ASSERT_EQ(2u, func->CallBatch(inputs, results));
+    for (size_t i = 0; i < inputs.size(); i += 2) {
+      float expected[2];
+      ASSERT_EQ(2u, func->Call(pdfium::span(inputs).subspan(i, 2u), expected));
+      EXPECT_FLOAT_EQ(expected[0], results[i]);
+      EXPECT_FLOAT_EQ(expected[1], results[i + 1]);
+    }
+    EXPECT_FLOAT_EQ(0.75f, results[0]);
+    EXPECT_FLOAT_EQ(0.25f, results[1]);
+    EXPECT_FLOAT_EQ(-0.25f, results[5]);
+
+    // Inputs must come in whole sets.
+    EXPECT_FALSE(func->CallBatch(pdfium::span(inputs).first(3u), results));
+  }
+}
+
+TEST(CPDFFunction, CallBatchSampled) {
+  {
+    // One input, two outputs, 8 bits per sample.
+    auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+    dict->SetNewFor<CPDF_Number>("FunctionType", 0);
+    dict->SetFor("Domain", MakeArray({0.0f, 1.0f}));
+    dict->SetFor("Range", MakeArray({0.0f, 1.0f, 0.0f, 1.0f}));
+    dict->SetFor("Size", MakeArray({3.0f}));
+    dict->SetNewFor<CPDF_Number>("BitsPerSample", 8);
+    auto stream = pdfium::MakeRetain<CPDF_Stream>(
+        DataVector<uint8_t>{0, 255, 128, 64, 255, 0}, std::move(dict));
+    std::unique_ptr<CPDF_Function> func = CPDF_Function::Load(stream);
+    ASSERT_TRUE(func);
+    CheckCallBatchSameAsCall(
+        *func, {0.0f, 0.1f, 0.5f, 0.7f, 1.0f, -1.0f, 2.0f, 0.999f});
+  }
+  {
+    // Two inputs, one output, 4 bits per sample.
+    auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+    dict->SetNewFor<CPDF_Number>("FunctionType", 0);
+    dict->SetFor("Domain", MakeArray({0.0f, 1.0f, 0.0f, 1.0f}));
+    dict->SetFor("Range", MakeArray({0.0f, 1.0f}));
+    dict->SetFor("Size", MakeArray({2.0f, 3.0f}));
+    dict->SetNewFor<CPDF_Number>("BitsPerSample", 4);
+    auto stream = pdfium::MakeRetain<CPDF_Stream>(
+        DataVector<uint8_t>{0x0F, 0x37, 0xA5}, std::move(dict));
+    std::unique_ptr<CPDF_Function> func = CPDF_Function::Load(stream);
+    ASSERT_TRUE(func);
+    CheckCallBatchSameAsCall(*func, {0.0f, 0.0f, 0.3f, 0.6f, 1.0f, 0.2f,
+                                     0.5f, 1.0f, 2.0f, -1.0f, 0.9f, 0.45f});
+  }
+}
+
+TEST(CPDFFunction, CallBatchExponential) {
+  for (float exponent : {1.0f, 2.0f, 0.5f}) {
+    std::unique_ptr<CPDF_Function> func = CPDF_Function::Load(
+        MakeExponentialFunction(0.25f, 1.0f, exponent));
+    ASSERT_TRUE(func);
+    CheckCallBatchSameAsCall(*func, {0.0f, 0.1f, 0.5f, 0.7f, 1.0f, -1.0f});
+  }
+}
+
+TEST(CPDFFunction, CallBatchStitching) {
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Number>("FunctionType", 3);
+  dict->SetFor("Domain", MakeArray({0.0f, 1.0f}));
+  dict->SetFor("Bounds", MakeArray({0.25f, 0.5f}));
+  dict->SetFor("Encode", MakeArray({0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f}));
+  auto functions = dict->SetNewFor<CPDF_Array>("Functions");
+  functions->Append(MakeExponentialFunction(0.0f, 1.0f, 1.0f));
+  functions->Append(MakeExponentialFunction(0.5f, 0.75f, 2.0f));
+  functions->Append(MakeExponentialFunction(1.0f, 0.0f, 1.0f));
+  std::unique_ptr<CPDF_Function> func = CPDF_Function::Load(dict);
+  ASSERT_TRUE(func);
+  CheckCallBatchSameAsCall(*func, {0.6f, 0.0f, 0.1f, 0.25f, 0.3f, 0.5f, 0.7f,
+                                   1.0f, -1.0f, 2.0f, 0.2f});
+}
@@ -117,6 +117,7 @@ CPDF_PageImageCache::CPDF_PageImageCache(CPDF_Page* pPage) : page_(pPage) {}
 CPDF_PageImageCache::~CPDF_PageImageCache() = default;
 
 void CPDF_PageImageCache::CacheOptimization(int32_t dwLimitCacheSize) {
+  ReleaseEvictedEntries();
   if (cache_size_ <= (uint32_t)dwLimitCacheSize) {
     return;
   }
@@ -165,6 +166,24 @@ void CPDF_PageImageCache::ClearImageCacheEntry(const CPDF_Stream* pStream) {
     cur_image_cache_entry_.Reset();
   }
   image_cache_.erase(it);
+  CFX_CacheBudget::Get()->RecordEviction(
+      CFX_CacheBudget::CacheType::kPageImage);
+}
+
+void CPDF_PageImageCache::ReleaseEvictedEntries() {
+  if (!TakeEvictionRequest()) {
+    return;
+  }
+
+  std::vector<RetainPtr<const CPDF_Stream>> evicted;
+  for (const auto& it : image_cache_) {
+    if (it.second->IsEvictionRequested()) {
+      evicted.push_back(it.first);
+    }
+  }
+  for (const auto& pStream : evicted) {
+    ClearImageCacheEntry(pStream.Get());
+  }
 }
 
 bool CPDF_PageImageCache::StartGetCachedBitmap(
@@ -180,17 +199,26 @@ bool CPDF_PageImageCache::StartGetCachedBitmap(
     return false;
   }
 
+  // No bitmaps from the previous image are in use anymore.
+  ReleaseEvictedEntries();
+
   RetainPtr<const CPDF_Stream> pStream = pImage->GetStream();
   const auto it = image_cache_.find(pStream);
   cur_find_cache_ = it != image_cache_.end();
   if (cur_find_cache_) {
     cur_image_cache_entry_ = it->second.get();
   } else {
-    cur_image_cache_entry_ = std::make_unique<Entry>(std::move(pImage));
+    cur_image_cache_entry_ = std::make_unique<Entry>(std::move(pImage), this);
   }
   CPDF_DIB::LoadState ret = cur_image_cache_entry_->StartGetCachedBitmap(
       this, pFormResources, pPageResources, bStdCS, eFamily, bLoadMask,
       max_size_required);
+  // Only bitmaps served from the cache load synchronously with success.
+  if (ret == CPDF_DIB::LoadState::kSuccess) {
+    CFX_CacheBudget::Get()->RecordHit(CFX_CacheBudget::CacheType::kPageImage);
+  } else {
+    CFX_CacheBudget::Get()->RecordMiss(CFX_CacheBudget::CacheType::kPageImage);
+  }
   if (ret == CPDF_DIB::LoadState::kContinue) {
     return true;
   }
@@ -247,8 +275,12 @@ RetainPtr<CFX_DIBBase> CPDF_PageImageCache::DetachCurMask() {
   return cur_image_cache_entry_->DetachMask();
 }
 
-CPDF_PageImageCache::Entry::Entry(RetainPtr<CPDF_Image> pImage)
-    : image_(std::move(pImage)) {}
+CPDF_PageImageCache::Entry::Entry(RetainPtr<CPDF_Image> pImage,
+                                  CPDF_PageImageCache* pPageImageCache)
+    : image_(std::move(pImage)),
+      charge_(CFX_CacheBudget::Get()->CreateCharge(
+          CFX_CacheBudget::CacheType::kPageImage,
+          pPageImageCache)) {}
 
 CPDF_PageImageCache::Entry::~Entry() = default;
 
@@ -274,6 +306,7 @@ CPDF_DIB::LoadState CPDF_PageImageCache::Entry::StartGetCachedBitmap(
     bool bLoadMask,
     const CFX_Size& max_size_required) {
   if (cached_bitmap_ && IsCacheValid(max_size_required)) {
+    charge_.Touch();
     cur_bitmap_ = cached_bitmap_;
     cur_mask_ = cached_mask_;
     return CPDF_DIB::LoadState::kSuccess;
@@ -342,6 +375,7 @@ void CPDF_PageImageCache::Entry::CalcSize() {
   if (cached_mask_) {
     cache_size_ += cached_mask_->GetEstimatedImageMemoryBurden();
   }
+  charge_.SetSize(cache_size_);
 }
 
 bool CPDF_PageImageCache::Entry::IsCacheValid(
@@ -14,6 +14,7 @@
 #include <memory>
 
 #include "core/fpdfapi/page/cpdf_dib.h"
+#include "core/fxcrt/cfx_cachebudget.h"
 #include "core/fxcrt/maybe_owned.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
@@ -24,10 +25,10 @@ class CPDF_Page;
 class CPDF_Stream;
 class PauseIndicatorIface;
 
-class CPDF_PageImageCache {
+class CPDF_PageImageCache final : public CFX_CacheBudget::Client {
  public:
   explicit CPDF_PageImageCache(CPDF_Page* pPage);
-  ~CPDF_PageImageCache();
+  ~CPDF_PageImageCache() override;
 
   void ResetBitmapForImage(RetainPtr<CPDF_Image> pImage);
   void CacheOptimization(int32_t dwLimitCacheSize);
@@ -51,11 +52,12 @@ class CPDF_PageImageCache {
  private:
   class Entry {
    public:
-    explicit Entry(RetainPtr<CPDF_Image> pImage);
+    Entry(RetainPtr<CPDF_Image> pImage, CPDF_PageImageCache* pPageImageCache);
     ~Entry();
 
     void Reset();
     uint32_t EstimateSize() const { return cache_size_; }
+    bool IsEvictionRequested() const { return charge_.IsEvictionRequested(); }
     uint32_t GetMatteColor() const { return matte_color_; }
     uint32_t GetTimeCount() const { return time_count_; }
     void SetTimeCount(uint32_t count) { time_count_ = count; }
@@ -91,9 +93,12 @@ class CPDF_PageImageCache {
     RetainPtr<CFX_DIBBase> cached_bitmap_;
     RetainPtr<CFX_DIBBase> cached_mask_;
     bool cached_set_max_size_required_ = false;
+    CFX_CacheBudget::Charge charge_;
   };
 
   void ClearImageCacheEntry(const CPDF_Stream* pStream);
+  // Drops the entries CFX_CacheBudget asked to evict.
+  void ReleaseEvictedEntries();
 
   UnownedPtr<CPDF_Page> const page_;
   std::map<RetainPtr<const CPDF_Stream>, std::unique_ptr<Entry>, std::less<>>
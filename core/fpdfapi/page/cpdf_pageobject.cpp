@@ -8,6 +8,7 @@
 
 #include <utility>
 
+#include "core/fpdfapi/page/cpdf_pageobjectholder.h"
 #include "core/fxcrt/fx_coordinates.h"
 
 CPDF_PageObject::CPDF_PageObject(int32_t content_stream)
@@ -44,6 +45,13 @@ void CPDF_PageObject::SetDefaultStates() {
   graphic_states_.SetDefaultStates();
 }
 
+void CPDF_PageObject::SetRect(const CFX_FloatRect& rect) {
+  rect_ = rect;
+  if (holder_) {
+    holder_->OnPageObjectRectChanged();
+  }
+}
+
 void CPDF_PageObject::CopyData(const CPDF_PageObject* pSrc) {
   graphic_states_ = pSrc->graphic_states_;
   rect_ = pSrc->rect_;
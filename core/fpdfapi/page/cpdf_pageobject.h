@@ -14,9 +14,11 @@
 #include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/span.h"
+#include "core/fxcrt/unowned_ptr.h"
 
 class CPDF_FormObject;
 class CPDF_ImageObject;
+class CPDF_PageObjectHolder;
 class CPDF_PathObject;
 class CPDF_ShadingObject;
 class CPDF_TextObject;
@@ -83,7 +85,7 @@ class CPDF_PageObject {
 
   void SetOriginalRect(const CFX_FloatRect& rect) { original_rect_ = rect; }
   const CFX_FloatRect& GetOriginalRect() const { return original_rect_; }
-  void SetRect(const CFX_FloatRect& rect) { rect_ = rect; }
+  void SetRect(const CFX_FloatRect& rect);
   const CFX_FloatRect& GetRect() const { return rect_; }
   FX_RECT GetBBox() const;
   FX_RECT GetTransformedBBox(const CFX_Matrix& matrix) const;
@@ -152,6 +154,10 @@ class CPDF_PageObject {
 
   const CFX_Matrix& original_matrix() const { return original_matrix_; }
 
+  // Set by the CPDF_PageObjectHolder that owns this object, which gets told
+  // about changes to the object's rect.
+  void SetHolder(CPDF_PageObjectHolder* holder) { holder_ = holder; }
+
  protected:
   void CopyData(const CPDF_PageObject* pSrcObject);
   void InitializeOriginalMatrix(const CFX_Matrix& matrix);
@@ -176,6 +182,7 @@ class CPDF_PageObject {
   int32_t content_stream_;
   // The resource name for this object.
   ByteString resource_name_;
+  UnownedPtr<CPDF_PageObjectHolder> holder_;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECT_H_
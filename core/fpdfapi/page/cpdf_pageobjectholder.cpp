@@ -13,6 +13,7 @@
 #include "core/fpdfapi/page/cpdf_allstates.h"
 #include "core/fpdfapi/page/cpdf_contentparser.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fxcrt/check.h"
@@ -21,6 +22,13 @@
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/stl_util.h"
 
+namespace {
+
+// Below this, a linear scan is about as fast as querying a spatial index.
+constexpr size_t kMinObjectCountForSpatialIndex = 256;
+
+}  // namespace
+
 bool GraphicsData::operator<(const GraphicsData& other) const {
   if (!FXSYS_SafeEQ(fillAlpha, other.fillAlpha)) {
     return FXSYS_SafeLT(fillAlpha, other.fillAlpha);
@@ -186,7 +194,9 @@ CPDF_PageObject* CPDF_PageObjectHolder::GetPageObjectByIndex(
 void CPDF_PageObjectHolder::AppendPageObject(
     std::unique_ptr<CPDF_PageObject> pPageObj) {
   CHECK(pPageObj);
+  pPageObj->SetHolder(this);
   page_object_list_.push_back(std::move(pPageObj));
+  OnPageObjectRectChanged();
 }
 
 bool CPDF_PageObjectHolder::InsertPageObjectAtIndex(
@@ -211,8 +221,10 @@ bool CPDF_PageObjectHolder::InsertPageObjectAtIndex(
 
   // Unsafe, but the compiler will not complain, because
   // std::deque::iterator::operator++() has not been marked as unsafe yet.
+  page_obj->SetHolder(this);
   page_object_list_.insert(UNSAFE_TODO(page_object_list_.begin() + index),
                            std::move(page_obj));
+  OnPageObjectRectChanged();
   return true;
 }
 
@@ -226,6 +238,8 @@ std::unique_ptr<CPDF_PageObject> CPDF_PageObjectHolder::RemovePageObject(
 
   std::unique_ptr<CPDF_PageObject> result = std::move(*it);
   page_object_list_.erase(it);
+  result->SetHolder(nullptr);
+  OnPageObjectRectChanged();
 
   int32_t content_stream = pPageObj->GetContentStream();
   if (content_stream >= 0) {
@@ -243,5 +257,46 @@ bool CPDF_PageObjectHolder::ErasePageObjectAtIndex(size_t index) {
   // Unsafe, but the compiler will not complain, because
   // std::deque::iterator::operator++() has not been marked as unsafe yet.
   page_object_list_.erase(UNSAFE_TODO(page_object_list_.begin() + index));
+  OnPageObjectRectChanged();
   return true;
 }
+
+std::vector<CPDF_PageObject*> CPDF_PageObjectHolder::GetPageObjectsInRect(
+    const CFX_FloatRect& rect) const {
+  std::vector<CPDF_PageObject*> result;
+  if (page_object_list_.size() < kMinObjectCountForSpatialIndex) {
+    for (const auto& page_object : page_object_list_) {
+      const CFX_FloatRect& object_rect = page_object->GetRect();
+      if (object_rect.left > rect.right || object_rect.right < rect.left ||
+          object_rect.bottom > rect.top || object_rect.top < rect.bottom) {
+        continue;
+      }
+      result.push_back(page_object.get());
+    }
+    return result;
+  }
+
+  std::vector<uint32_t> indices;
+  {
+    std::lock_guard<std::mutex> lock(spatial_index_lock_);
+    if (!spatial_index_) {
+      std::vector<CFX_FloatRect> rects;
+      rects.reserve(page_object_list_.size());
+      for (const auto& page_object : page_object_list_) {
+        rects.push_back(page_object->GetRect());
+      }
+      spatial_index_ = std::make_unique<CPDF_PageObjectIndex>(std::move(rects));
+    }
+    indices = spatial_index_->Query(rect);
+  }
+  result.reserve(indices.size());
+  for (uint32_t index : indices) {
+    result.push_back(page_object_list_[index].get());
+  }
+  return result;
+}
+
+void CPDF_PageObjectHolder::OnPageObjectRectChanged() {
+  std::lock_guard<std::mutex> lock(spatial_index_lock_);
+  spatial_index_.reset();
+}
@@ -14,6 +14,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <utility>
@@ -30,6 +31,7 @@
 class CPDF_ContentParser;
 class CPDF_Document;
 class CPDF_PageObject;
+class CPDF_PageObjectIndex;
 class PauseIndicatorIface;
 
 // These structs are used to keep track of resources that have already been
@@ -114,6 +116,16 @@ class CPDF_PageObjectHolder {
   iterator end() { return page_object_list_.end(); }
   const_iterator end() const { return page_object_list_.end(); }
 
+  // Returns the objects whose rects intersect `rect`, in z-order. Includes
+  // inactive objects. Large holders build a spatial index on first use, so
+  // this does not need to look at every object. Safe to call from several
+  // threads at once, as long as nothing modifies the holder at the same time.
+  std::vector<CPDF_PageObject*> GetPageObjectsInRect(
+      const CFX_FloatRect& rect) const;
+
+  // Called by owned objects when their rects change.
+  void OnPageObjectRectChanged();
+
   const CFX_FloatRect& GetBBox() const { return bbox_; }
 
   const CPDF_Transparency& GetTransparency() const { return transparency_; }
@@ -165,6 +177,11 @@ class CPDF_PageObjectHolder {
   std::unique_ptr<CPDF_ContentParser> parser_;
   std::deque<std::unique_ptr<CPDF_PageObject>> page_object_list_;
 
+  // Built lazily by GetPageObjectsInRect(), dropped when `page_object_list_`
+  // or the rect of an object in it changes.
+  mutable std::mutex spatial_index_lock_;
+  mutable std::unique_ptr<CPDF_PageObjectIndex> spatial_index_;
+
   CTMMap all_ctms_;
 
   // The indexes of Content streams that are dirty and need to be regenerated.
@@ -0,0 +1,150 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "core/fxcrt/numerics/safe_conversions.h"
+
+namespace {
+
+// Aim for a handful of rects per cell.
+constexpr size_t kRectsPerCell = 4;
+constexpr size_t kMaxGridSide = 256;
+
+bool IsIndexable(const CFX_FloatRect& rect) {
+  return isfinite(rect.left) && isfinite(rect.right) &&
+         isfinite(rect.bottom) && isfinite(rect.top) &&
+         rect.left <= rect.right && rect.bottom <= rect.top;
+}
+
+// Matches the culling test in CPDF_RenderStatus::RenderObjectList(), including
+// its treatment of NaN coordinates.
+bool Intersects(const CFX_FloatRect& a, const CFX_FloatRect& b) {
+  return !(a.left > b.right || a.right < b.left || a.bottom > b.top ||
+           a.top < b.bottom);
+}
+
+}  // namespace
+
+CPDF_PageObjectIndex::CPDF_PageObjectIndex(std::vector<CFX_FloatRect> rects)
+    : rects_(std::move(rects)) {
+  bool has_bounds = false;
+  for (const CFX_FloatRect& rect : rects_) {
+    if (!IsIndexable(rect)) {
+      continue;
+    }
+    if (has_bounds) {
+      bounds_.Union(rect);
+    } else {
+      bounds_ = rect;
+      has_bounds = true;
+    }
+  }
+
+  const size_t side = std::clamp<size_t>(
+      static_cast<size_t>(sqrt(static_cast<double>(rects_.size()) /
+                               kRectsPerCell)),
+      1, kMaxGridSide);
+  columns_ = side;
+  rows_ = side;
+  cell_width_ = bounds_.Width() / columns_;
+  cell_height_ = bounds_.Height() / rows_;
+  cells_.resize(columns_ * rows_);
+
+  // Rects covering more than this many cells are cheaper to check on every
+  // query than to file under each cell.
+  const size_t max_cells_per_rect = std::max<size_t>(4, cells_.size() / 16);
+  for (size_t i = 0; i < rects_.size(); ++i) {
+    const uint32_t index = pdfium::checked_cast<uint32_t>(i);
+    const CFX_FloatRect& rect = rects_[i];
+    if (!IsIndexable(rect)) {
+      oversized_.push_back(index);
+      continue;
+    }
+    const CellRange range = GetCellRange(rect);
+    const size_t cell_count =
+        (range.right - range.left + 1) * (range.top - range.bottom + 1);
+    if (cell_count > max_cells_per_rect) {
+      oversized_.push_back(index);
+      continue;
+    }
+    for (size_t row = range.bottom; row <= range.top; ++row) {
+      for (size_t column = range.left; column <= range.right; ++column) {
+        cells_[row * columns_ + column].push_back(index);
+      }
+    }
+  }
+}
+
+CPDF_PageObjectIndex::~CPDF_PageObjectIndex() = default;
+
+std::vector<uint32_t> CPDF_PageObjectIndex::Query(
+    const CFX_FloatRect& rect) const {
+  std::vector<uint32_t> result;
+  if (isnan(rect.left) || isnan(rect.right) || isnan(rect.bottom) ||
+      isnan(rect.top)) {
+    // Every rect "intersects" a NaN rect. Nothing to gain from the grid.
+    result.resize(rects_.size());
+    for (size_t i = 0; i < rects_.size(); ++i) {
+      result[i] = static_cast<uint32_t>(i);
+    }
+    return result;
+  }
+
+  // An indexed rect that intersects `rect` also intersects its normalized
+  // form, so the cells of the latter hold all candidates.
+  CFX_FloatRect normalized = rect;
+  normalized.Normalize();
+  const CellRange range = GetCellRange(normalized);
+  std::vector<uint32_t> candidates = oversized_;
+  for (size_t row = range.bottom; row <= range.top; ++row) {
+    for (size_t column = range.left; column <= range.right; ++column) {
+      const std::vector<uint32_t>& cell = cells_[row * columns_ + column];
+      candidates.insert(candidates.end(), cell.begin(), cell.end());
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                   candidates.end());
+
+  for (uint32_t index : candidates) {
+    if (Intersects(rects_[index], rect)) {
+      result.push_back(index);
+    }
+  }
+  return result;
+}
+
+CPDF_PageObjectIndex::CellRange CPDF_PageObjectIndex::GetCellRange(
+    const CFX_FloatRect& rect) const {
+  return {GetColumn(rect.left), GetRow(rect.bottom), GetColumn(rect.right),
+          GetRow(rect.top)};
+}
+
+size_t CPDF_PageObjectIndex::GetColumn(float x) const {
+  if (cell_width_ <= 0) {
+    return 0;
+  }
+  const float column = (x - bounds_.left) / cell_width_;
+  if (!(column > 0)) {
+    return 0;
+  }
+  return column >= columns_ ? columns_ - 1 : static_cast<size_t>(column);
+}
+
+size_t CPDF_PageObjectIndex::GetRow(float y) const {
+  if (cell_height_ <= 0) {
+    return 0;
+  }
+  const float row = (y - bounds_.bottom) / cell_height_;
+  if (!(row > 0)) {
+    return 0;
+  }
+  return row >= rows_ ? rows_ - 1 : static_cast<size_t>(row);
+}
@@ -0,0 +1,52 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTINDEX_H_
+#define CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTINDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxcrt/fx_coordinates.h"
+
+// Uniform grid over a list of bounding rects, e.g. those of the objects in a
+// CPDF_PageObjectHolder. Each rect is filed under every grid cell it touches.
+// Rects that span a large part of the grid, or are not finite, are kept in a
+// separate list that every query checks.
+class CPDF_PageObjectIndex {
+ public:
+  explicit CPDF_PageObjectIndex(std::vector<CFX_FloatRect> rects);
+  ~CPDF_PageObjectIndex();
+
+  // Returns the indices, in ascending order, of all rects that are not
+  // entirely to one side of `rect`. Edges that touch count as intersecting.
+  std::vector<uint32_t> Query(const CFX_FloatRect& rect) const;
+
+  size_t size() const { return rects_.size(); }
+
+ private:
+  struct CellRange {
+    size_t left;
+    size_t bottom;
+    size_t right;
+    size_t top;
+  };
+
+  CellRange GetCellRange(const CFX_FloatRect& rect) const;
+  size_t GetColumn(float x) const;
+  size_t GetRow(float y) const;
+
+  const std::vector<CFX_FloatRect> rects_;
+  CFX_FloatRect bounds_;
+  size_t columns_ = 1;
+  size_t rows_ = 1;
+  float cell_width_ = 0.0f;
+  float cell_height_ = 0.0f;
+  std::vector<std::vector<uint32_t>> cells_;
+  std::vector<uint32_t> oversized_;
+};
+
+#endif  // CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTINDEX_H_
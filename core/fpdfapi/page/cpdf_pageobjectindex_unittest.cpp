@@ -0,0 +1,106 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
+
+#include <stdint.h>
+
+#include <limits>
+#include <vector>
+
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+namespace {
+
+std::vector<uint32_t> BruteForceQuery(const std::vector<CFX_FloatRect>& rects,
+                                      const CFX_FloatRect& rect) {
+  std::vector<uint32_t> result;
+  for (size_t i = 0; i < rects.size(); ++i) {
+    if (!(rects[i].left > rect.right || rects[i].right < rect.left ||
+          rects[i].bottom > rect.top || rects[i].top < rect.bottom)) {
+      result.push_back(static_cast<uint32_t>(i));
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(CPDFPageObjectIndex, Empty) {
+  CPDF_PageObjectIndex index({});
+  EXPECT_EQ(0u, index.size());
+  EXPECT_THAT(index.Query(CFX_FloatRect(0, 0, 100, 100)), IsEmpty());
+}
+
+TEST(CPDFPageObjectIndex, Small) {
+  CPDF_PageObjectIndex index({
+      CFX_FloatRect(0, 0, 10, 10),
+      CFX_FloatRect(20, 20, 30, 30),
+      CFX_FloatRect(0, 0, 100, 100),
+      CFX_FloatRect(10, 10, 20, 20),
+  });
+  EXPECT_THAT(index.Query(CFX_FloatRect(5, 5, 5, 5)), ElementsAre(0, 2));
+  EXPECT_THAT(index.Query(CFX_FloatRect(25, 25, 26, 26)), ElementsAre(1, 2));
+  EXPECT_THAT(index.Query(CFX_FloatRect(200, 200, 300, 300)), IsEmpty());
+
+  // Touching edges count as intersecting.
+  EXPECT_THAT(index.Query(CFX_FloatRect(10, 10, 10, 10)),
+              ElementsAre(0, 2, 3));
+  EXPECT_THAT(index.Query(CFX_FloatRect(-5, -5, 200, 200)),
+              ElementsAre(0, 1, 2, 3));
+}
+
+TEST(CPDFPageObjectIndex, NonFinite) {
+  const float kInf = std::numeric_limits<float>::infinity();
+  const float kNan = std::numeric_limits<float>::quiet_NaN();
+  CPDF_PageObjectIndex index({
+      CFX_FloatRect(0, 0, 10, 10),
+      CFX_FloatRect(-kInf, -kInf, kInf, kInf),
+      CFX_FloatRect(kNan, kNan, kNan, kNan),
+      CFX_FloatRect(50, 50, 60, 60),
+  });
+  EXPECT_THAT(index.Query(CFX_FloatRect(5, 5, 6, 6)), ElementsAre(0, 1, 2));
+  EXPECT_THAT(index.Query(CFX_FloatRect(kNan, 0, 1, 1)),
+              ElementsAre(0, 1, 2, 3));
+}
+
+TEST(CPDFPageObjectIndex, MatchesBruteForce) {
+  // A 100 x 100 grid of small rects, plus some long thin ones and some that
+  // cover most of the page.
+  std::vector<CFX_FloatRect> rects;
+  for (int y = 0; y < 100; ++y) {
+    for (int x = 0; x < 100; ++x) {
+      rects.emplace_back(x * 6.0f, y * 8.0f, x * 6.0f + 5.0f, y * 8.0f + 9.0f);
+    }
+    if (y % 10 == 0) {
+      rects.emplace_back(0.0f, y * 8.0f, 600.0f, y * 8.0f + 1.0f);
+      rects.emplace_back(y * 6.0f, 0.0f, y * 6.0f + 1.0f, 800.0f);
+      rects.emplace_back(y, y, 600.0f - y, 800.0f - y);
+    }
+  }
+  CPDF_PageObjectIndex index(rects);
+  ASSERT_EQ(rects.size(), index.size());
+
+  const CFX_FloatRect kQueries[] = {
+      CFX_FloatRect(0, 0, 0, 0),
+      CFX_FloatRect(3, 3, 3, 3),
+      CFX_FloatRect(299.5f, 399.5f, 300.5f, 400.5f),
+      CFX_FloatRect(100, 100, 180, 150),
+      CFX_FloatRect(-50, -50, 10, 10),
+      CFX_FloatRect(590, 790, 700, 900),
+      CFX_FloatRect(-1000, -1000, 1000, 1000),
+      CFX_FloatRect(601, 801, 700, 900),
+      // Not normalized.
+      CFX_FloatRect(200, 200, 100, 100),
+  };
+  for (const CFX_FloatRect& query : kQueries) {
+    EXPECT_EQ(BruteForceQuery(rects, query), index.Query(query))
+        << query.left << ", " << query.bottom << ", " << query.right << ", "
+        << query.top;
+  }
+}
@@ -18,6 +18,7 @@
 #include "core/fxcrt/check_op.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/fx_string.h"
+#include "core/fxcrt/notreached.h"
 #include "core/fxcrt/numerics/safe_conversions.h"
 
 namespace {
@@ -85,6 +86,10 @@ float RoundHalfUp(float f) {
   return floor(f + 0.5f);
 }
 
+int ToInt(float f) {
+  return pdfium::saturated_cast<int>(f);
+}
+
 }  // namespace
 
 CPDF_PSOP::CPDF_PSOP()
@@ -114,6 +119,11 @@ float CPDF_PSOP::GetFloatValue() const {
   return value_;
 }
 
+const CPDF_PSProc& CPDF_PSOP::GetProc() const {
+  CHECK_EQ(op_, PSOP_PROC);
+  return *proc_;
+}
+
 bool CPDF_PSEngine::Execute() {
   return main_proc_.Execute(this);
 }
@@ -212,7 +222,7 @@ float CPDF_PSEngine::Pop() {
 }
 
 int CPDF_PSEngine::PopInt() {
-  return pdfium::saturated_cast<int>(Pop());
+  return ToInt(Pop());
 }
 
 bool CPDF_PSEngine::Parse(pdfium::span<const uint8_t> input) {
@@ -220,171 +230,133 @@ bool CPDF_PSEngine::Parse(pdfium::span<const uint8_t> input) {
   return parser.GetWord() == "{" && main_proc_.Parse(&parser, 0);
 }
 
-bool CPDF_PSEngine::DoOperator(PDF_PSOP op) {
-  int i1;
-  int i2;
-  float d1;
-  float d2;
+// static
+int CPDF_PSEngine::GetPureOperandCount(PDF_PSOP op) {
+  switch (op) {
+    case PSOP_TRUE:
+    case PSOP_FALSE:
+      return 0;
+    case PSOP_NEG:
+    case PSOP_ABS:
+    case PSOP_CEILING:
+    case PSOP_FLOOR:
+    case PSOP_ROUND:
+    case PSOP_TRUNCATE:
+    case PSOP_SQRT:
+    case PSOP_SIN:
+    case PSOP_COS:
+    case PSOP_LN:
+    case PSOP_LOG:
+    case PSOP_CVI:
+    case PSOP_NOT:
+      return 1;
+    case PSOP_ADD:
+    case PSOP_SUB:
+    case PSOP_MUL:
+    case PSOP_DIV:
+    case PSOP_IDIV:
+    case PSOP_MOD:
+    case PSOP_ATAN:
+    case PSOP_EXP:
+    case PSOP_EQ:
+    case PSOP_NE:
+    case PSOP_GT:
+    case PSOP_GE:
+    case PSOP_LT:
+    case PSOP_LE:
+    case PSOP_AND:
+    case PSOP_OR:
+    case PSOP_XOR:
+    case PSOP_BITSHIFT:
+      return 2;
+    default:
+      return -1;
+  }
+}
+
+// static
+float CPDF_PSEngine::EvaluatePureOperator(PDF_PSOP op,
+                                          float first,
+                                          float second) {
   FX_SAFE_INT32 result;
   switch (op) {
     case PSOP_ADD:
-      d1 = Pop();
-      d2 = Pop();
-      Push(d1 + d2);
-      break;
+      return second + first;
     case PSOP_SUB:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d1 - d2);
-      break;
+      return first - second;
     case PSOP_MUL:
-      d1 = Pop();
-      d2 = Pop();
-      Push(d1 * d2);
-      break;
+      return second * first;
     case PSOP_DIV:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d2 ? d1 / d2 : 0);
-      break;
+      return second ? first / second : 0;
     case PSOP_IDIV:
-      i2 = PopInt();
-      i1 = PopInt();
-      if (i2) {
-        result = i1;
-        result /= i2;
-        Push(result.ValueOrDefault(0));
-      } else {
-        Push(0);
+      if (!ToInt(second)) {
+        return 0;
       }
-      break;
+      result = ToInt(first);
+      result /= ToInt(second);
+      return result.ValueOrDefault(0);
     case PSOP_MOD:
-      i2 = PopInt();
-      i1 = PopInt();
-      if (i2) {
-        result = i1;
-        result %= i2;
-        Push(result.ValueOrDefault(0));
-      } else {
-        Push(0);
+      if (!ToInt(second)) {
+        return 0;
       }
-      break;
+      result = ToInt(first);
+      result %= ToInt(second);
+      return result.ValueOrDefault(0);
     case PSOP_NEG:
-      d1 = Pop();
-      Push(-d1);
-      break;
+      return -first;
     case PSOP_ABS:
-      d1 = Pop();
-      Push(fabs(d1));
-      break;
+      return fabs(first);
     case PSOP_CEILING:
-      d1 = Pop();
-      Push(ceil(d1));
-      break;
+      return ceil(first);
     case PSOP_FLOOR:
-      d1 = Pop();
-      Push(floor(d1));
-      break;
+      return floor(first);
     case PSOP_ROUND:
-      d1 = Pop();
-      Push(RoundHalfUp(d1));
-      break;
+      return RoundHalfUp(first);
     case PSOP_TRUNCATE:
-      i1 = PopInt();
-      Push(i1);
-      break;
+    case PSOP_CVI:
+      return ToInt(first);
     case PSOP_SQRT:
-      d1 = Pop();
-      Push(sqrt(d1));
-      break;
+      return sqrt(first);
     case PSOP_SIN:
-      d1 = Pop();
-      Push(sin(d1 * FXSYS_PI / 180.0f));
-      break;
+      return sin(first * FXSYS_PI / 180.0f);
     case PSOP_COS:
-      d1 = Pop();
-      Push(cos(d1 * FXSYS_PI / 180.0f));
-      break;
-    case PSOP_ATAN:
-      d2 = Pop();
-      d1 = Pop();
-      d1 = atan2(d1, d2) * 180.0 / FXSYS_PI;
-      if (d1 < 0) {
-        d1 += 360;
+      return cos(first * FXSYS_PI / 180.0f);
+    case PSOP_ATAN: {
+      float degrees = atan2(first, second) * 180.0 / FXSYS_PI;
+      if (degrees < 0) {
+        degrees += 360;
       }
-      Push(d1);
-      break;
+      return degrees;
+    }
     case PSOP_EXP:
-      d2 = Pop();
-      d1 = Pop();
-      Push(powf(d1, d2));
-      break;
+      return powf(first, second);
     case PSOP_LN:
-      d1 = Pop();
-      Push(log(d1));
-      break;
+      return log(first);
     case PSOP_LOG:
-      d1 = Pop();
-      Push(log10(d1));
-      break;
-    case PSOP_CVI:
-      i1 = PopInt();
-      Push(i1);
-      break;
-    case PSOP_CVR:
-      break;
+      return log10(first);
     case PSOP_EQ:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d1 == d2);
-      break;
+      return first == second;
     case PSOP_NE:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d1 != d2);
-      break;
+      return first != second;
     case PSOP_GT:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d1 > d2);
-      break;
+      return first > second;
     case PSOP_GE:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d1 >= d2);
-      break;
+      return first >= second;
     case PSOP_LT:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d1 < d2);
-      break;
+      return first < second;
     case PSOP_LE:
-      d2 = Pop();
-      d1 = Pop();
-      Push(d1 <= d2);
-      break;
+      return first <= second;
     case PSOP_AND:
-      i1 = PopInt();
-      i2 = PopInt();
-      Push(i1 & i2);
-      break;
+      return ToInt(second) & ToInt(first);
     case PSOP_OR:
-      i1 = PopInt();
-      i2 = PopInt();
-      Push(i1 | i2);
-      break;
+      return ToInt(second) | ToInt(first);
     case PSOP_XOR:
-      i1 = PopInt();
-      i2 = PopInt();
-      Push(i1 ^ i2);
-      break;
+      return ToInt(second) ^ ToInt(first);
     case PSOP_NOT:
-      i1 = PopInt();
-      Push(!i1);
-      break;
+      return !ToInt(first);
     case PSOP_BITSHIFT: {
-      int shift = PopInt();
-      result = PopInt();
+      const int shift = ToInt(second);
+      result = ToInt(first);
       if (shift > 0) {
         result <<= shift;
       } else {
@@ -392,14 +364,30 @@ bool CPDF_PSEngine::DoOperator(PDF_PSOP op) {
         FX_SAFE_INT32 safe_shift = shift;
         result >>= (-safe_shift).ValueOrDefault(0);
       }
-      Push(result.ValueOrDefault(0));
-      break;
+      return result.ValueOrDefault(0);
     }
     case PSOP_TRUE:
-      Push(1);
-      break;
+      return 1;
     case PSOP_FALSE:
-      Push(0);
+      return 0;
+    default:
+      NOTREACHED();
+  }
+}
+
+bool CPDF_PSEngine::DoOperator(PDF_PSOP op) {
+  const int operand_count = GetPureOperandCount(op);
+  if (operand_count >= 0) {
+    const float second = operand_count == 2 ? Pop() : 0;
+    const float first = operand_count >= 1 ? Pop() : 0;
+    Push(EvaluatePureOperator(op, first, second));
+    return true;
+  }
+
+  float d1;
+  float d2;
+  switch (op) {
+    case PSOP_CVR:
       break;
     case PSOP_POP:
       Pop();
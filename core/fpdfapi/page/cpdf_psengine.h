@@ -77,6 +77,7 @@ class CPDF_PSOP {
   bool Parse(CPDF_SimpleParser* parser, int depth);
   void Execute(CPDF_PSEngine* pEngine);
   float GetFloatValue() const;
+  const CPDF_PSProc& GetProc() const;
   PDF_PSOP GetOp() const { return op_; }
 
  private:
@@ -93,6 +94,10 @@ class CPDF_PSProc {
   bool Parse(CPDF_SimpleParser* parser, int depth);
   bool Execute(CPDF_PSEngine* pEngine);
 
+  const std::vector<std::unique_ptr<CPDF_PSOP>>& operators() const {
+    return operators_;
+  }
+
   // These methods are exposed for testing.
   void AddOperatorForTesting(ByteStringView word);
   const std::unique_ptr<CPDF_PSOP>& last_operator() {
@@ -109,6 +114,17 @@ class CPDF_PSProc {
 
 class CPDF_PSEngine {
  public:
+  static constexpr uint32_t kPSEngineStackSize = 100;
+
+  // For operators that pop a fixed number of operands and push one result,
+  // returns the number of operands. Returns -1 for other operators.
+  static int GetPureOperandCount(PDF_PSOP op);
+
+  // Evaluates an operator for which GetPureOperandCount() is not -1. `first`
+  // is the deepest operand on the stack and `second` is the top one. Unused
+  // operands are ignored.
+  static float EvaluatePureOperator(PDF_PSOP op, float first, float second);
+
   CPDF_PSEngine();
   ~CPDF_PSEngine();
 
@@ -120,10 +136,9 @@ class CPDF_PSEngine {
   float Pop();
   int PopInt();
   uint32_t GetStackSize() const { return stack_count_; }
+  const CPDF_PSProc& main_proc() const { return main_proc_; }
 
  private:
-  static constexpr uint32_t kPSEngineStackSize = 100;
-
   uint32_t stack_count_ = 0;
   CPDF_PSProc main_proc_;
   std::array<float, kPSEngineStackSize> stack_ = {};
@@ -17,11 +17,18 @@ bool CPDF_PSFunc::v_Init(const CPDF_Object* pObj, VisitedSet* pVisited) {
   auto pAcc =
       pdfium::MakeRetain<CPDF_StreamAcc>(pdfium::WrapRetain(pObj->AsStream()));
   pAcc->LoadAllDataFiltered();
-  return ps_.Parse(pAcc->GetSpan());
+  if (!ps_.Parse(pAcc->GetSpan())) {
+    return false;
+  }
+  program_ = CPDF_PSProgram::Compile(ps_.main_proc(), inputs_, outputs_);
+  return true;
 }
 
 bool CPDF_PSFunc::v_Call(pdfium::span<const float> inputs,
                          pdfium::span<float> results) const {
+  if (program_) {
+    return program_->Call(inputs, results);
+  }
   ps_.Reset();
   for (uint32_t i = 0; i < inputs_; i++) {
     ps_.Push(inputs[i]);
@@ -35,3 +42,11 @@ bool CPDF_PSFunc::v_Call(pdfium::span<const float> inputs,
   }
   return true;
 }
+
+bool CPDF_PSFunc::v_CallBatch(pdfium::span<const float> inputs,
+                              pdfium::span<float> results) const {
+  if (program_) {
+    return program_->CallBatch(inputs, results);
+  }
+  return CPDF_Function::v_CallBatch(inputs, results);
+}
@@ -0,0 +1,528 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_psprogram.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/check_op.h"
+#include "core/fxcrt/compiler_specific.h"
+#include "core/fxcrt/numerics/safe_conversions.h"
+#include "core/fxcrt/ptr_util.h"
+#include "core/fxcrt/unowned_ptr.h"
+
+namespace {
+
+constexpr uint32_t kStackSize = CPDF_PSEngine::kPSEngineStackSize;
+
+// Bounds the scratch space, which CallBatch() needs for each lane.
+constexpr uint32_t kMaxRegisters = 8192;
+
+// Number of sets of inputs that CallBatch() runs through each instruction.
+constexpr size_t kBatchLanes = 32;
+
+int ToInt(float f) {
+  return pdfium::saturated_cast<int>(f);
+}
+
+template <typename F>
+void ForEachLane(pdfium::span<float> dest,
+                 pdfium::span<const float> a,
+                 pdfium::span<const float> b,
+                 F f) {
+  CHECK_EQ(dest.size(), a.size());
+  CHECK_EQ(dest.size(), b.size());
+  float* dest_ptr = dest.data();
+  const float* a_ptr = a.data();
+  const float* b_ptr = b.data();
+  // SAFETY: all spans have `dest.size()` elements, as checked above.
+  UNSAFE_BUFFERS({
+    for (size_t i = 0; i < dest.size(); ++i) {
+      dest_ptr[i] = f(a_ptr[i], b_ptr[i]);
+    }
+  });
+}
+
+// Same as CPDF_PSEngine::EvaluatePureOperator() for each lane. Common
+// operators get loops that the compiler can vectorize.
+void EvaluateLanes(PDF_PSOP op,
+                   pdfium::span<float> dest,
+                   pdfium::span<const float> a,
+                   pdfium::span<const float> b) {
+  switch (op) {
+    case PSOP_ADD:
+      ForEachLane(dest, a, b, [](float x, float y) { return y + x; });
+      return;
+    case PSOP_SUB:
+      ForEachLane(dest, a, b, [](float x, float y) { return x - y; });
+      return;
+    case PSOP_MUL:
+      ForEachLane(dest, a, b, [](float x, float y) { return y * x; });
+      return;
+    case PSOP_DIV:
+      ForEachLane(dest, a, b,
+                  [](float x, float y) { return y ? x / y : 0.0f; });
+      return;
+    case PSOP_NEG:
+      ForEachLane(dest, a, b, [](float x, float) { return -x; });
+      return;
+    case PSOP_ABS:
+      ForEachLane(dest, a, b, [](float x, float) { return fabsf(x); });
+      return;
+    case PSOP_EQ:
+      ForEachLane(dest, a, b,
+                  [](float x, float y) { return x == y ? 1.0f : 0.0f; });
+      return;
+    case PSOP_NE:
+      ForEachLane(dest, a, b,
+                  [](float x, float y) { return x != y ? 1.0f : 0.0f; });
+      return;
+    case PSOP_GT:
+      ForEachLane(dest, a, b,
+                  [](float x, float y) { return x > y ? 1.0f : 0.0f; });
+      return;
+    case PSOP_GE:
+      ForEachLane(dest, a, b,
+                  [](float x, float y) { return x >= y ? 1.0f : 0.0f; });
+      return;
+    case PSOP_LT:
+      ForEachLane(dest, a, b,
+                  [](float x, float y) { return x < y ? 1.0f : 0.0f; });
+      return;
+    case PSOP_LE:
+      ForEachLane(dest, a, b,
+                  [](float x, float y) { return x <= y ? 1.0f : 0.0f; });
+      return;
+    default:
+      ForEachLane(dest, a, b, [op](float x, float y) {
+        return CPDF_PSEngine::EvaluatePureOperator(op, x, y);
+      });
+      return;
+  }
+}
+
+}  // namespace
+
+// Compiles procedures by running them on a stack of Values: operators that
+// only move values around change which Value is where, and operators with
+// constant operands push constants. Other operators emit instructions that
+// write new registers.
+//
+// Where control flow merges, the stack must look the same on all paths. There,
+// Flush() moves stack position `i` into register `i`.
+class CPDF_PSProgram::Compiler {
+ public:
+  explicit Compiler(CPDF_PSProgram* program) : program_(program) {}
+
+  bool Compile(const CPDF_PSProc& proc) {
+    const uint32_t input_count = std::min(program_->inputs_, kStackSize);
+    stack_.reserve(kStackSize);
+    for (uint32_t i = 0; i < input_count; ++i) {
+      stack_.push_back(Value::Register(i));
+    }
+    stack_register_count_ = input_count;
+    if (!CompileProc(proc) || next_register_ > kMaxRegisters) {
+      return false;
+    }
+    if (stack_.size() >= program_->outputs_) {
+      program_->has_results_ = true;
+      program_->results_.assign(stack_.end() - program_->outputs_,
+                                stack_.end());
+    }
+    PackRegisters();
+    return true;
+  }
+
+ private:
+  Value Pop() {
+    if (stack_.empty()) {
+      return Value::Constant(0);
+    }
+    Value value = stack_.back();
+    stack_.pop_back();
+    return value;
+  }
+
+  void Push(Value value) {
+    if (stack_.size() < kStackSize) {
+      stack_.push_back(value);
+    }
+  }
+
+  uint32_t NewRegister() { return next_register_++; }
+
+  size_t Emit(const Instruction& instruction) {
+    program_->instructions_.push_back(instruction);
+    return program_->instructions_.size() - 1;
+  }
+
+  uint32_t Materialize(Value value) {
+    if (!value.is_constant) {
+      return value.reg;
+    }
+    const uint32_t reg = NewRegister();
+    Emit({.opcode = Opcode::kConstant, .dest = reg, .value = value.constant});
+    return reg;
+  }
+
+  void Flush() {
+    // Values in the registers that are about to be written need to move out
+    // of the way first.
+    for (size_t i = 0; i < stack_.size(); ++i) {
+      Value& value = stack_[i];
+      if (!value.is_constant && value.reg < stack_.size() && value.reg != i) {
+        const uint32_t reg = NewRegister();
+        Emit({.opcode = Opcode::kMove, .dest = reg, .a = value.reg});
+        value.reg = reg;
+      }
+    }
+    for (size_t i = 0; i < stack_.size(); ++i) {
+      const Value& value = stack_[i];
+      const uint32_t reg = static_cast<uint32_t>(i);
+      if (value.is_constant) {
+        Emit({.opcode = Opcode::kConstant,
+              .dest = reg,
+              .value = value.constant});
+      } else if (value.reg != reg) {
+        Emit({.opcode = Opcode::kMove, .dest = reg, .a = value.reg});
+      }
+      stack_[i] = Value::Register(reg);
+    }
+    stack_register_count_ = std::max(stack_register_count_,
+                                     static_cast<uint32_t>(stack_.size()));
+  }
+
+  // Mirrors CPDF_PSProc::Execute(). Returning early there stops only the
+  // procedure being run, and which operators do so is known at compile time.
+  bool CompileProc(const CPDF_PSProc& proc) {
+    const auto& operators = proc.operators();
+    for (size_t i = 0; i < operators.size(); ++i) {
+      const PDF_PSOP op = operators[i]->GetOp();
+      if (op == PSOP_PROC) {
+        continue;
+      }
+
+      if (op == PSOP_CONST) {
+        Push(Value::Constant(operators[i]->GetFloatValue()));
+        continue;
+      }
+
+      if (op == PSOP_IF) {
+        if (i == 0 || operators[i - 1]->GetOp() != PSOP_PROC) {
+          return true;
+        }
+        if (!CompileIf(Pop(), operators[i - 1]->GetProc(), nullptr)) {
+          return false;
+        }
+      } else if (op == PSOP_IFELSE) {
+        if (i < 2 || operators[i - 1]->GetOp() != PSOP_PROC ||
+            operators[i - 2]->GetOp() != PSOP_PROC) {
+          return true;
+        }
+        if (!CompileIf(Pop(), operators[i - 2]->GetProc(),
+                       &operators[i - 1]->GetProc())) {
+          return false;
+        }
+      } else if (!CompileOperator(op)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool CompileIf(Value condition,
+                 const CPDF_PSProc& then_proc,
+                 const CPDF_PSProc* else_proc) {
+    if (condition.is_constant) {
+      if (ToInt(condition.constant)) {
+        return CompileProc(then_proc);
+      }
+      return !else_proc || CompileProc(*else_proc);
+    }
+
+    uint32_t condition_reg = condition.reg;
+    if (condition_reg < stack_.size()) {
+      condition_reg = NewRegister();
+      Emit({.opcode = Opcode::kMove,
+            .dest = condition_reg,
+            .a = condition.reg});
+    }
+    Flush();
+    const size_t depth = stack_.size();
+    program_->has_branches_ = true;
+    const size_t jump_to_else =
+        Emit({.opcode = Opcode::kJumpIfZero, .a = condition_reg});
+    if (!CompileProc(then_proc)) {
+      return false;
+    }
+    Flush();
+    const size_t then_depth = stack_.size();
+    if (!else_proc) {
+      if (then_depth != depth) {
+        return false;
+      }
+      SetJumpTarget(jump_to_else);
+      return true;
+    }
+
+    const size_t jump_to_end = Emit({.opcode = Opcode::kJump});
+    SetJumpTarget(jump_to_else);
+    stack_.clear();
+    for (size_t i = 0; i < depth; ++i) {
+      stack_.push_back(Value::Register(static_cast<uint32_t>(i)));
+    }
+    if (!CompileProc(*else_proc)) {
+      return false;
+    }
+    Flush();
+    if (stack_.size() != then_depth) {
+      return false;
+    }
+    SetJumpTarget(jump_to_end);
+    return true;
+  }
+
+  void SetJumpTarget(size_t jump) {
+    program_->instructions_[jump].target =
+        static_cast<uint32_t>(program_->instructions_.size());
+  }
+
+  // Mirrors CPDF_PSEngine::DoOperator().
+  bool CompileOperator(PDF_PSOP op) {
+    const int operand_count = CPDF_PSEngine::GetPureOperandCount(op);
+    if (operand_count >= 0) {
+      const Value second = operand_count == 2 ? Pop() : Value::Constant(0);
+      const Value first = operand_count >= 1 ? Pop() : Value::Constant(0);
+      if (first.is_constant && second.is_constant) {
+        Push(Value::Constant(CPDF_PSEngine::EvaluatePureOperator(
+            op, first.constant, second.constant)));
+        return true;
+      }
+      const uint32_t a = Materialize(first);
+      const uint32_t b = operand_count == 2 ? Materialize(second) : a;
+      const uint32_t dest = NewRegister();
+      Emit({.opcode = Opcode::kOperator,
+            .op = op,
+            .dest = dest,
+            .a = a,
+            .b = b});
+      Push(Value::Register(dest));
+      return true;
+    }
+
+    switch (op) {
+      case PSOP_POP:
+        Pop();
+        return true;
+      case PSOP_EXCH: {
+        const Value second = Pop();
+        const Value first = Pop();
+        Push(second);
+        Push(first);
+        return true;
+      }
+      case PSOP_DUP: {
+        const Value value = Pop();
+        Push(value);
+        Push(value);
+        return true;
+      }
+      case PSOP_COPY: {
+        const Value count = Pop();
+        // With an empty stack, there is nothing to copy whatever the count.
+        if (!count.is_constant) {
+          return stack_.empty();
+        }
+        const int n = ToInt(count.constant);
+        const size_t size = stack_.size();
+        if (n < 0 || size + n > kStackSize || n > static_cast<int>(size)) {
+          return true;
+        }
+        for (size_t i = size - n; i < size; ++i) {
+          const Value value = stack_[i];
+          stack_.push_back(value);
+        }
+        return true;
+      }
+      case PSOP_INDEX: {
+        const Value index = Pop();
+        if (!index.is_constant) {
+          return stack_.empty();
+        }
+        const int n = ToInt(index.constant);
+        if (n < 0 || n >= static_cast<int>(stack_.size())) {
+          return true;
+        }
+        Push(stack_[stack_.size() - n - 1]);
+        return true;
+      }
+      case PSOP_ROLL: {
+        const Value shift = Pop();
+        const Value count = Pop();
+        if ((shift.is_constant && ToInt(shift.constant) == 0) ||
+            (count.is_constant && ToInt(count.constant) == 0) ||
+            stack_.empty()) {
+          return true;
+        }
+        if (!shift.is_constant || !count.is_constant) {
+          return false;
+        }
+        int j = ToInt(shift.constant);
+        const int n = ToInt(count.constant);
+        if (n < 0 || n > static_cast<int>(stack_.size())) {
+          return true;
+        }
+        j %= n;
+        if (j > 0) {
+          j -= n;
+        }
+        std::rotate(stack_.end() - n, stack_.end() - n - j, stack_.end());
+        return true;
+      }
+      default:
+        // PSOP_CVR does nothing.
+        return true;
+    }
+  }
+
+  // Registers for stack positions come first, followed by the others. Only
+  // keep as many of the former as the program uses.
+  void PackRegisters() {
+    const uint32_t unused = kStackSize - stack_register_count_;
+    auto pack = [unused](uint32_t& reg) {
+      if (reg >= kStackSize) {
+        reg -= unused;
+      }
+    };
+    for (Instruction& instruction : program_->instructions_) {
+      pack(instruction.dest);
+      pack(instruction.a);
+      pack(instruction.b);
+    }
+    for (Value& value : program_->results_) {
+      pack(value.reg);
+    }
+    program_->register_count_ = next_register_ - unused;
+    program_->registers_.resize(program_->register_count_);
+  }
+
+  UnownedPtr<CPDF_PSProgram> const program_;
+  std::vector<Value> stack_;
+  uint32_t stack_register_count_ = 0;
+  uint32_t next_register_ = kStackSize;
+};
+
+// static
+std::unique_ptr<CPDF_PSProgram> CPDF_PSProgram::Compile(const CPDF_PSProc& proc,
+                                                        uint32_t inputs,
+                                                        uint32_t outputs) {
+  auto program = pdfium::WrapUnique(new CPDF_PSProgram(inputs, outputs));
+  Compiler compiler(program.get());
+  if (!compiler.Compile(proc)) {
+    return nullptr;
+  }
+  return program;
+}
+
+CPDF_PSProgram::CPDF_PSProgram(uint32_t inputs, uint32_t outputs)
+    : inputs_(inputs), outputs_(outputs) {}
+
+CPDF_PSProgram::~CPDF_PSProgram() = default;
+
+bool CPDF_PSProgram::Call(pdfium::span<const float> inputs,
+                          pdfium::span<float> results) const {
+  if (!has_results_) {
+    return false;
+  }
+  pdfium::span<float> registers(registers_);
+  const uint32_t input_count = std::min(inputs_, kStackSize);
+  for (uint32_t i = 0; i < input_count; ++i) {
+    registers[i] = inputs[i];
+  }
+  Run(registers, 1);
+  for (uint32_t i = 0; i < outputs_; ++i) {
+    const Value& value = results_[i];
+    results[i] = value.is_constant ? value.constant : registers[value.reg];
+  }
+  return true;
+}
+
+bool CPDF_PSProgram::CallBatch(pdfium::span<const float> inputs,
+                               pdfium::span<float> results) const {
+  CHECK_GT(inputs_, 0u);
+  if (!has_results_) {
+    return false;
+  }
+  const size_t count = inputs.size() / inputs_;
+  if (has_branches_) {
+    for (size_t i = 0; i < count; ++i) {
+      Call(inputs.subspan(i * inputs_, inputs_),
+           results.subspan(i * outputs_, outputs_));
+    }
+    return true;
+  }
+
+  const size_t batch_size = register_count_ * kBatchLanes;
+  if (registers_.size() < batch_size) {
+    registers_.resize(batch_size);
+  }
+  const uint32_t input_count = std::min(inputs_, kStackSize);
+  for (size_t start = 0; start < count; start += kBatchLanes) {
+    const size_t lanes = std::min(kBatchLanes, count - start);
+    pdfium::span<float> registers =
+        pdfium::span(registers_).first(register_count_ * lanes);
+    for (uint32_t i = 0; i < input_count; ++i) {
+      for (size_t lane = 0; lane < lanes; ++lane) {
+        registers[i * lanes + lane] = inputs[(start + lane) * inputs_ + i];
+      }
+    }
+    Run(registers, lanes);
+    for (uint32_t i = 0; i < outputs_; ++i) {
+      const Value& value = results_[i];
+      for (size_t lane = 0; lane < lanes; ++lane) {
+        results[(start + lane) * outputs_ + i] =
+            value.is_constant ? value.constant
+                              : registers[value.reg * lanes + lane];
+      }
+    }
+  }
+  return true;
+}
+
+void CPDF_PSProgram::Run(pdfium::span<float> registers, size_t lanes) const {
+  DCHECK(lanes == 1 || !has_branches_);
+  size_t pc = 0;
+  while (pc < instructions_.size()) {
+    const Instruction& instruction = instructions_[pc++];
+    auto get_register = [registers, lanes](uint32_t reg) {
+      return registers.subspan(reg * lanes, lanes);
+    };
+    switch (instruction.opcode) {
+      case Opcode::kConstant:
+        std::ranges::fill(get_register(instruction.dest), instruction.value);
+        break;
+      case Opcode::kMove:
+        std::ranges::copy(get_register(instruction.a),
+                          get_register(instruction.dest).begin());
+        break;
+      case Opcode::kOperator:
+        EvaluateLanes(instruction.op, get_register(instruction.dest),
+                      get_register(instruction.a),
+                      get_register(instruction.b));
+        break;
+      case Opcode::kJumpIfZero:
+        if (ToInt(registers[instruction.a]) == 0) {
+          pc = instruction.target;
+        }
+        break;
+      case Opcode::kJump:
+        pc = instruction.target;
+        break;
+    }
+  }
+}
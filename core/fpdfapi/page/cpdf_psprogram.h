@@ -0,0 +1,98 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PAGE_CPDF_PSPROGRAM_H_
+#define CORE_FPDFAPI_PAGE_CPDF_PSPROGRAM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/fpdfapi/page/cpdf_psengine.h"
+#include "core/fxcrt/span.h"
+
+// A PostScript calculator procedure compiled into flat code for a register
+// machine. Stack positions are assigned to registers at compile time, so stack
+// operators like `exch` and `roll` cost nothing when the program runs, and
+// operators whose operands are all constants are evaluated at compile time.
+// Produces the same results as CPDF_PSEngine.
+class CPDF_PSProgram {
+ public:
+  // Returns nullptr if the stack depth at some point in `proc` is not known at
+  // compile time, such as for `roll` by a computed amount, or for `ifelse`
+  // branches that leave different numbers of values on the stack. Those
+  // procedures need CPDF_PSEngine.
+  static std::unique_ptr<CPDF_PSProgram> Compile(const CPDF_PSProc& proc,
+                                                 uint32_t inputs,
+                                                 uint32_t outputs);
+
+  ~CPDF_PSProgram();
+
+  // Runs the program with `inputs` on the stack, and writes the top `outputs`
+  // values from the resulting stack to `results`. Returns false if fewer
+  // values are left, like CPDF_PSEngine::Execute() would.
+  bool Call(pdfium::span<const float> inputs,
+            pdfium::span<float> results) const;
+
+  // Same as Call() for each set of `inputs` values in `inputs`, writing each
+  // set of results one after another to `results`. Programs without branches
+  // evaluate many sets per instruction.
+  bool CallBatch(pdfium::span<const float> inputs,
+                 pdfium::span<float> results) const;
+
+  size_t GetInstructionCountForTesting() const { return instructions_.size(); }
+
+ private:
+  class Compiler;
+
+  enum class Opcode : uint8_t {
+    kConstant,    // dest = value
+    kMove,        // dest = a
+    kOperator,    // dest = op(a, b), or op(a) for unary operators.
+    kJumpIfZero,  // if (saturated_cast<int>(a) == 0) goto target
+    kJump,        // goto target
+  };
+
+  struct Instruction {
+    Opcode opcode;
+    PDF_PSOP op = PSOP_PROC;
+    uint32_t dest = 0;
+    uint32_t a = 0;
+    uint32_t b = 0;
+    float value = 0;
+    uint32_t target = 0;
+  };
+
+  // A stack value that is either known at compile time or in a register.
+  struct Value {
+    static Value Constant(float value) { return {true, value, 0}; }
+    static Value Register(uint32_t reg) { return {false, 0, reg}; }
+
+    bool is_constant;
+    float constant;
+    uint32_t reg;
+  };
+
+  CPDF_PSProgram(uint32_t inputs, uint32_t outputs);
+
+  // Runs the program on `lanes` sets of inputs at once, with the registers
+  // laid out `lanes` floats apart. Only programs without branches can run
+  // more than one set at once.
+  void Run(pdfium::span<float> registers, size_t lanes) const;
+
+  const uint32_t inputs_;
+  const uint32_t outputs_;
+  bool has_branches_ = false;
+  bool has_results_ = false;
+  uint32_t register_count_ = 0;
+  std::vector<Instruction> instructions_;
+  std::vector<Value> results_;  // The bottom of the stack comes first.
+
+  // Pre-allocated scratch space for Call() and CallBatch().
+  mutable std::vector<float> registers_;
+};
+
+#endif  // CORE_FPDFAPI_PAGE_CPDF_PSPROGRAM_H_
@@ -0,0 +1,241 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_psprogram.h"
+
+#include <math.h>
+#include <string.h>
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/fpdfapi/page/cpdf_psengine.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/span.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr float kNaN = std::numeric_limits<float>::quiet_NaN();
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+// Inputs around the usual [0, 1] domain, and some that are not.
+constexpr float kInputValues[] = {0.0f,  0.25f, 0.5f,      0.75f,
+                                  1.0f,  -1.5f, 2.5f,      1e10f,
+                                  -0.0f, kNaN,  kInfinity, -kInfinity};
+
+std::unique_ptr<CPDF_PSEngine> Parse(const char* code) {
+  auto engine = std::make_unique<CPDF_PSEngine>();
+  EXPECT_TRUE(engine->Parse(ByteStringView(code).unsigned_span()));
+  return engine;
+}
+
+// Runs `engine` the way CPDF_PSFunc does without a compiled program.
+bool Interpret(CPDF_PSEngine* engine,
+               pdfium::span<const float> inputs,
+               pdfium::span<float> results) {
+  engine->Reset();
+  for (float input : inputs) {
+    engine->Push(input);
+  }
+  engine->Execute();
+  if (engine->GetStackSize() < results.size()) {
+    return false;
+  }
+  for (size_t i = results.size(); i > 0; --i) {
+    results[i - 1] = engine->Pop();
+  }
+  return true;
+}
+
+bool SameFloat(float a, float b) {
+  return (isnan(a) && isnan(b)) || memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+// Compiles `code`, and checks that the program gives the same results as the
+// interpreter for many combinations of inputs.
+void CheckSameAsEngine(const char* code, uint32_t inputs, uint32_t outputs) {
+  SCOPED_TRACE(code);
+  std::unique_ptr<CPDF_PSEngine> engine = Parse(code);
+  std::unique_ptr<CPDF_PSProgram> program =
+      CPDF_PSProgram::Compile(engine->main_proc(), inputs, outputs);
+  ASSERT_TRUE(program);
+
+  const size_t value_count = std::size(kInputValues);
+  size_t combinations = 1;
+  for (uint32_t i = 0; i < inputs && combinations < 1000; ++i) {
+    combinations *= value_count;
+  }
+  for (size_t combination = 0; combination < combinations; ++combination) {
+    std::vector<float> input_values(inputs);
+    size_t rest = combination;
+    for (float& value : input_values) {
+      value = kInputValues[rest % value_count];
+      rest /= value_count;
+    }
+    std::vector<float> expected(outputs);
+    const bool expected_ok = Interpret(engine.get(), input_values, expected);
+    std::vector<float> actual(outputs);
+    ASSERT_EQ(expected_ok, program->Call(input_values, actual));
+    if (!expected_ok) {
+      continue;
+    }
+    for (uint32_t i = 0; i < outputs; ++i) {
+      EXPECT_TRUE(SameFloat(expected[i], actual[i]))
+          << "combination " << combination << " output " << i << ": "
+          << expected[i] << " vs " << actual[i];
+    }
+  }
+}
+
+}  // namespace
+
+TEST(CPDFPSProgramTest, Arithmetic) {
+  CheckSameAsEngine("{ 2 3 add mul }", 1, 1);
+  CheckSameAsEngine("{ dup mul exch dup mul add sqrt }", 2, 1);
+  CheckSameAsEngine("{ sub div idiv mod }", 4, 1);
+  CheckSameAsEngine("{ neg abs ceiling exch floor add round truncate }", 2, 1);
+  CheckSameAsEngine("{ 360 mul sin 1 add 2 div exch cos }", 2, 2);
+  CheckSameAsEngine("{ atan exch exp }", 3, 2);
+  CheckSameAsEngine("{ ln exch log cvi exch cvr }", 3, 3);
+  CheckSameAsEngine("{ 1000 mul cvi 3 and exch 255 mul cvi 2 bitshift xor }",
+                    2, 1);
+  CheckSameAsEngine("{ -3 bitshift exch cvi not or }", 2, 1);
+}
+
+TEST(CPDFPSProgramTest, Comparisons) {
+  CheckSameAsEngine("{ 2 copy eq 3 1 roll 2 copy ne 3 1 roll gt }", 2, 3);
+  CheckSameAsEngine("{ 2 copy ge 3 1 roll 2 copy lt 3 1 roll le }", 2, 3);
+  CheckSameAsEngine("{ 0.5 gt true false }", 1, 3);
+}
+
+TEST(CPDFPSProgramTest, StackOperators) {
+  // Typical tint transforms for Separation and DeviceN color spaces.
+  CheckSameAsEngine("{ dup 0.2 mul exch dup 0.5 mul exch dup 0 mul exch }", 1,
+                    4);
+  CheckSameAsEngine("{ 3 index 3 index add 2 index 5 2 roll pop pop pop }", 4,
+                    2);
+  CheckSameAsEngine("{ 1 index 2 index add 3 1 roll pop }", 3, 2);
+  CheckSameAsEngine("{ 4 -1 roll 4 1 roll 3 2 roll exch }", 4, 4);
+  CheckSameAsEngine("{ 3 copy 6 1 roll pop pop 2 copy }", 3, 5);
+  CheckSameAsEngine("{ 7 index 0 copy -1 index }", 2, 2);
+
+  // Popping more than there is gives zeros.
+  CheckSameAsEngine("{ pop pop pop 1 }", 1, 1);
+  CheckSameAsEngine("{ exch }", 1, 2);
+  CheckSameAsEngine("{ add add add }", 2, 1);
+
+  // A computed count does nothing on an empty stack.
+  CheckSameAsEngine("{ 0 gt copy 1 }", 1, 1);
+  CheckSameAsEngine("{ 0 gt index 1 }", 1, 1);
+}
+
+TEST(CPDFPSProgramTest, StackOverflow) {
+  std::string code = "{";
+  for (int i = 0; i < 120; ++i) {
+    code += " dup 1 add";
+  }
+  code += " add add }";
+  CheckSameAsEngine(code.c_str(), 1, 2);
+
+  code = "{";
+  for (int i = 0; i < 110; ++i) {
+    code += " 1 1 copy";
+  }
+  code += " }";
+  CheckSameAsEngine(code.c_str(), 2, 4);
+}
+
+TEST(CPDFPSProgramTest, Branches) {
+  CheckSameAsEngine("{ 0.5 gt { 1 0 } { 0 1 } ifelse }", 1, 2);
+  CheckSameAsEngine("{ dup 0.5 lt { 2 mul } if }", 1, 1);
+  CheckSameAsEngine("{ exch dup 0.5 gt { exch } if }", 2, 3);
+  CheckSameAsEngine(
+      "{ dup 0.3 lt { pop 0 } { dup 0.6 lt { 2 mul } { 3 mul 1 exch sub } "
+      "ifelse } ifelse }",
+      1, 1);
+  CheckSameAsEngine(
+      "{ 2 copy gt { exch } { 1 index exch pop } ifelse 3 copy add }", 2,
+      4);
+  CheckSameAsEngine("{ dup 0 le { pop 1 } if dup 1 ge { pop 0 } if }", 1, 1);
+  CheckSameAsEngine("{ 1 exch 0.5 gt { pop 2 } if }", 1, 1);
+}
+
+TEST(CPDFPSProgramTest, ConstantConditions) {
+  CheckSameAsEngine("{ true { 1 } { 2 } ifelse }", 1, 2);
+  CheckSameAsEngine("{ 1 2 gt { 3 4 } { 5 } ifelse }", 1, 2);
+  CheckSameAsEngine("{ 0.5 { 3 } if }", 1, 1);
+}
+
+TEST(CPDFPSProgramTest, MalformedConditionals) {
+  // An `if` or `ifelse` without procedures ends the procedure it is in.
+  CheckSameAsEngine("{ 1 if 2 }", 1, 1);
+  CheckSameAsEngine("{ 1 { 2 } ifelse 3 }", 1, 2);
+  CheckSameAsEngine("{ dup 0.5 gt { 2 if 5 } { 7 } ifelse 9 }", 1, 3);
+}
+
+TEST(CPDFPSProgramTest, TooFewResults) {
+  CheckSameAsEngine("{ pop }", 1, 1);
+  CheckSameAsEngine("{ }", 2, 3);
+}
+
+TEST(CPDFPSProgramTest, ConstantFolding) {
+  std::unique_ptr<CPDF_PSEngine> engine = Parse("{ 2 3 add 4 mul mul }");
+  auto program = CPDF_PSProgram::Compile(engine->main_proc(), 1, 1);
+  ASSERT_TRUE(program);
+  EXPECT_EQ(2u, program->GetInstructionCountForTesting());
+  const float input = 2.0f;
+  float result;
+  ASSERT_TRUE(program->Call(pdfium::span_from_ref(input),
+                            pdfium::span_from_ref(result)));
+  EXPECT_FLOAT_EQ(40.0f, result);
+
+  // Stack operators need no instructions.
+  engine = Parse("{ 1 2 3 4 5 2 copy 3 index 4 -2 roll exch dup pop }");
+  program = CPDF_PSProgram::Compile(engine->main_proc(), 1, 3);
+  ASSERT_TRUE(program);
+  EXPECT_EQ(0u, program->GetInstructionCountForTesting());
+}
+
+TEST(CPDFPSProgramTest, NotCompiled) {
+  // The stack depth after these depends on the inputs.
+  for (const char* code :
+       {"{ dup dup roll }", "{ copy }", "{ index }", "{ 1 exch roll }",
+        "{ 0.5 gt { 1 } if }", "{ 0.5 gt { 1 } { 1 2 } ifelse }"}) {
+    SCOPED_TRACE(code);
+    std::unique_ptr<CPDF_PSEngine> engine = Parse(code);
+    EXPECT_FALSE(CPDF_PSProgram::Compile(engine->main_proc(), 2, 1));
+  }
+}
+
+TEST(CPDFPSProgramTest, CallBatch) {
+  for (const char* code :
+       {"{ 2 copy mul 3 1 roll add }", "{ 0.5 gt { 1 0 } { 0 1 } ifelse }",
+        "{ dup 0.5 lt { 2 mul } if 3 }"}) {
+    SCOPED_TRACE(code);
+    std::unique_ptr<CPDF_PSEngine> engine = Parse(code);
+    auto program = CPDF_PSProgram::Compile(engine->main_proc(), 2, 2);
+    ASSERT_TRUE(program);
+
+    // More sets than run through an instruction at once, and not a multiple
+    // of that.
+    constexpr size_t kCount = 77;
+    std::vector<float> inputs(kCount * 2);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      inputs[i] = i / 100.0f;
+    }
+    std::vector<float> results(kCount * 2);
+    ASSERT_TRUE(program->CallBatch(inputs, results));
+    for (size_t i = 0; i < kCount; ++i) {
+      float expected[2];
+      ASSERT_TRUE(Interpret(engine.get(),
+                            pdfium::span(inputs).subspan(i * 2, 2u),
+                            expected));
+      EXPECT_FLOAT_EQ(expected[0], results[i * 2]);
+      EXPECT_FLOAT_EQ(expected[1], results[i * 2 + 1]);
+    }
+  }
+}
@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
@@ -21,6 +22,10 @@
 
 namespace {
 
+// Bounds the memory for CPDF_SampledFunc::sample_table_. Larger functions
+// read samples from the stream for each call instead.
+constexpr size_t kMaxSampleTableSize = 1024 * 1024;
+
 // See PDF Reference 1.7, page 170, table 3.36.
 bool IsValidBitsPerSample(uint32_t x) {
   switch (x) {
@@ -191,6 +196,80 @@ bool CPDF_SampledFunc::v_Call(pdfium::span<const float> inputs,
   return true;
 }
 
+bool CPDF_SampledFunc::v_CallBatch(pdfium::span<const float> inputs,
+                                   pdfium::span<float> results) const {
+  if (!LoadSampleTable()) {
+    return CPDF_Function::v_CallBatch(inputs, results);
+  }
+
+  // Same as v_Call() for each set of inputs, but with the samples unpacked,
+  // so the values do not depend on the bit stream. The table size bounds all
+  // positions, so they do not overflow.
+  std::vector<uint32_t> blocksize(inputs_);
+  for (uint32_t i = 0; i < inputs_; i++) {
+    blocksize[i] = i == 0 ? 1 : blocksize[i - 1] * encode_info_[i - 1].sizes;
+  }
+  std::vector<float> encoded_input(inputs_);
+  std::vector<uint32_t> index(inputs_);
+  const size_t count = inputs.size() / inputs_;
+  for (size_t set = 0; set < count; ++set) {
+    pdfium::span<const float> set_inputs =
+        inputs.subspan(set * inputs_, inputs_);
+    pdfium::span<float> set_results = results.subspan(set * outputs_, outputs_);
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i < inputs_; i++) {
+      encoded_input[i] =
+          Interpolate(set_inputs[i], domains_[i * 2], domains_[i * 2 + 1],
+                      encode_info_[i].encode_min, encode_info_[i].encode_max);
+      index[i] = std::clamp(static_cast<uint32_t>(encoded_input[i]), 0U,
+                            encode_info_[i].sizes - 1);
+      pos += index[i] * blocksize[i];
+    }
+    for (uint32_t i = 0; i < outputs_; ++i) {
+      uint32_t sample = sample_table_[pos * outputs_ + i];
+      float encoded = sample;
+      for (uint32_t j = 0; j < inputs_; ++j) {
+        if (index[j] == encode_info_[j].sizes - 1) {
+          if (index[j] == 0) {
+            encoded = encoded_input[j] * sample;
+          }
+        } else {
+          float sample2 = static_cast<float>(
+              sample_table_[(blocksize[j] + pos) * outputs_ + i]);
+          encoded += (encoded_input[j] - index[j]) * (sample2 - sample);
+        }
+      }
+      set_results[i] =
+          Interpolate(encoded, 0, sample_max_, decode_info_[i].decode_min,
+                      decode_info_[i].decode_max);
+    }
+  }
+  return true;
+}
+
+bool CPDF_SampledFunc::LoadSampleTable() const {
+  if (!sample_table_.empty()) {
+    return true;
+  }
+
+  FX_SAFE_SIZE_T sample_count = outputs_;
+  for (const SampleEncodeInfo& info : encode_info_) {
+    sample_count *= info.sizes;
+  }
+  if (!sample_count.IsValid() ||
+      sample_count.ValueOrDie() > kMaxSampleTableSize) {
+    return false;
+  }
+
+  // v_Init() checked that the stream has all the samples.
+  CFX_BitStream bitstream(sample_stream_->GetSpan());
+  sample_table_.resize(sample_count.ValueOrDie());
+  for (uint32_t& sample : sample_table_) {
+    sample = bitstream.GetBits(bits_per_sample_);
+  }
+  return true;
+}
+
 #if defined(PDF_USE_SKIA)
 RetainPtr<CPDF_StreamAcc> CPDF_SampledFunc::GetSampleStream() const {
   return sample_stream_;
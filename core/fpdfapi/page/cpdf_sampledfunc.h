@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "core/fpdfapi/page/cpdf_function.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/retain_ptr.h"
 
 class CPDF_StreamAcc;
@@ -34,6 +35,8 @@ class CPDF_SampledFunc final : public CPDF_Function {
   bool v_Init(const CPDF_Object* pObj, VisitedSet* pVisited) override;
   bool v_Call(pdfium::span<const float> inputs,
               pdfium::span<float> results) const override;
+  bool v_CallBatch(pdfium::span<const float> inputs,
+                   pdfium::span<float> results) const override;
 
   const std::vector<SampleEncodeInfo>& GetEncodeInfo() const {
     return encode_info_;
@@ -45,11 +48,16 @@ class CPDF_SampledFunc final : public CPDF_Function {
 #endif
 
  private:
+  // Unpacks all samples into `sample_table_` the first time it is called,
+  // unless there are too many. Returns whether `sample_table_` is usable.
+  bool LoadSampleTable() const;
+
   std::vector<SampleEncodeInfo> encode_info_;
   std::vector<SampleDecodeInfo> decode_info_;
   uint32_t bits_per_sample_ = 0;
   uint32_t sample_max_ = 0;
   RetainPtr<CPDF_StreamAcc> sample_stream_;
+  mutable DataVector<uint32_t> sample_table_;  // Unpacked for v_CallBatch().
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_SAMPLEDFUNC_H_
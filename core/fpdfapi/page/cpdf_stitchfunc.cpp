@@ -7,11 +7,13 @@
 #include "core/fpdfapi/page/cpdf_stitchfunc.h"
 
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/span.h"
 #include "core/fxcrt/stl_util.h"
 
 namespace {
@@ -121,15 +123,66 @@ bool CPDF_StitchFunc::v_Init(const CPDF_Object* pObj, VisitedSet* pVisited) {
 bool CPDF_StitchFunc::v_Call(pdfium::span<const float> inputs,
                              pdfium::span<float> results) const {
   float input = inputs[0];
+  size_t i = FindSubFunction(input);
+  input = Interpolate(input, bounds_[i], bounds_[i + 1], encode_[i * 2],
+                      encode_[i * 2 + 1]);
+  return sub_functions_[i]
+      ->Call(pdfium::span_from_ref(input), results)
+      .has_value();
+}
+
+bool CPDF_StitchFunc::v_CallBatch(pdfium::span<const float> inputs,
+                                  pdfium::span<float> results) const {
+  // Sort the inputs by sub-function, keeping their order otherwise, so that
+  // each sub-function gets one batch.
+  std::vector<size_t> sub_function_indices(inputs.size());
+  std::vector<size_t> offsets(sub_functions_.size() + 1);
+  for (size_t k = 0; k < inputs.size(); ++k) {
+    sub_function_indices[k] = FindSubFunction(inputs[k]);
+    ++offsets[sub_function_indices[k] + 1];
+  }
+  for (size_t i = 1; i < offsets.size(); ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+  std::vector<size_t> order(inputs.size());
+  {
+    std::vector<size_t> next = offsets;
+    for (size_t k = 0; k < inputs.size(); ++k) {
+      order[next[sub_function_indices[k]]++] = k;
+    }
+  }
+
+  std::vector<float> sub_inputs;
+  std::vector<float> sub_results;
+  for (size_t i = 0; i < sub_functions_.size(); ++i) {
+    pdfium::span<const size_t> batch =
+        pdfium::span(order).subspan(offsets[i], offsets[i + 1] - offsets[i]);
+    if (batch.empty()) {
+      continue;
+    }
+    sub_inputs.resize(batch.size());
+    for (size_t k = 0; k < batch.size(); ++k) {
+      sub_inputs[k] = Interpolate(inputs[batch[k]], bounds_[i], bounds_[i + 1],
+                                  encode_[i * 2], encode_[i * 2 + 1]);
+    }
+    sub_results.resize(batch.size() * outputs_);
+    if (!sub_functions_[i]->CallBatch(sub_inputs, sub_results).has_value()) {
+      return false;
+    }
+    for (size_t k = 0; k < batch.size(); ++k) {
+      fxcrt::Copy(pdfium::span(sub_results).subspan(k * outputs_, outputs_),
+                  results.subspan(batch[k] * outputs_, outputs_));
+    }
+  }
+  return true;
+}
+
+size_t CPDF_StitchFunc::FindSubFunction(float input) const {
   size_t i;
   for (i = 0; i + 1 < sub_functions_.size(); i++) {
     if (input < bounds_[i + 1]) {
       break;
     }
   }
-  input = Interpolate(input, bounds_[i], bounds_[i + 1], encode_[i * 2],
-                      encode_[i * 2 + 1]);
-  return sub_functions_[i]
-      ->Call(pdfium::span_from_ref(input), results)
-      .has_value();
+  return i;
 }
@@ -21,6 +21,8 @@ class CPDF_StitchFunc final : public CPDF_Function {
   bool v_Init(const CPDF_Object* pObj, VisitedSet* pVisited) override;
   bool v_Call(pdfium::span<const float> inputs,
               pdfium::span<float> results) const override;
+  bool v_CallBatch(pdfium::span<const float> inputs,
+                   pdfium::span<float> results) const override;
 
   const std::vector<std::unique_ptr<CPDF_Function>>& GetSubFunctions() const {
     return sub_functions_;
@@ -29,6 +31,9 @@ class CPDF_StitchFunc final : public CPDF_Function {
   float GetEncode(size_t i) const { return encode_[i]; }
 
  private:
+  // Returns the index of the sub-function for `input`.
+  size_t FindSubFunction(float input) const;
+
   std::vector<std::unique_ptr<CPDF_Function>> sub_functions_;
   std::vector<float> bounds_;
   std::vector<float> encode_;
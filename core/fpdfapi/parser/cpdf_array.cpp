@@ -10,6 +10,7 @@
 #include <utility>
 
 #include "core/fpdfapi/parser/cpdf_boolean.h"
+#include "core/fpdfapi/parser/cpdf_change_tracker.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
@@ -46,6 +47,18 @@ RetainPtr<CPDF_Object> CPDF_Array::Clone() const {
   return CloneObjectNonCyclic(false);
 }
 
+void CPDF_Array::SetChangeTracker(const WeakPtr<CPDF_ChangeTracker>& tracker,
+                                  uint32_t objnum) {
+  if (change_tracker_ == tracker && tracked_obj_num_ == objnum) {
+    return;
+  }
+  change_tracker_ = tracker;
+  tracked_obj_num_ = objnum;
+  for (auto& obj : objects_) {
+    obj->SetChangeTracker(tracker, objnum);
+  }
+}
+
 RetainPtr<CPDF_Object> CPDF_Array::CloneNonCyclic(
     bool bDirect,
     std::set<const CPDF_Object*>* pVisited) const {
@@ -204,13 +217,18 @@ RetainPtr<const CPDF_String> CPDF_Array::GetStringAt(size_t index) const {
 
 void CPDF_Array::Clear() {
   CHECK(!IsLocked());
+  if (objects_.empty()) {
+    return;
+  }
   objects_.clear();
+  MarkChanged();
 }
 
 void CPDF_Array::RemoveAt(size_t index) {
   CHECK(!IsLocked());
   if (index < objects_.size()) {
     objects_.erase(objects_.begin() + index);
+    MarkChanged();
   }
 }
 
@@ -227,6 +245,7 @@ void CPDF_Array::ConvertToIndirectObjectAt(size_t index,
 
   pHolder->AddIndirectObject(objects_[index]);
   objects_[index] = objects_[index]->MakeReference(pHolder);
+  MarkChanged();
 }
 
 void CPDF_Array::SetAt(size_t index, RetainPtr<CPDF_Object> object) {
@@ -251,6 +270,8 @@ CPDF_Object* CPDF_Array::SetAtInternal(size_t index,
     return nullptr;
   }
 
+  TrackChangesOf(pObj.Get());
+  MarkChanged();
   CPDF_Object* pRet = pObj.Get();
   objects_[index] = std::move(pObj);
   return pRet;
@@ -266,6 +287,8 @@ CPDF_Object* CPDF_Array::InsertAtInternal(size_t index,
     return nullptr;
   }
 
+  TrackChangesOf(pObj.Get());
+  MarkChanged();
   CPDF_Object* pRet = pObj.Get();
   objects_.insert(objects_.begin() + index, std::move(pObj));
   return pRet;
@@ -276,11 +299,25 @@ CPDF_Object* CPDF_Array::AppendInternal(RetainPtr<CPDF_Object> pObj) {
   CHECK(pObj);
   CHECK(pObj->IsInline());
   CHECK(!pObj->IsStream());
+  TrackChangesOf(pObj.Get());
+  MarkChanged();
   CPDF_Object* pRet = pObj.Get();
   objects_.push_back(std::move(pObj));
   return pRet;
 }
 
+void CPDF_Array::TrackChangesOf(CPDF_Object* obj) {
+  if (change_tracker_) {
+    obj->SetChangeTracker(change_tracker_, tracked_obj_num_);
+  }
+}
+
+void CPDF_Array::MarkChanged() {
+  if (change_tracker_) {
+    change_tracker_->MarkChanged(tracked_obj_num_);
+  }
+}
+
 bool CPDF_Array::WriteTo(IFX_ArchiveStream* archive,
                          const CPDF_Encryptor* encryptor) const {
   if (!archive->WriteString("[")) {
@@ -36,6 +36,8 @@ class CPDF_Array final : public CPDF_Object {
   CPDF_Array* AsMutableArray() override;
   bool WriteTo(IFX_ArchiveStream* archive,
                const CPDF_Encryptor* encryptor) const override;
+  void SetChangeTracker(const WeakPtr<CPDF_ChangeTracker>& tracker,
+                        uint32_t objnum) override;
 
   bool IsEmpty() const { return objects_.empty(); }
   size_t size() const { return objects_.size(); }
@@ -162,6 +164,10 @@ class CPDF_Array final : public CPDF_Object {
   CPDF_Object* AppendInternal(RetainPtr<CPDF_Object> pObj);
   CPDF_Object* SetAtInternal(size_t index, RetainPtr<CPDF_Object> pObj);
   CPDF_Object* InsertAtInternal(size_t index, RetainPtr<CPDF_Object> pObj);
+  // Has `obj`, just added to this array, report its changes the same way as
+  // this array does.
+  void TrackChangesOf(CPDF_Object* obj);
+  void MarkChanged();
 
   RetainPtr<CPDF_Object> CloneNonCyclic(
       bool bDirect,
@@ -169,7 +175,9 @@ class CPDF_Array final : public CPDF_Object {
 
   std::vector<RetainPtr<CPDF_Object>> objects_;
   WeakPtr<ByteStringPool> pool_;
+  WeakPtr<CPDF_ChangeTracker> change_tracker_;
   mutable uint32_t lock_count_ = 0;
+  uint32_t tracked_obj_num_ = 0;
 };
 
 class CPDF_ArrayLocker {
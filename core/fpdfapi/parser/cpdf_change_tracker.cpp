@@ -0,0 +1,17 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_change_tracker.h"
+
+CPDF_ChangeTracker::CPDF_ChangeTracker() = default;
+
+CPDF_ChangeTracker::~CPDF_ChangeTracker() = default;
+
+void CPDF_ChangeTracker::MarkChanged(uint32_t objnum) {
+  if (objnum == last_changed_obj_num_) {
+    return;
+  }
+  changed_obj_nums_.insert(objnum);
+  last_changed_obj_num_ = objnum;
+}
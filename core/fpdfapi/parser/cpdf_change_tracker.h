@@ -0,0 +1,37 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_CPDF_CHANGE_TRACKER_H_
+#define CORE_FPDFAPI_PARSER_CPDF_CHANGE_TRACKER_H_
+
+#include <stdint.h>
+
+#include <set>
+
+// Records which indirect objects of a CPDF_IndirectObjectHolder were added,
+// changed or deleted after loading, so that an incremental save only has to
+// write those. Arrays, dictionaries and streams report their own changes once
+// CPDF_Object::SetChangeTracker() has been called on them, which the holder
+// does for every indirect object it parses or adds.
+class CPDF_ChangeTracker {
+ public:
+  CPDF_ChangeTracker();
+  ~CPDF_ChangeTracker();
+
+  void MarkChanged(uint32_t objnum);
+
+  // In ascending order.
+  const std::set<uint32_t>& changed_obj_nums() const {
+    return changed_obj_nums_;
+  }
+
+ private:
+  std::set<uint32_t> changed_obj_nums_;
+
+  // Filling in an object changes it many times in a row, so remember the last
+  // change to skip looking it up again.
+  uint32_t last_changed_obj_num_ = 0;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_CPDF_CHANGE_TRACKER_H_
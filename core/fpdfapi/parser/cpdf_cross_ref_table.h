@@ -7,9 +7,9 @@
 
 #include <stdint.h>
 
-#include <map>
 #include <memory>
 
+#include "core/fpdfapi/parser/object_number_map.h"
 #include "core/fxcrt/fx_types.h"
 #include "core/fxcrt/retain_ptr.h"
 
@@ -67,17 +67,21 @@ class CPDF_CrossRefTable {
 
   const ObjectInfo* GetObjectInfo(uint32_t obj_num) const;
 
-  const std::map<uint32_t, ObjectInfo>& objects_info() const {
+  const ObjectNumberMap<ObjectInfo>& objects_info() const {
     return objects_info_;
   }
 
+  // Replaces all entries. Used when the entries come from CPDF_ParseCache
+  // instead of the file's cross reference sections.
+  void SetObjectsInfo(ObjectNumberMap<ObjectInfo> objects_info);
+
   void Update(std::unique_ptr<CPDF_CrossRefTable> new_cross_ref);
 
   // Objects with object number >= `size` will be removed.
   void SetObjectMapSize(uint32_t size);
 
  private:
-  void UpdateInfo(std::map<uint32_t, ObjectInfo> new_objects_info);
+  void UpdateInfo(ObjectNumberMap<ObjectInfo> new_objects_info);
   void UpdateTrailer(RetainPtr<CPDF_Dictionary> new_trailer);
 
   RetainPtr<CPDF_Dictionary> trailer_;
@@ -85,7 +89,7 @@ class CPDF_CrossRefTable {
   // inline, it has no object number. Store the stream's object number, or 0 if
   // there is none.
   uint32_t trailer_object_number_ = 0;
-  std::map<uint32_t, ObjectInfo> objects_info_;
+  ObjectNumberMap<ObjectInfo> objects_info_;
 };
 
 #endif  // CORE_FPDFAPI_PARSER_CPDF_CROSS_REF_TABLE_H_
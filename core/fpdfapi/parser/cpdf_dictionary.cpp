@@ -11,6 +11,7 @@
 
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_boolean.h"
+#include "core/fpdfapi/parser/cpdf_change_tracker.h"
 #include "core/fpdfapi/parser/cpdf_crypto_handler.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
@@ -28,6 +29,18 @@ CPDF_Dictionary::CPDF_Dictionary()
 CPDF_Dictionary::CPDF_Dictionary(const WeakPtr<ByteStringPool>& pPool)
     : pool_(pPool) {}
 
+CPDF_Dictionary::CPDF_Dictionary(const WeakPtr<ByteStringPool>& pPool,
+                                 std::vector<DictMap::value_type> entries)
+    : pool_(pPool) {
+  for (auto& entry : entries) {
+    CHECK(entry.second);
+    CHECK(entry.second->IsInline());
+    CHECK(!entry.second->IsStream());
+    entry.first = MaybeIntern(entry.first);
+  }
+  map_ = DictMap::FromUnsorted(std::move(entries));
+}
+
 CPDF_Dictionary::~CPDF_Dictionary() {
   // Mark the object as deleted so that it will not be deleted again,
   // and break cyclic references.
@@ -51,6 +64,19 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::Clone() const {
   return CloneObjectNonCyclic(false);
 }
 
+void CPDF_Dictionary::SetChangeTracker(
+    const WeakPtr<CPDF_ChangeTracker>& tracker,
+    uint32_t objnum) {
+  if (change_tracker_ == tracker && tracked_obj_num_ == objnum) {
+    return;
+  }
+  change_tracker_ = tracker;
+  tracked_obj_num_ = objnum;
+  for (auto& it : map_) {
+    it.second->SetChangeTracker(tracker, objnum);
+  }
+}
+
 RetainPtr<CPDF_Object> CPDF_Dictionary::CloneNonCyclic(
     bool bDirect,
     std::set<const CPDF_Object*>* pVisited) const {
@@ -62,7 +88,7 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::CloneNonCyclic(
       std::set<const CPDF_Object*> visited(*pVisited);
       auto obj = it.second->CloneNonCyclic(bDirect, &visited);
       if (obj) {
-        pCopy->map_.insert(std::make_pair(it.first, std::move(obj)));
+        pCopy->map_.InsertOrAssign(it.first, std::move(obj));
       }
     }
   }
@@ -257,7 +283,7 @@ CFX_Matrix CPDF_Dictionary::GetMatrixFor(ByteStringView key) const {
 }
 
 bool CPDF_Dictionary::KeyExist(ByteStringView key) const {
-  return pdfium::Contains(map_, key);
+  return map_.contains(key);
 }
 
 std::vector<ByteString> CPDF_Dictionary::GetKeys() const {
@@ -278,27 +304,32 @@ CPDF_Object* CPDF_Dictionary::SetForInternal(const ByteString& key,
                                              RetainPtr<CPDF_Object> pObj) {
   CHECK(!IsLocked());
   if (!pObj) {
-    map_.erase(key);
+    auto it = map_.find(key.AsStringView());
+    if (it != map_.end()) {
+      map_.erase(it);
+      MarkChanged();
+    }
     return nullptr;
   }
   CHECK(pObj->IsInline());
   CHECK(!pObj->IsStream());
-  CPDF_Object* pRet = pObj.Get();
-  map_[MaybeIntern(key)] = std::move(pObj);
-  return pRet;
+  TrackChangesOf(pObj.Get());
+  MarkChanged();
+  return map_.InsertOrAssign(MaybeIntern(key), std::move(pObj)).Get();
 }
 
 void CPDF_Dictionary::ConvertToIndirectObjectFor(
     const ByteString& key,
     CPDF_IndirectObjectHolder* pHolder) {
   CHECK(!IsLocked());
-  auto it = map_.find(key);
+  auto it = map_.find(key.AsStringView());
   if (it == map_.end() || it->second->IsReference()) {
     return;
   }
 
   pHolder->AddIndirectObject(it->second);
   it->second = it->second->MakeReference(pHolder);
+  MarkChanged();
 }
 
 RetainPtr<CPDF_Object> CPDF_Dictionary::RemoveFor(ByteStringView key) {
@@ -307,25 +338,29 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::RemoveFor(ByteStringView key) {
   if (it == map_.end()) {
     return RetainPtr<CPDF_Object>();
   }
-  auto node = map_.extract(it);
-  return std::move(node.mapped());
+  RetainPtr<CPDF_Object> result = std::move(it->second);
+  map_.erase(it);
+  MarkChanged();
+  return result;
 }
 
 void CPDF_Dictionary::ReplaceKey(const ByteString& oldkey,
                                  const ByteString& newkey) {
   CHECK(!IsLocked());
-  auto old_it = map_.find(oldkey);
+  auto old_it = map_.find(oldkey.AsStringView());
   if (old_it == map_.end()) {
     return;
   }
 
-  auto new_it = map_.find(newkey);
+  auto new_it = map_.find(newkey.AsStringView());
   if (new_it == old_it) {
     return;
   }
 
-  map_[MaybeIntern(newkey)] = std::move(old_it->second);
+  RetainPtr<CPDF_Object> object = std::move(old_it->second);
   map_.erase(old_it);
+  map_.InsertOrAssign(MaybeIntern(newkey), std::move(object));
+  MarkChanged();
 }
 
 void CPDF_Dictionary::SetRectFor(const ByteString& key,
@@ -352,6 +387,18 @@ ByteString CPDF_Dictionary::MaybeIntern(const ByteString& str) {
   return pool_ ? pool_->Intern(str) : str;
 }
 
+void CPDF_Dictionary::TrackChangesOf(CPDF_Object* obj) {
+  if (change_tracker_) {
+    obj->SetChangeTracker(change_tracker_, tracked_obj_num_);
+  }
+}
+
+void CPDF_Dictionary::MarkChanged() {
+  if (change_tracker_) {
+    change_tracker_->MarkChanged(tracked_obj_num_);
+  }
+}
+
 bool CPDF_Dictionary::WriteTo(IFX_ArchiveStream* archive,
                               const CPDF_Encryptor* encryptor) const {
   if (!archive->WriteString("<<")) {
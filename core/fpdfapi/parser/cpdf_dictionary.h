@@ -7,14 +7,13 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_DICTIONARY_H_
 #define CORE_FPDFAPI_PARSER_CPDF_DICTIONARY_H_
 
-#include <functional>
-#include <map>
 #include <set>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "core/fpdfapi/parser/cpdf_object.h"
+#include "core/fpdfapi/parser/dictionary_map.h"
 #include "core/fxcrt/bytestring_pool.h"
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/fx_coordinates.h"
@@ -28,7 +27,7 @@ class CPDF_IndirectObjectHolder;
 // will return nullptr to indicate non-existent keys.
 class CPDF_Dictionary final : public CPDF_Object {
  public:
-  using DictMap = std::map<ByteString, RetainPtr<CPDF_Object>, std::less<>>;
+  using DictMap = DictionaryMap<RetainPtr<CPDF_Object>>;
   using const_iterator = DictMap::const_iterator;
 
   CONSTRUCT_VIA_MAKE_RETAIN;
@@ -39,6 +38,8 @@ class CPDF_Dictionary final : public CPDF_Object {
   CPDF_Dictionary* AsMutableDictionary() override;
   bool WriteTo(IFX_ArchiveStream* archive,
                const CPDF_Encryptor* encryptor) const override;
+  void SetChangeTracker(const WeakPtr<CPDF_ChangeTracker>& tracker,
+                        uint32_t objnum) override;
 
   bool IsLocked() const { return !!lock_count_; }
 
@@ -131,6 +132,11 @@ class CPDF_Dictionary final : public CPDF_Object {
 
   CPDF_Dictionary();
   explicit CPDF_Dictionary(const WeakPtr<ByteStringPool>& pPool);
+  // Takes `entries` in any order, e.g. as read from a file. Where keys repeat,
+  // the last entry wins, as with calling SetFor() for each entry. Cheaper than
+  // SetFor() for dictionaries with many entries.
+  CPDF_Dictionary(const WeakPtr<ByteStringPool>& pPool,
+                  std::vector<DictMap::value_type> entries);
   ~CPDF_Dictionary() override;
 
   // No guarantees about result lifetime, use with caution.
@@ -145,13 +151,19 @@ class CPDF_Dictionary final : public CPDF_Object {
                               RetainPtr<CPDF_Object> pObj);
 
   ByteString MaybeIntern(const ByteString& str);
+  // Has `obj`, just added to this dictionary, report its changes the same way
+  // as this dictionary does.
+  void TrackChangesOf(CPDF_Object* obj);
+  void MarkChanged();
   const CPDF_Dictionary* GetDictInternal() const override;
   RetainPtr<CPDF_Object> CloneNonCyclic(
       bool bDirect,
       std::set<const CPDF_Object*>* visited) const override;
 
   mutable uint32_t lock_count_ = 0;
+  uint32_t tracked_obj_num_ = 0;
   WeakPtr<ByteStringPool> pool_;
+  WeakPtr<CPDF_ChangeTracker> change_tracker_;
   DictMap map_;
 };
 
@@ -5,11 +5,15 @@
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
+#include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+using testing::ElementsAre;
+
 TEST(DictionaryTest, Iterators) {
   auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
   dict->SetNewFor<CPDF_Dictionary>("the-dictionary");
@@ -35,3 +39,18 @@ TEST(DictionaryTest, Iterators) {
   ++it;
   EXPECT_EQ(it, locked_dict.end());
 }
+
+TEST(DictionaryTest, ConstructFromUnsortedEntries) {
+  std::vector<CPDF_Dictionary::DictMap::value_type> entries;
+  entries.emplace_back("b", pdfium::MakeRetain<CPDF_Number>(1));
+  entries.emplace_back("a", pdfium::MakeRetain<CPDF_Number>(2));
+  entries.emplace_back("b", pdfium::MakeRetain<CPDF_Number>(3));
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>(WeakPtr<ByteStringPool>(),
+                                                  std::move(entries));
+
+  // The last duplicate wins, as with SetFor().
+  EXPECT_EQ(2u, dict->size());
+  EXPECT_EQ(2, dict->GetIntegerFor("a"));
+  EXPECT_EQ(3, dict->GetIntegerFor("b"));
+  EXPECT_THAT(dict->GetKeys(), ElementsAre("a", "b"));
+}
@@ -18,6 +18,7 @@
 #include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_null.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_parse_cache.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
 #include "core/fpdfapi/parser/cpdf_read_validator.h"
 #include "core/fpdfapi/parser/cpdf_reference.h"
@@ -216,10 +217,20 @@ bool CPDF_Document::TryInit() {
 CPDF_Parser::Error CPDF_Document::LoadDoc(
     RetainPtr<IFX_SeekableReadStream> pFileAccess,
     const ByteString& password) {
+  return LoadDocWithParseCache(std::move(pFileAccess), password, nullptr);
+}
+
+CPDF_Parser::Error CPDF_Document::LoadDocWithParseCache(
+    RetainPtr<IFX_SeekableReadStream> pFileAccess,
+    const ByteString& password,
+    std::unique_ptr<CPDF_ParseCache> parse_cache) {
   if (!parser_) {
     SetParser(std::make_unique<CPDF_Parser>(this));
   }
 
+  if (parse_cache) {
+    parser_->SetParseCache(std::move(parse_cache));
+  }
   return HandleLoadResult(
       parser_->StartParse(std::move(pFileAccess), password));
 }
@@ -236,6 +247,12 @@ CPDF_Parser::Error CPDF_Document::LoadLinearizedDoc(
 }
 
 void CPDF_Document::LoadPages() {
+  const CPDF_ParseCache* parse_cache = parser_->GetUsedParseCache();
+  if (parse_cache && parse_cache->page_obj_nums.size() <= kPageMaxNum) {
+    page_list_ = parse_cache->page_obj_nums;
+    return;
+  }
+
   const CPDF_LinearizedHeader* linearized_header =
       parser_->GetLinearizedHeader();
   if (!linearized_header) {
@@ -402,6 +419,18 @@ void CPDF_Document::SetPageObjNum(int iPage, uint32_t objNum) {
   page_list_[iPage] = objNum;
 }
 
+std::unique_ptr<CPDF_ParseCache> CPDF_Document::CreateParseCache() {
+  if (!parser_) {
+    return nullptr;
+  }
+
+  // Fill in `page_list_` for pages that were not looked up yet.
+  for (int i = 0; i < GetPageCount(); ++i) {
+    GetPageDictionary(i);
+  }
+  return parser_->CreateParseCache(page_list_);
+}
+
 JBig2_DocumentContext* CPDF_Document::GetOrCreateCodecContext() {
   if (!codec_context_) {
     codec_context_ = std::make_unique<JBig2_DocumentContext>();
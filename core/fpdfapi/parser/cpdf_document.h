@@ -24,6 +24,7 @@ class CPDF_ReadValidator;
 class CPDF_StreamAcc;
 class IFX_SeekableReadStream;
 class JBig2_DocumentContext;
+struct CPDF_ParseCache;
 
 class CPDF_Document : public Observable,
                       public CPDF_Parser::ParsedObjectsHolder {
@@ -149,8 +150,19 @@ class CPDF_Document : public Observable,
 
   CPDF_Parser::Error LoadDoc(RetainPtr<IFX_SeekableReadStream> pFileAccess,
                              const ByteString& password);
+  // Like LoadDoc(), but lets the parser and LoadPages() take the document
+  // structure from `parse_cache` if it matches the file.
+  CPDF_Parser::Error LoadDocWithParseCache(
+      RetainPtr<IFX_SeekableReadStream> pFileAccess,
+      const ByteString& password,
+      std::unique_ptr<CPDF_ParseCache> parse_cache);
   CPDF_Parser::Error LoadLinearizedDoc(RetainPtr<CPDF_ReadValidator> validator,
                                        const ByteString& password);
+
+  // Returns the structure of the document for a later LoadDocWithParseCache(),
+  // or nullptr if it cannot be cached. Looks up all pages first. The page list
+  // reflects page insertions and deletions, so call this before editing pages.
+  std::unique_ptr<CPDF_ParseCache> CreateParseCache();
   bool has_valid_cross_reference_table() const {
     return has_valid_cross_reference_table_;
   }
@@ -6,10 +6,12 @@
 
 #include "core/fpdfapi/parser/cpdf_flateencoder.h"
 
+#include <utility>
 #include <variant>
 
 #include "constants/stream_dict_common.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_encryptor.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
@@ -17,8 +19,19 @@
 #include "core/fpdfapi/parser/fpdf_parser_decode.h"
 #include "core/fxcodec/flate/flatemodule.h"
 #include "core/fxcrt/check.h"
+#include "core/fxcrt/fx_stream.h"
 #include "core/fxcrt/numerics/safe_conversions.h"
 
+// static
+DataVector<uint8_t> CPDF_FlateEncoder::EncodeData(
+    pdfium::span<const uint8_t> raw_data,
+    bool has_filter) {
+  if (has_filter) {
+    return DataVector<uint8_t>(raw_data.begin(), raw_data.end());
+  }
+  return FlateModule::Encode(raw_data);
+}
+
 CPDF_FlateEncoder::CPDF_FlateEncoder(RetainPtr<const CPDF_Stream> pStream,
                                      bool bFlateEncode)
     : acc_(pdfium::MakeRetain<CPDF_StreamAcc>(pStream)) {
@@ -44,7 +57,26 @@ CPDF_FlateEncoder::CPDF_FlateEncoder(RetainPtr<const CPDF_Stream> pStream,
 
   data_ = FlateModule::Encode(acc_->GetSpan());
   CHECK(!GetSpan().empty());
-  cloned_dict_ = ToDictionary(pStream->GetDict()->Clone());
+  InitFlateEncodedDict(pStream.Get());
+}
+
+CPDF_FlateEncoder::CPDF_FlateEncoder(RetainPtr<const CPDF_Stream> pStream,
+                                     DataVector<uint8_t> data,
+                                     bool data_encrypted)
+    : data_(std::move(data)), data_encrypted_(data_encrypted) {
+  if (pStream->HasFilter()) {
+    dict_ = pStream->GetDict();
+    return;
+  }
+
+  CHECK(!GetSpan().empty());
+  InitFlateEncodedDict(pStream.Get());
+}
+
+CPDF_FlateEncoder::~CPDF_FlateEncoder() = default;
+
+void CPDF_FlateEncoder::InitFlateEncodedDict(const CPDF_Stream* stream) {
+  cloned_dict_ = ToDictionary(stream->GetDict()->Clone());
   cloned_dict_->SetNewFor<CPDF_Number>(
       "Length", pdfium::checked_cast<int>(GetSpan().size()));
   cloned_dict_->SetNewFor<CPDF_Name>("Filter", "FlateDecode");
@@ -52,8 +84,6 @@ CPDF_FlateEncoder::CPDF_FlateEncoder(RetainPtr<const CPDF_Stream> pStream,
   DCHECK(!dict_);
 }
 
-CPDF_FlateEncoder::~CPDF_FlateEncoder() = default;
-
 void CPDF_FlateEncoder::UpdateLength(size_t size) {
   if (static_cast<size_t>(GetDict()->GetIntegerFor("Length")) == size) {
     return;
@@ -73,6 +103,32 @@ bool CPDF_FlateEncoder::WriteDictTo(IFX_ArchiveStream* archive,
   return GetDict()->WriteTo(archive, encryptor);
 }
 
+bool CPDF_FlateEncoder::WriteStreamTo(IFX_ArchiveStream* archive,
+                                      const CPDF_Encryptor* encryptor,
+                                      bool encrypt_data) {
+  DataVector<uint8_t> encrypted_data;
+  pdfium::span<const uint8_t> data = GetSpan();
+  if (encryptor && encrypt_data && !data_encrypted_) {
+    encrypted_data = encryptor->Encrypt(data);
+    data = encrypted_data;
+  }
+
+  UpdateLength(data.size());
+  if (!WriteDictTo(archive, encryptor)) {
+    return false;
+  }
+
+  if (!archive->WriteString("stream\r\n")) {
+    return false;
+  }
+
+  if (!archive->WriteBlock(data)) {
+    return false;
+  }
+
+  return archive->WriteString("\r\nendstream");
+}
+
 const CPDF_Dictionary* CPDF_FlateEncoder::GetDict() const {
   if (cloned_dict_) {
     DCHECK(!dict_);
@@ -23,13 +23,31 @@ class IFX_ArchiveStream;
 
 class CPDF_FlateEncoder {
  public:
+  // Returns the data the constructor below writes for a stream with the raw
+  // data `raw_data`, when `bFlateEncode` is set. Only touches `raw_data`, so
+  // it may be called on any thread.
+  static DataVector<uint8_t> EncodeData(pdfium::span<const uint8_t> raw_data,
+                                        bool has_filter);
+
   CPDF_FlateEncoder(RetainPtr<const CPDF_Stream> pStream, bool bFlateEncode);
+  // Same as above with `bFlateEncode` set, but with `data` computed ahead of
+  // time by EncodeData(), and then encrypted if `data_encrypted` is set.
+  CPDF_FlateEncoder(RetainPtr<const CPDF_Stream> pStream,
+                    DataVector<uint8_t> data,
+                    bool data_encrypted);
   ~CPDF_FlateEncoder();
 
   void UpdateLength(size_t size);
   bool WriteDictTo(IFX_ArchiveStream* archive,
                    const CPDF_Encryptor* encryptor) const;
 
+  // Writes the dictionary and the data as the body of a stream object. The
+  // data is encrypted with `encryptor` if `encrypt_data` is set, unless it was
+  // encrypted ahead of time.
+  bool WriteStreamTo(IFX_ArchiveStream* archive,
+                     const CPDF_Encryptor* encryptor,
+                     bool encrypt_data);
+
   pdfium::span<const uint8_t> GetSpan() const;
 
  private:
@@ -37,6 +55,8 @@ class CPDF_FlateEncoder {
     return std::holds_alternative<DataVector<uint8_t>>(data_);
   }
 
+  void InitFlateEncodedDict(const CPDF_Stream* stream);
+
   // Returns |cloned_dict_| if it is valid. Otherwise returns |dict_|.
   const CPDF_Dictionary* GetDict() const;
 
@@ -44,6 +64,7 @@ class CPDF_FlateEncoder {
   RetainPtr<CPDF_StreamAcc> const acc_;
 
   std::variant<pdfium::raw_span<const uint8_t>, DataVector<uint8_t>> data_;
+  const bool data_encrypted_ = false;
 
   // Only one of these two pointers is valid at any time.
   RetainPtr<const CPDF_Dictionary> dict_;
@@ -10,6 +10,7 @@
 #include <memory>
 #include <utility>
 
+#include "core/fpdfapi/parser/cpdf_change_tracker.h"
 #include "core/fpdfapi/parser/cpdf_object.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
 #include "core/fxcrt/check.h"
@@ -23,10 +24,12 @@ const CPDF_Object* FilterInvalidObjNum(const CPDF_Object* obj) {
 }  // namespace
 
 CPDF_IndirectObjectHolder::CPDF_IndirectObjectHolder()
-    : byte_string_pool_(std::make_unique<ByteStringPool>()) {}
+    : byte_string_pool_(std::make_unique<ByteStringPool>()),
+      change_tracker_(std::make_unique<CPDF_ChangeTracker>()) {}
 
 CPDF_IndirectObjectHolder::~CPDF_IndirectObjectHolder() {
   byte_string_pool_.DeleteObject();  // Make weak.
+  change_tracker_.DeleteObject();    // Objects may outlive this holder.
 }
 
 RetainPtr<const CPDF_Object> CPDF_IndirectObjectHolder::GetIndirectObject(
@@ -42,12 +45,12 @@ RetainPtr<CPDF_Object> CPDF_IndirectObjectHolder::GetMutableIndirectObject(
 
 const CPDF_Object* CPDF_IndirectObjectHolder::GetIndirectObjectInternal(
     uint32_t objnum) const {
-  auto it = indirect_objs_.find(objnum);
-  if (it == indirect_objs_.end()) {
+  const RetainPtr<CPDF_Object>* obj = indirect_objs_.find(objnum);
+  if (!obj) {
     return nullptr;
   }
 
-  return FilterInvalidObjNum(it->second.Get());
+  return FilterInvalidObjNum(obj->Get());
 }
 
 RetainPtr<CPDF_Object> CPDF_IndirectObjectHolder::GetOrParseIndirectObject(
@@ -61,23 +64,26 @@ CPDF_Object* CPDF_IndirectObjectHolder::GetOrParseIndirectObjectInternal(
     return nullptr;
   }
 
-  // Add item anyway to prevent recursively parsing of same object.
-  auto insert_result = indirect_objs_.insert(std::make_pair(objnum, nullptr));
-  if (!insert_result.second) {
-    return const_cast<CPDF_Object*>(
-        FilterInvalidObjNum(insert_result.first->second.Get()));
+  const RetainPtr<CPDF_Object>* existing = indirect_objs_.find(objnum);
+  if (existing) {
+    return const_cast<CPDF_Object*>(FilterInvalidObjNum(existing->Get()));
   }
+
+  // Add item anyway to prevent recursively parsing of same object.
+  indirect_objs_[objnum] = nullptr;
   RetainPtr<CPDF_Object> pNewObj = ParseIndirectObject(objnum);
+  // Parsing may add other objects, so the placeholder must be looked up again.
   if (!pNewObj) {
-    indirect_objs_.erase(insert_result.first);
+    indirect_objs_.erase(objnum);
     return nullptr;
   }
 
   pNewObj->SetObjNum(objnum);
   last_obj_num_ = std::max(last_obj_num_, objnum);
 
+  pNewObj->SetChangeTracker(change_tracker_, objnum);
   CPDF_Object* result = pNewObj.Get();
-  insert_result.first->second = std::move(pNewObj);
+  indirect_objs_[objnum] = std::move(pNewObj);
   return result;
 }
 
@@ -90,6 +96,8 @@ uint32_t CPDF_IndirectObjectHolder::AddIndirectObject(
     RetainPtr<CPDF_Object> pObj) {
   CHECK(!pObj->GetObjNum());
   pObj->SetObjNum(++last_obj_num_);
+  pObj->SetChangeTracker(change_tracker_, last_obj_num_);
+  change_tracker_->MarkChanged(last_obj_num_);
   indirect_objs_[last_obj_num_] = std::move(pObj);
   return last_obj_num_;
 }
@@ -109,16 +117,22 @@ bool CPDF_IndirectObjectHolder::ReplaceIndirectObjectIfHigherGeneration(
   }
 
   pObj->SetObjNum(objnum);
+  pObj->SetChangeTracker(change_tracker_, objnum);
   obj_holder = std::move(pObj);
   last_obj_num_ = std::max(last_obj_num_, objnum);
   return true;
 }
 
 void CPDF_IndirectObjectHolder::DeleteIndirectObject(uint32_t objnum) {
-  auto it = indirect_objs_.find(objnum);
-  if (it == indirect_objs_.end() || !FilterInvalidObjNum(it->second.Get())) {
+  const RetainPtr<CPDF_Object>* obj = indirect_objs_.find(objnum);
+  if (!obj || !FilterInvalidObjNum(obj->Get())) {
     return;
   }
 
-  indirect_objs_.erase(it);
+  indirect_objs_.erase(objnum);
+  change_tracker_->MarkChanged(objnum);
+}
+
+const std::set<uint32_t>& CPDF_IndirectObjectHolder::GetChangedObjNums() const {
+  return change_tracker_->changed_obj_nums();
 }
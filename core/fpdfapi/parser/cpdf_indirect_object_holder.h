@@ -9,19 +9,22 @@
 
 #include <stdint.h>
 
-#include <map>
+#include <set>
 #include <type_traits>
 #include <utility>
 
 #include "core/fpdfapi/parser/cpdf_object.h"
+#include "core/fpdfapi/parser/object_number_map.h"
 #include "core/fxcrt/bytestring_pool.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/weak_ptr.h"
 
+class CPDF_ChangeTracker;
+
 class CPDF_IndirectObjectHolder {
  public:
   using const_iterator =
-      std::map<uint32_t, RetainPtr<CPDF_Object>>::const_iterator;
+      ObjectNumberMap<RetainPtr<CPDF_Object>>::const_iterator;
 
   CPDF_IndirectObjectHolder();
   virtual ~CPDF_IndirectObjectHolder();
@@ -31,6 +34,11 @@ class CPDF_IndirectObjectHolder {
   RetainPtr<CPDF_Object> GetMutableIndirectObject(uint32_t objnum);
   void DeleteIndirectObject(uint32_t objnum);
 
+  // Returns the object numbers of the indirect objects that were added,
+  // changed or deleted since they were loaded, in ascending order. Parsed
+  // objects only count as changed once they are modified.
+  const std::set<uint32_t>& GetChangedObjNums() const;
+
   // Creates and adds a new object retained by the indirect object holder,
   // and returns a retained pointer to it.
   template <typename T, typename... Args>
@@ -58,7 +66,8 @@ class CPDF_IndirectObjectHolder {
   // Always Retains |pObj|, returns its new object number.
   uint32_t AddIndirectObject(RetainPtr<CPDF_Object> pObj);
 
-  // If higher generation number, retains |pObj| and returns true.
+  // If higher generation number, retains |pObj| and returns true. Meant for
+  // loading objects, so |pObj| does not count as changed.
   bool ReplaceIndirectObjectIfHigherGeneration(uint32_t objnum,
                                                RetainPtr<CPDF_Object> pObj);
 
@@ -82,8 +91,9 @@ class CPDF_IndirectObjectHolder {
   CPDF_Object* GetOrParseIndirectObjectInternal(uint32_t objnum);
 
   uint32_t last_obj_num_ = 0;
-  std::map<uint32_t, RetainPtr<CPDF_Object>> indirect_objs_;
+  ObjectNumberMap<RetainPtr<CPDF_Object>> indirect_objs_;
   WeakPtr<ByteStringPool> byte_string_pool_;
+  WeakPtr<CPDF_ChangeTracker> change_tracker_;
 };
 
 #endif  // CORE_FPDFAPI_PARSER_CPDF_INDIRECT_OBJECT_HOLDER_H_
@@ -4,9 +4,15 @@
 
 #include "core/fpdfapi/parser/cpdf_indirect_object_holder.h"
 
+#include <stdint.h>
+
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_null.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/check.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -90,3 +96,67 @@ TEST(IndirectObjectHolderTest, TemplateNewMethods) {
   EXPECT_TRUE(dict->IsDictionary());
   EXPECT_TRUE(pArray->IsArray());
 }
+
+TEST(IndirectObjectHolderTest, ChangedObjNums) {
+  using ::testing::ElementsAre;
+  using ::testing::IsEmpty;
+
+  static constexpr uint32_t kDictObjNum = 1000;
+  static constexpr uint32_t kStreamObjNum = 1001;
+  MockIndirectObjectHolder mock_holder;
+  EXPECT_CALL(mock_holder, ParseIndirectObject(::testing::_))
+      .WillRepeatedly(
+          ::testing::WithArg<0>([](uint32_t objnum) -> RetainPtr<CPDF_Object> {
+            if (objnum == kStreamObjNum) {
+              return pdfium::MakeRetain<CPDF_Stream>(
+                  pdfium::MakeRetain<CPDF_Dictionary>());
+            }
+            auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+            dict->SetNewFor<CPDF_Array>("Kids")->AppendNew<CPDF_Number>(1);
+            return dict;
+          }));
+
+  // Loading objects does not change them.
+  RetainPtr<CPDF_Dictionary> dict =
+      ToDictionary(mock_holder.GetOrParseIndirectObject(kDictObjNum));
+  RetainPtr<CPDF_Stream> stream =
+      ToStream(mock_holder.GetOrParseIndirectObject(kStreamObjNum));
+  ASSERT_TRUE(dict);
+  ASSERT_TRUE(stream);
+  EXPECT_THAT(mock_holder.GetChangedObjNums(), IsEmpty());
+
+  // Changing a direct object within an indirect object changes the latter.
+  dict->GetMutableArrayFor("Kids")->AppendNew<CPDF_Number>(2);
+  EXPECT_THAT(mock_holder.GetChangedObjNums(), ElementsAre(kDictObjNum));
+
+  // So does changing stream data.
+  stream->SetData(pdfium::as_byte_span("data"));
+  EXPECT_THAT(mock_holder.GetChangedObjNums(),
+              ElementsAre(kDictObjNum, kStreamObjNum));
+
+  // New objects count as changed, as do deleted ones.
+  mock_holder.DeleteIndirectObject(kDictObjNum);
+  const uint32_t new_obj_num =
+      mock_holder.NewIndirect<CPDF_Name>("Name")->GetObjNum();
+  EXPECT_THAT(mock_holder.GetChangedObjNums(),
+              ElementsAre(kDictObjNum, kStreamObjNum, new_obj_num));
+}
+
+TEST(IndirectObjectHolderTest, ChangedObjNumsAfterInitStreamFromFile) {
+  static constexpr uint32_t kStreamObjNum = 1000;
+  MockIndirectObjectHolder mock_holder;
+  EXPECT_CALL(mock_holder, ParseIndirectObject(::testing::_))
+      .WillOnce(::testing::WithArg<0>([](uint32_t) -> RetainPtr<CPDF_Object> {
+        return pdfium::MakeRetain<CPDF_Stream>(
+            pdfium::MakeRetain<CPDF_Dictionary>());
+      }));
+  RetainPtr<CPDF_Stream> stream =
+      ToStream(mock_holder.GetOrParseIndirectObject(kStreamObjNum));
+  ASSERT_TRUE(stream);
+
+  // Replacing both the data and the dictionary changes the stream.
+  stream->InitStreamFromFile(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+      pdfium::as_byte_span("data")));
+  EXPECT_THAT(mock_holder.GetChangedObjNums(),
+              ::testing::ElementsAre(kStreamObjNum));
+}
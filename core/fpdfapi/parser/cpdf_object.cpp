@@ -170,3 +170,6 @@ RetainPtr<CPDF_Reference> CPDF_Object::MakeReference(
   CHECK(!IsInline());
   return pdfium::MakeRetain<CPDF_Reference>(holder, GetObjNum());
 }
+
+void CPDF_Object::SetChangeTracker(const WeakPtr<CPDF_ChangeTracker>& tracker,
+                                   uint32_t objnum) {}
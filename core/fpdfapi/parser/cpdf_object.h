@@ -14,9 +14,11 @@
 
 #include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/weak_ptr.h"
 
 class CPDF_Array;
 class CPDF_Boolean;
+class CPDF_ChangeTracker;
 class CPDF_Dictionary;
 class CPDF_Encryptor;
 class CPDF_IndirectObjectHolder;
@@ -115,6 +117,14 @@ class CPDF_Object : public Retainable {
   virtual RetainPtr<CPDF_Reference> MakeReference(
       CPDF_IndirectObjectHolder* holder) const;
 
+  // Makes changes to this object, and to the direct objects within it, get
+  // recorded in `tracker` as changes to the indirect object `objnum`. Only
+  // arrays, dictionaries and streams record changes. Other objects have to be
+  // replaced in their container, rather than changed in place, for the change
+  // to be recorded.
+  virtual void SetChangeTracker(const WeakPtr<CPDF_ChangeTracker>& tracker,
+                                uint32_t objnum);
+
   RetainPtr<const CPDF_Object> GetDirect() const;    // Wraps virtual method.
   RetainPtr<CPDF_Object> GetMutableDirect();         // Wraps virtual method.
   RetainPtr<const CPDF_Dictionary> GetDict() const;  // Wraps virtual method.
@@ -61,14 +61,30 @@ std::unique_ptr<CPDF_ObjectStream> CPDF_ObjectStream::Create(
   }
 
   // Protected constructor.
-  return pdfium::WrapUnique(new CPDF_ObjectStream(std::move(stream)));
+  return pdfium::WrapUnique(
+      new CPDF_ObjectStream(std::move(stream), std::nullopt));
 }
 
-CPDF_ObjectStream::CPDF_ObjectStream(RetainPtr<const CPDF_Stream> obj_stream)
+//  static
+std::unique_ptr<CPDF_ObjectStream> CPDF_ObjectStream::CreateWithObjectInfo(
+    RetainPtr<const CPDF_Stream> stream,
+    std::vector<ObjectInfo> object_info) {
+  if (!IsObjectStream(stream.Get())) {
+    return nullptr;
+  }
+
+  // Protected constructor.
+  return pdfium::WrapUnique(
+      new CPDF_ObjectStream(std::move(stream), std::move(object_info)));
+}
+
+CPDF_ObjectStream::CPDF_ObjectStream(
+    RetainPtr<const CPDF_Stream> obj_stream,
+    std::optional<std::vector<ObjectInfo>> object_info)
     : stream_acc_(pdfium::MakeRetain<CPDF_StreamAcc>(obj_stream)),
       first_object_offset_(obj_stream->GetDict()->GetIntegerFor("First")) {
   DCHECK(IsObjectStream(obj_stream.Get()));
-  Init(obj_stream.Get());
+  Init(obj_stream.Get(), std::move(object_info));
 }
 
 CPDF_ObjectStream::~CPDF_ObjectStream() = default;
@@ -94,10 +110,16 @@ RetainPtr<CPDF_Object> CPDF_ObjectStream::ParseObject(
   return result;
 }
 
-void CPDF_ObjectStream::Init(const CPDF_Stream* stream) {
+void CPDF_ObjectStream::Init(
+    const CPDF_Stream* stream,
+    std::optional<std::vector<ObjectInfo>> object_info) {
   stream_acc_->LoadAllDataFiltered();
   data_stream_ =
       pdfium::MakeRetain<CFX_ReadOnlySpanStream>(stream_acc_->GetSpan());
+  if (object_info.has_value()) {
+    object_info_ = std::move(object_info.value());
+    return;
+  }
 
   CPDF_SyntaxParser syntax(data_stream_);
   const int object_count = stream->GetDict()->GetIntegerFor("N");
@@ -6,6 +6,7 @@
 #define CORE_FPDFAPI_PARSER_CPDF_OBJECT_STREAM_H_
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "core/fpdfapi/parser/cpdf_object.h"
@@ -34,6 +35,12 @@ class CPDF_ObjectStream {
   static std::unique_ptr<CPDF_ObjectStream> Create(
       RetainPtr<const CPDF_Stream> stream);
 
+  // Like Create(), but takes the objects in `stream` from `object_info`, as
+  // returned by object_info() earlier, instead of parsing them.
+  static std::unique_ptr<CPDF_ObjectStream> CreateWithObjectInfo(
+      RetainPtr<const CPDF_Stream> stream,
+      std::vector<ObjectInfo> object_info);
+
   ~CPDF_ObjectStream();
 
   RetainPtr<CPDF_Object> ParseObject(CPDF_IndirectObjectHolder* pObjList,
@@ -42,9 +49,11 @@ class CPDF_ObjectStream {
   const std::vector<ObjectInfo>& object_info() const { return object_info_; }
 
  private:
-  explicit CPDF_ObjectStream(RetainPtr<const CPDF_Stream> stream);
+  CPDF_ObjectStream(RetainPtr<const CPDF_Stream> stream,
+                    std::optional<std::vector<ObjectInfo>> object_info);
 
-  void Init(const CPDF_Stream* stream);
+  void Init(const CPDF_Stream* stream,
+            std::optional<std::vector<ObjectInfo>> object_info);
   RetainPtr<CPDF_Object> ParseObjectAtOffset(
       CPDF_IndirectObjectHolder* pObjList,
       uint32_t object_offset) const;
@@ -0,0 +1,303 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_parse_cache.h"
+
+#include <limits>
+#include <optional>
+#include <utility>
+
+#include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fxcrt/binary_buffer.h"
+#include "core/fxcrt/byteorder.h"
+
+namespace {
+
+using ObjectInfo = CPDF_CrossRefTable::ObjectInfo;
+using ObjectType = CPDF_CrossRefTable::ObjectType;
+
+// Identifies the format. Bump `kVersion` whenever it changes.
+constexpr char kMagic[] = "PDFiumPC";
+constexpr uint32_t kVersion = 1;
+
+// All integers are stored little-endian.
+class Writer {
+ public:
+  void WriteUint8(uint8_t value) { buffer_.AppendUint8(value); }
+
+  void WriteUint32(uint32_t value) {
+    uint8_t bytes[4];
+    fxcrt::PutUInt32LSBFirst(value, bytes);
+    buffer_.AppendSpan(bytes);
+  }
+
+  void WriteUint64(uint64_t value) {
+    WriteUint32(static_cast<uint32_t>(value));
+    WriteUint32(static_cast<uint32_t>(value >> 32));
+  }
+
+  void WriteString(const ByteString& str) {
+    WriteUint32(static_cast<uint32_t>(str.GetLength()));
+    buffer_.AppendString(str);
+  }
+
+  void WriteSpan(pdfium::span<const uint8_t> span) { buffer_.AppendSpan(span); }
+
+  pdfium::span<const uint8_t> GetSpan() const { return buffer_.GetSpan(); }
+  DataVector<uint8_t> DetachBuffer() { return buffer_.DetachBuffer(); }
+
+ private:
+  BinaryBuffer buffer_;
+};
+
+class Reader {
+ public:
+  explicit Reader(pdfium::span<const uint8_t> data) : data_(data) {}
+
+  size_t remaining() const { return data_.size(); }
+
+  std::optional<pdfium::span<const uint8_t>> ReadSpan(size_t size) {
+    if (size > data_.size()) {
+      return std::nullopt;
+    }
+    pdfium::span<const uint8_t> result = data_.first(size);
+    data_ = data_.subspan(size);
+    return result;
+  }
+
+  std::optional<uint8_t> ReadUint8() {
+    std::optional<pdfium::span<const uint8_t>> bytes = ReadSpan(1);
+    if (!bytes.has_value()) {
+      return std::nullopt;
+    }
+    return bytes.value()[0];
+  }
+
+  std::optional<uint32_t> ReadUint32() {
+    std::optional<pdfium::span<const uint8_t>> bytes = ReadSpan(4);
+    if (!bytes.has_value()) {
+      return std::nullopt;
+    }
+    return fxcrt::GetUInt32LSBFirst(bytes.value().first<4u>());
+  }
+
+  std::optional<uint64_t> ReadUint64() {
+    std::optional<uint32_t> low = ReadUint32();
+    std::optional<uint32_t> high = ReadUint32();
+    if (!low.has_value() || !high.has_value()) {
+      return std::nullopt;
+    }
+    return static_cast<uint64_t>(high.value()) << 32 | low.value();
+  }
+
+  std::optional<ByteString> ReadString() {
+    std::optional<uint32_t> length = ReadUint32();
+    if (!length.has_value()) {
+      return std::nullopt;
+    }
+    std::optional<pdfium::span<const uint8_t>> bytes = ReadSpan(length.value());
+    if (!bytes.has_value()) {
+      return std::nullopt;
+    }
+    return ByteString(ByteStringView(bytes.value()));
+  }
+
+  // Reads an element count, and checks that the remaining data can hold that
+  // many elements of at least `min_element_size` bytes each.
+  std::optional<uint32_t> ReadCount(size_t min_element_size) {
+    std::optional<uint32_t> count = ReadUint32();
+    if (!count.has_value() ||
+        count.value() > remaining() / min_element_size) {
+      return std::nullopt;
+    }
+    return count;
+  }
+
+ private:
+  pdfium::span<const uint8_t> data_;
+};
+
+uint32_t Checksum(pdfium::span<const uint8_t> data) {
+  return FX_HashCode_GetA(ByteStringView(data));
+}
+
+bool IsValidFileOffset(uint64_t value) {
+  return value <=
+         static_cast<uint64_t>(std::numeric_limits<FX_FILESIZE>::max());
+}
+
+bool ReadObjectsInfo(Reader& reader,
+                     ObjectNumberMap<ObjectInfo>& objects_info) {
+  // Object number, type, flag, generation number and position.
+  constexpr size_t kObjectInfoSize = 4 + 1 + 1 + 4 + 8;
+  std::optional<uint32_t> count = reader.ReadCount(kObjectInfoSize);
+  if (!count.has_value()) {
+    return false;
+  }
+  std::optional<uint32_t> last_obj_num;
+  for (uint32_t i = 0; i < count.value(); ++i) {
+    std::optional<uint32_t> obj_num = reader.ReadUint32();
+    std::optional<uint8_t> type = reader.ReadUint8();
+    std::optional<uint8_t> is_object_stream = reader.ReadUint8();
+    std::optional<uint32_t> gennum = reader.ReadUint32();
+    std::optional<uint64_t> payload = reader.ReadUint64();
+    // ReadCount() checked that there is enough data for all of these.
+    if (!payload.has_value() ||
+        obj_num.value() > CPDF_Parser::kMaxObjectNumber ||
+        (last_obj_num.has_value() && obj_num.value() <= last_obj_num.value()) ||
+        type.value() > static_cast<uint8_t>(ObjectType::kCompressed) ||
+        is_object_stream.value() > 1 || gennum.value() > 0xFFFF) {
+      return false;
+    }
+    last_obj_num = obj_num;
+
+    ObjectInfo& info = objects_info[obj_num.value()];
+    info.type = static_cast<ObjectType>(type.value());
+    info.is_object_stream_flag = !!is_object_stream.value();
+    info.gennum = static_cast<uint16_t>(gennum.value());
+    if (info.type == ObjectType::kCompressed) {
+      info.archive.obj_num = static_cast<uint32_t>(payload.value());
+      info.archive.obj_index = static_cast<uint32_t>(payload.value() >> 32);
+    } else {
+      if (!IsValidFileOffset(payload.value())) {
+        return false;
+      }
+      info.pos = static_cast<FX_FILESIZE>(payload.value());
+    }
+  }
+  return true;
+}
+
+bool ReadObjectStreams(Reader& reader,
+                       CPDF_ParseCache::ObjectStreamMap& object_streams) {
+  // Object number and object count.
+  std::optional<uint32_t> count = reader.ReadCount(8);
+  if (!count.has_value()) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count.value(); ++i) {
+    std::optional<uint32_t> obj_num = reader.ReadUint32();
+    // Object number and offset.
+    std::optional<uint32_t> object_count = reader.ReadCount(8);
+    if (!object_count.has_value()) {
+      return false;
+    }
+    std::vector<CPDF_ObjectStream::ObjectInfo>& infos =
+        object_streams[obj_num.value()];
+    infos.reserve(object_count.value());
+    for (uint32_t j = 0; j < object_count.value(); ++j) {
+      std::optional<uint32_t> stream_obj_num = reader.ReadUint32();
+      std::optional<uint32_t> offset = reader.ReadUint32();
+      infos.emplace_back(stream_obj_num.value(), offset.value());
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<CPDF_ParseCache> CPDF_ParseCache::Deserialize(
+    pdfium::span<const uint8_t> data) {
+  constexpr size_t kMagicSize = sizeof(kMagic) - 1;
+  if (data.size() < kMagicSize + 8) {
+    return nullptr;
+  }
+  pdfium::span<const uint8_t> payload = data.first(data.size() - 4);
+  if (fxcrt::GetUInt32LSBFirst(data.last<4u>()) != Checksum(payload)) {
+    return nullptr;
+  }
+
+  Reader reader(payload);
+  std::optional<pdfium::span<const uint8_t>> magic =
+      reader.ReadSpan(kMagicSize);
+  std::optional<uint32_t> version = reader.ReadUint32();
+  if (ByteStringView(magic.value()) != ByteStringView(kMagic) ||
+      version.value() != kVersion) {
+    return nullptr;
+  }
+
+  auto cache = std::make_unique<CPDF_ParseCache>();
+  std::optional<uint64_t> file_size = reader.ReadUint64();
+  std::optional<uint64_t> last_xref_offset = reader.ReadUint64();
+  std::optional<ByteString> id = reader.ReadString();
+  if (!file_size.has_value() || !last_xref_offset.has_value() ||
+      !id.has_value() || !IsValidFileOffset(file_size.value()) ||
+      !IsValidFileOffset(last_xref_offset.value())) {
+    return nullptr;
+  }
+  std::optional<uint8_t> xref_stream = reader.ReadUint8();
+  if (!xref_stream.has_value()) {
+    return nullptr;
+  }
+  cache->key.file_size = static_cast<FX_FILESIZE>(file_size.value());
+  cache->key.last_xref_offset =
+      static_cast<FX_FILESIZE>(last_xref_offset.value());
+  cache->key.id = std::move(id.value());
+  cache->xref_stream = !!xref_stream.value();
+
+  if (!ReadObjectsInfo(reader, cache->objects_info) ||
+      !ReadObjectStreams(reader, cache->object_streams)) {
+    return nullptr;
+  }
+
+  std::optional<uint32_t> page_count = reader.ReadCount(4);
+  if (!page_count.has_value()) {
+    return nullptr;
+  }
+  cache->page_obj_nums.reserve(page_count.value());
+  for (uint32_t i = 0; i < page_count.value(); ++i) {
+    cache->page_obj_nums.push_back(reader.ReadUint32().value());
+  }
+  if (reader.remaining()) {
+    return nullptr;
+  }
+  return cache;
+}
+
+CPDF_ParseCache::CPDF_ParseCache() = default;
+
+CPDF_ParseCache::~CPDF_ParseCache() = default;
+
+DataVector<uint8_t> CPDF_ParseCache::Serialize() const {
+  Writer writer;
+  writer.WriteSpan(ByteStringView(kMagic).unsigned_span());
+  writer.WriteUint32(kVersion);
+  writer.WriteUint64(static_cast<uint64_t>(key.file_size));
+  writer.WriteUint64(static_cast<uint64_t>(key.last_xref_offset));
+  writer.WriteString(key.id);
+  writer.WriteUint8(xref_stream);
+
+  writer.WriteUint32(static_cast<uint32_t>(objects_info.size()));
+  for (const auto& [obj_num, info] : objects_info) {
+    writer.WriteUint32(obj_num);
+    writer.WriteUint8(static_cast<uint8_t>(info.type));
+    writer.WriteUint8(info.is_object_stream_flag);
+    writer.WriteUint32(info.gennum);
+    if (info.type == ObjectType::kCompressed) {
+      writer.WriteUint64(static_cast<uint64_t>(info.archive.obj_index) << 32 |
+                         info.archive.obj_num);
+    } else {
+      writer.WriteUint64(static_cast<uint64_t>(info.pos));
+    }
+  }
+
+  writer.WriteUint32(static_cast<uint32_t>(object_streams.size()));
+  for (const auto& [obj_num, infos] : object_streams) {
+    writer.WriteUint32(obj_num);
+    writer.WriteUint32(static_cast<uint32_t>(infos.size()));
+    for (const CPDF_ObjectStream::ObjectInfo& info : infos) {
+      writer.WriteUint32(info.obj_num);
+      writer.WriteUint32(info.obj_offset);
+    }
+  }
+
+  writer.WriteUint32(static_cast<uint32_t>(page_obj_nums.size()));
+  for (uint32_t obj_num : page_obj_nums) {
+    writer.WriteUint32(obj_num);
+  }
+
+  writer.WriteUint32(Checksum(writer.GetSpan()));
+  return writer.DetachBuffer();
+}
@@ -0,0 +1,64 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_CPDF_PARSE_CACHE_H_
+#define CORE_FPDFAPI_PARSER_CPDF_PARSE_CACHE_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "core/fpdfapi/parser/cpdf_cross_ref_table.h"
+#include "core/fpdfapi/parser/cpdf_object_stream.h"
+#include "core/fpdfapi/parser/object_number_map.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/fx_types.h"
+#include "core/fxcrt/span.h"
+
+// The structure of a parsed document, which an embedder can store next to the
+// file. When the same file is opened again, CPDF_Parser takes the merged cross
+// reference table from here instead of reading every cross reference section,
+// and CPDF_Document takes the page list instead of walking the page tree.
+//
+// The cache is only used if `key` still matches the file. The trailer itself
+// is not stored. It is always read from the file, and its /ID has to match.
+struct CPDF_ParseCache {
+  struct Key {
+    bool operator==(const Key&) const = default;
+
+    FX_FILESIZE file_size = 0;
+    // The offset given by the file's startxref.
+    FX_FILESIZE last_xref_offset = 0;
+    // The first string of the trailer's /ID array, if any.
+    ByteString id;
+  };
+
+  // Object stream numbers to the offsets of the objects inside them.
+  using ObjectStreamMap =
+      std::map<uint32_t, std::vector<CPDF_ObjectStream::ObjectInfo>>;
+
+  // Returns nullptr if `data` is not a valid serialized cache, e.g. because it
+  // is truncated or was written by an incompatible version.
+  static std::unique_ptr<CPDF_ParseCache> Deserialize(
+      pdfium::span<const uint8_t> data);
+
+  CPDF_ParseCache();
+  CPDF_ParseCache(const CPDF_ParseCache&) = delete;
+  CPDF_ParseCache& operator=(const CPDF_ParseCache&) = delete;
+  ~CPDF_ParseCache();
+
+  DataVector<uint8_t> Serialize() const;
+
+  Key key;
+  bool xref_stream = false;
+  ObjectNumberMap<CPDF_CrossRefTable::ObjectInfo> objects_info;
+  ObjectStreamMap object_streams;
+  // Page index to page object number, or 0 where unknown.
+  std::vector<uint32_t> page_obj_nums;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_CPDF_PARSE_CACHE_H_
@@ -0,0 +1,128 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_parse_cache.h"
+
+#include <memory>
+
+#include "core/fxcrt/data_vector.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using testing::ElementsAre;
+
+namespace {
+
+std::unique_ptr<CPDF_ParseCache> CreateTestCache() {
+  auto cache = std::make_unique<CPDF_ParseCache>();
+  cache->key.file_size = 12345;
+  cache->key.last_xref_offset = 12000;
+  cache->key.id = "0123456789abcdef";
+  cache->xref_stream = true;
+
+  CPDF_CrossRefTable::ObjectInfo& free_info = cache->objects_info[0];
+  free_info.type = CPDF_CrossRefTable::ObjectType::kFree;
+  free_info.gennum = 0xFFFF;
+
+  CPDF_CrossRefTable::ObjectInfo& normal_info = cache->objects_info[1];
+  normal_info.type = CPDF_CrossRefTable::ObjectType::kNormal;
+  normal_info.gennum = 2;
+  normal_info.pos = 15;
+
+  CPDF_CrossRefTable::ObjectInfo& stream_info = cache->objects_info[3];
+  stream_info.type = CPDF_CrossRefTable::ObjectType::kNormal;
+  stream_info.is_object_stream_flag = true;
+  stream_info.pos = 200;
+
+  CPDF_CrossRefTable::ObjectInfo& compressed_info = cache->objects_info[4];
+  compressed_info.type = CPDF_CrossRefTable::ObjectType::kCompressed;
+  compressed_info.archive.obj_num = 3;
+  compressed_info.archive.obj_index = 1;
+
+  cache->object_streams[3] = {CPDF_ObjectStream::ObjectInfo(5, 0),
+                              CPDF_ObjectStream::ObjectInfo(4, 17)};
+  cache->page_obj_nums = {4, 0, 1};
+  return cache;
+}
+
+}  // namespace
+
+TEST(ParseCacheTest, RoundTrip) {
+  DataVector<uint8_t> data = CreateTestCache()->Serialize();
+  std::unique_ptr<CPDF_ParseCache> cache = CPDF_ParseCache::Deserialize(data);
+  ASSERT_TRUE(cache);
+
+  EXPECT_EQ(12345, cache->key.file_size);
+  EXPECT_EQ(12000, cache->key.last_xref_offset);
+  EXPECT_EQ("0123456789abcdef", cache->key.id);
+  EXPECT_TRUE(cache->xref_stream);
+  EXPECT_EQ(4u, cache->objects_info.size());
+
+  const CPDF_CrossRefTable::ObjectInfo* info = cache->objects_info.find(0);
+  ASSERT_TRUE(info);
+  EXPECT_EQ(CPDF_CrossRefTable::ObjectType::kFree, info->type);
+  EXPECT_EQ(0xFFFF, info->gennum);
+
+  info = cache->objects_info.find(1);
+  ASSERT_TRUE(info);
+  EXPECT_EQ(CPDF_CrossRefTable::ObjectType::kNormal, info->type);
+  EXPECT_FALSE(info->is_object_stream_flag);
+  EXPECT_EQ(2, info->gennum);
+  EXPECT_EQ(15, info->pos);
+
+  EXPECT_FALSE(cache->objects_info.find(2));
+
+  info = cache->objects_info.find(3);
+  ASSERT_TRUE(info);
+  EXPECT_TRUE(info->is_object_stream_flag);
+  EXPECT_EQ(200, info->pos);
+
+  info = cache->objects_info.find(4);
+  ASSERT_TRUE(info);
+  EXPECT_EQ(CPDF_CrossRefTable::ObjectType::kCompressed, info->type);
+  EXPECT_EQ(3u, info->archive.obj_num);
+  EXPECT_EQ(1u, info->archive.obj_index);
+
+  ASSERT_EQ(1u, cache->object_streams.size());
+  EXPECT_THAT(cache->object_streams[3],
+              ElementsAre(CPDF_ObjectStream::ObjectInfo(5, 0),
+                          CPDF_ObjectStream::ObjectInfo(4, 17)));
+  EXPECT_THAT(cache->page_obj_nums, ElementsAre(4, 0, 1));
+
+  // Serializing again gives the same data.
+  EXPECT_EQ(data, cache->Serialize());
+}
+
+TEST(ParseCacheTest, RoundTripEmpty) {
+  CPDF_ParseCache empty_cache;
+  std::unique_ptr<CPDF_ParseCache> cache =
+      CPDF_ParseCache::Deserialize(empty_cache.Serialize());
+  ASSERT_TRUE(cache);
+  EXPECT_EQ(CPDF_ParseCache::Key(), cache->key);
+  EXPECT_FALSE(cache->xref_stream);
+  EXPECT_TRUE(cache->objects_info.empty());
+  EXPECT_TRUE(cache->object_streams.empty());
+  EXPECT_TRUE(cache->page_obj_nums.empty());
+}
+
+TEST(ParseCacheTest, RejectInvalid) {
+  EXPECT_FALSE(CPDF_ParseCache::Deserialize({}));
+
+  const DataVector<uint8_t> data = CreateTestCache()->Serialize();
+  for (size_t size = 0; size < data.size(); ++size) {
+    EXPECT_FALSE(
+        CPDF_ParseCache::Deserialize(pdfium::span(data).first(size)));
+  }
+
+  // Flip one bit at a time.
+  for (size_t i = 0; i < data.size(); ++i) {
+    DataVector<uint8_t> corrupted = data;
+    corrupted[i] ^= 0x10;
+    EXPECT_FALSE(CPDF_ParseCache::Deserialize(corrupted));
+  }
+
+  DataVector<uint8_t> extended = data;
+  extended.push_back(0);
+  EXPECT_FALSE(CPDF_ParseCache::Deserialize(extended));
+}
@@ -20,6 +20,7 @@
 #include "core/fpdfapi/parser/cpdf_linearized_header.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_object_stream.h"
+#include "core/fpdfapi/parser/cpdf_parse_cache.h"
 #include "core/fpdfapi/parser/cpdf_read_validator.h"
 #include "core/fpdfapi/parser/cpdf_reference.h"
 #include "core/fpdfapi/parser/cpdf_security_handler.h"
@@ -177,7 +178,7 @@ CPDF_Parser::~CPDF_Parser() = default;
 uint32_t CPDF_Parser::GetLastObjNum() const {
   return cross_ref_table_->objects_info().empty()
              ? 0
-             : cross_ref_table_->objects_info().rbegin()->first;
+             : cross_ref_table_->objects_info().last_key();
 }
 
 bool CPDF_Parser::IsValidObjectNumber(uint32_t objnum) const {
@@ -243,6 +244,48 @@ CPDF_Parser::Error CPDF_Parser::StartParse(
   return StartParseInternal();
 }
 
+void CPDF_Parser::SetParseCache(std::unique_ptr<CPDF_ParseCache> cache) {
+  DCHECK(!has_parsed_);
+  parse_cache_ = std::move(cache);
+}
+
+const CPDF_ParseCache* CPDF_Parser::GetUsedParseCache() const {
+  return parse_cache_used_ ? parse_cache_.get() : nullptr;
+}
+
+std::unique_ptr<CPDF_ParseCache> CPDF_Parser::CreateParseCache(
+    std::vector<uint32_t> page_obj_nums) const {
+  if (!has_parsed_ || cross_ref_rebuilt_ || linearized_ ||
+      last_xref_offset_ < kPDFHeaderSize) {
+    return nullptr;
+  }
+
+  auto cache = std::make_unique<CPDF_ParseCache>();
+  cache->key.file_size = GetDocumentSize();
+  cache->key.last_xref_offset = last_xref_offset_;
+  RetainPtr<const CPDF_Array> id_array = GetIDArray();
+  if (id_array) {
+    cache->key.id = id_array->GetByteStringAt(0);
+  }
+  cache->xref_stream = xref_stream_;
+  for (const auto& [obj_num, info] : cross_ref_table_->objects_info()) {
+    cache->objects_info[obj_num] = info;
+  }
+  if (parse_cache_used_) {
+    // Object streams that were not loaded this time.
+    for (const auto& [obj_num, infos] : parse_cache_->object_streams) {
+      cache->object_streams[obj_num] = infos;
+    }
+  }
+  for (const auto& [obj_num, object_stream] : object_stream_map_) {
+    if (object_stream) {
+      cache->object_streams[obj_num] = object_stream->object_info();
+    }
+  }
+  cache->page_obj_nums = std::move(page_obj_nums);
+  return cache;
+}
+
 CPDF_Parser::Error CPDF_Parser::StartParseInternal() {
   DCHECK(!has_parsed_);
   DCHECK(!xref_table_rebuilt_);
@@ -251,7 +294,8 @@ CPDF_Parser::Error CPDF_Parser::StartParseInternal() {
 
   last_xref_offset_ = ParseStartXRef();
   if (last_xref_offset_ >= kPDFHeaderSize) {
-    if (!LoadAllCrossRefTablesAndStreams(last_xref_offset_)) {
+    if (!LoadFromParseCache() &&
+        !LoadAllCrossRefTablesAndStreams(last_xref_offset_)) {
       if (!RebuildCrossRef()) {
         return FORMAT_ERROR;
       }
@@ -471,6 +515,57 @@ bool CPDF_Parser::LoadAllCrossRefTablesAndStreams(FX_FILESIZE xref_offset) {
   return true;
 }
 
+bool CPDF_Parser::LoadFromParseCache() {
+  if (!parse_cache_) {
+    return false;
+  }
+
+  const CPDF_ParseCache::Key& key = parse_cache_->key;
+  if (key.file_size != GetDocumentSize() ||
+      key.last_xref_offset != last_xref_offset_) {
+    parse_cache_.reset();
+    return false;
+  }
+
+  // The trailer is not cached, as reading the last one is cheap, and it
+  // confirms that the file still has the cached /ID.
+  RetainPtr<CPDF_Dictionary> trailer;
+  uint32_t trailer_object_number = kNoTrailerObjectNumber;
+  if (parse_cache_->xref_stream) {
+    RetainPtr<const CPDF_Stream> stream =
+        ToStream(ParseIndirectObjectAt(last_xref_offset_, 0));
+    if (stream && stream->GetObjNum()) {
+      trailer = ToDictionary(stream->GetDict()->Clone());
+      trailer_object_number = stream->GetObjNum();
+    }
+  } else if (LoadCrossRefTable(last_xref_offset_, /*skip=*/true)) {
+    trailer = LoadTrailer();
+  }
+  if (!trailer) {
+    parse_cache_.reset();
+    return false;
+  }
+
+  RetainPtr<const CPDF_Array> id_array = trailer->GetArrayFor("ID");
+  if ((id_array ? id_array->GetByteStringAt(0) : ByteString()) != key.id) {
+    parse_cache_.reset();
+    return false;
+  }
+
+  cross_ref_table_ = std::make_unique<CPDF_CrossRefTable>(
+      std::move(trailer), trailer_object_number);
+  cross_ref_table_->SetObjectsInfo(std::move(parse_cache_->objects_info));
+  if (!VerifyCrossRefTable()) {
+    cross_ref_table_ = std::make_unique<CPDF_CrossRefTable>();
+    parse_cache_.reset();
+    return false;
+  }
+
+  xref_stream_ = parse_cache_->xref_stream;
+  parse_cache_used_ = true;
+  return true;
+}
+
 bool CPDF_Parser::LoadLinearizedAllCrossRefTable(FX_FILESIZE main_xref_offset) {
   if (!LoadCrossRefTable(main_xref_offset, /*skip=*/false)) {
     return false;
@@ -759,6 +854,11 @@ bool CPDF_Parser::FindAllCrossReferenceTablesAndStream(
 }
 
 bool CPDF_Parser::RebuildCrossRef() {
+  // A rebuilt table no longer matches the cache.
+  parse_cache_.reset();
+  parse_cache_used_ = false;
+  cross_ref_rebuilt_ = true;
+
   auto cross_ref_table = std::make_unique<CPDF_CrossRefTable>();
 
   const uint32_t kBufferSize = 4096;
@@ -1135,8 +1235,17 @@ const CPDF_ObjectStream* CPDF_Parser::GetObjectStream(uint32_t object_number) {
     return nullptr;
   }
 
-  std::unique_ptr<CPDF_ObjectStream> objs_stream =
-      CPDF_ObjectStream::Create(ToStream(object));
+  std::unique_ptr<CPDF_ObjectStream> objs_stream;
+  if (parse_cache_used_) {
+    auto cached = parse_cache_->object_streams.extract(object_number);
+    if (cached) {
+      objs_stream = CPDF_ObjectStream::CreateWithObjectInfo(
+          ToStream(object), std::move(cached.mapped()));
+    }
+  }
+  if (!objs_stream) {
+    objs_stream = CPDF_ObjectStream::Create(ToStream(object));
+  }
   const CPDF_ObjectStream* result = objs_stream.get();
   object_stream_map_[object_number] = std::move(objs_stream);
 
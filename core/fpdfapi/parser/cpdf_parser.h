@@ -32,6 +32,7 @@ class CPDF_ReadValidator;
 class CPDF_SecurityHandler;
 class CPDF_SyntaxParser;
 class IFX_ArchiveStream;
+struct CPDF_ParseCache;
 class IFX_SeekableReadStream;
 
 class CPDF_Parser {
@@ -74,6 +75,20 @@ class CPDF_Parser {
   Error StartLinearizedParse(RetainPtr<CPDF_ReadValidator> validator,
                              const ByteString& password);
 
+  // Makes StartParse() take the cross reference table and object stream
+  // offsets from `cache` if it still matches the file. Otherwise, the file is
+  // parsed as usual.
+  void SetParseCache(std::unique_ptr<CPDF_ParseCache> cache);
+
+  // Returns the cache given to SetParseCache() if parsing used it.
+  const CPDF_ParseCache* GetUsedParseCache() const;
+
+  // Returns the structure of the parsed file, with `page_obj_nums` as the page
+  // list, or nullptr if it cannot be cached. That is the case for linearized
+  // loading and for files whose cross reference table had to be rebuilt.
+  std::unique_ptr<CPDF_ParseCache> CreateParseCache(
+      std::vector<uint32_t> page_obj_nums) const;
+
   ByteString GetPassword() const { return password_; }
 
   // Take the GetPassword() value and encode it, if necessary, based on the
@@ -150,6 +165,7 @@ class CPDF_Parser {
   };
 
   bool LoadAllCrossRefTablesAndStreams(FX_FILESIZE xref_offset);
+  bool LoadFromParseCache();
   bool FindAllCrossReferenceTablesAndStream(
       FX_FILESIZE main_xref_offset,
       std::vector<FX_FILESIZE>& xref_list,
@@ -195,6 +211,10 @@ class CPDF_Parser {
   bool has_parsed_ = false;
   bool xref_stream_ = false;
   bool xref_table_rebuilt_ = false;
+  bool parse_cache_used_ = false;
+  // Unlike `xref_table_rebuilt_`, also set when rebuilding after the cross
+  // reference sections loaded fine but pointed to unusable objects.
+  bool cross_ref_rebuilt_ = false;
   int file_version_ = 0;
   uint32_t metadata_objnum_ = 0;
   // cross_ref_table_ must be destroyed after security_handler_ due to the
@@ -203,6 +223,8 @@ class CPDF_Parser {
   FX_FILESIZE last_xref_offset_ = 0;
   ByteString password_;
   std::unique_ptr<CPDF_LinearizedHeader> linearized_;
+  // Object stream offsets are taken from here as the streams get loaded.
+  std::unique_ptr<CPDF_ParseCache> parse_cache_;
 
   // A map of object numbers to indirect streams.
   std::map<uint32_t, std::unique_ptr<CPDF_ObjectStream>> object_stream_map_;
@@ -12,9 +12,11 @@
 #include <utility>
 #include <vector>
 
+#include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_linearized_header.h"
 #include "core/fpdfapi/parser/cpdf_object.h"
+#include "core/fpdfapi/parser/cpdf_parse_cache.h"
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
 #include "core/fxcrt/cfx_fileaccess_stream.h"
 #include "core/fxcrt/cfx_read_only_span_stream.h"
@@ -848,3 +850,78 @@ TEST_F(ParserXRefTest, XrefWithIndexAndWrongSize) {
                                         Pair(80, expected_result[1]),
                                         Pair(81, expected_result[2])));
 }
+
+TEST(ParserTest, ParseCache) {
+  const unsigned char kData[] =
+      "%PDF-1.7\n"
+      "1 0 obj\n<< /Type /Catalog >>\nendobj\n"
+      "xref\n"
+      "0 2\n"
+      "0000000000 65535 f\r\n"
+      "0000000009 00000 n\r\n"
+      "trailer\n"
+      "<< /Size 2 /Root 1 0 R /ID [(first) (second)] >>\n"
+      "startxref\n"
+      "45\n"
+      "%%EOF\n";
+  auto root = pdfium::MakeRetain<CPDF_Dictionary>();
+
+  std::unique_ptr<CPDF_ParseCache> cache;
+  {
+    CPDF_TestParser parser;
+    EXPECT_CALL(parser.object_holder(), ParseIndirectObject)
+        .WillRepeatedly(Return(root));
+    ASSERT_TRUE(parser.InitTestFromBuffer(kData));
+    EXPECT_FALSE(parser.CreateParseCache({}));
+    ASSERT_EQ(CPDF_Parser::SUCCESS, parser.StartParseInternal());
+    EXPECT_FALSE(parser.GetUsedParseCache());
+    cache = parser.CreateParseCache({1});
+    ASSERT_TRUE(cache);
+  }
+  EXPECT_EQ(static_cast<FX_FILESIZE>(sizeof(kData)), cache->key.file_size);
+  EXPECT_EQ(45, cache->key.last_xref_offset);
+  EXPECT_EQ("first", cache->key.id);
+  EXPECT_FALSE(cache->xref_stream);
+  EXPECT_EQ(1u, cache->objects_info.size());
+  EXPECT_THAT(cache->page_obj_nums, ElementsAre(1));
+
+  {
+    CPDF_TestParser parser;
+    EXPECT_CALL(parser.object_holder(), ParseIndirectObject)
+        .WillRepeatedly(Return(root));
+    ASSERT_TRUE(parser.InitTestFromBuffer(kData));
+    parser.SetParseCache(CPDF_ParseCache::Deserialize(cache->Serialize()));
+    ASSERT_EQ(CPDF_Parser::SUCCESS, parser.StartParseInternal());
+    ASSERT_TRUE(parser.GetUsedParseCache());
+    EXPECT_THAT(parser.GetUsedParseCache()->page_obj_nums, ElementsAre(1));
+    EXPECT_EQ(9, GetObjInfo(parser, 1).pos);
+    EXPECT_EQ("first", parser.GetIDArray()->GetByteStringAt(0));
+  }
+
+  // A cache for a file with a different /ID is not used.
+  cache->key.id = "other";
+  {
+    CPDF_TestParser parser;
+    EXPECT_CALL(parser.object_holder(), ParseIndirectObject)
+        .WillRepeatedly(Return(root));
+    ASSERT_TRUE(parser.InitTestFromBuffer(kData));
+    parser.SetParseCache(CPDF_ParseCache::Deserialize(cache->Serialize()));
+    ASSERT_EQ(CPDF_Parser::SUCCESS, parser.StartParseInternal());
+    EXPECT_FALSE(parser.GetUsedParseCache());
+    EXPECT_EQ(9, GetObjInfo(parser, 1).pos);
+  }
+
+  // Neither is a cache whose entries do not match the file.
+  cache->key.id = "first";
+  cache->objects_info[1].pos = 20;
+  {
+    CPDF_TestParser parser;
+    EXPECT_CALL(parser.object_holder(), ParseIndirectObject)
+        .WillRepeatedly(Return(root));
+    ASSERT_TRUE(parser.InitTestFromBuffer(kData));
+    parser.SetParseCache(CPDF_ParseCache::Deserialize(cache->Serialize()));
+    ASSERT_EQ(CPDF_Parser::SUCCESS, parser.StartParseInternal());
+    EXPECT_FALSE(parser.GetUsedParseCache());
+    EXPECT_EQ(9, GetObjInfo(parser, 1).pos);
+  }
+}
@@ -83,6 +83,15 @@ FX_FILESIZE CPDF_ReadValidator::GetSize() {
   return file_size_;
 }
 
+pdfium::span<const uint8_t> CPDF_ReadValidator::GetOwnedSpan() {
+  // With `file_avail_`, data may still be downloading, so every read must be
+  // validated.
+  if (file_avail_) {
+    return {};
+  }
+  return file_read_->GetOwnedSpan();
+}
+
 void CPDF_ReadValidator::ScheduleDownload(FX_FILESIZE offset, size_t size) {
   has_unavailable_data_ = true;
   if (!hints_ || size == 0) {
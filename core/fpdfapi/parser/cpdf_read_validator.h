@@ -48,6 +48,7 @@ class CPDF_ReadValidator final : public IFX_SeekableReadStream {
   bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
                          FX_FILESIZE offset) override;
   FX_FILESIZE GetSize() override;
+  pdfium::span<const uint8_t> GetOwnedSpan() override;
 
  protected:
   CPDF_ReadValidator(RetainPtr<IFX_SeekableReadStream> file_read,
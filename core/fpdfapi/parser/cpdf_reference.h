@@ -33,6 +33,9 @@ class CPDF_Reference final : public CPDF_Object {
 
   uint32_t GetRefObjNum() const { return ref_obj_num_; }
   bool HasIndirectObjectHolder() const { return !!obj_list_; }
+
+  // Does not count as a change to the object containing this reference. To
+  // change a reference in a loaded object, replace it in its container.
   void SetRef(CPDF_IndirectObjectHolder* doc, uint32_t objnum);
 
  private:
@@ -371,6 +371,21 @@ TEST_F(CPDFSecurityHandlerEmbedderTest, OwnerPasswordVersion5Latin1) {
   VerifySavedModifiedHelloWorldDocumentWithPassword(kHotelUTF8);
 }
 
+TEST_F(CPDFSecurityHandlerEmbedderTest, SaveInParallelVersion5) {
+  OpenAndVerifyHelloWorldDocumentWithPassword("encrypted_hello_world_r5.pdf",
+                                              kAgeLatin1);
+  EXPECT_TRUE(FPDF_SaveWithVersion(document(), this, 0, 0));
+  const size_t serial_size = GetString().size();
+
+  // AES encryption uses a random IV, so the encrypted data differs between
+  // saves. Only the size matches.
+  ClearString();
+  EXPECT_TRUE(FPDF_SaveWithVersionParallel(document(), this, 0, 0, 4));
+  EXPECT_EQ(serial_size, GetString().size());
+  VerifySavedHelloWorldDocumentWithPassword(kAgeLatin1);
+  VerifySavedHelloWorldDocumentWithPassword(kAgeUTF8);
+}
+
 TEST_F(CPDFSecurityHandlerEmbedderTest, OwnerPasswordVersion6UTF8) {
   // Same as OwnerPasswordVersion2UTF8 test above.
   OpenAndVerifyHelloWorldDocumentWithPassword("encrypted_hello_world_r6.pdf",
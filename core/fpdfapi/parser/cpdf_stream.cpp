@@ -13,8 +13,8 @@
 #include <variant>
 
 #include "constants/stream_dict_common.h"
+#include "core/fpdfapi/parser/cpdf_change_tracker.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
-#include "core/fpdfapi/parser/cpdf_encryptor.h"
 #include "core/fpdfapi/parser/cpdf_flateencoder.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_stream_acc.h"
@@ -28,16 +28,6 @@
 #include "core/fxcrt/numerics/safe_conversions.h"
 #include "core/fxcrt/span_util.h"
 
-namespace {
-
-bool IsMetaDataStreamDictionary(const CPDF_Dictionary* dict) {
-  // See ISO 32000-1:2008 spec, table 315.
-  return ValidateDictType(dict, "Metadata") &&
-         dict->GetNameFor("Subtype") == "XML";
-}
-
-}  // namespace
-
 CPDF_Stream::CPDF_Stream(RetainPtr<CPDF_Dictionary> dict)
     : CPDF_Stream(DataVector<uint8_t>(), std::move(dict)) {}
 
@@ -90,6 +80,7 @@ void CPDF_Stream::InitStreamFromFile(RetainPtr<IFX_SeekableReadStream> file) {
   const int size = pdfium::checked_cast<int>(file->GetSize());
   data_ = std::move(file);
   dict_ = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict_->SetChangeTracker(change_tracker_, tracked_obj_num_);
   SetLengthInDict(size);
 }
 
@@ -97,6 +88,13 @@ RetainPtr<CPDF_Object> CPDF_Stream::Clone() const {
   return CloneObjectNonCyclic(false);
 }
 
+void CPDF_Stream::SetChangeTracker(const WeakPtr<CPDF_ChangeTracker>& tracker,
+                                   uint32_t objnum) {
+  change_tracker_ = tracker;
+  tracked_obj_num_ = objnum;
+  dict_->SetChangeTracker(tracker, objnum);
+}
+
 RetainPtr<CPDF_Object> CPDF_Stream::CloneNonCyclic(
     bool bDirect,
     std::set<const CPDF_Object*>* pVisited) const {
@@ -168,6 +166,12 @@ bool CPDF_Stream::HasFilter() const {
   return dict_->KeyExist("Filter");
 }
 
+bool CPDF_Stream::IsMetadataStream() const {
+  // See ISO 32000-1:2008 spec, table 315.
+  return ValidateDictType(dict_.Get(), "Metadata") &&
+         dict_->GetNameFor("Subtype") == "XML";
+}
+
 WideString CPDF_Stream::GetUnicodeText() const {
   auto pAcc = pdfium::MakeRetain<CPDF_StreamAcc>(pdfium::WrapRetain(this));
   pAcc->LoadAllDataFiltered();
@@ -176,30 +180,10 @@ WideString CPDF_Stream::GetUnicodeText() const {
 
 bool CPDF_Stream::WriteTo(IFX_ArchiveStream* archive,
                           const CPDF_Encryptor* encryptor) const {
-  const bool is_metadata = IsMetaDataStreamDictionary(GetDict().Get());
+  const bool is_metadata = IsMetadataStream();
   CPDF_FlateEncoder encoder(pdfium::WrapRetain(this), !is_metadata);
-
-  DataVector<uint8_t> encrypted_data;
-  pdfium::span<const uint8_t> data = encoder.GetSpan();
-  if (encryptor && !is_metadata) {
-    encrypted_data = encryptor->Encrypt(data);
-    data = encrypted_data;
-  }
-
-  encoder.UpdateLength(data.size());
-  if (!encoder.WriteDictTo(archive, encryptor)) {
-    return false;
-  }
-
-  if (!archive->WriteString("stream\r\n")) {
-    return false;
-  }
-
-  if (!archive->WriteBlock(data)) {
-    return false;
-  }
-
-  return archive->WriteString("\r\nendstream");
+  return encoder.WriteStreamTo(archive, encryptor,
+                               /*encrypt_data=*/!is_metadata);
 }
 
 size_t CPDF_Stream::GetRawSize() const {
@@ -210,8 +194,18 @@ size_t CPDF_Stream::GetRawSize() const {
   return std::get<DataVector<uint8_t>>(data_).size();
 }
 
+bool CPDF_Stream::HasInMemoryRawData() const {
+  return IsMemoryBased() ||
+         !std::get<RetainPtr<IFX_SeekableReadStream>>(data_)
+              ->GetOwnedSpan()
+              .empty();
+}
+
 pdfium::span<const uint8_t> CPDF_Stream::GetInMemoryRawData() const {
-  DCHECK(IsMemoryBased());
+  DCHECK(HasInMemoryRawData());
+  if (IsFileBased()) {
+    return std::get<RetainPtr<IFX_SeekableReadStream>>(data_)->GetOwnedSpan();
+  }
   return std::get<DataVector<uint8_t>>(data_);
 }
 
@@ -33,9 +33,17 @@ class CPDF_Stream final : public CPDF_Object {
   CPDF_Stream* AsMutableStream() override;
   bool WriteTo(IFX_ArchiveStream* archive,
                const CPDF_Encryptor* encryptor) const override;
+  // Changes to the data also change /Length in the dictionary, so the stream
+  // records its changes through its dictionary.
+  void SetChangeTracker(const WeakPtr<CPDF_ChangeTracker>& tracker,
+                        uint32_t objnum) override;
 
   size_t GetRawSize() const;
-  // Can only be called when stream is memory-based.
+  // Returns whether the raw data is already in memory, either because the
+  // stream is memory-based, or because it is file-based and the file keeps its
+  // contents in memory.
+  bool HasInMemoryRawData() const;
+  // Can only be called when HasInMemoryRawData() returns true.
   // This is meant to be used by CPDF_StreamAcc only.
   // Other callers should use CPDF_StreamAcc to access data in all cases.
   pdfium::span<const uint8_t> GetInMemoryRawData() const;
@@ -63,6 +71,9 @@ class CPDF_Stream final : public CPDF_Object {
     return std::holds_alternative<DataVector<uint8_t>>(data_);
   }
   bool HasFilter() const;
+  // Returns whether this is an XML metadata stream, which WriteTo() writes
+  // without compressing or encrypting its data.
+  bool IsMetadataStream() const;
 
  private:
   friend class CPDF_Dictionary;
@@ -95,6 +106,9 @@ class CPDF_Stream final : public CPDF_Object {
 
   std::variant<RetainPtr<IFX_SeekableReadStream>, DataVector<uint8_t>> data_;
   RetainPtr<CPDF_Dictionary> dict_;
+  // Kept to track a dictionary that replaces `dict_`.
+  WeakPtr<CPDF_ChangeTracker> change_tracker_;
+  uint32_t tracked_obj_num_ = 0;
 };
 
 inline CPDF_Stream* ToStream(CPDF_Object* obj) {
@@ -6,16 +6,187 @@
 
 #include "core/fpdfapi/parser/cpdf_stream_acc.h"
 
+#include <algorithm>
+#include <optional>
 #include <utility>
 #include <variant>
 
+#include "constants/stream_dict_common.h"
 #include "core/fdrm/fx_crypt.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/fpdf_parser_decode.h"
+#include "core/fxcodec/flate/flatemodule.h"
 #include "core/fxcrt/check_op.h"
 #include "core/fxcrt/compiler_specific.h"
 #include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/stl_util.h"
+
+namespace {
+
+// Returns the size of the fully decoded data of a stream with `dict`, as far
+// as the dictionary tells, or 0 if it does not. The decoders only use it to
+// size their output buffers, so a wrong size costs time, not correctness.
+uint32_t GetDecodedSizeHint(const CPDF_Dictionary* dict) {
+  const int decoded_length = dict->GetIntegerFor(pdfium::stream::kDL);
+  if (decoded_length > 0) {
+    return decoded_length;
+  }
+
+  // Images in device color spaces have a known size. Others need their color
+  // space loaded, which CPDF_DIB does before passing in the size itself.
+  if (dict->GetNameFor("Subtype") != "Image") {
+    return 0;
+  }
+  int components = 0;
+  int bpc = 1;
+  if (dict->GetBooleanFor("ImageMask", false)) {
+    components = 1;
+  } else {
+    const ByteString color_space = dict->GetNameFor("ColorSpace");
+    if (color_space == "DeviceGray") {
+      components = 1;
+    } else if (color_space == "DeviceRGB") {
+      components = 3;
+    } else if (color_space == "DeviceCMYK") {
+      components = 4;
+    }
+    bpc = dict->GetIntegerFor("BitsPerComponent");
+  }
+  const int width = dict->GetIntegerFor("Width");
+  const int height = dict->GetIntegerFor("Height");
+  if (components == 0 || bpc <= 0 || bpc > 16 || width <= 0 || height <= 0) {
+    return 0;
+  }
+
+  FX_SAFE_UINT32 size = width;
+  size *= components;
+  size *= bpc;
+  size += 7;
+  size /= 8;
+  size *= height;
+  return size.ValueOrDefault(0);
+}
+
+// Decodes data with a single FlateDecode filter and no predictor straight into
+// a buffer of its /DL size. Returns no data if that does not apply, or if /DL
+// turns out to be wrong, so the caller can decode it the usual way.
+std::optional<DataVector<uint8_t>> DecodeFlateWithDecodedLength(
+    pdfium::span<const uint8_t> src_span,
+    const CPDF_Dictionary* dict,
+    const DecoderArray& decoder_array) {
+  if (decoder_array.size() != 1) {
+    return std::nullopt;
+  }
+  const ByteString& decoder = decoder_array.front().first;
+  if (decoder != "FlateDecode" && decoder != "Fl") {
+    return std::nullopt;
+  }
+  RetainPtr<const CPDF_Dictionary> params =
+      ToDictionary(decoder_array.front().second);
+  if (params && params->GetIntegerFor("Predictor", 1) > 1) {
+    return std::nullopt;
+  }
+  const int decoded_length = dict->GetIntegerFor(pdfium::stream::kDL);
+  if (decoded_length <= 0 ||
+      !FlateModule::IsPlausibleDecodedSize(decoded_length, src_span.size())) {
+    return std::nullopt;
+  }
+
+  // The extra byte catches data longer than /DL.
+  DataVector<uint8_t> data(decoded_length + 1);
+  if (FlateModule::DecodeInto(src_span, data) !=
+      static_cast<size_t>(decoded_length)) {
+    return std::nullopt;
+  }
+  data.pop_back();
+  return data;
+}
+
+// Reads data that is already in memory.
+class SpanReader final : public CPDF_StreamAcc::Reader {
+ public:
+  // `holder` keeps `span` alive.
+  SpanReader(RetainPtr<const Retainable> holder,
+             pdfium::span<const uint8_t> span)
+      : holder_(std::move(holder)), span_(span) {}
+  ~SpanReader() override = default;
+
+  // CPDF_StreamAcc::Reader:
+  size_t Read(pdfium::span<uint8_t> buffer) override {
+    const size_t size = std::min(buffer.size(), span_.size());
+    fxcrt::Copy(span_.first(size), buffer);
+    span_ = span_.subspan(size);
+    return size;
+  }
+
+ private:
+  // Needs to outlive `span_`.
+  RetainPtr<const Retainable> const holder_;
+  pdfium::raw_span<const uint8_t> span_;
+};
+
+// Decodes a stream with a single FlateDecode filter on demand.
+class FlateReader final : public CPDF_StreamAcc::Reader {
+ public:
+  static std::unique_ptr<FlateReader> Create(
+      RetainPtr<const CPDF_Stream> stream,
+      const CPDF_Dictionary* params) {
+    auto reader = std::make_unique<FlateReader>(std::move(stream));
+    if (reader->stream_->HasInMemoryRawData()) {
+      reader->src_span_ = reader->stream_->GetInMemoryRawData();
+    } else {
+      reader->src_data_ = reader->stream_->ReadAllRawData();
+      reader->src_span_ = reader->src_data_;
+    }
+    if (reader->src_span_.empty()) {
+      return nullptr;
+    }
+
+    reader->decoder_ = CreateFlateStreamDecoder(reader->src_span_, params);
+    if (!reader->decoder_) {
+      return nullptr;
+    }
+    return reader;
+  }
+
+  explicit FlateReader(RetainPtr<const CPDF_Stream> stream)
+      : stream_(std::move(stream)) {}
+  ~FlateReader() override = default;
+
+  // CPDF_StreamAcc::Reader:
+  size_t Read(pdfium::span<uint8_t> buffer) override {
+    if (buffer.empty()) {
+      return 0;
+    }
+    if (!read_raw_) {
+      const size_t size = decoder_->Read(buffer);
+      if (size || started_) {
+        started_ = true;
+        return size;
+      }
+      // As in ProcessFilteredData(), data that decodes to nothing reads as
+      // the raw data.
+      read_raw_ = true;
+    }
+    const size_t size = std::min(buffer.size(), src_span_.size());
+    fxcrt::Copy(src_span_.first(size), buffer);
+    src_span_ = src_span_.subspan(size);
+    return size;
+  }
+
+ private:
+  // Needs to outlive `src_span_` when the data is not owned.
+  RetainPtr<const CPDF_Stream> const stream_;
+  DataVector<uint8_t> src_data_;
+  pdfium::raw_span<const uint8_t> src_span_;
+  std::unique_ptr<fxcodec::FlateStreamDecoder> decoder_;
+  bool started_ = false;
+  bool read_raw_ = false;
+};
+
+}  // namespace
 
 CPDF_StreamAcc::CPDF_StreamAcc(RetainPtr<const CPDF_Stream> pStream)
     : stream_(std::move(pStream)) {}
@@ -59,6 +230,32 @@ void CPDF_StreamAcc::LoadAllDataRaw() {
   LoadAllData(true, 0, false);
 }
 
+std::unique_ptr<CPDF_StreamAcc::Reader> CPDF_StreamAcc::CreateFilteredReader()
+    const {
+  if (stream_ && stream_->GetRawSize() && stream_->HasFilter()) {
+    std::optional<DecoderArray> decoder_array =
+        GetDecoderArray(stream_->GetDict());
+    if (decoder_array.has_value() && decoder_array.value().size() == 1) {
+      const ByteString& decoder = decoder_array.value().front().first;
+      if (decoder == "FlateDecode" || decoder == "Fl") {
+        RetainPtr<const CPDF_Dictionary> params =
+            ToDictionary(decoder_array.value().front().second);
+        std::unique_ptr<FlateReader> reader =
+            FlateReader::Create(stream_, params.Get());
+        if (reader) {
+          return reader;
+        }
+      }
+    }
+  }
+
+  // Other filters decode everything at once.
+  auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(stream_);
+  stream_acc->LoadAllDataFiltered();
+  pdfium::span<const uint8_t> span = stream_acc->GetSpan();
+  return std::make_unique<SpanReader>(std::move(stream_acc), span);
+}
+
 RetainPtr<const CPDF_Stream> CPDF_StreamAcc::GetStream() const {
   return stream_;
 }
@@ -79,7 +276,7 @@ pdfium::span<const uint8_t> CPDF_StreamAcc::GetSpan() const {
   if (is_owned()) {
     return std::get<DataVector<uint8_t>>(data_);
   }
-  if (stream_ && stream_->IsMemoryBased()) {
+  if (stream_ && stream_->HasInMemoryRawData()) {
     return stream_->GetInMemoryRawData();
   }
   return {};
@@ -108,7 +305,7 @@ void CPDF_StreamAcc::ProcessRawData() {
     return;
   }
 
-  if (stream_->IsMemoryBased()) {
+  if (stream_->HasInMemoryRawData()) {
     data_ = stream_->GetInMemoryRawData();
     return;
   }
@@ -130,7 +327,7 @@ void CPDF_StreamAcc::ProcessFilteredData(uint32_t estimated_size,
 
   std::variant<pdfium::raw_span<const uint8_t>, DataVector<uint8_t>> src_data;
   pdfium::span<const uint8_t> src_span;
-  if (stream_->IsMemoryBased()) {
+  if (stream_->HasInMemoryRawData()) {
     src_span = stream_->GetInMemoryRawData();
     src_data = src_span;
   } else {
@@ -150,6 +347,18 @@ void CPDF_StreamAcc::ProcessFilteredData(uint32_t estimated_size,
     return;
   }
 
+  if (!bImageAcc) {
+    std::optional<DataVector<uint8_t>> data = DecodeFlateWithDecodedLength(
+        src_span, stream_->GetDict(), decoder_array.value());
+    if (data.has_value()) {
+      data_ = std::move(data.value());
+      return;
+    }
+  }
+
+  if (!estimated_size) {
+    estimated_size = GetDecodedSizeHint(stream_->GetDict());
+  }
   std::optional<PDFDataDecodeResult> result = PDF_DataDecode(
       src_span, estimated_size, bImageAcc, decoder_array.value());
   if (!result.has_value()) {
@@ -7,6 +7,7 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_STREAM_ACC_H_
 #define CORE_FPDFAPI_PARSER_CPDF_STREAM_ACC_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <memory>
@@ -25,6 +26,17 @@ class CPDF_StreamAcc final : public Retainable {
  public:
   CONSTRUCT_VIA_MAKE_RETAIN;
 
+  // Pulls the data of a stream a piece at a time. See CreateFilteredReader().
+  class Reader {
+   public:
+    virtual ~Reader() = default;
+
+    // Fills `buffer` with the next bytes of data. Returns the number of bytes
+    // written, which is less than the size of `buffer` only at the end of the
+    // data.
+    virtual size_t Read(pdfium::span<uint8_t> buffer) = 0;
+  };
+
   CPDF_StreamAcc(const CPDF_StreamAcc&) = delete;
   CPDF_StreamAcc& operator=(const CPDF_StreamAcc&) = delete;
 
@@ -33,6 +45,11 @@ class CPDF_StreamAcc final : public Retainable {
   void LoadAllDataImageAcc(uint32_t estimated_size);
   void LoadAllDataRaw();
 
+  // Returns a reader for the data that LoadAllDataFiltered() would load. For
+  // streams with a single FlateDecode filter, the reader decodes on demand
+  // instead of holding all of the decoded data in memory.
+  std::unique_ptr<Reader> CreateFilteredReader() const;
+
   RetainPtr<const CPDF_Stream> GetStream() const;
   RetainPtr<const CPDF_Dictionary> GetImageParam() const;
 
@@ -4,15 +4,56 @@
 
 #include "core/fpdfapi/parser/cpdf_stream_acc.h"
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <algorithm>
+#include <memory>
 #include <utility>
 
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxcodec/data_and_bytes_consumed.h"
+#include "core/fxcodec/flate/flatemodule.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_stream.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/invalid_seekable_read_stream.h"
 
+namespace {
+
+RetainPtr<CPDF_Stream> MakeStream(DataVector<uint8_t> data,
+                                  const char* filter) {
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Name>("Filter", filter);
+  return pdfium::MakeRetain<CPDF_Stream>(std::move(data), std::move(dict));
+}
+
+DataVector<uint8_t> LoadFiltered(RetainPtr<const CPDF_Stream> stream) {
+  auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(stream));
+  stream_acc->LoadAllDataFiltered();
+  return stream_acc->DetachData();
+}
+
+// Reads all of the filtered data of `stream`, 1000 bytes at a time.
+DataVector<uint8_t> ReadFiltered(RetainPtr<const CPDF_Stream> stream) {
+  auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(stream));
+  std::unique_ptr<CPDF_StreamAcc::Reader> reader =
+      stream_acc->CreateFilteredReader();
+  DataVector<uint8_t> result;
+  DataVector<uint8_t> chunk(1000);
+  size_t size;
+  do {
+    size = reader->Read(chunk);
+    result.insert(result.end(), chunk.begin(), chunk.begin() + size);
+  } while (size == chunk.size());
+  return result;
+}
+
+}  // namespace
+
 TEST(StreamAccTest, ReadRawDataFailed) {
   auto stream = pdfium::MakeRetain<CPDF_Stream>(
       pdfium::MakeRetain<InvalidSeekableReadStream>(1024),
@@ -34,3 +75,74 @@ TEST(StreamAccTest, DataStreamLifeTime) {
   EXPECT_TRUE(
       std::equal(std::begin(kData), std::end(kData), span.begin(), span.end()));
 }
+
+TEST(StreamAccTest, DecodedSizeHint) {
+  DataVector<uint8_t> data(50000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i * 13);
+  }
+  const DataVector<uint8_t> encoded = FlateModule::Encode(data);
+  // Hints only size buffers, so wrong ones still give the right data.
+  for (int decoded_length : {0, 1, 49999, 50000, 50001, 60000}) {
+    RetainPtr<CPDF_Stream> stream = MakeStream(encoded, "FlateDecode");
+    stream->GetMutableDict()->SetNewFor<CPDF_Number>("DL", decoded_length);
+    EXPECT_EQ(data, LoadFiltered(stream)) << " for /DL " << decoded_length;
+  }
+}
+
+TEST(StreamAccTest, FilteredReader) {
+  DataVector<uint8_t> data(50000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i * 13);
+  }
+
+  // Decodes on demand.
+  RetainPtr<CPDF_Stream> flate_stream =
+      MakeStream(FlateModule::Encode(data), "FlateDecode");
+  EXPECT_EQ(data, ReadFiltered(flate_stream));
+
+  // Decodes everything at once, but gives the same data.
+  static constexpr char kHex[] = "616263>";
+  RetainPtr<CPDF_Stream> hex_stream = MakeStream(
+      DataVector<uint8_t>(std::begin(kHex), std::end(kHex) - 1),
+      "ASCIIHexDecode");
+  EXPECT_EQ(LoadFiltered(hex_stream), ReadFiltered(hex_stream));
+
+  // Data that does not decode reads as the raw data.
+  const DataVector<uint8_t> corrupt = {'b', 'a', 'd'};
+  RetainPtr<CPDF_Stream> corrupt_stream = MakeStream(corrupt, "FlateDecode");
+  EXPECT_EQ(corrupt, LoadFiltered(corrupt_stream));
+  EXPECT_EQ(corrupt, ReadFiltered(corrupt_stream));
+
+  // No filter.
+  RetainPtr<CPDF_Stream> raw_stream = pdfium::MakeRetain<CPDF_Stream>(data);
+  EXPECT_EQ(data, ReadFiltered(raw_stream));
+}
+
+TEST(StreamAccTest, FilteredReaderWithPredictor) {
+  // 10 gray pixels per row with PNG predictors, and a truncated last row.
+  static constexpr int kColumns = 10;
+  DataVector<uint8_t> png_rows((kColumns + 1) * 30 + 4);
+  for (size_t i = 0; i < png_rows.size(); ++i) {
+    png_rows[i] = static_cast<uint8_t>(i * 13);
+  }
+  for (size_t i = 0; i < png_rows.size(); i += kColumns + 1) {
+    png_rows[i] = (i / (kColumns + 1)) % 5;
+  }
+  const DataVector<uint8_t> encoded = FlateModule::Encode(png_rows);
+  DataAndBytesConsumed expected = FlateModule::FlateOrLZWDecode(
+      false, encoded, false, 15, 1, 8, kColumns, 0);
+  ASSERT_FALSE(expected.data.empty());
+
+  RetainPtr<CPDF_Stream> stream = MakeStream(encoded, "FlateDecode");
+  auto params = stream->GetMutableDict()->SetNewFor<CPDF_Dictionary>(
+      "DecodeParms");
+  params->SetNewFor<CPDF_Number>("Predictor", 15);
+  params->SetNewFor<CPDF_Number>("Columns", kColumns);
+  // A /DL of the size before the predictor must not make the predictor get
+  // skipped.
+  stream->GetMutableDict()->SetNewFor<CPDF_Number>(
+      "DL", static_cast<int>(png_rows.size()));
+  EXPECT_EQ(expected.data, LoadFiltered(stream));
+  EXPECT_EQ(expected.data, ReadFiltered(stream));
+}
@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_boolean.h"
@@ -67,6 +68,15 @@ class ReadableSubStream final : public IFX_SeekableReadStream {
 
   FX_FILESIZE GetSize() override { return part_size_; }
 
+  pdfium::span<const uint8_t> GetOwnedSpan() override {
+    pdfium::span<const uint8_t> whole_file = file_read_->GetOwnedSpan();
+    if (whole_file.empty()) {
+      return {};
+    }
+    return whole_file.subspan(static_cast<size_t>(part_offset_),
+                              static_cast<size_t>(part_size_));
+  }
+
  private:
   RetainPtr<IFX_SeekableReadStream> file_read_;
   FX_FILESIZE part_offset_;
@@ -98,7 +108,8 @@ CPDF_SyntaxParser::CPDF_SyntaxParser(RetainPtr<CPDF_ReadValidator> validator,
                                      FX_FILESIZE HeaderOffset)
     : file_access_(std::move(validator)),
       header_offset_(HeaderOffset),
-      file_len_(file_access_->GetSize()) {
+      file_len_(file_access_->GetSize()),
+      in_memory_file_(file_access_->GetOwnedSpan()) {
   DCHECK_LE(header_offset_, file_len_);
 }
 
@@ -114,6 +125,10 @@ bool CPDF_SyntaxParser::ReadBlockAt(FX_FILESIZE read_pos) {
   if (read_pos >= file_len_) {
     return false;
   }
+  if (!in_memory_file_.empty()) {
+    // GetReadBuffer() already covers the whole file.
+    return true;
+  }
   size_t read_size = read_buffer_size_;
   FX_SAFE_FILESIZE safe_end = read_pos;
   safe_end += read_size;
@@ -141,7 +156,7 @@ bool CPDF_SyntaxParser::GetNextChar(uint8_t& ch) {
     return false;
   }
 
-  ch = file_buf_[pos - buf_offset_];
+  ch = GetReadBuffer()[pos - buf_offset_];
   pos_++;
   return true;
 }
@@ -165,7 +180,7 @@ bool CPDF_SyntaxParser::GetCharAtBackward(FX_FILESIZE pos, uint8_t* ch) {
       return false;
     }
   }
-  *ch = file_buf_[pos - buf_offset_];
+  *ch = GetReadBuffer()[pos - buf_offset_];
   return true;
 }
 
@@ -604,8 +619,7 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
         pool_, PDF_NameDecode(ByteStringView(word_span).Substr(1)));
   }
   if (word == "<<") {
-    RetainPtr<CPDF_Dictionary> dict =
-        pdfium::MakeRetain<CPDF_Dictionary>(pool_);
+    std::vector<CPDF_Dictionary::DictMap::value_type> entries;
     while (true) {
       WordResult inner_word_result = GetNextWord();
       const ByteString& inner_word = inner_word_result.word;
@@ -645,9 +659,11 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
       // `key` has to be "/X" at the minimum.
       // `pObj` cannot be a stream, per ISO 32000-1:2008 section 7.3.8.1.
       if (key.GetLength() > 1 && !pObj->IsStream()) {
-        dict->SetFor(key.Substr(1), std::move(pObj));
+        entries.emplace_back(key.Substr(1), std::move(pObj));
       }
     }
+    RetainPtr<CPDF_Dictionary> dict =
+        pdfium::MakeRetain<CPDF_Dictionary>(pool_, std::move(entries));
 
     AutoRestorer<FX_FILESIZE> pos_restorer(&pos_);
     if (GetNextWord().word != "stream") {
@@ -852,7 +868,12 @@ RetainPtr<CPDF_Stream> CPDF_SyntaxParser::ReadStream(
   }
 
   RetainPtr<CPDF_Stream> stream;
-  if (substream) {
+  if (substream && !substream->GetOwnedSpan().empty()) {
+    // The data is in memory owned by the file, which `substream` retains, so
+    // `stream` can refer to it without making a copy.
+    stream =
+        pdfium::MakeRetain<CPDF_Stream>(std::move(substream), std::move(dict));
+  } else if (substream) {
     // It is unclear from CPDF_SyntaxParser's perspective what object
     // `substream` is ultimately holding references to. To avoid unexpectedly
     // changing object lifetimes by handing `substream` to `stream`, make a
@@ -1007,5 +1028,12 @@ FX_FILESIZE CPDF_SyntaxParser::FindTag(ByteStringView tag) {
 
 bool CPDF_SyntaxParser::IsPositionRead(FX_FILESIZE pos) const {
   return buf_offset_ <= pos &&
-         pos < static_cast<FX_FILESIZE>(buf_offset_ + file_buf_.size());
+         pos < static_cast<FX_FILESIZE>(buf_offset_ + GetReadBuffer().size());
+}
+
+pdfium::span<const uint8_t> CPDF_SyntaxParser::GetReadBuffer() const {
+  if (!in_memory_file_.empty()) {
+    return in_memory_file_;
+  }
+  return file_buf_;
 }
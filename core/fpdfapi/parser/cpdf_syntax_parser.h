@@ -17,6 +17,7 @@
 #include "core/fxcrt/bytestring_pool.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_types.h"
+#include "core/fxcrt/raw_span.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/span.h"
 #include "core/fxcrt/unowned_ptr.h"
@@ -111,6 +112,8 @@ class CPDF_SyntaxParser {
   RetainPtr<CPDF_Stream> ReadStream(RetainPtr<CPDF_Dictionary> dict);
 
   bool IsPositionRead(FX_FILESIZE pos) const;
+  // Returns the bytes starting at file offset `buf_offset_`.
+  pdfium::span<const uint8_t> GetReadBuffer() const;
 
   RetainPtr<CPDF_Object> GetObjectBodyInternal(
       CPDF_IndirectObjectHolder* pObjList,
@@ -122,6 +125,9 @@ class CPDF_SyntaxParser {
   // ignore this stuff.
   const FX_FILESIZE header_offset_;
   const FX_FILESIZE file_len_;
+  // The whole file, if `file_access_` holds it in memory. Then it is scanned in
+  // place and `file_buf_` is unused.
+  const pdfium::raw_span<const uint8_t> in_memory_file_;
   FX_FILESIZE pos_ = 0;
   WeakPtr<ByteStringPool> pool_;
   DataVector<uint8_t> file_buf_;
@@ -6,7 +6,10 @@
 
 #include "core/fpdfapi/parser/cpdf_object.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_stream_acc.h"
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
+#include "core/fxcrt/cfx_read_only_container_stream.h"
 #include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/fx_extension.h"
 #include "testing/gmock/include/gmock/gmock.h"
@@ -147,3 +150,40 @@ TEST(SyntaxParserTest, PeekNextWord) {
   EXPECT_EQ("WORD", parser.PeekNextWord());
   EXPECT_EQ("WORD", parser.GetNextWord().word);
 }
+
+TEST(SyntaxParserTest, ReadStreamFromOwnedData) {
+  // With a valid /Length, and with one that needs to be worked out from the
+  // position of "endstream", the stream data is used in place.
+  for (const char* data : {"<< /Length 5 >>\nstream\nhello\nendstream\n",
+                           "<< /Length 9 >>\nstream\nhello\nendstream\n"}) {
+    auto file =
+        pdfium::MakeRetain<CFX_ReadOnlyByteStringStream>(ByteString(data));
+    const pdfium::span<const uint8_t> file_span = file->span();
+    CPDF_SyntaxParser parser(file);
+    RetainPtr<CPDF_Stream> stream = ToStream(parser.GetObjectBody(nullptr));
+    ASSERT_TRUE(stream);
+    ASSERT_TRUE(stream->HasInMemoryRawData());
+
+    auto acc = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(stream));
+    acc->LoadAllDataRaw();
+    EXPECT_EQ("hello", ByteStringView(acc->GetSpan()));
+    const size_t offset = ByteString(data).Find("hello").value();
+    EXPECT_EQ(file_span.subspan(offset).data(), acc->GetSpan().data());
+  }
+}
+
+TEST(SyntaxParserTest, ReadStreamFromUnownedData) {
+  static const char kData[] = "<< /Length 5 >>\nstream\nhello\nendstream\n";
+  const pdfium::span<const uint8_t> data =
+      ByteStringView(kData).unsigned_span();
+  CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(data));
+
+  // The caller may free `data` before the stream goes away, so it is copied.
+  RetainPtr<CPDF_Stream> stream = ToStream(parser.GetObjectBody(nullptr));
+  ASSERT_TRUE(stream);
+  auto acc = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(stream));
+  acc->LoadAllDataRaw();
+  EXPECT_EQ("hello", ByteStringView(acc->GetSpan()));
+  const size_t offset = ByteString(kData).Find("hello").value();
+  EXPECT_NE(data.subspan(offset).data(), acc->GetSpan().data());
+}
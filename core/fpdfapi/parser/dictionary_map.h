@@ -0,0 +1,131 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_DICTIONARY_MAP_H_
+#define CORE_FPDFAPI_PARSER_DICTIONARY_MAP_H_
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "core/fxcrt/bytestring.h"
+
+// Map from dictionary keys to `T`, stored as a vector sorted by key. Iteration
+// visits keys in the same order as std::map<ByteString, T> would, so objects
+// are still serialized with sorted keys.
+//
+// Most dictionaries have only a few entries, so small maps are searched
+// linearly, comparing lengths first. Keys interned by the same ByteStringPool
+// share a buffer, so those are matched by pointer without comparing their
+// characters. Larger maps use binary search.
+//
+// Unlike std::map, adding or removing an entry may move other entries, so
+// references and iterators into the map are invalidated by any non-const call.
+// Callers must not change keys through an `iterator`.
+template <typename T>
+class DictionaryMap {
+ public:
+  using value_type = std::pair<ByteString, T>;
+  using iterator = typename std::vector<value_type>::iterator;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  // Up to this many entries, find() does a linear search.
+  static constexpr size_t kMaxLinearSearchSize = 16;
+
+  // Builds a map from `entries` in any order, sorting them once. Where keys
+  // repeat, the last entry wins, as if they were inserted one by one.
+  static DictionaryMap FromUnsorted(std::vector<value_type> entries) {
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const value_type& a, const value_type& b) {
+                       return a.first < b.first;
+                     });
+    auto out = entries.begin();
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+      auto next = std::next(it);
+      if (next != entries.end() && next->first == it->first) {
+        continue;
+      }
+      if (out != it) {
+        *out = std::move(*it);
+      }
+      ++out;
+    }
+    entries.erase(out, entries.end());
+
+    DictionaryMap map;
+    map.entries_ = std::move(entries);
+    return map;
+  }
+
+  DictionaryMap() = default;
+  DictionaryMap(DictionaryMap&& that) noexcept = default;
+  DictionaryMap& operator=(DictionaryMap&& that) noexcept = default;
+  ~DictionaryMap() = default;
+
+  bool empty() const { return entries_.empty(); }
+  size_t size() const { return entries_.size(); }
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
+
+  iterator find(ByteStringView key) {
+    return entries_.begin() +
+           (std::as_const(*this).find(key) - entries_.cbegin());
+  }
+
+  const_iterator find(ByteStringView key) const {
+    if (entries_.size() <= kMaxLinearSearchSize) {
+      return std::find_if(entries_.begin(), entries_.end(),
+                          [key](const value_type& entry) {
+                            return KeyEquals(entry.first, key);
+                          });
+    }
+    const_iterator it = LowerBound(key);
+    return it != entries_.end() && KeyEquals(it->first, key) ? it
+                                                             : entries_.end();
+  }
+
+  bool contains(ByteStringView key) const { return find(key) != end(); }
+
+  // Returns the value now stored for `key`.
+  T& InsertOrAssign(ByteString key, T value) {
+    auto it = entries_.begin() + (LowerBound(key.AsStringView()) -
+                                  entries_.cbegin());
+    if (it != entries_.end() && KeyEquals(it->first, key.AsStringView())) {
+      it->second = std::move(value);
+      return it->second;
+    }
+    return entries_.emplace(it, std::move(key), std::move(value))->second;
+  }
+
+  iterator erase(const_iterator it) { return entries_.erase(it); }
+
+ private:
+  static bool KeyEquals(const ByteString& a, ByteStringView b) {
+    return a.GetLength() == b.GetLength() &&
+           (a.unsigned_str() == b.unterminated_unsigned_str() ||
+            a.AsStringView() == b);
+  }
+
+  const_iterator LowerBound(ByteStringView key) const {
+    // Keys are usually added in order when copying, so check the end first.
+    if (entries_.empty() || entries_.back().first < key) {
+      return entries_.end();
+    }
+    return std::lower_bound(
+        entries_.begin(), entries_.end(), key,
+        [](const value_type& entry, ByteStringView key) {
+          return entry.first < key;
+        });
+  }
+
+  std::vector<value_type> entries_;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_DICTIONARY_MAP_H_
@@ -0,0 +1,128 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/dictionary_map.h"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "core/fxcrt/bytestring_pool.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+using testing::Pair;
+
+namespace {
+
+void ExpectSameContents(const std::map<ByteString, int>& expected,
+                        const DictionaryMap<int>& map) {
+  ASSERT_EQ(expected.size(), map.size());
+  ASSERT_EQ(expected.empty(), map.empty());
+  auto expected_it = expected.begin();
+  for (const auto& [key, value] : map) {
+    ASSERT_NE(expected_it, expected.end());
+    EXPECT_EQ(expected_it->first, key);
+    EXPECT_EQ(expected_it->second, value);
+    ++expected_it;
+  }
+  EXPECT_EQ(expected_it, expected.end());
+  for (const auto& [key, value] : expected) {
+    auto it = map.find(key.AsStringView());
+    ASSERT_NE(it, map.end()) << key;
+    EXPECT_EQ(value, it->second);
+  }
+}
+
+}  // namespace
+
+TEST(DictionaryMap, Empty) {
+  DictionaryMap<int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_EQ(map.end(), map.find("Type"));
+  EXPECT_FALSE(map.contains(""));
+  EXPECT_THAT(map, IsEmpty());
+}
+
+TEST(DictionaryMap, InsertOrAssign) {
+  DictionaryMap<int> map;
+  EXPECT_EQ(1, map.InsertOrAssign("Type", 1));
+  EXPECT_EQ(2, map.InsertOrAssign("Subtype", 2));
+  EXPECT_EQ(3, map.InsertOrAssign("Length", 3));
+  EXPECT_EQ(4, map.InsertOrAssign("Type", 4));
+  EXPECT_EQ(5, map.InsertOrAssign("", 5));
+  EXPECT_THAT(map, ElementsAre(Pair("", 5), Pair("Length", 3),
+                               Pair("Subtype", 2), Pair("Type", 4)));
+  EXPECT_TRUE(map.contains("Type"));
+  EXPECT_TRUE(map.contains(""));
+  EXPECT_FALSE(map.contains("Typ"));
+  EXPECT_FALSE(map.contains("Types"));
+
+  map.erase(map.find("Subtype"));
+  EXPECT_THAT(map,
+              ElementsAre(Pair("", 5), Pair("Length", 3), Pair("Type", 4)));
+}
+
+TEST(DictionaryMap, InternedKeys) {
+  ByteStringPool pool;
+  DictionaryMap<int> map;
+  const ByteString key = pool.Intern("Resources");
+  map.InsertOrAssign(key, 1);
+
+  // Both the interned key and an equal string that is not interned match.
+  auto it = map.find(pool.Intern(ByteString("Resources")).AsStringView());
+  ASSERT_NE(it, map.end());
+  EXPECT_EQ(key.unsigned_str(), it->first.unsigned_str());
+  EXPECT_EQ(it, map.find("Resources"));
+}
+
+TEST(DictionaryMap, FromUnsorted) {
+  std::vector<DictionaryMap<int>::value_type> entries;
+  entries.emplace_back("c", 1);
+  entries.emplace_back("a", 2);
+  entries.emplace_back("c", 3);
+  entries.emplace_back("b", 4);
+  entries.emplace_back("a", 5);
+  entries.emplace_back("c", 6);
+  DictionaryMap<int> map = DictionaryMap<int>::FromUnsorted(std::move(entries));
+  EXPECT_THAT(map, ElementsAre(Pair("a", 5), Pair("b", 4), Pair("c", 6)));
+
+  EXPECT_TRUE(DictionaryMap<int>::FromUnsorted({}).empty());
+}
+
+TEST(DictionaryMap, MatchesStdMap) {
+  // Large enough to use binary search.
+  constexpr int kCount = 200;
+  static_assert(kCount > DictionaryMap<int>::kMaxLinearSearchSize);
+
+  std::map<ByteString, int> expected;
+  DictionaryMap<int> map;
+  std::vector<DictionaryMap<int>::value_type> entries;
+  for (int i = 0; i < kCount; ++i) {
+    // Insert in a scrambled order, with some keys repeated.
+    ByteString key = ByteString::Format("Key%d", (i * 37) % (kCount / 2));
+    expected[key] = i;
+    map.InsertOrAssign(key, i);
+    entries.emplace_back(key, i);
+    if (map.size() == DictionaryMap<int>::kMaxLinearSearchSize) {
+      ExpectSameContents(expected, map);
+    }
+  }
+  ExpectSameContents(expected, map);
+  ExpectSameContents(expected,
+                     DictionaryMap<int>::FromUnsorted(std::move(entries)));
+  EXPECT_FALSE(map.contains("Key"));
+  EXPECT_FALSE(map.contains("Key100"));
+  EXPECT_FALSE(map.contains("Zzz"));
+
+  for (int i = 0; i < kCount / 2; i += 3) {
+    ByteString key = ByteString::Format("Key%d", i);
+    expected.erase(key);
+    map.erase(map.find(key.AsStringView()));
+  }
+  ExpectSameContents(expected, map);
+}
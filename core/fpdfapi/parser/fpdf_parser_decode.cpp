@@ -390,6 +390,26 @@ DataAndBytesConsumed FlateOrLZWDecode(bool use_lzw,
                                        Columns, estimated_size);
 }
 
+std::unique_ptr<fxcodec::FlateStreamDecoder> CreateFlateStreamDecoder(
+    pdfium::span<const uint8_t> src_span,
+    const CPDF_Dictionary* pParams) {
+  int predictor = 0;
+  int Colors = 0;
+  int BitsPerComponent = 0;
+  int Columns = 0;
+  if (pParams) {
+    predictor = pParams->GetIntegerFor("Predictor");
+    Colors = pParams->GetIntegerFor("Colors", 1);
+    BitsPerComponent = pParams->GetIntegerFor("BitsPerComponent", 8);
+    Columns = pParams->GetIntegerFor("Columns", 1);
+    if (!CheckFlateDecodeParams(Colors, BitsPerComponent, Columns)) {
+      return nullptr;
+    }
+  }
+  return FlateModule::CreateStreamDecoder(src_span, predictor, Colors,
+                                          BitsPerComponent, Columns);
+}
+
 std::optional<DecoderArray> GetDecoderArray(
     RetainPtr<const CPDF_Dictionary> dict) {
   RetainPtr<const CPDF_Object> pFilter = dict->GetDirectObjectFor("Filter");
@@ -26,6 +26,7 @@ class CPDF_Dictionary;
 class CPDF_Object;
 
 namespace fxcodec {
+class FlateStreamDecoder;
 class ScanlineDecoder;
 }
 
@@ -66,6 +67,12 @@ fxcodec::DataAndBytesConsumed FlateOrLZWDecode(
     const CPDF_Dictionary* pParams,
     uint32_t estimated_size);
 
+// Returns a decoder that gives the same data as FlateOrLZWDecode() a piece at
+// a time, or nullptr if `pParams` is invalid.
+std::unique_ptr<fxcodec::FlateStreamDecoder> CreateFlateStreamDecoder(
+    pdfium::span<const uint8_t> src_span,
+    const CPDF_Dictionary* pParams);
+
 // Returns std::nullopt if the filter in |dict| is the wrong type or an
 // invalid decoder pipeline.
 // Returns an empty vector if there is no filter, or if the filter is an empty
@@ -0,0 +1,251 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_OBJECT_NUMBER_MAP_H_
+#define CORE_FPDFAPI_PARSER_OBJECT_NUMBER_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "core/fxcrt/check.h"
+
+// Ordered map from object numbers to `T`. Object numbers are usually dense,
+// starting at 0 or 1, so most entries live in a vector indexed by object
+// number. Entries whose object number is far beyond the number of entries,
+// e.g. from a malformed cross reference table, go into a std::map instead.
+//
+// Unlike std::map, adding an entry may move other entries, so references and
+// iterators into the map are invalidated by any non-const call.
+template <typename T>
+class ObjectNumberMap {
+ public:
+  using value_type = std::pair<uint32_t, const T&>;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ObjectNumberMap::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    const_iterator(const const_iterator&) = default;
+    const_iterator& operator=(const const_iterator&) = default;
+
+    value_type operator*() const {
+      if (dense_index_ < map_->dense_values_.size()) {
+        return {static_cast<uint32_t>(dense_index_),
+                map_->dense_values_[dense_index_]};
+      }
+      return {sparse_it_->first, sparse_it_->second};
+    }
+
+    const_iterator& operator++() {
+      if (dense_index_ < map_->dense_values_.size()) {
+        dense_index_ = map_->NextDenseIndex(dense_index_ + 1);
+      } else {
+        ++sparse_it_;
+      }
+      return *this;
+    }
+
+    bool operator==(const const_iterator& that) const {
+      return dense_index_ == that.dense_index_ && sparse_it_ == that.sparse_it_;
+    }
+
+   private:
+    friend class ObjectNumberMap;
+
+    const_iterator(const ObjectNumberMap* map,
+                   size_t dense_index,
+                   typename std::map<uint32_t, T>::const_iterator sparse_it)
+        : map_(map), dense_index_(dense_index), sparse_it_(sparse_it) {}
+
+    const ObjectNumberMap* map_;
+    size_t dense_index_;
+    typename std::map<uint32_t, T>::const_iterator sparse_it_;
+  };
+
+  using iterator = const_iterator;
+
+  ObjectNumberMap() = default;
+  ObjectNumberMap(ObjectNumberMap&&) noexcept = default;
+  ObjectNumberMap& operator=(ObjectNumberMap&&) noexcept = default;
+  ~ObjectNumberMap() = default;
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  const_iterator begin() const {
+    return const_iterator(this, NextDenseIndex(0), sparse_.begin());
+  }
+  const_iterator end() const {
+    return const_iterator(this, dense_values_.size(), sparse_.end());
+  }
+
+  // Returns the largest object number in the map. Must not be empty.
+  uint32_t last_key() const {
+    CHECK(!empty());
+    if (!sparse_.empty()) {
+      return sparse_.rbegin()->first;
+    }
+    // The last dense entry is always present, see TrimDense().
+    return static_cast<uint32_t>(dense_values_.size() - 1);
+  }
+
+  bool contains(uint32_t key) const { return !!find(key); }
+
+  const T* find(uint32_t key) const {
+    if (key < dense_values_.size()) {
+      return dense_present_[key] ? &dense_values_[key] : nullptr;
+    }
+    auto it = sparse_.find(key);
+    return it != sparse_.end() ? &it->second : nullptr;
+  }
+  T* find(uint32_t key) {
+    return const_cast<T*>(std::as_const(*this).find(key));
+  }
+
+  // Returns the entry for `key`, adding a default-constructed one if needed.
+  T& operator[](uint32_t key) {
+    if (key < dense_values_.size()) {
+      if (!dense_present_[key]) {
+        dense_present_[key] = true;
+        ++size_;
+      }
+      return dense_values_[key];
+    }
+    if (key < DenseLimit()) {
+      GrowDense(key);
+      if (!dense_present_[key]) {
+        dense_present_[key] = true;
+        ++size_;
+      }
+      return dense_values_[key];
+    }
+    auto [it, inserted] = sparse_.try_emplace(key);
+    if (!inserted) {
+      return it->second;
+    }
+    ++size_;
+    // Entries may have gone into `sparse_` when the map was smaller. Move them
+    // over once they are dense enough, so the map does not degrade into a
+    // std::map when filled in descending order.
+    if (std::has_single_bit(sparse_.size())) {
+      const size_t limit = DenseLimit();
+      std::optional<uint32_t> new_last;
+      for (const auto& entry : sparse_) {
+        if (entry.first >= limit) {
+          break;
+        }
+        new_last = entry.first;
+      }
+      if (new_last.has_value()) {
+        GrowDense(new_last.value());
+        return *find(key);
+      }
+    }
+    return it->second;
+  }
+
+  // Returns whether an entry for `key` was removed.
+  bool erase(uint32_t key) {
+    if (key < dense_values_.size()) {
+      if (!dense_present_[key]) {
+        return false;
+      }
+      dense_present_[key] = false;
+      dense_values_[key] = T();
+      --size_;
+      TrimDense();
+      return true;
+    }
+    if (!sparse_.erase(key)) {
+      return false;
+    }
+    --size_;
+    return true;
+  }
+
+  // Removes all entries with keys of `key` or above.
+  void erase_from(uint32_t key) {
+    if (key < dense_values_.size()) {
+      for (size_t i = key; i < dense_values_.size(); ++i) {
+        if (dense_present_[i]) {
+          --size_;
+        }
+      }
+      dense_values_.resize(key);
+      dense_present_.resize(key);
+      TrimDense();
+    }
+    for (auto it = sparse_.lower_bound(key); it != sparse_.end();) {
+      it = sparse_.erase(it);
+      --size_;
+    }
+  }
+
+  void clear() {
+    dense_values_.clear();
+    dense_present_.clear();
+    sparse_.clear();
+    size_ = 0;
+  }
+
+ private:
+  // Keys below this always go into the vector.
+  static constexpr size_t kMinDenseLimit = 1024;
+  // Allow the vector to be this many times larger than the number of entries.
+  static constexpr size_t kMaxDenseOverhead = 4;
+
+  size_t DenseLimit() const {
+    return std::max(kMinDenseLimit, kMaxDenseOverhead * (size_ + 1));
+  }
+
+  size_t NextDenseIndex(size_t index) const {
+    while (index < dense_present_.size() && !dense_present_[index]) {
+      ++index;
+    }
+    return index;
+  }
+
+  // Makes `key` a valid index into the vector, moving over any entries from
+  // `sparse_` that are now in range.
+  void GrowDense(uint32_t key) {
+    dense_values_.resize(key + 1);
+    dense_present_.resize(key + 1);
+    while (!sparse_.empty() && sparse_.begin()->first <= key) {
+      auto node = sparse_.extract(sparse_.begin());
+      dense_values_[node.key()] = std::move(node.mapped());
+      dense_present_[node.key()] = true;
+    }
+  }
+
+  // Drops trailing vector slots without entries, so the last slot, if any, is
+  // always an entry.
+  void TrimDense() {
+    size_t new_size = dense_present_.size();
+    while (new_size > 0 && !dense_present_[new_size - 1]) {
+      --new_size;
+    }
+    dense_values_.resize(new_size);
+    dense_present_.resize(new_size);
+  }
+
+  std::vector<T> dense_values_;
+  std::vector<bool> dense_present_;
+  // Entries with keys past the end of `dense_values_`.
+  std::map<uint32_t, T> sparse_;
+  size_t size_ = 0;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_OBJECT_NUMBER_MAP_H_
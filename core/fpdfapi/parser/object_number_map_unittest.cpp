@@ -0,0 +1,125 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/object_number_map.h"
+
+#include <stdint.h>
+
+#include <map>
+#include <vector>
+
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+using testing::Pair;
+
+namespace {
+
+void ExpectSameContents(const std::map<uint32_t, int>& expected,
+                        const ObjectNumberMap<int>& map) {
+  ASSERT_EQ(expected.size(), map.size());
+  ASSERT_EQ(expected.empty(), map.empty());
+  auto expected_it = expected.begin();
+  for (const auto& [key, value] : map) {
+    ASSERT_NE(expected_it, expected.end());
+    EXPECT_EQ(expected_it->first, key);
+    EXPECT_EQ(expected_it->second, value);
+    ++expected_it;
+  }
+  EXPECT_EQ(expected_it, expected.end());
+  if (!expected.empty()) {
+    EXPECT_EQ(expected.rbegin()->first, map.last_key());
+  }
+}
+
+}  // namespace
+
+TEST(ObjectNumberMap, Empty) {
+  ObjectNumberMap<int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_THAT(map, IsEmpty());
+  EXPECT_FALSE(map.contains(0));
+  EXPECT_FALSE(map.find(1));
+  EXPECT_FALSE(map.erase(2));
+}
+
+TEST(ObjectNumberMap, Basic) {
+  ObjectNumberMap<int> map;
+  map[3] = 30;
+  map[1] = 10;
+  map[0xFFFFFF] = 42;
+  map[2];
+  EXPECT_EQ(4u, map.size());
+  EXPECT_THAT(map, ElementsAre(Pair(1, 10), Pair(2, 0), Pair(3, 30),
+                               Pair(0xFFFFFF, 42)));
+  EXPECT_EQ(0xFFFFFFu, map.last_key());
+  ASSERT_TRUE(map.find(3));
+  EXPECT_EQ(30, *map.find(3));
+  EXPECT_FALSE(map.find(4));
+  EXPECT_TRUE(map.contains(0xFFFFFF));
+
+  EXPECT_TRUE(map.erase(0xFFFFFF));
+  EXPECT_FALSE(map.erase(0xFFFFFF));
+  EXPECT_EQ(3u, map.last_key());
+  EXPECT_TRUE(map.erase(3));
+  EXPECT_EQ(2u, map.last_key());
+  EXPECT_THAT(map, ElementsAre(Pair(1, 10), Pair(2, 0)));
+
+  map.clear();
+  EXPECT_THAT(map, IsEmpty());
+}
+
+TEST(ObjectNumberMap, EraseFrom) {
+  ObjectNumberMap<int> map;
+  for (uint32_t key : {1u, 5u, 9u, 100000u, 200000u}) {
+    map[key] = static_cast<int>(key);
+  }
+  map.erase_from(100001);
+  EXPECT_THAT(map, ElementsAre(Pair(1, 1), Pair(5, 5), Pair(9, 9),
+                               Pair(100000, 100000)));
+  map.erase_from(6);
+  EXPECT_THAT(map, ElementsAre(Pair(1, 1), Pair(5, 5)));
+  EXPECT_EQ(5u, map.last_key());
+  map.erase_from(0);
+  EXPECT_THAT(map, IsEmpty());
+}
+
+TEST(ObjectNumberMap, MatchesStdMap) {
+  // Mix dense ascending, dense descending and scattered keys, so entries move
+  // between the vector and the std::map.
+  std::map<uint32_t, int> expected;
+  ObjectNumberMap<int> map;
+  auto insert = [&](uint32_t key) {
+    expected[key] = static_cast<int>(key) * 3;
+    map[key] = static_cast<int>(key) * 3;
+  };
+  for (uint32_t key = 5000; key > 2000; --key) {
+    insert(key);
+  }
+  ExpectSameContents(expected, map);
+  for (uint32_t key = 0; key < 3000; key += 2) {
+    insert(key);
+  }
+  for (uint32_t key = 7; key < 4000000000u; key = key * 5 + 1) {
+    insert(key);
+  }
+  ExpectSameContents(expected, map);
+
+  for (uint32_t key = 0; key < 6000; key += 3) {
+    EXPECT_EQ(expected.erase(key) == 1, map.erase(key));
+  }
+  ExpectSameContents(expected, map);
+
+  expected.erase(expected.lower_bound(4500), expected.end());
+  map.erase_from(4500);
+  ExpectSameContents(expected, map);
+
+  for (uint32_t key = 10000; key < 20000; ++key) {
+    insert(key);
+  }
+  ExpectSameContents(expected, map);
+}
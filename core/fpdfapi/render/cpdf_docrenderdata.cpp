@@ -12,6 +12,7 @@
 #include <array>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/font/cpdf_type3font.h"
 #include "core/fpdfapi/page/cpdf_dib.h"
@@ -22,6 +23,8 @@
 #include "core/fpdfapi/render/cpdf_type3cache.h"
 #include "core/fxcrt/compiler_specific.h"
 #include "core/fxcrt/fixed_size_data_vector.h"
+#include "core/fxcrt/span.h"
+#include "core/fxcrt/stl_util.h"
 
 #if BUILDFLAG(IS_WIN)
 #include "core/fxge/win32/cfx_psfonttracker.h"
@@ -31,6 +34,40 @@ namespace {
 
 const int kMaxOutputs = 16;
 
+// Returns the results of `func` for the inputs 0, 1 / 255, ..., 1, one set of
+// results after another, or an empty vector if `func` fails for any of them.
+// Functions that do not take exactly one input are left to Call(), which fails
+// for them and leaves the samples as they were.
+std::vector<float> CallForAllSamples(const CPDF_Function& func) {
+  if (func.InputCount() != 1) {
+    return {};
+  }
+  std::array<float, CPDF_TransferFunc::kChannelSampleSize> inputs;
+  for (size_t v = 0; v < inputs.size(); ++v) {
+    inputs[v] = static_cast<float>(v) / 255.0f;
+  }
+  std::vector<float> results(inputs.size() * func.OutputCount());
+  if (!func.CallBatch(inputs, results).has_value()) {
+    return {};
+  }
+  return results;
+}
+
+// Writes the results of `func` for sample `v` to `output`, the same as
+// calling it with `input`. Takes them from `batch_results` if not empty.
+void GetSampleResults(const CPDF_Function& func,
+                      pdfium::span<const float> batch_results,
+                      size_t v,
+                      float input,
+                      pdfium::span<float> output) {
+  if (batch_results.empty()) {
+    func.Call(pdfium::span_from_ref(input), output);
+    return;
+  }
+  const uint32_t count = func.OutputCount();
+  fxcrt::Copy(batch_results.subspan(v * count, count), output);
+}
+
 }  // namespace
 
 // static
@@ -113,6 +150,12 @@ RetainPtr<CPDF_TransferFunc> CPDF_DocRenderData::CreateTransferFunc(
   std::array<pdfium::span<uint8_t>, 3> samples = {
       samples_r.span(), samples_g.span(), samples_b.span()};
   if (pArray) {
+    std::array<std::vector<float>, 3> batch_results;
+    for (int i = 0; i < 3; ++i) {
+      if (pFuncs[i]->OutputCount() <= kMaxOutputs) {
+        batch_results[i] = CallForAllSamples(*pFuncs[i]);
+      }
+    }
     for (size_t v = 0; v < CPDF_TransferFunc::kChannelSampleSize; ++v) {
       float input = static_cast<float>(v) / 255.0f;
       for (int i = 0; i < 3; ++i) {
@@ -120,7 +163,7 @@ RetainPtr<CPDF_TransferFunc> CPDF_DocRenderData::CreateTransferFunc(
           samples[i][v] = v;
           continue;
         }
-        pFuncs[i]->Call(pdfium::span_from_ref(input), output);
+        GetSampleResults(*pFuncs[i], batch_results[i], v, input, output);
         size_t o = FXSYS_roundf(output[0] * 255);
         if (o != v) {
           bIdentity = false;
@@ -129,10 +172,14 @@ RetainPtr<CPDF_TransferFunc> CPDF_DocRenderData::CreateTransferFunc(
       }
     }
   } else {
+    std::vector<float> batch_results;
+    if (pFuncs[0]->OutputCount() <= kMaxOutputs) {
+      batch_results = CallForAllSamples(*pFuncs[0]);
+    }
     for (size_t v = 0; v < CPDF_TransferFunc::kChannelSampleSize; ++v) {
       float input = static_cast<float>(v) / 255.0f;
       if (pFuncs[0]->OutputCount() <= kMaxOutputs) {
-        pFuncs[0]->Call(pdfium::span_from_ref(input), output);
+        GetSampleResults(*pFuncs[0], batch_results, v, input, output);
       }
       size_t o = FXSYS_roundf(output[0] * 255);
       if (o != v) {
@@ -19,6 +19,7 @@
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+using ::testing::Each;
 using ::testing::ElementsAreArray;
 
 namespace {
@@ -159,6 +160,27 @@ RetainPtr<CPDF_Stream> CreateBadType4FunctionStream() {
       std::move(func_dict));
 }
 
+// A function of two inputs, which a transfer function cannot call.
+RetainPtr<CPDF_Stream> CreateTwoInputType4FunctionStream() {
+  auto func_dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  func_dict->SetNewFor<CPDF_Number>("FunctionType", 4);
+
+  auto domain_array = func_dict->SetNewFor<CPDF_Array>("Domain");
+  domain_array->AppendNew<CPDF_Number>(0);
+  domain_array->AppendNew<CPDF_Number>(1);
+  domain_array->AppendNew<CPDF_Number>(0);
+  domain_array->AppendNew<CPDF_Number>(1);
+
+  auto range_array = func_dict->SetNewFor<CPDF_Array>("Range");
+  range_array->AppendNew<CPDF_Number>(0);
+  range_array->AppendNew<CPDF_Number>(1);
+
+  static constexpr uint8_t kContents[] = "{ add 0.5 add }";
+  return pdfium::MakeRetain<CPDF_Stream>(
+      DataVector<uint8_t>(std::begin(kContents), std::end(kContents)),
+      std::move(func_dict));
+}
+
 class TestDocRenderData : public CPDF_DocRenderData {
  public:
   TestDocRenderData() = default;
@@ -257,4 +279,17 @@ TEST(CPDFDocRenderDataTest, BadTransferFunctions) {
   }
 }
 
+TEST(CPDFDocRenderDataTest, TransferFunctionWithTwoInputs) {
+  auto func_stream = CreateTwoInputType4FunctionStream();
+
+  // Every call fails, which leaves each sample at 0.
+  TestDocRenderData render_data;
+  auto func = render_data.CreateTransferFuncForTesting(func_stream);
+  ASSERT_TRUE(func);
+  EXPECT_FALSE(func->GetIdentity());
+  EXPECT_THAT(func->GetSamplesR(), Each(0));
+  EXPECT_THAT(func->GetSamplesG(), Each(0));
+  EXPECT_THAT(func->GetSamplesB(), Each(0));
+}
+
 }  // namespace
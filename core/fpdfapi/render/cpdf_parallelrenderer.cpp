@@ -0,0 +1,119 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_parallelrenderer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "core/fpdfapi/page/cpdf_pageimagecache.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/render/cpdf_rendercontext.h"
+#include "core/fpdfapi/render/cpdf_renderoptions.h"
+#include "core/fxge/cfx_renderdevice.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+
+namespace {
+
+// Enough bands per thread to even out bands of very different cost.
+constexpr size_t kBandsPerThread = 4;
+
+// Bands thinner than this spend more time walking the object list than
+// rasterizing.
+constexpr int kMinBandHeight = 32;
+
+}  // namespace
+
+CPDF_ParallelRenderer::Band::Band() = default;
+
+CPDF_ParallelRenderer::Band::Band(Band&& that) noexcept = default;
+
+CPDF_ParallelRenderer::Band& CPDF_ParallelRenderer::Band::operator=(
+    Band&& that) noexcept = default;
+
+CPDF_ParallelRenderer::Band::~Band() = default;
+
+// static
+std::vector<FX_RECT> CPDF_ParallelRenderer::SplitIntoBands(
+    const FX_RECT& clip_rect,
+    size_t thread_count) {
+  std::vector<FX_RECT> bands;
+  if (clip_rect.IsEmpty()) {
+    return bands;
+  }
+
+  const int height = clip_rect.Height();
+  const size_t wanted = std::max<size_t>(thread_count, 1) * kBandsPerThread;
+  const int band_height = std::max(
+      kMinBandHeight, static_cast<int>((height + wanted - 1) / wanted));
+  for (int top = clip_rect.top; top < clip_rect.bottom; top += band_height) {
+    bands.emplace_back(clip_rect.left, top, clip_rect.right,
+                       std::min(top + band_height, clip_rect.bottom));
+  }
+  return bands;
+}
+
+CPDF_ParallelRenderer::CPDF_ParallelRenderer(RetainPtr<CFX_DIBitmap> bitmap,
+                                             bool rgb_byte_order)
+    : bitmap_(std::move(bitmap)), rgb_byte_order_(rgb_byte_order) {}
+
+CPDF_ParallelRenderer::~CPDF_ParallelRenderer() = default;
+
+void CPDF_ParallelRenderer::Render(std::vector<Band> bands,
+                                   size_t thread_count) {
+  if (bands.empty()) {
+    return;
+  }
+
+  // The page image cache is shared by all bands, so trim it once afterwards
+  // rather than after every band.
+  CPDF_PageImageCache* page_cache = bands.front().context->GetPageCache();
+  std::optional<uint32_t> cache_size_limit;
+  std::mutex shared_state_lock;
+  for (Band& band : bands) {
+    band.context->SetSharedStateLock(&shared_state_lock);
+    auto& options = band.options->GetOptions();
+    if (options.bLimitedImageCache) {
+      cache_size_limit = band.options->GetCacheSizeLimit();
+      options.bLimitedImageCache = false;
+    }
+  }
+
+  std::atomic<size_t> next_band = 0;
+  auto render_bands = [this, &bands, &next_band] {
+    for (size_t i = next_band++; i < bands.size(); i = next_band++) {
+      RenderBand(bands[i]);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  const size_t worker_count = std::min(thread_count, bands.size());
+  for (size_t i = 1; i < worker_count; ++i) {
+    workers.emplace_back(render_bands);
+  }
+  render_bands();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  if (cache_size_limit.has_value() && page_cache) {
+    page_cache->CacheOptimization(cache_size_limit.value());
+  }
+}
+
+void CPDF_ParallelRenderer::RenderBand(Band& band) {
+  std::unique_ptr<CFX_RenderDevice> device =
+      CFX_RenderDevice::CreateForBitmap(bitmap_, rgb_byte_order_);
+  if (!device) {
+    return;
+  }
+  device->SetBaseClip(band.rect);
+  device->SetClip_Rect(band.rect);
+  band.context->Render(device.get(), /*pStopObj=*/nullptr,
+                       band.options.get(), /*pLastMatrix=*/nullptr);
+}
@@ -0,0 +1,61 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_RENDER_CPDF_PARALLELRENDERER_H_
+#define CORE_FPDFAPI_RENDER_CPDF_PARALLELRENDERER_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/retain_ptr.h"
+
+class CFX_DIBitmap;
+class CPDF_RenderContext;
+class CPDF_RenderOptions;
+
+// Renders a page into a bitmap by splitting the clip rect into horizontal
+// bands, which a pool of worker threads pick up one at a time. The bands
+// share the parsed page. Simple opaque paths render concurrently; all other
+// objects are rendered one at a time, see
+// CPDF_RenderContext::SetSharedStateLock(). Every band is rendered with the
+// same device matrix, so the output is identical to a single-threaded
+// render of the whole clip rect.
+class CPDF_ParallelRenderer {
+ public:
+  // Everything needed to render one band. Created on the calling thread, as
+  // setting up contexts (e.g. appending annotation layers) may load objects.
+  struct Band {
+    Band();
+    Band(Band&& that) noexcept;
+    Band& operator=(Band&& that) noexcept;
+    ~Band();
+
+    FX_RECT rect;
+    std::unique_ptr<CPDF_RenderOptions> options;
+    std::unique_ptr<CPDF_RenderContext> context;
+  };
+
+  // Returns the bands covering `clip_rect`. There are several per thread, so
+  // threads that finish early pick up the remaining work.
+  static std::vector<FX_RECT> SplitIntoBands(const FX_RECT& clip_rect,
+                                             size_t thread_count);
+
+  CPDF_ParallelRenderer(RetainPtr<CFX_DIBitmap> bitmap, bool rgb_byte_order);
+  ~CPDF_ParallelRenderer();
+
+  // Renders `bands` using the calling thread plus up to `thread_count` - 1
+  // workers. Returns once all bands are done.
+  void Render(std::vector<Band> bands, size_t thread_count);
+
+ private:
+  void RenderBand(Band& band);
+
+  RetainPtr<CFX_DIBitmap> const bitmap_;
+  const bool rgb_byte_order_;
+};
+
+#endif  // CORE_FPDFAPI_RENDER_CPDF_PARALLELRENDERER_H_
@@ -62,62 +62,59 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
       device_->SaveState();
       clip_rect_ = current_layer_->GetMatrix().GetInverse().TransformRect(
           CFX_FloatRect(device_->GetClipBox()));
-    }
-    CPDF_PageObjectHolder::const_iterator iter;
-    CPDF_PageObjectHolder::const_iterator iterEnd =
-        current_layer_->GetObjectHolder()->end();
-    if (last_object_rendered_ != iterEnd) {
-      iter = last_object_rendered_;
-      ++iter;
-    } else {
-      iter = current_layer_->GetObjectHolder()->begin();
+      // Fully parsed layers can skip straight to the objects inside the clip
+      // rect. Others get rendered while parsing, one object at a time.
+      objects_in_clip_.reset();
+      next_object_in_clip_ = 0;
+      if (current_layer_->GetObjectHolder()->GetParseState() ==
+          CPDF_PageObjectHolder::ParseState::kParsed) {
+        objects_in_clip_ =
+            current_layer_->GetObjectHolder()->GetPageObjectsInRect(
+                clip_rect_);
+      }
     }
     int nObjsToGo = kStepLimit;
     bool is_mask = false;
-    while (iter != iterEnd) {
-      CPDF_PageObject* pCurObj = iter->get();
-      if (pCurObj->IsActive() && pCurObj->GetRect().left <= clip_rect_.right &&
-          pCurObj->GetRect().right >= clip_rect_.left &&
-          pCurObj->GetRect().bottom <= clip_rect_.top &&
-          pCurObj->GetRect().top >= clip_rect_.bottom) {
-        if (options_->GetOptions().bBreakForMasks && pCurObj->IsImage() &&
-            pCurObj->AsImage()->GetImage()->IsMask()) {
-#if BUILDFLAG(IS_WIN)
-          if (device_->GetDeviceType() == DeviceType::kPrinter) {
-            last_object_rendered_ = iter;
-            render_status_->ProcessClipPath(pCurObj->clip_path(),
-                                            current_layer_->GetMatrix());
-            return;
-          }
-#endif
-          is_mask = true;
-        }
-        if (render_status_->ContinueSingleObject(
-                pCurObj, current_layer_->GetMatrix(), pPause)) {
+    if (objects_in_clip_.has_value()) {
+      while (next_object_in_clip_ < objects_in_clip_->size()) {
+        const Step step =
+            RenderObject((*objects_in_clip_)[next_object_in_clip_], pPause,
+                         &nObjsToGo, &is_mask);
+        if (step == Step::kPaused) {
           return;
         }
-        if (pCurObj->IsImage() && render_status_->GetRenderOptions()
-                                      .GetOptions()
-                                      .bLimitedImageCache) {
-          context_->GetPageCache()->CacheOptimization(
-              render_status_->GetRenderOptions().GetCacheSizeLimit());
+        ++next_object_in_clip_;
+        if (step == Step::kYield) {
+          return;
         }
-        if (pCurObj->IsForm() || pCurObj->IsShading()) {
-          nObjsToGo = 0;
-        } else {
-          --nObjsToGo;
+        if (is_mask && next_object_in_clip_ < objects_in_clip_->size()) {
+          return;
         }
       }
-      last_object_rendered_ = iter;
-      if (nObjsToGo == 0) {
-        if (pPause && pPause->NeedToPauseNow()) {
+    } else {
+      CPDF_PageObjectHolder::const_iterator iter;
+      CPDF_PageObjectHolder::const_iterator iterEnd =
+          current_layer_->GetObjectHolder()->end();
+      if (last_object_rendered_ != iterEnd) {
+        iter = last_object_rendered_;
+        ++iter;
+      } else {
+        iter = current_layer_->GetObjectHolder()->begin();
+      }
+      while (iter != iterEnd) {
+        const Step step =
+            RenderObject(iter->get(), pPause, &nObjsToGo, &is_mask);
+        if (step == Step::kPaused) {
+          return;
+        }
+        last_object_rendered_ = iter;
+        if (step == Step::kYield) {
+          return;
+        }
+        ++iter;
+        if (is_mask && iter != iterEnd) {
           return;
         }
-        nObjsToGo = kStepLimit;
-      }
-      ++iter;
-      if (is_mask && iter != iterEnd) {
-        return;
       }
     }
     if (current_layer_->GetObjectHolder()->GetParseState() ==
@@ -140,3 +137,47 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
     }
   }
 }
+
+CPDF_ProgressiveRenderer::Step CPDF_ProgressiveRenderer::RenderObject(
+    CPDF_PageObject* pCurObj,
+    PauseIndicatorIface* pPause,
+    int* nObjsToGo,
+    bool* is_mask) {
+  if (pCurObj->IsActive() && pCurObj->GetRect().left <= clip_rect_.right &&
+      pCurObj->GetRect().right >= clip_rect_.left &&
+      pCurObj->GetRect().bottom <= clip_rect_.top &&
+      pCurObj->GetRect().top >= clip_rect_.bottom) {
+    if (options_->GetOptions().bBreakForMasks && pCurObj->IsImage() &&
+        pCurObj->AsImage()->GetImage()->IsMask()) {
+#if BUILDFLAG(IS_WIN)
+      if (device_->GetDeviceType() == DeviceType::kPrinter) {
+        render_status_->ProcessClipPath(pCurObj->clip_path(),
+                                        current_layer_->GetMatrix());
+        return Step::kYield;
+      }
+#endif
+      *is_mask = true;
+    }
+    if (render_status_->ContinueSingleObject(
+            pCurObj, current_layer_->GetMatrix(), pPause)) {
+      return Step::kPaused;
+    }
+    if (pCurObj->IsImage() &&
+        render_status_->GetRenderOptions().GetOptions().bLimitedImageCache) {
+      context_->GetPageCache()->CacheOptimization(
+          render_status_->GetRenderOptions().GetCacheSizeLimit());
+    }
+    if (pCurObj->IsForm() || pCurObj->IsShading()) {
+      *nObjsToGo = 0;
+    } else {
+      --*nObjsToGo;
+    }
+  }
+  if (*nObjsToGo == 0) {
+    if (pPause && pPause->NeedToPauseNow()) {
+      return Step::kYield;
+    }
+    *nObjsToGo = kStepLimit;
+  }
+  return Step::kNext;
+}
@@ -7,15 +7,19 @@
 #ifndef CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
 #define CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "core/fpdfapi/page/cpdf_pageobjectholder.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/unowned_ptr.h"
 
+class CPDF_PageObject;
 class CPDF_RenderOptions;
 class CPDF_RenderStatus;
 class CFX_RenderDevice;
@@ -46,6 +50,17 @@ class CPDF_ProgressiveRenderer {
   // Maximum page objects to render before checking for pause.
   static constexpr int kStepLimit = 100;
 
+  enum class Step {
+    kNext,    // Object done, go on to the next one.
+    kYield,   // Object done, return from Continue().
+    kPaused,  // Object not done yet, return from Continue().
+  };
+
+  Step RenderObject(CPDF_PageObject* pCurObj,
+                    PauseIndicatorIface* pPause,
+                    int* nObjsToGo,
+                    bool* is_mask);
+
   Status status_ = kReady;
   UnownedPtr<CPDF_RenderContext> const context_;
   UnownedPtr<CFX_RenderDevice> const device_;
@@ -55,6 +70,10 @@ class CPDF_ProgressiveRenderer {
   uint32_t layer_index_ = 0;
   UnownedPtr<CPDF_RenderContext::Layer> current_layer_;
   CPDF_PageObjectHolder::const_iterator last_object_rendered_;
+  // Set instead of using `last_object_rendered_` when the current layer was
+  // fully parsed before rendering started.
+  std::optional<std::vector<CPDF_PageObject*>> objects_in_clip_;
+  size_t next_object_in_clip_ = 0;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
@@ -7,6 +7,7 @@
 #ifndef CORE_FPDFAPI_RENDER_CPDF_RENDERCONTEXT_H_
 #define CORE_FPDFAPI_RENDER_CPDF_RENDERCONTEXT_H_
 
+#include <mutex>
 #include <vector>
 
 #include "build/build_config.h"
@@ -75,10 +76,17 @@ class CPDF_RenderContext {
   }
   CPDF_PageImageCache* GetPageCache() const { return page_cache_; }
 
+  // Set when several contexts render the same page concurrently. Objects
+  // that may populate lazily loaded document or page state are then
+  // rendered one at a time while holding `lock`.
+  void SetSharedStateLock(std::mutex* lock) { shared_state_lock_ = lock; }
+  std::mutex* GetSharedStateLock() const { return shared_state_lock_; }
+
  private:
   UnownedPtr<CPDF_Document> const document_;
   RetainPtr<CPDF_Dictionary> const page_resources_;
   UnownedPtr<CPDF_PageImageCache> const page_cache_;
+  UnownedPtr<std::mutex> shared_state_lock_;
   std::vector<Layer> layers_;
 };
 
@@ -62,6 +62,58 @@ uint32_t GetValidatedOutputsCount(
   return funcs_outputs ? std::max(funcs_outputs, pCS->ComponentCount()) : 0;
 }
 
+// Calls each function in `funcs` for all the sets of `input_count` values in
+// `inputs` at once. Returns the results of each function, one set after
+// another, or an empty vector for functions that fail for any set.
+std::vector<std::vector<float>> CallFunctionsBatch(
+    const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
+    pdfium::span<const float> inputs,
+    uint32_t input_count) {
+  std::vector<std::vector<float>> batch_results(funcs.size());
+  const size_t count = inputs.size() / input_count;
+  for (size_t i = 0; i < funcs.size(); ++i) {
+    const auto& func = funcs[i];
+    if (!func || func->InputCount() != input_count) {
+      continue;
+    }
+    std::vector<float>& results = batch_results[i];
+    results.resize(count * func->OutputCount());
+    if (!func->CallBatch(inputs, results).has_value()) {
+      results.clear();
+    }
+  }
+  return batch_results;
+}
+
+// Writes the results of all `funcs` for set `index` of the inputs passed to
+// CallFunctionsBatch() to `results`, the same as calling each function in turn
+// with `input`. Functions without batch results get called here.
+void GetFunctionResults(
+    const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
+    const std::vector<std::vector<float>>& batch_results,
+    size_t index,
+    pdfium::span<const float> input,
+    pdfium::span<float> results) {
+  for (size_t i = 0; i < funcs.size(); ++i) {
+    const auto& func = funcs[i];
+    if (!func) {
+      continue;
+    }
+    std::optional<uint32_t> nresults;
+    if (batch_results[i].empty()) {
+      nresults = func->Call(input, results);
+    } else {
+      const uint32_t count = func->OutputCount();
+      fxcrt::Copy(pdfium::span(batch_results[i]).subspan(index * count, count),
+                  results);
+      nresults = count;
+    }
+    if (nresults.has_value()) {
+      results = results.subspan(nresults.value());
+    }
+  }
+}
+
 bool GetShadingSteps(float t_min,
                      float t_max,
                      const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
@@ -76,21 +128,17 @@ bool GetShadingSteps(float t_min,
   CHECK_GE(results_count, CountOutputsFromFunctions(funcs));
   CHECK_GE(results_count, pCS->ComponentCount());
   std::array<FX_ARGB, kShadingSteps>& shading_steps = *output;
-  std::vector<float> result_array(results_count);
+  std::array<float, kShadingSteps> inputs;
   float diff = t_max - t_min;
   for (int i = 0; i < kShadingSteps; ++i) {
-    float input = diff * i / kShadingSteps + t_min;
-    pdfium::span<float> result_span = pdfium::span(result_array);
-    for (const auto& func : funcs) {
-      if (!func) {
-        continue;
-      }
-      std::optional<uint32_t> nresults =
-          func->Call(pdfium::span_from_ref(input), result_span);
-      if (nresults.has_value()) {
-        result_span = result_span.subspan(nresults.value());
-      }
-    }
+    inputs[i] = diff * i / kShadingSteps + t_min;
+  }
+  const std::vector<std::vector<float>> batch_results =
+      CallFunctionsBatch(funcs, inputs, 1);
+  std::vector<float> result_array(results_count);
+  for (int i = 0; i < kShadingSteps; ++i) {
+    GetFunctionResults(funcs, batch_results, i,
+                       pdfium::span_from_ref(inputs[i]), result_array);
     auto rgb = pCS->GetRGBOrZerosOnError(result_array);
     shading_steps[i] =
         ArgbEncode(alpha, FXSYS_roundf(rgb.red * 255),
@@ -307,30 +355,35 @@ void DrawFuncShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
   CHECK_GE(total_results, CountOutputsFromFunctions(funcs));
   CHECK_GE(total_results, pCS->ComponentCount());
   std::vector<float> result_array(total_results);
+  std::vector<float> inputs;
+  std::vector<int> columns;
   for (int row = 0; row < height; ++row) {
-    auto dib_buf = pBitmap->GetWritableScanlineAs<uint32_t>(row);
+    // Evaluate the functions for all the pixels of the row at once.
+    inputs.clear();
+    columns.clear();
     for (int column = 0; column < width; column++) {
       CFX_PointF pos = matrix.Transform(
           CFX_PointF(static_cast<float>(column), static_cast<float>(row)));
       if (pos.x < xmin || pos.x > xmax || pos.y < ymin || pos.y > ymax) {
         continue;
       }
+      inputs.push_back(pos.x);
+      inputs.push_back(pos.y);
+      columns.push_back(column);
+    }
+    const std::vector<std::vector<float>> batch_results =
+        CallFunctionsBatch(funcs, inputs, 2);
 
-      float input[2] = {pos.x, pos.y};
-      pdfium::span<float> result_span = pdfium::span(result_array);
-      for (const auto& func : funcs) {
-        if (!func) {
-          continue;
-        }
-        std::optional<uint32_t> nresults = func->Call(input, result_span);
-        if (nresults.has_value()) {
-          result_span = result_span.subspan(nresults.value());
-        }
-      }
+    auto dib_buf = pBitmap->GetWritableScanlineAs<uint32_t>(row);
+    for (size_t i = 0; i < columns.size(); ++i) {
+      GetFunctionResults(funcs, batch_results, i,
+                         pdfium::span(inputs).subspan(i * 2, 2u),
+                         result_array);
       auto rgb = pCS->GetRGBOrZerosOnError(result_array);
-      dib_buf[column] = ArgbEncode(alpha, static_cast<int32_t>(rgb.red * 255),
-                                   static_cast<int32_t>(rgb.green * 255),
-                                   static_cast<int32_t>(rgb.blue * 255));
+      dib_buf[columns[i]] =
+          ArgbEncode(alpha, static_cast<int32_t>(rgb.red * 255),
+                     static_cast<int32_t>(rgb.green * 255),
+                     static_cast<int32_t>(rgb.blue * 255));
     }
   }
 }
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <set>
 #include <utility>
@@ -20,6 +21,7 @@
 #include "core/fpdfapi/font/cpdf_font.h"
 #include "core/fpdfapi/font/cpdf_type3char.h"
 #include "core/fpdfapi/font/cpdf_type3font.h"
+#include "core/fpdfapi/page/cpdf_contentmarks.h"
 #include "core/fpdfapi/page/cpdf_docpagedata.h"
 #include "core/fpdfapi/page/cpdf_form.h"
 #include "core/fpdfapi/page/cpdf_formobject.h"
@@ -80,7 +82,36 @@
 namespace {
 
 constexpr int kRenderMaxRecursionDepth = 64;
-int g_CurrentRecursionDepth = 0;
+// Per-thread, so that independent documents may render concurrently.
+thread_local int g_CurrentRecursionDepth = 0;
+
+// Whether `obj` can be rendered while other threads render the same page.
+// Only simple opaque paths qualify. Everything else may lazily load
+// document objects, populate page or document caches, or read back device
+// pixels outside of the caller's clip rect.
+bool CanRenderConcurrently(const CPDF_PageObject* obj) {
+  const CPDF_PathObject* path_obj = obj->AsPath();
+  if (!path_obj || path_obj->GetContentMarks()->CountItems() > 0) {
+    return false;
+  }
+  const CPDF_GeneralState& general_state = path_obj->general_state();
+  if (general_state.GetBlendType() != BlendMode::kNormal ||
+      general_state.GetSoftMask() || general_state.GetTR() ||
+      general_state.GetFillAlpha() != 1.0f ||
+      general_state.GetStrokeAlpha() != 1.0f) {
+    return false;
+  }
+  const CPDF_ClipPath& clip_path = path_obj->clip_path();
+  if (clip_path.HasRef() && clip_path.GetTextCount() > 0) {
+    return false;
+  }
+  const CPDF_ColorState& color_state = path_obj->color_state();
+  if (!color_state.HasRef()) {
+    return true;
+  }
+  return !color_state.GetFillColor()->IsPattern() &&
+         !color_state.GetStrokeColor()->IsPattern();
+}
 
 CFX_FillRenderOptions GetFillOptionsForDrawPathWithBlend(
     const CPDF_RenderOptions::Options& options,
@@ -215,6 +246,21 @@ void CPDF_RenderStatus::RenderObjectList(
     const CFX_Matrix& mtObj2Device) {
   CFX_FloatRect clip_rect = mtObj2Device.GetInverse().TransformRect(
       CFX_FloatRect(device_->GetClipBox()));
+  if (!stop_obj_) {
+    for (CPDF_PageObject* pCurObj :
+         pObjectHolder->GetPageObjectsInRect(clip_rect)) {
+      if (!pCurObj->IsActive()) {
+        continue;
+      }
+      RenderSingleObject(pCurObj, mtObj2Device);
+      if (stopped_) {
+        return;
+      }
+    }
+    return;
+  }
+
+  // Rendering stops at `stop_obj_`, even if it is outside `clip_rect`.
   for (const auto& pCurObj : *pObjectHolder) {
     if (pCurObj.get() == stop_obj_) {
       stopped_ = true;
@@ -243,6 +289,12 @@ void CPDF_RenderStatus::RenderSingleObject(CPDF_PageObject* pObj,
   if (++g_CurrentRecursionDepth > kRenderMaxRecursionDepth) {
     return;
   }
+  // Nested objects are covered by the lock taken for their top-level object.
+  std::unique_lock<std::mutex> shared_state_lock;
+  std::mutex* lock = context_->GetSharedStateLock();
+  if (lock && g_CurrentRecursionDepth == 1 && !CanRenderConcurrently(pObj)) {
+    shared_state_lock = std::unique_lock<std::mutex>(*lock);
+  }
   cur_obj_ = pObj;
   if (!options_.CheckPageObjectVisible(pObj)) {
     return;
@@ -76,7 +76,11 @@ int DetectLastScan(const RetainPtr<CFX_DIBitmap>& bitmap) {
 
 }  // namespace
 
-CPDF_Type3Cache::CPDF_Type3Cache(CPDF_Type3Font* font) : font_(font) {}
+CPDF_Type3Cache::CPDF_Type3Cache(CPDF_Type3Font* font)
+    : font_(font),
+      charge_(CFX_CacheBudget::Get()->CreateCharge(
+          CFX_CacheBudget::CacheType::kType3Glyph,
+          /*client=*/nullptr)) {}
 
 CPDF_Type3Cache::~CPDF_Type3Cache() = default;
 
@@ -98,14 +102,21 @@ const CFX_GlyphBitmap* CPDF_Type3Cache::LoadGlyphBitmap(
   } else {
     pSizeCache = it->second.get();
   }
+  CFX_CacheBudget* budget = CFX_CacheBudget::Get();
   const CFX_GlyphBitmap* pExisting = pSizeCache->GetBitmap(charcode);
   if (pExisting) {
+    budget->RecordHit(CFX_CacheBudget::CacheType::kType3Glyph);
     return pExisting;
   }
 
+  budget->RecordMiss(CFX_CacheBudget::CacheType::kType3Glyph);
   std::unique_ptr<CFX_GlyphBitmap> pNewBitmap =
       RenderGlyph(pSizeCache, charcode, mtMatrix);
   CFX_GlyphBitmap* pGlyphBitmap = pNewBitmap.get();
+  if (pGlyphBitmap) {
+    charge_.SetSize(charge_.size() + sizeof(CFX_GlyphBitmap) +
+                    pGlyphBitmap->GetBitmap()->GetEstimatedImageMemoryBurden());
+  }
   pSizeCache->SetBitmap(charcode, std::move(pNewBitmap));
   return pGlyphBitmap;
 }
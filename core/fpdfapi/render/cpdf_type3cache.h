@@ -14,6 +14,7 @@
 #include <tuple>
 
 #include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/cfx_cachebudget.h"
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
 
@@ -41,6 +42,9 @@ class CPDF_Type3Cache final : public Retainable, public Observable {
 
   RetainPtr<CPDF_Type3Font> const font_;
   std::map<SizeKey, std::unique_ptr<CPDF_Type3GlyphMap>> size_map_;
+  // The cache only lives while a text object is rendered, during which its
+  // glyphs are in use, so it is charged as a whole and never evicted.
+  CFX_CacheBudget::Charge charge_;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_TYPE3CACHE_H_
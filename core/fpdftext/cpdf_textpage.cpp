@@ -20,6 +20,7 @@
 #include "core/fpdfapi/page/cpdf_formobject.h"
 #include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
 #include "core/fpdfapi/page/cpdf_textobject.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
@@ -368,6 +369,18 @@ CPDF_TextPage::CharInfo::CharInfo(const CharInfo&) = default;
 
 CPDF_TextPage::CharInfo::~CharInfo() = default;
 
+struct CPDF_TextPage::CharIndex {
+  CharIndex(std::vector<CFX_FloatRect> char_boxes,
+            std::vector<uint32_t> non_space)
+      : boxes(std::move(char_boxes)), non_space_counts(std::move(non_space)) {}
+
+  // Indices match those of `char_list_`.
+  const CPDF_PageObjectIndex boxes;
+
+  // Number of non-space characters before each index, plus the total.
+  const std::vector<uint32_t> non_space_counts;
+};
+
 CPDF_TextPage::CPDF_TextPage(const CPDF_Page* page, bool rtl)
     : page_(page), rtl_(rtl), display_matrix_(page_->GetDisplayMatrix()) {
   Init();
@@ -482,22 +495,29 @@ std::vector<CFX_FloatRect> CPDF_TextPage::GetRectArray(int start,
 
 int CPDF_TextPage::GetIndexAtPos(const CFX_PointF& point,
                                  const CFX_SizeF& tolerance) const {
-  int pos;
-  int near_pos = -1;
-  double xdif = 5000;
-  double ydif = 5000;
-  const int count = CountChars();
-  for (pos = 0; pos < count; ++pos) {
-    const CFX_FloatRect& orig_charrect = char_list_[pos].char_box();
-    if (orig_charrect.Contains(point)) {
-      break;
+  const CharIndex& char_index = GetCharIndex();
+  for (uint32_t pos : char_index.boxes.Query(
+           CFX_FloatRect(point.x, point.y, point.x, point.y))) {
+    if (char_list_[pos].char_box().Contains(point)) {
+      return static_cast<int>(pos);
     }
+  }
 
-    if (tolerance.width <= 0 && tolerance.height <= 0) {
-      continue;
-    }
+  if (tolerance.width <= 0 && tolerance.height <= 0) {
+    return -1;
+  }
 
-    CFX_FloatRect charrect = orig_charrect;
+  // Pad the query a little, so rounding cannot drop a candidate that the
+  // exact test below would accept.
+  const float half_width = fabsf(tolerance.width) / 2 + 1;
+  const float half_height = fabsf(tolerance.height) / 2 + 1;
+  int near_pos = -1;
+  double xdif = 5000;
+  double ydif = 5000;
+  for (uint32_t pos : char_index.boxes.Query(
+           CFX_FloatRect(point.x - half_width, point.y - half_height,
+                         point.x + half_width, point.y + half_height))) {
+    CFX_FloatRect charrect = char_list_[pos].char_box();
     charrect.Normalize();
     CFX_FloatRect char_rect_ext(charrect.left - tolerance.width / 2,
                                 charrect.bottom - tolerance.height / 2,
@@ -514,10 +534,10 @@ int CPDF_TextPage::GetIndexAtPos(const CFX_PointF& point,
     if (current_ydiff + current_xdiff < xdif + ydif) {
       xdif = current_xdiff;
       ydif = current_ydiff;
-      near_pos = pos;
+      near_pos = static_cast<int>(pos);
     }
   }
-  return pos < count ? pos : near_pos;
+  return near_pos;
 }
 
 WideString CPDF_TextPage::GetTextByPredicate(
@@ -555,9 +575,61 @@ WideString CPDF_TextPage::GetTextByPredicate(
 }
 
 WideString CPDF_TextPage::GetTextByRect(const CFX_FloatRect& rect) const {
-  return GetTextByPredicate([&rect](const CharInfo& charinfo) {
-    return IsRectIntersect(rect, charinfo.char_box());
-  });
+  const CharIndex& char_index = GetCharIndex();
+  // Like IsRectIntersect(), accept the bounds of `rect` in either order.
+  CFX_FloatRect query_rect = rect;
+  query_rect.Normalize();
+  std::vector<uint32_t> matches;
+  for (uint32_t pos : char_index.boxes.Query(query_rect)) {
+    if (IsRectIntersect(rect, char_list_[pos].char_box())) {
+      matches.push_back(pos);
+    }
+  }
+  if (matches.empty()) {
+    return WideString();
+  }
+
+  // Same as GetTextByPredicate(), but only visits the matching characters.
+  // The characters in between only matter as far as whether they are spaces,
+  // which `non_space_counts` answers for any range.
+  auto has_non_space = [&char_index](size_t begin, size_t end) {
+    return begin < end && char_index.non_space_counts[end] >
+                              char_index.non_space_counts[begin];
+  };
+  float posy = 0;
+  bool IsContainPreChar = false;
+  bool IsAddLineFeed = has_non_space(0, matches[0]);
+  WideString strText;
+  for (size_t i = 0; i < matches.size(); ++i) {
+    if (i > 0 && matches[i] != matches[i - 1] + 1) {
+      const size_t next = matches[i - 1] + 1;
+      if (char_list_[next].unicode() == L' ') {
+        strText += L' ';
+        IsAddLineFeed = has_non_space(next + 1, matches[i]);
+      } else {
+        IsAddLineFeed = true;
+      }
+      IsContainPreChar = false;
+    }
+    const CharInfo& charinfo = char_list_[matches[i]];
+    if (fabs(posy - charinfo.origin().y) > 0 && !IsContainPreChar &&
+        IsAddLineFeed) {
+      posy = charinfo.origin().y;
+      if (!strText.IsEmpty()) {
+        strText += L"\r\n";
+      }
+    }
+    IsContainPreChar = true;
+    IsAddLineFeed = false;
+    if (charinfo.unicode()) {
+      strText += charinfo.unicode();
+    }
+  }
+  const size_t next = matches.back() + 1;
+  if (next < char_list_.size() && char_list_[next].unicode() == L' ') {
+    strText += L' ';
+  }
+  return strText;
 }
 
 WideString CPDF_TextPage::GetTextByObject(
@@ -567,6 +639,24 @@ WideString CPDF_TextPage::GetTextByObject(
   });
 }
 
+const CPDF_TextPage::CharIndex& CPDF_TextPage::GetCharIndex() const {
+  if (!char_index_) {
+    std::vector<CFX_FloatRect> boxes;
+    boxes.reserve(char_list_.size());
+    std::vector<uint32_t> non_space_counts;
+    non_space_counts.reserve(char_list_.size() + 1);
+    non_space_counts.push_back(0);
+    for (const CharInfo& charinfo : char_list_) {
+      boxes.push_back(charinfo.char_box());
+      non_space_counts.push_back(non_space_counts.back() +
+                                 (charinfo.unicode() != L' ' ? 1 : 0));
+    }
+    char_index_ = std::make_unique<CharIndex>(std::move(boxes),
+                                              std::move(non_space_counts));
+  }
+  return *char_index_;
+}
+
 const CPDF_TextPage::CharInfo& CPDF_TextPage::GetCharInfo(size_t index) const {
   CHECK_LT(index, char_list_.size());
   return char_list_[index];
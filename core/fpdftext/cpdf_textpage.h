@@ -10,6 +10,7 @@
 #include <stdint.h>
 
 #include <functional>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -128,6 +129,9 @@ class CPDF_TextPage {
 
   enum class MarkedContentState { kPass = 0, kDone, kDelay };
 
+  // Spatial index over `char_list_`, for hit-testing.
+  struct CharIndex;
+
   struct TransformedTextObject {
     TransformedTextObject();
     TransformedTextObject(const TransformedTextObject& that);
@@ -188,10 +192,14 @@ class CPDF_TextPage {
   WideString GetTextByPredicate(
       const std::function<bool(const CharInfo&)>& predicate) const;
 
+  // Builds `char_index_` on first use.
+  const CharIndex& GetCharIndex() const;
+
   UnownedPtr<const CPDF_Page> const page_;
   DataVector<TextPageCharSegment> char_indices_;
   std::vector<CharInfo> char_list_;
   std::vector<CharInfo> temp_char_list_;
+  mutable std::unique_ptr<CharIndex> char_index_;
   WideTextBuffer text_buf_;
   WideTextBuffer temp_text_buf_;
   UnownedPtr<const CPDF_TextObject> prev_text_obj_;
@@ -0,0 +1,187 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/binning_decoder.h"
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+#include <utility>
+
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/check_op.h"
+#include "core/fxge/calculate_pitch.h"
+
+namespace fxcodec {
+
+// static
+bool RowBinner::IsSupportedFormat(int comps, int bpc) {
+  return (bpc == 1 && comps == 1) || (bpc == 8 && comps >= 1 && comps <= 4);
+}
+
+// static
+int RowBinner::GetBinnedSize(int size, int shift) {
+  return static_cast<int>(
+      (static_cast<int64_t>(size) + (int64_t{1} << shift) - 1) >> shift);
+}
+
+RowBinner::RowBinner(int src_width, int comps, int bpc, int shift)
+    : src_width_(src_width),
+      comps_(comps),
+      bpc_(bpc),
+      shift_(shift),
+      dest_width_(GetBinnedSize(src_width, shift)),
+      sums_(static_cast<size_t>(dest_width_) * comps) {
+  CHECK(IsSupportedFormat(comps, bpc));
+  CHECK(shift >= 1 && shift <= 3);
+  CHECK_GT(src_width, 0);
+}
+
+RowBinner::~RowBinner() = default;
+
+void RowBinner::AddRow(pdfium::span<const uint8_t> row) {
+  if (bpc_ == 1) {
+    AddRow1bpp(row);
+  } else {
+    AddRow8bpc(row);
+  }
+  ++rows_;
+}
+
+void RowBinner::AddRow1bpp(pdfium::span<const uint8_t> row) {
+  // A box is 2, 4 or 8 bits wide, so each byte holds whole boxes. Count the
+  // set bits of each box at once.
+  const int box_width = 1 << shift_;
+  const int boxes_per_byte = 8 >> shift_;
+  const uint32_t box_mask = (1u << box_width) - 1;
+  const size_t row_bytes = static_cast<size_t>(src_width_ + 7) / 8;
+  const size_t byte_count = std::min(row.size(), row_bytes);
+  for (size_t i = 0; i < byte_count; ++i) {
+    uint32_t byte = row[i];
+    if (i == row_bytes - 1 && src_width_ % 8) {
+      // Ignore the padding bits past the end of the row.
+      byte &= 0xFFu << (8 - src_width_ % 8);
+    }
+    if (!byte) {
+      continue;
+    }
+    for (int k = 0; k < boxes_per_byte; ++k) {
+      const size_t col = i * boxes_per_byte + k;
+      if (col >= sums_.size()) {
+        break;
+      }
+      sums_[col] += std::popcount((byte >> (8 - box_width * (k + 1))) &
+                                  box_mask);
+    }
+  }
+}
+
+void RowBinner::AddRow8bpc(pdfium::span<const uint8_t> row) {
+  const size_t width = std::min(static_cast<size_t>(src_width_),
+                                row.size() / static_cast<size_t>(comps_));
+  for (size_t col = 0; col < width; ++col) {
+    const size_t dest_offset = (col >> shift_) * comps_;
+    for (int k = 0; k < comps_; ++k) {
+      sums_[dest_offset + k] += row[col * comps_ + k];
+    }
+  }
+}
+
+bool RowBinner::TakeRow(pdfium::span<uint8_t> dest) {
+  if (rows_ == 0) {
+    return false;
+  }
+
+  const int box_width = 1 << shift_;
+  const uint32_t max_value = bpc_ == 1 ? 255 : 1;
+  for (int col = 0; col < dest_width_; ++col) {
+    const uint32_t pixels =
+        std::min(box_width, src_width_ - col * box_width) * rows_;
+    for (int k = 0; k < comps_; ++k) {
+      const size_t index = static_cast<size_t>(col) * comps_ + k;
+      dest[index] = static_cast<uint8_t>(
+          (sums_[index] * max_value + pixels / 2) / pixels);
+    }
+  }
+  std::ranges::fill(sums_, 0);
+  rows_ = 0;
+  return true;
+}
+
+// static
+std::unique_ptr<ScanlineDecoder> BinningDecoder::Create(
+    std::unique_ptr<ScanlineDecoder> source,
+    int shift) {
+  if (!source || shift < 1 || shift > 3 || source->GetWidth() <= 0 ||
+      source->GetHeight() <= 0 ||
+      !RowBinner::IsSupportedFormat(source->CountComps(), source->GetBPC())) {
+    return nullptr;
+  }
+
+  const std::optional<uint32_t> pitch = fxge::CalculatePitch8(
+      8, source->CountComps(),
+      RowBinner::GetBinnedSize(source->GetWidth(), shift));
+  if (!pitch.has_value()) {
+    return nullptr;
+  }
+
+  return std::unique_ptr<ScanlineDecoder>(
+      new BinningDecoder(std::move(source), shift, pitch.value()));
+}
+
+BinningDecoder::BinningDecoder(std::unique_ptr<ScanlineDecoder> source,
+                               int shift,
+                               uint32_t pitch)
+    : ScanlineDecoder(source->GetWidth(),
+                      source->GetHeight(),
+                      RowBinner::GetBinnedSize(source->GetWidth(), shift),
+                      RowBinner::GetBinnedSize(source->GetHeight(), shift),
+                      source->CountComps(),
+                      8,
+                      pitch),
+      source_(std::move(source)),
+      shift_(shift),
+      binner_(source_->GetWidth(),
+              source_->CountComps(),
+              source_->GetBPC(),
+              shift),
+      scanline_(pitch) {}
+
+BinningDecoder::~BinningDecoder() {
+  // Span in superclass can't outlive our buffer.
+  last_scanline_ = pdfium::span<uint8_t>();
+}
+
+bool BinningDecoder::Rewind() {
+  next_row_ = 0;
+  return true;
+}
+
+pdfium::span<uint8_t> BinningDecoder::GetNextLine() {
+  if (next_row_ >= output_height_) {
+    return pdfium::span<uint8_t>();
+  }
+
+  // The source rewinds itself if needed. Rows it fails to decode are left
+  // out of the average.
+  const int first_line = next_row_ << shift_;
+  const int end_line = std::min(first_line + (1 << shift_), orig_height_);
+  for (int line = first_line; line < end_line; ++line) {
+    pdfium::span<const uint8_t> row = source_->GetScanline(line);
+    if (!row.empty()) {
+      binner_.AddRow(row);
+    }
+  }
+  ++next_row_;
+  if (!binner_.TakeRow(scanline_)) {
+    return pdfium::span<uint8_t>();
+  }
+  return scanline_;
+}
+
+uint32_t BinningDecoder::GetSrcOffset() {
+  return source_->GetSrcOffset();
+}
+
+}  // namespace fxcodec
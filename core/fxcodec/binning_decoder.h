@@ -0,0 +1,86 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCODEC_BINNING_DECODER_H_
+#define CORE_FXCODEC_BINNING_DECODER_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/fxcodec/scanlinedecoder.h"
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/span.h"
+
+namespace fxcodec {
+
+// Box-filters rows of samples down by 2^shift in each direction. Takes either
+// 8 bits per component, or 1 bit per pixel, and always produces 8 bits per
+// component. For 1 bpp input, each output sample is the share of set bits in
+// its box, scaled to 0-255. Boxes at the right and bottom edges average over
+// the pixels that exist.
+class RowBinner {
+ public:
+  static bool IsSupportedFormat(int comps, int bpc);
+  static int GetBinnedSize(int size, int shift);
+
+  // `IsSupportedFormat(comps, bpc)` must be true, and `shift` must be 1 to 3.
+  RowBinner(int src_width, int comps, int bpc, int shift);
+  ~RowBinner();
+
+  // Adds one source row to the output row being built.
+  void AddRow(pdfium::span<const uint8_t> row);
+
+  // Writes the output row averaged from the rows added since the last call
+  // to `dest`, and starts the next one. Returns false if no rows were added.
+  bool TakeRow(pdfium::span<uint8_t> dest);
+
+ private:
+  void AddRow1bpp(pdfium::span<const uint8_t> row);
+  void AddRow8bpc(pdfium::span<const uint8_t> row);
+
+  const int src_width_;
+  const int comps_;
+  const int bpc_;
+  const int shift_;
+  const int dest_width_;
+  int rows_ = 0;
+  std::vector<uint32_t> sums_;
+};
+
+// Decodes `source` at 1 / 2^shift of its size in each direction, reading each
+// source row once and keeping only one output row in memory.
+class BinningDecoder final : public ScanlineDecoder {
+ public:
+  // Returns nullptr if RowBinner does not support the format of `source`.
+  static std::unique_ptr<ScanlineDecoder> Create(
+      std::unique_ptr<ScanlineDecoder> source,
+      int shift);
+
+  ~BinningDecoder() override;
+
+  // ScanlineDecoder:
+  [[nodiscard]] bool Rewind() override;
+  pdfium::span<uint8_t> GetNextLine() override;
+  uint32_t GetSrcOffset() override;
+
+ private:
+  BinningDecoder(std::unique_ptr<ScanlineDecoder> source,
+                 int shift,
+                 uint32_t pitch);
+
+  std::unique_ptr<ScanlineDecoder> const source_;
+  const int shift_;
+  RowBinner binner_;
+  int next_row_ = 0;
+  DataVector<uint8_t> scanline_;
+};
+
+}  // namespace fxcodec
+
+using BinningDecoder = fxcodec::BinningDecoder;
+using RowBinner = fxcodec::RowBinner;
+
+#endif  // CORE_FXCODEC_BINNING_DECODER_H_
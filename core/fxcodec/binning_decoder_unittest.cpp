@@ -0,0 +1,114 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/binning_decoder.h"
+
+#include <stdint.h>
+
+#include <iterator>
+#include <memory>
+
+#include "core/fxcodec/basic/basicmodule.h"
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/span.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using ::testing::ElementsAre;
+
+TEST(RowBinner, BinnedSize) {
+  EXPECT_EQ(1, RowBinner::GetBinnedSize(1, 3));
+  EXPECT_EQ(1, RowBinner::GetBinnedSize(8, 3));
+  EXPECT_EQ(2, RowBinner::GetBinnedSize(9, 3));
+  EXPECT_EQ(3, RowBinner::GetBinnedSize(5, 1));
+  EXPECT_EQ(268435456, RowBinner::GetBinnedSize(2147483647, 3));
+}
+
+TEST(RowBinner, OneBitPerPixel) {
+  // 11 pixels wide: 1011 0011 111, then padding bits that must be ignored.
+  const uint8_t row1[] = {0b10110011, 0b11111111};
+  const uint8_t row2[] = {0b00000000, 0b00011111};
+  {
+    RowBinner binner(11, 1, 1, 1);
+    binner.AddRow(row1);
+    binner.AddRow(row2);
+    uint8_t dest[6];
+    ASSERT_TRUE(binner.TakeRow(dest));
+    // Boxes of 2x2, and 1x2 at the right edge.
+    EXPECT_THAT(dest, ElementsAre(64, 128, 0, 128, 128, 128));
+  }
+  {
+    RowBinner binner(11, 1, 1, 2);
+    binner.AddRow(row1);
+    uint8_t dest[3];
+    ASSERT_TRUE(binner.TakeRow(dest));
+    EXPECT_THAT(dest, ElementsAre(191, 128, 255));
+    EXPECT_FALSE(binner.TakeRow(dest));
+  }
+  {
+    RowBinner binner(11, 1, 1, 3);
+    binner.AddRow(row1);
+    binner.AddRow(row2);
+    binner.AddRow(row2);
+    uint8_t dest[2];
+    ASSERT_TRUE(binner.TakeRow(dest));
+    EXPECT_THAT(dest, ElementsAre(53, 85));
+  }
+}
+
+TEST(RowBinner, EightBitsPerComponent) {
+  // 3 RGB pixels wide.
+  const uint8_t row1[] = {10, 20, 30, 40, 50, 60, 255, 0, 7};
+  const uint8_t row2[] = {30, 40, 50, 61, 70, 80, 255, 2, 8};
+  RowBinner binner(3, 3, 8, 1);
+  binner.AddRow(row1);
+  binner.AddRow(row2);
+  uint8_t dest[6];
+  ASSERT_TRUE(binner.TakeRow(dest));
+  EXPECT_THAT(dest, ElementsAre(35, 45, 55, 255, 1, 8));
+
+  // The sums start over for the next row.
+  binner.AddRow(row1);
+  ASSERT_TRUE(binner.TakeRow(dest));
+  EXPECT_THAT(dest, ElementsAre(25, 35, 45, 255, 0, 7));
+}
+
+TEST(BinningDecoder, Unsupported) {
+  const uint8_t data[] = {0x01, 0x00, 0x00, 0x80};
+  EXPECT_FALSE(BinningDecoder::Create(
+      BasicModule::CreateRunLengthDecoder(data, 2, 1, 1, 4), 1));
+  EXPECT_FALSE(BinningDecoder::Create(
+      BasicModule::CreateRunLengthDecoder(data, 2, 1, 1, 8), 0));
+  EXPECT_FALSE(BinningDecoder::Create(
+      BasicModule::CreateRunLengthDecoder(data, 2, 1, 1, 8), 4));
+}
+
+TEST(BinningDecoder, RunLength) {
+  // A 5x5 gray image, run-length encoded as one literal run per row.
+  const uint8_t kRows[5][5] = {{0, 10, 20, 30, 40},
+                               {50, 60, 70, 80, 90},
+                               {100, 110, 120, 130, 140},
+                               {150, 160, 170, 180, 190},
+                               {200, 210, 220, 230, 240}};
+  DataVector<uint8_t> data;
+  for (const auto& row : kRows) {
+    data.push_back(4);
+    data.insert(data.end(), std::begin(row), std::end(row));
+  }
+  data.push_back(128);
+
+  std::unique_ptr<ScanlineDecoder> decoder = BinningDecoder::Create(
+      BasicModule::CreateRunLengthDecoder(data, 5, 5, 1, 8), 1);
+  ASSERT_TRUE(decoder);
+  EXPECT_EQ(3, decoder->GetWidth());
+  EXPECT_EQ(3, decoder->GetHeight());
+  EXPECT_EQ(8, decoder->GetBPC());
+  EXPECT_EQ(1, decoder->CountComps());
+  EXPECT_THAT(decoder->GetScanline(0).first(3u), ElementsAre(30, 50, 65));
+  EXPECT_THAT(decoder->GetScanline(1).first(3u), ElementsAre(130, 150, 165));
+  EXPECT_THAT(decoder->GetScanline(2).first(3u), ElementsAre(205, 225, 240));
+
+  // Going back rewinds the source.
+  EXPECT_THAT(decoder->GetScanline(1).first(3u), ElementsAre(130, 150, 165));
+}
@@ -0,0 +1,174 @@
+// Copyright 2014 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Original code copyright 2014 Foxit Software Inc. http://www.foxitsoftware.com
+
+#include "core/fxcodec/flate/flate_predictor.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include "core/fxcrt/numerics/safe_conversions.h"
+#include "core/fxcrt/stl_util.h"
+
+#if defined(PDF_USE_HIGHWAY)
+#include "core/fxcodec/flate/flate_predictor_simd.h"
+#endif
+
+namespace fxcodec {
+
+namespace {
+
+uint8_t GetLeftValue(pdfium::span<const uint8_t> span,
+                     size_t i,
+                     uint32_t bytes_per_pixel) {
+  return i >= bytes_per_pixel ? span[i - bytes_per_pixel] : 0;
+}
+
+uint8_t GetUpValue(pdfium::span<const uint8_t> span, size_t i) {
+  return span.empty() ? 0 : span[i];
+}
+
+uint8_t GetUpperLeftValue(pdfium::span<const uint8_t> span,
+                          size_t i,
+                          uint32_t bytes_per_pixel) {
+  if (i >= bytes_per_pixel && !span.empty()) {
+    return span[i - bytes_per_pixel];
+  }
+  return 0;
+}
+
+uint8_t PathPredictor(uint8_t a, uint8_t b, uint8_t c) {
+  int p = static_cast<int>(a) + b - c;
+  int pa = abs(p - a);
+  int pb = abs(p - b);
+  int pc = abs(p - c);
+  if (pa <= pb && pa <= pc) {
+    return a;
+  }
+  return pb <= pc ? b : c;
+}
+
+}  // namespace
+
+void PNG_PredictLine(pdfium::span<uint8_t> dest_span,
+                     pdfium::span<const uint8_t> src_span,
+                     pdfium::span<const uint8_t> last_span,
+                     size_t row_size,
+                     uint32_t bytes_per_pixel) {
+#if defined(PDF_USE_HIGHWAY)
+  pdfium::span<const uint8_t> row_src_span = src_span.subspan(1u, row_size);
+  if (PNG_PredictLineSimd(
+          src_span.front(), dest_span.first(row_size), row_src_span,
+          last_span.empty() ? last_span : last_span.first(row_size),
+          bytes_per_pixel)) {
+    return;
+  }
+#endif
+  PNG_PredictLineScalar(dest_span, src_span, last_span, row_size,
+                        bytes_per_pixel);
+}
+
+void TIFF_PredictLine(pdfium::span<uint8_t> dest_span,
+                      int BitsPerComponent,
+                      int Colors,
+                      int Columns) {
+#if defined(PDF_USE_HIGHWAY)
+  if (BitsPerComponent == 8 &&
+      TIFF_PredictLineSimd(dest_span, static_cast<uint32_t>(Colors))) {
+    return;
+  }
+#endif
+  TIFF_PredictLineScalar(dest_span, BitsPerComponent, Colors, Columns);
+}
+
+void PNG_PredictLineScalar(pdfium::span<uint8_t> dest_span,
+                           pdfium::span<const uint8_t> src_span,
+                           pdfium::span<const uint8_t> last_span,
+                           size_t row_size,
+                           uint32_t bytes_per_pixel) {
+  const uint8_t tag = src_span.front();
+  pdfium::span<const uint8_t> remaining_src_span =
+      src_span.subspan(1u, row_size);
+  switch (tag) {
+    case 1: {
+      for (size_t i = 0; i < remaining_src_span.size(); ++i) {
+        uint8_t left = GetLeftValue(dest_span, i, bytes_per_pixel);
+        dest_span[i] = remaining_src_span[i] + left;
+      }
+      break;
+    }
+    case 2: {
+      for (size_t i = 0; i < remaining_src_span.size(); ++i) {
+        uint8_t up = GetUpValue(last_span, i);
+        dest_span[i] = remaining_src_span[i] + up;
+      }
+      break;
+    }
+    case 3: {
+      for (size_t i = 0; i < remaining_src_span.size(); ++i) {
+        uint8_t left = GetLeftValue(dest_span, i, bytes_per_pixel);
+        uint8_t up = GetUpValue(last_span, i);
+        dest_span[i] = remaining_src_span[i] + (up + left) / 2;
+      }
+      break;
+    }
+    case 4: {
+      for (size_t i = 0; i < remaining_src_span.size(); ++i) {
+        uint8_t left = GetLeftValue(dest_span, i, bytes_per_pixel);
+        uint8_t up = GetUpValue(last_span, i);
+        uint8_t upper_left = GetUpperLeftValue(last_span, i, bytes_per_pixel);
+        dest_span[i] =
+            remaining_src_span[i] + PathPredictor(left, up, upper_left);
+      }
+      break;
+    }
+    default: {
+      fxcrt::Copy(remaining_src_span, dest_span);
+      break;
+    }
+  }
+}
+
+void TIFF_PredictLineScalar(pdfium::span<uint8_t> dest_span,
+                            int BitsPerComponent,
+                            int Colors,
+                            int Columns) {
+  if (BitsPerComponent == 1) {
+    int row_bits = std::min(BitsPerComponent * Colors * Columns,
+                            pdfium::checked_cast<int>(dest_span.size() * 8));
+    int index_pre = 0;
+    int col_pre = 0;
+    for (int i = 1; i < row_bits; i++) {
+      int col = i % 8;
+      int index = i / 8;
+      if (((dest_span[index] >> (7 - col)) & 1) ^
+          ((dest_span[index_pre] >> (7 - col_pre)) & 1)) {
+        dest_span[index] |= 1 << (7 - col);
+      } else {
+        dest_span[index] &= ~(1 << (7 - col));
+      }
+      index_pre = index;
+      col_pre = col;
+    }
+    return;
+  }
+  int BytesPerPixel = BitsPerComponent * Colors / 8;
+  if (BitsPerComponent == 16) {
+    for (size_t i = BytesPerPixel; i + 1 < dest_span.size(); i += 2) {
+      uint16_t pixel = (dest_span[i - BytesPerPixel] << 8) |
+                       dest_span[i - BytesPerPixel + 1];
+      pixel += (dest_span[i] << 8) | dest_span[i + 1];
+      dest_span[i] = pixel >> 8;
+      dest_span[i + 1] = (uint8_t)pixel;
+    }
+  } else {
+    for (size_t i = BytesPerPixel; i < dest_span.size(); i++) {
+      dest_span[i] += dest_span[i - BytesPerPixel];
+    }
+  }
+}
+
+}  // namespace fxcodec
@@ -0,0 +1,46 @@
+// Copyright 2014 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Original code copyright 2014 Foxit Software Inc. http://www.foxitsoftware.com
+
+#ifndef CORE_FXCODEC_FLATE_FLATE_PREDICTOR_H_
+#define CORE_FXCODEC_FLATE_FLATE_PREDICTOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/fxcrt/span.h"
+
+namespace fxcodec {
+
+// Undoes the PNG predictor of one row. `src_span` holds the filter type
+// followed by `row_size` bytes, and `last_span` holds the previous row, or is
+// empty for the first row. Writes `row_size` bytes to `dest_span`.
+void PNG_PredictLine(pdfium::span<uint8_t> dest_span,
+                     pdfium::span<const uint8_t> src_span,
+                     pdfium::span<const uint8_t> last_span,
+                     size_t row_size,
+                     uint32_t bytes_per_pixel);
+
+// Undoes the TIFF predictor of one row, in place.
+void TIFF_PredictLine(pdfium::span<uint8_t> dest_span,
+                      int BitsPerComponent,
+                      int Colors,
+                      int Columns);
+
+// Same as the functions above, but never use SIMD code. For checking the
+// SIMD code against.
+void PNG_PredictLineScalar(pdfium::span<uint8_t> dest_span,
+                           pdfium::span<const uint8_t> src_span,
+                           pdfium::span<const uint8_t> last_span,
+                           size_t row_size,
+                           uint32_t bytes_per_pixel);
+void TIFF_PredictLineScalar(pdfium::span<uint8_t> dest_span,
+                            int BitsPerComponent,
+                            int Colors,
+                            int Columns);
+
+}  // namespace fxcodec
+
+#endif  // CORE_FXCODEC_FLATE_FLATE_PREDICTOR_H_
@@ -0,0 +1,308 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/flate/flate_predictor_simd.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/check_op.h"
+#include "core/fxcrt/compiler_specific.h"
+
+// foreach_target.h includes this file again for each SIMD target that Highway
+// compiles for, each time with a different HWY_NAMESPACE.
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "core/fxcodec/flate/flate_predictor_simd.cpp"
+#include "hwy/foreach_target.h"
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace fxcodec {
+namespace HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+// 16 bytes, so whole-vector byte shifts work the same on all targets.
+using DBlock = hn::FixedTag<uint8_t, 16>;
+using VBlock = hn::Vec<DBlock>;
+constexpr size_t kBlockSize = 16;
+
+// One pixel of up to 4 bytes, widened so that sums do not overflow.
+using DPixel = hn::FixedTag<int16_t, 4>;
+using DPixelBytes = hn::Rebind<uint8_t, DPixel>;
+using VPixel = hn::Vec<DPixel>;
+constexpr size_t kPixelSize = 4;
+
+// In the kernels below, the callers in the HWY_ONCE section check that all
+// spans have `size` bytes.
+
+// Adds each byte of `block` to the bytes `kStride`, `2 * kStride`, ... bytes
+// after it.
+template <size_t kStride>
+HWY_INLINE VBlock PrefixSum(VBlock block) {
+  if constexpr (kStride < kBlockSize) {
+    block = hn::Add(block, hn::ShiftLeftBytes<kStride>(DBlock(), block));
+    return PrefixSum<kStride * 2>(block);
+  } else {
+    return block;
+  }
+}
+
+// The left byte of `dest[i]` is `dest[i - kBpp]`. As each byte depends on
+// the one to its left, compute a block at a time as a prefix sum. `src` and
+// `dest` may be the same.
+template <size_t kBpp>
+void UndoSubFor(const uint8_t* src, uint8_t* dest, size_t size) {
+  const DBlock d;
+  VBlock last = hn::Zero(d);
+  size_t i = 0;
+  // SAFETY: `i + kBlockSize` is at most `size` in the vector loop, and `i` is
+  // less than `size` in the scalar loop.
+  UNSAFE_BUFFERS({
+    for (; i + kBlockSize <= size; i += kBlockSize) {
+      // Add the last pixel of the previous block to the first pixel of this
+      // one, and let the prefix sum carry it to the other pixels.
+      VBlock block = hn::Add(hn::LoadU(d, src + i),
+                             hn::ShiftRightBytes<kBlockSize - kBpp>(d, last));
+      last = PrefixSum<kBpp>(block);
+      hn::StoreU(last, d, dest + i);
+    }
+    for (; i < size; ++i) {
+      dest[i] = src[i] + (i >= kBpp ? dest[i - kBpp] : 0);
+    }
+  });
+}
+
+void UndoSub(const uint8_t* src,
+             uint8_t* dest,
+             size_t size,
+             uint32_t bytes_per_pixel) {
+  switch (bytes_per_pixel) {
+    case 1:
+      UndoSubFor<1>(src, dest, size);
+      break;
+    case 3:
+      UndoSubFor<3>(src, dest, size);
+      break;
+    default:
+      DCHECK_EQ(bytes_per_pixel, 4u);
+      UndoSubFor<4>(src, dest, size);
+      break;
+  }
+}
+
+void UndoUp(const uint8_t* src, const uint8_t* up, uint8_t* dest, size_t size) {
+  const hn::ScalableTag<uint8_t> d;
+  const size_t lanes = hn::Lanes(d);
+  size_t i = 0;
+  // SAFETY: `i + lanes` is at most `size` in the vector loop, and `i` is less
+  // than `size` in the scalar loop.
+  UNSAFE_BUFFERS({
+    for (; i + lanes <= size; i += lanes) {
+      hn::StoreU(hn::Add(hn::LoadU(d, src + i), hn::LoadU(d, up + i)), d,
+                 dest + i);
+    }
+    for (; i < size; ++i) {
+      dest[i] = src[i] + up[i];
+    }
+  });
+}
+
+// The average and Paeth filters depend on the left pixel in a way that a
+// prefix sum cannot express. Instead, compute all bytes of a pixel at once.
+// With 3 bytes per pixel, the fourth byte is wrong, but the next pixel
+// overwrites it.
+HWY_INLINE VPixel LoadPixel(const uint8_t* bytes) {
+  return hn::PromoteTo(DPixel(), hn::LoadU(DPixelBytes(), bytes));
+}
+
+HWY_INLINE void StorePixel(VPixel pixel, uint8_t* bytes) {
+  hn::StoreU(hn::DemoteTo(DPixelBytes(), pixel), DPixelBytes(), bytes);
+}
+
+template <size_t kBpp>
+void UndoAverageFor(const uint8_t* src,
+                    const uint8_t* up,
+                    uint8_t* dest,
+                    size_t size) {
+  const DPixel d;
+  const VPixel byte_mask = hn::Set(d, 0xFF);
+  VPixel left = hn::Zero(d);
+  size_t i = 0;
+  // SAFETY: `i + kPixelSize` is at most `size` in the vector loop, and `i` is
+  // less than `size` in the scalar loop.
+  UNSAFE_BUFFERS({
+    for (; i + kPixelSize <= size; i += kBpp) {
+      const VPixel average =
+          hn::ShiftRight<1>(hn::Add(left, LoadPixel(up + i)));
+      left = hn::And(hn::Add(LoadPixel(src + i), average), byte_mask);
+      StorePixel(left, dest + i);
+    }
+    for (; i < size; ++i) {
+      const uint8_t left_byte = i >= kBpp ? dest[i - kBpp] : 0;
+      dest[i] = src[i] + (left_byte + up[i]) / 2;
+    }
+  });
+}
+
+void UndoAverage(const uint8_t* src,
+                 const uint8_t* up,
+                 uint8_t* dest,
+                 size_t size,
+                 uint32_t bytes_per_pixel) {
+  if (bytes_per_pixel == 3) {
+    UndoAverageFor<3>(src, up, dest, size);
+  } else {
+    DCHECK_EQ(bytes_per_pixel, 4u);
+    UndoAverageFor<4>(src, up, dest, size);
+  }
+}
+
+template <size_t kBpp>
+void UndoPaethFor(const uint8_t* src,
+                  const uint8_t* up,
+                  uint8_t* dest,
+                  size_t size) {
+  const DPixel d;
+  const VPixel byte_mask = hn::Set(d, 0xFF);
+  VPixel left = hn::Zero(d);
+  VPixel upper_left = hn::Zero(d);
+  size_t i = 0;
+  // SAFETY: `i + kPixelSize` is at most `size` in the vector loop, and `i` is
+  // less than `size` in the scalar loop.
+  UNSAFE_BUFFERS({
+    for (; i + kPixelSize <= size; i += kBpp) {
+      const VPixel above = LoadPixel(up + i);
+      // With p = left + above - upper_left, the distances from p to left,
+      // above and upper_left are:
+      const VPixel pa = hn::Abs(hn::Sub(above, upper_left));
+      const VPixel pb = hn::Abs(hn::Sub(left, upper_left));
+      const VPixel pc = hn::Abs(
+          hn::Sub(hn::Add(left, above), hn::Add(upper_left, upper_left)));
+      const VPixel predicted =
+          hn::IfThenElse(hn::And(hn::Le(pa, pb), hn::Le(pa, pc)), left,
+                         hn::IfThenElse(hn::Le(pb, pc), above, upper_left));
+      left = hn::And(hn::Add(LoadPixel(src + i), predicted), byte_mask);
+      upper_left = above;
+      StorePixel(left, dest + i);
+    }
+    for (; i < size; ++i) {
+      const int a = i >= kBpp ? dest[i - kBpp] : 0;
+      const int b = up[i];
+      const int c = i >= kBpp ? up[i - kBpp] : 0;
+      const int pa = abs(b - c);
+      const int pb = abs(a - c);
+      const int pc = abs(a + b - 2 * c);
+      const int predicted = pa <= pb && pa <= pc ? a : (pb <= pc ? b : c);
+      dest[i] = static_cast<uint8_t>(src[i] + predicted);
+    }
+  });
+}
+
+void UndoPaeth(const uint8_t* src,
+               const uint8_t* up,
+               uint8_t* dest,
+               size_t size,
+               uint32_t bytes_per_pixel) {
+  if (bytes_per_pixel == 3) {
+    UndoPaethFor<3>(src, up, dest, size);
+  } else {
+    DCHECK_EQ(bytes_per_pixel, 4u);
+    UndoPaethFor<4>(src, up, dest, size);
+  }
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace fxcodec
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace fxcodec {
+
+HWY_EXPORT(UndoSub);
+HWY_EXPORT(UndoUp);
+HWY_EXPORT(UndoAverage);
+HWY_EXPORT(UndoPaeth);
+
+namespace {
+
+// PNG filter types.
+constexpr uint8_t kFilterSub = 1;
+constexpr uint8_t kFilterUp = 2;
+constexpr uint8_t kFilterAverage = 3;
+constexpr uint8_t kFilterPaeth = 4;
+
+bool IsSupportedBytesPerPixel(uint32_t bytes_per_pixel) {
+  return bytes_per_pixel == 1 || bytes_per_pixel == 3 || bytes_per_pixel == 4;
+}
+
+}  // namespace
+
+bool PNG_PredictLineSimd(uint8_t type,
+                         pdfium::span<uint8_t> dest_span,
+                         pdfium::span<const uint8_t> src_span,
+                         pdfium::span<const uint8_t> last_span,
+                         uint32_t bytes_per_pixel) {
+  if (!IsSupportedBytesPerPixel(bytes_per_pixel)) {
+    return false;
+  }
+  CHECK_EQ(dest_span.size(), src_span.size());
+  CHECK(last_span.empty() || last_span.size() == src_span.size());
+
+  // Each byte of a 1-byte pixel depends on the previous byte in a way that
+  // only the Sub and Up filters can vectorize. The first row of the Up and
+  // average filters has nothing to add, which the scalar code does well.
+  switch (type) {
+    case kFilterSub:
+      HWY_DYNAMIC_DISPATCH(UndoSub)(src_span.data(), dest_span.data(),
+                                    src_span.size(), bytes_per_pixel);
+      return true;
+    case kFilterUp:
+      if (last_span.empty()) {
+        return false;
+      }
+      HWY_DYNAMIC_DISPATCH(UndoUp)(src_span.data(), last_span.data(),
+                                   dest_span.data(), src_span.size());
+      return true;
+    case kFilterAverage:
+      if (last_span.empty() || bytes_per_pixel == 1) {
+        return false;
+      }
+      HWY_DYNAMIC_DISPATCH(UndoAverage)(src_span.data(), last_span.data(),
+                                        dest_span.data(), src_span.size(),
+                                        bytes_per_pixel);
+      return true;
+    case kFilterPaeth:
+      if (bytes_per_pixel == 1) {
+        return false;
+      }
+      // Without a previous row, Paeth always predicts the left byte.
+      if (last_span.empty()) {
+        HWY_DYNAMIC_DISPATCH(UndoSub)(src_span.data(), dest_span.data(),
+                                      src_span.size(), bytes_per_pixel);
+      } else {
+        HWY_DYNAMIC_DISPATCH(UndoPaeth)(src_span.data(), last_span.data(),
+                                        dest_span.data(), src_span.size(),
+                                        bytes_per_pixel);
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool TIFF_PredictLineSimd(pdfium::span<uint8_t> span,
+                          uint32_t bytes_per_pixel) {
+  if (!IsSupportedBytesPerPixel(bytes_per_pixel)) {
+    return false;
+  }
+  // Horizontal differencing is the same as the PNG Sub filter, in place.
+  HWY_DYNAMIC_DISPATCH(UndoSub)(span.data(), span.data(), span.size(),
+                                bytes_per_pixel);
+  return true;
+}
+
+}  // namespace fxcodec
+#endif  // HWY_ONCE
@@ -0,0 +1,33 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCODEC_FLATE_FLATE_PREDICTOR_SIMD_H_
+#define CORE_FXCODEC_FLATE_FLATE_PREDICTOR_SIMD_H_
+
+#include <stdint.h>
+
+#include "core/fxcrt/span.h"
+
+namespace fxcodec {
+
+// Vectorized versions of PNG_PredictLine() and TIFF_PredictLine() for 8-bit
+// samples. They run with the widest instruction set the CPU supports, and
+// return false without writing anything if they do not handle the given row.
+
+// Undoes PNG filter `type` for the bytes in `src_span`, writing the same
+// number of bytes to `dest_span`. `last_span` is either empty for the first
+// row, or holds the previous row with the same number of bytes.
+bool PNG_PredictLineSimd(uint8_t type,
+                         pdfium::span<uint8_t> dest_span,
+                         pdfium::span<const uint8_t> src_span,
+                         pdfium::span<const uint8_t> last_span,
+                         uint32_t bytes_per_pixel);
+
+// Undoes the TIFF horizontal differencing predictor in place.
+bool TIFF_PredictLineSimd(pdfium::span<uint8_t> span,
+                          uint32_t bytes_per_pixel);
+
+}  // namespace fxcodec
+
+#endif  // CORE_FXCODEC_FLATE_FLATE_PREDICTOR_SIMD_H_
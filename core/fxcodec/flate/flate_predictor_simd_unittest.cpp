@@ -0,0 +1,119 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/flate/flate_predictor_simd.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxcodec/flate/flate_predictor.h"
+#include "core/fxcrt/span.h"
+#include "hwy/targets.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// These tests check that PNG_PredictLine() and TIFF_PredictLine(), which use
+// the SIMD code where they can, give the same results as the scalar code.
+
+namespace fxcodec {
+
+namespace {
+
+// Short rows, rows that are not a multiple of the pixel size as the last row
+// of a truncated image can be, and rows longer than any vector.
+constexpr size_t kRowSizes[] = {0, 1, 2, 3, 4, 5, 15, 16, 17, 31, 33, 64, 1001};
+
+constexpr uint32_t kBytesPerPixel[] = {1, 2, 3, 4, 6, 8};
+
+// Runs `test` once for each SIMD target that this CPU supports.
+template <typename Test>
+void ForEachTarget(const Test& test) {
+  for (int64_t target : hwy::SupportedAndGeneratedTargets()) {
+    SCOPED_TRACE(hwy::TargetName(target));
+    hwy::SetSupportedTargetsForTest(target);
+    test();
+  }
+  hwy::SetSupportedTargetsForTest(0);
+}
+
+// Deterministic xorshift generator, so failures are reproducible.
+class RandomBytes {
+ public:
+  std::vector<uint8_t> Bytes(size_t size) {
+    std::vector<uint8_t> result(size);
+    for (uint8_t& byte : result) {
+      state_ ^= state_ << 13;
+      state_ ^= state_ >> 17;
+      state_ ^= state_ << 5;
+      byte = static_cast<uint8_t>(state_ >> 24);
+    }
+    return result;
+  }
+
+ private:
+  uint32_t state_ = 0x12345678;
+};
+
+}  // namespace
+
+TEST(FlatePredictorSimdTest, PngPredictLine) {
+  RandomBytes random;
+  for (size_t row_size : kRowSizes) {
+    for (uint32_t bytes_per_pixel : kBytesPerPixel) {
+      // Types past 4 are invalid, and copy the row.
+      for (uint8_t type = 0; type <= 5; ++type) {
+        for (bool has_last : {false, true}) {
+          SCOPED_TRACE(testing::Message()
+                       << "row_size " << row_size << " bpp " << bytes_per_pixel
+                       << " type " << static_cast<int>(type) << " has_last "
+                       << has_last);
+          std::vector<uint8_t> src = random.Bytes(row_size + 1);
+          src[0] = type;
+          const std::vector<uint8_t> last =
+              has_last ? random.Bytes(row_size) : std::vector<uint8_t>();
+          std::vector<uint8_t> expected(row_size);
+          PNG_PredictLineScalar(expected, src, last, row_size,
+                                bytes_per_pixel);
+          ForEachTarget([&] {
+            std::vector<uint8_t> actual(row_size);
+            PNG_PredictLine(actual, src, last, row_size, bytes_per_pixel);
+            EXPECT_EQ(expected, actual);
+          });
+        }
+      }
+    }
+  }
+}
+
+TEST(FlatePredictorSimdTest, TiffPredictLine) {
+  RandomBytes random;
+  for (size_t row_size : kRowSizes) {
+    for (int colors : {1, 2, 3, 4}) {
+      SCOPED_TRACE(testing::Message()
+                   << "row_size " << row_size << " colors " << colors);
+      const std::vector<uint8_t> row = random.Bytes(row_size);
+      std::vector<uint8_t> expected = row;
+      TIFF_PredictLineScalar(expected, /*BitsPerComponent=*/8, colors,
+                             /*Columns=*/0);
+      ForEachTarget([&] {
+        std::vector<uint8_t> actual = row;
+        TIFF_PredictLine(actual, /*BitsPerComponent=*/8, colors,
+                         /*Columns=*/0);
+        EXPECT_EQ(expected, actual);
+      });
+    }
+  }
+}
+
+TEST(FlatePredictorSimdTest, UnsupportedRows) {
+  const std::vector<uint8_t> src(32, 1);
+  std::vector<uint8_t> dest(32, 0);
+  // 2 bytes per pixel and unknown filter types are left to the scalar code.
+  EXPECT_FALSE(PNG_PredictLineSimd(1, dest, src, {}, 2));
+  EXPECT_FALSE(PNG_PredictLineSimd(0, dest, src, src, 3));
+  EXPECT_FALSE(TIFF_PredictLineSimd(dest, 2));
+  EXPECT_EQ(std::vector<uint8_t>(32, 0), dest);
+}
+
+}  // namespace fxcodec
@@ -13,9 +13,9 @@
 #include <memory>
 #include <optional>
 #include <utility>
-#include <vector>
 
 #include "core/fxcodec/data_and_bytes_consumed.h"
+#include "core/fxcodec/flate/flate_predictor.h"
 #include "core/fxcodec/scanlinedecoder.h"
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/data_vector.h"
@@ -27,10 +27,13 @@
 #include "core/fxcrt/numerics/safe_conversions.h"
 #include "core/fxcrt/raw_span.h"
 #include "core/fxcrt/span.h"
-#include "core/fxcrt/span_util.h"
 #include "core/fxcrt/stl_util.h"
 #include "core/fxge/calculate_pitch.h"
 
+#if defined(PDF_USE_LIBDEFLATE)
+#include "core/fxcodec/flate/libdeflate_decoder.h"
+#endif
+
 #if defined(USE_SYSTEM_ZLIB)
 #include <zlib.h>
 #else
@@ -57,6 +60,12 @@ namespace {
 
 static constexpr uint32_t kMaxTotalOutSize = 1024 * 1024 * 1024;  // 1 GiB
 
+// The largest factor by which deflate can expand data.
+constexpr uint32_t kMaxFlateRatio = 1032;
+
+// The smallest step by which FlateUncompress() grows its output buffer.
+constexpr size_t kMinGrowSize = 4096;
+
 uint32_t FlateGetPossiblyTruncatedTotalOut(z_stream* context) {
   return std::min(pdfium::saturated_cast<uint32_t>(context->total_out),
                   kMaxTotalOutSize);
@@ -306,84 +315,6 @@ bool CLZWDecoder::Decode() {
   return dest_byte_pos_ != 0;
 }
 
-uint8_t GetLeftValue(pdfium::span<const uint8_t> span,
-                     size_t i,
-                     uint32_t bytes_per_pixel) {
-  return i >= bytes_per_pixel ? span[i - bytes_per_pixel] : 0;
-}
-
-uint8_t GetUpValue(pdfium::span<const uint8_t> span, size_t i) {
-  return span.empty() ? 0 : span[i];
-}
-
-uint8_t GetUpperLeftValue(pdfium::span<const uint8_t> span,
-                          size_t i,
-                          uint32_t bytes_per_pixel) {
-  if (i >= bytes_per_pixel && !span.empty()) {
-    return span[i - bytes_per_pixel];
-  }
-  return 0;
-}
-
-uint8_t PathPredictor(uint8_t a, uint8_t b, uint8_t c) {
-  int p = static_cast<int>(a) + b - c;
-  int pa = abs(p - a);
-  int pb = abs(p - b);
-  int pc = abs(p - c);
-  if (pa <= pb && pa <= pc) {
-    return a;
-  }
-  return pb <= pc ? b : c;
-}
-
-void PNG_PredictLine(pdfium::span<uint8_t> dest_span,
-                     pdfium::span<const uint8_t> src_span,
-                     pdfium::span<const uint8_t> last_span,
-                     size_t row_size,
-                     uint32_t bytes_per_pixel) {
-  const uint8_t tag = src_span.front();
-  pdfium::span<const uint8_t> remaining_src_span =
-      src_span.subspan(1u, row_size);
-  switch (tag) {
-    case 1: {
-      for (size_t i = 0; i < remaining_src_span.size(); ++i) {
-        uint8_t left = GetLeftValue(dest_span, i, bytes_per_pixel);
-        dest_span[i] = remaining_src_span[i] + left;
-      }
-      break;
-    }
-    case 2: {
-      for (size_t i = 0; i < remaining_src_span.size(); ++i) {
-        uint8_t up = GetUpValue(last_span, i);
-        dest_span[i] = remaining_src_span[i] + up;
-      }
-      break;
-    }
-    case 3: {
-      for (size_t i = 0; i < remaining_src_span.size(); ++i) {
-        uint8_t left = GetLeftValue(dest_span, i, bytes_per_pixel);
-        uint8_t up = GetUpValue(last_span, i);
-        dest_span[i] = remaining_src_span[i] + (up + left) / 2;
-      }
-      break;
-    }
-    case 4: {
-      for (size_t i = 0; i < remaining_src_span.size(); ++i) {
-        uint8_t left = GetLeftValue(dest_span, i, bytes_per_pixel);
-        uint8_t up = GetUpValue(last_span, i);
-        uint8_t upper_left = GetUpperLeftValue(last_span, i, bytes_per_pixel);
-        dest_span[i] =
-            remaining_src_span[i] + PathPredictor(left, up, upper_left);
-      }
-      break;
-    }
-    default: {
-      fxcrt::Copy(remaining_src_span, dest_span);
-      break;
-    }
-  }
-}
-
 std::optional<DataVector<uint8_t>> PNG_Predictor(
     int Colors,
     int BitsPerComponent,
@@ -427,45 +358,6 @@ std::optional<DataVector<uint8_t>> PNG_Predictor(
   return dest_buf;
 }
 
-void TIFF_PredictLine(pdfium::span<uint8_t> dest_span,
-                      int BitsPerComponent,
-                      int Colors,
-                      int Columns) {
-  if (BitsPerComponent == 1) {
-    int row_bits = std::min(BitsPerComponent * Colors * Columns,
-                            pdfium::checked_cast<int>(dest_span.size() * 8));
-    int index_pre = 0;
-    int col_pre = 0;
-    for (int i = 1; i < row_bits; i++) {
-      int col = i % 8;
-      int index = i / 8;
-      if (((dest_span[index] >> (7 - col)) & 1) ^
-          ((dest_span[index_pre] >> (7 - col_pre)) & 1)) {
-        dest_span[index] |= 1 << (7 - col);
-      } else {
-        dest_span[index] &= ~(1 << (7 - col));
-      }
-      index_pre = index;
-      col_pre = col;
-    }
-    return;
-  }
-  int BytesPerPixel = BitsPerComponent * Colors / 8;
-  if (BitsPerComponent == 16) {
-    for (size_t i = BytesPerPixel; i + 1 < dest_span.size(); i += 2) {
-      uint16_t pixel = (dest_span[i - BytesPerPixel] << 8) |
-                       dest_span[i - BytesPerPixel + 1];
-      pixel += (dest_span[i] << 8) | dest_span[i + 1];
-      dest_span[i] = pixel >> 8;
-      dest_span[i + 1] = (uint8_t)pixel;
-    }
-  } else {
-    for (size_t i = BytesPerPixel; i < dest_span.size(); i++) {
-      dest_span[i] += dest_span[i - BytesPerPixel];
-    }
-  }
-}
-
 bool TIFF_Predictor(int Colors,
                     int BitsPerComponent,
                     int Columns,
@@ -487,14 +379,34 @@ bool TIFF_Predictor(int Colors,
 
 uint32_t EstimateFlateUncompressBufferSize(uint32_t orig_size,
                                            size_t src_size) {
+  // A size hint from the stream dictionary is usually exact, so allocate all
+  // of it, plus one byte so that inflate() can report the end of the data
+  // without a reallocation. Deflate cannot expand data by more than
+  // kMaxFlateRatio though, so a larger hint is bogus.
+  if (orig_size && FlateModule::IsPlausibleDecodedSize(orig_size, src_size)) {
+    return orig_size + 1;
+  }
+
+  // Without a usable hint, start small and let the buffer grow.
   static constexpr uint32_t kMaxInitialAllocSize = 10000000;
-  uint32_t guess_size =
-      orig_size ? orig_size : pdfium::checked_cast<uint32_t>(src_size * 2);
-  return std::min(guess_size, kMaxInitialAllocSize);
+  FX_SAFE_UINT32 guess_size = src_size;
+  guess_size *= 2;
+  return std::min<uint32_t>(guess_size.ValueOrDefault(kMaxInitialAllocSize),
+                            kMaxInitialAllocSize);
 }
 
 DataAndBytesConsumed FlateUncompress(pdfium::span<const uint8_t> src_buf,
                                      uint32_t orig_size) {
+#if defined(PDF_USE_LIBDEFLATE)
+  // Most streams are whole and valid, and libdeflate decodes those fastest.
+  std::optional<DataAndBytesConsumed> result = LibdeflateDecoder::Decode(
+      src_buf, EstimateFlateUncompressBufferSize(orig_size, src_buf.size()),
+      kMaxTotalOutSize);
+  if (result.has_value()) {
+    return std::move(result.value());
+  }
+#endif
+
   std::unique_ptr<z_stream, FlateDeleter> context(FlateInit());
   if (!context) {
     return {DataVector<uint8_t>(), 0u};
@@ -502,49 +414,27 @@ DataAndBytesConsumed FlateUncompress(pdfium::span<const uint8_t> src_buf,
 
   FlateInput(context.get(), src_buf);
 
-  const uint32_t buf_size =
-      EstimateFlateUncompressBufferSize(orig_size, src_buf.size());
-  uint32_t last_buf_size = buf_size;
-  DataVector<uint8_t> guess_buf(buf_size);
-  std::vector<DataVector<uint8_t>> result_tmp_bufs;
-  {
-    DataVector<uint8_t> cur_buf = std::move(guess_buf);
-    while (true) {
-      bool ret = FlateOutput(context.get(), cur_buf);
-      uint32_t avail_buf_size = FlateGetAvailOut(context.get());
-      if (!ret || avail_buf_size != 0) {
-        last_buf_size = buf_size - avail_buf_size;
-        result_tmp_bufs.push_back(std::move(cur_buf));
-        break;
-      }
-      result_tmp_bufs.push_back(std::move(cur_buf));
-      cur_buf = DataVector<uint8_t>(buf_size);
+  // Decode into one buffer that grows in place, so the decoded data is never
+  // copied. With an exact size hint, it does not grow at all.
+  DataVector<uint8_t> dest_buf(
+      EstimateFlateUncompressBufferSize(orig_size, src_buf.size()));
+  size_t dest_size = 0;
+  while (true) {
+    bool ret = FlateOutput(context.get(),
+                           pdfium::span(dest_buf).subspan(dest_size));
+    dest_size = dest_buf.size() - FlateGetAvailOut(context.get());
+    if (!ret || dest_size < dest_buf.size() ||
+        dest_buf.size() >= kMaxTotalOutSize) {
+      break;
     }
+    // Growing by half keeps the number of reallocations logarithmic while
+    // wasting less memory than doubling.
+    dest_buf.resize(std::min<size_t>(
+        dest_buf.size() + std::max<size_t>(dest_buf.size() / 2, kMinGrowSize),
+        kMaxTotalOutSize));
   }
-
-  // The TotalOut size returned from the library may not be big enough to
-  // handle the content the library returns. We can only handle items
-  // up to 4GB in size.
-  const uint32_t dest_size = FlateGetPossiblyTruncatedTotalOut(context.get());
-  const uint32_t bytes_consumed =
-      FlateGetPossiblyTruncatedTotalIn(context.get());
-  if (result_tmp_bufs.size() == 1) {
-    CHECK_LE(dest_size, buf_size);
-    result_tmp_bufs.front().resize(dest_size);
-    return {std::move(result_tmp_bufs.front()), bytes_consumed};
-  }
-
-  DataVector<uint8_t> result_buf(dest_size);
-  auto result_span = pdfium::span(result_buf);
-  for (size_t i = 0; i < result_tmp_bufs.size(); i++) {
-    DataVector<uint8_t> tmp_buf = std::move(result_tmp_bufs[i]);
-    const uint32_t tmp_buf_size =
-        i + 1 < result_tmp_bufs.size() ? buf_size : last_buf_size;
-    size_t cp_size = std::min<size_t>(tmp_buf_size, result_span.size());
-    result_span =
-        fxcrt::spancpy(result_span, pdfium::span(tmp_buf).first(cp_size));
-  }
-  return {std::move(result_buf), bytes_consumed};
+  dest_buf.resize(dest_size);
+  return {std::move(dest_buf), FlateGetPossiblyTruncatedTotalIn(context.get())};
 }
 
 enum class PredictorType : uint8_t { kNone, kFlate, kPng };
@@ -558,6 +448,26 @@ static PredictorType GetPredictor(int predictor) {
   return PredictorType::kNone;
 }
 
+// `estimated_size` is the size of the data after undoing the predictor. With
+// a PNG predictor, the inflated data also has a filter type byte per row.
+uint32_t EstimateInflatedSize(PredictorType predictor,
+                              int Colors,
+                              int BitsPerComponent,
+                              int Columns,
+                              uint32_t estimated_size) {
+  if (predictor != PredictorType::kPng || !estimated_size) {
+    return estimated_size;
+  }
+  const uint32_t row_size =
+      fxge::CalculatePitch8(BitsPerComponent, Colors, Columns).value_or(0);
+  if (row_size == 0) {
+    return estimated_size;
+  }
+  FX_SAFE_UINT32 size = estimated_size;
+  size += (estimated_size - 1) / row_size + 1;
+  return size.ValueOrDefault(estimated_size);
+}
+
 class FlateScanlineDecoder : public ScanlineDecoder {
  public:
   FlateScanlineDecoder(pdfium::span<const uint8_t> src_span,
@@ -772,6 +682,138 @@ size_t FlatePredictorScanlineDecoder::CopyAndAdvanceLine(size_t bytes_to_go) {
   return bytes_to_go - read_bytes;
 }
 
+class FlateStreamDecoderImpl final : public FlateStreamDecoder {
+ public:
+  FlateStreamDecoderImpl(pdfium::span<const uint8_t> src_span,
+                         PredictorType predictor,
+                         int Colors,
+                         int BitsPerComponent,
+                         int Columns,
+                         uint32_t row_size);
+  ~FlateStreamDecoderImpl() override;
+
+  // FlateStreamDecoder:
+  size_t Read(pdfium::span<uint8_t> buffer) override;
+
+ private:
+  // Inflates into `dest_span` until it is full or the data ends. Returns the
+  // number of bytes written.
+  size_t Inflate(pdfium::span<uint8_t> dest_span);
+
+  // Decodes the next row and points `pending_` at it. Returns false at the
+  // end of the data.
+  bool DecodeRow();
+
+  std::unique_ptr<z_stream, FlateDeleter> flate_;
+  const pdfium::raw_span<const uint8_t> src_span_;
+  const PredictorType predictor_;
+  const int colors_;
+  const int bits_per_component_;
+  const int columns_;
+  const uint32_t bytes_per_pixel_;
+  bool done_ = false;
+  size_t total_out_ = 0;
+  DataVector<uint8_t> raw_row_;
+  DataVector<uint8_t> row_;
+  DataVector<uint8_t> last_row_;
+  pdfium::raw_span<const uint8_t> pending_;
+};
+
+FlateStreamDecoderImpl::FlateStreamDecoderImpl(
+    pdfium::span<const uint8_t> src_span,
+    PredictorType predictor,
+    int Colors,
+    int BitsPerComponent,
+    int Columns,
+    uint32_t row_size)
+    : flate_(FlateInit()),
+      src_span_(src_span),
+      predictor_(predictor),
+      colors_(Colors),
+      bits_per_component_(BitsPerComponent),
+      columns_(Columns),
+      bytes_per_pixel_((Colors * BitsPerComponent + 7) / 8) {
+  FlateInput(flate_.get(), src_span_);
+  switch (predictor_) {
+    case PredictorType::kNone:
+      break;
+    case PredictorType::kFlate:
+      row_.resize(row_size);
+      break;
+    case PredictorType::kPng:
+      // Each row starts with its filter type. DecodeRow() sizes `row_`, so
+      // that `last_row_` stays empty for the first row.
+      raw_row_.resize(row_size + 1);
+      break;
+  }
+}
+
+FlateStreamDecoderImpl::~FlateStreamDecoderImpl() {
+  // Span can't outlive the buffer it points into.
+  pending_ = pdfium::span<const uint8_t>();
+}
+
+size_t FlateStreamDecoderImpl::Read(pdfium::span<uint8_t> buffer) {
+  if (predictor_ == PredictorType::kNone) {
+    return Inflate(buffer);
+  }
+
+  size_t bytes_written = 0;
+  while (bytes_written < buffer.size()) {
+    if (pending_.empty() && !DecodeRow()) {
+      break;
+    }
+    const size_t size =
+        std::min(pending_.size(), buffer.size() - bytes_written);
+    fxcrt::Copy(pending_.first(size), buffer.subspan(bytes_written));
+    pending_ = pending_.subspan(size);
+    bytes_written += size;
+  }
+  return bytes_written;
+}
+
+size_t FlateStreamDecoderImpl::Inflate(pdfium::span<uint8_t> dest_span) {
+  // Stop where FlateUncompress() would, so both give the same data.
+  dest_span = dest_span.first(
+      std::min<size_t>(dest_span.size(), kMaxTotalOutSize - total_out_));
+  size_t bytes_written = 0;
+  while (!done_ && bytes_written < dest_span.size()) {
+    pdfium::span<uint8_t> remaining = dest_span.subspan(bytes_written);
+    flate_->next_out = remaining.data();
+    flate_->avail_out = pdfium::checked_cast<uint32_t>(remaining.size());
+    // Like FlateOutput(), treat anything but Z_OK as the end of the data. That
+    // includes Z_BUF_ERROR, which means the input is used up.
+    done_ = inflate(flate_.get(), Z_SYNC_FLUSH) != Z_OK;
+    bytes_written += remaining.size() - flate_->avail_out;
+  }
+  total_out_ += bytes_written;
+  return bytes_written;
+}
+
+bool FlateStreamDecoderImpl::DecodeRow() {
+  if (predictor_ == PredictorType::kFlate) {
+    const size_t size = Inflate(row_);
+    if (size == 0) {
+      return false;
+    }
+    pdfium::span<uint8_t> row_span = pdfium::span(row_).first(size);
+    TIFF_PredictLine(row_span, bits_per_component_, colors_, columns_);
+    pending_ = row_span;
+    return true;
+  }
+
+  // As in PNG_Predictor(), a truncated last row still gives its bytes.
+  const size_t size = Inflate(raw_row_);
+  if (size <= 1) {
+    return false;
+  }
+  std::swap(row_, last_row_);
+  row_.resize(raw_row_.size() - 1);
+  PNG_PredictLine(row_, raw_row_, last_row_, size - 1, bytes_per_pixel_);
+  pending_ = pdfium::span(row_).first(size - 1);
+  return true;
+}
+
 }  // namespace
 
 // static
@@ -818,7 +860,9 @@ DataAndBytesConsumed FlateModule::FlateOrLZWDecode(
     dest_buf = decoder->TakeDestBuf();
     bytes_consumed = decoder->GetSrcSize();
   } else {
-    DataAndBytesConsumed result = FlateUncompress(src_span, estimated_size);
+    DataAndBytesConsumed result = FlateUncompress(
+        src_span, EstimateInflatedSize(predictor_type, Colors, BitsPerComponent,
+                                       Columns, estimated_size));
     dest_buf = std::move(result.data);
     bytes_consumed = result.bytes_consumed;
   }
@@ -842,6 +886,59 @@ DataAndBytesConsumed FlateModule::FlateOrLZWDecode(
   }
 }
 
+// static
+size_t FlateModule::DecodeInto(pdfium::span<const uint8_t> src_span,
+                               pdfium::span<uint8_t> dest_span) {
+#if defined(PDF_USE_LIBDEFLATE)
+  std::optional<LibdeflateDecoder::Result> result =
+      LibdeflateDecoder::DecodeInto(src_span, dest_span);
+  if (result.has_value()) {
+    std::ranges::fill(dest_span.subspan(result.value().bytes_written), 0);
+    return result.value().bytes_written;
+  }
+#endif
+
+  std::unique_ptr<z_stream, FlateDeleter> context(FlateInit());
+  if (!context) {
+    return 0;
+  }
+
+  FlateInput(context.get(), src_span);
+  FlateOutput(context.get(), dest_span);
+  return dest_span.size() - FlateGetAvailOut(context.get());
+}
+
+// static
+bool FlateModule::IsPlausibleDecodedSize(uint32_t decoded_size,
+                                         size_t src_size) {
+  if (decoded_size >= kMaxTotalOutSize) {
+    return false;
+  }
+  FX_SAFE_UINT32 max_size = src_size;
+  max_size *= kMaxFlateRatio;
+  return !max_size.IsValid() || decoded_size <= max_size.ValueOrDie();
+}
+
+// static
+std::unique_ptr<FlateStreamDecoder> FlateModule::CreateStreamDecoder(
+    pdfium::span<const uint8_t> src_span,
+    int predictor,
+    int Colors,
+    int BitsPerComponent,
+    int Columns) {
+  PredictorType predictor_type = GetPredictor(predictor);
+  uint32_t row_size = 0;
+  if (predictor_type != PredictorType::kNone) {
+    row_size =
+        fxge::CalculatePitch8(BitsPerComponent, Colors, Columns).value_or(0);
+    if (row_size == 0) {
+      return nullptr;
+    }
+  }
+  return std::make_unique<FlateStreamDecoderImpl>(
+      src_span, predictor_type, Colors, BitsPerComponent, Columns, row_size);
+}
+
 // static
 DataVector<uint8_t> FlateModule::Encode(pdfium::span<const uint8_t> src_span) {
   FX_SAFE_SIZE_T safe_dest_size = src_span.size();
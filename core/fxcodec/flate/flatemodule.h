@@ -7,6 +7,7 @@
 #ifndef CORE_FXCODEC_FLATE_FLATEMODULE_H_
 #define CORE_FXCODEC_FLATE_FLATEMODULE_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <memory>
@@ -19,6 +20,18 @@ namespace fxcodec {
 
 class ScanlineDecoder;
 
+// Decodes FlateDecode data a piece at a time, for callers that consume it in
+// order and do not need all of it at once.
+class FlateStreamDecoder {
+ public:
+  virtual ~FlateStreamDecoder() = default;
+
+  // Fills `buffer` with the next decoded bytes. Returns the number of bytes
+  // written, which is less than the size of `buffer` only at the end of the
+  // data.
+  virtual size_t Read(pdfium::span<uint8_t> buffer) = 0;
+};
+
 class FlateModule {
  public:
   static std::unique_ptr<ScanlineDecoder> CreateDecoder(
@@ -42,6 +55,27 @@ class FlateModule {
       int Columns,
       uint32_t estimated_size);
 
+  // Same as FlateOrLZWDecode() with no predictor, but for callers that know
+  // the decoded size and have a buffer for it. Stops once `dest_span` is full.
+  // Returns the number of bytes written, which is less than the size of
+  // `dest_span` if the data is shorter or corrupt.
+  static size_t DecodeInto(pdfium::span<const uint8_t> src_span,
+                           pdfium::span<uint8_t> dest_span);
+
+  // Whether deflate data of `src_size` bytes could decode to `decoded_size`
+  // bytes. For checking size hints from the document before trusting them.
+  static bool IsPlausibleDecodedSize(uint32_t decoded_size, size_t src_size);
+
+  // Returns a decoder that undoes the same predictors as FlateOrLZWDecode(),
+  // or nullptr if the predictor parameters are invalid. `src_span` must
+  // outlive the decoder.
+  static std::unique_ptr<FlateStreamDecoder> CreateStreamDecoder(
+      pdfium::span<const uint8_t> src_span,
+      int predictor,
+      int Colors,
+      int BitsPerComponent,
+      int Columns);
+
   static DataVector<uint8_t> Encode(pdfium::span<const uint8_t> src_span);
 
   FlateModule() = delete;
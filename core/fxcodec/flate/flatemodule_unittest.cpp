@@ -4,13 +4,49 @@
 
 #include "core/fxcodec/flate/flatemodule.h"
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include "core/fxcodec/data_and_bytes_consumed.h"
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/span.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/test_support.h"
 
 using testing::ElementsAreArray;
 
+namespace {
+
+// Returns `size` bytes that compress well, but not to nothing.
+DataVector<uint8_t> MakeData(size_t size) {
+  DataVector<uint8_t> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<uint8_t>((i * 7) ^ (i >> 8));
+  }
+  return data;
+}
+
+// Reads all of `decoder`'s data, `chunk_size` bytes at a time.
+DataVector<uint8_t> ReadAll(fxcodec::FlateStreamDecoder* decoder,
+                            size_t chunk_size) {
+  DataVector<uint8_t> result;
+  DataVector<uint8_t> chunk(chunk_size);
+  while (true) {
+    size_t size = decoder->Read(chunk);
+    result.insert(result.end(), chunk.begin(), chunk.begin() + size);
+    if (size < chunk_size) {
+      return result;
+    }
+  }
+}
+
+}  // namespace
+
 // NOTE: python's zlib.compress() and zlib.decompress() may be useful for
 // external validation of the FlateDncode/FlateEecode test cases.
 TEST(FlateModule, Decode) {
@@ -72,3 +108,86 @@ TEST(FlateModule, Encode) {
     ++i;
   }
 }
+
+TEST(FlateModule, DecodeWithSizeHints) {
+  const DataVector<uint8_t> data = MakeData(100000);
+  const DataVector<uint8_t> encoded = FlateModule::Encode(data);
+  // Exact hints, wrong hints, and hints too large to be true.
+  for (uint32_t hint : {0u, 1u, 99999u, 100000u, 100001u, 400000u,
+                        0xFFFFFFFFu}) {
+    DataAndBytesConsumed result = FlateModule::FlateOrLZWDecode(
+        false, encoded, false, 0, 0, 0, 0, hint);
+    EXPECT_EQ(encoded.size(), result.bytes_consumed) << " for hint " << hint;
+    EXPECT_EQ(data, result.data) << " for hint " << hint;
+  }
+}
+
+TEST(FlateModule, DecodeInto) {
+  const DataVector<uint8_t> data = MakeData(5000);
+  const DataVector<uint8_t> encoded = FlateModule::Encode(data);
+
+  DataVector<uint8_t> exact(data.size());
+  EXPECT_EQ(data.size(), FlateModule::DecodeInto(encoded, exact));
+  EXPECT_EQ(data, exact);
+
+  // A short buffer gets the start of the data.
+  DataVector<uint8_t> short_buf(1000);
+  EXPECT_EQ(1000u, FlateModule::DecodeInto(encoded, short_buf));
+  EXPECT_TRUE(std::equal(short_buf.begin(), short_buf.end(), data.begin()));
+
+  // A long buffer gets zeros after the data.
+  DataVector<uint8_t> long_buf(6000, 0xFF);
+  EXPECT_EQ(data.size(), FlateModule::DecodeInto(encoded, long_buf));
+  EXPECT_TRUE(std::equal(data.begin(), data.end(), long_buf.begin()));
+  EXPECT_TRUE(std::all_of(long_buf.begin() + data.size(), long_buf.end(),
+                          [](uint8_t byte) { return byte == 0; }));
+
+  static constexpr uint8_t kCorrupt[] = {'b', 'a', 'd'};
+  EXPECT_EQ(0u, FlateModule::DecodeInto(kCorrupt, exact));
+}
+
+TEST(FlateModule, StreamDecoder) {
+  const DataVector<uint8_t> data = MakeData(70000);
+  const DataVector<uint8_t> encoded = FlateModule::Encode(data);
+  for (size_t chunk_size : {1u, 7u, 4096u, 100000u}) {
+    std::unique_ptr<fxcodec::FlateStreamDecoder> decoder =
+        FlateModule::CreateStreamDecoder(encoded, 0, 0, 0, 0);
+    ASSERT_TRUE(decoder);
+    EXPECT_EQ(data, ReadAll(decoder.get(), chunk_size))
+        << " for chunk size " << chunk_size;
+    // Reading past the end gives nothing.
+    DataVector<uint8_t> buffer(10);
+    EXPECT_EQ(0u, decoder->Read(buffer));
+  }
+}
+
+TEST(FlateModule, StreamDecoderWithPredictors) {
+  // 10 RGB pixels per row. The PNG rows use all filter types in turn, and the
+  // last row of each is truncated.
+  static constexpr int kColors = 3;
+  static constexpr int kColumns = 10;
+  static constexpr size_t kRowSize = kColors * kColumns;
+  DataVector<uint8_t> png_rows = MakeData((kRowSize + 1) * 20 + 7);
+  for (size_t i = 0; i < png_rows.size(); i += kRowSize + 1) {
+    png_rows[i] = (i / (kRowSize + 1)) % 5;
+  }
+  const DataVector<uint8_t> tiff_rows = MakeData(kRowSize * 20 + 7);
+
+  for (int predictor : {2, 10, 15}) {
+    const DataVector<uint8_t> encoded =
+        FlateModule::Encode(predictor == 2 ? tiff_rows : png_rows);
+    DataAndBytesConsumed expected = FlateModule::FlateOrLZWDecode(
+        false, encoded, false, predictor, kColors, 8, kColumns, 0);
+    ASSERT_FALSE(expected.data.empty());
+    for (size_t chunk_size : {1u, 29u, 4096u}) {
+      std::unique_ptr<fxcodec::FlateStreamDecoder> decoder =
+          FlateModule::CreateStreamDecoder(encoded, predictor, kColors, 8,
+                                           kColumns);
+      ASSERT_TRUE(decoder);
+      EXPECT_EQ(expected.data, ReadAll(decoder.get(), chunk_size))
+          << " for predictor " << predictor << " chunk size " << chunk_size;
+    }
+  }
+
+  EXPECT_FALSE(FlateModule::CreateStreamDecoder({}, 12, kColors, 8, 0));
+}
@@ -0,0 +1,91 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/flate/libdeflate_decoder.h"
+
+#include <libdeflate.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/numerics/safe_conversions.h"
+
+namespace fxcodec {
+
+namespace {
+
+struct DecompressorDeleter {
+  void operator()(libdeflate_decompressor* decompressor) const {
+    libdeflate_free_decompressor(decompressor);
+  }
+};
+
+using ScopedDecompressor =
+    std::unique_ptr<libdeflate_decompressor, DecompressorDeleter>;
+
+libdeflate_result Decompress(libdeflate_decompressor* decompressor,
+                             pdfium::span<const uint8_t> src_span,
+                             pdfium::span<uint8_t> dest_span,
+                             LibdeflateDecoder::Result* result) {
+  return libdeflate_zlib_decompress_ex(
+      decompressor, src_span.data(), src_span.size(), dest_span.data(),
+      dest_span.size(), &result->bytes_consumed, &result->bytes_written);
+}
+
+}  // namespace
+
+// static
+std::optional<LibdeflateDecoder::Result> LibdeflateDecoder::DecodeInto(
+    pdfium::span<const uint8_t> src_span,
+    pdfium::span<uint8_t> dest_span) {
+  ScopedDecompressor decompressor(libdeflate_alloc_decompressor());
+  if (!decompressor) {
+    return std::nullopt;
+  }
+
+  Result result;
+  if (Decompress(decompressor.get(), src_span, dest_span, &result) !=
+      LIBDEFLATE_SUCCESS) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+// static
+std::optional<DataAndBytesConsumed> LibdeflateDecoder::Decode(
+    pdfium::span<const uint8_t> src_span,
+    size_t estimated_size,
+    size_t max_size) {
+  ScopedDecompressor decompressor(libdeflate_alloc_decompressor());
+  if (!decompressor) {
+    return std::nullopt;
+  }
+
+  // libdeflate cannot resume, so each retry decodes from the start. Doubling
+  // the size keeps the wasted work below that of one more decode.
+  DataVector<uint8_t> dest_buf(std::min(std::max<size_t>(estimated_size, 1),
+                                        max_size));
+  while (true) {
+    Result result;
+    libdeflate_result ret =
+        Decompress(decompressor.get(), src_span, dest_buf, &result);
+    if (ret == LIBDEFLATE_SUCCESS) {
+      dest_buf.resize(result.bytes_written);
+      return DataAndBytesConsumed(
+          std::move(dest_buf),
+          pdfium::saturated_cast<uint32_t>(result.bytes_consumed));
+    }
+    if (ret != LIBDEFLATE_INSUFFICIENT_SPACE || dest_buf.size() >= max_size) {
+      return std::nullopt;
+    }
+    // The partial data is of no use, so do not let resize() copy it.
+    const size_t new_size = std::min(dest_buf.size() * 2, max_size);
+    dest_buf = DataVector<uint8_t>();
+    dest_buf.resize(new_size);
+  }
+}
+
+}  // namespace fxcodec
@@ -0,0 +1,50 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCODEC_FLATE_LIBDEFLATE_DECODER_H_
+#define CORE_FXCODEC_FLATE_LIBDEFLATE_DECODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+
+#include "core/fxcodec/data_and_bytes_consumed.h"
+#include "core/fxcrt/span.h"
+
+namespace fxcodec {
+
+// Decodes whole zlib streams with libdeflate, which is several times faster
+// than zlib's inflate(), but cannot decode a stream in pieces. Unlike zlib, it
+// gives no data at all for truncated or corrupt streams, so callers fall back
+// to zlib to salvage what they can.
+class LibdeflateDecoder {
+ public:
+  struct Result {
+    size_t bytes_written;
+    size_t bytes_consumed;
+  };
+
+  // Decodes `src_span` into `dest_span`. Returns std::nullopt if the decoded
+  // data does not fit, or if the stream is truncated or corrupt.
+  static std::optional<Result> DecodeInto(pdfium::span<const uint8_t> src_span,
+                                          pdfium::span<uint8_t> dest_span);
+
+  // Decodes `src_span` into a buffer of `estimated_size` bytes, and decodes
+  // again into a buffer twice the size while the data does not fit, up to
+  // `max_size` bytes. Returns std::nullopt if the data does not fit into
+  // `max_size` bytes, or if the stream is truncated or corrupt.
+  static std::optional<DataAndBytesConsumed> Decode(
+      pdfium::span<const uint8_t> src_span,
+      size_t estimated_size,
+      size_t max_size);
+
+  LibdeflateDecoder() = delete;
+  LibdeflateDecoder(const LibdeflateDecoder&) = delete;
+  LibdeflateDecoder& operator=(const LibdeflateDecoder&) = delete;
+};
+
+}  // namespace fxcodec
+
+#endif  // CORE_FXCODEC_FLATE_LIBDEFLATE_DECODER_H_
@@ -0,0 +1,93 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/flate/libdeflate_decoder.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <optional>
+
+#include "core/fxcodec/data_and_bytes_consumed.h"
+#include "core/fxcodec/flate/flatemodule.h"
+#include "core/fxcrt/data_vector.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace fxcodec {
+
+namespace {
+
+DataVector<uint8_t> MakeData(size_t size) {
+  DataVector<uint8_t> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<uint8_t>((i * 7) ^ (i >> 8));
+  }
+  return data;
+}
+
+}  // namespace
+
+TEST(LibdeflateDecoder, DecodeInto) {
+  const DataVector<uint8_t> data = MakeData(10000);
+  DataVector<uint8_t> encoded = FlateModule::Encode(data);
+
+  DataVector<uint8_t> dest(data.size());
+  std::optional<LibdeflateDecoder::Result> result =
+      LibdeflateDecoder::DecodeInto(encoded, dest);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(data.size(), result.value().bytes_written);
+  EXPECT_EQ(encoded.size(), result.value().bytes_consumed);
+  EXPECT_EQ(data, dest);
+
+  // Data after the end of the stream is not consumed.
+  DataVector<uint8_t> padded = encoded;
+  padded.insert(padded.end(), {'e', 'n', 'd'});
+  result = LibdeflateDecoder::DecodeInto(padded, dest);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(encoded.size(), result.value().bytes_consumed);
+
+  DataVector<uint8_t> short_dest(data.size() - 1);
+  EXPECT_FALSE(LibdeflateDecoder::DecodeInto(encoded, short_dest));
+
+  DataVector<uint8_t> truncated(encoded.begin(), encoded.end() - 10);
+  EXPECT_FALSE(LibdeflateDecoder::DecodeInto(truncated, dest));
+
+  encoded[encoded.size() / 2] ^= 0x55;
+  EXPECT_FALSE(LibdeflateDecoder::DecodeInto(encoded, dest));
+}
+
+TEST(LibdeflateDecoder, Decode) {
+  const DataVector<uint8_t> data = MakeData(10000);
+  const DataVector<uint8_t> encoded = FlateModule::Encode(data);
+
+  // Too small estimates make it decode again.
+  for (size_t estimated_size : {0u, 1u, 9999u, 10000u, 40000u}) {
+    std::optional<DataAndBytesConsumed> result =
+        LibdeflateDecoder::Decode(encoded, estimated_size, 100000);
+    ASSERT_TRUE(result.has_value()) << " for estimate " << estimated_size;
+    EXPECT_EQ(data, result.value().data);
+    EXPECT_EQ(encoded.size(), result.value().bytes_consumed);
+  }
+
+  EXPECT_FALSE(LibdeflateDecoder::Decode(encoded, 100, 9999));
+}
+
+TEST(LibdeflateDecoder, FlateModuleFallsBackToZlib) {
+  const DataVector<uint8_t> data = MakeData(10000);
+  const DataVector<uint8_t> encoded = FlateModule::Encode(data);
+
+  // zlib gives the data decoded before the end of a truncated stream.
+  const DataVector<uint8_t> truncated(encoded.begin(), encoded.end() - 10);
+  DataAndBytesConsumed result = FlateModule::FlateOrLZWDecode(
+      false, truncated, false, 0, 0, 0, 0, data.size());
+  ASSERT_FALSE(result.data.empty());
+  EXPECT_TRUE(std::equal(result.data.begin(), result.data.end(), data.begin()));
+
+  DataVector<uint8_t> dest(data.size());
+  size_t size = FlateModule::DecodeInto(truncated, dest);
+  EXPECT_EQ(result.data.size(), size);
+}
+
+}  // namespace fxcodec
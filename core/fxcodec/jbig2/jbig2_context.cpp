@@ -9,7 +9,6 @@
 #include <algorithm>
 #include <array>
 #include <limits>
-#include <list>
 #include <utility>
 #include <vector>
 
@@ -49,36 +48,29 @@ JBig2ComposeOp GetComposeOp(uint8_t flags) {
 
 }  // namespace
 
-// Implement a very small least recently used (LRU) cache. It is very
-// common for a JBIG2 dictionary to span multiple pages in a PDF file,
-// and we do not want to decode the same dictionary over and over
-// again. We key off of the memory location of the dictionary. The
-// list keeps track of the freshness of entries, with freshest ones
-// at the front. Even a tiny cache size like 2 makes a dramatic
-// difference for typical JBIG2 documents.
-static const size_t kSymbolDictCacheMaxSize = 2;
-static_assert(kSymbolDictCacheMaxSize > 0,
-              "Symbol Dictionary Cache must have non-zero size");
-
 // static
 std::unique_ptr<CJBig2_Context> CJBig2_Context::Create(
     pdfium::span<const uint8_t> pGlobalSpan,
     uint64_t global_key,
     pdfium::span<const uint8_t> pSrcSpan,
     uint64_t src_key,
-    std::list<CJBig2_CachePair>* pSymbolDictCache) {
+    CJBig2_SymbolDictCache* pSymbolDictCache,
+    std::optional<CJBig2_SymbolDictCache::Digest> global_digest) {
   auto result = pdfium::WrapUnique(
       new CJBig2_Context(pSrcSpan, src_key, pSymbolDictCache, false));
   if (!pGlobalSpan.empty()) {
     result->global_context_ = pdfium::WrapUnique(
         new CJBig2_Context(pGlobalSpan, global_key, pSymbolDictCache, true));
+    if (pSymbolDictCache) {
+      result->global_context_->stream_digest_ = global_digest;
+    }
   }
   return result;
 }
 
 CJBig2_Context::CJBig2_Context(pdfium::span<const uint8_t> pSrcSpan,
                                uint64_t src_key,
-                               std::list<CJBig2_CachePair>* pSymbolDictCache,
+                               CJBig2_SymbolDictCache* pSymbolDictCache,
                                bool bIsGlobal)
     : stream_(std::make_unique<CJBig2_BitStream>(pSrcSpan, src_key)),
       huffman_tables_(CJBig2_HuffmanTable::kNumHuffmanTables),
@@ -296,7 +288,6 @@ JBig2_Result CJBig2_Context::ParseSegmentHeader(CJBig2_Segment* pSegment) {
     return JBig2_Result::kFailure;
   }
 
-  pSegment->key_ = stream_->getKey();
   pSegment->data_offset_ = stream_->getOffset();
   pSegment->state_ = JBIG2_SEGMENT_DATA_UNPARSED;
   return JBig2_Result::kSuccess;
@@ -565,50 +556,34 @@ JBig2_Result CJBig2_Context::ParseSymbolDict(CJBig2_Segment* pSegment) {
     }
   }
 
-  CJBig2_CompoundKey key(pSegment->key_, pSegment->data_offset_);
-  bool cache_hit = false;
   pSegment->result_type_ = JBIG2_SYMBOL_DICT_POINTER;
-  if (is_global_ && key.first != 0) {
-    for (auto it = symbol_dict_cache_->begin(); it != symbol_dict_cache_->end();
-         ++it) {
-      if (it->first == key) {
-        pSegment->symbol_dict_ = it->second->DeepCopy();
-        symbol_dict_cache_->emplace_front(key, std::move(it->second));
-        symbol_dict_cache_->erase(it);
-        cache_hit = true;
-        break;
-      }
+  std::optional<CJBig2_SymbolDictCache::Key> key;
+  if (stream_digest_.has_value()) {
+    key = CJBig2_SymbolDictCache::Key{stream_digest_.value(),
+                                      pSegment->data_offset_};
+    // The cached copy already holds the contexts to retain, if any.
+    pSegment->symbol_dict_ = symbol_dict_cache_->Lookup(key.value());
+    if (pSegment->symbol_dict_) {
+      return JBig2_Result::kSuccess;
     }
   }
-  if (!cache_hit) {
-    if (bUseGbContext) {
-      auto pArithDecoder = std::make_unique<CJBig2_ArithDecoder>(stream_.get());
-      pSegment->symbol_dict_ = pSymbolDictDecoder->DecodeArith(
-          pArithDecoder.get(), gbContexts, grContexts);
-      if (!pSegment->symbol_dict_) {
-        return JBig2_Result::kFailure;
-      }
+  if (bUseGbContext) {
+    auto pArithDecoder = std::make_unique<CJBig2_ArithDecoder>(stream_.get());
+    pSegment->symbol_dict_ = pSymbolDictDecoder->DecodeArith(
+        pArithDecoder.get(), gbContexts, grContexts);
+    if (!pSegment->symbol_dict_) {
+      return JBig2_Result::kFailure;
+    }
 
-      stream_->alignByte();
-      stream_->addOffset(2);
-    } else {
-      pSegment->symbol_dict_ = pSymbolDictDecoder->DecodeHuffman(
-          stream_.get(), gbContexts, grContexts);
-      if (!pSegment->symbol_dict_) {
-        return JBig2_Result::kFailure;
-      }
-      stream_->alignByte();
-    }
-    if (is_global_) {
-      std::unique_ptr<CJBig2_SymbolDict> value =
-          pSegment->symbol_dict_->DeepCopy();
-      size_t size = symbol_dict_cache_->size();
-      while (size >= kSymbolDictCacheMaxSize) {
-        symbol_dict_cache_->pop_back();
-        --size;
-      }
-      symbol_dict_cache_->emplace_front(key, std::move(value));
+    stream_->alignByte();
+    stream_->addOffset(2);
+  } else {
+    pSegment->symbol_dict_ = pSymbolDictDecoder->DecodeHuffman(
+        stream_.get(), gbContexts, grContexts);
+    if (!pSegment->symbol_dict_) {
+      return JBig2_Result::kFailure;
     }
+    stream_->alignByte();
   }
   if (wFlags & 0x0200) {
     if (bUseGbContext) {
@@ -618,6 +593,9 @@ JBig2_Result CJBig2_Context::ParseSymbolDict(CJBig2_Segment* pSegment) {
       pSegment->symbol_dict_->SetGrContexts(std::move(grContexts));
     }
   }
+  if (key.has_value()) {
+    symbol_dict_cache_->Insert(key.value(), *pSegment->symbol_dict_);
+  }
   return JBig2_Result::kSuccess;
 }
 
@@ -10,15 +10,15 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <list>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
 #include "core/fxcodec/fx_codec_def.h"
-#include "core/fxcodec/jbig2/jbig2_document_context.h"
 #include "core/fxcodec/jbig2/jbig2_page.h"
 #include "core/fxcodec/jbig2/jbig2_segment.h"
+#include "core/fxcodec/jbig2/jbig2_symbol_dict_cache.h"
 #include "core/fxcrt/span.h"
 #include "core/fxcrt/unowned_ptr.h"
 
@@ -30,12 +30,15 @@ enum class JBig2_Result { kSuccess, kFailure, kEndReached };
 
 class CJBig2_Context {
  public:
+  // Symbol dictionaries from `pGlobalSpan` go through `pSymbolDictCache`,
+  // under `global_digest`, if both are given.
   static std::unique_ptr<CJBig2_Context> Create(
       pdfium::span<const uint8_t> pGlobalSpan,
       uint64_t global_key,
       pdfium::span<const uint8_t> pSrcSpan,
       uint64_t src_key,
-      std::list<CJBig2_CachePair>* pSymbolDictCache);
+      CJBig2_SymbolDictCache* pSymbolDictCache,
+      std::optional<CJBig2_SymbolDictCache::Digest> global_digest);
 
   ~CJBig2_Context();
 
@@ -57,7 +60,7 @@ class CJBig2_Context {
  private:
   CJBig2_Context(pdfium::span<const uint8_t> pSrcSpan,
                  uint64_t src_key,
-                 std::list<CJBig2_CachePair>* pSymbolDictCache,
+                 CJBig2_SymbolDictCache* pSymbolDictCache,
                  bool bIsGlobal);
 
   JBig2_Result DecodeSequential(PauseIndicatorIface* pPause);
@@ -103,7 +106,9 @@ class CJBig2_Context {
   std::unique_ptr<CJBig2_Segment> segment_;
   uint32_t offset_ = 0;
   JBig2RegionInfo ri_ = {};
-  UnownedPtr<std::list<CJBig2_CachePair>> const symbol_dict_cache_;
+  UnownedPtr<CJBig2_SymbolDictCache> const symbol_dict_cache_;
+  // Digest of the stream, for global contexts that use `symbol_dict_cache_`.
+  std::optional<CJBig2_SymbolDictCache::Digest> stream_digest_;
   bool reject_large_regions_when_fuzzing_ = false;
 };
 
@@ -7,9 +7,11 @@
 #include "core/fxcodec/jbig2/jbig2_decoder.h"
 
 #include <algorithm>
+#include <optional>
 
 #include "core/fxcodec/jbig2/jbig2_context.h"
 #include "core/fxcodec/jbig2/jbig2_document_context.h"
+#include "core/fxcodec/jbig2/jbig2_symbol_dict_cache.h"
 #include "core/fxcrt/fx_2d_size.h"
 #include "core/fxcrt/span_util.h"
 
@@ -64,9 +66,17 @@ FXCODEC_STATUS Jbig2Decoder::StartDecode(
   pJbig2Context->dest_buf_ = dest_buf;
   pJbig2Context->dest_pitch_ = dest_pitch;
   std::ranges::fill(dest_buf.first(Fx2DSizeOrDie(height, dest_pitch)), 0);
-  pJbig2Context->context_ =
-      CJBig2_Context::Create(global_span, global_key, src_span, src_key,
-                             pJBig2DocumentContext->GetSymbolDictCache());
+  // Symbol dictionaries in global data streams are often shared by many
+  // images, and by other documents from the same source, so cache them by
+  // the contents of the stream.
+  std::optional<CJBig2_SymbolDictCache::Digest> global_digest;
+  if (!global_span.empty()) {
+    global_digest =
+        pJBig2DocumentContext->GetGlobalDigest(global_key, global_span);
+  }
+  pJbig2Context->context_ = CJBig2_Context::Create(
+      global_span, global_key, src_span, src_key,
+      pJBig2DocumentContext->GetSymbolDictCache(), global_digest);
 
   if (reject_large_regions_when_fuzzing) {
     pJbig2Context->context_->RejectLargeRegionsWhenFuzzing();
@@ -6,9 +6,28 @@
 
 #include "core/fxcodec/jbig2/jbig2_document_context.h"
 
-#include "core/fxcodec/jbig2/jbig2_image.h"
-#include "core/fxcodec/jbig2/jbig2_symbol_dict.h"
+JBig2_DocumentContext::JBig2_DocumentContext()
+    : JBig2_DocumentContext(CJBig2_SymbolDictCache::Get()) {}
 
-JBig2_DocumentContext::JBig2_DocumentContext() = default;
+JBig2_DocumentContext::JBig2_DocumentContext(
+    CJBig2_SymbolDictCache* symbol_dict_cache)
+    : symbol_dict_cache_(symbol_dict_cache) {}
 
 JBig2_DocumentContext::~JBig2_DocumentContext() = default;
+
+std::optional<CJBig2_SymbolDictCache::Digest>
+JBig2_DocumentContext::GetGlobalDigest(
+    uint64_t global_key,
+    pdfium::span<const uint8_t> global_span) {
+  if (!symbol_dict_cache_) {
+    return std::nullopt;
+  }
+  auto it = global_digests_.find(global_key);
+  if (it == global_digests_.end()) {
+    it = global_digests_
+             .emplace(global_key,
+                      CJBig2_SymbolDictCache::HashStream(global_span))
+             .first;
+  }
+  return it->second;
+}
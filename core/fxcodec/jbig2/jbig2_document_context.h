@@ -9,29 +9,35 @@
 
 #include <stdint.h>
 
-#include <list>
-#include <memory>
-#include <utility>
+#include <map>
+#include <optional>
 
-class CJBig2_SymbolDict;
-
-// Cache is keyed by both the key of a stream and an index within the stream.
-using CJBig2_CompoundKey = std::pair<uint64_t, uint32_t>;
-using CJBig2_CachePair =
-    std::pair<CJBig2_CompoundKey, std::unique_ptr<CJBig2_SymbolDict>>;
+#include "core/fxcodec/jbig2/jbig2_symbol_dict_cache.h"
+#include "core/fxcrt/span.h"
+#include "core/fxcrt/unowned_ptr.h"
 
 // Holds per-document JBig2 related data.
 class JBig2_DocumentContext {
  public:
+  // Uses the symbol dictionary cache shared by the whole process.
   JBig2_DocumentContext();
+  explicit JBig2_DocumentContext(CJBig2_SymbolDictCache* symbol_dict_cache);
   ~JBig2_DocumentContext();
 
-  std::list<CJBig2_CachePair>* GetSymbolDictCache() {
-    return &symbol_dict_cache_;
+  CJBig2_SymbolDictCache* GetSymbolDictCache() const {
+    return symbol_dict_cache_;
   }
 
+  // Returns the digest that identifies the global data stream with
+  // `global_key` in the symbol dictionary cache, or nothing without a cache.
+  // Only hashes `global_span` the first time for each stream.
+  std::optional<CJBig2_SymbolDictCache::Digest> GetGlobalDigest(
+      uint64_t global_key,
+      pdfium::span<const uint8_t> global_span);
+
  private:
-  std::list<CJBig2_CachePair> symbol_dict_cache_;
+  UnownedPtr<CJBig2_SymbolDictCache> const symbol_dict_cache_;
+  std::map<uint64_t, CJBig2_SymbolDictCache::Digest> global_digests_;
 };
 
 #endif  // CORE_FXCODEC_JBIG2_JBIG2_DOCUMENT_CONTEXT_H_
@@ -6,6 +6,7 @@
 
 #include "core/fxcodec/jbig2/jbig2_grd_proc.h"
 
+#include <algorithm>
 #include <array>
 #include <functional>
 #include <memory>
@@ -47,6 +48,73 @@ constexpr std::array<const uint16_t, 3> kOptConstant11 = {
 constexpr std::array<const uint16_t, 3> kOptConstant12 = {
     {0x000f, 0x0007, 0x0003}};
 
+// Where the pixels around the pixel at x go in the context of each generic
+// region template. The runs from the rows above end at x + offset, with the
+// rightmost pixel in the lowest bit. The run from the current row ends at
+// x - 1, in the lowest bits of the context.
+struct GenericTemplateLayout {
+  uint32_t tp_context;
+  int current_bits;
+  int prev1_offset;
+  int prev1_bits;
+  int prev1_shift;
+  int prev2_offset;
+  int prev2_bits;
+  int prev2_shift;
+  size_t at_count;
+  std::array<int, 4> at_shifts;
+};
+
+constexpr std::array<GenericTemplateLayout, 4> kGenericTemplateLayouts = {{
+    {.tp_context = 0x9b25,
+     .current_bits = 4,
+     .prev1_offset = 2,
+     .prev1_bits = 5,
+     .prev1_shift = 5,
+     .prev2_offset = 1,
+     .prev2_bits = 3,
+     .prev2_shift = 12,
+     .at_count = 4,
+     .at_shifts = {4, 10, 11, 15}},
+    {.tp_context = 0x0795,
+     .current_bits = 3,
+     .prev1_offset = 2,
+     .prev1_bits = 5,
+     .prev1_shift = 4,
+     .prev2_offset = 2,
+     .prev2_bits = 4,
+     .prev2_shift = 9,
+     .at_count = 1,
+     .at_shifts = {3}},
+    {.tp_context = 0x00e5,
+     .current_bits = 2,
+     .prev1_offset = 1,
+     .prev1_bits = 4,
+     .prev1_shift = 3,
+     .prev2_offset = 1,
+     .prev2_bits = 3,
+     .prev2_shift = 7,
+     .at_count = 1,
+     .at_shifts = {2}},
+    {.tp_context = 0x0195,
+     .current_bits = 4,
+     .prev1_offset = 1,
+     .prev1_bits = 5,
+     .prev1_shift = 5,
+     .prev2_offset = 0,
+     .prev2_bits = 0,
+     .prev2_shift = 0,
+     .at_count = 1,
+     .at_shifts = {4}},
+}};
+
+// Returns the run of `bits` pixels that ends at x + `offset`, for the pixel
+// x that is `k` pixels into a word read from x - k - 16.
+uint32_t GetRun(uint64_t word, int k, int offset, int bits) {
+  return static_cast<uint32_t>(word >> (47 - k - offset)) &
+         ((1u << bits) - 1);
+}
+
 struct LineLayout {
   uint32_t full_bytes;
   // Range of values is [1, 8].
@@ -98,19 +166,19 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArith(
     case 0:
       return UseTemplate0Opt3()
                  ? DecodeArithOpt3<0>(pArithDecoder, gbContexts)
-                 : DecodeArithTemplateUnopt<0>(pArithDecoder, gbContexts);
+                 : DecodeArithGeneric(pArithDecoder, gbContexts);
     case 1:
       return UseTemplate1Opt3()
                  ? DecodeArithOpt3<1>(pArithDecoder, gbContexts)
-                 : DecodeArithTemplateUnopt<1>(pArithDecoder, gbContexts);
+                 : DecodeArithGeneric(pArithDecoder, gbContexts);
     case 2:
       return UseTemplate23Opt3()
                  ? DecodeArithOpt3<2>(pArithDecoder, gbContexts)
-                 : DecodeArithTemplateUnopt<2>(pArithDecoder, gbContexts);
+                 : DecodeArithGeneric(pArithDecoder, gbContexts);
     default:
       return UseTemplate23Opt3()
                  ? DecodeArithTemplate3Opt3(pArithDecoder, gbContexts)
-                 : DecodeArithTemplate3Unopt(pArithDecoder, gbContexts);
+                 : DecodeArithGeneric(pArithDecoder, gbContexts);
   }
 }
 
@@ -235,97 +303,6 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithOpt3(
   return GBREG;
 }
 
-template <int UNOPT>
-std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithTemplateUnopt(
-    CJBig2_ArithDecoder* pArithDecoder,
-    pdfium::span<JBig2ArithCtx> gbContexts) {
-  auto GBREG = std::make_unique<CJBig2_Image>(GBW, GBH);
-  if (!GBREG->has_data()) {
-    return nullptr;
-  }
-
-  GBREG->Fill(false);
-  int LTP = 0;
-  const uint8_t MOD2 = UNOPT % 2;
-  const uint8_t DIV2 = UNOPT / 2;
-  const uint8_t SHIFT = 4 - UNOPT;
-  pdfium::span<uint8_t> row_write;
-  pdfium::span<const uint8_t> row_prev1;
-  pdfium::span<const uint8_t> row_prev2;
-  for (uint32_t h = 0; h < GBH; h++) {
-    row_prev2 = row_prev1;
-    row_prev1 = row_write;
-    row_write = GBREG->GetLine(h);
-    if (TPGDON) {
-      if (pArithDecoder->IsComplete()) {
-        return nullptr;
-      }
-
-      LTP = LTP ^ pArithDecoder->Decode(&gbContexts[kOptConstant1[UNOPT]]);
-      if (LTP) {
-        GBREG->CopyLine(row_write, row_prev1);
-        continue;
-      }
-    }
-
-    pdfium::span<const uint8_t> row_skip;
-    if (USESKIP) {
-      row_skip = SKIP->GetLine(h);
-    }
-    pdfium::span<const uint8_t> row_gbat0 = GBREG->GetLine(h + GBAT[1]);
-    pdfium::span<const uint8_t> row_gbat1;
-    pdfium::span<const uint8_t> row_gbat2;
-    pdfium::span<const uint8_t> row_gbat3;
-    if (UNOPT == 0) {
-      row_gbat1 = GBREG->GetLine(h + GBAT[3]);
-      row_gbat2 = GBREG->GetLine(h + GBAT[5]);
-      row_gbat3 = GBREG->GetLine(h + GBAT[7]);
-    }
-
-    uint32_t val_prev2 = GBREG->GetPixel(1 + MOD2, row_prev2);
-    val_prev2 |= GBREG->GetPixel(MOD2, row_prev2) << 1;
-    if (UNOPT == 1) {
-      val_prev2 |= GBREG->GetPixel(0, row_prev2) << 2;
-    }
-    uint32_t val_prev1 = GBREG->GetPixel(2 - DIV2, row_prev1);
-    val_prev1 |= GBREG->GetPixel(1 - DIV2, row_prev1) << 1;
-    if (UNOPT < 2) {
-      val_prev1 |= GBREG->GetPixel(0, row_prev1) << 2;
-    }
-    uint32_t val_current = 0;
-    for (uint32_t w = 0; w < GBW; w++) {
-      int bVal = 0;
-      if (!USESKIP || !SKIP->GetPixel(w, row_skip)) {
-        if (pArithDecoder->IsComplete()) {
-          return nullptr;
-        }
-
-        uint32_t CONTEXT = val_current;
-        CONTEXT |= GBREG->GetPixel(w + GBAT[0], row_gbat0) << SHIFT;
-        CONTEXT |= val_prev1 << (SHIFT + 1);
-        CONTEXT |= val_prev2 << kOptConstant9[UNOPT];
-        if (UNOPT == 0) {
-          CONTEXT |= GBREG->GetPixel(w + GBAT[2], row_gbat1) << 10;
-          CONTEXT |= GBREG->GetPixel(w + GBAT[4], row_gbat2) << 11;
-          CONTEXT |= GBREG->GetPixel(w + GBAT[6], row_gbat3) << 15;
-        }
-        bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-        if (bVal) {
-          GBREG->SetPixel(w, row_write, bVal);
-        }
-      }
-      val_prev2 =
-          ((val_prev2 << 1) | GBREG->GetPixel(w + 2 + MOD2, row_prev2)) &
-          kOptConstant10[UNOPT];
-      val_prev1 =
-          ((val_prev1 << 1) | GBREG->GetPixel(w + 3 - DIV2, row_prev1)) &
-          kOptConstant11[UNOPT];
-      val_current = ((val_current << 1) | bVal) & kOptConstant12[UNOPT];
-    }
-  }
-  return GBREG;
-}
-
 std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithTemplate3Opt3(
     CJBig2_ArithDecoder* pArithDecoder,
     pdfium::span<JBig2ArithCtx> gbContexts) {
@@ -416,7 +393,7 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithTemplate3Opt3(
   return GBREG;
 }
 
-std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithTemplate3Unopt(
+std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithGeneric(
     CJBig2_ArithDecoder* pArithDecoder,
     pdfium::span<JBig2ArithCtx> gbContexts) {
   auto GBREG = std::make_unique<CJBig2_Image>(GBW, GBH);
@@ -425,53 +402,120 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithTemplate3Unopt(
   }
 
   GBREG->Fill(false);
+  const uint32_t tp_context =
+      kGenericTemplateLayouts[std::min<uint8_t>(GBTEMPLATE, 3)].tp_context;
   int LTP = 0;
-  pdfium::span<uint8_t> row_write;
-  pdfium::span<const uint8_t> row_prev;
-  for (uint32_t h = 0; h < GBH; h++) {
-    row_prev = row_write;
-    row_write = GBREG->GetLine(h);
+  for (int32_t h = 0; h < static_cast<int32_t>(GBH); h++) {
     if (TPGDON) {
       if (pArithDecoder->IsComplete()) {
         return nullptr;
       }
 
-      LTP = LTP ^ pArithDecoder->Decode(&gbContexts[0x0195]);
+      LTP = LTP ^ pArithDecoder->Decode(&gbContexts[tp_context]);
       if (LTP) {
-        GBREG->CopyLine(row_write, row_prev);
+        GBREG->CopyLine(GBREG->GetLine(h), GBREG->GetLine(h - 1));
         continue;
       }
     }
-
-    pdfium::span<const uint8_t> row_skip;
-    if (USESKIP) {
-      row_skip = SKIP->GetLine(h);
+    if (!DecodeArithGenericLine(pArithDecoder, gbContexts, GBREG.get(), h)) {
+      return nullptr;
     }
-    pdfium::span<const uint8_t> row_gbat = GBREG->GetLine(h + GBAT[1]);
+  }
+  return GBREG;
+}
 
-    uint32_t val_prev = GBREG->GetPixel(1, row_prev);
-    val_prev |= GBREG->GetPixel(0, row_prev) << 1;
-    uint32_t val_current = 0;
-    for (uint32_t w = 0; w < GBW; w++) {
+bool CJBig2_GRDProc::DecodeArithGenericLine(
+    CJBig2_ArithDecoder* pArithDecoder,
+    pdfium::span<JBig2ArithCtx> gbContexts,
+    CJBig2_Image* image,
+    int32_t h) {
+  switch (GBTEMPLATE) {
+    case 0:
+      return DecodeArithLine<0>(pArithDecoder, gbContexts, image, h);
+    case 1:
+      return DecodeArithLine<1>(pArithDecoder, gbContexts, image, h);
+    case 2:
+      return DecodeArithLine<2>(pArithDecoder, gbContexts, image, h);
+    default:
+      return DecodeArithLine<3>(pArithDecoder, gbContexts, image, h);
+  }
+}
+
+template <int TEMPLATE>
+bool CJBig2_GRDProc::DecodeArithLine(CJBig2_ArithDecoder* pArithDecoder,
+                                     pdfium::span<JBig2ArithCtx> gbContexts,
+                                     CJBig2_Image* image,
+                                     int32_t h) {
+  // Rather than reading each pixel of the template on its own, read 64 pixels
+  // of each row above at a time, and keep the pixels decoded so far on this
+  // row in `history`, with the last one in the lowest bit. `image` starts out
+  // clear, so pixels to the right and below read as 0.
+  static constexpr GenericTemplateLayout kLayout =
+      kGenericTemplateLayouts[TEMPLATE];
+  pdfium::span<uint8_t> row_write = image->GetLine(h);
+  pdfium::span<const uint8_t> row_prev1 = image->GetLine(h - 1);
+  pdfium::span<const uint8_t> row_prev2 = image->GetLine(h - 2);
+  pdfium::span<const uint8_t> row_skip;
+  if (USESKIP) {
+    row_skip = SKIP->GetLine(h);
+  }
+
+  // AT pixels within a byte to the left on this row come from `history`. The
+  // others are read a word at a time like the rows above, as the bytes before
+  // the one being decoded are already written.
+  std::array<pdfium::span<const uint8_t>, kLayout.at_count> at_rows;
+  std::array<int, kLayout.at_count> at_history_shifts;
+  for (size_t i = 0; i < kLayout.at_count; ++i) {
+    const int dx = GBAT[2 * i];
+    const int dy = GBAT[2 * i + 1];
+    at_history_shifts[i] = dy == 0 && dx < 0 && dx > -8 ? -dx - 1 : -1;
+    if (dy < 0 || (dy == 0 && dx <= -8)) {
+      at_rows[i] = image->GetLine(h + dy);
+    }
+  }
+
+  const int64_t width = GBW;
+  uint64_t history = 0;
+  for (int64_t x0 = 0; x0 < width; x0 += 8) {
+    const uint64_t prev1 = image->GetPixelWord(x0 - 16, row_prev1);
+    const uint64_t prev2 = image->GetPixelWord(x0 - 16, row_prev2);
+    std::array<uint64_t, kLayout.at_count> at_words;
+    for (size_t i = 0; i < kLayout.at_count; ++i) {
+      at_words[i] = image->GetPixelWord(x0 + GBAT[2 * i], at_rows[i]);
+    }
+    const uint64_t skip = USESKIP ? SKIP->GetPixelWord(x0, row_skip) : 0;
+    const int count = static_cast<int>(std::min<int64_t>(8, width - x0));
+    const size_t byte_index = static_cast<size_t>(x0 / 8);
+    uint8_t cVal = 0;
+    for (int k = 0; k < count; ++k) {
       int bVal = 0;
-      if (!USESKIP || !SKIP->GetPixel(w, row_skip)) {
-        uint32_t CONTEXT = val_current;
-        CONTEXT |= GBREG->GetPixel(w + GBAT[0], row_gbat) << 4;
-        CONTEXT |= val_prev << 5;
+      if (!((skip >> (63 - k)) & 1)) {
         if (pArithDecoder->IsComplete()) {
-          return nullptr;
+          row_write[byte_index] = cVal;
+          return false;
         }
 
+        uint32_t CONTEXT = static_cast<uint32_t>(history) &
+                           ((1u << kLayout.current_bits) - 1);
+        CONTEXT |= GetRun(prev1, k, kLayout.prev1_offset, kLayout.prev1_bits)
+                   << kLayout.prev1_shift;
+        CONTEXT |= GetRun(prev2, k, kLayout.prev2_offset, kLayout.prev2_bits)
+                   << kLayout.prev2_shift;
+        for (size_t i = 0; i < kLayout.at_count; ++i) {
+          uint64_t pixel = at_words[i] >> (63 - k);
+          if (at_history_shifts[i] >= 0) {
+            pixel = history >> at_history_shifts[i];
+          }
+          CONTEXT |= static_cast<uint32_t>(pixel & 1) << kLayout.at_shifts[i];
+        }
         bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
+        cVal |= bVal << (7 - k);
       }
-      if (bVal) {
-        GBREG->SetPixel(w, row_write, bVal);
-      }
-      val_prev = ((val_prev << 1) | GBREG->GetPixel(w + 2, row_prev)) & 0x1f;
-      val_current = ((val_current << 1) | bVal) & 0x0f;
+      history = (history << 1) | bVal;
     }
+    row_write[byte_index] = cVal;
   }
-  return GBREG;
+  return true;
 }
 
 FXCODEC_STATUS CJBig2_GRDProc::StartDecodeArith(
@@ -511,22 +555,22 @@ FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArith(
     case 0:
       func = UseTemplate0Opt3()
                  ? &CJBig2_GRDProc::ProgressiveDecodeArithTemplate0Opt3
-                 : &CJBig2_GRDProc::ProgressiveDecodeArithTemplate0Unopt;
+                 : &CJBig2_GRDProc::ProgressiveDecodeArithGeneric;
       break;
     case 1:
       func = UseTemplate1Opt3()
                  ? &CJBig2_GRDProc::ProgressiveDecodeArithTemplate1Opt3
-                 : &CJBig2_GRDProc::ProgressiveDecodeArithTemplate1Unopt;
+                 : &CJBig2_GRDProc::ProgressiveDecodeArithGeneric;
       break;
     case 2:
       func = UseTemplate23Opt3()
                  ? &CJBig2_GRDProc::ProgressiveDecodeArithTemplate2Opt3
-                 : &CJBig2_GRDProc::ProgressiveDecodeArithTemplate2Unopt;
+                 : &CJBig2_GRDProc::ProgressiveDecodeArithGeneric;
       break;
     default:
       func = UseTemplate23Opt3()
                  ? &CJBig2_GRDProc::ProgressiveDecodeArithTemplate3Opt3
-                 : &CJBig2_GRDProc::ProgressiveDecodeArithTemplate3Unopt;
+                 : &CJBig2_GRDProc::ProgressiveDecodeArithGeneric;
       break;
   }
   CJBig2_Image* pImage = pState->pImage->get();
@@ -622,83 +666,6 @@ FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate0Opt3(
   return FXCODEC_STATUS::kDecodeFinished;
 }
 
-FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate0Unopt(
-    ProgressiveArithDecodeState* pState) {
-  CJBig2_Image* pImage = pState->pImage->get();
-  pdfium::span<JBig2ArithCtx> gbContexts = pState->gbContexts;
-  CJBig2_ArithDecoder* pArithDecoder = pState->pArithDecoder;
-  pdfium::span<uint8_t> row_write = pImage->GetLine(loop_index_ - 1);
-  pdfium::span<const uint8_t> row_prev1 = pImage->GetLine(loop_index_ - 2);
-  pdfium::span<const uint8_t> row_prev2;
-  for (; loop_index_ < GBH; loop_index_++) {
-    row_prev2 = row_prev1;
-    row_prev1 = row_write;
-    row_write = pImage->GetLine(loop_index_);
-    if (TPGDON) {
-      if (pArithDecoder->IsComplete()) {
-        return FXCODEC_STATUS::kError;
-      }
-
-      ltp_ = ltp_ ^ pArithDecoder->Decode(&gbContexts[0x9b25]);
-    }
-    if (ltp_) {
-      pImage->CopyLine(row_write, row_prev1);
-    } else {
-      pdfium::span<const uint8_t> row_skip;
-      if (USESKIP) {
-        row_skip = SKIP->GetLine(loop_index_);
-      }
-      pdfium::span<const uint8_t> row_gbat0 =
-          pImage->GetLine(loop_index_ + GBAT[1]);
-      pdfium::span<const uint8_t> row_gbat1 =
-          pImage->GetLine(loop_index_ + GBAT[3]);
-      pdfium::span<const uint8_t> row_gbat2 =
-          pImage->GetLine(loop_index_ + GBAT[5]);
-      pdfium::span<const uint8_t> row_gbat3 =
-          pImage->GetLine(loop_index_ + GBAT[7]);
-
-      uint32_t val_prev2 = pImage->GetPixel(1, row_prev2);
-      val_prev2 |= pImage->GetPixel(0, row_prev2) << 1;
-      uint32_t val_prev1 = pImage->GetPixel(2, row_prev1);
-      val_prev1 |= pImage->GetPixel(1, row_prev1) << 1;
-      val_prev1 |= pImage->GetPixel(0, row_prev1) << 2;
-      uint32_t val_current = 0;
-      for (uint32_t w = 0; w < GBW; w++) {
-        int bVal = 0;
-        if (!USESKIP || !SKIP->GetPixel(w, row_skip)) {
-          uint32_t CONTEXT = val_current;
-          CONTEXT |= pImage->GetPixel(w + GBAT[0], row_gbat0) << 4;
-          CONTEXT |= val_prev1 << 5;
-          CONTEXT |= pImage->GetPixel(w + GBAT[2], row_gbat1) << 10;
-          CONTEXT |= pImage->GetPixel(w + GBAT[4], row_gbat2) << 11;
-          CONTEXT |= val_prev2 << 12;
-          CONTEXT |= pImage->GetPixel(w + GBAT[6], row_gbat3) << 15;
-          if (pArithDecoder->IsComplete()) {
-            return FXCODEC_STATUS::kError;
-          }
-
-          bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-        }
-        if (bVal) {
-          pImage->SetPixel(w, row_write, bVal);
-        }
-        val_prev2 =
-            ((val_prev2 << 1) | pImage->GetPixel(w + 2, row_prev2)) & 0x07;
-        val_prev1 =
-            ((val_prev1 << 1) | pImage->GetPixel(w + 3, row_prev1)) & 0x1f;
-        val_current = ((val_current << 1) | bVal) & 0x0f;
-      }
-    }
-    if (pState->pPause && pState->pPause->NeedToPauseNow()) {
-      loop_index_++;
-      progressive_status_ = FXCODEC_STATUS::kDecodeToBeContinued;
-      return FXCODEC_STATUS::kDecodeToBeContinued;
-    }
-  }
-  progressive_status_ = FXCODEC_STATUS::kDecodeFinished;
-  return FXCODEC_STATUS::kDecodeFinished;
-}
-
 FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate1Opt3(
     ProgressiveArithDecodeState* pState) {
   CJBig2_Image* pImage = pState->pImage->get();
@@ -732,75 +699,6 @@ FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate1Opt3(
   return FXCODEC_STATUS::kDecodeFinished;
 }
 
-FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate1Unopt(
-    ProgressiveArithDecodeState* pState) {
-  CJBig2_Image* pImage = pState->pImage->get();
-  pdfium::span<JBig2ArithCtx> gbContexts = pState->gbContexts;
-  CJBig2_ArithDecoder* pArithDecoder = pState->pArithDecoder;
-  pdfium::span<uint8_t> row_write = pImage->GetLine(loop_index_ - 1);
-  pdfium::span<const uint8_t> row_prev1 = pImage->GetLine(loop_index_ - 2);
-  pdfium::span<const uint8_t> row_prev2;
-  for (; loop_index_ < GBH; loop_index_++) {
-    row_prev2 = row_prev1;
-    row_prev1 = row_write;
-    row_write = pImage->GetLine(loop_index_);
-    if (TPGDON) {
-      if (pArithDecoder->IsComplete()) {
-        return FXCODEC_STATUS::kError;
-      }
-
-      ltp_ = ltp_ ^ pArithDecoder->Decode(&gbContexts[0x0795]);
-    }
-    if (ltp_) {
-      pImage->CopyLine(row_write, row_prev1);
-    } else {
-      pdfium::span<const uint8_t> row_skip;
-      if (USESKIP) {
-        row_skip = SKIP->GetLine(loop_index_);
-      }
-      pdfium::span<const uint8_t> row_gbat =
-          pImage->GetLine(loop_index_ + GBAT[1]);
-
-      uint32_t val_prev2 = pImage->GetPixel(2, row_prev2);
-      val_prev2 |= pImage->GetPixel(1, row_prev2) << 1;
-      val_prev2 |= pImage->GetPixel(0, row_prev2) << 2;
-      uint32_t val_prev1 = pImage->GetPixel(2, row_prev1);
-      val_prev1 |= pImage->GetPixel(1, row_prev1) << 1;
-      val_prev1 |= pImage->GetPixel(0, row_prev1) << 2;
-      uint32_t val_current = 0;
-      for (uint32_t w = 0; w < GBW; w++) {
-        int bVal = 0;
-        if (!USESKIP || !SKIP->GetPixel(w, row_skip)) {
-          uint32_t CONTEXT = val_current;
-          CONTEXT |= pImage->GetPixel(w + GBAT[0], row_gbat) << 3;
-          CONTEXT |= val_prev1 << 4;
-          CONTEXT |= val_prev2 << 9;
-          if (pArithDecoder->IsComplete()) {
-            return FXCODEC_STATUS::kError;
-          }
-
-          bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-        }
-        if (bVal) {
-          pImage->SetPixel(w, row_write, bVal);
-        }
-        val_prev2 =
-            ((val_prev2 << 1) | pImage->GetPixel(w + 3, row_prev2)) & 0x0f;
-        val_prev1 =
-            ((val_prev1 << 1) | pImage->GetPixel(w + 3, row_prev1)) & 0x1f;
-        val_current = ((val_current << 1) | bVal) & 0x07;
-      }
-    }
-    if (pState->pPause && pState->pPause->NeedToPauseNow()) {
-      loop_index_++;
-      progressive_status_ = FXCODEC_STATUS::kDecodeToBeContinued;
-      return FXCODEC_STATUS::kDecodeToBeContinued;
-    }
-  }
-  progressive_status_ = FXCODEC_STATUS::kDecodeFinished;
-  return FXCODEC_STATUS::kDecodeFinished;
-}
-
 FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate2Opt3(
     ProgressiveArithDecodeState* pState) {
   CJBig2_Image* pImage = pState->pImage->get();
@@ -934,73 +832,6 @@ bool CJBig2_GRDProc::ProgressiveDecodeArithTemplateOpt3Helper(
   return true;
 }
 
-FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate2Unopt(
-    ProgressiveArithDecodeState* pState) {
-  CJBig2_Image* pImage = pState->pImage->get();
-  pdfium::span<JBig2ArithCtx> gbContexts = pState->gbContexts;
-  CJBig2_ArithDecoder* pArithDecoder = pState->pArithDecoder;
-  pdfium::span<uint8_t> row_write = pImage->GetLine(loop_index_ - 1);
-  pdfium::span<const uint8_t> row_prev1 = pImage->GetLine(loop_index_ - 2);
-  pdfium::span<const uint8_t> row_prev2;
-  for (; loop_index_ < GBH; loop_index_++) {
-    row_prev2 = row_prev1;
-    row_prev1 = row_write;
-    row_write = pImage->GetLine(loop_index_);
-    if (TPGDON) {
-      if (pArithDecoder->IsComplete()) {
-        return FXCODEC_STATUS::kError;
-      }
-
-      ltp_ = ltp_ ^ pArithDecoder->Decode(&gbContexts[0x00e5]);
-    }
-    if (ltp_) {
-      pImage->CopyLine(row_write, row_prev1);
-    } else {
-      pdfium::span<const uint8_t> row_skip;
-      if (USESKIP) {
-        row_skip = SKIP->GetLine(loop_index_);
-      }
-      pdfium::span<const uint8_t> row_gbat =
-          pImage->GetLine(loop_index_ + GBAT[1]);
-
-      uint32_t val_prev2 = pImage->GetPixel(1, row_prev2);
-      val_prev2 |= pImage->GetPixel(0, row_prev2) << 1;
-      uint32_t val_prev1 = pImage->GetPixel(1, row_prev1);
-      val_prev1 |= pImage->GetPixel(0, row_prev1) << 1;
-      uint32_t val_current = 0;
-      for (uint32_t w = 0; w < GBW; w++) {
-        int bVal = 0;
-        if (!USESKIP || !SKIP->GetPixel(w, row_skip)) {
-          uint32_t CONTEXT = val_current;
-          CONTEXT |= pImage->GetPixel(w + GBAT[0], row_gbat) << 2;
-          CONTEXT |= val_prev1 << 3;
-          CONTEXT |= val_prev2 << 7;
-          if (pArithDecoder->IsComplete()) {
-            return FXCODEC_STATUS::kError;
-          }
-
-          bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-        }
-        if (bVal) {
-          pImage->SetPixel(w, row_write, bVal);
-        }
-        val_prev2 =
-            ((val_prev2 << 1) | pImage->GetPixel(w + 2, row_prev2)) & 0x07;
-        val_prev1 =
-            ((val_prev1 << 1) | pImage->GetPixel(w + 2, row_prev1)) & 0x0f;
-        val_current = ((val_current << 1) | bVal) & 0x03;
-      }
-    }
-    if (pState->pPause && pState->pPause->NeedToPauseNow()) {
-      loop_index_++;
-      progressive_status_ = FXCODEC_STATUS::kDecodeToBeContinued;
-      return FXCODEC_STATUS::kDecodeToBeContinued;
-    }
-  }
-  progressive_status_ = FXCODEC_STATUS::kDecodeFinished;
-  return FXCODEC_STATUS::kDecodeFinished;
-}
-
 FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate3Opt3(
     ProgressiveArithDecodeState* pState) {
   CJBig2_Image* pImage = pState->pImage->get();
@@ -1092,54 +923,27 @@ FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate3Opt3(
   return FXCODEC_STATUS::kDecodeFinished;
 }
 
-FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate3Unopt(
+FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithGeneric(
     ProgressiveArithDecodeState* pState) {
   CJBig2_Image* pImage = pState->pImage->get();
   pdfium::span<JBig2ArithCtx> gbContexts = pState->gbContexts;
   CJBig2_ArithDecoder* pArithDecoder = pState->pArithDecoder;
-  pdfium::span<uint8_t> row_write = pImage->GetLine(loop_index_ - 1);
-  pdfium::span<const uint8_t> row_prev;
+  const uint32_t tp_context =
+      kGenericTemplateLayouts[std::min<uint8_t>(GBTEMPLATE, 3)].tp_context;
   for (; loop_index_ < GBH; loop_index_++) {
-    row_prev = row_write;
-    row_write = pImage->GetLine(loop_index_);
+    const int32_t h = static_cast<int32_t>(loop_index_);
     if (TPGDON) {
       if (pArithDecoder->IsComplete()) {
         return FXCODEC_STATUS::kError;
       }
 
-      ltp_ = ltp_ ^ pArithDecoder->Decode(&gbContexts[0x0195]);
+      ltp_ = ltp_ ^ pArithDecoder->Decode(&gbContexts[tp_context]);
     }
     if (ltp_) {
-      pImage->CopyLine(row_write, row_prev);
-    } else {
-      pdfium::span<const uint8_t> row_skip;
-      if (USESKIP) {
-        row_skip = SKIP->GetLine(loop_index_);
-      }
-      pdfium::span<const uint8_t> row_gbat =
-          pImage->GetLine(loop_index_ + GBAT[1]);
-
-      uint32_t val_prev = pImage->GetPixel(1, row_prev);
-      val_prev |= pImage->GetPixel(0, row_prev) << 1;
-      uint32_t val_current = 0;
-      for (uint32_t w = 0; w < GBW; w++) {
-        int bVal = 0;
-        if (!USESKIP || !SKIP->GetPixel(w, row_skip)) {
-          uint32_t CONTEXT = val_current;
-          CONTEXT |= pImage->GetPixel(w + GBAT[0], row_gbat) << 4;
-          CONTEXT |= val_prev << 5;
-          if (pArithDecoder->IsComplete()) {
-            return FXCODEC_STATUS::kError;
-          }
-
-          bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-        }
-        if (bVal) {
-          pImage->SetPixel(w, row_write, bVal);
-        }
-        val_prev = ((val_prev << 1) | pImage->GetPixel(w + 2, row_prev)) & 0x1f;
-        val_current = ((val_current << 1) | bVal) & 0x0f;
-      }
+      pImage->CopyLine(pImage->GetLine(h), pImage->GetLine(h - 1));
+    } else if (!DecodeArithGenericLine(pArithDecoder, gbContexts, pImage,
+                                       h)) {
+      return FXCODEC_STATUS::kError;
     }
     if (pState->pPause && pState->pPause->NeedToPauseNow()) {
       loop_index_++;
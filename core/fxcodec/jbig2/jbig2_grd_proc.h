@@ -80,19 +80,14 @@ class CJBig2_GRDProc {
   FXCODEC_STATUS ProgressiveDecodeArith(ProgressiveArithDecodeState* pState);
   FXCODEC_STATUS ProgressiveDecodeArithTemplate0Opt3(
       ProgressiveArithDecodeState* pState);
-  FXCODEC_STATUS ProgressiveDecodeArithTemplate0Unopt(
-      ProgressiveArithDecodeState* pState);
   FXCODEC_STATUS ProgressiveDecodeArithTemplate1Opt3(
       ProgressiveArithDecodeState* pState);
-  FXCODEC_STATUS ProgressiveDecodeArithTemplate1Unopt(
-      ProgressiveArithDecodeState* pState);
   FXCODEC_STATUS ProgressiveDecodeArithTemplate2Opt3(
       ProgressiveArithDecodeState* pState);
-  FXCODEC_STATUS ProgressiveDecodeArithTemplate2Unopt(
-      ProgressiveArithDecodeState* pState);
   FXCODEC_STATUS ProgressiveDecodeArithTemplate3Opt3(
       ProgressiveArithDecodeState* pState);
-  FXCODEC_STATUS ProgressiveDecodeArithTemplate3Unopt(
+
+  FXCODEC_STATUS ProgressiveDecodeArithGeneric(
       ProgressiveArithDecodeState* pState);
 
   bool ProgressiveDecodeArithTemplateOpt3Helper(
@@ -108,17 +103,26 @@ class CJBig2_GRDProc {
   std::unique_ptr<CJBig2_Image> DecodeArithOpt3(
       CJBig2_ArithDecoder* pArithDecoder,
       pdfium::span<JBig2ArithCtx> gbContexts);
-  template <int UNOPT>
-  std::unique_ptr<CJBig2_Image> DecodeArithTemplateUnopt(
-      CJBig2_ArithDecoder* pArithDecoder,
-      pdfium::span<JBig2ArithCtx> gbContexts);
   std::unique_ptr<CJBig2_Image> DecodeArithTemplate3Opt3(
       CJBig2_ArithDecoder* pArithDecoder,
       pdfium::span<JBig2ArithCtx> gbContexts);
-  std::unique_ptr<CJBig2_Image> DecodeArithTemplate3Unopt(
+
+  // Decodes with any template, AT pixels and skip mask.
+  std::unique_ptr<CJBig2_Image> DecodeArithGeneric(
       CJBig2_ArithDecoder* pArithDecoder,
       pdfium::span<JBig2ArithCtx> gbContexts);
 
+  // Decodes line `h` of `image`, which must still be clear from line `h` on.
+  bool DecodeArithGenericLine(CJBig2_ArithDecoder* pArithDecoder,
+                              pdfium::span<JBig2ArithCtx> gbContexts,
+                              CJBig2_Image* image,
+                              int32_t h);
+  template <int TEMPLATE>
+  bool DecodeArithLine(CJBig2_ArithDecoder* pArithDecoder,
+                       pdfium::span<JBig2ArithCtx> gbContexts,
+                       CJBig2_Image* image,
+                       int32_t h);
+
   uint32_t loop_index_ = 0;
   pdfium::raw_span<const uint8_t> line_prev2_;
   pdfium::raw_span<const uint8_t> line_prev1_;
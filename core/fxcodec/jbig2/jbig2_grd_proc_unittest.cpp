@@ -0,0 +1,204 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/jbig2/jbig2_grd_proc.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "core/fxcodec/jbig2/jbig2_arith_decoder.h"
+#include "core/fxcodec/jbig2/jbig2_bit_stream.h"
+#include "core/fxcodec/jbig2/jbig2_image.h"
+#include "core/fxcrt/pauseindicator_iface.h"
+#include "core/fxcrt/span.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr std::array<uint32_t, 4> kTypicalPredictionContexts = {
+    0x9b25, 0x0795, 0x00e5, 0x0195};
+
+class AlwaysPause final : public PauseIndicatorIface {
+ public:
+  bool NeedToPauseNow() override { return true; }
+};
+
+std::vector<uint8_t> MakeRandomData(size_t size, uint32_t seed) {
+  std::vector<uint8_t> data(size);
+  for (uint8_t& byte : data) {
+    seed = seed * 1103515245 + 12345;
+    byte = static_cast<uint8_t>(seed >> 16);
+  }
+  return data;
+}
+
+// Returns the context of the pixel at (`x`, `y`) by reading each pixel of the
+// template on its own, as laid out in 6.2.5.3 of the JBIG2 specification.
+uint32_t GetContext(const CJBig2_GRDProc& proc,
+                    const CJBig2_Image& image,
+                    int32_t x,
+                    int32_t y) {
+  auto pixel = [&](int dx, int dy) -> uint32_t {
+    return image.GetPixel(x + dx, image.GetLine(y + dy));
+  };
+  auto at = [&](int i) {
+    return pixel(proc.GBAT[2 * i], proc.GBAT[2 * i + 1]);
+  };
+  switch (proc.GBTEMPLATE) {
+    case 0:
+      return pixel(-1, 0) | pixel(-2, 0) << 1 | pixel(-3, 0) << 2 |
+             pixel(-4, 0) << 3 | at(0) << 4 | pixel(2, -1) << 5 |
+             pixel(1, -1) << 6 | pixel(0, -1) << 7 | pixel(-1, -1) << 8 |
+             pixel(-2, -1) << 9 | at(1) << 10 | at(2) << 11 |
+             pixel(1, -2) << 12 | pixel(0, -2) << 13 | pixel(-1, -2) << 14 |
+             at(3) << 15;
+    case 1:
+      return pixel(-1, 0) | pixel(-2, 0) << 1 | pixel(-3, 0) << 2 |
+             at(0) << 3 | pixel(2, -1) << 4 | pixel(1, -1) << 5 |
+             pixel(0, -1) << 6 | pixel(-1, -1) << 7 | pixel(-2, -1) << 8 |
+             pixel(2, -2) << 9 | pixel(1, -2) << 10 | pixel(0, -2) << 11 |
+             pixel(-1, -2) << 12;
+    case 2:
+      return pixel(-1, 0) | pixel(-2, 0) << 1 | at(0) << 2 |
+             pixel(1, -1) << 3 | pixel(0, -1) << 4 | pixel(-1, -1) << 5 |
+             pixel(-2, -1) << 6 | pixel(1, -2) << 7 | pixel(0, -2) << 8 |
+             pixel(-1, -2) << 9;
+    default:
+      return pixel(-1, 0) | pixel(-2, 0) << 1 | pixel(-3, 0) << 2 |
+             pixel(-4, 0) << 3 | at(0) << 4 | pixel(1, -1) << 5 |
+             pixel(0, -1) << 6 | pixel(-1, -1) << 7 | pixel(-2, -1) << 8 |
+             pixel(-3, -1) << 9;
+  }
+}
+
+std::unique_ptr<CJBig2_Image> DecodeReference(
+    const CJBig2_GRDProc& proc,
+    CJBig2_ArithDecoder* decoder,
+    pdfium::span<JBig2ArithCtx> contexts) {
+  auto image = std::make_unique<CJBig2_Image>(proc.GBW, proc.GBH);
+  image->Fill(false);
+  int ltp = 0;
+  for (int32_t y = 0; y < static_cast<int32_t>(proc.GBH); ++y) {
+    if (proc.TPGDON) {
+      ltp ^= decoder->Decode(
+          &contexts[kTypicalPredictionContexts[proc.GBTEMPLATE]]);
+      if (ltp) {
+        image->CopyLine(image->GetLine(y), image->GetLine(y - 1));
+        continue;
+      }
+    }
+    for (int32_t x = 0; x < static_cast<int32_t>(proc.GBW); ++x) {
+      if (proc.USESKIP && proc.SKIP->GetPixel(x, proc.SKIP->GetLine(y))) {
+        continue;
+      }
+      image->SetPixel(x, image->GetLine(y),
+                      decoder->Decode(&contexts[GetContext(proc, *image, x,
+                                                           y)]));
+    }
+  }
+  return image;
+}
+
+// Decodes the same data with `proc`, both at once and a line at a time, and
+// with the reference decoder above, and checks that the images match.
+void CheckSameAsReference(CJBig2_GRDProc& proc) {
+  const std::vector<uint8_t> data = MakeRandomData(
+      16384, proc.GBTEMPLATE * 7 + proc.GBW + proc.GBAT[0] * 31);
+  const size_t context_count = size_t{1} << 16;
+
+  CJBig2_BitStream expected_stream(data, 0);
+  CJBig2_ArithDecoder expected_decoder(&expected_stream);
+  std::vector<JBig2ArithCtx> expected_contexts(context_count);
+  std::unique_ptr<CJBig2_Image> expected =
+      DecodeReference(proc, &expected_decoder, expected_contexts);
+
+  CJBig2_BitStream stream(data, 0);
+  CJBig2_ArithDecoder decoder(&stream);
+  std::vector<JBig2ArithCtx> contexts(context_count);
+  std::unique_ptr<CJBig2_Image> image = proc.DecodeArith(&decoder, contexts);
+  ASSERT_TRUE(image);
+  EXPECT_TRUE(std::ranges::equal(expected->span(), image->span()));
+
+  CJBig2_BitStream progressive_stream(data, 0);
+  CJBig2_ArithDecoder progressive_decoder(&progressive_stream);
+  std::vector<JBig2ArithCtx> progressive_contexts(context_count);
+  std::unique_ptr<CJBig2_Image> progressive_image;
+  AlwaysPause pause;
+  CJBig2_GRDProc::ProgressiveArithDecodeState state;
+  state.pImage = &progressive_image;
+  state.pArithDecoder = &progressive_decoder;
+  state.gbContexts = progressive_contexts;
+  state.pPause = &pause;
+  FXCODEC_STATUS status = proc.StartDecodeArith(&state);
+  while (status == FXCODEC_STATUS::kDecodeToBeContinued) {
+    status = proc.ContinueDecode(&state);
+  }
+  ASSERT_EQ(FXCODEC_STATUS::kDecodeFinished, status);
+  ASSERT_TRUE(progressive_image);
+  EXPECT_TRUE(
+      std::ranges::equal(expected->span(), progressive_image->span()));
+}
+
+CJBig2_GRDProc MakeProc(uint8_t gb_template,
+                        uint32_t width,
+                        const std::array<int8_t, 8>& gbat) {
+  CJBig2_GRDProc proc;
+  proc.MMR = false;
+  proc.TPGDON = false;
+  proc.USESKIP = false;
+  proc.GBTEMPLATE = gb_template;
+  proc.GBW = width;
+  proc.GBH = 23;
+  proc.GBAT = gbat;
+  return proc;
+}
+
+}  // namespace
+
+TEST(CJBig2GRDProcTest, GenericTemplates) {
+  // AT pixels away from their nominal positions, on the rows above and on the
+  // current row, up to the furthest an AT pixel can be.
+  const std::array<std::array<int8_t, 8>, 4> kGbats = {{
+      {-1, -1, -3, -1, 2, -2, -2, -2},
+      {5, -2, -128, 0, 127, -1, -70, -128},
+      {-65, 0, -64, 0, -9, 0, 0, 0},
+      {1, 0, 3, 2, -5, -1, 7, -3},
+  }};
+  for (uint8_t gb_template = 0; gb_template < 4; ++gb_template) {
+    for (uint32_t width : {1u, 7u, 8u, 9u, 63u, 64u, 65u, 150u}) {
+      for (const auto& gbat : kGbats) {
+        for (bool tpgdon : {false, true}) {
+          SCOPED_TRACE(testing::Message()
+                       << "template " << static_cast<int>(gb_template)
+                       << " width " << width << " gbat " << int{gbat[0]}
+                       << " tpgdon " << tpgdon);
+          CJBig2_GRDProc proc = MakeProc(gb_template, width, gbat);
+          proc.TPGDON = tpgdon;
+          CheckSameAsReference(proc);
+        }
+      }
+    }
+  }
+}
+
+TEST(CJBig2GRDProcTest, GenericSkip) {
+  // The skip mask is narrower than the region, as it can be for halftones.
+  CJBig2_Image skip(70, 23);
+  const std::vector<uint8_t> skip_data = MakeRandomData(skip.span().size(), 5);
+  std::ranges::copy(skip_data, skip.span().begin());
+  for (uint8_t gb_template = 0; gb_template < 4; ++gb_template) {
+    SCOPED_TRACE(static_cast<int>(gb_template));
+    CJBig2_GRDProc proc =
+        MakeProc(gb_template, 77, {3, -1, -3, -1, 2, -2, -2, -2});
+    proc.GBAT[0] = gb_template < 2 ? 3 : 2;
+    proc.USESKIP = true;
+    proc.SKIP = &skip;
+    proc.TPGDON = gb_template % 2;
+    CheckSameAsReference(proc);
+  }
+}
@@ -6,6 +6,7 @@
 
 #include "core/fxcodec/jbig2/jbig2_grrd_proc.h"
 
+#include <algorithm>
 #include <array>
 #include <memory>
 
@@ -14,6 +15,17 @@
 #include "core/fxcodec/jbig2/jbig2_image.h"
 #include "core/fxcrt/zip.h"
 
+namespace {
+
+// Returns the run of `bits` pixels that ends at x + `offset`, for the pixel
+// x that is `k` pixels into a word read from x - k - 16.
+uint32_t GetRun(uint64_t word, int k, int offset, int bits) {
+  return static_cast<uint32_t>(word >> (47 - k - offset)) &
+         ((1u << bits) - 1);
+}
+
+}  // namespace
+
 CJBig2_GRRDProc::CJBig2_GRRDProc() = default;
 
 CJBig2_GRRDProc::~CJBig2_GRRDProc() = default;
@@ -31,17 +43,17 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRRDProc::Decode(
         (GRW == (uint32_t)GRREFERENCE->width())) {
       return DecodeTemplate0Opt(pArithDecoder, grContexts);
     }
-    return DecodeTemplate0Unopt(pArithDecoder, grContexts);
+    return DecodeGeneric(pArithDecoder, grContexts);
   }
 
   if ((GRREFERENCEDX == 0) && (GRW == (uint32_t)GRREFERENCE->width())) {
     return DecodeTemplate1Opt(pArithDecoder, grContexts);
   }
 
-  return DecodeTemplate1Unopt(pArithDecoder, grContexts);
+  return DecodeGeneric(pArithDecoder, grContexts);
 }
 
-std::unique_ptr<CJBig2_Image> CJBig2_GRRDProc::DecodeTemplate0Unopt(
+std::unique_ptr<CJBig2_Image> CJBig2_GRRDProc::DecodeGeneric(
     CJBig2_ArithDecoder* pArithDecoder,
     pdfium::span<JBig2ArithCtx> grContexts) {
   auto GRREG = std::make_unique<CJBig2_Image>(GRW, GRH);
@@ -49,106 +61,104 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRRDProc::DecodeTemplate0Unopt(
     return nullptr;
   }
 
+  // As in CJBig2_GRDProc::DecodeArithLine(), read 64 pixels of each row at a
+  // time, and keep the pixels decoded so far on this row in `history`.
   GRREG->Fill(false);
+  const int64_t width = GRW;
+  const int64_t reference_x = -static_cast<int64_t>(GRREFERENCEDX);
+  const uint32_t tp_context = GRTEMPLATE ? 0x0008 : 0x0010;
   int LTP = 0;
   for (uint32_t h = 0; h < GRH; h++) {
     if (TPGRON) {
       if (pArithDecoder->IsComplete()) {
         return nullptr;
       }
-      LTP = LTP ^ pArithDecoder->Decode(&grContexts[0x0010]);
+      LTP = LTP ^ pArithDecoder->Decode(&grContexts[tp_context]);
     }
 
     pdfium::span<uint8_t> row_write = GRREG->GetLine(h);
     pdfium::span<const uint8_t> row_prev = GRREG->GetLine(h - 1);
     std::array<pdfium::span<const uint8_t>, 3> row_refs_dy = GetRowRefsDy(h);
+    std::array<pdfium::span<const uint8_t>, 3> row_refs;
+    if (LTP) {
+      row_refs = GetRowRefs(h);
+    }
+    pdfium::span<const uint8_t> row_ref_grat;
+    pdfium::span<const uint8_t> row_grat;
+    if (!GRTEMPLATE) {
+      row_ref_grat = GRREFERENCE->GetLine(h - GRREFERENCEDY + GRAT[3]);
+      if (GRAT[1] < 0) {
+        row_grat = GRREG->GetLine(h + GRAT[1]);
+      }
+    }
 
-    std::array<uint32_t, 5> lines;
-    lines[0] = GRREG->GetPixel(1, row_prev);
-    lines[0] |= GRREG->GetPixel(0, row_prev) << 1;
-    lines[1] = 0;
-    lines[2] = GRREFERENCE->GetPixel(-GRREFERENCEDX + 1, row_refs_dy[0]);
-    lines[2] |= GRREFERENCE->GetPixel(-GRREFERENCEDX, row_refs_dy[0]) << 1;
-    lines[3] = GRREFERENCE->GetPixel(-GRREFERENCEDX + 1, row_refs_dy[1]);
-    lines[3] |= GRREFERENCE->GetPixel(-GRREFERENCEDX, row_refs_dy[1]) << 1;
-    lines[3] |= GRREFERENCE->GetPixel(-GRREFERENCEDX - 1, row_refs_dy[1]) << 2;
-    lines[4] = GRREFERENCE->GetPixel(-GRREFERENCEDX + 1, row_refs_dy[2]);
-    lines[4] |= GRREFERENCE->GetPixel(-GRREFERENCEDX, row_refs_dy[2]) << 1;
-    lines[4] |= GRREFERENCE->GetPixel(-GRREFERENCEDX - 1, row_refs_dy[2]) << 2;
-
-    pdfium::span<const uint8_t> row_ref_grat =
-        GRREFERENCE->GetLine(h - GRREFERENCEDY + GRAT[3]);
-    pdfium::span<const uint8_t> row_grat = GRREG->GetLine(h + GRAT[1]);
-    if (!LTP) {
-      for (uint32_t w = 0; w < GRW; w++) {
-        uint32_t CONTEXT = DecodeTemplate0UnoptCalculateContext(
-            *GRREG, lines, w, row_ref_grat, row_grat);
-        if (pArithDecoder->IsComplete()) {
-          return nullptr;
-        }
-
-        int bVal = pArithDecoder->Decode(&grContexts[CONTEXT]);
-        DecodeTemplate0UnoptSetPixel(GRREG.get(), lines, w, bVal, row_refs_dy,
-                                     row_prev, row_write);
+    uint64_t history = 0;
+    for (int64_t x0 = 0; x0 < width; x0 += 8) {
+      const uint64_t prev = GRREG->GetPixelWord(x0 - 16, row_prev);
+      std::array<uint64_t, 3> refs;
+      for (auto [row_ref_dy, ref] : fxcrt::Zip(row_refs_dy, refs)) {
+        ref = GRREFERENCE->GetPixelWord(x0 + reference_x - 16, row_ref_dy);
       }
-    } else {
-      std::array<pdfium::span<const uint8_t>, 3> row_refs = GetRowRefs(h);
-      for (uint32_t w = 0; w < GRW; w++) {
-        int bVal = GRREFERENCE->GetPixel(w, row_refs[1]);
-        if (!TPGRON || !TypicalPrediction(w, bVal, row_refs)) {
-          uint32_t CONTEXT = DecodeTemplate0UnoptCalculateContext(
-              *GRREG, lines, w, row_ref_grat, row_grat);
+      uint64_t ref_grat = 0;
+      uint64_t grat = 0;
+      if (!GRTEMPLATE) {
+        ref_grat = GRREFERENCE->GetPixelWord(x0 + reference_x + GRAT[2],
+                                             row_ref_grat);
+        grat = GRREG->GetPixelWord(x0 + GRAT[0], row_grat);
+      }
+      uint8_t typical = 0;
+      uint8_t typical_values = 0;
+      if (LTP) {
+        typical = GetTypicalPixels(x0, row_refs, &typical_values);
+      }
+      const int count = static_cast<int>(std::min<int64_t>(8, width - x0));
+      uint8_t cVal = 0;
+      for (int k = 0; k < count; ++k) {
+        int bVal;
+        if ((typical >> (7 - k)) & 1) {
+          bVal = (typical_values >> (7 - k)) & 1;
+        } else {
+          uint32_t CONTEXT;
+          if (GRTEMPLATE) {
+            CONTEXT = GetRun(refs[2], k, 1, 2);
+            CONTEXT |= GetRun(refs[1], k, 1, 3) << 2;
+            CONTEXT |= GetRun(refs[0], k, 0, 1) << 5;
+            CONTEXT |= static_cast<uint32_t>(history & 1) << 6;
+            CONTEXT |= GetRun(prev, k, 1, 3) << 7;
+          } else {
+            CONTEXT = GetRun(refs[2], k, 1, 3);
+            CONTEXT |= GetRun(refs[1], k, 1, 3) << 3;
+            CONTEXT |= GetRun(refs[0], k, 1, 2) << 6;
+            CONTEXT |= static_cast<uint32_t>((ref_grat >> (63 - k)) & 1) << 8;
+            CONTEXT |= static_cast<uint32_t>(history & 1) << 9;
+            CONTEXT |= GetRun(prev, k, 1, 2) << 10;
+            uint32_t grat_pixel = 0;
+            if (GRAT[1] < 0) {
+              grat_pixel = (grat >> (63 - k)) & 1;
+            } else if (GRAT[1] == 0 && GRAT[0] < 0) {
+              grat_pixel =
+                  GRAT[0] >= -64
+                      ? static_cast<uint32_t>(history >> (-GRAT[0] - 1)) & 1
+                      : GRREG->GetPixel(static_cast<int32_t>(x0 + k + GRAT[0]),
+                                        row_write);
+            }
+            CONTEXT |= grat_pixel << 12;
+          }
           if (pArithDecoder->IsComplete()) {
             return nullptr;
           }
 
           bVal = pArithDecoder->Decode(&grContexts[CONTEXT]);
         }
-        DecodeTemplate0UnoptSetPixel(GRREG.get(), lines, w, bVal, row_refs_dy,
-                                     row_prev, row_write);
+        cVal |= bVal << (7 - k);
+        history = (history << 1) | bVal;
       }
+      row_write[x0 / 8] = cVal;
     }
   }
   return GRREG;
 }
 
-uint32_t CJBig2_GRRDProc::DecodeTemplate0UnoptCalculateContext(
-    const CJBig2_Image& GRREG,
-    pdfium::span<const uint32_t, 5> lines,
-    uint32_t w,
-    pdfium::span<const uint8_t> row_ref_grat,
-    pdfium::span<const uint8_t> row_grat) const {
-  uint32_t CONTEXT = lines[4];
-  CONTEXT |= lines[3] << 3;
-  CONTEXT |= lines[2] << 6;
-  CONTEXT |= GRREFERENCE->GetPixel(w - GRREFERENCEDX + GRAT[2], row_ref_grat)
-             << 8;
-  CONTEXT |= lines[1] << 9;
-  CONTEXT |= lines[0] << 10;
-  CONTEXT |= GRREG.GetPixel(w + GRAT[0], row_grat) << 12;
-  return CONTEXT;
-}
-
-void CJBig2_GRRDProc::DecodeTemplate0UnoptSetPixel(
-    CJBig2_Image* GRREG,
-    pdfium::span<uint32_t, 5> lines,
-    uint32_t w,
-    int bVal,
-    pdfium::span<pdfium::span<const uint8_t>, 3> row_refs_dy,
-    pdfium::span<const uint8_t> row_prev,
-    pdfium::span<uint8_t> row_write) {
-  GRREG->SetPixel(w, row_write, bVal);
-  const int w_dx = w - GRREFERENCEDX + 2;
-  lines[0] = ((lines[0] << 1) | GRREG->GetPixel(w + 2, row_prev)) & 0x03;
-  lines[1] = ((lines[1] << 1) | bVal) & 0x01;
-  lines[2] =
-      ((lines[2] << 1) | GRREFERENCE->GetPixel(w_dx, row_refs_dy[0])) & 0x03;
-  lines[3] =
-      ((lines[3] << 1) | GRREFERENCE->GetPixel(w_dx, row_refs_dy[1])) & 0x07;
-  lines[4] =
-      ((lines[4] << 1) | GRREFERENCE->GetPixel(w_dx, row_refs_dy[2])) & 0x07;
-}
-
 std::unique_ptr<CJBig2_Image> CJBig2_GRRDProc::DecodeTemplate0Opt(
     CJBig2_ArithDecoder* pArithDecoder,
     pdfium::span<JBig2ArithCtx> grContexts) {
@@ -258,10 +268,14 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRRDProc::DecodeTemplate0Opt(
             }
           }
         }
+        uint8_t typical_values;
+        const uint8_t typical = GetTypicalPixels(w, row_refs, &typical_values);
         uint8_t cVal = 0;
         for (int32_t k = 0; k < nBits; k++) {
-          int bVal = GRREFERENCE->GetPixel(w + k, row_refs[1]);
-          if (!TPGRON || !TypicalPrediction(w + k, bVal, row_refs)) {
+          int bVal;
+          if ((typical >> (7 - k)) & 1) {
+            bVal = (typical_values >> (7 - k)) & 1;
+          } else {
             if (pArithDecoder->IsComplete()) {
               return nullptr;
             }
@@ -282,99 +296,6 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRRDProc::DecodeTemplate0Opt(
   return GRREG;
 }
 
-std::unique_ptr<CJBig2_Image> CJBig2_GRRDProc::DecodeTemplate1Unopt(
-    CJBig2_ArithDecoder* pArithDecoder,
-    pdfium::span<JBig2ArithCtx> grContexts) {
-  auto GRREG = std::make_unique<CJBig2_Image>(GRW, GRH);
-  if (!GRREG->has_data()) {
-    return nullptr;
-  }
-
-  GRREG->Fill(false);
-  int LTP = 0;
-  for (uint32_t h = 0; h < GRH; h++) {
-    if (TPGRON) {
-      if (pArithDecoder->IsComplete()) {
-        return nullptr;
-      }
-      LTP = LTP ^ pArithDecoder->Decode(&grContexts[0x0008]);
-    }
-
-    pdfium::span<uint8_t> row_write = GRREG->GetLine(h);
-    pdfium::span<const uint8_t> row_prev = GRREG->GetLine(h - 1);
-    std::array<pdfium::span<const uint8_t>, 3> row_refs_dy = GetRowRefsDy(h);
-    std::array<uint32_t, 5> lines;
-    lines[0] = GRREG->GetPixel(1, row_prev);
-    lines[0] |= GRREG->GetPixel(0, row_prev) << 1;
-    lines[0] |= GRREG->GetPixel(-1, row_prev) << 2;
-    lines[1] = 0;
-    lines[2] = GRREFERENCE->GetPixel(-GRREFERENCEDX, row_refs_dy[0]);
-    lines[2] = GRREFERENCE->GetPixel(-GRREFERENCEDX, row_refs_dy[0]);
-    lines[3] = GRREFERENCE->GetPixel(-GRREFERENCEDX + 1, row_refs_dy[1]);
-    lines[3] |= GRREFERENCE->GetPixel(-GRREFERENCEDX, row_refs_dy[1]) << 1;
-    lines[3] |= GRREFERENCE->GetPixel(-GRREFERENCEDX - 1, row_refs_dy[1]) << 2;
-    lines[4] = GRREFERENCE->GetPixel(-GRREFERENCEDX + 1, row_refs_dy[2]);
-    lines[4] |= GRREFERENCE->GetPixel(-GRREFERENCEDX, row_refs_dy[2]) << 1;
-
-    if (!LTP) {
-      for (uint32_t w = 0; w < GRW; w++) {
-        uint32_t CONTEXT = lines[4];
-        CONTEXT |= lines[3] << 2;
-        CONTEXT |= lines[2] << 5;
-        CONTEXT |= lines[1] << 6;
-        CONTEXT |= lines[0] << 7;
-        if (pArithDecoder->IsComplete()) {
-          return nullptr;
-        }
-        int bVal = pArithDecoder->Decode(&grContexts[CONTEXT]);
-        GRREG->SetPixel(w, row_write, bVal);
-        const int w_dx = w - GRREFERENCEDX + 1;
-        lines[0] = ((lines[0] << 1) | GRREG->GetPixel(w + 2, row_prev)) & 0x07;
-        lines[1] = ((lines[1] << 1) | bVal) & 0x01;
-        lines[2] =
-            ((lines[2] << 1) | GRREFERENCE->GetPixel(w_dx, row_refs_dy[0])) &
-            0x01;
-        lines[3] = ((lines[3] << 1) |
-                    GRREFERENCE->GetPixel(w_dx + 1, row_refs_dy[1])) &
-                   0x07;
-        lines[4] = ((lines[4] << 1) |
-                    GRREFERENCE->GetPixel(w_dx + 1, row_refs_dy[2])) &
-                   0x03;
-      }
-    } else {
-      std::array<pdfium::span<const uint8_t>, 3> row_refs = GetRowRefs(h);
-      for (uint32_t w = 0; w < GRW; w++) {
-        int bVal = GRREFERENCE->GetPixel(w, row_refs[1]);
-        if (!TPGRON || !TypicalPrediction(w, bVal, row_refs)) {
-          uint32_t CONTEXT = lines[4];
-          CONTEXT |= lines[3] << 2;
-          CONTEXT |= lines[2] << 5;
-          CONTEXT |= lines[1] << 6;
-          CONTEXT |= lines[0] << 7;
-          if (pArithDecoder->IsComplete()) {
-            return nullptr;
-          }
-          bVal = pArithDecoder->Decode(&grContexts[CONTEXT]);
-        }
-        GRREG->SetPixel(w, row_write, bVal);
-        int w_dx = w - GRREFERENCEDX + 1;
-        lines[0] = ((lines[0] << 1) | GRREG->GetPixel(w + 2, row_prev)) & 0x07;
-        lines[1] = ((lines[1] << 1) | bVal) & 0x01;
-        lines[2] =
-            ((lines[2] << 1) | GRREFERENCE->GetPixel(w_dx, row_refs_dy[0])) &
-            0x01;
-        lines[3] = ((lines[3] << 1) |
-                    GRREFERENCE->GetPixel(w_dx + 1, row_refs_dy[1])) &
-                   0x07;
-        lines[4] = ((lines[4] << 1) |
-                    GRREFERENCE->GetPixel(w_dx + 1, row_refs_dy[2])) &
-                   0x03;
-      }
-    }
-  }
-  return GRREG;
-}
-
 std::unique_ptr<CJBig2_Image> CJBig2_GRRDProc::DecodeTemplate1Opt(
     CJBig2_ArithDecoder* pArithDecoder,
     pdfium::span<JBig2ArithCtx> grContexts) {
@@ -479,10 +400,14 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRRDProc::DecodeTemplate1Opt(
             }
           }
         }
+        uint8_t typical_values;
+        const uint8_t typical = GetTypicalPixels(w, row_refs, &typical_values);
         uint8_t cVal = 0;
         for (int32_t k = 0; k < nBits; k++) {
-          int bVal = GRREFERENCE->GetPixel(w + k, row_refs[1]);
-          if (!TPGRON || !TypicalPrediction(w + k, bVal, row_refs)) {
+          int bVal;
+          if ((typical >> (7 - k)) & 1) {
+            bVal = (typical_values >> (7 - k)) & 1;
+          } else {
             if (pArithDecoder->IsComplete()) {
               return nullptr;
             }
@@ -521,16 +446,18 @@ std::array<pdfium::span<const uint8_t>, 3> CJBig2_GRRDProc::GetRowRefsDy(
   };
 }
 
-bool CJBig2_GRRDProc::TypicalPrediction(
-    int x,
-    int val,
-    pdfium::span<pdfium::span<const uint8_t>, 3> row_refs) const {
-  return (val == GRREFERENCE->GetPixel(x - 1, row_refs[0])) &&
-         (val == GRREFERENCE->GetPixel(x, row_refs[0])) &&
-         (val == GRREFERENCE->GetPixel(x + 1, row_refs[0])) &&
-         (val == GRREFERENCE->GetPixel(x - 1, row_refs[1])) &&
-         (val == GRREFERENCE->GetPixel(x + 1, row_refs[1])) &&
-         (val == GRREFERENCE->GetPixel(x - 1, row_refs[2])) &&
-         (val == GRREFERENCE->GetPixel(x, row_refs[2])) &&
-         (val == GRREFERENCE->GetPixel(x + 1, row_refs[2]));
+uint8_t CJBig2_GRRDProc::GetTypicalPixels(
+    int64_t x,
+    pdfium::span<pdfium::span<const uint8_t>, 3> row_refs,
+    uint8_t* values) const {
+  // Pixel x + k is at bit 47 - k of each word.
+  const uint64_t above = GRREFERENCE->GetPixelWord(x - 16, row_refs[0]);
+  const uint64_t center = GRREFERENCE->GetPixelWord(x - 16, row_refs[1]);
+  const uint64_t below = GRREFERENCE->GetPixelWord(x - 16, row_refs[2]);
+  const uint64_t ones = above & center & below;
+  const uint64_t zeros = ~above & ~center & ~below;
+  const uint64_t typical = (ones & (ones << 1) & (ones >> 1)) |
+                           (zeros & (zeros << 1) & (zeros >> 1));
+  *values = static_cast<uint8_t>(center >> 40);
+  return static_cast<uint8_t>(typical >> 40);
 }
@@ -37,22 +37,8 @@ class CJBig2_GRRDProc {
   std::array<int8_t, 4> GRAT;
 
  private:
-  uint32_t DecodeTemplate0UnoptCalculateContext(
-      const CJBig2_Image& GRREG,
-      pdfium::span<const uint32_t, 5> lines,
-      uint32_t w,
-      pdfium::span<const uint8_t> row_ref_grat,
-      pdfium::span<const uint8_t> row_grat) const;
-  void DecodeTemplate0UnoptSetPixel(
-      CJBig2_Image* GRREG,
-      pdfium::span<uint32_t, 5> lines,
-      uint32_t w,
-      int bVal,
-      pdfium::span<pdfium::span<const uint8_t>, 3> row_refs_dy,
-      pdfium::span<const uint8_t> row_prev,
-      pdfium::span<uint8_t> row_write);
-
-  std::unique_ptr<CJBig2_Image> DecodeTemplate0Unopt(
+  // Decodes with either template, any reference offset and AT pixels.
+  std::unique_ptr<CJBig2_Image> DecodeGeneric(
       CJBig2_ArithDecoder* pArithDecoder,
       pdfium::span<JBig2ArithCtx> grContexts);
 
@@ -60,20 +46,20 @@ class CJBig2_GRRDProc {
       CJBig2_ArithDecoder* pArithDecoder,
       pdfium::span<JBig2ArithCtx> grContexts);
 
-  std::unique_ptr<CJBig2_Image> DecodeTemplate1Unopt(
-      CJBig2_ArithDecoder* pArithDecoder,
-      pdfium::span<JBig2ArithCtx> grContexts);
-
   std::unique_ptr<CJBig2_Image> DecodeTemplate1Opt(
       CJBig2_ArithDecoder* pArithDecoder,
       pdfium::span<JBig2ArithCtx> grContexts);
 
   std::array<pdfium::span<const uint8_t>, 3> GetRowRefs(uint32_t h) const;
   std::array<pdfium::span<const uint8_t>, 3> GetRowRefsDy(uint32_t h) const;
-  bool TypicalPrediction(
-      int x,
-      int val,
-      pdfium::span<pdfium::span<const uint8_t>, 3> row_refs) const;
+
+  // Returns a bit for each of the 8 pixels from `x`, most significant first,
+  // that is set if the pixel and its 8 neighbours in `row_refs` all have the
+  // same value. Writes the values of the 8 pixels to `values`.
+  uint8_t GetTypicalPixels(
+      int64_t x,
+      pdfium::span<pdfium::span<const uint8_t>, 3> row_refs,
+      uint8_t* values) const;
 };
 
 #endif  // CORE_FXCODEC_JBIG2_JBIG2_GRRD_PROC_H_
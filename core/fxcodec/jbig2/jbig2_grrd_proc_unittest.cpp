@@ -0,0 +1,174 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/jbig2/jbig2_grrd_proc.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "core/fxcodec/jbig2/jbig2_arith_decoder.h"
+#include "core/fxcodec/jbig2/jbig2_bit_stream.h"
+#include "core/fxcodec/jbig2/jbig2_image.h"
+#include "core/fxcrt/span.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+std::vector<uint8_t> MakeRandomData(size_t size, uint32_t seed) {
+  std::vector<uint8_t> data(size);
+  for (uint8_t& byte : data) {
+    seed = seed * 1103515245 + 12345;
+    byte = static_cast<uint8_t>(seed >> 16);
+  }
+  return data;
+}
+
+// Makes a reference image of diagonal bands with a few stray pixels, so that
+// typical prediction finds both typical and non-typical pixels.
+std::unique_ptr<CJBig2_Image> MakeReference(int32_t width, int32_t height) {
+  auto image = std::make_unique<CJBig2_Image>(width, height);
+  const std::vector<uint8_t> noise =
+      MakeRandomData(static_cast<size_t>(width) * height, 3);
+  for (int32_t y = 0; y < height; ++y) {
+    for (int32_t x = 0; x < width; ++x) {
+      const bool band = (x / 7 + y / 5) % 3 == 0;
+      const bool flip = noise[y * width + x] < 8;
+      image->SetPixel(x, image->GetLine(y), band != flip);
+    }
+  }
+  return image;
+}
+
+// Returns the context of the pixel at (`x`, `y`) by reading each pixel of the
+// template on its own, as laid out in 6.3.5.3 of the JBIG2 specification.
+uint32_t GetContext(const CJBig2_GRRDProc& proc,
+                    const CJBig2_Image& image,
+                    int32_t x,
+                    int32_t y) {
+  auto pixel = [&](int dx, int dy) -> uint32_t {
+    return image.GetPixel(x + dx, image.GetLine(y + dy));
+  };
+  const CJBig2_Image& reference = *proc.GRREFERENCE;
+  auto ref = [&](int dx, int dy) -> uint32_t {
+    return reference.GetPixel(
+        x - proc.GRREFERENCEDX + dx,
+        reference.GetLine(y - proc.GRREFERENCEDY + dy));
+  };
+  if (proc.GRTEMPLATE) {
+    return ref(1, 1) | ref(0, 1) << 1 | ref(1, 0) << 2 | ref(0, 0) << 3 |
+           ref(-1, 0) << 4 | ref(0, -1) << 5 | pixel(-1, 0) << 6 |
+           pixel(1, -1) << 7 | pixel(0, -1) << 8 | pixel(-1, -1) << 9;
+  }
+  return ref(1, 1) | ref(0, 1) << 1 | ref(-1, 1) << 2 | ref(1, 0) << 3 |
+         ref(0, 0) << 4 | ref(-1, 0) << 5 | ref(1, -1) << 6 |
+         ref(0, -1) << 7 | ref(proc.GRAT[2], proc.GRAT[3]) << 8 |
+         pixel(-1, 0) << 9 | pixel(1, -1) << 10 | pixel(0, -1) << 11 |
+         pixel(proc.GRAT[0], proc.GRAT[1]) << 12;
+}
+
+// Returns whether the pixel at (`x`, `y`) of the reference, unshifted, and its
+// 8 neighbours all have the same value.
+bool IsTypical(const CJBig2_Image& reference, int32_t x, int32_t y) {
+  const int value = reference.GetPixel(x, reference.GetLine(y));
+  for (int dy = -1; dy <= 1; ++dy) {
+    for (int dx = -1; dx <= 1; ++dx) {
+      if (reference.GetPixel(x + dx, reference.GetLine(y + dy)) != value) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+std::unique_ptr<CJBig2_Image> DecodeReference(
+    const CJBig2_GRRDProc& proc,
+    CJBig2_ArithDecoder* decoder,
+    pdfium::span<JBig2ArithCtx> contexts) {
+  auto image = std::make_unique<CJBig2_Image>(proc.GRW, proc.GRH);
+  image->Fill(false);
+  int ltp = 0;
+  for (int32_t y = 0; y < static_cast<int32_t>(proc.GRH); ++y) {
+    if (proc.TPGRON) {
+      ltp ^= decoder->Decode(&contexts[proc.GRTEMPLATE ? 0x0008 : 0x0010]);
+    }
+    for (int32_t x = 0; x < static_cast<int32_t>(proc.GRW); ++x) {
+      int value;
+      if (ltp && IsTypical(*proc.GRREFERENCE, x, y)) {
+        value = proc.GRREFERENCE->GetPixel(x, proc.GRREFERENCE->GetLine(y));
+      } else {
+        value = decoder->Decode(&contexts[GetContext(proc, *image, x, y)]);
+      }
+      image->SetPixel(x, image->GetLine(y), value);
+    }
+  }
+  return image;
+}
+
+void CheckSameAsReference(CJBig2_GRRDProc& proc) {
+  const std::vector<uint8_t> data =
+      MakeRandomData(16384, proc.GRW + proc.GRREFERENCEDX * 13);
+  const size_t context_count = size_t{1} << 13;
+
+  CJBig2_BitStream expected_stream(data, 0);
+  CJBig2_ArithDecoder expected_decoder(&expected_stream);
+  std::vector<JBig2ArithCtx> expected_contexts(context_count);
+  std::unique_ptr<CJBig2_Image> expected =
+      DecodeReference(proc, &expected_decoder, expected_contexts);
+
+  CJBig2_BitStream stream(data, 0);
+  CJBig2_ArithDecoder decoder(&stream);
+  std::vector<JBig2ArithCtx> contexts(context_count);
+  std::unique_ptr<CJBig2_Image> image = proc.Decode(&decoder, contexts);
+  ASSERT_TRUE(image);
+  EXPECT_TRUE(std::ranges::equal(expected->span(), image->span()));
+}
+
+}  // namespace
+
+TEST(CJBig2GRRDProcTest, Templates) {
+  struct Case {
+    bool gr_template;
+    uint32_t width;
+    int32_t dx;
+    int32_t dy;
+    std::array<int8_t, 4> grat;
+  };
+  // The first cases of each template are as text regions refine symbols,
+  // with the reference the same size as the region. The others are shifted,
+  // of another size, or with AT pixels that are not nominal.
+  const Case kCases[] = {
+      {false, 67, 0, 0, {-1, -1, -1, -1}},
+      {true, 67, 0, 0, {0, 0, 0, 0}},
+      {false, 67, 0, 2, {-1, -1, -1, -1}},
+      {false, 67, 3, -2, {-1, -1, -1, -1}},
+      {false, 150, -9, 1, {-3, 0, 2, 1}},
+      {false, 40, 1, 0, {-70, 0, -128, 127}},
+      {false, 9, 0, 0, {2, -1, 0, -2}},
+      {true, 64, 2, -1, {0, 0, 0, 0}},
+      {true, 150, -70, 3, {0, 0, 0, 0}},
+  };
+  std::unique_ptr<CJBig2_Image> reference = MakeReference(67, 30);
+  for (const Case& test_case : kCases) {
+    for (bool tpgron : {false, true}) {
+      SCOPED_TRACE(testing::Message()
+                   << "template " << test_case.gr_template << " width "
+                   << test_case.width << " dx " << test_case.dx << " dy "
+                   << test_case.dy << " tpgron " << tpgron);
+      CJBig2_GRRDProc proc;
+      proc.GRTEMPLATE = test_case.gr_template;
+      proc.TPGRON = tpgron;
+      proc.GRW = test_case.width;
+      proc.GRH = 30;
+      proc.GRREFERENCEDX = test_case.dx;
+      proc.GRREFERENCEDY = test_case.dy;
+      proc.GRREFERENCE = reference.get();
+      proc.GRAT = test_case.grat;
+      CheckSameAsReference(proc);
+    }
+  }
+}
@@ -146,6 +146,45 @@ int CJBig2_Image::GetPixel(int32_t x, pdfium::span<const uint8_t> line) const {
   return (line[m] >> (7 - n)) & 1;
 }
 
+uint64_t CJBig2_Image::GetPixelWord(int64_t x,
+                                    pdfium::span<const uint8_t> line) const {
+  if (line.empty() || x <= -64 || x >= width_) {
+    return 0;
+  }
+
+  // Read the 9 bytes that the pixels can straddle, with bytes outside the
+  // line as 0.
+  const int64_t first_byte = x >> 3;
+  const int64_t line_bytes = (static_cast<int64_t>(width_) + 7) / 8;
+  uint64_t word = 0;
+  uint8_t next_byte = 0;
+  if (first_byte >= 0 && first_byte + 9 <= line_bytes) {
+    auto bytes = line.subspan(static_cast<size_t>(first_byte));
+    word = (uint64_t{fxcrt::GetUInt32MSBFirst(bytes.first<4u>())} << 32) |
+           fxcrt::GetUInt32MSBFirst(bytes.subspan<4u, 4u>());
+    next_byte = bytes[8];
+  } else {
+    for (int64_t i = first_byte; i < first_byte + 8; ++i) {
+      word = (word << 8) |
+             (i >= 0 && i < line_bytes ? line[static_cast<size_t>(i)] : 0);
+    }
+    if (first_byte + 8 < line_bytes) {
+      next_byte = line[static_cast<size_t>(first_byte + 8)];
+    }
+  }
+  const int bit = static_cast<int>(x & 7);
+  if (bit) {
+    word = (word << bit) | (next_byte >> (8 - bit));
+  }
+
+  // Clear the pixels past the end of the line, including the padding bits.
+  const int64_t pixels_left = width_ - x;
+  if (pixels_left < 64) {
+    word &= ~uint64_t{0} << (64 - pixels_left);
+  }
+  return word;
+}
+
 void CJBig2_Image::SetPixel(int32_t x, pdfium::span<uint8_t> line, int v) {
   if (line.empty() || x < 0 || x >= width_) {
     return;
@@ -55,6 +55,11 @@ class CJBig2_Image {
   int GetPixel(int32_t x, pdfium::span<const uint8_t> line) const;
   void SetPixel(int32_t x, pdfium::span<uint8_t> line, int v);
 
+  // Returns the 64 pixels starting at position `x` in `line`, with the pixel
+  // at `x` in the most significant bit. Pixels that are out of bounds read as
+  // 0, as with GetPixel().
+  uint64_t GetPixelWord(int64_t x, pdfium::span<const uint8_t> line) const;
+
   // Returns an empty span if `y` is out of bounds, or if there is no data.
   pdfium::span<const uint8_t> GetLine(int32_t y) const;
   pdfium::span<uint8_t> GetLine(int32_t y);
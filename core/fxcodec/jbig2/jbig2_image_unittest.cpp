@@ -383,3 +383,26 @@ TEST(fxcodec, JBig2CopyLine) {
 
   CheckImageEq(expected.get(), img.get(), __LINE__);
 }
+
+TEST(fxcodec, JBig2GetPixelWord) {
+  // 100 pixels wide, with the padding bits set to check they read as 0.
+  CJBig2_Image img(100, 2);
+  img.Fill(true);
+  pdfium::span<const uint8_t> line = img.GetLine(0);
+  img.SetPixel(3, img.GetLine(0), 0);
+  img.SetPixel(70, img.GetLine(0), 0);
+
+  for (int64_t x : {-100, -64, -63, -5, 0, 3, 5, 8, 36, 37, 63, 70, 99, 100}) {
+    uint64_t expected = 0;
+    for (int i = 0; i < 64; ++i) {
+      const int64_t pixel_x = x + i;
+      if (pixel_x >= 0 && pixel_x < 100) {
+        expected |= static_cast<uint64_t>(img.GetPixel(
+                        static_cast<int32_t>(pixel_x), line))
+                    << (63 - i);
+      }
+    }
+    EXPECT_EQ(expected, img.GetPixelWord(x, line)) << x;
+  }
+  EXPECT_EQ(0u, img.GetPixelWord(0, img.GetLine(2)));
+}
@@ -51,7 +51,6 @@ class CJBig2_Segment {
   uint32_t data_length_ = 0;
   uint32_t header_length_ = 0;
   uint32_t data_offset_ = 0;
-  uint64_t key_ = 0;
   JBig2_SegmentState state_ = JBIG2_SEGMENT_HEADER_UNPARSED;
   JBig2_ResultType result_type_ = JBIG2_VOID_POINTER;
   std::unique_ptr<CJBig2_SymbolDict> symbol_dict_;
@@ -0,0 +1,189 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/jbig2/jbig2_symbol_dict_cache.h"
+
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+#include "core/fdrm/fx_crypt_sha.h"
+#include "core/fxcodec/jbig2/jbig2_image.h"
+#include "core/fxcodec/jbig2/jbig2_symbol_dict.h"
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/check_op.h"
+
+namespace {
+
+constexpr CFX_CacheBudget::CacheType kCacheType =
+    CFX_CacheBudget::CacheType::kJBig2SymbolDict;
+
+CJBig2_SymbolDictCache* g_symbol_dict_cache = nullptr;
+
+size_t GetMemorySize(const CJBig2_SymbolDict& dict) {
+  size_t size = sizeof(CJBig2_SymbolDict) +
+                (dict.GbContexts().size() + dict.GrContexts().size()) *
+                    sizeof(JBig2ArithCtx);
+  for (size_t i = 0; i < dict.NumImages(); ++i) {
+    size += sizeof(std::unique_ptr<CJBig2_Image>);
+    if (const CJBig2_Image* image = dict.GetImage(i)) {
+      size += sizeof(CJBig2_Image) + image->span().size();
+    }
+  }
+  return size;
+}
+
+}  // namespace
+
+class CJBig2_SymbolDictCache::CachedDict final : public Retainable {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  const CJBig2_SymbolDict& dict() const { return *dict_; }
+
+ private:
+  explicit CachedDict(std::unique_ptr<CJBig2_SymbolDict> dict)
+      : dict_(std::move(dict)) {}
+  ~CachedDict() override = default;
+
+  std::unique_ptr<const CJBig2_SymbolDict> const dict_;
+};
+
+bool CJBig2_SymbolDictCache::Key::operator<(const Key& that) const {
+  return std::tie(stream_digest, data_offset) <
+         std::tie(that.stream_digest, that.data_offset);
+}
+
+CJBig2_SymbolDictCache::Entry::Entry(const Key& key,
+                                     RetainPtr<const CachedDict> dict,
+                                     CFX_CacheBudget::Charge charge)
+    : key(key), dict(std::move(dict)), charge(std::move(charge)) {}
+
+CJBig2_SymbolDictCache::Entry::~Entry() = default;
+
+// static
+void CJBig2_SymbolDictCache::Create() {
+  DCHECK(!g_symbol_dict_cache);
+  g_symbol_dict_cache =
+      new CJBig2_SymbolDictCache(CFX_CacheBudget::Get(), kDefaultMaxBytes);
+}
+
+// static
+void CJBig2_SymbolDictCache::Destroy() {
+  DCHECK(g_symbol_dict_cache);
+  delete g_symbol_dict_cache;
+  g_symbol_dict_cache = nullptr;
+}
+
+// static
+CJBig2_SymbolDictCache* CJBig2_SymbolDictCache::Get() {
+  DCHECK(g_symbol_dict_cache);
+  return g_symbol_dict_cache;
+}
+
+// static
+CJBig2_SymbolDictCache::Digest CJBig2_SymbolDictCache::HashStream(
+    pdfium::span<const uint8_t> stream) {
+  CryptSha2Context context;
+  CryptSha256Start(&context);
+  CryptSha256Update(&context, stream);
+  Digest digest;
+  CryptSha256Finish(&context, digest);
+  return digest;
+}
+
+CJBig2_SymbolDictCache::CJBig2_SymbolDictCache(CFX_CacheBudget* budget,
+                                               size_t max_bytes)
+    : budget_(budget), max_bytes_(max_bytes) {
+  budget_->AddSharedClient(this);
+}
+
+CJBig2_SymbolDictCache::~CJBig2_SymbolDictCache() {
+  budget_->RemoveSharedClient(this);
+}
+
+std::unique_ptr<CJBig2_SymbolDict> CJBig2_SymbolDictCache::Lookup(
+    const Key& key) {
+  RetainPtr<const CachedDict> cached;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    DropFlaggedEntries();
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      budget_->RecordMiss(kCacheType);
+      return nullptr;
+    }
+    budget_->RecordHit(kCacheType);
+    entries_.splice(entries_.begin(), entries_, it->second);
+    it->second->charge.Touch();
+    cached = it->second->dict;
+  }
+  // Copy without the lock, so lookups on other threads do not wait for it.
+  return cached->dict().DeepCopy();
+}
+
+void CJBig2_SymbolDictCache::Insert(const Key& key,
+                                    const CJBig2_SymbolDict& dict) {
+  const size_t size = GetMemorySize(dict);
+  auto copy = pdfium::MakeRetain<CachedDict>(dict.DeepCopy());
+  std::lock_guard<std::mutex> lock(lock_);
+  DropFlaggedEntries();
+  if (size > max_bytes_ || index_.contains(key)) {
+    return;
+  }
+  DropLeastRecentlyUsed(max_bytes_ - size);
+  entries_.emplace_front(key, std::move(copy),
+                         budget_->CreateCharge(kCacheType, this));
+  index_.emplace(key, entries_.begin());
+  bytes_ += size;
+  entries_.front().charge.SetSize(size);
+}
+
+size_t CJBig2_SymbolDictCache::GetMaxBytes() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return max_bytes_;
+}
+
+void CJBig2_SymbolDictCache::SetMaxBytes(size_t max_bytes) {
+  std::lock_guard<std::mutex> lock(lock_);
+  max_bytes_ = max_bytes;
+  DropLeastRecentlyUsed(max_bytes_);
+}
+
+size_t CJBig2_SymbolDictCache::GetEntryCount() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return entries_.size();
+}
+
+void CJBig2_SymbolDictCache::ReleaseFlaggedEntries() {
+  std::lock_guard<std::mutex> lock(lock_);
+  DropFlaggedEntries();
+}
+
+void CJBig2_SymbolDictCache::DropFlaggedEntries() {
+  if (!TakeEvictionRequest()) {
+    return;
+  }
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    auto next = std::next(it);
+    if (it->charge.IsEvictionRequested()) {
+      DropEntry(it);
+    }
+    it = next;
+  }
+}
+
+void CJBig2_SymbolDictCache::DropLeastRecentlyUsed(size_t max_bytes) {
+  while (bytes_ > max_bytes) {
+    DropEntry(std::prev(entries_.end()));
+  }
+}
+
+void CJBig2_SymbolDictCache::DropEntry(std::list<Entry>::iterator it) {
+  DCHECK_GE(bytes_, it->charge.size());
+  bytes_ -= it->charge.size();
+  index_.erase(it->key);
+  entries_.erase(it);
+  budget_->RecordEviction(kCacheType);
+}
@@ -0,0 +1,111 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCODEC_JBIG2_JBIG2_SYMBOL_DICT_CACHE_H_
+#define CORE_FXCODEC_JBIG2_JBIG2_SYMBOL_DICT_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "core/fxcrt/cfx_cachebudget.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
+#include "core/fxcrt/unowned_ptr.h"
+
+class CJBig2_SymbolDict;
+
+// Process-wide cache of the symbol dictionaries decoded from JBIG2 global data
+// streams. Scanned documents from the same source often carry identical
+// /JBIG2Globals, so entries are keyed by the contents of the stream rather
+// than by its object number, and are shared by all documents and threads.
+//
+// The cache holds at most a fixed number of bytes, dropping the least recently
+// used dictionaries first. Its entries are also charged to a CFX_CacheBudget,
+// which may ask for more of them to be dropped, and which keeps the hit, miss
+// and eviction counters.
+class CJBig2_SymbolDictCache final : public CFX_CacheBudget::Client {
+ public:
+  using Digest = std::array<uint8_t, 32>;
+
+  // Identifies a symbol dictionary segment by the SHA-256 digest of the global
+  // data stream it is in, and by the offset of its data within that stream.
+  // A segment only depends on the segments before it in the same stream, so
+  // segments with equal keys decode to equal dictionaries.
+  struct Key {
+    bool operator<(const Key& that) const;
+
+    Digest stream_digest;
+    uint32_t data_offset;
+  };
+
+  static constexpr size_t kDefaultMaxBytes = 32 * 1024 * 1024;
+
+  // Per-process singleton which must be managed by callers. Requires the
+  // CFX_CacheBudget singleton to outlive it.
+  static void Create();
+  static void Destroy();
+  // Returns the cache shared by all documents in the process.
+  static CJBig2_SymbolDictCache* Get();
+
+  static Digest HashStream(pdfium::span<const uint8_t> stream);
+
+  CJBig2_SymbolDictCache(CFX_CacheBudget* budget, size_t max_bytes);
+  CJBig2_SymbolDictCache(const CJBig2_SymbolDictCache&) = delete;
+  CJBig2_SymbolDictCache& operator=(const CJBig2_SymbolDictCache&) = delete;
+  ~CJBig2_SymbolDictCache() override;
+
+  // Returns a copy of the dictionary for `key`, or nullptr if there is none.
+  std::unique_ptr<CJBig2_SymbolDict> Lookup(const Key& key);
+
+  // Stores a copy of `dict` for `key`, unless it is larger than the cache.
+  void Insert(const Key& key, const CJBig2_SymbolDict& dict);
+
+  size_t GetMaxBytes() const;
+  void SetMaxBytes(size_t max_bytes);
+  size_t GetEntryCount() const;
+
+ private:
+  // Keeps a dictionary alive while Lookup() copies it without holding
+  // `lock_`, even if the entry is dropped meanwhile.
+  class CachedDict;
+
+  struct Entry {
+    Entry(const Key& key,
+          RetainPtr<const CachedDict> dict,
+          CFX_CacheBudget::Charge charge);
+    ~Entry();
+
+    const Key key;
+    RetainPtr<const CachedDict> const dict;
+    CFX_CacheBudget::Charge charge;
+  };
+
+  // CFX_CacheBudget::Client:
+  void ReleaseFlaggedEntries() override;
+
+  // Drops the entries the budget flagged for eviction. Requires `lock_`.
+  void DropFlaggedEntries();
+  // Drops the least recently used entries until at most `max_bytes` are held.
+  // Requires `lock_`.
+  void DropLeastRecentlyUsed(size_t max_bytes);
+  // Requires `lock_`.
+  void DropEntry(std::list<Entry>::iterator it);
+
+  UnownedPtr<CFX_CacheBudget> const budget_;
+
+  mutable std::mutex lock_;
+  size_t max_bytes_;
+  size_t bytes_ = 0;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::map<Key, std::list<Entry>::iterator> index_;
+};
+
+#endif  // CORE_FXCODEC_JBIG2_JBIG2_SYMBOL_DICT_CACHE_H_
@@ -0,0 +1,173 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/jbig2/jbig2_symbol_dict_cache.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/fxcodec/jbig2/jbig2_document_context.h"
+#include "core/fxcodec/jbig2/jbig2_image.h"
+#include "core/fxcodec/jbig2/jbig2_symbol_dict.h"
+#include "core/fxcrt/cfx_cachebudget.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr CFX_CacheBudget::CacheType kCacheType =
+    CFX_CacheBudget::CacheType::kJBig2SymbolDict;
+
+// Makes a dictionary with `count` 32x32 symbols.
+std::unique_ptr<CJBig2_SymbolDict> MakeDict(size_t count, bool value) {
+  auto dict = std::make_unique<CJBig2_SymbolDict>();
+  for (size_t i = 0; i < count; ++i) {
+    auto image = std::make_unique<CJBig2_Image>(32, 32);
+    image->Fill(value);
+    dict->AddImage(std::move(image));
+  }
+  return dict;
+}
+
+CJBig2_SymbolDictCache::Key MakeKey(uint8_t stream_byte,
+                                    uint32_t data_offset) {
+  const std::vector<uint8_t> stream(100, stream_byte);
+  return {CJBig2_SymbolDictCache::HashStream(stream), data_offset};
+}
+
+int GetFirstPixel(const CJBig2_SymbolDict& dict) {
+  const CJBig2_Image* image = dict.GetImage(0);
+  return image->GetPixel(0, image->GetLine(0));
+}
+
+}  // namespace
+
+TEST(CJBig2SymbolDictCacheTest, LookupAndInsert) {
+  CFX_CacheBudget budget;
+  CJBig2_SymbolDictCache cache(&budget, 1024 * 1024);
+  EXPECT_FALSE(cache.Lookup(MakeKey(1, 10)));
+
+  std::unique_ptr<CJBig2_SymbolDict> dict = MakeDict(3, true);
+  dict->SetGbContexts(std::vector<JBig2ArithCtx>(1024));
+  cache.Insert(MakeKey(1, 10), *dict);
+  EXPECT_EQ(1u, cache.GetEntryCount());
+
+  // The cache hands out copies, so changing one does not affect the next.
+  std::unique_ptr<CJBig2_SymbolDict> found = cache.Lookup(MakeKey(1, 10));
+  ASSERT_TRUE(found);
+  ASSERT_EQ(3u, found->NumImages());
+  EXPECT_NE(dict->GetImage(0), found->GetImage(0));
+  EXPECT_EQ(1, GetFirstPixel(*found));
+  EXPECT_EQ(1024u, found->GbContexts().size());
+  found->GetImage(0)->Fill(false);
+  found = cache.Lookup(MakeKey(1, 10));
+  ASSERT_TRUE(found);
+  EXPECT_EQ(1, GetFirstPixel(*found));
+
+  // Another segment of the same stream, or the same offset in another stream,
+  // is another entry.
+  EXPECT_FALSE(cache.Lookup(MakeKey(1, 11)));
+  EXPECT_FALSE(cache.Lookup(MakeKey(2, 10)));
+
+  CFX_CacheBudget::Stats stats = budget.GetStats(kCacheType);
+  EXPECT_EQ(2u, stats.hits);
+  EXPECT_EQ(3u, stats.misses);
+  EXPECT_EQ(0u, stats.evictions);
+  EXPECT_GT(stats.bytes, 3u * 128);
+}
+
+TEST(CJBig2SymbolDictCacheTest, HashStream) {
+  const std::vector<uint8_t> stream1 = {1, 2, 3};
+  const std::vector<uint8_t> stream2 = {1, 2, 3};
+  const std::vector<uint8_t> stream3 = {1, 2, 4};
+  EXPECT_EQ(CJBig2_SymbolDictCache::HashStream(stream1),
+            CJBig2_SymbolDictCache::HashStream(stream2));
+  EXPECT_NE(CJBig2_SymbolDictCache::HashStream(stream1),
+            CJBig2_SymbolDictCache::HashStream(stream3));
+}
+
+TEST(CJBig2SymbolDictCacheTest, DocumentContextGlobalDigest) {
+  const std::vector<uint8_t> stream1 = {1, 2, 3};
+  const std::vector<uint8_t> stream2 = {1, 2, 4};
+  EXPECT_FALSE(JBig2_DocumentContext(nullptr).GetGlobalDigest(1, stream1));
+
+  CFX_CacheBudget budget;
+  CJBig2_SymbolDictCache cache(&budget, 1024 * 1024);
+  JBig2_DocumentContext context(&cache);
+  EXPECT_EQ(CJBig2_SymbolDictCache::HashStream(stream1),
+            context.GetGlobalDigest(1, stream1));
+  EXPECT_EQ(CJBig2_SymbolDictCache::HashStream(stream2),
+            context.GetGlobalDigest(2, stream2));
+  // The digest is computed once per stream of the document.
+  EXPECT_EQ(CJBig2_SymbolDictCache::HashStream(stream1),
+            context.GetGlobalDigest(1, stream2));
+}
+
+TEST(CJBig2SymbolDictCacheTest, EvictsLeastRecentlyUsed) {
+  CFX_CacheBudget budget;
+  std::unique_ptr<CJBig2_SymbolDict> dict = MakeDict(10, false);
+  CJBig2_SymbolDictCache cache(&budget, 1024 * 1024);
+  cache.Insert(MakeKey(1, 0), *dict);
+  const size_t dict_bytes = budget.GetStats(kCacheType).bytes;
+
+  // Make room for two of the dictionaries above, but not three.
+  cache.SetMaxBytes(dict_bytes * 5 / 2);
+  cache.Insert(MakeKey(2, 0), *dict);
+  EXPECT_EQ(2u, cache.GetEntryCount());
+
+  // Using the first entry makes the second one the least recently used.
+  EXPECT_TRUE(cache.Lookup(MakeKey(1, 0)));
+  cache.Insert(MakeKey(3, 0), *dict);
+  EXPECT_EQ(2u, cache.GetEntryCount());
+  EXPECT_TRUE(cache.Lookup(MakeKey(1, 0)));
+  EXPECT_FALSE(cache.Lookup(MakeKey(2, 0)));
+  EXPECT_TRUE(cache.Lookup(MakeKey(3, 0)));
+  EXPECT_EQ(1u, budget.GetStats(kCacheType).evictions);
+
+  // Dictionaries larger than the whole cache are not stored.
+  cache.Insert(MakeKey(4, 0), *MakeDict(30, false));
+  EXPECT_FALSE(cache.Lookup(MakeKey(4, 0)));
+  EXPECT_EQ(2u, cache.GetEntryCount());
+
+  cache.SetMaxBytes(0);
+  EXPECT_EQ(0u, cache.GetEntryCount());
+  EXPECT_EQ(3u, budget.GetStats(kCacheType).evictions);
+  EXPECT_EQ(0u, budget.GetStats(kCacheType).bytes);
+}
+
+TEST(CJBig2SymbolDictCacheTest, BudgetEviction) {
+  CFX_CacheBudget budget;
+  CJBig2_SymbolDictCache cache(&budget, 1024 * 1024);
+  cache.Insert(MakeKey(1, 0), *MakeDict(10, false));
+  cache.Insert(MakeKey(2, 0), *MakeDict(10, false));
+  const size_t bytes = budget.GetStats(kCacheType).bytes;
+
+  // Going over the budget flags the least recently used entry. It is dropped
+  // the next time the cache is used.
+  budget.SetLimit(bytes - 1);
+  EXPECT_EQ(2u, cache.GetEntryCount());
+  EXPECT_TRUE(cache.Lookup(MakeKey(2, 0)));
+  EXPECT_EQ(1u, cache.GetEntryCount());
+  EXPECT_FALSE(cache.Lookup(MakeKey(1, 0)));
+  EXPECT_EQ(1u, budget.GetStats(kCacheType).evictions);
+  EXPECT_EQ(bytes / 2, budget.GetStats(kCacheType).bytes);
+  budget.SetLimit(0);
+}
+
+TEST(CJBig2SymbolDictCacheTest, BudgetEvictionWhileIdle) {
+  CFX_CacheBudget budget;
+  CJBig2_SymbolDictCache cache(&budget, 1024 * 1024);
+  cache.Insert(MakeKey(1, 0), *MakeDict(10, false));
+  cache.Insert(MakeKey(2, 0), *MakeDict(10, false));
+  const size_t bytes = budget.GetStats(kCacheType).bytes;
+
+  // The flagged entry goes away without the cache being used again.
+  budget.SetLimit(bytes - 1);
+  EXPECT_EQ(2u, cache.GetEntryCount());
+  budget.ReleaseSharedEvictions();
+  EXPECT_EQ(1u, cache.GetEntryCount());
+  EXPECT_EQ(bytes / 2, budget.GetStats(kCacheType).bytes);
+  budget.SetLimit(0);
+}
@@ -292,7 +292,7 @@ bool ByteString::EqualNoCase(ByteStringView str) const {
 }
 
 intptr_t ByteString::ReferenceCountForTesting() const {
-  return data_ ? data_->refs_ : 0;
+  return data_ ? data_->refs_.load(std::memory_order_relaxed) : 0;
 }
 
 ByteString ByteString::Substr(size_t offset) const {
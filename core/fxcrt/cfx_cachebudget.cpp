@@ -0,0 +1,277 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_cachebudget.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/check_op.h"
+
+namespace {
+
+// Once over the limit, evict down to 7/8 of it, so a full budget does not
+// have to look for the least recently used entries on every insertion.
+constexpr size_t kLowWaterDivisor = 8;
+
+CFX_CacheBudget* g_cache_budget = nullptr;
+
+size_t ToIndex(CFX_CacheBudget::CacheType type) {
+  return static_cast<size_t>(type);
+}
+
+}  // namespace
+
+struct CFX_CacheBudget::Charge::Node {
+  Node(CFX_CacheBudget* budget, CacheType type, Client* client)
+      : budget(budget), type(type), client(client) {}
+
+  UnownedPtr<CFX_CacheBudget> const budget;
+  const CacheType type;
+  UnownedPtr<Client> const client;
+  std::atomic<uint64_t> last_use{0};
+  std::atomic<bool> eviction_requested{false};
+  // Only written while holding the budget's lock.
+  size_t bytes = 0;
+};
+
+CFX_CacheBudget::Client::Client() = default;
+
+CFX_CacheBudget::Client::~Client() = default;
+
+CFX_CacheBudget::ScopedPin::ScopedPin(Client* client) : client_(client) {
+  Pin(client_);
+}
+
+CFX_CacheBudget::ScopedPin::~ScopedPin() {
+  Unpin(client_);
+}
+
+CFX_CacheBudget::Charge::Charge() = default;
+
+CFX_CacheBudget::Charge::Charge(std::unique_ptr<Node> node)
+    : node_(std::move(node)) {}
+
+CFX_CacheBudget::Charge::Charge(Charge&& that) noexcept = default;
+
+CFX_CacheBudget::Charge& CFX_CacheBudget::Charge::operator=(
+    Charge&& that) noexcept {
+  if (this != &that) {
+    if (node_) {
+      node_->budget->Remove(node_.get());
+    }
+    node_ = std::move(that.node_);
+  }
+  return *this;
+}
+
+CFX_CacheBudget::Charge::~Charge() {
+  if (node_) {
+    node_->budget->Remove(node_.get());
+  }
+}
+
+size_t CFX_CacheBudget::Charge::size() const {
+  return node_ ? node_->bytes : 0;
+}
+
+void CFX_CacheBudget::Charge::SetSize(size_t bytes) {
+  if (node_) {
+    node_->budget->Resize(node_.get(), bytes);
+  }
+}
+
+void CFX_CacheBudget::Charge::Touch() {
+  if (!node_) {
+    return;
+  }
+  node_->last_use.store(node_->budget->NextUseCount(),
+                        std::memory_order_relaxed);
+  if (node_->eviction_requested.load(std::memory_order_relaxed)) {
+    node_->budget->CancelEviction(node_.get());
+  }
+}
+
+bool CFX_CacheBudget::Charge::IsEvictionRequested() const {
+  return node_ && node_->eviction_requested.load(std::memory_order_relaxed);
+}
+
+// static
+void CFX_CacheBudget::Create() {
+  DCHECK(!g_cache_budget);
+  g_cache_budget = new CFX_CacheBudget();
+}
+
+// static
+void CFX_CacheBudget::Destroy() {
+  DCHECK(g_cache_budget);
+  delete g_cache_budget;
+  g_cache_budget = nullptr;
+}
+
+// static
+CFX_CacheBudget* CFX_CacheBudget::Get() {
+  DCHECK(g_cache_budget);
+  return g_cache_budget;
+}
+
+CFX_CacheBudget::CFX_CacheBudget() = default;
+
+CFX_CacheBudget::~CFX_CacheBudget() {
+  DCHECK(evictable_.empty());
+  DCHECK(shared_clients_.empty());
+}
+
+void CFX_CacheBudget::SetLimit(size_t bytes) {
+  std::lock_guard<std::mutex> lock(lock_);
+  limit_ = bytes;
+  if (limit_ && total_bytes_ - flagged_bytes_ > limit_) {
+    FlagLeastRecentlyUsed();
+  }
+}
+
+size_t CFX_CacheBudget::GetLimit() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return limit_;
+}
+
+CFX_CacheBudget::Charge CFX_CacheBudget::CreateCharge(CacheType type,
+                                                      Client* client) {
+  auto node = std::make_unique<Charge::Node>(this, type, client);
+  node->last_use.store(NextUseCount(), std::memory_order_relaxed);
+  if (client) {
+    std::lock_guard<std::mutex> lock(lock_);
+    evictable_.insert(node.get());
+  }
+  return Charge(std::move(node));
+}
+
+void CFX_CacheBudget::AddSharedClient(Client* client) {
+  std::lock_guard<std::mutex> lock(shared_clients_lock_);
+  shared_clients_.insert(client);
+}
+
+void CFX_CacheBudget::RemoveSharedClient(Client* client) {
+  std::lock_guard<std::mutex> lock(shared_clients_lock_);
+  shared_clients_.erase(client);
+}
+
+void CFX_CacheBudget::ReleaseSharedEvictions() {
+  // Holding the lock keeps the clients from going away meanwhile.
+  std::lock_guard<std::mutex> lock(shared_clients_lock_);
+  for (Client* client : shared_clients_) {
+    if (client->eviction_requested_.load(std::memory_order_acquire)) {
+      client->ReleaseFlaggedEntries();
+    }
+  }
+}
+
+void CFX_CacheBudget::RecordHit(CacheType type) {
+  hits_[ToIndex(type)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void CFX_CacheBudget::RecordMiss(CacheType type) {
+  misses_[ToIndex(type)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void CFX_CacheBudget::RecordEviction(CacheType type) {
+  evictions_[ToIndex(type)].fetch_add(1, std::memory_order_relaxed);
+}
+
+CFX_CacheBudget::Stats CFX_CacheBudget::GetStats(CacheType type) const {
+  const size_t index = ToIndex(type);
+  Stats stats;
+  stats.hits = hits_[index].load(std::memory_order_relaxed);
+  stats.misses = misses_[index].load(std::memory_order_relaxed);
+  stats.evictions = evictions_[index].load(std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock(lock_);
+  stats.bytes = bytes_[index];
+  return stats;
+}
+
+// static
+void CFX_CacheBudget::Pin(Client* client) {
+  ++client->pin_count_;
+}
+
+// static
+void CFX_CacheBudget::Unpin(Client* client) {
+  if (--client->pin_count_ == 0 && client->eviction_requested_.load()) {
+    client->ReleaseFlaggedEntries();
+  }
+}
+
+uint64_t CFX_CacheBudget::NextUseCount() {
+  return use_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CFX_CacheBudget::Resize(Charge::Node* node, size_t bytes) {
+  node->last_use.store(NextUseCount(), std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock(lock_);
+  const size_t index = ToIndex(node->type);
+  total_bytes_ = total_bytes_ - node->bytes + bytes;
+  bytes_[index] = bytes_[index] - node->bytes + bytes;
+  if (node->eviction_requested.load(std::memory_order_relaxed)) {
+    flagged_bytes_ = flagged_bytes_ - node->bytes + bytes;
+  }
+  node->bytes = bytes;
+  if (limit_ && total_bytes_ - flagged_bytes_ > limit_) {
+    FlagLeastRecentlyUsed();
+  }
+}
+
+void CFX_CacheBudget::CancelEviction(Charge::Node* node) {
+  std::lock_guard<std::mutex> lock(lock_);
+  if (!node->eviction_requested.load(std::memory_order_relaxed)) {
+    return;
+  }
+  node->eviction_requested.store(false, std::memory_order_relaxed);
+  flagged_bytes_ -= node->bytes;
+  if (limit_ && total_bytes_ - flagged_bytes_ > limit_) {
+    FlagLeastRecentlyUsed();
+  }
+}
+
+void CFX_CacheBudget::Remove(Charge::Node* node) {
+  std::lock_guard<std::mutex> lock(lock_);
+  if (node->client) {
+    evictable_.erase(node);
+  }
+  const size_t index = ToIndex(node->type);
+  DCHECK_GE(total_bytes_, node->bytes);
+  DCHECK_GE(bytes_[index], node->bytes);
+  total_bytes_ -= node->bytes;
+  bytes_[index] -= node->bytes;
+  if (node->eviction_requested.load(std::memory_order_relaxed)) {
+    flagged_bytes_ -= node->bytes;
+  }
+}
+
+void CFX_CacheBudget::FlagLeastRecentlyUsed() {
+  const size_t target = limit_ - limit_ / kLowWaterDivisor;
+
+  // Use counts change without the lock held, so sort a snapshot of them.
+  std::vector<std::pair<uint64_t, Charge::Node*>> candidates;
+  for (Charge::Node* node : evictable_) {
+    if (node->bytes &&
+        !node->eviction_requested.load(std::memory_order_relaxed)) {
+      candidates.emplace_back(node->last_use.load(std::memory_order_relaxed),
+                              node);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  for (const auto& candidate : candidates) {
+    if (total_bytes_ - flagged_bytes_ <= target) {
+      break;
+    }
+    Charge::Node* node = candidate.second;
+    node->eviction_requested.store(true, std::memory_order_relaxed);
+    flagged_bytes_ += node->bytes;
+    node->client->eviction_requested_.store(true, std::memory_order_release);
+  }
+}
@@ -0,0 +1,191 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_CFX_CACHEBUDGET_H_
+#define CORE_FXCRT_CFX_CACHEBUDGET_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+
+#include "core/fxcrt/unowned_ptr.h"
+
+// Process-wide memory accounting for caches of decoded data, such as image
+// bitmaps, rendered glyphs and parsed fonts. Caches charge the size of each
+// entry to the budget and report hits and misses. Once the charged total goes
+// over the limit, the least recently used entries across all caches are
+// flagged for eviction.
+//
+// Caches may belong to documents that are in use on other threads, so the
+// budget never frees anything itself. Instead, it marks the owning
+// CFX_CacheBudget::Client, which drops its flagged entries on its own thread
+// the next time it is used. Flagged bytes still count in the stats until they
+// are freed, but not when picking more entries to flag.
+//
+// A cache that is idle would keep its flagged entries indefinitely, so they
+// are also dropped at fixed points: clients that guard their own entries
+// register with AddSharedClient() and drop them in ReleaseSharedEvictions(),
+// and per-document caches drop them when a page of the document closes.
+class CFX_CacheBudget {
+ public:
+  enum class CacheType : uint8_t {
+    kPageImage = 0,
+    kGlyph,
+    kType3Glyph,
+    kFont,
+    kColorSpace,
+    kIccProfile,
+    kJBig2SymbolDict,
+  };
+  static constexpr size_t kCacheTypeCount = 7;
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t bytes = 0;
+  };
+
+  // Base class for caches with evictable entries.
+  class Client {
+   public:
+    // Returns whether entries were flagged for eviction since the last call.
+    // Callers that see true must release all flagged entries they can.
+    bool TakeEvictionRequest() {
+      return eviction_requested_.exchange(false, std::memory_order_acquire);
+    }
+
+    bool IsPinned() const {
+      return pin_count_.load(std::memory_order_acquire) > 0;
+    }
+
+   protected:
+    Client();
+    virtual ~Client();
+
+    // Called when the client may drop its flagged entries: when the last
+    // ScopedPin goes away while an eviction request is pending, and from
+    // ReleaseSharedEvictions() for shared clients. The client must check
+    // IsPinned() again under its own lock, as another thread may have pinned
+    // it in the meantime.
+    virtual void ReleaseFlaggedEntries() {}
+
+   private:
+    friend class CFX_CacheBudget;
+
+    std::atomic<bool> eviction_requested_{false};
+    std::atomic<int> pin_count_{0};
+  };
+
+  // Marks pointers into a client's entries as being in use, for clients that
+  // are shared across threads. Such clients only release flagged entries
+  // while unpinned.
+  class ScopedPin {
+   public:
+    explicit ScopedPin(Client* client);
+    ScopedPin(const ScopedPin&) = delete;
+    ScopedPin& operator=(const ScopedPin&) = delete;
+    ~ScopedPin();
+
+   private:
+    UnownedPtr<Client> const client_;
+  };
+
+  // The bytes charged for one cache entry, which are uncharged again when the
+  // Charge is destroyed. Default-constructed Charges are empty.
+  class Charge {
+   public:
+    Charge();
+    Charge(Charge&& that) noexcept;
+    Charge& operator=(Charge&& that) noexcept;
+    ~Charge();
+
+    size_t size() const;
+    // Sets the size of the entry and marks it as the most recently used.
+    void SetSize(size_t bytes);
+    // Marks the entry as the most recently used. This cancels a pending
+    // eviction of the entry.
+    void Touch();
+    bool IsEvictionRequested() const;
+
+   private:
+    friend class CFX_CacheBudget;
+
+    struct Node;
+
+    explicit Charge(std::unique_ptr<Node> node);
+
+    std::unique_ptr<Node> node_;
+  };
+
+  // Per-process singleton which must be managed by callers.
+  static void Create();
+  static void Destroy();
+  // Returns the budget shared by all caches in the process.
+  static CFX_CacheBudget* Get();
+
+  CFX_CacheBudget();
+  CFX_CacheBudget(const CFX_CacheBudget&) = delete;
+  CFX_CacheBudget& operator=(const CFX_CacheBudget&) = delete;
+  ~CFX_CacheBudget();
+
+  // Sets the total number of bytes the caches may hold. 0 means no limit,
+  // which is the default.
+  void SetLimit(size_t bytes);
+  size_t GetLimit() const;
+
+  // Returns a new, empty charge for an entry of `type`. Entries without a
+  // `client` are never evicted, but still count towards the limit.
+  Charge CreateCharge(CacheType type, Client* client);
+
+  // Registers a client that guards its own entries, so that
+  // ReleaseSharedEvictions() may call it from any thread. The client must
+  // remove itself before its entries go away.
+  void AddSharedClient(Client* client);
+  void RemoveSharedClient(Client* client);
+
+  // Has the shared clients drop the entries flagged for eviction.
+  void ReleaseSharedEvictions();
+
+  void RecordHit(CacheType type);
+  void RecordMiss(CacheType type);
+  void RecordEviction(CacheType type);
+  Stats GetStats(CacheType type) const;
+
+ private:
+  static void Pin(Client* client);
+  static void Unpin(Client* client);
+
+  uint64_t NextUseCount();
+  void Resize(Charge::Node* node, size_t bytes);
+  void CancelEviction(Charge::Node* node);
+  void Remove(Charge::Node* node);
+  // Flags the least recently used entries until the bytes not flagged are
+  // comfortably below the limit. Requires `lock_`.
+  void FlagLeastRecentlyUsed();
+
+  std::atomic<uint64_t> use_count_{0};
+  std::array<std::atomic<uint64_t>, kCacheTypeCount> hits_{};
+  std::array<std::atomic<uint64_t>, kCacheTypeCount> misses_{};
+  std::array<std::atomic<uint64_t>, kCacheTypeCount> evictions_{};
+
+  mutable std::mutex lock_;
+  size_t limit_ = 0;
+  size_t total_bytes_ = 0;
+  size_t flagged_bytes_ = 0;
+  std::array<size_t, kCacheTypeCount> bytes_{};
+  // Charges that may be evicted.
+  std::set<Charge::Node*> evictable_;
+
+  // Separate from `lock_`, which shared clients take while dropping entries.
+  std::mutex shared_clients_lock_;
+  std::set<Client*> shared_clients_;
+};
+
+#endif  // CORE_FXCRT_CFX_CACHEBUDGET_H_
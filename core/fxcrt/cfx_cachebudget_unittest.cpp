@@ -0,0 +1,189 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_cachebudget.h"
+
+#include <utility>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+using CacheType = CFX_CacheBudget::CacheType;
+
+class TestClient final : public CFX_CacheBudget::Client {
+ public:
+  int release_calls() const { return release_calls_; }
+
+ private:
+  // CFX_CacheBudget::Client:
+  void ReleaseFlaggedEntries() override { ++release_calls_; }
+
+  int release_calls_ = 0;
+};
+
+}  // namespace
+
+TEST(CFXCacheBudget, Stats) {
+  CFX_CacheBudget budget;
+  budget.RecordHit(CacheType::kGlyph);
+  budget.RecordHit(CacheType::kGlyph);
+  budget.RecordMiss(CacheType::kGlyph);
+  budget.RecordEviction(CacheType::kFont);
+
+  CFX_CacheBudget::Stats stats = budget.GetStats(CacheType::kGlyph);
+  EXPECT_EQ(2u, stats.hits);
+  EXPECT_EQ(1u, stats.misses);
+  EXPECT_EQ(0u, stats.evictions);
+  EXPECT_EQ(0u, stats.bytes);
+  EXPECT_EQ(1u, budget.GetStats(CacheType::kFont).evictions);
+
+  {
+    CFX_CacheBudget::Charge charge =
+        budget.CreateCharge(CacheType::kPageImage, nullptr);
+    EXPECT_EQ(0u, charge.size());
+    charge.SetSize(100);
+    EXPECT_EQ(100u, charge.size());
+    EXPECT_EQ(100u, budget.GetStats(CacheType::kPageImage).bytes);
+    charge.SetSize(40);
+    EXPECT_EQ(40u, budget.GetStats(CacheType::kPageImage).bytes);
+
+    CFX_CacheBudget::Charge moved = std::move(charge);
+    EXPECT_EQ(40u, moved.size());
+    EXPECT_EQ(40u, budget.GetStats(CacheType::kPageImage).bytes);
+  }
+  EXPECT_EQ(0u, budget.GetStats(CacheType::kPageImage).bytes);
+}
+
+TEST(CFXCacheBudget, EmptyCharge) {
+  CFX_CacheBudget::Charge charge;
+  charge.SetSize(100);
+  charge.Touch();
+  EXPECT_EQ(0u, charge.size());
+  EXPECT_FALSE(charge.IsEvictionRequested());
+}
+
+TEST(CFXCacheBudget, EvictsLeastRecentlyUsed) {
+  CFX_CacheBudget budget;
+  budget.SetLimit(1000);
+  TestClient images;
+  TestClient glyphs;
+  CFX_CacheBudget::Charge image1 =
+      budget.CreateCharge(CacheType::kPageImage, &images);
+  CFX_CacheBudget::Charge glyph =
+      budget.CreateCharge(CacheType::kGlyph, &glyphs);
+  CFX_CacheBudget::Charge image2 =
+      budget.CreateCharge(CacheType::kPageImage, &images);
+  image1.SetSize(400);
+  glyph.SetSize(300);
+  image2.SetSize(300);
+  EXPECT_FALSE(images.TakeEvictionRequest());
+  EXPECT_FALSE(glyphs.TakeEvictionRequest());
+
+  // Going over the limit flags the oldest entries across caches, until the
+  // total is at most 7/8 of the limit.
+  image1.Touch();
+  CFX_CacheBudget::Charge font = budget.CreateCharge(CacheType::kFont, nullptr);
+  font.SetSize(200);
+  EXPECT_FALSE(image1.IsEvictionRequested());
+  EXPECT_TRUE(glyph.IsEvictionRequested());
+  EXPECT_TRUE(image2.IsEvictionRequested());
+  EXPECT_FALSE(font.IsEvictionRequested());
+  EXPECT_TRUE(images.TakeEvictionRequest());
+  EXPECT_FALSE(images.TakeEvictionRequest());
+  EXPECT_TRUE(glyphs.TakeEvictionRequest());
+
+  // Flagged bytes still count until the entry goes away.
+  EXPECT_EQ(300u, budget.GetStats(CacheType::kGlyph).bytes);
+  glyph = CFX_CacheBudget::Charge();
+  EXPECT_EQ(0u, budget.GetStats(CacheType::kGlyph).bytes);
+
+  // Using an entry again cancels its eviction.
+  image2.Touch();
+  EXPECT_FALSE(image2.IsEvictionRequested());
+  EXPECT_FALSE(image1.IsEvictionRequested());
+  EXPECT_EQ(700u, budget.GetStats(CacheType::kPageImage).bytes);
+}
+
+TEST(CFXCacheBudget, NeverEvictsUnownedCharges) {
+  CFX_CacheBudget budget;
+  budget.SetLimit(100);
+  CFX_CacheBudget::Charge charge =
+      budget.CreateCharge(CacheType::kType3Glyph, nullptr);
+  charge.SetSize(1000);
+  EXPECT_FALSE(charge.IsEvictionRequested());
+}
+
+TEST(CFXCacheBudget, LoweringLimitEvicts) {
+  CFX_CacheBudget budget;
+  TestClient client;
+  CFX_CacheBudget::Charge charge =
+      budget.CreateCharge(CacheType::kColorSpace, &client);
+  charge.SetSize(1000);
+  EXPECT_FALSE(charge.IsEvictionRequested());
+  EXPECT_EQ(0u, budget.GetLimit());
+
+  budget.SetLimit(2000);
+  EXPECT_FALSE(charge.IsEvictionRequested());
+  budget.SetLimit(500);
+  EXPECT_EQ(500u, budget.GetLimit());
+  EXPECT_TRUE(charge.IsEvictionRequested());
+  EXPECT_TRUE(client.TakeEvictionRequest());
+}
+
+TEST(CFXCacheBudget, Pins) {
+  CFX_CacheBudget budget;
+  budget.SetLimit(100);
+  TestClient client;
+  CFX_CacheBudget::Charge charge =
+      budget.CreateCharge(CacheType::kGlyph, &client);
+  EXPECT_FALSE(client.IsPinned());
+  {
+    CFX_CacheBudget::ScopedPin pin(&client);
+    EXPECT_TRUE(client.IsPinned());
+    {
+      CFX_CacheBudget::ScopedPin nested_pin(&client);
+      charge.SetSize(200);
+    }
+    // Still pinned by the outer pin.
+    EXPECT_TRUE(client.IsPinned());
+    EXPECT_EQ(0, client.release_calls());
+  }
+  EXPECT_FALSE(client.IsPinned());
+  EXPECT_EQ(1, client.release_calls());
+
+  // Without a pending request, unpinning does not notify the client.
+  EXPECT_TRUE(client.TakeEvictionRequest());
+  { CFX_CacheBudget::ScopedPin pin(&client); }
+  EXPECT_EQ(1, client.release_calls());
+}
+
+TEST(CFXCacheBudget, ReleaseSharedEvictions) {
+  CFX_CacheBudget budget;
+  TestClient shared;
+  TestClient other;
+  budget.AddSharedClient(&shared);
+  CFX_CacheBudget::Charge shared_charge =
+      budget.CreateCharge(CacheType::kJBig2SymbolDict, &shared);
+  CFX_CacheBudget::Charge other_charge =
+      budget.CreateCharge(CacheType::kFont, &other);
+  shared_charge.SetSize(100);
+  other_charge.SetSize(100);
+
+  // Nothing to release yet.
+  budget.ReleaseSharedEvictions();
+  EXPECT_EQ(0, shared.release_calls());
+
+  budget.SetLimit(50);
+  EXPECT_TRUE(shared_charge.IsEvictionRequested());
+  EXPECT_TRUE(other_charge.IsEvictionRequested());
+  budget.ReleaseSharedEvictions();
+  EXPECT_EQ(1, shared.release_calls());
+  // Other clients release their entries on their own thread.
+  EXPECT_EQ(0, other.release_calls());
+
+  budget.RemoveSharedClient(&shared);
+  budget.ReleaseSharedEvictions();
+  EXPECT_EQ(1, shared.release_calls());
+}
@@ -34,6 +34,9 @@ class CFX_ReadOnlyContainerStream final : public CFX_ReadOnlySpanStream {
  public:
   CONSTRUCT_VIA_MAKE_RETAIN;
 
+  // IFX_SeekableReadStream:
+  pdfium::span<const uint8_t> GetOwnedSpan() override { return span_; }
+
  private:
   explicit CFX_ReadOnlyContainerStream(Container data)
     requires(HasPtrSpanMethod<Container>)
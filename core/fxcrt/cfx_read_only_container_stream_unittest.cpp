@@ -32,6 +32,8 @@ TEST(CFX_ReadOnlyContainerStreamTest, FromDataVector) {
   EXPECT_THAT(buffer, testing::ElementsAre('b', 'c'));
 
   EXPECT_THAT(stream->span(), testing::ElementsAre('a', 'b', 'c', 'd'));
+  EXPECT_EQ(stream->span().data(), stream->GetOwnedSpan().data());
+  EXPECT_EQ(4u, stream->GetOwnedSpan().size());
 }
 
 TEST(CFX_ReadOnlyContainerStreamTest, FromFixedSizeDataVector) {
@@ -52,6 +54,13 @@ TEST(CFX_ReadOnlyContainerStreamTest, FromFixedSizeDataVector) {
   EXPECT_THAT(stream->span(), testing::ElementsAre('e', 'f', 'g', 'h'));
 }
 
+TEST(CFX_ReadOnlyContainerStreamTest, SpanStreamDoesNotOwnData) {
+  static const uint8_t kData[] = {'a', 'b', 'c'};
+  auto stream = pdfium::MakeRetain<CFX_ReadOnlySpanStream>(kData);
+  EXPECT_EQ(3, stream->GetSize());
+  EXPECT_TRUE(stream->GetOwnedSpan().empty());
+}
+
 TEST(CFX_ReadOnlyContainerStreamTest, OutOfBoundsRead) {
   DataVector<uint8_t> data = {'a', 'b', 'c'};
   auto stream =
@@ -76,5 +85,6 @@ TEST_F(CFX_ReadOnlyTemporaryTest, FromFile) {
   ASSERT_TRUE(stream);
   EXPECT_EQ(5, stream->GetSize());
   EXPECT_THAT(stream->span(), testing::ElementsAre('f', 'i', 'l', 'e', 's'));
+  EXPECT_EQ(stream->span().data(), stream->GetOwnedSpan().data());
 }
 #endif
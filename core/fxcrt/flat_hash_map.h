@@ -0,0 +1,151 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_FLAT_HASH_MAP_H_
+#define CORE_FXCRT_FLAT_HASH_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "core/fxcrt/check_op.h"
+
+namespace fxcrt {
+
+// Unordered map that keeps all entries in a single array and resolves
+// collisions by linear probing. Lookups never allocate, which makes it a good
+// fit for small keys that are looked up far more often than they are added,
+// such as cache keys.
+//
+// Unlike std::unordered_map, adding or removing entries may move other
+// entries, so pointers to values are invalidated by TryEmplace() and EraseIf().
+// Store values behind std::unique_ptr where pointers must stay valid.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap {
+ public:
+  FlatHashMap() = default;
+  FlatHashMap(const FlatHashMap&) = delete;
+  FlatHashMap& operator=(const FlatHashMap&) = delete;
+  FlatHashMap(FlatHashMap&&) noexcept = default;
+  FlatHashMap& operator=(FlatHashMap&&) noexcept = default;
+  ~FlatHashMap() = default;
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  void clear() {
+    slots_.clear();
+    size_ = 0;
+  }
+
+  Value* Find(const Key& key) {
+    return const_cast<Value*>(std::as_const(*this).Find(key));
+  }
+
+  const Value* Find(const Key& key) const {
+    if (slots_.empty()) {
+      return nullptr;
+    }
+    for (size_t i = SlotFor(key);; i = (i + 1) & Mask()) {
+      const std::optional<Entry>& slot = slots_[i];
+      if (!slot.has_value()) {
+        return nullptr;
+      }
+      if (slot->first == key) {
+        return &slot->second;
+      }
+    }
+  }
+
+  // Returns the value for `key` and true if it was added, constructing it from
+  // `args`. Otherwise, returns the existing value and false.
+  template <typename... Args>
+  std::pair<Value*, bool> TryEmplace(const Key& key, Args&&... args) {
+    if (Value* value = Find(key)) {
+      return {value, false};
+    }
+    if ((size_ + 1) * kMaxLoadDenominator >
+        slots_.size() * kMaxLoadNumerator) {
+      Rehash(slots_.empty() ? kMinCapacity : slots_.size() * 2);
+    }
+    size_t i = SlotFor(key);
+    while (slots_[i].has_value()) {
+      i = (i + 1) & Mask();
+    }
+    slots_[i].emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                      std::forward_as_tuple(std::forward<Args>(args)...));
+    ++size_;
+    return {&slots_[i]->second, true};
+  }
+
+  // Removes the entries for which `pred(key, value)` returns true, and returns
+  // how many were removed.
+  template <typename Pred>
+  size_t EraseIf(Pred pred) {
+    const size_t old_size = size_;
+    std::vector<std::optional<Entry>> old_slots = std::move(slots_);
+    slots_ = std::vector<std::optional<Entry>>(old_slots.size());
+    size_ = 0;
+    for (std::optional<Entry>& slot : old_slots) {
+      if (slot.has_value() && !pred(std::as_const(slot->first), slot->second)) {
+        Insert(std::move(*slot));
+      }
+    }
+    return old_size - size_;
+  }
+
+ private:
+  using Entry = std::pair<Key, Value>;
+
+  static constexpr size_t kMinCapacity = 8;
+  // Keep at most 3/4 of the slots in use, so probe sequences stay short.
+  static constexpr size_t kMaxLoadNumerator = 3;
+  static constexpr size_t kMaxLoadDenominator = 4;
+
+  size_t Mask() const { return slots_.size() - 1; }
+
+  size_t SlotFor(const Key& key) const {
+    // std::hash is the identity for integers in common implementations, so
+    // spread the bits with a Fibonacci multiplier before masking.
+    uint64_t hash = static_cast<uint64_t>(Hash()(key));
+    hash *= UINT64_C(0x9E3779B97F4A7C15);
+    return static_cast<size_t>(hash >> 32) & Mask();
+  }
+
+  void Rehash(size_t capacity) {
+    DCHECK_EQ(capacity & (capacity - 1), 0u);
+    std::vector<std::optional<Entry>> old_slots = std::move(slots_);
+    slots_ = std::vector<std::optional<Entry>>(capacity);
+    size_ = 0;
+    for (std::optional<Entry>& slot : old_slots) {
+      if (slot.has_value()) {
+        Insert(std::move(*slot));
+      }
+    }
+  }
+
+  // Inserts an entry whose key is known to be absent, without growing.
+  void Insert(Entry&& entry) {
+    size_t i = SlotFor(entry.first);
+    while (slots_[i].has_value()) {
+      i = (i + 1) & Mask();
+    }
+    slots_[i].emplace(std::move(entry));
+    ++size_;
+  }
+
+  std::vector<std::optional<Entry>> slots_;
+  size_t size_ = 0;
+};
+
+}  // namespace fxcrt
+
+using fxcrt::FlatHashMap;
+
+#endif  // CORE_FXCRT_FLAT_HASH_MAP_H_
@@ -0,0 +1,88 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/flat_hash_map.h"
+
+#include <map>
+#include <memory>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Sends every key to the same slot, so lookups must probe.
+struct CollidingHash {
+  size_t operator()(int) const { return 0; }
+};
+
+}  // namespace
+
+TEST(FlatHashMap, Empty) {
+  FlatHashMap<int, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_FALSE(map.Find(0));
+  EXPECT_EQ(0u, map.EraseIf([](int, int) { return true; }));
+}
+
+TEST(FlatHashMap, TryEmplace) {
+  FlatHashMap<int, int> map;
+  auto result = map.TryEmplace(1, 10);
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(10, *result.first);
+
+  result = map.TryEmplace(1, 20);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(10, *result.first);
+  EXPECT_EQ(1u, map.size());
+
+  ASSERT_TRUE(map.Find(1));
+  EXPECT_EQ(10, *map.Find(1));
+  *map.Find(1) = 30;
+  EXPECT_EQ(30, *map.Find(1));
+  EXPECT_FALSE(map.Find(2));
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.Find(1));
+}
+
+TEST(FlatHashMap, Grow) {
+  FlatHashMap<uint32_t, std::unique_ptr<uint32_t>> map;
+  std::map<uint32_t, const uint32_t*> pointers;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    const uint32_t key = i * 7919;
+    auto result = map.TryEmplace(key, std::make_unique<uint32_t>(i));
+    ASSERT_TRUE(result.second);
+    pointers[key] = result.first->get();
+  }
+  EXPECT_EQ(1000u, map.size());
+
+  // The unique_ptrs move when the table grows, but what they point to stays.
+  for (const auto& it : pointers) {
+    const std::unique_ptr<uint32_t>* value = map.Find(it.first);
+    ASSERT_TRUE(value);
+    EXPECT_EQ(it.second, value->get());
+  }
+  EXPECT_FALSE(map.Find(1));
+}
+
+TEST(FlatHashMap, Collisions) {
+  FlatHashMap<int, int, CollidingHash> map;
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_TRUE(map.TryEmplace(i, i * 2).second);
+  }
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_TRUE(map.Find(i));
+    EXPECT_EQ(i * 2, *map.Find(i));
+  }
+  EXPECT_FALSE(map.Find(20));
+
+  // Removing entries must not break the probe sequences of the others.
+  EXPECT_EQ(10u, map.EraseIf([](int key, int) { return key % 2 == 0; }));
+  EXPECT_EQ(10u, map.size());
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_EQ(i % 2 != 0, !!map.Find(i));
+  }
+}
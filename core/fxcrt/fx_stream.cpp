@@ -37,3 +37,7 @@ bool IFX_SeekableReadStream::IsEOF() {
 FX_FILESIZE IFX_SeekableReadStream::GetPosition() {
   return 0;
 }
+
+pdfium::span<const uint8_t> IFX_SeekableReadStream::GetOwnedSpan() {
+  return {};
+}
@@ -53,6 +53,10 @@ class IFX_SeekableReadStream : virtual public Retainable,
  public:
   virtual bool IsEOF();
   virtual FX_FILESIZE GetPosition();
+  // Returns the entire contents if the stream keeps them in memory it owns,
+  // so they stay valid for as long as the stream is retained. Otherwise,
+  // returns an empty span and callers must use ReadBlockAtOffset().
+  virtual pdfium::span<const uint8_t> GetOwnedSpan();
   [[nodiscard]] virtual bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
                                                FX_FILESIZE offset) = 0;
 };
@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <cstddef>
 #include <functional>
 #include <memory>
@@ -149,12 +150,20 @@ class TRIVIAL_ABI RetainPtr {
   std::unique_ptr<T, ReleaseDeleter<T>> obj_;
 };
 
-// Trivial implementation - internal ref count with virtual destructor.
+// Trivial implementation - internal ref count with virtual destructor. The
+// count is atomic so that objects held by process-wide caches (stock
+// colorspaces, fonts, CMaps) may be shared by documents on different threads.
+// This is paid by single-threaded embedders too: every Retain() and Release()
+// is a locked read-modify-write, which even uncontended is several times
+// slower than a plain increment or decrement. Avoid copying RetainPtrs in hot
+// loops; pass raw pointers or const references where the caller owns a ref.
 class Retainable {
  public:
   Retainable() = default;
 
-  bool HasOneRef() const { return ref_count_ == 1; }
+  bool HasOneRef() const {
+    return ref_count_.load(std::memory_order_acquire) == 1;
+  }
 
  protected:
   virtual ~Retainable() = default;
@@ -166,6 +175,9 @@ class Retainable {
   template <typename U>
   friend class RetainPtr;
 
+  template <typename U>
+  friend RetainPtr<U> WrapRetainIfAlive(U* that);
+
   Retainable(const Retainable& that) = delete;
   Retainable& operator=(const Retainable& that) = delete;
 
@@ -173,22 +185,47 @@ class Retainable {
   // RetainPtr<const T> can be used for an object that is otherwise const
   // apart from the internal ref-counting.
   void Retain() const {
-    ++ref_count_;
-    CHECK(ref_count_ > 0);
+    uintptr_t old_count = ref_count_.fetch_add(1, std::memory_order_relaxed);
+    CHECK(old_count + 1 > 0);
+  }
+  // Takes a reference unless the count has already dropped to zero.
+  bool TryRetain() const {
+    uintptr_t old_count = ref_count_.load(std::memory_order_relaxed);
+    while (old_count != 0) {
+      if (ref_count_.compare_exchange_weak(old_count, old_count + 1,
+                                           std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
   }
   void Release() const {
-    CHECK(ref_count_ > 0);
-    if (--ref_count_ == 0) {
+    uintptr_t old_count = ref_count_.fetch_sub(1, std::memory_order_acq_rel);
+    CHECK(old_count > 0);
+    if (old_count == 1) {
       delete this;
     }
   }
 
-  mutable uintptr_t ref_count_ = 0;
-  static_assert(std::is_unsigned<decltype(ref_count_)>::value,
+  mutable std::atomic<uintptr_t> ref_count_{0};
+  static_assert(std::is_unsigned<uintptr_t>::value,
                 "ref_count_ must be an unsigned type for overflow check"
                 "to work properly in Retain()");
 };
 
+// Makes a RetainPtr from a pointer held unretained by a cache that is shared
+// across threads, unless the object's last reference is concurrently being
+// released. Returns nullptr in that case. Callers must ensure, typically by
+// holding the cache's lock, that the object has not yet been destroyed.
+template <typename T>
+RetainPtr<T> WrapRetainIfAlive(T* that) {
+  RetainPtr<T> result;
+  if (that && that->TryRetain()) {
+    result.Unleak(that);
+  }
+  return result;
+}
+
 }  // namespace fxcrt
 
 using fxcrt::ReleaseDeleter;
@@ -213,6 +250,8 @@ RetainPtr<T> WrapRetain(T* that) {
   return RetainPtr<T>(that);
 }
 
+using fxcrt::WrapRetainIfAlive;
+
 }  // namespace pdfium
 
 // Macro to allow construction via MakeRetain<>() only, when used
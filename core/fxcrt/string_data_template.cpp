@@ -55,7 +55,7 @@ RetainPtr<StringDataTemplate<CharType>> StringDataTemplate<CharType>::Create(
 
 template <typename CharType>
 void StringDataTemplate<CharType>::Release() {
-  if (--refs_ <= 0) {
+  if (refs_.fetch_sub(1, std::memory_order_acq_rel) <= 1) {
     FX_StringFree(this);
   }
 }
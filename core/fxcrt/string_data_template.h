@@ -10,6 +10,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <string>
 
 #include "core/fxcrt/retain_ptr.h"
@@ -23,11 +24,12 @@ class StringDataTemplate {
   static RetainPtr<StringDataTemplate> Create(size_t nLen);
   static RetainPtr<StringDataTemplate> Create(pdfium::span<const CharType> str);
 
-  void Retain() { ++refs_; }
+  void Retain() { refs_.fetch_add(1, std::memory_order_relaxed); }
   void Release();
 
   bool CanOperateInPlace(size_t nTotalLen) const {
-    return refs_ <= 1 && nTotalLen <= alloc_length_;
+    return refs_.load(std::memory_order_acquire) <= 1 &&
+           nTotalLen <= alloc_length_;
   }
 
   void CopyContents(const StringDataTemplate& other);
@@ -86,8 +88,10 @@ class StringDataTemplate {
   // the entire address space contains nothing but pointers to this object.
   // Since the count increments with each new pointer, the largest value is
   // the number of pointers that can fit into the address space. The size of
-  // the address space itself is a good upper bound on it.
-  intptr_t refs_ = 0;
+  // the address space itself is a good upper bound on it. Atomic so that
+  // strings held by process-wide caches may be shared across threads, at the
+  // same cost per copy as Retainable's count (see retain_ptr.h).
+  std::atomic<intptr_t> refs_{0};
 
   // These lengths are in terms of number of characters, not bytes, and do not
   // include the terminating NUL character, but the underlying buffer is sized
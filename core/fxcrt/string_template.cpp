@@ -52,7 +52,7 @@ void StringTemplate<T>::ReleaseBuffer(size_t nNewLength) {
     clear();
     return;
   }
-  DCHECK_EQ(data_->refs_, 1);
+  DCHECK_EQ(data_->refs_.load(std::memory_order_relaxed), 1);
   data_->data_length_ = nNewLength;
   data_->capacity_span()[nNewLength] = 0;
   if (data_->alloc_length_ - nNewLength >= 32) {
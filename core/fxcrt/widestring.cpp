@@ -528,7 +528,7 @@ bool WideString::operator<(const WideString& other) const {
 }
 
 intptr_t WideString::ReferenceCountForTesting() const {
-  return data_ ? data_->refs_ : 0;
+  return data_ ? data_->refs_.load(std::memory_order_relaxed) : 0;
 }
 
 ByteString WideString::ToASCII() const {
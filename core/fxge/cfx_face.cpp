@@ -364,6 +364,7 @@ struct SkrifaFontHolder {
 RetainPtr<CFX_Face> CFX_Face::New(RetainPtr<Retainable> cache_entry,
                                   RetainPtr<CFX_ReadOnlySpanStream> font_stream,
                                   uint32_t face_index) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   CFX_FontMgr* font_mgr = CFX_GEModule::Get()->GetFontMgr();
   pdfium::span<const uint8_t> data = font_stream->span();
   FT_FaceRec* face_rec = nullptr;
@@ -635,6 +636,7 @@ pdfium::span<const uint8_t> CFX_Face::GetData() const {
 }
 
 size_t CFX_Face::GetSfntTable(uint32_t table, pdfium::span<uint8_t> buffer) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   size_t ft_result = 0;
   unsigned long length = pdfium::checked_cast<unsigned long>(buffer.size());
   if (length) {
@@ -816,6 +818,7 @@ std::unique_ptr<CFX_GlyphBitmap> CFX_Face::RenderGlyph(
     int dest_width,
     FontAntiAliasingMode anti_alias,
     const CFX_SubstFont* subst_font) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   // TODO(https://crbug.com/42271123): Implement glyph rendering in
   // Skia/Fontations.
   FT_Matrix ft_matrix;
@@ -917,6 +920,7 @@ std::unique_ptr<CFX_Path> CFX_Face::LoadGlyphPath(
     int dest_width,
     bool is_vertical,
     const CFX_SubstFont* subst_font) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
 #if defined(PDF_ENABLE_FONTATIONS)
   if (CFX_GEModule::Get()->GetFontMgr()->GetFontBackend() ==
       CFX_FontMgr::FontBackend::kFontations) {
@@ -986,6 +990,7 @@ std::unique_ptr<CFX_Path> CFX_Face::LoadGlyphPath(
 }
 
 int CFX_Face::GetGlyphTTWidth(uint32_t glyph_index) const {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   const auto* fontglyph = GetRec()->glyph;
   DCHECK_EQ(glyph_index, fontglyph->glyph_index);
 
@@ -1021,6 +1026,7 @@ int CFX_Face::GetGlyphWidth(uint32_t glyph_index,
                             int dest_width,
                             int weight,
                             const CFX_SubstFont* subst_font) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   if (subst_font && subst_font->IsBuiltInGenericFont()) {
     AdjustVariationParams(glyph_index, dest_width, weight);
   }
@@ -1055,6 +1061,7 @@ int CFX_Face::GetGlyphWidth(uint32_t glyph_index,
 }
 
 ByteString CFX_Face::GetGlyphName(uint32_t glyph_index) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   char name[256] = {};
   FT_Get_Glyph_Name(GetRec(), glyph_index, name, sizeof(name));
   name[255] = 0;
@@ -1076,6 +1083,7 @@ ByteString CFX_Face::GetGlyphName(uint32_t glyph_index) {
 }
 
 int CFX_Face::GetCharIndex(uint32_t code) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
 #if defined(PDF_ENABLE_FONTATIONS)
   if (CFX_GEModule::Get()->GetFontMgr()->GetFontBackend() ==
       CFX_FontMgr::FontBackend::kFontations) {
@@ -1127,6 +1135,7 @@ int CFX_Face::GetCharIndex(uint32_t code) {
 }
 
 int CFX_Face::GetNameIndex(const char* name) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   int ft_result = FT_Get_Name_Index(GetRec(), name);
 
 #if defined(PDF_ENABLE_SKIA_TYPEFACE_CHECKS)
@@ -1142,6 +1151,7 @@ int CFX_Face::GetNameIndex(const char* name) {
 }
 
 int CFX_Face::LoadGlyph(uint32_t glyph_index, bool scale) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   FT_Int32 args = FT_LOAD_IGNORE_GLOBAL_ADVANCE_WIDTH;
   if (!scale) {
     args |= FT_LOAD_NO_SCALE;
@@ -1166,6 +1176,7 @@ int CFX_Face::LoadGlyph(uint32_t glyph_index, bool scale) {
 }
 
 ByteString CFX_Face::GetPostscriptName() {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   const char* ft_result = FT_Get_Postscript_Name(GetRec());
 #if defined(PDF_ENABLE_SKIA_TYPEFACE_CHECKS)
 #if defined(PDF_ENABLE_FONTATIONS)
@@ -1198,6 +1209,7 @@ CFX_Size CFX_Face::GetPixelSize() const {
 }
 
 std::optional<FX_RECT> CFX_Face::GetFontGlyphBBox(uint32_t glyph_index) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   if (IsTricky()) {
     int error = FT_Set_Char_Size(GetRec(), 0, 1000 * 64, 72, 72);
     if (error) {
@@ -1256,6 +1268,7 @@ std::optional<FX_RECT> CFX_Face::GetFontGlyphBBox(uint32_t glyph_index) {
 }
 
 FX_RECT CFX_Face::GetCharBBox(uint32_t code, int glyph_index) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   FX_RECT rect;
   FT_FaceRec* rec = GetRec();
   if (IsTricky()) {
@@ -1319,6 +1332,7 @@ FX_RECT CFX_Face::GetCharBBox(uint32_t code, int glyph_index) {
 }
 
 FX_RECT CFX_Face::GetGlyphBBox(uint32_t glyph_index) const {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   const auto* glyph = GetRec()->glyph;
   DCHECK_EQ(glyph_index, glyph->glyph_index);
 
@@ -1375,6 +1389,7 @@ FX_RECT CFX_Face::GetGlyphBBox(uint32_t glyph_index) const {
 
 std::vector<CharCodeAndIndex> CFX_Face::GetCharCodesAndIndices(
     char32_t max_char) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   CharCodeAndIndex char_code_and_index;
   char_code_and_index.char_code = static_cast<uint32_t>(
       FT_Get_First_Char(GetRec(), &char_code_and_index.glyph_index));
@@ -1470,12 +1485,14 @@ pdfium::span<const FT_CharMap> CFX_Face::GetCharMaps() const {
 }
 
 void CFX_Face::SetCharMap(CharMap map) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   // TODO(https://crbug.com/42271123): Implement charmap management in
   // Skia/Fontations.
   FT_Set_Charmap(GetRec(), static_cast<FT_CharMap>(map));
 }
 
 void CFX_Face::SetCharMapByIndex(size_t index) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   // TODO(https://crbug.com/42271123): Implement charmap management in
   // Skia/Fontations.
   CHECK_LT(index, GetCharMapCount());
@@ -1484,6 +1501,7 @@ void CFX_Face::SetCharMapByIndex(size_t index) {
 }
 
 bool CFX_Face::SelectCharMap(fxge::FontEncoding encoding) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   // TODO(https://crbug.com/42271123): Implement charmap management in
   // Skia/Fontations.
   FT_Error error = FT_Select_Charmap(GetRec(), ToFTEncoding(encoding));
@@ -1556,11 +1574,17 @@ SkTypeface* CFX_Face::GetOrCreateSkTypeface() {
 }
 #endif  // defined(PDF_USE_SKIA)
 
-CFX_Face::~CFX_Face() = default;
+CFX_Face::~CFX_Face() {
+  // Detach from CFX_FontMapper's cache entries while concurrent lookups are
+  // excluded.
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
+  NotifyObservers();
+}
 
 void CFX_Face::AdjustVariationParams(int glyph_index,
                                      int dest_width,
                                      int weight) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   // TODO(https://crbug.com/42271123): Implement variation parameters adjustment
   // in Skia/Fontations.
   DCHECK_GE(dest_width, 0);
@@ -88,6 +88,8 @@ class CFX_Font {
   void SetSubstFont(std::unique_ptr<CFX_SubstFont> subst);
 #endif  // defined(PDF_ENABLE_XFA) && !BUILDFLAG(IS_WIN)
 
+  RetainPtr<CFX_GlyphCache> GetOrCreateGlyphCache() const;
+  // See CFX_GlyphCache::LoadGlyphBitmap() for the lifetime of the result.
   const CFX_GlyphBitmap* LoadGlyphBitmap(
       uint32_t glyph_index,
       bool is_cid_font,
@@ -140,7 +142,6 @@ class CFX_Font {
 #endif
 
  private:
-  RetainPtr<CFX_GlyphCache> GetOrCreateGlyphCache() const;
   void ClearGlyphCache();
 #if BUILDFLAG(IS_APPLE)
   void ReleasePlatformResource();
@@ -512,6 +512,8 @@ RetainPtr<CFX_Face> CFX_FontMapper::FindSubstFace(const ByteString& name,
                                                   int italic_angle,
                                                   FX_CodePage code_page,
                                                   CFX_SubstFont* subst_font) {
+  // Faces found here are cached and shared by all documents.
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   if (weight == 0) {
     weight = pdfium::kFontWeightNormal;
   }
@@ -803,7 +805,8 @@ RetainPtr<CFX_Face> CFX_FontMapper::GetCachedTTCFace(void* font_handle,
   size_t font_offset = ttc_size - data_size;
   uint32_t face_index =
       GetTTCIndex(cache_entry->FontStream()->span(), font_offset);
-  RetainPtr<CFX_Face> face(cache_entry->GetFace(face_index));
+  RetainPtr<CFX_Face> face =
+      pdfium::WrapRetainIfAlive(cache_entry->GetFace(face_index));
   if (face) {
     return face;
   }
@@ -835,7 +838,8 @@ RetainPtr<CFX_Face> CFX_FontMapper::GetCachedFace(void* font_handle,
     cache_entry =
         AddFontCacheEntry(subst_name, weight, is_italic, std::move(font_data));
   }
-  RetainPtr<CFX_Face> face(cache_entry->GetFace(0));
+  RetainPtr<CFX_Face> face =
+      pdfium::WrapRetainIfAlive(cache_entry->GetFace(0));
   if (face) {
     return face;
   }
@@ -854,7 +858,11 @@ CFX_FontMapper::FontCacheEntry::FontCacheEntry(
     : font_stream_(pdfium::MakeRetain<CFX_ReadOnlyFixedSizeDataVectorStream>(
           std::move(data))) {}
 
-CFX_FontMapper::FontCacheEntry::~FontCacheEntry() = default;
+CFX_FontMapper::FontCacheEntry::~FontCacheEntry() {
+  // Detach from CFX_FontMapper's maps while concurrent lookups are excluded.
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
+  NotifyObservers();
+}
 
 void CFX_FontMapper::FontCacheEntry::SetFace(uint32_t face_index,
                                              CFX_Face* face) {
@@ -872,7 +880,8 @@ RetainPtr<CFX_FontMapper::FontCacheEntry> CFX_FontMapper::GetFontCacheEntry(
     int weight,
     bool italic) {
   auto it = face_map_.find({face_name, weight, italic});
-  return it != face_map_.end() ? pdfium::WrapRetain(it->second.Get()) : nullptr;
+  return it != face_map_.end() ? pdfium::WrapRetainIfAlive(it->second.Get())
+                               : nullptr;
 }
 
 RetainPtr<CFX_FontMapper::FontCacheEntry> CFX_FontMapper::AddFontCacheEntry(
@@ -889,8 +898,9 @@ RetainPtr<CFX_FontMapper::FontCacheEntry> CFX_FontMapper::GetTTCFontCacheEntry(
     size_t ttc_size,
     uint32_t checksum) {
   auto it = ttc_face_map_.find({ttc_size, checksum});
-  return it != ttc_face_map_.end() ? pdfium::WrapRetain(it->second.Get())
-                                   : nullptr;
+  return it != ttc_face_map_.end()
+             ? pdfium::WrapRetainIfAlive(it->second.Get())
+             : nullptr;
 }
 
 RetainPtr<CFX_FontMapper::FontCacheEntry> CFX_FontMapper::AddTTCFontCacheEntry(
@@ -83,9 +83,14 @@ CFX_FontMgr::~CFX_FontMgr() = default;
 
 RetainPtr<CFX_GlyphCache> CFX_FontMgr::GetGlyphCache(const CFX_Font* font) {
   RetainPtr<CFX_Face> face = font->GetFace();
+  GlyphCacheLock lock = AcquireGlyphCacheLock();
   auto it = glyph_cache_map_.find(face.Get());
   if (it != glyph_cache_map_.end() && it->second) {
-    return pdfium::WrapRetain(it->second.Get());
+    RetainPtr<CFX_GlyphCache> cache =
+        pdfium::WrapRetainIfAlive(it->second.Get());
+    if (cache) {
+      return cache;
+    }
   }
   auto new_cache = pdfium::MakeRetain<CFX_GlyphCache>(face);
   glyph_cache_map_[face.Get()].Reset(new_cache.Get());
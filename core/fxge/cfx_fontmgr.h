@@ -12,6 +12,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
@@ -36,10 +37,16 @@ class CFX_FontMgr {
  public:
   enum class FontBackend { kFreeType, kFontations };  // Currently skia-only.
 
+  using GlyphCacheLock = std::unique_lock<std::mutex>;
+
   explicit CFX_FontMgr(FontBackend backend);
   ~CFX_FontMgr();
 
+  // Thread-safe. Glyph caches are shared by all fonts using the same face.
   RetainPtr<CFX_GlyphCache> GetGlyphCache(const CFX_Font* font);
+  GlyphCacheLock AcquireGlyphCacheLock() {
+    return GlyphCacheLock(glyph_cache_lock_);
+  }
 
   // Always present.
   CFX_FontMapper* GetBuiltinMapper() const { return builtin_mapper_.get(); }
@@ -64,6 +71,7 @@ class CFX_FontMgr {
   sk_sp<SkFontMgr> skia_fontmgr_fallback_;
 #endif
   std::unique_ptr<CFX_FontMapper> builtin_mapper_;
+  std::mutex glyph_cache_lock_;  // Guards `glyph_cache_map_`.
   std::map<CFX_Face*, ObservedPtr<CFX_GlyphCache>> glyph_cache_map_;
   const bool ft_library_supports_hinting_;
 };
@@ -15,10 +15,12 @@
 #include "core/fxcrt/span.h"
 #include "core/fxcrt/to_underlying.h"
 #include "core/fxge/cfx_font.h"
+#include "core/fxge/cfx_fontmgr.h"
 #include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_glyphbitmap.h"
 #include "core/fxge/cfx_path.h"
 #include "core/fxge/cfx_substfont.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/fx_font.h"
 
 #if BUILDFLAG(IS_APPLE)
@@ -29,79 +31,95 @@ namespace {
 
 constexpr uint32_t kInvalidGlyphIndex = static_cast<uint32_t>(-1);
 
-class UniqueKeyGen {
- public:
-  UniqueKeyGen(const CFX_Font* font,
-               const CFX_Matrix& matrix,
-               int dest_width,
-               FontAntiAliasingMode anti_alias,
-               bool bNative);
-
-  pdfium::span<const uint8_t> span() const;
+size_t EstimateGlyphSize(const CFX_GlyphBitmap* glyph) {
+  if (!glyph) {
+    return 0;
+  }
+  return sizeof(CFX_GlyphBitmap) +
+         glyph->GetBitmap()->GetEstimatedImageMemoryBurden();
+}
 
- private:
-  void Initialize(std::initializer_list<const int> args);
+// Combines `values` into a hash. FlatHashMap mixes the result further, so
+// this only needs to avoid trivial collisions.
+size_t HashValues(std::initializer_list<uint32_t> values) {
+  size_t hash = 0;
+  for (uint32_t value : values) {
+    hash = (hash ^ value) * 0x01000193u;
+  }
+  return hash;
+}
 
-  size_t key_len_;
-  uint32_t key_[32];
-};
+}  // namespace
 
-void UniqueKeyGen::Initialize(std::initializer_list<const int32_t> args) {
-  auto key_span = pdfium::span<uint32_t, pdfium::dynamic_extent>(key_);
-  for (const auto& arg : args) {
-    key_span.front() = arg;
-    key_span = key_span.subspan<1u>();
-  }
-  key_len_ = args.size();
+size_t CFX_GlyphCache::SizeKey::Hash::operator()(const SizeKey& key) const {
+  return HashValues({static_cast<uint32_t>(key.matrix[0]),
+                     static_cast<uint32_t>(key.matrix[1]),
+                     static_cast<uint32_t>(key.matrix[2]),
+                     static_cast<uint32_t>(key.matrix[3]),
+                     static_cast<uint32_t>(key.dest_width),
+                     static_cast<uint32_t>(key.weight),
+                     static_cast<uint32_t>(key.italic_angle),
+                     key.anti_alias | key.has_subst_font << 8 |
+                         key.vertical << 9 | key.native << 10});
 }
 
-pdfium::span<const uint8_t> UniqueKeyGen::span() const {
-  return pdfium::as_bytes(pdfium::span(key_).first(key_len_));
+size_t CFX_GlyphCache::PathKey::Hash::operator()(const PathKey& key) const {
+  return HashValues({key.glyph_index, static_cast<uint32_t>(key.dest_width),
+                     static_cast<uint32_t>(key.weight),
+                     static_cast<uint32_t>(key.italic_angle), key.vertical});
 }
 
-UniqueKeyGen::UniqueKeyGen(const CFX_Font* font,
-                           const CFX_Matrix& matrix,
-                           int dest_width,
-                           FontAntiAliasingMode anti_alias,
-                           bool bNative) {
-  int nMatrixA = static_cast<int>(matrix.a * 10000);
-  int nMatrixB = static_cast<int>(matrix.b * 10000);
-  int nMatrixC = static_cast<int>(matrix.c * 10000);
-  int nMatrixD = static_cast<int>(matrix.d * 10000);
+size_t CFX_GlyphCache::WidthKey::Hash::operator()(const WidthKey& key) const {
+  return HashValues({key.glyph_index, static_cast<uint32_t>(key.dest_width),
+                     static_cast<uint32_t>(key.weight)});
+}
 
-#if BUILDFLAG(IS_APPLE)
-  if (bNative) {
-    if (font->GetSubstFont()) {
-      Initialize(
-          {nMatrixA, nMatrixB, nMatrixC, nMatrixD, dest_width,
-           fxcrt::to_underlying(anti_alias), font->GetSubstFont()->GetWeight(),
-           font->GetSubstFont()->GetItalicAngle(), font->IsVertical(), 3});
-    } else {
-      Initialize({nMatrixA, nMatrixB, nMatrixC, nMatrixD, dest_width,
-                  fxcrt::to_underlying(anti_alias), 3});
-    }
-    return;
+// static
+CFX_GlyphCache::SizeKey CFX_GlyphCache::MakeSizeKey(
+    const CFX_Font* font,
+    const CFX_Matrix& matrix,
+    int dest_width,
+    FontAntiAliasingMode anti_alias,
+    bool native) {
+  SizeKey key = {};
+  key.matrix[0] = static_cast<int32_t>(matrix.a * 10000);
+  key.matrix[1] = static_cast<int32_t>(matrix.b * 10000);
+  key.matrix[2] = static_cast<int32_t>(matrix.c * 10000);
+  key.matrix[3] = static_cast<int32_t>(matrix.d * 10000);
+  key.dest_width = dest_width;
+  key.anti_alias = static_cast<uint8_t>(fxcrt::to_underlying(anti_alias));
+  key.native = native;
+  const CFX_SubstFont* subst_font = font->GetSubstFont();
+  if (subst_font) {
+    key.has_subst_font = true;
+    key.weight = subst_font->GetWeight();
+    key.italic_angle = subst_font->GetItalicAngle();
+    key.vertical = font->IsVertical();
   }
-#endif
+  return key;
+}
 
-  CHECK(!bNative);
-  if (font->GetSubstFont()) {
-    Initialize({nMatrixA, nMatrixB, nMatrixC, nMatrixD, dest_width,
-                fxcrt::to_underlying(anti_alias),
-                font->GetSubstFont()->GetWeight(),
-                font->GetSubstFont()->GetItalicAngle(), font->IsVertical()});
-  } else {
-    Initialize({nMatrixA, nMatrixB, nMatrixC, nMatrixD, dest_width,
-                fxcrt::to_underlying(anti_alias)});
-  }
+CFX_GlyphCache::CFX_GlyphCache(RetainPtr<CFX_Face> face)
+    : face_(std::move(face)) {
+  CFX_CacheBudget::Get()->AddSharedClient(this);
 }
 
-}  // namespace
+CFX_GlyphCache::~CFX_GlyphCache() {
+  CFX_CacheBudget::Get()->RemoveSharedClient(this);
 
-CFX_GlyphCache::CFX_GlyphCache(RetainPtr<CFX_Face> face)
-    : face_(std::move(face)) {}
+  // Detach from CFX_FontMgr's map under its lock, so that a concurrent
+  // lookup either sees this cache with a zero count or not at all.
+  CFX_FontMgr::GlyphCacheLock lock =
+      CFX_GEModule::Get()->GetFontMgr()->AcquireGlyphCacheLock();
+  NotifyObservers();
+}
+
+CFX_GlyphCache::SizeGlyphs::SizeGlyphs(CFX_CacheBudget::Charge charge)
+    : charge(std::move(charge)) {}
 
-CFX_GlyphCache::~CFX_GlyphCache() = default;
+CFX_GlyphCache::SizeGlyphs::SizeGlyphs(SizeGlyphs&& that) noexcept = default;
+
+CFX_GlyphCache::SizeGlyphs::~SizeGlyphs() = default;
 
 std::unique_ptr<CFX_GlyphBitmap> CFX_GlyphCache::RenderGlyph(
     uint32_t glyph_index,
@@ -125,19 +143,23 @@ const CFX_Path* CFX_GlyphCache::LoadGlyphPath(const CFX_Font* font,
     return nullptr;
   }
 
+  std::lock_guard<std::mutex> lock(lock_);
   const auto* pSubstFont = font->GetSubstFont();
-  int weight = pSubstFont ? pSubstFont->GetWeight() : 0;
-  int angle = pSubstFont ? pSubstFont->GetItalicAngle() : 0;
-  bool vertical = pSubstFont && font->IsVertical();
-  const PathMapKey key =
-      std::make_tuple(glyph_index, dest_width, weight, angle, vertical);
-  auto it = path_map_.find(key);
-  if (it != path_map_.end()) {
-    return it->second.get();
+  PathKey key = {};
+  key.glyph_index = glyph_index;
+  key.dest_width = dest_width;
+  key.weight = pSubstFont ? pSubstFont->GetWeight() : 0;
+  key.italic_angle = pSubstFont ? pSubstFont->GetItalicAngle() : 0;
+  key.vertical = pSubstFont && font->IsVertical();
+  if (const std::unique_ptr<CFX_Path>* path = path_map_.Find(key)) {
+    return path->get();
   }
 
-  path_map_[key] = font->LoadGlyphPathImpl(glyph_index, dest_width);
-  return path_map_[key].get();
+  std::unique_ptr<CFX_Path>* path =
+      path_map_
+          .TryEmplace(key, font->LoadGlyphPathImpl(glyph_index, dest_width))
+          .first;
+  return path->get();
 }
 
 const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
@@ -152,13 +174,14 @@ const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
     return nullptr;
   }
 
+  std::lock_guard<std::mutex> lock(lock_);
 #if BUILDFLAG(IS_APPLE)
   const bool bNative = text_options->native_text;
 #else
   const bool bNative = false;
 #endif
-  UniqueKeyGen keygen(font, matrix, dest_width, anti_alias, bNative);
-  auto FaceGlyphsKey = ByteString(ByteStringView(keygen.span()));
+  const SizeKey size_key =
+      MakeSizeKey(font, matrix, dest_width, anti_alias, bNative);
 
 #if BUILDFLAG(IS_APPLE)
   bool bDoLookUp = !text_options->native_text;
@@ -169,8 +192,8 @@ const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
   const bool bDoLookUp = true;
 #endif  // BUILDFLAG(IS_APPLE)
   if (bDoLookUp) {
-    return LookUpGlyphBitmap(font, matrix, FaceGlyphsKey, glyph_index,
-                             is_cid_font, dest_width, anti_alias);
+    return LookUpGlyphBitmap(font, matrix, size_key, glyph_index, is_cid_font,
+                             dest_width, anti_alias);
   }
 
 #if BUILDFLAG(IS_APPLE)
@@ -178,20 +201,21 @@ const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
   DCHECK(!CFX_GEModule::Get()->UseSkiaRenderer());
 #endif  // defined(PDF_USE_SKIA)
 
-  auto it = size_map_.find(FaceGlyphsKey);
-  if (it != size_map_.end()) {
-    SizeToGlyphMap& size_glyph_cache = it->second;
-    auto size_glyph_it = size_glyph_cache.find(glyph_index);
-    if (size_glyph_it != size_glyph_cache.end()) {
-      return size_glyph_it->second.get();
+  SizeGlyphs* size_glyphs = size_map_.Find(size_key);
+  if (size_glyphs) {
+    std::unique_ptr<CFX_GlyphBitmap>* glyph =
+        size_glyphs->glyphs.Find(glyph_index);
+    if (glyph) {
+      CFX_CacheBudget::Get()->RecordHit(CFX_CacheBudget::CacheType::kGlyph);
+      size_glyphs->charge.Touch();
+      return glyph->get();
     }
   }
-  UniqueKeyGen keygen2(font, matrix, dest_width, anti_alias,
-                       /*bNative=*/false);
-  auto FaceGlyphsKey2 = ByteString(ByteStringView(keygen2.span()));
+  const SizeKey size_key2 =
+      MakeSizeKey(font, matrix, dest_width, anti_alias, /*native=*/false);
   text_options->native_text = false;
-  return LookUpGlyphBitmap(font, matrix, FaceGlyphsKey2, glyph_index,
-                           is_cid_font, dest_width, anti_alias);
+  return LookUpGlyphBitmap(font, matrix, size_key2, glyph_index, is_cid_font,
+                           dest_width, anti_alias);
 #endif  // BUILDFLAG(IS_APPLE)
 }
 
@@ -199,42 +223,67 @@ int CFX_GlyphCache::GetGlyphWidth(const CFX_Font* font,
                                   uint32_t glyph_index,
                                   int dest_width,
                                   int weight) {
-  const WidthMapKey key = std::make_tuple(glyph_index, dest_width, weight);
-  auto it = width_map_.find(key);
-  if (it != width_map_.end()) {
-    return it->second;
+  std::lock_guard<std::mutex> lock(lock_);
+  const WidthKey key = {glyph_index, dest_width, weight};
+  if (const int* width = width_map_.Find(key)) {
+    return *width;
   }
 
-  width_map_[key] = font->GetGlyphWidthImpl(glyph_index, dest_width, weight);
-  return width_map_[key];
+  const int width = font->GetGlyphWidthImpl(glyph_index, dest_width, weight);
+  width_map_.TryEmplace(key, width);
+  return width;
 }
 
 CFX_GlyphBitmap* CFX_GlyphCache::LookUpGlyphBitmap(
     const CFX_Font* font,
     const CFX_Matrix& matrix,
-    const ByteString& FaceGlyphsKey,
+    const SizeKey& size_key,
     uint32_t glyph_index,
     bool is_cid_font,
     int dest_width,
     FontAntiAliasingMode anti_alias) {
-  SizeToGlyphMap* pSizeCache;
-  auto it = size_map_.find(FaceGlyphsKey);
-  if (it == size_map_.end()) {
-    size_map_[FaceGlyphsKey] = SizeToGlyphMap();
-    pSizeCache = &(size_map_[FaceGlyphsKey]);
-  } else {
-    pSizeCache = &(it->second);
+  CFX_CacheBudget* budget = CFX_CacheBudget::Get();
+  SizeGlyphs* size_glyphs = size_map_.Find(size_key);
+  if (!size_glyphs) {
+    size_glyphs =
+        size_map_
+            .TryEmplace(size_key, budget->CreateCharge(
+                                      CFX_CacheBudget::CacheType::kGlyph, this))
+            .first;
   }
 
-  auto it2 = pSizeCache->find(glyph_index);
-  if (it2 != pSizeCache->end()) {
-    return it2->second.get();
+  std::unique_ptr<CFX_GlyphBitmap>* glyph =
+      size_glyphs->glyphs.Find(glyph_index);
+  if (glyph) {
+    budget->RecordHit(CFX_CacheBudget::CacheType::kGlyph);
+    size_glyphs->charge.Touch();
+    return glyph->get();
   }
 
+  budget->RecordMiss(CFX_CacheBudget::CacheType::kGlyph);
   std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap =
       RenderGlyph(glyph_index, is_cid_font, font->IsVertical(), matrix,
                   dest_width, anti_alias, font->GetSubstFont());
   CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-  (*pSizeCache)[glyph_index] = std::move(pGlyphBitmap);
+  size_glyphs->glyphs.TryEmplace(glyph_index, std::move(pGlyphBitmap));
+  size_glyphs->charge.SetSize(size_glyphs->charge.size() +
+                              EstimateGlyphSize(pResult));
   return pResult;
 }
+
+void CFX_GlyphCache::ReleaseFlaggedEntries() {
+  std::lock_guard<std::mutex> lock(lock_);
+  // Another thread may have pinned the cache since, and already be holding
+  // glyphs. The request then stays pending until that pin goes away.
+  if (IsPinned() || !TakeEvictionRequest()) {
+    return;
+  }
+
+  size_t evicted =
+      size_map_.EraseIf([](const SizeKey&, const SizeGlyphs& size_glyphs) {
+        return size_glyphs.charge.IsEvictionRequested();
+      });
+  for (; evicted; --evicted) {
+    CFX_CacheBudget::Get()->RecordEviction(CFX_CacheBudget::CacheType::kGlyph);
+  }
+}
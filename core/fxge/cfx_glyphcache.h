@@ -7,11 +7,14 @@
 #ifndef CORE_FXGE_CFX_GLYPHCACHE_H_
 #define CORE_FXGE_CFX_GLYPHCACHE_H_
 
-#include <map>
+#include <stddef.h>
+#include <stdint.h>
+
 #include <memory>
-#include <tuple>
+#include <mutex>
 
-#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/cfx_cachebudget.h"
+#include "core/fxcrt/flat_hash_map.h"
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/span.h"
@@ -24,10 +27,14 @@ class CFX_Matrix;
 class CFX_Path;
 struct CFX_TextRenderOptions;
 
-class CFX_GlyphCache final : public Retainable, public Observable {
+class CFX_GlyphCache final : public Retainable,
+                             public Observable,
+                             public CFX_CacheBudget::Client {
  public:
   CONSTRUCT_VIA_MAKE_RETAIN;
 
+  // The result stays valid while the caller holds a CFX_CacheBudget::ScopedPin
+  // for this cache.
   const CFX_GlyphBitmap* LoadGlyphBitmap(const CFX_Font* font,
                                          uint32_t glyph_index,
                                          bool is_cid_font,
@@ -47,11 +54,67 @@ class CFX_GlyphCache final : public Retainable, public Observable {
   explicit CFX_GlyphCache(RetainPtr<CFX_Face> face);
   ~CFX_GlyphCache() override;
 
-  using SizeToGlyphMap = std::map<uint32_t, std::unique_ptr<CFX_GlyphBitmap>>;
-  // <glyph_index, width, weight, angle, vertical>
-  using PathMapKey = std::tuple<uint32_t, int, int, int, bool>;
-  // <glyph_index, dest_width, weight>
-  using WidthMapKey = std::tuple<uint32_t, int, int>;
+  // Identifies glyphs rendered with the same matrix and options. The matrix
+  // is stored in fixed point, scaled by 10000.
+  struct SizeKey {
+    struct Hash {
+      size_t operator()(const SizeKey& key) const;
+    };
+
+    bool operator==(const SizeKey&) const = default;
+
+    int32_t matrix[4];
+    int32_t dest_width;
+    int32_t weight;
+    int32_t italic_angle;
+    uint8_t anti_alias;
+    bool has_subst_font;
+    bool vertical;
+    bool native;
+  };
+  struct PathKey {
+    struct Hash {
+      size_t operator()(const PathKey& key) const;
+    };
+
+    bool operator==(const PathKey&) const = default;
+
+    uint32_t glyph_index;
+    int32_t dest_width;
+    int32_t weight;
+    int32_t italic_angle;
+    bool vertical;
+  };
+  struct WidthKey {
+    struct Hash {
+      size_t operator()(const WidthKey& key) const;
+    };
+
+    bool operator==(const WidthKey&) const = default;
+
+    uint32_t glyph_index;
+    int32_t dest_width;
+    int32_t weight;
+  };
+
+  using SizeToGlyphMap =
+      FlatHashMap<uint32_t, std::unique_ptr<CFX_GlyphBitmap>>;
+  // Glyphs rendered with the same matrix and options. These are evicted
+  // together.
+  struct SizeGlyphs {
+    explicit SizeGlyphs(CFX_CacheBudget::Charge charge);
+    SizeGlyphs(SizeGlyphs&& that) noexcept;
+    ~SizeGlyphs();
+
+    SizeToGlyphMap glyphs;
+    CFX_CacheBudget::Charge charge;
+  };
+
+  static SizeKey MakeSizeKey(const CFX_Font* font,
+                             const CFX_Matrix& matrix,
+                             int dest_width,
+                             FontAntiAliasingMode anti_alias,
+                             bool native);
 
   std::unique_ptr<CFX_GlyphBitmap> RenderGlyph(uint32_t glyph_index,
                                                bool is_cid_font,
@@ -62,16 +125,25 @@ class CFX_GlyphCache final : public Retainable, public Observable {
                                                const CFX_SubstFont* subst_font);
   CFX_GlyphBitmap* LookUpGlyphBitmap(const CFX_Font* font,
                                      const CFX_Matrix& matrix,
-                                     const ByteString& FaceGlyphsKey,
+                                     const SizeKey& size_key,
                                      uint32_t glyph_index,
                                      bool is_cid_font,
                                      int dest_width,
                                      FontAntiAliasingMode anti_alias);
 
+  // CFX_CacheBudget::Client:
+  void ReleaseFlaggedEntries() override;
+
   RetainPtr<CFX_Face> const face_;
-  std::map<ByteString, SizeToGlyphMap> size_map_;
-  std::map<PathMapKey, std::unique_ptr<CFX_Path>> path_map_;
-  std::map<WidthMapKey, int> width_map_;
+
+  // Glyph caches of shared faces are shared by all documents, so the maps
+  // below are guarded. Glyph bitmaps are only evicted while the cache is not
+  // pinned, and other entries are never removed, so pointers handed out remain
+  // valid after the lock is released.
+  std::mutex lock_;
+  FlatHashMap<SizeKey, SizeGlyphs, SizeKey::Hash> size_map_;
+  FlatHashMap<PathKey, std::unique_ptr<CFX_Path>, PathKey::Hash> path_map_;
+  FlatHashMap<WidthKey, int, WidthKey::Hash> width_map_;
 };
 
 #endif  //  CORE_FXGE_CFX_GLYPHCACHE_H_
@@ -14,6 +14,7 @@
 #include <utility>
 
 #include "build/build_config.h"
+#include "core/fxcrt/cfx_cachebudget.h"
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/check_op.h"
 #include "core/fxcrt/compiler_specific.h"
@@ -1248,6 +1249,9 @@ bool CFX_RenderDevice::DrawNormalText(pdfium::span<const TextCharPos> pCharPos,
                           nullptr, fill_color, 0, nullptr, path_options);
     }
   }
+  // Must come before `glyphs`, which points into the glyph cache.
+  RetainPtr<CFX_GlyphCache> glyph_cache = font->GetOrCreateGlyphCache();
+  CFX_CacheBudget::ScopedPin glyph_cache_pin(glyph_cache.Get());
   std::vector<TextGlyphPos> glyphs(pCharPos.size());
   const bool anti_alias_is_lcd = anti_alias == FontAntiAliasingMode::kLcd;
   for (auto [charpos, glyph] : fxcrt::Zip(pCharPos, pdfium::span(glyphs))) {
@@ -19,8 +19,15 @@
 #include "core/fxge/dib/blend.h"
 #include "core/fxge/dib/fx_dib.h"
 
-#if defined(PDF_USE_SKIA)
+#if defined(PDF_USE_HIGHWAY) || defined(PDF_USE_SKIA)
 #include <type_traits>
+#endif
+
+#if defined(PDF_USE_HIGHWAY)
+#include "core/fxge/dib/cfx_scanlinecompositor_simd.h"
+#endif
+
+#if defined(PDF_USE_SKIA)
 
 #include "third_party/skia/include/core/SkBlendMode.h"  // nogncheck
 #include "third_party/skia/include/core/SkCanvas.h"     // nogncheck
@@ -167,6 +174,77 @@ void AlphaMergeToSource(const T& input, U& output, uint8_t alpha) {
   output.red = AlphaMerge(input.red, output.red, alpha);
 }
 
+// The functions below composite the first pixels of a row in
+// BlendMode::kNormal with SIMD code, where available. They return how many
+// pixels they composited, and the caller composites the rest.
+
+template <typename DestPixelStruct>
+size_t CompositeRowBgra2BgrSimd(
+    pdfium::span<const FX_BGRA_STRUCT<uint8_t>> src_span,
+    pdfium::span<const uint8_t> clip_span,
+    pdfium::span<DestPixelStruct> dest_span) {
+#if defined(PDF_USE_HIGHWAY)
+  if constexpr (std::is_same_v<DestPixelStruct, FX_BGR_STRUCT<uint8_t>> ||
+                std::is_same_v<DestPixelStruct, FX_BGRA_STRUCT<uint8_t>>) {
+    return fxge::CompositeRowBgra2BgrNormalSimd(
+        pdfium::as_writable_bytes(dest_span), pdfium::as_bytes(src_span),
+        clip_span, sizeof(DestPixelStruct));
+  } else {
+    return 0;
+  }
+#else
+  return 0;
+#endif
+}
+
+template <typename DestPixelStruct>
+size_t CompositeRowBgra2BgraSimd(
+    pdfium::span<const FX_BGRA_STRUCT<uint8_t>> src_span,
+    pdfium::span<const uint8_t> clip_span,
+    pdfium::span<DestPixelStruct> dest_span) {
+#if defined(PDF_USE_HIGHWAY)
+  if constexpr (std::is_same_v<DestPixelStruct, FX_BGRA_STRUCT<uint8_t>>) {
+    return fxge::CompositeRowBgra2BgraNormalSimd(
+        pdfium::as_writable_bytes(dest_span), pdfium::as_bytes(src_span),
+        clip_span);
+  } else {
+    return 0;
+  }
+#else
+  return 0;
+#endif
+}
+
+template <typename DestPixelStruct>
+size_t CompositeRowByteMask2BgraSimd(pdfium::span<DestPixelStruct> dest_span,
+                                     pdfium::span<const uint8_t> src_span,
+                                     FX_BGRA_STRUCT<uint8_t> mask,
+                                     pdfium::span<const uint8_t> clip_span) {
+#if defined(PDF_USE_HIGHWAY)
+  if constexpr (std::is_same_v<DestPixelStruct, FX_BGRA_STRUCT<uint8_t>>) {
+    return fxge::CompositeRowByteMask2BgraNormalSimd(
+        pdfium::as_writable_bytes(dest_span), src_span, mask, clip_span);
+  } else {
+    return 0;
+  }
+#else
+  return 0;
+#endif
+}
+
+size_t CompositeRowByteMask2RgbSimd(pdfium::span<uint8_t> dest_span,
+                                    pdfium::span<const uint8_t> src_span,
+                                    FX_BGRA_STRUCT<uint8_t> mask,
+                                    int Bpp,
+                                    pdfium::span<const uint8_t> clip_span) {
+#if defined(PDF_USE_HIGHWAY)
+  return fxge::CompositeRowByteMask2BgrNormalSimd(dest_span, src_span, mask,
+                                                  clip_span, Bpp);
+#else
+  return 0;
+#endif
+}
+
 void CompositePixelBgra2Mask(const FX_BGRA_STRUCT<uint8_t>& input,
                              uint8_t clip,
                              uint8_t& output) {
@@ -481,6 +559,16 @@ void CompositeRowBgra2Bgr(pdfium::span<const FX_BGRA_STRUCT<uint8_t>> src_span,
                           pdfium::span<const uint8_t> clip_span,
                           pdfium::span<DestPixelStruct> dest_span,
                           BlendMode blend_type) {
+  if (blend_type == BlendMode::kNormal) {
+    const size_t done = CompositeRowBgra2BgrSimd(
+        src_span, clip_span, dest_span.first(src_span.size()));
+    src_span = src_span.subspan(done);
+    dest_span = dest_span.subspan(done);
+    if (!clip_span.empty()) {
+      clip_span = clip_span.subspan(done);
+    }
+  }
+
   const bool non_separable_blend = IsNonSeparableBlendMode(blend_type);
   if (clip_span.empty()) {
     if (non_separable_blend) {
@@ -587,6 +675,16 @@ void CompositeRowBgra2Bgra(pdfium::span<const FX_BGRA_STRUCT<uint8_t>> src_span,
                            pdfium::span<const uint8_t> clip_span,
                            pdfium::span<DestPixelStruct> dest_span,
                            BlendMode blend_type) {
+  if (blend_type == BlendMode::kNormal) {
+    const size_t done = CompositeRowBgra2BgraSimd(
+        src_span, clip_span, dest_span.first(src_span.size()));
+    src_span = src_span.subspan(done);
+    dest_span = dest_span.subspan(done);
+    if (!clip_span.empty()) {
+      clip_span = clip_span.subspan(done);
+    }
+  }
+
   const bool non_separable_blend = IsNonSeparableBlendMode(blend_type);
   if (clip_span.empty()) {
     if (non_separable_blend) {
@@ -1104,6 +1202,18 @@ void CompositeRow_ByteMask2Bgra(pdfium::span<DestPixelStruct> dest_span,
                                 int pixel_count,
                                 BlendMode blend_type,
                                 pdfium::span<const uint8_t> clip_span) {
+  if (blend_type == BlendMode::kNormal) {
+    const size_t done = CompositeRowByteMask2BgraSimd(
+        dest_span.first(static_cast<size_t>(pixel_count)),
+        src_span.first(static_cast<size_t>(pixel_count)), mask, clip_span);
+    dest_span = dest_span.subspan(done);
+    src_span = src_span.subspan(done);
+    if (!clip_span.empty()) {
+      clip_span = clip_span.subspan(done);
+    }
+    pixel_count -= static_cast<int>(done);
+  }
+
   for (int col = 0; col < pixel_count; col++) {
     const int src_alpha = GetAlphaWithSrc(mask.alpha, clip_span, src_span, col);
     auto& dest = dest_span[col];
@@ -1142,6 +1252,19 @@ void CompositeRow_ByteMask2Rgb(pdfium::span<uint8_t> dest_span,
                                BlendMode blend_type,
                                int Bpp,
                                pdfium::span<const uint8_t> clip_span) {
+  if (blend_type == BlendMode::kNormal) {
+    const size_t done = CompositeRowByteMask2RgbSimd(
+        dest_span.first(static_cast<size_t>(pixel_count * Bpp)),
+        src_span.first(static_cast<size_t>(pixel_count)), mask, Bpp,
+        clip_span);
+    dest_span = dest_span.subspan(done * Bpp);
+    src_span = src_span.subspan(done);
+    if (!clip_span.empty()) {
+      clip_span = clip_span.subspan(done);
+    }
+    pixel_count -= static_cast<int>(done);
+  }
+
   uint8_t* dest_scan = dest_span.data();
   UNSAFE_TODO({
     for (int col = 0; col < pixel_count; col++) {
@@ -0,0 +1,369 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/cfx_scanlinecompositor_simd.h"
+
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/check_op.h"
+#include "core/fxcrt/compiler_specific.h"
+
+// foreach_target.h includes this file again for each SIMD target that Highway
+// compiles for, each time with a different HWY_NAMESPACE.
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "core/fxge/dib/cfx_scanlinecompositor_simd.cpp"
+#include "hwy/foreach_target.h"
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace fxge {
+namespace HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+using D8 = hn::ScalableTag<uint8_t>;
+using D16 = hn::Repartition<uint16_t, D8>;
+using D32 = hn::Repartition<int32_t, D8>;
+using DF = hn::Repartition<float, D8>;
+using V8 = hn::Vec<D8>;
+using V16 = hn::Vec<D16>;
+using V32 = hn::Vec<D32>;
+
+// Returns `x / 255` for `x` <= 65279.
+HWY_INLINE V16 Div255(V16 x) {
+  return hn::ShiftRight<8>(
+      hn::Add(hn::Add(x, hn::Set(D16(), 1)), hn::ShiftRight<8>(x)));
+}
+
+// Returns `num / den` for 0 <= `num` < 2^24 and `den` > 0. Truncating the
+// float quotient is exact for such values where division is correctly
+// rounded, but some targets approximate it, so correct it by one if needed.
+HWY_INLINE V32 DivideExact(V32 num, V32 den) {
+  const D32 d32;
+  const V32 one = hn::Set(d32, 1);
+  V32 quotient = hn::ConvertTo(
+      d32, hn::Div(hn::ConvertTo(DF(), num), hn::ConvertTo(DF(), den)));
+  quotient = hn::IfThenElse(hn::Gt(hn::Mul(quotient, den), num),
+                            hn::Sub(quotient, one), quotient);
+  quotient = hn::IfThenElse(hn::Le(hn::Mul(hn::Add(quotient, one), den), num),
+                            hn::Add(quotient, one), quotient);
+  return quotient;
+}
+
+// Returns `a * b / 255`.
+HWY_INLINE V8 MulDiv255(V8 a, V8 b) {
+  const D16 d16;
+  const V16 lo = Div255(
+      hn::Mul(hn::PromoteLowerTo(d16, a), hn::PromoteLowerTo(d16, b)));
+  const V16 hi = Div255(
+      hn::Mul(hn::PromoteUpperTo(d16, a), hn::PromoteUpperTo(d16, b)));
+  return hn::OrderedDemote2To(D8(), lo, hi);
+}
+
+// Same as AlphaMerge() in fx_dib.h, for 8-bit values in 16-bit lanes.
+HWY_INLINE V16 AlphaMerge16(V16 back, V16 src, V16 alpha) {
+  const V16 inverse = hn::Sub(hn::Set(D16(), 255), alpha);
+  return Div255(hn::Add(hn::Mul(back, inverse), hn::Mul(src, alpha)));
+}
+
+// Same as AlphaMerge() in fx_dib.h.
+HWY_INLINE V8 AlphaMerge8(V8 back, V8 src, V8 alpha) {
+  const D16 d16;
+  const V16 lo =
+      AlphaMerge16(hn::PromoteLowerTo(d16, back), hn::PromoteLowerTo(d16, src),
+                   hn::PromoteLowerTo(d16, alpha));
+  const V16 hi =
+      AlphaMerge16(hn::PromoteUpperTo(d16, back), hn::PromoteUpperTo(d16, src),
+                   hn::PromoteUpperTo(d16, alpha));
+  return hn::OrderedDemote2To(D8(), lo, hi);
+}
+
+// Returns `src_alpha * 255 / dest_alpha`, where `dest_alpha` is at least
+// `src_alpha`. Returns 0 where both are 0.
+HWY_INLINE V16 AlphaRatio16(V16 src_alpha, V16 dest_alpha) {
+  const D16 d16;
+  const D32 d32;
+  const V16 num = hn::Mul(src_alpha, hn::Set(d16, 255));
+  const V16 den = hn::Max(dest_alpha, hn::Set(d16, 1));
+  const V32 lo = DivideExact(hn::PromoteLowerTo(d32, num),
+                             hn::PromoteLowerTo(d32, den));
+  const V32 hi = DivideExact(hn::PromoteUpperTo(d32, num),
+                             hn::PromoteUpperTo(d32, den));
+  return hn::OrderedDemote2To(d16, lo, hi);
+}
+
+HWY_INLINE V8 AlphaRatio8(V8 src_alpha, V8 dest_alpha) {
+  const D16 d16;
+  const V16 lo = AlphaRatio16(hn::PromoteLowerTo(d16, src_alpha),
+                              hn::PromoteLowerTo(d16, dest_alpha));
+  const V16 hi = AlphaRatio16(hn::PromoteUpperTo(d16, src_alpha),
+                              hn::PromoteUpperTo(d16, dest_alpha));
+  return hn::OrderedDemote2To(D8(), lo, hi);
+}
+
+// Returns `alpha * clip / 255 / 255`, rounded down once, as
+// GetAlphaWithSrc() in cfx_scanlinecompositor.cpp does. `alpha` is the
+// product of two 8-bit values.
+HWY_INLINE V16 ClipMaskAlpha16(V16 alpha, V16 clip) {
+  const D32 d32;
+  const V32 den = hn::Set(d32, 255 * 255);
+  const V32 lo = DivideExact(
+      hn::Mul(hn::PromoteLowerTo(d32, alpha), hn::PromoteLowerTo(d32, clip)),
+      den);
+  const V32 hi = DivideExact(
+      hn::Mul(hn::PromoteUpperTo(d32, alpha), hn::PromoteUpperTo(d32, clip)),
+      den);
+  return hn::OrderedDemote2To(D16(), lo, hi);
+}
+
+// Returns the alpha of `mask_alpha` through the mask values in `src`, scaled
+// by the values at `clip` if it is not null.
+HWY_INLINE V8 MaskAlpha(uint8_t mask_alpha, V8 src, const uint8_t* clip) {
+  const D8 d8;
+  if (!clip) {
+    return MulDiv255(hn::Set(d8, mask_alpha), src);
+  }
+  const D16 d16;
+  const V8 clip_values = hn::LoadU(d8, clip);
+  const V16 mask_alpha16 = hn::Set(d16, mask_alpha);
+  const V16 lo =
+      ClipMaskAlpha16(hn::Mul(mask_alpha16, hn::PromoteLowerTo(d16, src)),
+                      hn::PromoteLowerTo(d16, clip_values));
+  const V16 hi =
+      ClipMaskAlpha16(hn::Mul(mask_alpha16, hn::PromoteUpperTo(d16, src)),
+                      hn::PromoteUpperTo(d16, clip_values));
+  return hn::OrderedDemote2To(d8, lo, hi);
+}
+
+// Merges a vector of pixels with colors `b`, `g` and `r` into the pixels at
+// `dest` with `alpha`. If `dest_bpp` is 4, the last byte of each pixel stays
+// the same.
+HWY_INLINE void MergeIntoBgr(V8 b,
+                             V8 g,
+                             V8 r,
+                             V8 alpha,
+                             uint8_t* dest,
+                             int dest_bpp) {
+  const D8 d8;
+  V8 dest_b;
+  V8 dest_g;
+  V8 dest_r;
+  if (dest_bpp == 3) {
+    hn::LoadInterleaved3(d8, dest, dest_b, dest_g, dest_r);
+    hn::StoreInterleaved3(AlphaMerge8(dest_b, b, alpha),
+                          AlphaMerge8(dest_g, g, alpha),
+                          AlphaMerge8(dest_r, r, alpha), d8, dest);
+    return;
+  }
+  V8 dest_x;
+  hn::LoadInterleaved4(d8, dest, dest_b, dest_g, dest_r, dest_x);
+  hn::StoreInterleaved4(AlphaMerge8(dest_b, b, alpha),
+                        AlphaMerge8(dest_g, g, alpha),
+                        AlphaMerge8(dest_r, r, alpha), dest_x, d8, dest);
+}
+
+// Composites a vector of pixels with colors `b`, `g` and `r` and alpha
+// `src_alpha` onto the BGRA pixels at `dest`. Where the destination alpha is
+// 0, the source pixel replaces the destination pixel.
+HWY_INLINE void CompositeOntoBgra(V8 b,
+                                  V8 g,
+                                  V8 r,
+                                  V8 src_alpha,
+                                  uint8_t* dest) {
+  const D8 d8;
+  V8 dest_b;
+  V8 dest_g;
+  V8 dest_r;
+  V8 dest_a;
+  hn::LoadInterleaved4(d8, dest, dest_b, dest_g, dest_r, dest_a);
+  const hn::Mask<D8> back_is_empty = hn::Eq(dest_a, hn::Zero(d8));
+  // Same as AlphaUnion(). The sum may wrap around, but the result does not.
+  const V8 alpha =
+      hn::Sub(hn::Add(dest_a, src_alpha), MulDiv255(dest_a, src_alpha));
+  const V8 ratio = AlphaRatio8(src_alpha, alpha);
+  hn::StoreInterleaved4(
+      hn::IfThenElse(back_is_empty, b, AlphaMerge8(dest_b, b, ratio)),
+      hn::IfThenElse(back_is_empty, g, AlphaMerge8(dest_g, g, ratio)),
+      hn::IfThenElse(back_is_empty, r, AlphaMerge8(dest_r, r, ratio)),
+      hn::IfThenElse(back_is_empty, src_alpha, alpha), d8, dest);
+}
+
+// In the kernels below, the callers in the HWY_ONCE section check that `src`,
+// `dest` and `clip` (if not null) hold `pixel_count` pixels.
+
+size_t CompositeRowBgra2BgrNormal(uint8_t* dest,
+                                  const uint8_t* src,
+                                  const uint8_t* clip,
+                                  size_t pixel_count,
+                                  int dest_bpp) {
+  const D8 d8;
+  const size_t lanes = hn::Lanes(d8);
+  size_t col = 0;
+  for (; col + lanes <= pixel_count; col += lanes) {
+    V8 b;
+    V8 g;
+    V8 r;
+    V8 a;
+    // SAFETY: `col + lanes` is at most `pixel_count`.
+    UNSAFE_BUFFERS({
+      hn::LoadInterleaved4(d8, src + col * 4, b, g, r, a);
+      if (clip) {
+        a = MulDiv255(a, hn::LoadU(d8, clip + col));
+      }
+      MergeIntoBgr(b, g, r, a, dest + col * dest_bpp, dest_bpp);
+    });
+  }
+  return col;
+}
+
+size_t CompositeRowBgra2BgraNormal(uint8_t* dest,
+                                   const uint8_t* src,
+                                   const uint8_t* clip,
+                                   size_t pixel_count) {
+  const D8 d8;
+  const size_t lanes = hn::Lanes(d8);
+  size_t col = 0;
+  for (; col + lanes <= pixel_count; col += lanes) {
+    V8 b;
+    V8 g;
+    V8 r;
+    V8 a;
+    // SAFETY: `col + lanes` is at most `pixel_count`.
+    UNSAFE_BUFFERS({
+      hn::LoadInterleaved4(d8, src + col * 4, b, g, r, a);
+      if (clip) {
+        a = MulDiv255(a, hn::LoadU(d8, clip + col));
+      }
+      CompositeOntoBgra(b, g, r, a, dest + col * 4);
+    });
+  }
+  return col;
+}
+
+size_t CompositeRowByteMask2BgrNormal(uint8_t* dest,
+                                      const uint8_t* src,
+                                      FX_BGRA_STRUCT<uint8_t> color,
+                                      const uint8_t* clip,
+                                      size_t pixel_count,
+                                      int dest_bpp) {
+  const D8 d8;
+  const size_t lanes = hn::Lanes(d8);
+  const V8 b = hn::Set(d8, color.blue);
+  const V8 g = hn::Set(d8, color.green);
+  const V8 r = hn::Set(d8, color.red);
+  size_t col = 0;
+  for (; col + lanes <= pixel_count; col += lanes) {
+    // SAFETY: `col + lanes` is at most `pixel_count`.
+    UNSAFE_BUFFERS({
+      const V8 alpha = MaskAlpha(color.alpha, hn::LoadU(d8, src + col),
+                                 clip ? clip + col : nullptr);
+      MergeIntoBgr(b, g, r, alpha, dest + col * dest_bpp, dest_bpp);
+    });
+  }
+  return col;
+}
+
+size_t CompositeRowByteMask2BgraNormal(uint8_t* dest,
+                                       const uint8_t* src,
+                                       FX_BGRA_STRUCT<uint8_t> color,
+                                       const uint8_t* clip,
+                                       size_t pixel_count) {
+  const D8 d8;
+  const size_t lanes = hn::Lanes(d8);
+  const V8 b = hn::Set(d8, color.blue);
+  const V8 g = hn::Set(d8, color.green);
+  const V8 r = hn::Set(d8, color.red);
+  size_t col = 0;
+  for (; col + lanes <= pixel_count; col += lanes) {
+    // SAFETY: `col + lanes` is at most `pixel_count`.
+    UNSAFE_BUFFERS({
+      const V8 alpha = MaskAlpha(color.alpha, hn::LoadU(d8, src + col),
+                                 clip ? clip + col : nullptr);
+      CompositeOntoBgra(b, g, r, alpha, dest + col * 4);
+    });
+  }
+  return col;
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace fxge
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace fxge {
+
+HWY_EXPORT(CompositeRowBgra2BgrNormal);
+HWY_EXPORT(CompositeRowBgra2BgraNormal);
+HWY_EXPORT(CompositeRowByteMask2BgrNormal);
+HWY_EXPORT(CompositeRowByteMask2BgraNormal);
+
+namespace {
+
+// Returns the start of `clip`, or null if it is empty.
+const uint8_t* GetClipData(pdfium::span<const uint8_t> clip) {
+  return clip.empty() ? nullptr : clip.data();
+}
+
+bool IsClipUsable(pdfium::span<const uint8_t> clip, size_t pixel_count) {
+  return clip.empty() || clip.size() >= pixel_count;
+}
+
+}  // namespace
+
+size_t CompositeRowBgra2BgrNormalSimd(pdfium::span<uint8_t> dest,
+                                      pdfium::span<const uint8_t> src,
+                                      pdfium::span<const uint8_t> clip,
+                                      int dest_bpp) {
+  CHECK(dest_bpp == 3 || dest_bpp == 4);
+  const size_t pixel_count = src.size() / 4;
+  CHECK_GE(dest.size(), pixel_count * dest_bpp);
+  if (!IsClipUsable(clip, pixel_count)) {
+    return 0;
+  }
+  return HWY_DYNAMIC_DISPATCH(CompositeRowBgra2BgrNormal)(
+      dest.data(), src.data(), GetClipData(clip), pixel_count, dest_bpp);
+}
+
+size_t CompositeRowBgra2BgraNormalSimd(pdfium::span<uint8_t> dest,
+                                       pdfium::span<const uint8_t> src,
+                                       pdfium::span<const uint8_t> clip) {
+  const size_t pixel_count = src.size() / 4;
+  CHECK_GE(dest.size(), pixel_count * 4);
+  if (!IsClipUsable(clip, pixel_count)) {
+    return 0;
+  }
+  return HWY_DYNAMIC_DISPATCH(CompositeRowBgra2BgraNormal)(
+      dest.data(), src.data(), GetClipData(clip), pixel_count);
+}
+
+size_t CompositeRowByteMask2BgrNormalSimd(pdfium::span<uint8_t> dest,
+                                          pdfium::span<const uint8_t> src,
+                                          FX_BGRA_STRUCT<uint8_t> color,
+                                          pdfium::span<const uint8_t> clip,
+                                          int dest_bpp) {
+  CHECK(dest_bpp == 3 || dest_bpp == 4);
+  const size_t pixel_count = src.size();
+  CHECK_GE(dest.size(), pixel_count * dest_bpp);
+  if (!IsClipUsable(clip, pixel_count)) {
+    return 0;
+  }
+  return HWY_DYNAMIC_DISPATCH(CompositeRowByteMask2BgrNormal)(
+      dest.data(), src.data(), color, GetClipData(clip), pixel_count,
+      dest_bpp);
+}
+
+size_t CompositeRowByteMask2BgraNormalSimd(pdfium::span<uint8_t> dest,
+                                           pdfium::span<const uint8_t> src,
+                                           FX_BGRA_STRUCT<uint8_t> color,
+                                           pdfium::span<const uint8_t> clip) {
+  const size_t pixel_count = src.size();
+  CHECK_GE(dest.size(), pixel_count * 4);
+  if (!IsClipUsable(clip, pixel_count)) {
+    return 0;
+  }
+  return HWY_DYNAMIC_DISPATCH(CompositeRowByteMask2BgraNormal)(
+      dest.data(), src.data(), color, GetClipData(clip), pixel_count);
+}
+
+}  // namespace fxge
+#endif  // HWY_ONCE
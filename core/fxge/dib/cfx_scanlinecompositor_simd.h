@@ -0,0 +1,55 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_DIB_CFX_SCANLINECOMPOSITOR_SIMD_H_
+#define CORE_FXGE_DIB_CFX_SCANLINECOMPOSITOR_SIMD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/fxcrt/span.h"
+#include "core/fxge/dib/fx_dib.h"
+
+namespace fxge {
+
+// Vectorized versions of the CFX_ScanlineCompositor row functions for
+// BlendMode::kNormal into destinations with BGR byte order. They run with the
+// widest instruction set the CPU supports, and give the same results as the
+// scalar code, bit for bit.
+//
+// Each function composites the first pixels of the row and returns how many
+// it composited. That is a multiple of the vector width, so the caller has to
+// composite the remaining pixels. `clip` is either empty or holds one value
+// per pixel. Otherwise, nothing is composited.
+
+// Composites BGRA pixels from `src` onto `dest`, which has `dest_bpp` bytes
+// per pixel. With 4 bytes per pixel, the last byte is left unchanged.
+size_t CompositeRowBgra2BgrNormalSimd(pdfium::span<uint8_t> dest,
+                                      pdfium::span<const uint8_t> src,
+                                      pdfium::span<const uint8_t> clip,
+                                      int dest_bpp);
+
+// Composites BGRA pixels from `src` onto BGRA pixels in `dest`.
+size_t CompositeRowBgra2BgraNormalSimd(pdfium::span<uint8_t> dest,
+                                       pdfium::span<const uint8_t> src,
+                                       pdfium::span<const uint8_t> clip);
+
+// Composites `color` through the 8-bit mask `src` onto `dest`, which has
+// `dest_bpp` bytes per pixel. With 4 bytes per pixel, the last byte is left
+// unchanged.
+size_t CompositeRowByteMask2BgrNormalSimd(pdfium::span<uint8_t> dest,
+                                          pdfium::span<const uint8_t> src,
+                                          FX_BGRA_STRUCT<uint8_t> color,
+                                          pdfium::span<const uint8_t> clip,
+                                          int dest_bpp);
+
+// Composites `color` through the 8-bit mask `src` onto BGRA pixels in `dest`.
+size_t CompositeRowByteMask2BgraNormalSimd(pdfium::span<uint8_t> dest,
+                                           pdfium::span<const uint8_t> src,
+                                           FX_BGRA_STRUCT<uint8_t> color,
+                                           pdfium::span<const uint8_t> clip);
+
+}  // namespace fxge
+
+#endif  // CORE_FXGE_DIB_CFX_SCANLINECOMPOSITOR_SIMD_H_
@@ -0,0 +1,212 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/cfx_scanlinecompositor_simd.h"
+
+#include <stdint.h>
+
+#include <optional>
+#include <vector>
+
+#include "core/fxcrt/span.h"
+#include "core/fxge/dib/cfx_scanlinecompositor.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "hwy/targets.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// These tests check that CFX_ScanlineCompositor gives the same results when
+// compositing whole rows, which uses the SIMD code for most of each row, as
+// when compositing one pixel at a time, which always uses the scalar code.
+
+namespace {
+
+// Pixel `i` gets source alpha `i % 256` and destination alpha `i / 256 % 256`,
+// so all combinations are covered. The extra pixels are not a multiple of any
+// vector width, so the scalar code composites the end of the row.
+constexpr size_t kWidth = 256 * 256 + 37;
+
+// Runs `test` once for each SIMD target that this CPU supports.
+template <typename Test>
+void ForEachTarget(const Test& test) {
+  for (int64_t target : hwy::SupportedAndGeneratedTargets()) {
+    SCOPED_TRACE(hwy::TargetName(target));
+    hwy::SetSupportedTargetsForTest(target);
+    test();
+  }
+  hwy::SetSupportedTargetsForTest(0);
+}
+
+// Deterministic xorshift generator, so failures are reproducible.
+class RandomBytes {
+ public:
+  uint8_t Next() {
+    state_ ^= state_ << 13;
+    state_ ^= state_ >> 17;
+    state_ ^= state_ << 5;
+    return static_cast<uint8_t>(state_ >> 24);
+  }
+
+  // Returns 0 and 255 more often than other values, as those take different
+  // paths in the scalar code.
+  uint8_t NextAlpha() {
+    const uint8_t value = Next();
+    if (value < 32) {
+      return 0;
+    }
+    if (value < 64) {
+      return 255;
+    }
+    return Next();
+  }
+
+  std::vector<uint8_t> Bytes(size_t size) {
+    std::vector<uint8_t> result(size);
+    for (uint8_t& byte : result) {
+      byte = Next();
+    }
+    return result;
+  }
+
+  std::vector<uint8_t> Clip(size_t size) {
+    std::vector<uint8_t> result(size);
+    for (uint8_t& value : result) {
+      value = NextAlpha();
+    }
+    return result;
+  }
+
+ private:
+  uint32_t state_ = 0x12345678;
+};
+
+// Returns a row of `kWidth` pixels with `bpp` bytes per pixel and random
+// colors. If `alpha_shift` is set, each pixel's last byte is the alpha
+// described for `kWidth`.
+std::vector<uint8_t> CreateRow(RandomBytes& random,
+                               size_t bpp,
+                               std::optional<int> alpha_shift) {
+  std::vector<uint8_t> row = random.Bytes(kWidth * bpp);
+  if (alpha_shift.has_value()) {
+    for (size_t i = 0; i < kWidth; ++i) {
+      row[i * bpp + bpp - 1] = static_cast<uint8_t>(i >> alpha_shift.value());
+    }
+  }
+  return row;
+}
+
+// BGRA destinations get the destination alpha described for `kWidth`.
+std::optional<int> GetDestAlphaShift(FXDIB_Format dest_format) {
+  if (dest_format == FXDIB_Format::kBgra) {
+    return 8;
+  }
+  return std::nullopt;
+}
+
+void CheckRgbBitmapLine(FXDIB_Format dest_format, bool clip) {
+  CFX_ScanlineCompositor compositor;
+  ASSERT_TRUE(compositor.Init(dest_format, FXDIB_Format::kBgra,
+                              /*src_palette=*/{}, /*mask_color=*/0,
+                              BlendMode::kNormal, /*bRgbByteOrder=*/false));
+  const size_t bpp = GetCompsFromFormat(dest_format);
+  RandomBytes random;
+  const std::vector<uint8_t> src = CreateRow(random, 4, /*alpha_shift=*/0);
+  const std::vector<uint8_t> dest =
+      CreateRow(random, bpp, GetDestAlphaShift(dest_format));
+  const std::vector<uint8_t> clip_scan =
+      clip ? random.Clip(kWidth) : std::vector<uint8_t>();
+
+  ForEachTarget([&] {
+    std::vector<uint8_t> expected = dest;
+    pdfium::span<uint8_t> expected_span(expected);
+    pdfium::span<const uint8_t> src_span(src);
+    pdfium::span<const uint8_t> clip_span(clip_scan);
+    for (size_t i = 0; i < kWidth; ++i) {
+      compositor.CompositeRgbBitmapLine(
+          expected_span.subspan(i * bpp), src_span.subspan(i * 4), 1,
+          clip ? clip_span.subspan(i) : pdfium::span<const uint8_t>());
+    }
+
+    std::vector<uint8_t> actual = dest;
+    compositor.CompositeRgbBitmapLine(actual, src, static_cast<int>(kWidth),
+                                      clip_scan);
+    EXPECT_EQ(expected, actual);
+  });
+}
+
+void CheckByteMaskLine(FXDIB_Format dest_format, bool clip) {
+  for (uint32_t mask_color : {0xff3080f0u, 0x80ff0010u, 0x01020304u}) {
+    SCOPED_TRACE(mask_color);
+    CFX_ScanlineCompositor compositor;
+    ASSERT_TRUE(compositor.Init(dest_format, FXDIB_Format::k8bppMask,
+                                /*src_palette=*/{}, mask_color,
+                                BlendMode::kNormal, /*bRgbByteOrder=*/false));
+    const size_t bpp = GetCompsFromFormat(dest_format);
+    RandomBytes random;
+    std::vector<uint8_t> src(kWidth);
+    for (size_t i = 0; i < kWidth; ++i) {
+      src[i] = static_cast<uint8_t>(i);
+    }
+    const std::vector<uint8_t> dest =
+        CreateRow(random, bpp, GetDestAlphaShift(dest_format));
+    const std::vector<uint8_t> clip_scan =
+        clip ? random.Clip(kWidth) : std::vector<uint8_t>();
+
+    ForEachTarget([&] {
+      std::vector<uint8_t> expected = dest;
+      pdfium::span<uint8_t> expected_span(expected);
+      pdfium::span<const uint8_t> src_span(src);
+      pdfium::span<const uint8_t> clip_span(clip_scan);
+      for (size_t i = 0; i < kWidth; ++i) {
+        compositor.CompositeByteMaskLine(
+            expected_span.subspan(i * bpp), src_span.subspan(i), 1,
+            clip ? clip_span.subspan(i) : pdfium::span<const uint8_t>());
+      }
+
+      std::vector<uint8_t> actual = dest;
+      compositor.CompositeByteMaskLine(actual, src, static_cast<int>(kWidth),
+                                       clip_scan);
+      EXPECT_EQ(expected, actual);
+    });
+  }
+}
+
+}  // namespace
+
+TEST(ScanlineCompositorSimdTest, Bgra2Bgr) {
+  CheckRgbBitmapLine(FXDIB_Format::kBgr, /*clip=*/false);
+  CheckRgbBitmapLine(FXDIB_Format::kBgr, /*clip=*/true);
+}
+
+TEST(ScanlineCompositorSimdTest, Bgra2Bgrx) {
+  CheckRgbBitmapLine(FXDIB_Format::kBgrx, /*clip=*/false);
+  CheckRgbBitmapLine(FXDIB_Format::kBgrx, /*clip=*/true);
+}
+
+TEST(ScanlineCompositorSimdTest, Bgra2Bgra) {
+  CheckRgbBitmapLine(FXDIB_Format::kBgra, /*clip=*/false);
+  CheckRgbBitmapLine(FXDIB_Format::kBgra, /*clip=*/true);
+}
+
+TEST(ScanlineCompositorSimdTest, ByteMask2Bgr) {
+  CheckByteMaskLine(FXDIB_Format::kBgr, /*clip=*/false);
+  CheckByteMaskLine(FXDIB_Format::kBgr, /*clip=*/true);
+}
+
+TEST(ScanlineCompositorSimdTest, ByteMask2Bgrx) {
+  CheckByteMaskLine(FXDIB_Format::kBgrx, /*clip=*/false);
+  CheckByteMaskLine(FXDIB_Format::kBgrx, /*clip=*/true);
+}
+
+TEST(ScanlineCompositorSimdTest, ByteMask2Bgra) {
+  CheckByteMaskLine(FXDIB_Format::kBgra, /*clip=*/false);
+  CheckByteMaskLine(FXDIB_Format::kBgra, /*clip=*/true);
+}
+
+TEST(ScanlineCompositorSimdTest, ShortRow) {
+  // Rows shorter than a vector are left to the scalar code.
+  const std::vector<uint8_t> src(4 * 3, 0x80);
+  std::vector<uint8_t> dest(4 * 3, 0x40);
+  EXPECT_EQ(0u, fxge::CompositeRowBgra2BgraNormalSimd(dest, src, {}));
+  EXPECT_EQ(std::vector<uint8_t>(4 * 3, 0x40), dest);
+}
@@ -23,6 +23,10 @@
 #include "core/fxge/dib/fx_dib.h"
 #include "core/fxge/dib/scanlinecomposer_iface.h"
 
+#if defined(PDF_USE_HIGHWAY)
+#include "core/fxge/dib/cstretchengine_simd.h"
+#endif
+
 static_assert(
     std::is_trivially_destructible<CStretchEngine::PixelWeight>::value,
     "PixelWeight storage may be re-used without invoking its destructor");
@@ -312,6 +316,9 @@ bool CStretchEngine::StartStretchHorz() {
           src_clip_.left, src_clip_.right, resample_options_)) {
     return false;
   }
+#if defined(PDF_USE_HIGHWAY)
+  InitSimdStretchHorz();
+#endif
   cur_row_ = src_clip_.top;
   state_ = State::kHorizontal;
   return true;
@@ -337,9 +344,17 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
       rows_to_go = kStrechPauseRows;
     }
 
-    const uint8_t* src_scan = source_->GetScanline(cur_row_).data();
+    pdfium::span<const uint8_t> src_row = source_->GetScanline(cur_row_);
+    const uint8_t* src_scan = src_row.data();
     pdfium::span<uint8_t> dest_span = inter_buf_.subspan(
         (cur_row_ - src_clip_.top) * inter_pitch_, inter_pitch_);
+#if defined(PDF_USE_HIGHWAY)
+    if (simd_horz_) {
+      simd_horz_->StretchRow(src_row, dest_span);
+      rows_to_go--;
+      continue;
+    }
+#endif
     size_t dest_span_index = 0;
     // TODO(npm): reduce duplicated code here
     switch (trans_method_) {
@@ -470,6 +485,12 @@ void CStretchEngine::StretchVert() {
   for (int row = dest_clip_.top; row < dest_clip_.bottom; ++row) {
     unsigned char* dest_scan = dest_scanline_.data();
     const PixelWeight* pWeights = table.GetPixelWeight(row);
+#if defined(PDF_USE_HIGHWAY)
+    if (StretchVertSimd(*pWeights)) {
+      dest_bitmap_->ComposeScanline(row - dest_clip_.top, dest_scanline_);
+      continue;
+    }
+#endif
     switch (trans_method_) {
       case TransformMethod::k1BppTo8Bpp:
       case TransformMethod::k1BppToManyBpp:
@@ -556,3 +577,87 @@ void CStretchEngine::StretchVert() {
     dest_bitmap_->ComposeScanline(row - dest_clip_.top, dest_scanline_);
   }
 }
+
+#if defined(PDF_USE_HIGHWAY)
+void CStretchEngine::InitSimdStretchHorz() {
+  simd_horz_.reset();
+  // The 1bpp and palette cases expand source pixels, and stay scalar.
+  if (trans_method_ != TransformMethod::k8BppTo8Bpp &&
+      trans_method_ != TransformMethod::kManyBpptoManyBpp &&
+      trans_method_ != TransformMethod::kManyBpptoManyBppWithAlpha) {
+    return;
+  }
+  if (src_bpp_ != dest_bpp_ || dest_clip_.IsEmpty()) {
+    return;
+  }
+
+  size_t max_taps = 1;
+  for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+    max_taps = std::max(max_taps,
+                        weight_table_.GetPixelWeight(col)->GetWeights().size());
+  }
+  std::unique_ptr<fxge::HorizontalStretcher> stretcher =
+      fxge::HorizontalStretcher::Create(
+          dest_bpp_ / 8, has_alpha_, src_clip_.left, src_clip_.right,
+          static_cast<size_t>(dest_clip_.Width()), max_taps);
+  if (!stretcher) {
+    return;
+  }
+  for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+    const PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
+    if (!stretcher->SetTaps(col - dest_clip_.left, pWeights->src_start_,
+                            pWeights->GetWeights())) {
+      return;
+    }
+  }
+  simd_horz_ = std::move(stretcher);
+}
+
+bool CStretchEngine::StretchVertSimd(const PixelWeight& weights) {
+  const int DestBpp = dest_bpp_ / 8;
+  const size_t width = dest_clip_.Width();
+  pdfium::span<const uint32_t> row_weights = weights.GetWeights();
+  pdfium::span<const uint8_t> src = inter_buf_.subspan(
+      static_cast<size_t>((weights.src_start_ - src_clip_.top) * inter_pitch_));
+  switch (trans_method_) {
+    case TransformMethod::k1BppTo8Bpp:
+    case TransformMethod::k1BppToManyBpp:
+    case TransformMethod::k8BppTo8Bpp: {
+      if (DestBpp != 1) {
+        return false;
+      }
+      fxge::StretchVertRowSimd(src, inter_pitch_, row_weights, /*bpp=*/1,
+                               /*channel_count=*/1,
+                               pdfium::span(dest_scanline_).first(width));
+      return true;
+    }
+    case TransformMethod::k8BppToManyBpp:
+    case TransformMethod::kManyBpptoManyBpp: {
+      fxge::StretchVertRowSimd(
+          src, inter_pitch_, row_weights, DestBpp, /*channel_count=*/3,
+          pdfium::span(dest_scanline_).first(width * DestBpp));
+      return true;
+    }
+    case TransformMethod::kManyBpptoManyBppWithAlpha: {
+      DCHECK(has_alpha_);
+      static constexpr size_t kPixelBytes = 4;
+      vert_sums_.resize(width * kPixelBytes);
+      fxge::StretchVertSumsSimd(src, inter_pitch_, row_weights, vert_sums_);
+      pdfium::span<uint8_t> dest_scan(dest_scanline_);
+      for (size_t i = 0; i < vert_sums_.size(); i += kPixelBytes) {
+        const uint32_t dest_a = vert_sums_[i + 3];
+        if (dest_a) {
+          int r = vert_sums_[i + 2] * 255 / dest_a;
+          int g = vert_sums_[i + 1] * 255 / dest_a;
+          int b = vert_sums_[i] * 255 / dest_a;
+          dest_scan[i] = std::clamp(b, 0, 255);
+          dest_scan[i + 1] = std::clamp(g, 0, 255);
+          dest_scan[i + 2] = std::clamp(r, 0, 255);
+        }
+        dest_scan[i + 3] = PixelFromFixed(dest_a);
+      }
+      return true;
+    }
+  }
+}
+#endif  // defined(PDF_USE_HIGHWAY)
@@ -9,6 +9,8 @@
 
 #include <stdint.h>
 
+#include <memory>
+
 #include "core/fxcrt/check_op.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fixed_size_data_vector.h"
@@ -16,6 +18,7 @@
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/raw_span.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
 #include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/dib/fx_dib.h"
 
@@ -23,6 +26,12 @@ class CFX_DIBBase;
 class PauseIndicatorIface;
 class ScanlineComposerIface;
 
+#if defined(PDF_USE_HIGHWAY)
+namespace fxge {
+class HorizontalStretcher;
+}  // namespace fxge
+#endif
+
 class CStretchEngine {
  public:
   static constexpr uint32_t kFixedPointBits = 16;
@@ -73,6 +82,16 @@ class CStretchEngine {
       UNSAFE_BUFFERS(weights_[position - src_start_] = weight);
     }
 
+    // Returns the weights of positions `src_start_` to `src_end_`.
+    pdfium::span<const uint32_t> GetWeights() const {
+      if (src_end_ < src_start_) {
+        return {};
+      }
+      // SAFETY: SetStartEnd() checks that there are this many weights.
+      return UNSAFE_BUFFERS(pdfium::span<const uint32_t>(
+          weights_, static_cast<size_t>(src_end_ - src_start_ + 1)));
+    }
+
     // NOTE: relies on defined behaviour for unsigned overflow to
     // decrement the previous position, as needed.
     void RemoveLastWeightAndAdjust(uint32_t weight_change) {
@@ -142,6 +161,15 @@ class CStretchEngine {
     kManyBpptoManyBppWithAlpha
   };
 
+#if defined(PDF_USE_HIGHWAY)
+  // Sets up `simd_horz_` if the SIMD code can do the horizontal pass.
+  void InitSimdStretchHorz();
+
+  // Resamples one destination row with the SIMD code. Returns false if the
+  // scalar code has to do it instead.
+  bool StretchVertSimd(const PixelWeight& weights);
+#endif
+
   const FXDIB_Format dest_format_;
   const int dest_bpp_;
   const int src_bpp_;
@@ -164,6 +192,10 @@ class CStretchEngine {
   State state_ = State::kInitial;
   int cur_row_ = 0;
   WeightTable weight_table_;
+#if defined(PDF_USE_HIGHWAY)
+  std::unique_ptr<fxge::HorizontalStretcher> simd_horz_;
+  DataVector<uint32_t> vert_sums_;
+#endif
 };
 
 #endif  // CORE_FXGE_DIB_CSTRETCHENGINE_H_
@@ -0,0 +1,517 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/cstretchengine_simd.h"
+
+#include <algorithm>
+
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/check_op.h"
+#include "core/fxcrt/compiler_specific.h"
+#include "core/fxcrt/fx_memcpy_wrappers.h"
+#include "core/fxcrt/ptr_util.h"
+#include "core/fxcrt/span_util.h"
+
+// foreach_target.h includes this file again for each SIMD target that Highway
+// compiles for, each time with a different HWY_NAMESPACE.
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "core/fxge/dib/cstretchengine_simd.cpp"
+#include "hwy/foreach_target.h"
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace fxge {
+namespace HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+// Full vectors of bytes, and the same bits as 16-bit and 32-bit lanes.
+using D8 = hn::ScalableTag<uint8_t>;
+using D16 = hn::Repartition<uint16_t, D8>;
+using D32 = hn::Repartition<uint32_t, D8>;
+using V8 = hn::Vec<D8>;
+using V32 = hn::Vec<D32>;
+
+// Bytes widened to 32-bit lanes.
+using D8Quarter = hn::Rebind<uint8_t, D32>;
+
+// One lane per destination pixel of a group.
+using DGroup = hn::CappedTag<uint32_t, HorizontalStretcher::kGroupSize>;
+using DGroupIndex = hn::RebindToSigned<DGroup>;
+using DGroupFloat = hn::RebindToFloat<DGroup>;
+using DGroup8 = hn::Rebind<uint8_t, DGroup>;
+using VGroup = hn::Vec<DGroup>;
+using VGroup8 = hn::Vec<DGroup8>;
+
+// Same as CStretchEngine::PixelFromFixed().
+HWY_INLINE VGroup8 PixelFromFixed(VGroup fixed) {
+  return hn::TruncateTo(DGroup8(), hn::ShiftRight<16>(fixed));
+}
+
+// Returns `x / 255` for `x` < 2^24. Truncating the float quotient is exact
+// for such values where division is correctly rounded, but some targets
+// approximate it, so correct it by one if needed.
+HWY_INLINE VGroup Div255(VGroup x) {
+  const DGroup d;
+  const DGroupIndex di;
+  const VGroup divisor = hn::Set(d, 255);
+  const VGroup one = hn::Set(d, 1);
+  VGroup quotient = hn::BitCast(
+      d, hn::ConvertTo(di, hn::Div(hn::ConvertTo(DGroupFloat(),
+                                                 hn::BitCast(di, x)),
+                                   hn::Set(DGroupFloat(), 255.0f))));
+  quotient = hn::IfThenElse(hn::Gt(hn::Mul(quotient, divisor), x),
+                            hn::Sub(quotient, one), quotient);
+  quotient =
+      hn::IfThenElse(hn::Le(hn::Mul(hn::Add(quotient, one), divisor), x),
+                     hn::Add(quotient, one), quotient);
+  return quotient;
+}
+
+// Widens the bytes of `v` to 32 bits and stores them at `dest`.
+HWY_INLINE void StoreWidened(V8 v, uint32_t* dest) {
+  const D16 d16;
+  const D32 d32;
+  const size_t lanes = hn::Lanes(d32);
+  const hn::Vec<D16> lo = hn::PromoteLowerTo(d16, v);
+  const hn::Vec<D16> hi = hn::PromoteUpperTo(d16, v);
+  // SAFETY: the caller provides room for one 32-bit value per byte of `v`.
+  UNSAFE_BUFFERS({
+    hn::StoreU(hn::PromoteLowerTo(d32, lo), d32, dest);
+    hn::StoreU(hn::PromoteUpperTo(d32, lo), d32, dest + lanes);
+    hn::StoreU(hn::PromoteLowerTo(d32, hi), d32, dest + 2 * lanes);
+    hn::StoreU(hn::PromoteUpperTo(d32, hi), d32, dest + 3 * lanes);
+  });
+}
+
+// In the kernels below, the callers in the HWY_ONCE section check that all
+// buffers are large enough.
+
+// Copies the first `channel_count` bytes of the `pixel_count` pixels at `src`
+// into one plane per channel in `planes`.
+void DeinterleaveRow(const uint8_t* src,
+                     size_t pixel_count,
+                     int bpp,
+                     size_t channel_count,
+                     uint32_t* planes) {
+  const D8 d8;
+  const size_t lanes = hn::Lanes(d8);
+  size_t i = 0;
+  // SAFETY: `i + lanes` is at most `pixel_count` in the vector loops, and
+  // `i` is less than `pixel_count` in the scalar loop.
+  UNSAFE_BUFFERS({
+    uint32_t* plane1 = planes + pixel_count;
+    uint32_t* plane2 = planes + 2 * pixel_count;
+    uint32_t* plane3 = planes + 3 * pixel_count;
+    if (bpp == 1) {
+      for (; i + lanes <= pixel_count; i += lanes) {
+        StoreWidened(hn::LoadU(d8, src + i), planes + i);
+      }
+    } else if (bpp == 3) {
+      for (; i + lanes <= pixel_count; i += lanes) {
+        V8 b;
+        V8 g;
+        V8 r;
+        hn::LoadInterleaved3(d8, src + i * 3, b, g, r);
+        StoreWidened(b, planes + i);
+        StoreWidened(g, plane1 + i);
+        StoreWidened(r, plane2 + i);
+      }
+    } else {
+      for (; i + lanes <= pixel_count; i += lanes) {
+        V8 b;
+        V8 g;
+        V8 r;
+        V8 a;
+        hn::LoadInterleaved4(d8, src + i * 4, b, g, r, a);
+        StoreWidened(b, planes + i);
+        StoreWidened(g, plane1 + i);
+        StoreWidened(r, plane2 + i);
+        if (channel_count == 4) {
+          StoreWidened(a, plane3 + i);
+        }
+      }
+    }
+    for (; i < pixel_count; ++i) {
+      for (size_t c = 0; c < channel_count; ++c) {
+        planes[c * pixel_count + i] = src[i * bpp + c];
+      }
+    }
+  });
+}
+
+// Filters the planes made by DeinterleaveRow() into `dest_pixel_count`
+// destination pixels with `bpp` bytes, a group at a time.
+void FilterGroups(const uint32_t* planes,
+                  size_t src_pixel_count,
+                  size_t channel_count,
+                  bool has_alpha,
+                  const int32_t* indices,
+                  const uint32_t* weights,
+                  size_t tap_count,
+                  size_t dest_pixel_count,
+                  int bpp,
+                  uint8_t* dest) {
+  constexpr size_t kGroupSize = HorizontalStretcher::kGroupSize;
+  const DGroup d;
+  const DGroupIndex di;
+  const DGroup8 d8;
+  const size_t lanes = hn::Lanes(d);
+  const size_t group_taps = tap_count * kGroupSize;
+  const VGroup opaque = hn::Set(d, 255);
+  // SAFETY: the loops stay within `dest_pixel_count` destination pixels and
+  // their taps, and the taps only refer to pixels in the planes.
+  UNSAFE_BUFFERS({
+    const uint32_t* plane1 = planes + src_pixel_count;
+    const uint32_t* plane2 = planes + 2 * src_pixel_count;
+    const uint32_t* plane3 = planes + 3 * src_pixel_count;
+    for (size_t first = 0; first < dest_pixel_count; first += kGroupSize) {
+      const size_t count = std::min(kGroupSize, dest_pixel_count - first);
+      const int32_t* group_indices = indices + first * tap_count;
+      const uint32_t* group_weights = weights + first * tap_count;
+      uint8_t* group_dest = dest + first * bpp;
+
+      // Write the group to `pixels` first, so the last group can be partial.
+      uint8_t pixels[kGroupSize * 4] = {};
+      FXSYS_memcpy(pixels, group_dest, count * bpp);
+      for (size_t lane = 0; lane < kGroupSize; lane += lanes) {
+        VGroup sum_b = hn::Zero(d);
+        VGroup sum_g = hn::Zero(d);
+        VGroup sum_r = hn::Zero(d);
+        VGroup sum_a = hn::Zero(d);
+        for (size_t tap = lane; tap < group_taps; tap += kGroupSize) {
+          const hn::Vec<DGroupIndex> index =
+              hn::LoadU(di, group_indices + tap);
+          VGroup weight = hn::LoadU(d, group_weights + tap);
+          if (has_alpha) {
+            weight = Div255(hn::Mul(weight, hn::GatherIndex(d, plane3, index)));
+            sum_a = hn::Add(sum_a, weight);
+          }
+          sum_b = hn::Add(sum_b,
+                          hn::Mul(weight, hn::GatherIndex(d, planes, index)));
+          if (channel_count > 1) {
+            sum_g = hn::Add(
+                sum_g, hn::Mul(weight, hn::GatherIndex(d, plane1, index)));
+            sum_r = hn::Add(
+                sum_r, hn::Mul(weight, hn::GatherIndex(d, plane2, index)));
+          }
+        }
+
+        uint8_t* lane_pixels = pixels + lane * bpp;
+        if (bpp == 1) {
+          hn::StoreU(PixelFromFixed(sum_b), d8, lane_pixels);
+        } else if (bpp == 3) {
+          hn::StoreInterleaved3(PixelFromFixed(sum_b), PixelFromFixed(sum_g),
+                                PixelFromFixed(sum_r), d8, lane_pixels);
+        } else {
+          VGroup8 unused_b;
+          VGroup8 unused_g;
+          VGroup8 unused_r;
+          VGroup8 fourth;
+          hn::LoadInterleaved4(d8, lane_pixels, unused_b, unused_g, unused_r,
+                               fourth);
+          if (has_alpha) {
+            fourth = PixelFromFixed(hn::Mul(sum_a, opaque));
+          }
+          hn::StoreInterleaved4(PixelFromFixed(sum_b), PixelFromFixed(sum_g),
+                                PixelFromFixed(sum_r), fourth, d8,
+                                lane_pixels);
+        }
+      }
+      FXSYS_memcpy(group_dest, pixels, count * bpp);
+    }
+  });
+}
+
+// Adds the weighted bytes at `offset` in each row of `src` to the sums in
+// `sum0` to `sum3`, one for each quarter of a vector of bytes.
+HWY_INLINE void AccumulateRows(const uint8_t* src,
+                               size_t src_pitch,
+                               const uint32_t* weights,
+                               size_t weight_count,
+                               size_t offset,
+                               V32& sum0,
+                               V32& sum1,
+                               V32& sum2,
+                               V32& sum3) {
+  const D32 d32;
+  const D8Quarter d8;
+  const size_t lanes = hn::Lanes(d32);
+  // SAFETY: the caller checks that `src` holds `weight_count` rows, and that
+  // a vector of bytes at `offset` fits in a row.
+  UNSAFE_BUFFERS({
+    for (size_t row = 0; row < weight_count; ++row) {
+      const uint8_t* bytes = src + row * src_pitch + offset;
+      const V32 weight = hn::Set(d32, weights[row]);
+      const V32 bytes0 = hn::PromoteTo(d32, hn::LoadU(d8, bytes));
+      const V32 bytes1 = hn::PromoteTo(d32, hn::LoadU(d8, bytes + lanes));
+      const V32 bytes2 = hn::PromoteTo(d32, hn::LoadU(d8, bytes + 2 * lanes));
+      const V32 bytes3 = hn::PromoteTo(d32, hn::LoadU(d8, bytes + 3 * lanes));
+      sum0 = hn::Add(sum0, hn::Mul(weight, bytes0));
+      sum1 = hn::Add(sum1, hn::Mul(weight, bytes1));
+      sum2 = hn::Add(sum2, hn::Mul(weight, bytes2));
+      sum3 = hn::Add(sum3, hn::Mul(weight, bytes3));
+    }
+  });
+}
+
+// Returns the weighted sum of the bytes at `offset` in each row of `src`.
+uint32_t SumRowsAt(const uint8_t* src,
+                   size_t src_pitch,
+                   const uint32_t* weights,
+                   size_t weight_count,
+                   size_t offset) {
+  uint32_t sum = 0;
+  // SAFETY: the caller checks that `src` holds `weight_count` rows, and that
+  // `offset` is within a row.
+  UNSAFE_BUFFERS({
+    for (size_t row = 0; row < weight_count; ++row) {
+      sum += weights[row] * src[row * src_pitch + offset];
+    }
+  });
+  return sum;
+}
+
+void StretchVertRow(const uint8_t* src,
+                    size_t src_pitch,
+                    const uint32_t* weights,
+                    size_t weight_count,
+                    int bpp,
+                    int channel_count,
+                    uint8_t* dest,
+                    size_t byte_count) {
+  const D8 d8;
+  const D32 d32;
+  const D8Quarter d8_quarter;
+  const size_t lanes = hn::Lanes(d8);
+  const size_t quarter_lanes = hn::Lanes(d32);
+  // With 3 channels in 4 bytes, keep every fourth byte. Vectors of bytes
+  // start at multiples of 4, so the pattern is the same in each of them.
+  const bool skip_fourth = channel_count != bpp;
+  const hn::Vec<D8Quarter> three = hn::Set(d8_quarter, 3);
+  const hn::Mask<D8Quarter> keep =
+      hn::Eq(hn::And(hn::Iota(d8_quarter, 0), three), three);
+  size_t offset = 0;
+  // SAFETY: `offset + lanes` is at most `byte_count` in the vector loop, and
+  // `offset` is less than `byte_count` in the scalar loop.
+  UNSAFE_BUFFERS({
+    for (; offset + lanes <= byte_count; offset += lanes) {
+      V32 sums[4] = {hn::Zero(d32), hn::Zero(d32), hn::Zero(d32),
+                     hn::Zero(d32)};
+      AccumulateRows(src, src_pitch, weights, weight_count, offset, sums[0],
+                     sums[1], sums[2], sums[3]);
+      for (size_t quarter = 0; quarter < 4; ++quarter) {
+        uint8_t* out = dest + offset + quarter * quarter_lanes;
+        hn::Vec<D8Quarter> result =
+            hn::TruncateTo(d8_quarter, hn::ShiftRight<16>(sums[quarter]));
+        if (skip_fourth) {
+          result = hn::IfThenElse(keep, hn::LoadU(d8_quarter, out), result);
+        }
+        hn::StoreU(result, d8_quarter, out);
+      }
+    }
+    for (; offset < byte_count; ++offset) {
+      if (skip_fourth && offset % 4 == 3) {
+        continue;
+      }
+      dest[offset] = static_cast<uint8_t>(
+          SumRowsAt(src, src_pitch, weights, weight_count, offset) >> 16);
+    }
+  });
+}
+
+void StretchVertSums(const uint8_t* src,
+                     size_t src_pitch,
+                     const uint32_t* weights,
+                     size_t weight_count,
+                     uint32_t* sums,
+                     size_t byte_count) {
+  const D8 d8;
+  const D32 d32;
+  const size_t lanes = hn::Lanes(d8);
+  const size_t quarter_lanes = hn::Lanes(d32);
+  size_t offset = 0;
+  // SAFETY: `offset + lanes` is at most `byte_count` in the vector loop, and
+  // `offset` is less than `byte_count` in the scalar loop.
+  UNSAFE_BUFFERS({
+    for (; offset + lanes <= byte_count; offset += lanes) {
+      V32 sum0 = hn::Zero(d32);
+      V32 sum1 = hn::Zero(d32);
+      V32 sum2 = hn::Zero(d32);
+      V32 sum3 = hn::Zero(d32);
+      AccumulateRows(src, src_pitch, weights, weight_count, offset, sum0, sum1,
+                     sum2, sum3);
+      hn::StoreU(sum0, d32, sums + offset);
+      hn::StoreU(sum1, d32, sums + offset + quarter_lanes);
+      hn::StoreU(sum2, d32, sums + offset + 2 * quarter_lanes);
+      hn::StoreU(sum3, d32, sums + offset + 3 * quarter_lanes);
+    }
+    for (; offset < byte_count; ++offset) {
+      sums[offset] = SumRowsAt(src, src_pitch, weights, weight_count, offset);
+    }
+  });
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace fxge
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace fxge {
+
+HWY_EXPORT(DeinterleaveRow);
+HWY_EXPORT(FilterGroups);
+HWY_EXPORT(StretchVertRow);
+HWY_EXPORT(StretchVertSums);
+
+namespace {
+
+// Keeps the taps below 64 MB.
+constexpr size_t kMaxTapEntries = 8 * 1024 * 1024;
+
+// With alpha, weights are multiplied by alpha values and divided by 255. The
+// SIMD code does that exactly for products below 2^24.
+constexpr uint32_t kMaxAlphaWeight = (1 << 24) / 255;
+
+// Checks that `src` holds `weight_count` rows of which the last has at least
+// `byte_count` bytes.
+void CheckRows(pdfium::span<const uint8_t> src,
+               size_t src_pitch,
+               size_t weight_count,
+               size_t byte_count) {
+  if (weight_count > 0) {
+    CHECK_GE(src.size(), (weight_count - 1) * src_pitch + byte_count);
+    CHECK_GE(src_pitch, byte_count);
+  }
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<HorizontalStretcher> HorizontalStretcher::Create(
+    int bpp,
+    bool has_alpha,
+    int src_min,
+    int src_max,
+    size_t dest_pixel_count,
+    size_t max_taps) {
+  CHECK(bpp == 1 || bpp == 3 || bpp == 4);
+  CHECK(!has_alpha || bpp == 4);
+  if (src_min < 0 || src_max <= src_min || dest_pixel_count == 0 ||
+      max_taps == 0) {
+    return nullptr;
+  }
+  const size_t group_count =
+      (dest_pixel_count + kGroupSize - 1) / kGroupSize;
+  if (max_taps > kMaxTapEntries / kGroupSize / group_count) {
+    return nullptr;
+  }
+  return pdfium::WrapUnique(new HorizontalStretcher(
+      bpp, has_alpha, src_min, static_cast<size_t>(src_max - src_min),
+      dest_pixel_count, max_taps));
+}
+
+HorizontalStretcher::HorizontalStretcher(int bpp,
+                                         bool has_alpha,
+                                         int src_min,
+                                         size_t src_pixel_count,
+                                         size_t dest_pixel_count,
+                                         size_t tap_count)
+    : bpp_(bpp),
+      has_alpha_(has_alpha),
+      src_min_(src_min),
+      src_pixel_count_(src_pixel_count),
+      dest_pixel_count_(dest_pixel_count),
+      tap_count_(tap_count),
+      indices_((dest_pixel_count + kGroupSize - 1) / kGroupSize * kGroupSize *
+               tap_count),
+      weights_(indices_.size()),
+      planes_(GetChannelCount() * src_pixel_count) {}
+
+HorizontalStretcher::~HorizontalStretcher() = default;
+
+bool HorizontalStretcher::SetTaps(size_t dest_pixel,
+                                  int src_start,
+                                  pdfium::span<const uint32_t> weights) {
+  CHECK_LT(dest_pixel, dest_pixel_count_);
+  if (weights.size() > tap_count_) {
+    return false;
+  }
+  // Pixels without weights read the first source pixel, with a weight of 0.
+  size_t first_index = 0;
+  if (!weights.empty()) {
+    if (src_start < src_min_) {
+      return false;
+    }
+    first_index = static_cast<size_t>(src_start - src_min_);
+    if (first_index >= src_pixel_count_ ||
+        weights.size() > src_pixel_count_ - first_index) {
+      return false;
+    }
+  }
+  if (has_alpha_ && std::ranges::any_of(weights, [](uint32_t weight) {
+        return weight > kMaxAlphaWeight;
+      })) {
+    return false;
+  }
+
+  // Taps of the same pixel are `kGroupSize` apart.
+  const size_t group = dest_pixel / kGroupSize;
+  const size_t first_tap =
+      group * kGroupSize * tap_count_ + dest_pixel % kGroupSize;
+  for (size_t i = 0; i < tap_count_; ++i) {
+    const size_t tap = first_tap + i * kGroupSize;
+    if (i < weights.size()) {
+      indices_[tap] = static_cast<int32_t>(first_index + i);
+      weights_[tap] = weights[i];
+    } else {
+      indices_[tap] = static_cast<int32_t>(first_index);
+      weights_[tap] = 0;
+    }
+  }
+  return true;
+}
+
+void HorizontalStretcher::StretchRow(pdfium::span<const uint8_t> src_row,
+                                     pdfium::span<uint8_t> dest_row) {
+  pdfium::span<const uint8_t> src = src_row.subspan(
+      static_cast<size_t>(src_min_) * bpp_, src_pixel_count_ * bpp_);
+  CHECK_GE(dest_row.size(), dest_pixel_count_ * bpp_);
+  HWY_DYNAMIC_DISPATCH(DeinterleaveRow)(src.data(), src_pixel_count_, bpp_,
+                                        GetChannelCount(), planes_.data());
+  HWY_DYNAMIC_DISPATCH(FilterGroups)(
+      planes_.data(), src_pixel_count_, GetChannelCount(), has_alpha_,
+      indices_.data(), weights_.data(), tap_count_, dest_pixel_count_, bpp_,
+      dest_row.data());
+}
+
+size_t HorizontalStretcher::GetChannelCount() const {
+  return has_alpha_ || bpp_ == 1 ? bpp_ : 3;
+}
+
+void StretchVertRowSimd(pdfium::span<const uint8_t> src,
+                        size_t src_pitch,
+                        pdfium::span<const uint32_t> weights,
+                        int bpp,
+                        int channel_count,
+                        pdfium::span<uint8_t> dest) {
+  CHECK(channel_count == bpp || (channel_count == 3 && bpp == 4));
+  CheckRows(src, src_pitch, weights.size(), dest.size());
+  HWY_DYNAMIC_DISPATCH(StretchVertRow)(src.data(), src_pitch, weights.data(),
+                                       weights.size(), bpp, channel_count,
+                                       dest.data(), dest.size());
+}
+
+void StretchVertSumsSimd(pdfium::span<const uint8_t> src,
+                         size_t src_pitch,
+                         pdfium::span<const uint32_t> weights,
+                         pdfium::span<uint32_t> sums) {
+  CheckRows(src, src_pitch, weights.size(), sums.size());
+  HWY_DYNAMIC_DISPATCH(StretchVertSums)(src.data(), src_pitch, weights.data(),
+                                        weights.size(), sums.data(),
+                                        sums.size());
+}
+
+}  // namespace fxge
+#endif  // HWY_ONCE
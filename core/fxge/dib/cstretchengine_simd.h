@@ -0,0 +1,104 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_DIB_CSTRETCHENGINE_SIMD_H_
+#define CORE_FXGE_DIB_CSTRETCHENGINE_SIMD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/span.h"
+
+namespace fxge {
+
+// Vectorized versions of the CStretchEngine resampling passes. They run with
+// the widest instruction set the CPU supports, and give the same results as
+// the scalar fixed-point code, bit for bit.
+
+// Resamples rows horizontally, computing several destination pixels at once.
+// Each destination pixel is the weighted sum of a run of source pixels, with
+// weights in CStretchEngine's fixed-point format.
+class HorizontalStretcher {
+ public:
+  // Destination pixels are filtered in groups of this many.
+  static constexpr size_t kGroupSize = 16;
+
+  // Source and destination pixels have `bpp` bytes: 1 for gray, or 3 or 4 for
+  // BGR. If `has_alpha`, `bpp` must be 4 and the color is weighted by alpha.
+  // Otherwise, the fourth byte of destination pixels is left unchanged.
+  // Rows are read from the source pixels in [`src_min`, `src_max`), and each
+  // destination pixel has up to `max_taps` weights. Returns nullptr if the
+  // taps would take too much memory.
+  static std::unique_ptr<HorizontalStretcher> Create(int bpp,
+                                                     bool has_alpha,
+                                                     int src_min,
+                                                     int src_max,
+                                                     size_t dest_pixel_count,
+                                                     size_t max_taps);
+
+  ~HorizontalStretcher();
+
+  // Sets the taps of destination pixel `dest_pixel`, weighting the source
+  // pixels starting at `src_start`. Returns false if the SIMD code cannot
+  // give the same results as the scalar code for these taps.
+  bool SetTaps(size_t dest_pixel,
+               int src_start,
+               pdfium::span<const uint32_t> weights);
+
+  // Resamples `src_row`, which holds at least `src_max` pixels, into
+  // `dest_row`, which holds at least `dest_pixel_count` pixels.
+  void StretchRow(pdfium::span<const uint8_t> src_row,
+                  pdfium::span<uint8_t> dest_row);
+
+ private:
+  HorizontalStretcher(int bpp,
+                      bool has_alpha,
+                      int src_min,
+                      size_t src_pixel_count,
+                      size_t dest_pixel_count,
+                      size_t tap_count);
+
+  size_t GetChannelCount() const;
+
+  const int bpp_;
+  const bool has_alpha_;
+  const int src_min_;
+  const size_t src_pixel_count_;
+  const size_t dest_pixel_count_;
+  const size_t tap_count_;
+
+  // For each group of destination pixels and each tap, the indices of the
+  // source pixels, relative to `src_min_`, and their weights. Unused taps
+  // have a weight of 0.
+  DataVector<int32_t> indices_;
+  DataVector<uint32_t> weights_;
+
+  // Source pixels of the current row, one plane per channel.
+  DataVector<uint32_t> planes_;
+};
+
+// Resamples the rows of `src`, which are `src_pitch` bytes apart, into
+// `dest` with one weight per row. Computes the first `channel_count` bytes of
+// each pixel with `bpp` bytes, and leaves the other bytes unchanged.
+// `channel_count` must be either `bpp`, or 3 with a `bpp` of 4.
+void StretchVertRowSimd(pdfium::span<const uint8_t> src,
+                        size_t src_pitch,
+                        pdfium::span<const uint32_t> weights,
+                        int bpp,
+                        int channel_count,
+                        pdfium::span<uint8_t> dest);
+
+// Like StretchVertRowSimd(), but stores the weighted sums of all bytes in
+// `sums`, without converting them from fixed-point.
+void StretchVertSumsSimd(pdfium::span<const uint8_t> src,
+                         size_t src_pitch,
+                         pdfium::span<const uint32_t> weights,
+                         pdfium::span<uint32_t> sums);
+
+}  // namespace fxge
+
+#endif  // CORE_FXGE_DIB_CSTRETCHENGINE_SIMD_H_
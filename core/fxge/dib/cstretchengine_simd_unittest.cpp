@@ -0,0 +1,289 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/cstretchengine_simd.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "core/fxcrt/span.h"
+#include "core/fxge/dib/cstretchengine.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "hwy/targets.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// These tests check that the SIMD resampling code gives the same results as
+// the scalar code in CStretchEngine, using real weight tables for a range of
+// scales.
+
+namespace {
+
+using PixelWeight = CStretchEngine::PixelWeight;
+
+// From upscaling to 1/16 of the source length. None of these is a multiple of
+// any vector width.
+constexpr int kSrcLength = 997;
+constexpr int kDestLengths[] = {2503, 997, 499, 251, 125, 63};
+
+// Runs `test` once for each SIMD target that this CPU supports.
+template <typename Test>
+void ForEachTarget(const Test& test) {
+  for (int64_t target : hwy::SupportedAndGeneratedTargets()) {
+    SCOPED_TRACE(hwy::TargetName(target));
+    hwy::SetSupportedTargetsForTest(target);
+    test();
+  }
+  hwy::SetSupportedTargetsForTest(0);
+}
+
+// Deterministic xorshift generator, so failures are reproducible.
+class RandomBytes {
+ public:
+  std::vector<uint8_t> Bytes(size_t size) {
+    std::vector<uint8_t> result(size);
+    for (uint8_t& byte : result) {
+      state_ ^= state_ << 13;
+      state_ ^= state_ >> 17;
+      state_ ^= state_ << 5;
+      byte = static_cast<uint8_t>(state_ >> 24);
+    }
+    return result;
+  }
+
+ private:
+  uint32_t state_ = 0x12345678;
+};
+
+std::vector<FXDIB_ResampleOptions> GetAllOptions() {
+  std::vector<FXDIB_ResampleOptions> result(3);
+  result[1].bInterpolateBilinear = true;
+  result[2].bNoSmoothing = true;
+  return result;
+}
+
+// Calculates weights for `dest_length` pixels from the source pixels in
+// [`src_min`, `src_max`), mirrored if `dest_length` is negative.
+std::unique_ptr<CStretchEngine::WeightTable> CreateWeightTable(
+    int dest_length,
+    int src_min,
+    int src_max,
+    const FXDIB_ResampleOptions& options) {
+  auto table = std::make_unique<CStretchEngine::WeightTable>();
+  const int dest_max = dest_length < 0 ? -dest_length : dest_length;
+  if (!table->CalculateWeights(dest_length, 0, dest_max, kSrcLength, src_min,
+                               src_max, options)) {
+    return nullptr;
+  }
+  return table;
+}
+
+// Same as the horizontal pass in CStretchEngine::ContinueStretchHorz().
+void StretchRowScalar(const CStretchEngine::WeightTable& table,
+                      int dest_width,
+                      int bpp,
+                      bool has_alpha,
+                      pdfium::span<const uint8_t> src,
+                      pdfium::span<uint8_t> dest) {
+  for (int col = 0; col < dest_width; ++col) {
+    const PixelWeight* weights = table.GetPixelWeight(col);
+    uint32_t sums[4] = {};
+    for (int j = weights->src_start_; j <= weights->src_end_; ++j) {
+      pdfium::span<const uint8_t> src_pixel =
+          src.subspan(static_cast<size_t>(j * bpp), static_cast<size_t>(bpp));
+      uint32_t weight = weights->GetWeightForPosition(j);
+      if (has_alpha) {
+        weight = weight * src_pixel[3] / 255;
+        sums[3] += weight;
+      }
+      for (int c = 0; c < std::min(bpp, 3); ++c) {
+        sums[c] += weight * src_pixel[c];
+      }
+    }
+    for (int c = 0; c < std::min(bpp, 3); ++c) {
+      dest[col * bpp + c] = CStretchEngine::PixelFromFixed(sums[c]);
+    }
+    if (has_alpha) {
+      dest[col * bpp + 3] = CStretchEngine::PixelFromFixed(255 * sums[3]);
+    }
+  }
+}
+
+void CheckStretchRow(int bpp, bool has_alpha) {
+  // Leave a few source pixels out at both ends.
+  constexpr int kSrcMin = 2;
+  constexpr int kSrcMax = kSrcLength - 3;
+  RandomBytes random;
+  const std::vector<uint8_t> src = random.Bytes(kSrcLength * bpp);
+  for (const FXDIB_ResampleOptions& options : GetAllOptions()) {
+    for (int dest_length : kDestLengths) {
+      for (int sign : {1, -1}) {
+        SCOPED_TRACE(sign * dest_length);
+        std::unique_ptr<CStretchEngine::WeightTable> table = CreateWeightTable(
+            sign * dest_length, kSrcMin, kSrcMax, options);
+        ASSERT_TRUE(table);
+
+        // The fourth byte of BGRX pixels must be left unchanged.
+        const std::vector<uint8_t> dest = random.Bytes(dest_length * bpp);
+        std::vector<uint8_t> expected = dest;
+        StretchRowScalar(*table, dest_length, bpp, has_alpha, src, expected);
+
+        size_t max_taps = 1;
+        for (int col = 0; col < dest_length; ++col) {
+          max_taps = std::max(max_taps,
+                              table->GetPixelWeight(col)->GetWeights().size());
+        }
+        std::unique_ptr<fxge::HorizontalStretcher> stretcher =
+            fxge::HorizontalStretcher::Create(bpp, has_alpha, kSrcMin, kSrcMax,
+                                              dest_length, max_taps);
+        ASSERT_TRUE(stretcher);
+        for (int col = 0; col < dest_length; ++col) {
+          const PixelWeight* weights = table->GetPixelWeight(col);
+          ASSERT_TRUE(stretcher->SetTaps(col, weights->src_start_,
+                                         weights->GetWeights()));
+        }
+        ForEachTarget([&] {
+          std::vector<uint8_t> actual = dest;
+          stretcher->StretchRow(src, actual);
+          EXPECT_EQ(expected, actual);
+        });
+      }
+    }
+  }
+}
+
+// Rows of `kRowWidth` bytes, `kRowPitch` bytes apart.
+constexpr size_t kRowWidth = 37 * 4;
+constexpr size_t kRowPitch = kRowWidth + 12;
+
+// Returns the weighted sum of byte `offset` of the rows in `weights`.
+uint32_t SumRowsScalar(const PixelWeight& weights,
+                       pdfium::span<const uint8_t> src,
+                       size_t offset) {
+  uint32_t sum = 0;
+  for (int j = weights.src_start_; j <= weights.src_end_; ++j) {
+    sum += weights.GetWeightForPosition(j) * src[j * kRowPitch + offset];
+  }
+  return sum;
+}
+
+// Runs `check` for each destination row of each weight table.
+template <typename Check>
+void ForEachRow(const Check& check) {
+  for (const FXDIB_ResampleOptions& options : GetAllOptions()) {
+    for (int dest_length : kDestLengths) {
+      SCOPED_TRACE(dest_length);
+      std::unique_ptr<CStretchEngine::WeightTable> table =
+          CreateWeightTable(dest_length, 0, kSrcLength, options);
+      ASSERT_TRUE(table);
+      for (int row = 0; row < dest_length; ++row) {
+        check(*table->GetPixelWeight(row));
+      }
+    }
+  }
+}
+
+void CheckStretchVertRow(int bpp, int channel_count) {
+  RandomBytes random;
+  const std::vector<uint8_t> src = random.Bytes(kSrcLength * kRowPitch);
+  const std::vector<uint8_t> dest = random.Bytes(kRowWidth);
+  const pdfium::span<const uint8_t> src_span(src);
+  ForEachRow([&](const PixelWeight& weights) {
+    std::vector<uint8_t> expected = dest;
+    for (size_t offset = 0; offset < kRowWidth; ++offset) {
+      if (offset % bpp < static_cast<size_t>(channel_count)) {
+        expected[offset] = CStretchEngine::PixelFromFixed(
+            SumRowsScalar(weights, src_span, offset));
+      }
+    }
+    ForEachTarget([&] {
+      std::vector<uint8_t> actual = dest;
+      fxge::StretchVertRowSimd(
+          src_span.subspan(weights.src_start_ * kRowPitch), kRowPitch,
+          weights.GetWeights(), bpp, channel_count, actual);
+      EXPECT_EQ(expected, actual);
+    });
+  });
+}
+
+}  // namespace
+
+TEST(CStretchEngineSimdTest, StretchRowGray) {
+  CheckStretchRow(/*bpp=*/1, /*has_alpha=*/false);
+}
+
+TEST(CStretchEngineSimdTest, StretchRowBgr) {
+  CheckStretchRow(/*bpp=*/3, /*has_alpha=*/false);
+}
+
+TEST(CStretchEngineSimdTest, StretchRowBgrx) {
+  CheckStretchRow(/*bpp=*/4, /*has_alpha=*/false);
+}
+
+TEST(CStretchEngineSimdTest, StretchRowBgra) {
+  CheckStretchRow(/*bpp=*/4, /*has_alpha=*/true);
+}
+
+TEST(CStretchEngineSimdTest, SetTapsRejectsUnsupportedTaps) {
+  std::unique_ptr<fxge::HorizontalStretcher> stretcher =
+      fxge::HorizontalStretcher::Create(/*bpp=*/4, /*has_alpha=*/true,
+                                        /*src_min=*/10, /*src_max=*/20,
+                                        /*dest_pixel_count=*/4,
+                                        /*max_taps=*/2);
+  ASSERT_TRUE(stretcher);
+  const uint32_t kWeights[] = {CStretchEngine::kFixedPointOne / 2,
+                               CStretchEngine::kFixedPointOne / 2};
+  EXPECT_TRUE(stretcher->SetTaps(0, 10, kWeights));
+  EXPECT_TRUE(stretcher->SetTaps(1, 18, kWeights));
+  EXPECT_TRUE(stretcher->SetTaps(2, 10, {}));
+
+  // Outside of the source pixels.
+  EXPECT_FALSE(stretcher->SetTaps(3, 9, kWeights));
+  EXPECT_FALSE(stretcher->SetTaps(3, 19, kWeights));
+
+  // Too many taps.
+  const uint32_t kThreeWeights[] = {1, 2, 3};
+  EXPECT_FALSE(stretcher->SetTaps(3, 10, kThreeWeights));
+
+  // Too large to weight by alpha exactly.
+  const uint32_t kLargeWeights[] = {1 << 24};
+  EXPECT_FALSE(stretcher->SetTaps(3, 10, kLargeWeights));
+}
+
+TEST(CStretchEngineSimdTest, StretchVertRowGray) {
+  CheckStretchVertRow(/*bpp=*/1, /*channel_count=*/1);
+}
+
+TEST(CStretchEngineSimdTest, StretchVertRowBgr) {
+  CheckStretchVertRow(/*bpp=*/3, /*channel_count=*/3);
+}
+
+TEST(CStretchEngineSimdTest, StretchVertRowBgrx) {
+  CheckStretchVertRow(/*bpp=*/4, /*channel_count=*/3);
+}
+
+TEST(CStretchEngineSimdTest, StretchVertRowBgra) {
+  CheckStretchVertRow(/*bpp=*/4, /*channel_count=*/4);
+}
+
+TEST(CStretchEngineSimdTest, StretchVertSums) {
+  RandomBytes random;
+  const std::vector<uint8_t> src = random.Bytes(kSrcLength * kRowPitch);
+  const pdfium::span<const uint8_t> src_span(src);
+  ForEachRow([&](const PixelWeight& weights) {
+    std::vector<uint32_t> expected(kRowWidth);
+    for (size_t offset = 0; offset < kRowWidth; ++offset) {
+      expected[offset] = SumRowsScalar(weights, src_span, offset);
+    }
+    ForEachTarget([&] {
+      std::vector<uint32_t> actual(kRowWidth);
+      fxge::StretchVertSumsSimd(
+          src_span.subspan(weights.src_start_ * kRowPitch), kRowPitch,
+          weights.GetWeights(), actual);
+      EXPECT_EQ(expected, actual);
+    });
+  });
+}
@@ -80,9 +80,25 @@ pdfium::span<const FT_Var_Axis> GetVariationAxis(
       pdfium::span(variation_desc->axis, variation_desc->num_axis));
 }
 
+std::recursive_mutex& GetFreeTypeMutex() {
+  // Intentionally leaked, as faces may be released during static destruction.
+  static std::recursive_mutex* const mutex = new std::recursive_mutex();
+  return *mutex;
+}
+
 }  // namespace
 
+FXFT_ScopedLock FXFT_AcquireLock() {
+  return FXFT_ScopedLock(GetFreeTypeMutex());
+}
+
+void FXFTFaceRecDeleter::operator()(FT_FaceRec* pRec) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
+  FT_Done_Face(pRec);
+}
+
 void FXFTMMVarDeleter::operator()(FT_MM_Var* variation_desc) {
+  FXFT_ScopedLock lock = FXFT_AcquireLock();
   FT_Done_MM_Var(CFX_GEModule::Get()->GetFontMgr()->GetFTLibrary(),
                  variation_desc);
 }
@@ -10,6 +10,7 @@
 #include <ft2build.h>
 
 #include <memory>
+#include <mutex>
 
 #include "core/fxcrt/span.h"
 
@@ -24,7 +25,7 @@
 using FXFT_LibraryRec = struct FT_LibraryRec_;
 
 struct FXFTFaceRecDeleter {
-  inline void operator()(FT_FaceRec* pRec) { FT_Done_Face(pRec); }
+  void operator()(FT_FaceRec* pRec);
 };
 
 struct FXFTLibraryRecDeleter {
@@ -56,6 +57,12 @@ class ScopedFXFTMMVar {
   const pdfium::span<const FT_Var_Axis> axis_;
 };
 
+// FreeType library and face objects are not thread-safe, and the faces of
+// standard and system fonts are shared by all documents. Code that creates,
+// destroys or mutates FreeType objects holds this process-wide lock.
+using FXFT_ScopedLock = std::unique_lock<std::recursive_mutex>;
+FXFT_ScopedLock FXFT_AcquireLock();
+
 ScopedFXFTLibraryRec InitializeFreeType();
 bool FreeTypeSetLcdFilterMode(FXFT_LibraryRec* ft_library);
 bool FreeTypeVersionSupportsHinting(FXFT_LibraryRec* ft_library);
@@ -6,6 +6,7 @@
 
 #include "fpdfsdk/cpdfsdk_helpers.h"
 
+#include <memory>
 #include <utility>
 
 #include "build/build_config.h"
@@ -23,6 +24,7 @@
 #include "core/fpdfdoc/cpdf_metadata.h"
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/compiler_specific.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/numerics/safe_conversions.h"
 #include "core/fxcrt/span_util.h"
@@ -73,6 +75,21 @@ unsigned long GetStreamMaybeCopyAndReturnLengthImpl(
     bool decode) {
   DCHECK(stream);
   auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(stream));
+  if (decode && buffer.empty()) {
+    // Only the length is wanted, so decode a piece at a time instead of
+    // holding all of the decoded data.
+    std::unique_ptr<CPDF_StreamAcc::Reader> reader =
+        stream_acc->CreateFilteredReader();
+    DataVector<uint8_t> chunk(4096);
+    size_t length = 0;
+    size_t size;
+    do {
+      size = reader->Read(chunk);
+      length += size;
+    } while (size == chunk.size());
+    return pdfium::checked_cast<unsigned long>(length);
+  }
+
   if (decode) {
     stream_acc->LoadAllDataFiltered();
   } else {
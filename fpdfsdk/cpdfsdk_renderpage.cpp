@@ -8,32 +8,27 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "build/build_config.h"
 #include "core/fpdfapi/page/cpdf_pageimagecache.h"
 #include "core/fpdfapi/render/cpdf_pagerendercontext.h"
+#include "core/fpdfapi/render/cpdf_parallelrenderer.h"
 #include "core/fpdfapi/render/cpdf_progressiverenderer.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfdoc/cpdf_annotlist.h"
 #include "core/fxge/cfx_renderdevice.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
 #include "fpdfsdk/cpdfsdk_helpers.h"
 #include "fpdfsdk/cpdfsdk_pauseadapter.h"
 
 namespace {
 
-void RenderPageImpl(CPDF_PageRenderContext* context,
-                    CPDF_Page* pPage,
-                    const CFX_Matrix& matrix,
-                    const FX_RECT& clipping_rect,
-                    int flags,
-                    const FPDF_COLORSCHEME* color_scheme,
-                    bool need_to_restore,
-                    CPDFSDK_PauseAdapter* pause) {
-  if (!context->options_) {
-    context->options_ = std::make_unique<CPDF_RenderOptions>();
-  }
-
-  auto& options = context->options_->GetOptions();
+void ConfigureRenderOptions(CPDF_RenderOptions* render_options,
+                            CPDF_Page* pPage,
+                            int flags,
+                            const FPDF_COLORSCHEME* color_scheme) {
+  auto& options = render_options->GetOptions();
   options.bClearType = !!(flags & FPDF_LCD_TEXT);
   options.bNoNativeText = !!(flags & FPDF_NO_NATIVETEXT);
   options.bLimitedImageCache = !!(flags & FPDF_RENDER_LIMITEDIMAGECACHE);
@@ -44,19 +39,33 @@ void RenderPageImpl(CPDF_PageRenderContext* context,
 
   // Grayscale output
   if (flags & FPDF_GRAYSCALE) {
-    context->options_->SetColorMode(CPDF_RenderOptions::kGray);
+    render_options->SetColorMode(CPDF_RenderOptions::kGray);
   }
 
   if (color_scheme) {
-    context->options_->SetColorMode(CPDF_RenderOptions::kForcedColor);
-    SetColorFromScheme(color_scheme, context->options_.get());
+    render_options->SetColorMode(CPDF_RenderOptions::kForcedColor);
+    SetColorFromScheme(color_scheme, render_options);
     options.bConvertFillToStroke = !!(flags & FPDF_CONVERT_FILL_TO_STROKE);
   }
 
   const CPDF_OCContext::UsageType usage =
       (flags & FPDF_PRINTING) ? CPDF_OCContext::kPrint : CPDF_OCContext::kView;
-  context->options_->SetOCContext(
+  render_options->SetOCContext(
       pdfium::MakeRetain<CPDF_OCContext>(pPage->GetDocument(), usage));
+}
+
+void RenderPageImpl(CPDF_PageRenderContext* context,
+                    CPDF_Page* pPage,
+                    const CFX_Matrix& matrix,
+                    const FX_RECT& clipping_rect,
+                    int flags,
+                    const FPDF_COLORSCHEME* color_scheme,
+                    bool need_to_restore,
+                    CPDFSDK_PauseAdapter* pause) {
+  if (!context->options_) {
+    context->options_ = std::make_unique<CPDF_RenderOptions>();
+  }
+  ConfigureRenderOptions(context->options_.get(), pPage, flags, color_scheme);
 
   context->device_->SaveState();
   context->device_->SetBaseClip(clipping_rect);
@@ -117,3 +126,49 @@ void CPDFSDK_RenderPageWithContext(CPDF_PageRenderContext* context,
   RenderPageImpl(context, pPage, pPage->GetDisplayMatrixForRect(rect, rotate),
                  rect, flags, color_scheme, need_to_restore, pause);
 }
+
+void CPDFSDK_RenderPageInParallel(CPDF_Page* pPage,
+                                  RetainPtr<CFX_DIBitmap> bitmap,
+                                  bool rgb_byte_order,
+                                  int start_x,
+                                  int start_y,
+                                  int size_x,
+                                  int size_y,
+                                  int rotate,
+                                  int flags,
+                                  size_t thread_count) {
+  const FX_RECT rect(start_x, start_y, start_x + size_x, start_y + size_y);
+  FX_RECT clipping_rect = rect;
+  clipping_rect.Intersect(
+      FX_RECT(0, 0, bitmap->GetWidth(), bitmap->GetHeight()));
+  const CFX_Matrix matrix = pPage->GetDisplayMatrixForRect(rect, rotate);
+
+  std::unique_ptr<CPDF_AnnotList> annot_list;
+  if (flags & FPDF_ANNOT) {
+    annot_list = std::make_unique<CPDF_AnnotList>(pPage);
+  }
+
+  std::vector<CPDF_ParallelRenderer::Band> bands;
+  for (const FX_RECT& band_rect :
+       CPDF_ParallelRenderer::SplitIntoBands(clipping_rect, thread_count)) {
+    CPDF_ParallelRenderer::Band band;
+    band.rect = band_rect;
+    band.options = std::make_unique<CPDF_RenderOptions>();
+    ConfigureRenderOptions(band.options.get(), pPage, flags,
+                           /*color_scheme=*/nullptr);
+    band.context = std::make_unique<CPDF_RenderContext>(
+        pPage->GetDocument(), pPage->GetMutablePageResources(),
+        pPage->GetPageImageCache());
+    band.context->AppendLayer(pPage, matrix);
+    if (annot_list) {
+      // TODO(https://crbug.com/42271964) - maybe pass true here.
+      annot_list->DisplayAnnots(band.context.get(),
+                                /*bPrinting=*/!!(flags & FPDF_PRINTING),
+                                matrix, /*bShowWidget=*/false);
+    }
+    bands.push_back(std::move(band));
+  }
+
+  CPDF_ParallelRenderer renderer(std::move(bitmap), rgb_byte_order);
+  renderer.Render(std::move(bands), thread_count);
+}
@@ -7,8 +7,12 @@
 #ifndef FPDFSDK_CPDFSDK_RENDERPAGE_H_
 #define FPDFSDK_CPDFSDK_RENDERPAGE_H_
 
+#include <stddef.h>
+
+#include "core/fxcrt/retain_ptr.h"
 #include "public/fpdfview.h"
 
+class CFX_DIBitmap;
 class CFX_Matrix;
 class CPDFSDK_PauseAdapter;
 class CPDF_Page;
@@ -36,4 +40,18 @@ void CPDFSDK_RenderPageWithContext(CPDF_PageRenderContext* context,
                                    bool need_to_restore,
                                    CPDFSDK_PauseAdapter* pause);
 
+// Renders `pPage` into `bitmap` by splitting the destination rectangle into
+// horizontal bands that are rendered by up to `thread_count` threads. Produces
+// the same output as CPDFSDK_RenderPageWithContext() with no color scheme.
+void CPDFSDK_RenderPageInParallel(CPDF_Page* pPage,
+                                  RetainPtr<CFX_DIBitmap> bitmap,
+                                  bool rgb_byte_order,
+                                  int start_x,
+                                  int start_y,
+                                  int size_x,
+                                  int size_y,
+                                  int rotate,
+                                  int flags,
+                                  size_t thread_count);
+
 #endif  // FPDFSDK_CPDFSDK_RENDERPAGE_H_
@@ -1894,6 +1894,79 @@ TEST_F(FPDFEditEmbedderTest, MaintainIndirectMarkedObjects) {
   CheckMarkCounts(saved_page.get(), 2, 18, 8, 3, 9, 1);
 }
 
+TEST_F(FPDFEditEmbedderTest, GetObjectsInRect) {
+  CreateEmptyDocument();
+  ScopedFPDFPage page(FPDFPage_New(document(), 0, 640, 480));
+  ASSERT_TRUE(page);
+
+  // Add enough 10x10 squares, 20 units apart, for the page to build a spatial
+  // index.
+  static constexpr int kColumns = 32;
+  static constexpr int kRows = 24;
+  for (int y = 0; y < kRows; ++y) {
+    for (int x = 0; x < kColumns; ++x) {
+      FPDF_PAGEOBJECT square =
+          FPDFPageObj_CreateNewRect(x * 20, y * 20, 10, 10);
+      ASSERT_TRUE(square);
+      EXPECT_TRUE(FPDFPath_SetDrawMode(square, FPDF_FILLMODE_ALTERNATE, 0));
+      FPDFPage_InsertObject(page.get(), square);
+    }
+  }
+  ASSERT_EQ(kColumns * kRows, FPDFPage_CountObjects(page.get()));
+
+  static constexpr int kMaxObjects = 8;
+  std::array<FPDF_PAGEOBJECT, kMaxObjects> objects;
+  static constexpr FS_RECTF kPoint = {25, 25, 25, 25};
+  EXPECT_EQ(-1, FPDFPage_GetObjectsInRect(nullptr, &kPoint, objects.data(),
+                                          kMaxObjects));
+  EXPECT_EQ(-1, FPDFPage_GetObjectsInRect(page.get(), nullptr, objects.data(),
+                                          kMaxObjects));
+  EXPECT_EQ(-1, FPDFPage_GetObjectsInRect(page.get(), &kPoint, nullptr, 1));
+  EXPECT_EQ(-1,
+            FPDFPage_GetObjectsInRect(page.get(), &kPoint, objects.data(), -1));
+
+  // A point inside the square at (1, 1).
+  ASSERT_EQ(1, FPDFPage_GetObjectsInRect(page.get(), &kPoint, objects.data(),
+                                         kMaxObjects));
+  EXPECT_EQ(FPDFPage_GetObject(page.get(), kColumns + 1), objects[0]);
+
+  // A point between squares.
+  static constexpr FS_RECTF kGap = {15, 15, 15, 15};
+  EXPECT_EQ(0, FPDFPage_GetObjectsInRect(page.get(), &kGap, objects.data(),
+                                         kMaxObjects));
+
+  // A rect over 2x2 squares. Results are in z-order, and the count does not
+  // depend on the buffer size.
+  static constexpr FS_RECTF kRect = {5, 35, 35, 5};
+  EXPECT_EQ(4, FPDFPage_GetObjectsInRect(page.get(), &kRect, nullptr, 0));
+  ASSERT_EQ(4, FPDFPage_GetObjectsInRect(page.get(), &kRect, objects.data(),
+                                         kMaxObjects));
+  EXPECT_EQ(FPDFPage_GetObject(page.get(), 0), objects[0]);
+  EXPECT_EQ(FPDFPage_GetObject(page.get(), 1), objects[1]);
+  EXPECT_EQ(FPDFPage_GetObject(page.get(), kColumns), objects[2]);
+  EXPECT_EQ(FPDFPage_GetObject(page.get(), kColumns + 1), objects[3]);
+
+  // Moving a square is reflected in the results.
+  FPDF_PAGEOBJECT first = FPDFPage_GetObject(page.get(), 0);
+  FPDFPageObj_Transform(first, 1, 0, 0, 1, 25, 25);
+  ASSERT_EQ(2, FPDFPage_GetObjectsInRect(page.get(), &kPoint, objects.data(),
+                                         kMaxObjects));
+  EXPECT_EQ(first, objects[0]);
+  EXPECT_EQ(FPDFPage_GetObject(page.get(), kColumns + 1), objects[1]);
+
+  // So is removing one.
+  ScopedFPDFPageObject removed(FPDFPage_GetObject(page.get(), kColumns + 1));
+  ASSERT_TRUE(FPDFPage_RemoveObject(page.get(), removed.get()));
+  ASSERT_EQ(1, FPDFPage_GetObjectsInRect(page.get(), &kPoint, objects.data(),
+                                         kMaxObjects));
+  EXPECT_EQ(first, objects[0]);
+
+  // Transforming a removed object does not affect the page.
+  FPDFPageObj_Transform(removed.get(), 1, 0, 0, 1, 100, 100);
+  EXPECT_EQ(1, FPDFPage_GetObjectsInRect(page.get(), &kPoint, objects.data(),
+                                         kMaxObjects));
+}
+
 TEST_F(FPDFEditEmbedderTest, RemoveExistingPageObject) {
   // Load document with some text.
   ASSERT_TRUE(OpenDocument("hello_world.pdf"));
@@ -371,6 +371,36 @@ FPDF_EXPORT FPDF_PAGEOBJECT FPDF_CALLCONV FPDFPage_GetObject(FPDF_PAGE page,
   return FPDFPageObjectFromCPDFPageObject(pPage->GetPageObjectByIndex(index));
 }
 
+FPDF_EXPORT int FPDF_CALLCONV
+FPDFPage_GetObjectsInRect(FPDF_PAGE page,
+                          const FS_RECTF* rect,
+                          FPDF_PAGEOBJECT* objects,
+                          int max_objects) {
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!IsPageObject(pPage) || !rect || max_objects < 0 ||
+      (!objects && max_objects > 0)) {
+    return -1;
+  }
+
+  CFX_FloatRect search_rect = CFXFloatRectFromFSRectF(*rect);
+  search_rect.Normalize();
+
+  // SAFETY: required from caller.
+  auto objects_span = UNSAFE_BUFFERS(
+      pdfium::span(objects, static_cast<size_t>(max_objects)));
+  size_t count = 0;
+  for (CPDF_PageObject* page_obj : pPage->GetPageObjectsInRect(search_rect)) {
+    if (!page_obj->IsActive()) {
+      continue;
+    }
+    if (count < objects_span.size()) {
+      objects_span[count] = FPDFPageObjectFromCPDFPageObject(page_obj);
+    }
+    ++count;
+  }
+  return pdfium::checked_cast<int>(count);
+}
+
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPage_HasTransparency(FPDF_PAGE page) {
   CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
   return pPage && pPage->BackgroundAlphaNeeded();
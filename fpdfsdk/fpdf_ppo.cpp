@@ -6,6 +6,7 @@
 
 #include "public/fpdf_ppo.h"
 
+#include <map>
 #include <memory>
 #include <numeric>
 #include <utility>
@@ -13,6 +14,7 @@
 
 #include "constants/catalog.h"
 #include "core/fpdfapi/edit/cpdf_npagetooneexporter.h"
+#include "core/fpdfapi/edit/cpdf_objectdeduplicator.h"
 #include "core/fpdfapi/edit/cpdf_pageexporter.h"
 #include "core/fpdfapi/page/cpdf_form.h"
 #include "core/fpdfapi/page/cpdf_formobject.h"
@@ -25,6 +27,7 @@
 #include "core/fpdfapi/parser/cpdf_object.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fxcrt/check.h"
+#include "core/fxcrt/numerics/safe_conversions.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/span.h"
 #include "fpdfsdk/cpdfsdk_helpers.h"
@@ -158,6 +161,82 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_ImportPages(FPDF_DOCUMENT dest_doc,
   return true;
 }
 
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_ImportPagesFromDocuments(FPDF_DOCUMENT dest_doc,
+                              const FPDF_IMPORT_PAGES_SOURCE* sources,
+                              unsigned long count,
+                              int index) {
+  CPDF_Document* cdest_doc = CPDFDocumentFromFPDFDocument(dest_doc);
+  if (!cdest_doc || !sources || count == 0) {
+    return false;
+  }
+
+  // Check all the sources before importing anything.
+  struct Import {
+    CPDF_Document* src_doc;
+    std::vector<uint32_t> page_indices;
+  };
+  std::vector<Import> imports;
+  // SAFETY: required from caller.
+  auto source_span = UNSAFE_BUFFERS(
+      pdfium::span(sources, pdfium::checked_cast<size_t>(count)));
+  for (const FPDF_IMPORT_PAGES_SOURCE& source : source_span) {
+    CPDF_Document* csrc_doc = CPDFDocumentFromFPDFDocument(source.src_doc);
+    if (!csrc_doc) {
+      return false;
+    }
+
+    if (!source.page_indices) {
+      imports.push_back({csrc_doc, GetPageIndices(*csrc_doc, ByteString())});
+      continue;
+    }
+    size_t length = pdfium::checked_cast<size_t>(source.length);
+    if (length == 0) {
+      return false;
+    }
+    // SAFETY: required from caller.
+    auto page_span = UNSAFE_BUFFERS(pdfium::span(source.page_indices, length));
+    const int page_count = csrc_doc->GetPageCount();
+    std::vector<uint32_t> page_indices;
+    page_indices.reserve(length);
+    for (int page_index : page_span) {
+      if (page_index < 0 || page_index >= page_count) {
+        return false;
+      }
+      page_indices.push_back(page_index);
+    }
+    imports.push_back({csrc_doc, std::move(page_indices)});
+  }
+
+  // Use one exporter per source document, so its map of copied objects spans
+  // all the entries for that document. Drop it after the last one.
+  std::map<CPDF_Document*, size_t> last_import;
+  for (size_t i = 0; i < imports.size(); ++i) {
+    last_import[imports[i].src_doc] = i;
+  }
+  std::map<CPDF_Document*, std::unique_ptr<CPDF_PageExporter>> exporters;
+  CPDF_Document::Extension* extension = cdest_doc->GetExtension();
+  for (size_t i = 0; i < imports.size(); ++i) {
+    CPDF_Document* csrc_doc = imports[i].src_doc;
+    std::unique_ptr<CPDF_PageExporter>& exporter = exporters[csrc_doc];
+    if (!exporter) {
+      exporter = std::make_unique<CPDF_PageExporter>(cdest_doc, csrc_doc);
+    }
+    const std::vector<uint32_t>& page_indices = imports[i].page_indices;
+    if (!exporter->ExportPages(page_indices, index)) {
+      return false;
+    }
+    if (extension) {
+      extension->PagesInserted(index, page_indices.size());
+    }
+    index += pdfium::checked_cast<int>(page_indices.size());
+    if (last_import[csrc_doc] == i) {
+      exporters.erase(csrc_doc);
+    }
+  }
+  return true;
+}
+
 FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
 FPDF_ImportNPagesToOne(FPDF_DOCUMENT src_doc,
                        float output_width,
@@ -279,3 +358,18 @@ FPDF_CopyViewerPreferences(FPDF_DOCUMENT dest_doc, FPDF_DOCUMENT src_doc) {
                     std::move(cloned_dict));
   return true;
 }
+
+FPDF_EXPORT int FPDF_CALLCONV
+FPDF_DeduplicateObjects(FPDF_DOCUMENT document, unsigned long* bytes_saved) {
+  CPDF_Document* doc = CPDFDocumentFromFPDFDocument(document);
+  if (!doc) {
+    return -1;
+  }
+
+  CPDF_ObjectDeduplicator::Result result =
+      CPDF_ObjectDeduplicator(doc).Deduplicate();
+  if (bytes_saved) {
+    *bytes_saved = pdfium::saturated_cast<unsigned long>(result.bytes_saved);
+  }
+  return pdfium::saturated_cast<int>(result.objects_removed);
+}
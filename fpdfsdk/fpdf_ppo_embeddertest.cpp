@@ -658,6 +658,106 @@ TEST_F(FPDFPPOEmbedderTest, ImportIntoDestDocWithoutInfo) {
   EXPECT_EQ(3, FPDF_GetPageCount(document()));
 }
 
+TEST_F(FPDFPPOEmbedderTest, ImportPagesFromDocuments) {
+  ASSERT_TRUE(OpenDocument("hello_world_2_pages.pdf"));
+  ScopedFPDFDocument rectangles_doc(FPDF_LoadDocument(
+      PathService::GetTestFilePath("rectangles.pdf").c_str(), nullptr));
+  ASSERT_TRUE(rectangles_doc);
+
+  ScopedFPDFDocument output_doc(FPDF_CreateNewDocument());
+  ASSERT_TRUE(output_doc);
+  static constexpr int kFirstPage[] = {0};
+  static constexpr int kSecondPage[] = {1};
+  const FPDF_IMPORT_PAGES_SOURCE kSources[] = {
+      {document(), kFirstPage, std::size(kFirstPage)},
+      {rectangles_doc.get(), nullptr, 0},
+      {document(), kSecondPage, std::size(kSecondPage)},
+  };
+  ASSERT_TRUE(FPDF_ImportPagesFromDocuments(output_doc.get(), kSources,
+                                            std::size(kSources), 0));
+  ASSERT_EQ(3, FPDF_GetPageCount(output_doc.get()));
+  EXPECT_EQ(GetPageChecksum(document(), 0),
+            GetPageChecksum(output_doc.get(), 0));
+  EXPECT_EQ(GetPageChecksum(rectangles_doc.get(), 0),
+            GetPageChecksum(output_doc.get(), 1));
+  EXPECT_EQ(GetPageChecksum(document(), 1),
+            GetPageChecksum(output_doc.get(), 2));
+
+  // Both pages from `document()` share one copy of their content stream.
+  CPDF_Document* output_doc_impl =
+      CPDFDocumentFromFPDFDocument(output_doc.get());
+  RetainPtr<const CPDF_Object> first_contents =
+      output_doc_impl->GetPageDictionary(0)->GetDirectObjectFor("Contents");
+  RetainPtr<const CPDF_Object> second_contents =
+      output_doc_impl->GetPageDictionary(2)->GetDirectObjectFor("Contents");
+  ASSERT_TRUE(first_contents);
+  EXPECT_EQ(first_contents, second_contents);
+}
+
+TEST_F(FPDFPPOEmbedderTest, ImportPagesFromDocumentsBadSources) {
+  ASSERT_TRUE(OpenDocument("hello_world_2_pages.pdf"));
+  ScopedFPDFDocument output_doc(FPDF_CreateNewDocument());
+  ASSERT_TRUE(output_doc);
+
+  static constexpr int kBadPage[] = {-1};
+  const FPDF_IMPORT_PAGES_SOURCE kBadIndexSources[] = {
+      {document(), nullptr, 0},
+      {document(), kBadPage, std::size(kBadPage)},
+  };
+  EXPECT_FALSE(FPDF_ImportPagesFromDocuments(output_doc.get(), kBadIndexSources,
+                                             std::size(kBadIndexSources), 0));
+  static constexpr int kPastLastPage[] = {2};
+  const FPDF_IMPORT_PAGES_SOURCE kPastLastPageSources[] = {
+      {document(), nullptr, 0},
+      {document(), kPastLastPage, std::size(kPastLastPage)},
+  };
+  EXPECT_FALSE(FPDF_ImportPagesFromDocuments(
+      output_doc.get(), kPastLastPageSources, std::size(kPastLastPageSources),
+      0));
+  const FPDF_IMPORT_PAGES_SOURCE kNoDocumentSources[] = {
+      {document(), nullptr, 0},
+      {nullptr, nullptr, 0},
+  };
+  EXPECT_FALSE(FPDF_ImportPagesFromDocuments(
+      output_doc.get(), kNoDocumentSources, std::size(kNoDocumentSources), 0));
+  EXPECT_FALSE(FPDF_ImportPagesFromDocuments(output_doc.get(), nullptr, 0, 0));
+  EXPECT_EQ(0, FPDF_GetPageCount(output_doc.get()));
+}
+
+TEST_F(FPDFPPOEmbedderTest, DeduplicateObjects) {
+  EXPECT_EQ(-1, FPDF_DeduplicateObjects(nullptr, nullptr));
+
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  ScopedFPDFDocument output_doc(FPDF_CreateNewDocument());
+  ASSERT_TRUE(output_doc);
+  EXPECT_TRUE(FPDF_ImportPages(output_doc.get(), document(), "1", 0));
+  EXPECT_TRUE(FPDF_ImportPages(output_doc.get(), document(), "1", 1));
+  ASSERT_EQ(2, FPDF_GetPageCount(output_doc.get()));
+  EXPECT_TRUE(FPDF_SaveAsCopy(output_doc.get(), this, 0));
+  const size_t original_size = GetString().size();
+
+  // The second copy of the page shares the first copy's content stream and
+  // fonts.
+  unsigned long bytes_saved = 0;
+  EXPECT_GT(FPDF_DeduplicateObjects(output_doc.get(), &bytes_saved), 0);
+  EXPECT_GT(bytes_saved, 0u);
+  EXPECT_EQ(0, FPDF_DeduplicateObjects(output_doc.get(), nullptr));
+
+  ClearString();
+  EXPECT_TRUE(FPDF_SaveAsCopy(output_doc.get(), this, 0));
+  EXPECT_LT(GetString().size(), original_size);
+
+  ScopedSavedDoc saved_doc = OpenScopedSavedDocument();
+  ASSERT_TRUE(saved_doc);
+  ASSERT_EQ(2, FPDF_GetPageCount(saved_doc.get()));
+  for (int i = 0; i < 2; ++i) {
+    ScopedSavedPage saved_page = LoadScopedSavedPage(i);
+    ASSERT_TRUE(saved_page);
+    VerifySavedRenderingWithExpectationSuffix(saved_page.get(),
+                                              pdfium::kHelloWorldPng);
+  }
+}
+
 TEST_F(FPDFPPOEmbedderTest, ImportIntoDocWithWrongPageType) {
   ASSERT_TRUE(OpenDocument("bad_page_type.pdf"));
   EXPECT_EQ(2, FPDF_GetPageCount(document()));
@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 
+#include <memory>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -18,6 +19,7 @@
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_parse_cache.h"
 #include "core/fpdfapi/parser/cpdf_reference.h"
 #include "core/fpdfapi/parser/cpdf_stream_acc.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
@@ -43,6 +45,8 @@ static_assert(FPDF_REMOVE_SECURITY ==
               CPDF_Creator::CreateFlags::kRemoveSecurity);
 static_assert(FPDF_SUBSET_NEW_FONTS ==
               CPDF_Creator::CreateFlags::kSubsetNewFonts);
+static_assert(FPDF_COMPRESS_OBJECTS ==
+              CPDF_Creator::CreateFlags::kCompressObjects);
 
 namespace {
 
@@ -176,7 +180,8 @@ bool SaveXFADocumentData(
 bool DoDocSave(FPDF_DOCUMENT document,
                FPDF_FILEWRITE* file_write,
                FPDF_DWORD flags,
-               std::optional<int> version) {
+               std::optional<int> version,
+               int thread_count) {
   CPDF_Document* doc = CPDFDocumentFromFPDFDocument(document);
   if (!doc) {
     return false;
@@ -193,6 +198,9 @@ bool DoDocSave(FPDF_DOCUMENT document,
 
   CPDF_Creator file_maker(
       doc, pdfium::MakeRetain<CPDFSDK_FileWriteAdapter>(file_write));
+  if (thread_count > 1) {
+    file_maker.SetThreadCount(thread_count);
+  }
   bool create_result = file_maker.Create(
       Mask<CPDF_Creator::CreateFlags>::FromUnderlyingUnchecked(
           static_cast<uint32_t>(flags)),
@@ -212,7 +220,7 @@ bool DoDocSave(FPDF_DOCUMENT document,
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_SaveAsCopy(FPDF_DOCUMENT document,
                                                     FPDF_FILEWRITE* file_write,
                                                     FPDF_DWORD flags) {
-  return DoDocSave(document, file_write, flags, {});
+  return DoDocSave(document, file_write, flags, {}, /*thread_count=*/1);
 }
 
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
@@ -220,5 +228,31 @@ FPDF_SaveWithVersion(FPDF_DOCUMENT document,
                      FPDF_FILEWRITE* file_write,
                      FPDF_DWORD flags,
                      int fileVersion) {
-  return DoDocSave(document, file_write, flags, fileVersion);
+  return DoDocSave(document, file_write, flags, fileVersion,
+                   /*thread_count=*/1);
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SaveWithVersionParallel(FPDF_DOCUMENT document,
+                             FPDF_FILEWRITE* file_write,
+                             FPDF_DWORD flags,
+                             int fileVersion,
+                             int thread_count) {
+  return DoDocSave(document, file_write, flags, fileVersion, thread_count);
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SaveParseCache(FPDF_DOCUMENT document, FPDF_FILEWRITE* file_write) {
+  CPDF_Document* doc = CPDFDocumentFromFPDFDocument(document);
+  if (!doc || !file_write) {
+    return false;
+  }
+
+  std::unique_ptr<CPDF_ParseCache> cache = doc->CreateParseCache();
+  if (!cache) {
+    return false;
+  }
+
+  auto adapter = pdfium::MakeRetain<CPDFSDK_FileWriteAdapter>(file_write);
+  return adapter->WriteBlock(cache->Serialize());
 }
@@ -12,6 +12,7 @@
 #include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/span.h"
 #include "public/cpp/fpdf_scopers.h"
+#include "public/fpdf_annot.h"
 #include "public/fpdf_edit.h"
 #include "public/fpdf_ppo.h"
 #include "public/fpdf_save.h"
@@ -30,6 +31,20 @@ using testing::HasSubstr;
 using testing::Not;
 using testing::StartsWith;
 
+namespace {
+
+// Every save generates a new random file identifier. Removes the identifiers
+// from `saved`, so that saves can be compared.
+std::string RemoveFileIds(std::string saved) {
+  for (size_t start = saved.find("/ID["); start != std::string::npos;
+       start = saved.find("/ID[", start)) {
+    saved.erase(start, saved.find(']', start) + 1 - start);
+  }
+  return saved;
+}
+
+}  // namespace
+
 class FPDFSaveEmbedderTest : public EmbedderTest {};
 
 TEST_F(FPDFSaveEmbedderTest, SaveSimpleDoc) {
@@ -65,9 +80,8 @@ TEST_F(FPDFSaveEmbedderTest, SaveSimpleDocIncremental) {
   EXPECT_TRUE(FPDF_SaveWithVersion(document(), this, FPDF_INCREMENTAL, 14));
   // Version gets taken as-is from input document.
   EXPECT_THAT(GetString(), StartsWith("%PDF-1.7\n%\xa0\xf2\xa4\xf4"));
-  // Additional output produced vs. non incremental.
-  // Check that the size is larger than the old, broken incremental save size.
-  EXPECT_GT(GetString().size(), 985u);
+  // Nothing changed, so nothing gets appended.
+  EXPECT_EQ(840u, GetString().size());
 }
 
 TEST_F(FPDFSaveEmbedderTest, SaveSimpleDocNoIncremental) {
@@ -182,6 +196,95 @@ TEST_F(FPDFSaveEmbedderTest, SaveLinearizedDoc) {
   }
 }
 
+TEST_F(FPDFSaveEmbedderTest, SaveWithCompressedObjects) {
+  const int kPageCount = 3;
+  std::array<std::string, kPageCount> original_md5;
+
+  ASSERT_TRUE(OpenDocument("linearized.pdf"));
+  for (int i = 0; i < kPageCount; ++i) {
+    ScopedPage page = LoadScopedPage(i);
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+    original_md5[i] = HashBitmap(bitmap.get());
+  }
+
+  EXPECT_TRUE(FPDF_SaveAsCopy(document(), this, 0));
+  const size_t uncompressed_size = GetString().size();
+
+  ClearString();
+  EXPECT_TRUE(FPDF_SaveAsCopy(document(), this, FPDF_COMPRESS_OBJECTS));
+  EXPECT_THAT(GetString(), StartsWith("%PDF-1.6\r\n"));
+  EXPECT_THAT(GetString(), HasSubstr("/Type/ObjStm"));
+  EXPECT_THAT(GetString(), HasSubstr("/Type/XRef"));
+  EXPECT_THAT(GetString(), Not(HasSubstr("\r\nxref\r\n")));
+  EXPECT_THAT(GetString(), Not(HasSubstr("trailer")));
+  EXPECT_LT(GetString().size(), uncompressed_size);
+
+  // Make sure new document renders the same as the old one.
+  ScopedSavedDoc saved_document = OpenScopedSavedDocument();
+  ASSERT_TRUE(saved_document);
+  EXPECT_EQ(kPageCount, FPDF_GetPageCount(saved_document.get()));
+  for (int i = 0; i < kPageCount; ++i) {
+    ScopedSavedPage page = LoadScopedSavedPage(i);
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderSavedPage(page.get());
+    EXPECT_EQ(original_md5[i], HashBitmap(bitmap.get()));
+  }
+}
+
+TEST_F(FPDFSaveEmbedderTest, SaveWithCompressedObjectsRaisesVersion) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  EXPECT_TRUE(
+      FPDF_SaveWithVersion(document(), this, FPDF_COMPRESS_OBJECTS, 14));
+  EXPECT_THAT(GetString(), StartsWith("%PDF-1.5\r\n"));
+  EXPECT_THAT(GetString(), HasSubstr("/Type/ObjStm"));
+
+  ScopedSavedDoc saved_document = OpenScopedSavedDocument();
+  ASSERT_TRUE(saved_document);
+  ScopedSavedPage page = LoadScopedSavedPage(0);
+  ASSERT_TRUE(page);
+  ScopedFPDFBitmap bitmap = RenderSavedPage(page.get());
+  CompareBitmapWithExpectationSuffix(bitmap.get(), pdfium::kHelloWorldPng);
+}
+
+TEST_F(FPDFSaveEmbedderTest, SaveIncrementalIgnoresCompressedObjects) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  EXPECT_TRUE(FPDF_SaveAsCopy(document(), this,
+                              FPDF_INCREMENTAL | FPDF_COMPRESS_OBJECTS));
+  EXPECT_THAT(GetString(), StartsWith("%PDF-1.7\n"));
+  EXPECT_THAT(GetString(), Not(HasSubstr("/ObjStm")));
+}
+
+TEST_F(FPDFSaveEmbedderTest, SaveInParallel) {
+  ASSERT_TRUE(OpenDocument("linearized.pdf"));
+  for (FPDF_DWORD flags : {0, FPDF_COMPRESS_OBJECTS}) {
+    ClearString();
+    EXPECT_TRUE(FPDF_SaveWithVersion(document(), this, flags, 0));
+    const std::string serial = RemoveFileIds(GetString());
+
+    for (int thread_count : {-1, 1, 2, 4}) {
+      ClearString();
+      EXPECT_TRUE(FPDF_SaveWithVersionParallel(document(), this, flags, 0,
+                                               thread_count));
+      EXPECT_EQ(serial, RemoveFileIds(GetString()));
+    }
+  }
+}
+
+TEST_F(FPDFSaveEmbedderTest, SaveEncryptedInParallel) {
+  // RC4 encryption is deterministic, so the streams encrypted on worker
+  // threads match the serial save.
+  ASSERT_TRUE(OpenDocumentWithPassword("encrypted_hello_world_r3.pdf",
+                                       "\xe2"
+                                       "ge"));
+  EXPECT_TRUE(FPDF_SaveWithVersion(document(), this, 0, 0));
+  const std::string serial = RemoveFileIds(GetString());
+
+  ClearString();
+  EXPECT_TRUE(FPDF_SaveWithVersionParallel(document(), this, 0, 0, 4));
+  EXPECT_EQ(serial, RemoveFileIds(GetString()));
+}
+
 TEST_F(FPDFSaveEmbedderTest, Bug1409) {
   ASSERT_TRUE(OpenDocument("jpx_lzw.pdf"));
   ScopedPage page = LoadScopedPage(0);
@@ -218,6 +321,19 @@ TEST_F(FPDFSaveEmbedderTest, SaveXFADoc) {
   ASSERT_TRUE(saved_document);
   // TODO(tsepez): check for XFA forms in document
 }
+
+TEST_F(FPDFSaveEmbedderTest, SaveXFADocIncremental) {
+  ASSERT_TRUE(OpenDocument("xfa_datasets.pdf"));
+  EXPECT_TRUE(FPDF_SaveAsCopy(document(), this, FPDF_INCREMENTAL));
+
+  // Saving replaces the data of the existing datasets stream, object 10, with
+  // the current form data, so it has to be appended.
+  ASSERT_GT(GetString().size(), 6080u);
+  const std::string appended = GetString().substr(6080);
+  EXPECT_THAT(appended, HasSubstr("10 0 obj"));
+  ScopedSavedDoc saved_document = OpenScopedSavedDocument();
+  ASSERT_TRUE(saved_document);
+}
 #endif  // PDF_ENABLE_XFA
 
 TEST_F(FPDFSaveEmbedderTest, Bug342) {
@@ -316,6 +432,35 @@ TEST_F(FPDFSaveEmbedderTest, IncrementalSaveWithModifications) {
   EXPECT_EQ(1, count_text_objects(saved_page.get()));
 }
 
+TEST_F(FPDFSaveEmbedderTest, IncrementalSaveWritesOnlyChangedObjects) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  {
+    ScopedPage page = LoadScopedPage(0);
+    ASSERT_TRUE(page);
+    ScopedFPDFAnnotation annot(
+        FPDFPage_CreateAnnot(page.get(), FPDF_ANNOT_SQUARE));
+    ASSERT_TRUE(annot);
+  }
+  ASSERT_TRUE(FPDF_SaveAsCopy(document(), this, FPDF_INCREMENTAL));
+
+  // Only the page, which holds the new annotation, gets appended. The catalog,
+  // the page tree and the unchanged page contents and fonts do not.
+  ASSERT_GT(GetString().size(), 840u);
+  const std::string appended = GetString().substr(840);
+  EXPECT_THAT(appended, HasSubstr("/Type/Page"));
+  EXPECT_THAT(appended, HasSubstr("/Subtype/Square"));
+  EXPECT_THAT(appended, Not(HasSubstr("/Type/Catalog")));
+  EXPECT_THAT(appended, Not(HasSubstr("/Kids")));
+  EXPECT_THAT(appended, Not(HasSubstr("/Type/Font")));
+  EXPECT_THAT(appended, Not(HasSubstr("stream")));
+
+  ScopedSavedDoc saved_doc = OpenScopedSavedDocument();
+  ASSERT_TRUE(saved_doc);
+  ScopedSavedPage saved_page = LoadScopedSavedPage(0);
+  ASSERT_TRUE(saved_page);
+  EXPECT_EQ(1, FPDFPage_GetAnnotCount(saved_page.get()));
+}
+
 class FPDFSaveWithFontSubsetEmbedderTest : public FPDFSaveEmbedderTest {
  public:
   static constexpr char kSaveNewTextFilename[] = "save_new_text";
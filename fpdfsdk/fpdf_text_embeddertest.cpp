@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <math.h>
+
 #include <algorithm>
 #include <array>
 #include <string>
@@ -9,6 +11,7 @@
 #include <vector>
 
 #include "build/build_config.h"
+#include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/notreached.h"
 #include "core/fxge/fx_font.h"
 #include "public/cpp/fpdf_scopers.h"
@@ -76,6 +79,119 @@ int GetRotatedText90FirstCharIndexForQuadrant(int quadrant) {
   }
 }
 
+struct CharForTesting {
+  CFX_FloatRect box;
+  float origin_y;
+  unsigned int unicode;
+};
+
+std::vector<CharForTesting> GetCharsForTesting(FPDF_TEXTPAGE textpage) {
+  std::vector<CharForTesting> chars;
+  const int count = FPDFText_CountChars(textpage);
+  for (int i = 0; i < count; ++i) {
+    double left;
+    double right;
+    double bottom;
+    double top;
+    double x;
+    double y;
+    EXPECT_TRUE(FPDFText_GetCharBox(textpage, i, &left, &right, &bottom, &top));
+    EXPECT_TRUE(FPDFText_GetCharOrigin(textpage, i, &x, &y));
+    chars.push_back({CFX_FloatRect(left, bottom, right, top),
+                     static_cast<float>(y), FPDFText_GetUnicode(textpage, i)});
+  }
+  return chars;
+}
+
+// Checks every character, like CPDF_TextPage::GetIndexAtPos() did before it
+// used a spatial index.
+int GetCharIndexAtPosSlowly(const std::vector<CharForTesting>& chars,
+                            const CFX_PointF& point,
+                            const CFX_SizeF& tolerance) {
+  int near_pos = -1;
+  double xdif = 5000;
+  double ydif = 5000;
+  for (size_t pos = 0; pos < chars.size(); ++pos) {
+    if (chars[pos].box.Contains(point)) {
+      return static_cast<int>(pos);
+    }
+    if (tolerance.width <= 0 && tolerance.height <= 0) {
+      continue;
+    }
+    CFX_FloatRect charrect = chars[pos].box;
+    charrect.Normalize();
+    CFX_FloatRect char_rect_ext(charrect.left - tolerance.width / 2,
+                                charrect.bottom - tolerance.height / 2,
+                                charrect.right + tolerance.width / 2,
+                                charrect.top + tolerance.height / 2);
+    if (!char_rect_ext.Contains(point)) {
+      continue;
+    }
+    double current_xdiff = std::min(fabs(point.x - charrect.left),
+                                    fabs(point.x - charrect.right));
+    double current_ydiff = std::min(fabs(point.y - charrect.bottom),
+                                    fabs(point.y - charrect.top));
+    if (current_ydiff + current_xdiff < xdif + ydif) {
+      xdif = current_xdiff;
+      ydif = current_ydiff;
+      near_pos = static_cast<int>(pos);
+    }
+  }
+  return near_pos;
+}
+
+// Checks every character, like CPDF_TextPage::GetTextByRect() did before it
+// used a spatial index.
+std::vector<unsigned short> GetBoundedTextSlowly(
+    const std::vector<CharForTesting>& chars,
+    const CFX_FloatRect& rect) {
+  float posy = 0;
+  bool contains_prev_char = false;
+  bool add_line_feed = false;
+  std::vector<unsigned short> text;
+  for (const CharForTesting& c : chars) {
+    CFX_FloatRect intersection = rect;
+    intersection.Intersect(c.box);
+    if (!intersection.IsEmpty()) {
+      if (fabs(posy - c.origin_y) > 0 && !contains_prev_char &&
+          add_line_feed) {
+        posy = c.origin_y;
+        if (!text.empty()) {
+          text.push_back('\r');
+          text.push_back('\n');
+        }
+      }
+      contains_prev_char = true;
+      add_line_feed = false;
+      if (c.unicode) {
+        text.push_back(static_cast<unsigned short>(c.unicode));
+      }
+    } else if (c.unicode == ' ') {
+      if (contains_prev_char) {
+        text.push_back(' ');
+        contains_prev_char = false;
+        add_line_feed = false;
+      }
+    } else {
+      contains_prev_char = false;
+      add_line_feed = true;
+    }
+  }
+  return text;
+}
+
+std::vector<unsigned short> GetBoundedText(FPDF_TEXTPAGE textpage,
+                                           const CFX_FloatRect& rect) {
+  const int length =
+      FPDFText_GetBoundedText(textpage, rect.left, rect.top, rect.right,
+                              rect.bottom, nullptr, 0);
+  std::vector<unsigned short> text(length + 1);
+  FPDFText_GetBoundedText(textpage, rect.left, rect.top, rect.right,
+                          rect.bottom, text.data(), length + 1);
+  text.resize(length);
+  return text;
+}
+
 }  // namespace
 
 class FPDFTextEmbedderTest : public EmbedderTest {};
@@ -250,6 +366,60 @@ TEST_F(FPDFTextEmbedderTest, Text) {
   EXPECT_EQ(0xbdbd, buffer[10]);
 }
 
+TEST_F(FPDFTextEmbedderTest, HitTestingMatchesLinearScan) {
+  static constexpr const char* kFiles[] = {
+      "hello_world.pdf",
+      "rotated_text.pdf",
+      "weblinks.pdf",
+  };
+  static constexpr CFX_SizeF kTolerances[] = {
+      {0, 0}, {5, 5}, {20, 0}, {-4, 10}};
+  static constexpr float kStep = 7;
+
+  for (const char* file : kFiles) {
+    ASSERT_TRUE(OpenDocument(file));
+    {
+      ScopedPage page = LoadScopedPage(0);
+      ASSERT_TRUE(page);
+      ScopedFPDFTextPage textpage(FPDFText_LoadPage(page.get()));
+      ASSERT_TRUE(textpage);
+
+      const std::vector<CharForTesting> chars =
+          GetCharsForTesting(textpage.get());
+      ASSERT_FALSE(chars.empty());
+      const float width = FPDF_GetPageWidthF(page.get());
+      const float height = FPDF_GetPageHeightF(page.get());
+      for (float y = 0; y < height; y += kStep) {
+        for (float x = 0; x < width; x += kStep) {
+          for (const CFX_SizeF& tolerance : kTolerances) {
+            EXPECT_EQ(GetCharIndexAtPosSlowly(chars, {x, y}, tolerance),
+                      FPDFText_GetCharIndexAtPos(textpage.get(), x, y,
+                                                 tolerance.width,
+                                                 tolerance.height))
+                << file << " at " << x << ", " << y;
+          }
+          const CFX_FloatRect rect(x, y, x + 10 * kStep, y + 2 * kStep);
+          const std::vector<unsigned short> expected =
+              GetBoundedTextSlowly(chars, rect);
+          EXPECT_EQ(expected, GetBoundedText(textpage.get(), rect))
+              << file << " at " << x << ", " << y;
+          // Callers may pass the bounds in either order.
+          const CFX_FloatRect inverted(rect.right, rect.top, rect.left,
+                                       rect.bottom);
+          EXPECT_EQ(expected, GetBoundedText(textpage.get(), inverted))
+              << file << " at " << x << ", " << y << " inverted";
+        }
+      }
+      for (const CharForTesting& c : chars) {
+        CFX_FloatRect line(0, c.box.bottom, width, c.box.top);
+        EXPECT_EQ(GetBoundedTextSlowly(chars, line),
+                  GetBoundedText(textpage.get(), line));
+      }
+    }
+    CloseDocument();
+  }
+}
+
 TEST_F(FPDFTextEmbedderTest, TextVertical) {
   ASSERT_TRUE(OpenDocument("vertical_text.pdf"));
   ScopedPage page = LoadScopedPage(0);
@@ -22,6 +22,7 @@
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_parse_cache.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
@@ -33,7 +34,10 @@
 #include "core/fpdfdoc/cpdf_nametree.h"
 #include "core/fpdfdoc/cpdf_viewerpreferences.h"
 #include "core/fxcodec/fx_codec.h"
+#include "core/fxcodec/jbig2/jbig2_symbol_dict_cache.h"
+#include "core/fxcrt/cfx_cachebudget.h"
 #include "core/fxcrt/cfx_fileaccess_stream.h"
+#include "core/fxcrt/cfx_read_only_container_stream.h"
 #include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/cfx_timer.h"
 #include "core/fxcrt/check_op.h"
@@ -102,6 +106,23 @@ static_assert(
     FPDF_PRINTMODE_POSTSCRIPT3_TYPE42_PASSTHROUGH);
 #endif  // BUILDFLAG(IS_WIN)
 
+static_assert(static_cast<int>(CFX_CacheBudget::CacheType::kPageImage) ==
+              FPDF_CACHETYPE_PAGE_IMAGE);
+static_assert(static_cast<int>(CFX_CacheBudget::CacheType::kGlyph) ==
+              FPDF_CACHETYPE_GLYPH);
+static_assert(static_cast<int>(CFX_CacheBudget::CacheType::kType3Glyph) ==
+              FPDF_CACHETYPE_TYPE3_GLYPH);
+static_assert(static_cast<int>(CFX_CacheBudget::CacheType::kFont) ==
+              FPDF_CACHETYPE_FONT);
+static_assert(static_cast<int>(CFX_CacheBudget::CacheType::kColorSpace) ==
+              FPDF_CACHETYPE_COLORSPACE);
+static_assert(static_cast<int>(CFX_CacheBudget::CacheType::kIccProfile) ==
+              FPDF_CACHETYPE_ICC_PROFILE);
+static_assert(static_cast<int>(CFX_CacheBudget::CacheType::kJBig2SymbolDict) ==
+              FPDF_CACHETYPE_JBIG2_SYMBOL_DICT);
+static_assert(CFX_CacheBudget::kCacheTypeCount ==
+              FPDF_CACHETYPE_JBIG2_SYMBOL_DICT + 1);
+
 #if defined(PDF_USE_SKIA)
 // These checks are here because core/ and public/ cannot depend on each other.
 static_assert(static_cast<int>(CFX_GEModule::RendererType::kAgg) ==
@@ -170,7 +191,12 @@ std::vector<XFAPacket> GetXFAPackets(RetainPtr<const CPDF_Object> xfa_object) {
 }
 
 FPDF_DOCUMENT LoadDocumentImpl(RetainPtr<IFX_SeekableReadStream> pFileAccess,
-                               FPDF_BYTESTRING password) {
+                               FPDF_BYTESTRING password,
+                               std::unique_ptr<CPDF_ParseCache> parse_cache,
+                               FPDF_BOOL* parse_cache_used) {
+  if (parse_cache_used) {
+    *parse_cache_used = false;
+  }
   if (!pFileAccess) {
     ProcessParseError(CPDF_Parser::FILE_ERROR);
     return nullptr;
@@ -180,17 +206,25 @@ FPDF_DOCUMENT LoadDocumentImpl(RetainPtr<IFX_SeekableReadStream> pFileAccess,
       std::make_unique<CPDF_Document>(std::make_unique<CPDF_DocRenderData>(),
                                       std::make_unique<CPDF_DocPageData>());
 
-  CPDF_Parser::Error error =
-      document->LoadDoc(std::move(pFileAccess), password);
+  CPDF_Parser::Error error = document->LoadDocWithParseCache(
+      std::move(pFileAccess), password, std::move(parse_cache));
   if (error != CPDF_Parser::SUCCESS) {
     ProcessParseError(error);
     return nullptr;
   }
 
+  if (parse_cache_used) {
+    *parse_cache_used = !!document->GetParser()->GetUsedParseCache();
+  }
   ReportUnsupportedFeatures(document.get());
   return FPDFDocumentFromCPDFDocument(document.release());
 }
 
+FPDF_DOCUMENT LoadDocumentImpl(RetainPtr<IFX_SeekableReadStream> pFileAccess,
+                               FPDF_BYTESTRING password) {
+  return LoadDocumentImpl(std::move(pFileAccess), password, nullptr, nullptr);
+}
+
 }  // namespace
 
 FPDF_EXPORT void FPDF_CALLCONV FPDF_InitLibrary() {
@@ -203,6 +237,8 @@ FPDF_InitLibraryWithConfig(const FPDF_LIBRARY_CONFIG* config) {
     return;
   }
   CFX_Timer::InitializeGlobals();
+  CFX_CacheBudget::Create();
+  CJBig2_SymbolDictCache::Create();
 
   CFX_GEModule::RendererType renderer_type =
       CFX_GEModule::RendererType::kDefault;
@@ -281,6 +317,8 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_DestroyLibrary() {
 
   pdfium::DestroyPageModule();
   CFX_GEModule::Destroy();
+  CJBig2_SymbolDictCache::Destroy();
+  CFX_CacheBudget::Destroy();
   CFX_Timer::DestroyGlobals();
 
   g_bLibraryInitialized = false;
@@ -303,6 +341,28 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_SetPrintMode(int mode) {
 }
 #endif  // BUILDFLAG(IS_WIN)
 
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetCacheMemoryLimit(size_t limit) {
+  CFX_CacheBudget* budget = CFX_CacheBudget::Get();
+  budget->SetLimit(limit);
+  budget->ReleaseSharedEvictions();
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetCacheStats(FPDF_CACHE_TYPE cache_type, FPDF_CACHE_STATS* stats) {
+  if (!stats || cache_type < FPDF_CACHETYPE_PAGE_IMAGE ||
+      cache_type > FPDF_CACHETYPE_JBIG2_SYMBOL_DICT) {
+    return false;
+  }
+
+  CFX_CacheBudget::Stats budget_stats = CFX_CacheBudget::Get()->GetStats(
+      static_cast<CFX_CacheBudget::CacheType>(cache_type));
+  stats->hits = budget_stats.hits;
+  stats->misses = budget_stats.misses;
+  stats->evictions = budget_stats.evictions;
+  stats->bytes = budget_stats.bytes;
+  return true;
+}
+
 FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
 FPDF_LoadDocument(FPDF_STRING file_path, FPDF_BYTESTRING password) {
   // NOTE: the creation of the file needs to be by the embedder on the
@@ -311,6 +371,38 @@ FPDF_LoadDocument(FPDF_STRING file_path, FPDF_BYTESTRING password) {
                           password);
 }
 
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentMapped(FPDF_STRING file_path, FPDF_BYTESTRING password) {
+#if BUILDFLAG(IS_POSIX)
+  std::unique_ptr<MappedDataBytes> mapping = MappedDataBytes::Create(file_path);
+  if (!mapping) {
+    ProcessParseError(CPDF_Parser::FILE_ERROR);
+    return nullptr;
+  }
+  return LoadDocumentImpl(
+      pdfium::MakeRetain<CFX_ReadOnlyMappedDataBytesStream>(std::move(mapping)),
+      password);
+#else
+  return FPDF_LoadDocument(file_path, password);
+#endif  // BUILDFLAG(IS_POSIX)
+}
+
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentWithParseCache(FPDF_STRING file_path,
+                                FPDF_BYTESTRING password,
+                                const void* cache_buf,
+                                unsigned long cache_size,
+                                FPDF_BOOL* cache_used) {
+  std::unique_ptr<CPDF_ParseCache> parse_cache;
+  if (cache_buf) {
+    // SAFETY: required from caller.
+    parse_cache = CPDF_ParseCache::Deserialize(UNSAFE_BUFFERS(
+        pdfium::span(static_cast<const uint8_t*>(cache_buf), cache_size)));
+  }
+  return LoadDocumentImpl(CFX_FileAccessStream::CreateFromFilename(file_path),
+                          password, std::move(parse_cache), cache_used);
+}
+
 FPDF_EXPORT int FPDF_CALLCONV FPDF_GetFormType(FPDF_DOCUMENT document) {
   const CPDF_Document* doc = CPDFDocumentFromFPDFDocument(document);
   if (!doc) {
@@ -795,6 +887,42 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPageBitmap(FPDF_BITMAP bitmap,
                                 /*pause=*/nullptr);
 }
 
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_RenderPageBitmapParallel(FPDF_BITMAP bitmap,
+                              FPDF_PAGE page,
+                              int start_x,
+                              int start_y,
+                              int size_x,
+                              int size_y,
+                              int rotate,
+                              int flags,
+                              int thread_count) {
+  if (thread_count <= 1) {
+    FPDF_RenderPageBitmap(bitmap, page, start_x, start_y, size_x, size_y,
+                          rotate, flags);
+    return;
+  }
+
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!pPage) {
+    return;
+  }
+
+  RetainPtr<CFX_DIBitmap> pBitmap(CFXDIBitmapFromFPDFBitmap(bitmap));
+  if (!pBitmap) {
+    return;
+  }
+  ValidateBitmapPremultiplyState(pBitmap);
+
+#if defined(PDF_USE_SKIA)
+  CFX_DIBitmap::ScopedPremultiplier scoped_premultiplier(pBitmap);
+#endif
+  CPDFSDK_RenderPageInParallel(pPage, std::move(pBitmap),
+                               !!(flags & FPDF_REVERSE_BYTE_ORDER), start_x,
+                               start_y, size_x, size_y, rotate, flags,
+                               static_cast<size_t>(thread_count));
+}
+
 FPDF_EXPORT void FPDF_CALLCONV
 FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
                                 FPDF_PAGE page,
@@ -889,7 +1017,15 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_ClosePage(FPDF_PAGE page) {
   // This will delete the PageView object corresponding to |pPage|. We must
   // cleanup the PageView before releasing the reference on |pPage| as it will
   // attempt to reset the PageView during destruction.
-  pPage->AsPDFPage()->ClearView();
+  CPDF_Page* pdf_page = pPage->AsPDFPage();
+  pdf_page->ClearView();
+
+  // Drop the cache entries flagged for eviction while the document was in
+  // use, in case it is not used again for a while.
+  CPDF_Document* doc = pdf_page->GetDocument();
+  pPage.Reset();
+  CPDF_DocPageData::FromDocument(doc)->ReleaseEvictedObjects();
+  CFX_CacheBudget::Get()->ReleaseSharedEvictions();
 }
 
 FPDF_EXPORT void FPDF_CALLCONV FPDF_CloseDocument(FPDF_DOCUMENT document) {
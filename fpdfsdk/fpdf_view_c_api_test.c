@@ -254,6 +254,7 @@ int CheckPDFiumCApi() {
     CHK(FPDFPage_Delete);
     CHK(FPDFPage_GenerateContent);
     CHK(FPDFPage_GetObject);
+    CHK(FPDFPage_GetObjectsInRect);
     CHK(FPDFPage_GetRotation);
     CHK(FPDFPage_HasTransparency);
     CHK(FPDFPage_InsertObject);
@@ -359,9 +360,11 @@ int CheckPDFiumCApi() {
     // fpdf_ppo.h
     CHK(FPDF_CloseXObject);
     CHK(FPDF_CopyViewerPreferences);
+    CHK(FPDF_DeduplicateObjects);
     CHK(FPDF_ImportNPagesToOne);
     CHK(FPDF_ImportPages);
     CHK(FPDF_ImportPagesByIndex);
+    CHK(FPDF_ImportPagesFromDocuments);
     CHK(FPDF_NewFormObjectFromXObject);
     CHK(FPDF_NewXObjectFromPage);
 
@@ -373,7 +376,9 @@ int CheckPDFiumCApi() {
 
     // fpdf_save.h
     CHK(FPDF_SaveAsCopy);
+    CHK(FPDF_SaveParseCache);
     CHK(FPDF_SaveWithVersion);
+    CHK(FPDF_SaveWithVersionParallel);
 
     // fpdf_searchex.h
     CHK(FPDFText_GetCharIndexFromTextIndex);
@@ -520,6 +525,7 @@ int CheckPDFiumCApi() {
 #ifdef PDF_ENABLE_V8
     CHK(FPDF_GetArrayBufferAllocatorSharedInstance);
 #endif
+    CHK(FPDF_GetCacheStats);
     CHK(FPDF_GetDocPermissions);
     CHK(FPDF_GetDocUserPermissions);
     CHK(FPDF_GetFileVersion);
@@ -546,6 +552,8 @@ int CheckPDFiumCApi() {
     CHK(FPDF_InitLibraryWithConfig);
     CHK(FPDF_LoadCustomDocument);
     CHK(FPDF_LoadDocument);
+    CHK(FPDF_LoadDocumentMapped);
+    CHK(FPDF_LoadDocumentWithParseCache);
     CHK(FPDF_LoadMemDocument);
     CHK(FPDF_LoadMemDocument64);
     CHK(FPDF_LoadPage);
@@ -554,10 +562,12 @@ int CheckPDFiumCApi() {
     CHK(FPDF_RenderPage);
 #endif
     CHK(FPDF_RenderPageBitmap);
+    CHK(FPDF_RenderPageBitmapParallel);
     CHK(FPDF_RenderPageBitmapWithMatrix);
 #if defined(PDF_USE_SKIA)
     CHK(FPDF_RenderPageSkia);
 #endif
+    CHK(FPDF_SetCacheMemoryLimit);
 #if defined(_WIN32)
     CHK(FPDF_SetPrintMode);
 #endif
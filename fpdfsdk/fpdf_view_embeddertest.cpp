@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -18,6 +19,7 @@
 #include "fpdfsdk/cpdfsdk_helpers.h"
 #include "fpdfsdk/fpdf_view_c_api_test.h"
 #include "public/cpp/fpdf_scopers.h"
+#include "public/fpdf_save.h"
 #include "public/fpdfview.h"
 #include "testing/embedder_test.h"
 #include "testing/embedder_test_constants.h"
@@ -548,12 +550,298 @@ TEST_F(FPDFViewEmbedderTest, LoadDocument64) {
   EXPECT_EQ(14, version);
 }
 
+// Races in the process-wide caches rarely change the output, so run this under
+// ThreadSanitizer when touching them. See the "Thread Sanitizer" section of
+// README.md.
+TEST_F(FPDFViewEmbedderTest, RenderDocumentsOnSeparateThreads) {
+  static constexpr const char* kFiles[] = {
+      "hello_world.pdf",
+      "rectangles.pdf",
+      "embedded_images.pdf",
+      "text_render_mode.pdf",
+  };
+  static constexpr int kThreadsPerFile = 4;
+  static constexpr int kIterations = 8;
+
+  std::vector<std::vector<uint8_t>> file_contents;
+  for (const char* file : kFiles) {
+    std::string file_path = PathService::GetTestFilePath(file);
+    ASSERT_FALSE(file_path.empty());
+    file_contents.push_back(GetFileContents(file_path.c_str()));
+    ASSERT_FALSE(file_contents.back().empty());
+  }
+
+  // Each thread owns its document; only process-wide state is shared.
+  auto render_first_page = [](const std::vector<uint8_t>& contents) {
+    ScopedFPDFDocument doc(
+        FPDF_LoadMemDocument64(contents.data(), contents.size(), nullptr));
+    if (!doc) {
+      return std::string();
+    }
+    ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+    if (!page) {
+      return std::string();
+    }
+    ScopedFPDFBitmap bitmap = RenderPage(page.get());
+    return HashBitmap(bitmap.get());
+  };
+
+  std::vector<std::string> expected_hashes;
+  for (const auto& contents : file_contents) {
+    expected_hashes.push_back(render_first_page(contents));
+    ASSERT_FALSE(expected_hashes.back().empty());
+  }
+
+  std::vector<std::vector<std::string>> actual_hashes(
+      std::size(kFiles) * kThreadsPerFile);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < actual_hashes.size(); ++i) {
+    threads.emplace_back([&, i] {
+      const auto& contents = file_contents[i % std::size(kFiles)];
+      for (int j = 0; j < kIterations; ++j) {
+        actual_hashes[i].push_back(render_first_page(contents));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < actual_hashes.size(); ++i) {
+    for (const std::string& hash : actual_hashes[i]) {
+      EXPECT_EQ(expected_hashes[i % std::size(kFiles)], hash);
+    }
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, RenderPageBitmapParallel) {
+  static constexpr const char* kFiles[] = {
+      "hello_world.pdf",
+      "rectangles.pdf",
+      "embedded_images.pdf",
+      "annotation_stamp_with_ap.pdf",
+  };
+  static constexpr int kFlags[] = {0, FPDF_ANNOT, FPDF_ANNOT | FPDF_LCD_TEXT};
+  static constexpr int kRotations[] = {0, 3};
+  static constexpr int kThreadCounts[] = {1, 2, 4, 7};
+
+  auto render = [](FPDF_PAGE page, int width, int height, int rotate,
+                   int flags, int thread_count) {
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(width, height, 0));
+    FPDFBitmap_FillRect(bitmap.get(), 0, 0, width, height, 0xFFFFFFFF);
+    if (thread_count == 0) {
+      FPDF_RenderPageBitmap(bitmap.get(), page, 0, 0, width, height, rotate,
+                            flags);
+    } else {
+      FPDF_RenderPageBitmapParallel(bitmap.get(), page, 0, 0, width, height,
+                                    rotate, flags, thread_count);
+    }
+    return HashBitmap(bitmap.get());
+  };
+
+  for (const char* file : kFiles) {
+    ASSERT_TRUE(OpenDocument(file));
+    {
+      ScopedPage page = LoadScopedPage(0);
+      ASSERT_TRUE(page);
+
+      // Scale up so that the page gets split into several bands.
+      const int width = static_cast<int>(FPDF_GetPageWidthF(page.get())) * 2;
+      const int height = static_cast<int>(FPDF_GetPageHeightF(page.get())) * 2;
+      for (int flags : kFlags) {
+        for (int rotate : kRotations) {
+          const std::string expected_hash =
+              render(page.get(), width, height, rotate, flags,
+                     /*thread_count=*/0);
+          for (int thread_count : kThreadCounts) {
+            EXPECT_EQ(expected_hash, render(page.get(), width, height, rotate,
+                                            flags, thread_count))
+                << file << " flags " << flags << " rotate " << rotate
+                << " threads " << thread_count;
+          }
+        }
+      }
+    }
+    CloseDocument();
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, GetCacheStats) {
+  FPDF_CACHE_STATS stats;
+  EXPECT_FALSE(FPDF_GetCacheStats(FPDF_CACHETYPE_GLYPH, nullptr));
+  EXPECT_FALSE(FPDF_GetCacheStats(static_cast<FPDF_CACHE_TYPE>(-1), &stats));
+  EXPECT_FALSE(FPDF_GetCacheStats(static_cast<FPDF_CACHE_TYPE>(7), &stats));
+
+  // Counters are process-wide, so only look at how they change.
+  FPDF_CACHE_STATS glyphs_before;
+  ASSERT_TRUE(FPDF_GetCacheStats(FPDF_CACHETYPE_GLYPH, &glyphs_before));
+  FPDF_CACHE_STATS fonts_before;
+  ASSERT_TRUE(FPDF_GetCacheStats(FPDF_CACHETYPE_FONT, &fonts_before));
+
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  ScopedPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+  ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+
+  FPDF_CACHE_STATS glyphs_after_first;
+  ASSERT_TRUE(FPDF_GetCacheStats(FPDF_CACHETYPE_GLYPH, &glyphs_after_first));
+  EXPECT_GT(glyphs_after_first.misses, glyphs_before.misses);
+  EXPECT_GT(glyphs_after_first.bytes, 0u);
+  ASSERT_TRUE(FPDF_GetCacheStats(FPDF_CACHETYPE_FONT, &stats));
+  EXPECT_GT(stats.misses, fonts_before.misses);
+  EXPECT_GT(stats.bytes, 0u);
+
+  // Rendering again finds all glyphs in the cache.
+  bitmap = RenderLoadedPage(page.get());
+  ASSERT_TRUE(FPDF_GetCacheStats(FPDF_CACHETYPE_GLYPH, &stats));
+  EXPECT_EQ(glyphs_after_first.misses, stats.misses);
+  EXPECT_GT(stats.hits, glyphs_after_first.hits);
+}
+
+TEST_F(FPDFViewEmbedderTest, SetCacheMemoryLimit) {
+  ASSERT_TRUE(OpenDocument("embedded_images.pdf"));
+  ScopedPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+  const std::string expected_hash =
+      HashBitmap(RenderLoadedPage(page.get()).get());
+
+  FPDF_CACHE_STATS images_before;
+  ASSERT_TRUE(FPDF_GetCacheStats(FPDF_CACHETYPE_PAGE_IMAGE, &images_before));
+  EXPECT_GT(images_before.bytes, 0u);
+
+  // With a tiny limit, every cached image gets evicted, so the images are
+  // decoded again. The output must not change.
+  FPDF_SetCacheMemoryLimit(1);
+  ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+  FPDF_SetCacheMemoryLimit(0);
+  EXPECT_EQ(expected_hash, HashBitmap(bitmap.get()));
+
+  FPDF_CACHE_STATS images_after;
+  ASSERT_TRUE(FPDF_GetCacheStats(FPDF_CACHETYPE_PAGE_IMAGE, &images_after));
+  EXPECT_GT(images_after.evictions, images_before.evictions);
+  EXPECT_GT(images_after.misses, images_before.misses);
+}
+
 TEST_F(FPDFViewEmbedderTest, LoadNonexistentDocument) {
   FPDF_DOCUMENT doc = FPDF_LoadDocument("nonexistent_document.pdf", "");
   ASSERT_FALSE(doc);
   EXPECT_EQ(static_cast<int>(FPDF_GetLastError()), FPDF_ERR_FILE);
 }
 
+TEST_F(FPDFViewEmbedderTest, LoadDocumentMapped) {
+  {
+    ScopedFPDFDocument doc(
+        FPDF_LoadDocumentMapped("nonexistent_document.pdf", ""));
+    ASSERT_FALSE(doc);
+    EXPECT_EQ(static_cast<int>(FPDF_GetLastError()), FPDF_ERR_FILE);
+  }
+
+  for (const char* file :
+       {"hello_world.pdf", "embedded_images.pdf", "rectangles.pdf"}) {
+    std::string file_path = PathService::GetTestFilePath(file);
+    ASSERT_FALSE(file_path.empty());
+    ScopedFPDFDocument doc(FPDF_LoadDocument(file_path.c_str(), ""));
+    ASSERT_TRUE(doc);
+    ScopedFPDFDocument mapped_doc(
+        FPDF_LoadDocumentMapped(file_path.c_str(), ""));
+    ASSERT_TRUE(mapped_doc);
+
+    const int page_count = FPDF_GetPageCount(doc.get());
+    ASSERT_EQ(page_count, FPDF_GetPageCount(mapped_doc.get()));
+    for (int i = 0; i < page_count; ++i) {
+      ScopedFPDFPage page(FPDF_LoadPage(doc.get(), i));
+      ASSERT_TRUE(page);
+      ScopedFPDFPage mapped_page(FPDF_LoadPage(mapped_doc.get(), i));
+      ASSERT_TRUE(mapped_page);
+      ScopedFPDFBitmap bitmap = RenderPage(page.get());
+      ScopedFPDFBitmap mapped_bitmap = RenderPage(mapped_page.get());
+      EXPECT_EQ(HashBitmap(bitmap.get()), HashBitmap(mapped_bitmap.get()))
+          << file << " page " << i;
+    }
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, LoadDocumentWithParseCache) {
+  std::string other_cache;
+  for (const char* file :
+       {"hello_world.pdf", "embedded_images.pdf", "page_labels.pdf"}) {
+    std::string file_path = PathService::GetTestFilePath(file);
+    ASSERT_FALSE(file_path.empty());
+    ScopedFPDFDocument doc(FPDF_LoadDocument(file_path.c_str(), ""));
+    ASSERT_TRUE(doc);
+    ClearString();
+    ASSERT_TRUE(FPDF_SaveParseCache(doc.get(), this));
+    const std::string cache = GetString();
+    ASSERT_FALSE(cache.empty());
+
+    FPDF_BOOL cache_used = false;
+    ScopedFPDFDocument cached_doc(FPDF_LoadDocumentWithParseCache(
+        file_path.c_str(), "", cache.data(), cache.size(), &cache_used));
+    ASSERT_TRUE(cached_doc);
+    EXPECT_TRUE(cache_used) << file;
+
+    const int page_count = FPDF_GetPageCount(doc.get());
+    ASSERT_EQ(page_count, FPDF_GetPageCount(cached_doc.get()));
+    for (int i = 0; i < page_count; ++i) {
+      ScopedFPDFPage page(FPDF_LoadPage(doc.get(), i));
+      ASSERT_TRUE(page);
+      ScopedFPDFPage cached_page(FPDF_LoadPage(cached_doc.get(), i));
+      ASSERT_TRUE(cached_page);
+      ScopedFPDFBitmap bitmap = RenderPage(page.get());
+      ScopedFPDFBitmap cached_bitmap = RenderPage(cached_page.get());
+      EXPECT_EQ(HashBitmap(bitmap.get()), HashBitmap(cached_bitmap.get()))
+          << file << " page " << i;
+    }
+
+    // A cache for another file is ignored.
+    if (!other_cache.empty()) {
+      cache_used = true;
+      ScopedFPDFDocument other_doc(
+          FPDF_LoadDocumentWithParseCache(file_path.c_str(), "",
+                                          other_cache.data(),
+                                          other_cache.size(), &cache_used));
+      ASSERT_TRUE(other_doc);
+      EXPECT_FALSE(cache_used) << file;
+      EXPECT_EQ(page_count, FPDF_GetPageCount(other_doc.get()));
+    }
+    other_cache = cache;
+  }
+
+  {
+    // An invalid cache is ignored.
+    static constexpr char kGarbage[] = "not a parse cache";
+    std::string file_path = PathService::GetTestFilePath("hello_world.pdf");
+    FPDF_BOOL cache_used = true;
+    ScopedFPDFDocument doc(FPDF_LoadDocumentWithParseCache(
+        file_path.c_str(), "", kGarbage, sizeof(kGarbage), &cache_used));
+    ASSERT_TRUE(doc);
+    EXPECT_FALSE(cache_used);
+
+    // So is a missing one.
+    cache_used = true;
+    ScopedFPDFDocument doc_without_cache(FPDF_LoadDocumentWithParseCache(
+        file_path.c_str(), "", nullptr, 0, &cache_used));
+    ASSERT_TRUE(doc_without_cache);
+    EXPECT_FALSE(cache_used);
+  }
+
+  {
+    FPDF_BOOL cache_used = true;
+    ScopedFPDFDocument doc(FPDF_LoadDocumentWithParseCache(
+        "nonexistent_document.pdf", "", nullptr, 0, &cache_used));
+    ASSERT_FALSE(doc);
+    EXPECT_EQ(static_cast<int>(FPDF_GetLastError()), FPDF_ERR_FILE);
+    EXPECT_FALSE(cache_used);
+  }
+
+  {
+    // New documents have no parsed structure to cache.
+    ScopedFPDFDocument new_doc(FPDF_CreateNewDocument());
+    ASSERT_TRUE(new_doc);
+    EXPECT_FALSE(FPDF_SaveParseCache(new_doc.get(), this));
+  }
+}
+
 TEST_F(FPDFViewEmbedderTest, DocumentWithNoPageCount) {
   ASSERT_TRUE(OpenDocument("no_page_count.pdf"));
   ASSERT_EQ(6, FPDF_GetPageCount(document()));
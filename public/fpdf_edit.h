@@ -242,6 +242,28 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFPage_CountObjects(FPDF_PAGE page);
 FPDF_EXPORT FPDF_PAGEOBJECT FPDF_CALLCONV FPDFPage_GetObject(FPDF_PAGE page,
                                                              int index);
 
+// Experimental API.
+// Get the active page objects in |page| whose bounds intersect |rect|.
+//
+//   page        - handle to a page.
+//   rect        - the area to search, in page coordinates. To find the objects
+//                 under a point, pass a rect with zero width and height.
+//   objects     - buffer for the page object handles, or NULL. Handles are
+//                 written in the same order as FPDFPage_GetObject() returns
+//                 them, i.e. from back to front.
+//   max_objects - number of handles |objects| can hold.
+//
+// Returns the number of matching objects, which may be larger than
+// |max_objects|, or -1 on failure. Bounds are as returned by
+// FPDFPageObj_GetBounds(); objects that touch |rect| count as intersecting.
+// Pages with many objects build a spatial index on first use, which is kept
+// until objects on |page| are added, removed or transformed.
+FPDF_EXPORT int FPDF_CALLCONV
+FPDFPage_GetObjectsInRect(FPDF_PAGE page,
+                          const FS_RECTF* rect,
+                          FPDF_PAGEOBJECT* objects,
+                          int max_objects);
+
 // Checks if |page| contains transparency.
 //
 //   page - handle to a page.
@@ -51,6 +51,41 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_ImportPages(FPDF_DOCUMENT dest_doc,
                                                      FPDF_BYTESTRING pagerange,
                                                      int index);
 
+// Experimental API.
+// Pages to import with FPDF_ImportPagesFromDocuments().
+typedef struct _FPDF_IMPORT_PAGES_SOURCE {
+  // The document to import pages from.
+  FPDF_DOCUMENT src_doc;
+  // An array of page indices to import. The first page is zero. If NULL, all
+  // pages from |src_doc| are imported.
+  const int* page_indices;
+  // The length of the |page_indices| array.
+  unsigned long length;
+} FPDF_IMPORT_PAGES_SOURCE;
+
+// Experimental API.
+// Import pages from several documents to a FPDF_DOCUMENT in one call.
+//
+//   dest_doc - The destination document for the pages.
+//   sources  - An array of the pages to import, in the order to insert them.
+//              The same document may appear more than once.
+//   count    - The length of the |sources| array.
+//   index    - The page index at which to insert the first imported page into
+//              |dest_doc|. The first page is zero.
+//
+// Unlike calling FPDF_ImportPagesByIndex() once per entry of |sources|, objects
+// that pages from the same source document share, such as fonts and images,
+// are copied into |dest_doc| only once, even if the pages come from different
+// entries.
+//
+// Returns TRUE on success. Returns FALSE if any entry of |sources| is invalid,
+// in which case no pages are imported, or if importing fails.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_ImportPagesFromDocuments(FPDF_DOCUMENT dest_doc,
+                              const FPDF_IMPORT_PAGES_SOURCE* sources,
+                              unsigned long count,
+                              int index);
+
 // Experimental API.
 // Create a new document from |src_doc|.  The pages of |src_doc| will be
 // combined to provide |num_pages_on_x_axis x num_pages_on_y_axis| pages per
@@ -109,6 +144,23 @@ FPDF_NewFormObjectFromXObject(FPDF_XOBJECT xobject);
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
 FPDF_CopyViewerPreferences(FPDF_DOCUMENT dest_doc, FPDF_DOCUMENT src_doc);
 
+// Experimental API.
+// Merge identical objects in |document| into one. Importing pages from several
+// documents copies the images, ICC profiles and embedded fonts of each source
+// document separately, even when they are the same. Streams with the same
+// dictionary and data, and fonts that use the same font files, become a single
+// object that all pages refer to. Best called after importing pages and before
+// saving.
+//
+//   document    - The document to merge objects in.
+//   bytes_saved - If not NULL, receives the size of the removed objects, an
+//                 estimate of how many bytes smaller |document| becomes once
+//                 saved.
+//
+// Returns the number of objects removed, or -1 if |document| is invalid.
+FPDF_EXPORT int FPDF_CALLCONV
+FPDF_DeduplicateObjects(FPDF_DOCUMENT document, unsigned long* bytes_saved);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -52,6 +52,10 @@ typedef struct FPDF_FILEWRITE_ {
 // Experimental. Subsets any embedded font files for new text objects added to
 // the document.
 #define FPDF_SUBSET_NEW_FONTS (1 << 3)
+// Experimental. Writes non-stream objects into compressed object streams, and
+// the cross reference table as a cross reference stream. This raises the file
+// version to at least 1.5. Ignored for incremental saves.
+#define FPDF_COMPRESS_OBJECTS (1 << 4)
 
 // Function: FPDF_SaveAsCopy
 //          Saves the copy of specified document in custom way.
@@ -86,6 +90,54 @@ FPDF_SaveWithVersion(FPDF_DOCUMENT document,
                      FPDF_DWORD flags,
                      int file_version);
 
+// Experimental API.
+// Function: FPDF_SaveWithVersionParallel
+//          Same as FPDF_SaveWithVersion(), except that stream data is
+//          compressed and encrypted on worker threads while the calling
+//          thread writes the file. The saved document is byte-for-byte the
+//          same as the one FPDF_SaveWithVersion() writes.
+// Parameters:
+//          document        -   Handle to document.
+//          file_write      -   A pointer to a custom file write structure.
+//          flags           -   The creating flags.
+//          file_version    -   The PDF file version. File version: 14 for 1.4,
+//                              15 for 1.5, ...
+//          thread_count    -   Maximum number of threads to use, including
+//                              the calling thread. Values of 1 or less save
+//                              on the calling thread only. Values above the
+//                              number of hardware threads, or above 64, are
+//                              reduced to that.
+// Return value:
+//          TRUE if succeed, FALSE if failed.
+//
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SaveWithVersionParallel(FPDF_DOCUMENT document,
+                             FPDF_FILEWRITE* file_write,
+                             FPDF_DWORD flags,
+                             int file_version,
+                             int thread_count);
+
+// Experimental API.
+// Function: FPDF_SaveParseCache
+//          Saves the structure of a loaded document, to speed up loading the
+//          same file again with FPDF_LoadDocumentWithParseCache().
+// Parameters:
+//          document        -   Handle to document, as returned by
+//                              FPDF_LoadDocument() or a similar function.
+//          file_write      -   A pointer to a custom file write structure,
+//                              which receives the cache data.
+// Return value:
+//          TRUE if the cache was written, FALSE if the document's structure
+//          cannot be cached. That is the case for new documents, documents
+//          loaded with FPDFAvail_GetDocument(), and damaged files whose cross
+//          reference table had to be rebuilt.
+// Comments:
+//          The cache describes the file as loaded. It includes the position of
+//          every page, so call this before inserting, deleting or moving pages.
+//          The cache is only useful together with the same, unmodified file.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SaveParseCache(FPDF_DOCUMENT document, FPDF_FILEWRITE* file_write);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,6 +12,14 @@
 // from a single thread. Barring that, embedders are required to ensure (via
 // a mutex or similar) that only a single PDFium call can be made at a time.
 //
+// The one exception is rendering independent documents: once the library is
+// initialized, separate FPDF_DOCUMENTs may be loaded, rendered and closed on
+// separate threads concurrently, provided that each document, and every
+// handle obtained from it, is only used by one thread at a time. Library
+// initialization, FPDF_DestroyLibrary(), FPDF_SetSystemFontInfo() and other
+// process-wide settings must still not race with any other call. Form fill
+// environments and JavaScript are not covered.
+//
 // NOTE: External docs refer to this file as "fpdfview.h", so do not rename
 // despite lack of consistency with other public files.
 
@@ -395,6 +403,74 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_SetSandBoxPolicy(FPDF_DWORD policy,
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_SetPrintMode(int mode);
 #endif  // defined(_WIN32)
 
+// Caches of decoded data - Experimental.
+// See FPDF_SetCacheMemoryLimit() and FPDF_GetCacheStats().
+typedef enum {
+  // Decoded image bitmaps, per page.
+  FPDF_CACHETYPE_PAGE_IMAGE = 0,
+  // Rendered glyph bitmaps, per font face. Shared by all documents.
+  FPDF_CACHETYPE_GLYPH = 1,
+  // Rendered Type 3 glyph bitmaps, while a text object is rendered.
+  FPDF_CACHETYPE_TYPE3_GLYPH = 2,
+  // Parsed fonts, per document.
+  FPDF_CACHETYPE_FONT = 3,
+  // Parsed colorspaces, per document.
+  FPDF_CACHETYPE_COLORSPACE = 4,
+  // Parsed ICC profiles, per document.
+  FPDF_CACHETYPE_ICC_PROFILE = 5,
+  // Decoded JBIG2 symbol dictionaries from /JBIG2Globals streams, keyed by the
+  // stream contents. Shared by all documents.
+  FPDF_CACHETYPE_JBIG2_SYMBOL_DICT = 6,
+} FPDF_CACHE_TYPE;
+
+// Counters for one cache type - Experimental.
+typedef struct FPDF_CACHE_STATS_ {
+  // Number of lookups that found an entry.
+  unsigned long long hits;
+  // Number of lookups that had to decode or parse the data.
+  unsigned long long misses;
+  // Number of entries dropped to stay within the memory limit.
+  unsigned long long evictions;
+  // Estimated number of bytes the cache currently holds.
+  unsigned long long bytes;
+} FPDF_CACHE_STATS;
+
+// Experimental API.
+// Function: FPDF_SetCacheMemoryLimit
+//          Set the amount of memory all caches of decoded data may use
+//          together.
+// Parameters:
+//          limit - the limit in bytes, or 0 for no limit, which is the
+//                  default.
+// Return value:
+//          None.
+// Comments:
+//          When the caches go over the limit, the least recently used entries
+//          across all documents and caches are flagged for eviction. The caches
+//          of a document free their flagged entries the next time they are
+//          used, or when a page of the document is closed. The caches shared
+//          by all documents also free them when FPDF_ClosePage() or this
+//          function is called. Until then, the flagged entries still use
+//          memory, so usage stays over the limit while a document with
+//          flagged entries is open but not used. Type 3 glyphs count towards
+//          the limit but are never evicted.
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetCacheMemoryLimit(size_t limit);
+
+// Experimental API.
+// Function: FPDF_GetCacheStats
+//          Get the counters for one type of cache.
+// Parameters:
+//          cache_type - one of the FPDF_CACHE_TYPE values.
+//          stats      - receives the counters.
+// Return value:
+//          True if successful, false if |cache_type| is invalid or |stats| is
+//          NULL.
+// Comments:
+//          Counters are process-wide and cover all documents since the process
+//          started.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetCacheStats(FPDF_CACHE_TYPE cache_type, FPDF_CACHE_STATS* stats);
+
 // Function: FPDF_LoadDocument
 //          Open and load a PDF document.
 // Parameters:
@@ -419,6 +495,67 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_SetPrintMode(int mode);
 FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
 FPDF_LoadDocument(FPDF_STRING file_path, FPDF_BYTESTRING password);
 
+// Experimental API.
+// Function: FPDF_LoadDocumentMapped
+//          Open and load a PDF document by mapping the file into memory.
+// Parameters:
+//          file_path -  Path to the PDF file (including extension).
+//          password  -  A string used as the password for the PDF file.
+//                       If no password is needed, empty or NULL can be used.
+// Return value:
+//          A handle to the loaded document, or NULL on failure.
+// Comments:
+//          Behaves like FPDF_LoadDocument(), but parses the document directly
+//          from the mapped file, and stream data that needs no decoding is
+//          used in place instead of being copied. This saves memory for large
+//          documents.
+//
+//          The file must not be modified or truncated while the document is
+//          open. Doing so may crash the process.
+//
+//          Memory mapping is only used on POSIX platforms. Elsewhere, this
+//          function is equivalent to FPDF_LoadDocument().
+//
+//          See the comments for FPDF_LoadDocument() regarding the encodings
+//          of |file_path| and |password|.
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentMapped(FPDF_STRING file_path, FPDF_BYTESTRING password);
+
+// Experimental API.
+// Function: FPDF_LoadDocumentWithParseCache
+//          Open and load a PDF document, reusing the structure saved by
+//          FPDF_SaveParseCache() for an earlier load of the same file.
+// Parameters:
+//          file_path   -  Path to the PDF file (including extension).
+//          password    -  A string used as the password for the PDF file.
+//                         If no password is needed, empty or NULL can be used.
+//          cache_buf   -  The data written by FPDF_SaveParseCache(). May be
+//                         NULL if no cache is available.
+//          cache_size  -  Size in bytes of |cache_buf|.
+//          cache_used  -  Receives whether the cache was used. May be NULL.
+// Return value:
+//          A handle to the loaded document, or NULL on failure.
+// Comments:
+//          Behaves like FPDF_LoadDocument(), but takes the merged cross
+//          reference table, the object stream offsets and the page list from
+//          the cache, instead of reading every cross reference section and
+//          walking the page tree. This makes reopening large documents faster.
+//
+//          The cache is only used if the file's size, last cross reference
+//          offset and /ID still match, and its first cross reference entry
+//          still points at the right object. Otherwise, the document is loaded
+//          as usual, and |cache_used| receives false. Call
+//          FPDF_SaveParseCache() again to replace a cache that was not used.
+//
+//          See the comments for FPDF_LoadDocument() regarding the encodings
+//          of |file_path| and |password|.
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentWithParseCache(FPDF_STRING file_path,
+                                FPDF_BYTESTRING password,
+                                const void* cache_buf,
+                                unsigned long cache_size,
+                                FPDF_BOOL* cache_used);
+
 // Function: FPDF_LoadMemDocument
 //          Open and load a PDF document from memory.
 // Parameters:
@@ -934,6 +1071,41 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPageBitmap(FPDF_BITMAP bitmap,
                                                      int rotate,
                                                      int flags);
 
+// Experimental API.
+// Function: FPDF_RenderPageBitmapParallel
+//          Render contents of a page to a device independent bitmap, using
+//          multiple threads.
+// Parameters:
+//          bitmap       -  Same as FPDF_RenderPageBitmap().
+//          page         -  Same as FPDF_RenderPageBitmap().
+//          start_x      -  Same as FPDF_RenderPageBitmap().
+//          start_y      -  Same as FPDF_RenderPageBitmap().
+//          size_x       -  Same as FPDF_RenderPageBitmap().
+//          size_y       -  Same as FPDF_RenderPageBitmap().
+//          rotate       -  Same as FPDF_RenderPageBitmap().
+//          flags        -  Same as FPDF_RenderPageBitmap().
+//          thread_count -  Maximum number of threads to render with, including
+//                          the calling thread. Values of 1 or less render on
+//                          the calling thread only.
+// Return value:
+//          None.
+// Comments:
+//          The output is identical to that of FPDF_RenderPageBitmap(). The
+//          display area is split into horizontal bands that are rendered
+//          concurrently. The call returns once all bands are done. Do not call
+//          other functions on the page's document while this call is in
+//          progress.
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_RenderPageBitmapParallel(FPDF_BITMAP bitmap,
+                              FPDF_PAGE page,
+                              int start_x,
+                              int start_y,
+                              int size_x,
+                              int size_y,
+                              int rotate,
+                              int flags,
+                              int thread_count);
+
 // Function: FPDF_RenderPageBitmapWithMatrix
 //          Render contents of a page to a device independent bitmap.
 // Parameters:
@@ -0,0 +1,81 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "core/fxcodec/flate/flate_predictor.h"
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/compiler_specific.h"
+#include "core/fxcrt/span.h"
+
+// Checks that undoing PNG and TIFF predictors, which uses SIMD code where it
+// can, gives the same results as the scalar code.
+
+namespace {
+
+constexpr size_t kMaxRowSize = 4096;
+
+void CheckPngRows(pdfium::span<const uint8_t> data,
+                  size_t row_size,
+                  uint32_t bytes_per_pixel) {
+  // Each row starts with its filter type. The last row may be partial.
+  std::vector<uint8_t> last;
+  while (data.size() > 1) {
+    const size_t size = std::min(row_size, data.size() - 1);
+    pdfium::span<const uint8_t> src = data.first(size + 1);
+    std::vector<uint8_t> expected(size);
+    fxcodec::PNG_PredictLineScalar(expected, src, last, size, bytes_per_pixel);
+    std::vector<uint8_t> actual(size);
+    fxcodec::PNG_PredictLine(actual, src, last, size, bytes_per_pixel);
+    CHECK(expected == actual);
+    last = std::move(actual);
+    data = data.subspan(size + 1);
+  }
+}
+
+void CheckTiffRows(pdfium::span<const uint8_t> data,
+                   size_t row_size,
+                   int colors) {
+  while (!data.empty()) {
+    pdfium::span<const uint8_t> row =
+        data.first(std::min(row_size, data.size()));
+    std::vector<uint8_t> expected(row.begin(), row.end());
+    fxcodec::TIFF_PredictLineScalar(expected, /*BitsPerComponent=*/8, colors,
+                                    /*Columns=*/0);
+    std::vector<uint8_t> actual(row.begin(), row.end());
+    fxcodec::TIFF_PredictLine(actual, /*BitsPerComponent=*/8, colors,
+                              /*Columns=*/0);
+    CHECK(expected == actual);
+    data = data.subspan(row.size());
+  }
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  // SAFETY: trusted arguments passed from fuzzer.
+  auto data_span = UNSAFE_BUFFERS(pdfium::span(data, size));
+
+  // The first byte picks the predictor and pixel size, and the next two the
+  // row size.
+  if (data_span.size() < 3) {
+    return 0;
+  }
+  const bool tiff = data_span[0] & 0x80;
+  const uint32_t bytes_per_pixel = (data_span[0] & 7) + 1;
+  const size_t row_size =
+      ((data_span[1] << 8) | data_span[2]) % kMaxRowSize + 1;
+  pdfium::span<const uint8_t> rows = data_span.subspan(3u);
+  if (tiff) {
+    CheckTiffRows(rows, row_size, static_cast<int>(bytes_per_pixel));
+  } else {
+    CheckPngRows(rows, row_size, bytes_per_pixel);
+  }
+  return 0;
+}
@@ -2,17 +2,60 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <math.h>
 #include <stdint.h>
 
+#include <memory>
+
 #include "core/fpdfapi/page/cpdf_psengine.h"
+#include "core/fpdfapi/page/cpdf_psprogram.h"
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/check_op.h"
 #include "core/fxcrt/compiler_specific.h"
 #include "core/fxcrt/span.h"
 
+namespace {
+
+constexpr uint32_t kInputs = 2;
+constexpr uint32_t kOutputs = 2;
+
+// Checks that the compiled program, if there is one, gives the same results as
+// the interpreter.
+void CheckProgram(CPDF_PSEngine& engine, const CPDF_PSProgram& program) {
+  static constexpr float kInputValues[][kInputs] = {
+      {0, 0}, {0.25f, 1}, {1, 0.5f}, {-3, 7.5f}};
+  for (const auto& inputs : kInputValues) {
+    engine.Reset();
+    for (float input : inputs) {
+      engine.Push(input);
+    }
+    engine.Execute();
+    float results[kOutputs];
+    const bool has_results = engine.GetStackSize() >= kOutputs;
+    CHECK_EQ(has_results, program.Call(inputs, results));
+    if (!has_results) {
+      continue;
+    }
+    for (uint32_t i = kOutputs; i > 0; --i) {
+      const float expected = engine.Pop();
+      CHECK((isnan(expected) && isnan(results[i - 1])) ||
+            expected == results[i - 1]);
+    }
+  }
+}
+
+}  // namespace
+
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
   CPDF_PSEngine engine;
   // SAFETY: required across fuzzer API.
   if (engine.Parse(UNSAFE_BUFFERS(pdfium::span(data, size)))) {
     engine.Execute();
+    std::unique_ptr<CPDF_PSProgram> program =
+        CPDF_PSProgram::Compile(engine.main_proc(), kInputs, kOutputs);
+    if (program) {
+      CheckProgram(engine, *program);
+    }
   }
   return 0;
 }
@@ -6,6 +6,8 @@
 
 #include <limits.h>
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -19,6 +21,8 @@
 #include "public/fpdf_annot.h"
 #include "public/fpdf_attachment.h"
 #include "public/fpdf_edit.h"
+#include "public/fpdf_ppo.h"
+#include "public/fpdf_save.h"
 #include "public/fpdf_thumbnail.h"
 #include "testing/fx_string_testhelpers.h"
 #include "testing/utils/file_util.h"
@@ -282,6 +286,25 @@ std::string WritePng(const char* pdf_name,
   return filename;
 }
 
+// Collects the output of FPDF_SaveAsCopy() in memory, so that the time taken
+// to save does not include the time taken to write the file.
+struct StringFileWrite : public FPDF_FILEWRITE {
+  StringFileWrite() {
+    version = 1;
+    WriteBlock = &StringFileWrite::WriteBlockCallback;
+  }
+
+  static int WriteBlockCallback(FPDF_FILEWRITE* file_write,
+                                const void* data,
+                                unsigned long size) {
+    auto* self = static_cast<StringFileWrite*>(file_write);
+    self->output.append(static_cast<const char*>(data), size);
+    return 1;
+  }
+
+  std::string output;
+};
+
 }  // namespace
 
 std::string WritePpm(const char* pdf_name,
@@ -791,6 +814,81 @@ void WriteAttachments(FPDF_DOCUMENT doc, const std::string& name) {
   }
 }
 
+void WriteCopy(FPDF_DOCUMENT doc,
+               const std::string& name,
+               int save_flags,
+               int thread_count) {
+  std::string save_name = name + ".copy.pdf";
+  StringFileWrite file_write;
+  const auto start = std::chrono::steady_clock::now();
+  const bool saved = FPDF_SaveWithVersionParallel(doc, &file_write, save_flags,
+                                                  0, thread_count);
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  if (!saved) {
+    fprintf(stderr, "Failed to save a copy of %s.\n", name.c_str());
+    return;
+  }
+
+  printf("Saved copy: %zu bytes in %.3f ms\n", file_write.output.size(),
+         elapsed.count());
+  WriteBufferToFile(file_write.output.data(), file_write.output.size(),
+                    save_name.c_str(), "copy");
+}
+
+void WriteMerged(const std::vector<FPDF_DOCUMENT>& docs,
+                 const std::string& name,
+                 bool separately) {
+  std::vector<FPDF_IMPORT_PAGES_SOURCE> sources;
+  std::vector<int> page_indices;
+  for (FPDF_DOCUMENT doc : docs) {
+    page_indices.resize(std::max(page_indices.size(),
+                                 static_cast<size_t>(FPDF_GetPageCount(doc))));
+  }
+  for (size_t i = 0; i < page_indices.size(); ++i) {
+    page_indices[i] = static_cast<int>(i);
+  }
+  for (FPDF_DOCUMENT doc : docs) {
+    for (int i = 0; i < FPDF_GetPageCount(doc); ++i) {
+      sources.push_back({doc, &page_indices[i], 1});
+    }
+  }
+
+  ScopedFPDFDocument merged_doc(FPDF_CreateNewDocument());
+  const auto start = std::chrono::steady_clock::now();
+  bool imported = true;
+  if (separately) {
+    for (size_t i = 0; i < sources.size() && imported; ++i) {
+      imported = FPDF_ImportPagesByIndex(merged_doc.get(), sources[i].src_doc,
+                                         sources[i].page_indices, 1,
+                                         static_cast<int>(i));
+    }
+  } else {
+    imported = FPDF_ImportPagesFromDocuments(merged_doc.get(), sources.data(),
+                                             sources.size(), 0);
+  }
+  const auto imported_time = std::chrono::steady_clock::now();
+  if (!imported) {
+    fprintf(stderr, "Failed to merge %zu documents.\n", docs.size());
+    return;
+  }
+
+  StringFileWrite file_write;
+  if (!FPDF_SaveAsCopy(merged_doc.get(), &file_write, 0)) {
+    fprintf(stderr, "Failed to save the merged document.\n");
+    return;
+  }
+  const std::chrono::duration<double, std::milli> import_elapsed =
+      imported_time - start;
+  const std::chrono::duration<double, std::milli> save_elapsed =
+      std::chrono::steady_clock::now() - imported_time;
+  printf("Merged %zu pages: %zu bytes, %.3f ms to import, %.3f ms to save\n",
+         sources.size(), file_write.output.size(), import_elapsed.count(),
+         save_elapsed.count());
+  WriteBufferToFile(file_write.output.data(), file_write.output.size(),
+                    name.c_str(), "merged document");
+}
+
 void WriteImages(FPDF_PAGE page, const char* pdf_name, int page_num) {
   for (int i = 0; i < FPDFPage_CountObjects(page); ++i) {
     FPDF_PAGEOBJECT obj = FPDFPage_GetObject(page, i);
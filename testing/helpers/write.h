@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "public/fpdfview.h"
 
@@ -62,6 +63,19 @@ std::string WriteSkp(const char* pdf_name, int num, const SkPicture& picture);
 #endif  // PDF_ENABLE_SKIA
 
 void WriteAttachments(FPDF_DOCUMENT doc, const std::string& name);
+// Saves a copy of `doc` with `save_flags` on up to `thread_count` threads as
+// <name>.copy.pdf, and prints its size and the time taken to save it.
+void WriteCopy(FPDF_DOCUMENT doc,
+               const std::string& name,
+               int save_flags,
+               int thread_count);
+// Imports every page of `docs` into a new document and saves it as `name`.
+// Uses one FPDF_ImportPagesFromDocuments() call with one entry per page, or one
+// FPDF_ImportPagesByIndex() call per page if `separately`. Prints the number
+// of pages, the size of the result and the time taken to import and save.
+void WriteMerged(const std::vector<FPDF_DOCUMENT>& docs,
+                 const std::string& name,
+                 bool separately);
 void WriteImages(FPDF_PAGE page, const char* pdf_name, int page_num);
 void WriteRenderedImages(FPDF_DOCUMENT doc,
                          FPDF_PAGE page,
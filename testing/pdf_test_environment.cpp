@@ -4,6 +4,8 @@
 
 #include "testing/pdf_test_environment.h"
 
+#include "core/fxcodec/jbig2/jbig2_symbol_dict_cache.h"
+#include "core/fxcrt/cfx_cachebudget.h"
 #include "core/fxcrt/span.h"
 #include "core/fxge/cfx_gemodule.h"
 
@@ -13,6 +15,8 @@ PDFTestEnvironment::~PDFTestEnvironment() = default;
 
 // testing::Environment:
 void PDFTestEnvironment::SetUp() {
+  CFX_CacheBudget::Create();
+  CJBig2_SymbolDictCache::Create();
   CFX_GEModule::Create(test_fonts_.FontPathsSpan(),
                        CFX_GEModule::RendererType::kDefault,
                        CFX_FontMgr::FontBackend::kFreeType);
@@ -20,4 +24,6 @@ void PDFTestEnvironment::SetUp() {
 
 void PDFTestEnvironment::TearDown() {
   CFX_GEModule::Destroy();
+  CJBig2_SymbolDictCache::Destroy();
+  CFX_CacheBudget::Destroy();
 }
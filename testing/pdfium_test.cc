@@ -17,6 +17,7 @@
 #include <optional>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #if defined(PDF_ENABLE_SKIA) && !defined(PDF_USE_SKIA)
@@ -177,11 +178,16 @@ struct Options {
   bool render_premultiplied_alpha = false;
   bool reverse_byte_order = false;
   bool save_attachments = false;
+  bool save_copy = false;
+  int save_copy_flags = 0;
+  int save_threads = 1;
+  bool add_annot = false;
   bool save_images = false;
   bool save_rendered_images = false;
   bool save_thumbnails = false;
   bool save_thumbnails_decoded = false;
   bool save_thumbnails_raw = false;
+  bool merge_separately = false;
   RendererType use_renderer_type = RendererType::kDefault;
 #if defined(PDF_ENABLE_SKIA)
   bool use_fontations_backend = false;
@@ -207,6 +213,7 @@ struct Options {
   bool croscore_font_names = false;
   OutputFormat output_format = OutputFormat::kNone;
   std::string password;
+  std::string merge_path;
   std::string render_repeats_as_string;
   std::string scale_factor_as_string;
   std::string exe_path;
@@ -543,6 +550,8 @@ bool ParseCommandLine(const std::vector<std::string>& args,
       options->reverse_byte_order = true;
     } else if (cur_arg == "--save-attachments") {
       options->save_attachments = true;
+    } else if (cur_arg == "--save-copy") {
+      options->save_copy = true;
     } else if (cur_arg == "--save-images") {
       if (options->save_rendered_images) {
         fprintf(stderr,
@@ -732,6 +741,25 @@ bool ParseCommandLine(const std::vector<std::string>& args,
         return false;
       }
       options->password = value;
+    } else if (ParseSwitchKeyValue(cur_arg, "--save-copy=", &value)) {
+      if (options->save_copy) {
+        fprintf(stderr, "Duplicate --save-copy argument\n");
+        return false;
+      }
+      options->save_copy = true;
+      std::stringstream(value) >> options->save_copy_flags;
+    } else if (ParseSwitchKeyValue(cur_arg, "--save-threads=", &value)) {
+      std::stringstream(value) >> options->save_threads;
+    } else if (cur_arg == "--add-annot") {
+      options->add_annot = true;
+    } else if (ParseSwitchKeyValue(cur_arg, "--merge=", &value)) {
+      if (!options->merge_path.empty()) {
+        fprintf(stderr, "Duplicate --merge argument\n");
+        return false;
+      }
+      options->merge_path = value;
+    } else if (cur_arg == "--merge-separately") {
+      options->merge_separately = true;
     } else if (ParseSwitchKeyValue(cur_arg, "--render-repeats=", &value)) {
       if (!options->render_repeats_as_string.empty()) {
         fprintf(stderr, "Duplicate --render-repeats argument\n");
@@ -841,6 +869,24 @@ void PrintLastError() {
   fprintf(stderr, ".\n");
 }
 
+// Loads every page, as a viewer would before the user edits, and adds a square
+// annotation to the first one.
+void AddAnnotToFirstPage(FPDF_DOCUMENT doc) {
+  const int page_count = FPDF_GetPageCount(doc);
+  for (int i = 0; i < page_count; ++i) {
+    ScopedFPDFPage page(FPDF_LoadPage(doc, i));
+    if (!page || i > 0) {
+      continue;
+    }
+    ScopedFPDFAnnotation annot(
+        FPDFPage_CreateAnnot(page.get(), FPDF_ANNOT_SQUARE));
+    const FS_RECTF rect = {100, 200, 200, 100};
+    if (!annot || !FPDFAnnot_SetRect(annot.get(), &rect)) {
+      fprintf(stderr, "Failed to add an annotation.\n");
+    }
+  }
+}
+
 FPDF_BOOL Is_Data_Avail(FX_FILEAVAIL* avail, size_t offset, size_t size) {
   return true;
 }
@@ -1726,6 +1772,14 @@ void Processor::ProcessPdf(const std::string& name,
     WriteAttachments(doc.get(), name);
   }
 
+  if (options().save_copy) {
+    if (options().add_annot) {
+      AddAnnotToFirstPage(doc.get());
+    }
+    WriteCopy(doc.get(), name, options().save_copy_flags,
+              options().save_threads);
+  }
+
 #ifdef PDF_ENABLE_V8
   IPDF_JSPLATFORM platform_callbacks = {};
   platform_callbacks.version = 3;
@@ -1833,6 +1887,34 @@ void Processor::ProcessPdf(const std::string& name,
   }
 }
 
+// Loads all of `files` and writes all their pages to one document, as
+// requested by --merge.
+void MergePdfs(const Options& options, const std::vector<std::string>& files) {
+  const char* password =
+      options.password.empty() ? nullptr : options.password.c_str();
+  // `docs` must be destroyed before the `file_contents` they were loaded from.
+  std::vector<std::vector<uint8_t>> file_contents;
+  std::vector<ScopedFPDFDocument> docs;
+  std::vector<FPDF_DOCUMENT> doc_handles;
+  for (const std::string& filename : files) {
+    std::vector<uint8_t> contents = GetFileContents(filename.c_str());
+    if (contents.empty()) {
+      continue;
+    }
+    ScopedFPDFDocument doc(
+        FPDF_LoadMemDocument(contents.data(), contents.size(), password));
+    if (!doc) {
+      fprintf(stderr, "Failed to load %s for merging.\n", filename.c_str());
+      continue;
+    }
+    doc_handles.push_back(doc.get());
+    docs.push_back(std::move(doc));
+    file_contents.push_back(std::move(contents));
+  }
+  fprintf(stderr, "Merging %zu PDF files.\n", docs.size());
+  WriteMerged(doc_handles, options.merge_path, options.merge_separately);
+}
+
 void ShowConfig() {
   std::string config;
   [[maybe_unused]] auto append_config = [&config](const char* name) {
@@ -1899,6 +1981,17 @@ constexpr char kUsageString[] =
     "format\n"
     "  --save-attachments     - write embedded attachments "
     "<pdf-name>.attachment.<attachment-name>\n"
+    "  --save-copy            - write a copy saved with FPDF_SaveAsCopy() "
+    "<pdf-name>.copy.pdf\n"
+    "  --save-copy=<flags>    - same as --save-copy, passing <flags> to "
+    "FPDF_SaveAsCopy()\n"
+    "  --save-threads=<n>     - save the copy on up to <n> threads\n"
+    "  --add-annot            - with --save-copy, load every page and add an "
+    "annotation to the first before saving\n"
+    "  --merge=<path>         - write all pages of all files to <path> instead "
+    "of rendering them\n"
+    "  --merge-separately     - with --merge, import one page per "
+    "FPDF_ImportPagesByIndex() call\n"
     "  --save-images          - write raw embedded images "
     "<pdf-name>.<page-number>.<object-number>.png\n"
     "  --save-rendered-images - write embedded images as rendered on the page "
@@ -2135,6 +2228,11 @@ int main(int argc, const char* argv[]) {
     }
 
     Processor processor(&options, &idler);
+    if (!options.merge_path.empty()) {
+      // Merging takes the place of processing the files one by one.
+      MergePdfs(options, files);
+      files.clear();
+    }
     for (const std::string& filename : files) {
       std::vector<uint8_t> file_contents = GetFileContents(filename.c_str());
       if (file_contents.empty()) {
@@ -9,6 +9,7 @@ import os
 import re
 import subprocess
 import sys
+import time
 
 import pdfium_root
 
@@ -132,3 +133,129 @@ def PrintWithTime(s):
 def PrintErr(s):
   """Prints s to stderr."""
   print(s, file=sys.stderr)
+
+
+def AddBuildDirArgument(parser):
+  """Adds the --build-dir argument of the *_benchmark.py scripts."""
+  parser.add_argument(
+      '--build-dir',
+      default=os.path.join('out', 'Release'),
+      help='relative path to the build directory with pdfium_test')
+
+
+def FindPdfiumTest(build_dir, option='--build-dir'):
+  """Returns the path of pdfium_test in `build_dir`, or None if missing.
+
+  `option` is the command line option that names `build_dir`.
+  """
+  path = os.path.join(build_dir, 'pdfium_test')
+  if not os.access(path, os.X_OK):
+    PrintErr("FAILURE: Can't find test executable '%s'" % path)
+    PrintErr('Use %s to specify its location.' % option)
+    return None
+  return path
+
+
+def FindPdfs(directory):
+  """Returns the sorted paths of the PDFs under `directory`."""
+  paths = []
+  for root, _, files in os.walk(directory):
+    for name in files:
+      if name.lower().endswith('.pdf'):
+        paths.append(os.path.join(root, name))
+  return sorted(paths)
+
+
+def MakeStream(data, entries=b''):
+  """Returns the body of a stream object holding `data`.
+
+  `entries` are added to the stream dictionary, before /Length.
+  """
+  if entries:
+    entries += b' '
+  return b'<< %s/Length %d >>\nstream\n%s\nendstream' % (entries, len(data),
+                                                          data)
+
+
+def WritePdf(path, objects):
+  """Writes a PDF with a cross reference table to `path`.
+
+  `objects` yields the object bodies, numbered from 1. Object 1 must be the
+  catalog. Returns the number of objects.
+  """
+  offsets = []
+  with open(path, 'wb') as f:
+    f.write(b'%PDF-1.7\n')
+    for i, body in enumerate(objects):
+      offsets.append(f.tell())
+      f.write(b'%d 0 obj\n%s\nendobj\n' % (i + 1, body))
+    xref_offset = f.tell()
+    f.write(b'xref\n0 %d\n0000000000 65535 f\r\n' % (len(offsets) + 1))
+    f.write(b''.join(b'%010d 00000 n\r\n' % offset for offset in offsets))
+    f.write(b'trailer\n<< /Size %d /Root 1 0 R >>\n' % (len(offsets) + 1))
+    f.write(b'startxref\n%d\n%%%%EOF\n' % xref_offset)
+  return len(offsets)
+
+
+def TimeCommand(cmd, capture_stdout=False):
+  """Runs `cmd` and measures it.
+
+  Returns (seconds, stdout, peak RSS in KiB), where stdout is None unless
+  `capture_stdout` is set, and the peak RSS is None on systems without
+  os.wait4(). Returns None if `cmd` fails.
+  """
+  start = time.monotonic()
+  process = subprocess.Popen(
+      cmd,
+      stdout=subprocess.PIPE if capture_stdout else subprocess.DEVNULL,
+      stderr=subprocess.DEVNULL)
+  stdout = None
+  if capture_stdout:
+    stdout = process.stdout.read()
+    process.stdout.close()
+  peak_kib = None
+  if hasattr(os, 'wait4'):
+    _, status, rusage = os.wait4(process.pid, 0)
+    process.returncode = os.waitstatus_to_exitcode(status)
+    peak_kib = rusage.ru_maxrss
+  else:
+    process.wait()
+  elapsed = time.monotonic() - start
+  if process.returncode != 0:
+    PrintErr('FAILURE: %s exited with %d' % (' '.join(cmd), process.returncode))
+    return None
+  return elapsed, stdout, peak_kib
+
+
+def TimeFastest(cmd, repeats, capture_stdout=False):
+  """Runs `cmd` `repeats` times, and returns TimeCommand() of the fastest run.
+
+  Returns None if any run fails.
+  """
+  fastest = None
+  for _ in range(repeats):
+    result = TimeCommand(cmd, capture_stdout)
+    if result is None:
+      return None
+    if fastest is None or result[0] < fastest[0]:
+      fastest = result
+  return fastest
+
+
+def MeasureRender(pdfium_test_path, pdf_path, repeats, args):
+  """Returns the seconds taken by the fastest of `repeats` pdfium_test runs.
+
+  pdfium_test renders `pdf_path` with the options in `args`. Returns None if
+  any run fails.
+  """
+  result = TimeFastest([pdfium_test_path] + args + [pdf_path], repeats)
+  return None if result is None else result[0]
+
+
+def GetMd5s(pdfium_test_output):
+  """Returns the page MD5s that pdfium_test --md5 printed."""
+  return [
+      line.rsplit(b':', 1)[1].strip()
+      for line in pdfium_test_output.splitlines()
+      if line.startswith(b'MD5:')
+  ]
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+# Copyright 2026 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures dictionary parsing and lookup time.
+
+Renders every page of each given PDF with pdfium_test at a small scale, so
+that rasterization is cheap and the time goes mostly into parsing objects and
+looking up dictionary entries. Pass large real-world documents to measure
+typical workloads.
+
+Also generates a synthetic PDF whose pages share a resource dictionary with
+many entries, and whose content streams look them up over and over.
+"""
+
+import argparse
+import os
+import sys
+import tempfile
+
+from common import (AddBuildDirArgument, FindPdfiumTest, MakeStream,
+                    MeasureRender, PrintErr, WritePdf)
+
+PAGE_SIZE = 200
+
+
+def WriteSyntheticPdf(path, page_count, resource_count, lookups_per_page):
+  """Writes a PDF with `page_count` pages sharing `resource_count` resources.
+
+  Each page's content stream selects a graphics state by name
+  `lookups_per_page` times.
+  """
+  gs_names = [b'GS%d' % i for i in range(resource_count)]
+  ops = []
+  for i in range(lookups_per_page):
+    ops.append(b'/%s gs 0 0 1 1 re f' % gs_names[(i * 7) % resource_count])
+  contents = b'\n'.join(ops)
+
+  # Object 1 is the catalog, 2 the page tree, 3 the resources and 4 the shared
+  # contents. Graphics states and pages follow.
+  objects = [
+      b'<< /Type /Catalog /Pages 2 0 R >>',
+      None,
+      b'<< /ExtGState << %s >> >>' % b' '.join(
+          b'/%s %d 0 R' % (name, 5 + i) for i, name in enumerate(gs_names)),
+      MakeStream(contents),
+  ]
+  for i in range(resource_count):
+    objects.append(b'<< /Type /ExtGState /CA %.3f /ca %.3f /LW %d >>' %
+                   ((i % 100) / 100, (i % 100) / 100, i % 10))
+  first_page = len(objects) + 1
+  for _ in range(page_count):
+    objects.append(b'<< /Type /Page /Parent 2 0 R /MediaBox [0 0 %d %d] '
+                   b'/Resources 3 0 R /Contents 4 0 R >>' %
+                   (PAGE_SIZE, PAGE_SIZE))
+  kids = b' '.join(b'%d 0 R' % (first_page + i) for i in range(page_count))
+  objects[1] = b'<< /Type /Pages /Kids [%s] /Count %d >>' % (kids, page_count)
+  WritePdf(path, objects)
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  parser.add_argument('pdfs', nargs='*', help='PDF files to measure')
+  AddBuildDirArgument(parser)
+  parser.add_argument(
+      '--scale',
+      default='0.05',
+      help='scale passed to pdfium_test. Small values keep rasterization '
+      'cheap')
+  parser.add_argument(
+      '--synthetic-pages',
+      type=int,
+      default=200,
+      help='page count of the synthetic PDF. 0 skips it')
+  parser.add_argument(
+      '--synthetic-resources',
+      type=int,
+      default=500,
+      help='number of entries in the synthetic resource dictionary')
+  parser.add_argument(
+      '--synthetic-lookups',
+      type=int,
+      default=2000,
+      help='number of resource lookups per synthetic page')
+  parser.add_argument(
+      '--repeats',
+      type=int,
+      default=3,
+      help='number of runs per document. The fastest run is reported')
+  args = parser.parse_args()
+
+  pdfium_test_path = FindPdfiumTest(args.build_dir)
+  if not pdfium_test_path:
+    return 1
+  if args.repeats < 1 or args.synthetic_resources < 1:
+    PrintErr('--repeats and --synthetic-resources must be positive.')
+    return 1
+
+  with tempfile.TemporaryDirectory() as temp_dir:
+    pdfs = list(args.pdfs)
+    if args.synthetic_pages > 0:
+      synthetic_path = os.path.join(temp_dir, 'dictionaries.pdf')
+      WriteSyntheticPdf(synthetic_path, args.synthetic_pages,
+                        args.synthetic_resources, args.synthetic_lookups)
+      pdfs.append(synthetic_path)
+    if not pdfs:
+      PrintErr('Nothing to measure.')
+      return 1
+
+    print('%12s  %s' % ('seconds', 'document'))
+    for pdf_path in pdfs:
+      seconds = MeasureRender(pdfium_test_path, pdf_path, args.repeats,
+                              ['--scale=%s' % args.scale])
+      if seconds is None:
+        return 1
+      print('%12.3f  %s' % (seconds, os.path.basename(pdf_path)))
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+# Copyright 2026 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures adding one annotation to a large PDF and saving it incrementally.
+
+Generates a synthetic PDF with four objects per page, a page, its contents, an
+annotation and the annotation's appearance stream, for about a million objects
+by default. pdfium_test --add-annot loads every page, adds a square annotation
+to the first one and saves a copy, once incrementally with FPDF_INCREMENTAL and
+once in full with FPDF_NO_INCREMENTAL. Reports the time each save took, the
+size of each copy and how much the incremental save appended to the original,
+and checks that the first page of both copies renders the same.
+"""
+
+import argparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+from common import (AddBuildDirArgument, FindPdfiumTest, GetMd5s, MakeStream,
+                    PrintErr, WritePdf)
+
+# Flag values from public/fpdf_save.h.
+FPDF_INCREMENTAL = 1 << 0
+FPDF_NO_INCREMENTAL = 1 << 1
+
+SAVED_COPY_RE = re.compile(rb'^Saved copy: (\d+) bytes in ([\d.]+) ms$')
+
+# Object 1 is the catalog and 2 the page tree.
+OBJECTS_PER_PAGE = 4
+APPEARANCE = b'0 0 40 40 re S'
+
+
+def GenerateObjects(page_count):
+  """Yields the objects of a PDF with `page_count` pages."""
+  yield b'<< /Type /Catalog /Pages 2 0 R >>'
+  yield (b'<< /Type /Pages /Kids [%s] /Count %d >>' %
+         (b' '.join(b'%d 0 R' % (3 + OBJECTS_PER_PAGE * i)
+                    for i in range(page_count)), page_count))
+  for i in range(page_count):
+    page = 3 + OBJECTS_PER_PAGE * i
+    yield (b'<< /Type /Page /Parent 2 0 R /MediaBox [0 0 612 792] '
+           b'/Contents %d 0 R /Annots [%d 0 R] >>' % (page + 1, page + 2))
+    yield MakeStream(b'BT /F1 12 Tf 72 720 Td (Page %d) Tj ET' % i)
+    yield (b'<< /Type /Annot /Subtype /Square /Rect [10 10 50 50] '
+           b'/AP << /N %d 0 R >> >>' % (page + 3))
+    yield MakeStream(APPEARANCE,
+                     b'/Type /XObject /Subtype /Form /BBox [0 0 40 40]')
+
+
+def SaveWithAnnot(pdfium_test_path, pdf_path, flags):
+  """Returns the path of the copy, its size and the time to save in ms."""
+  cmd = [
+      pdfium_test_path,
+      '--save-copy=%d' % flags, '--add-annot', '--pages=0', '--scale=0.01',
+      pdf_path
+  ]
+  result = subprocess.run(cmd,
+                          stdout=subprocess.PIPE,
+                          stderr=subprocess.DEVNULL)
+  if result.returncode != 0:
+    PrintErr('FAILURE: %s exited with %d' % (' '.join(cmd), result.returncode))
+    return None
+  for line in result.stdout.splitlines():
+    match = SAVED_COPY_RE.match(line)
+    if match:
+      return (pdf_path + '.copy.pdf', int(match.group(1)),
+              float(match.group(2)))
+  PrintErr('FAILURE: %s did not save a copy' % ' '.join(cmd))
+  return None
+
+
+def GetFirstPageMd5(pdfium_test_path, pdf_path):
+  result = subprocess.run(
+      [pdfium_test_path, '--ppm', '--md5', '--pages=0', pdf_path],
+      stdout=subprocess.PIPE,
+      stderr=subprocess.DEVNULL)
+  md5s = GetMd5s(result.stdout)
+  return md5s[0] if md5s else None
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  AddBuildDirArgument(parser)
+  parser.add_argument(
+      '--pages',
+      type=int,
+      default=250000,
+      help='number of pages, each adding %d objects' % OBJECTS_PER_PAGE)
+  args = parser.parse_args()
+
+  pdfium_test_path = FindPdfiumTest(args.build_dir)
+  if not pdfium_test_path:
+    return 1
+  if args.pages < 1:
+    PrintErr('--pages must be positive.')
+    return 1
+
+  with tempfile.TemporaryDirectory() as temp_dir:
+    original_path = os.path.join(temp_dir, 'original.pdf')
+    object_count = WritePdf(original_path, GenerateObjects(args.pages))
+    original_size = os.path.getsize(original_path)
+    print('%d objects, %d bytes' % (object_count, original_size))
+
+    print('%-12s %12s %12s %10s' % ('save', 'bytes', 'appended', 'save ms'))
+    copies = []
+    for name, flags in (('full', FPDF_NO_INCREMENTAL),
+                        ('incremental', FPDF_INCREMENTAL)):
+      # pdfium_test writes the copy next to the PDF, so work on copies.
+      pdf_path = os.path.join(temp_dir, '%s.pdf' % name)
+      shutil.copyfile(original_path, pdf_path)
+      result = SaveWithAnnot(pdfium_test_path, pdf_path, flags)
+      if result is None:
+        return 1
+      copy_path, size, ms = result
+      appended = ('%d' % (size - original_size)
+                  if flags == FPDF_INCREMENTAL else '-')
+      print('%-12s %12d %12s %10.1f' % (name, size, appended, ms))
+      copies.append(copy_path)
+
+    md5s = [GetFirstPageMd5(pdfium_test_path, path) for path in copies]
+    if md5s[0] is None or md5s[0] != md5s[1]:
+      PrintErr('FAILURE: The first pages of the copies render differently')
+      return 1
+    print('The first pages of both copies render identically.')
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+# Copyright 2026 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures how fast PDFs with JBIG2 images render.
+
+Renders every PDF in a corpus directory that uses JBIG2Decode with pdfium_test,
+and reports the time per file. With --baseline-build-dir, also renders each
+file with the pdfium_test of another build, reports the speedup, and checks
+that both builds produce the same MD5 for every page, so that a change to the
+JBIG2 decoder can be shown to be faster and bit-identical at once.
+"""
+
+import argparse
+import os
+import shutil
+import sys
+import tempfile
+
+from common import (AddBuildDirArgument, FindPdfiumTest, FindPdfs, GetMd5s,
+                    PrintErr, TimeFastest)
+
+
+def FindJbig2Pdfs(corpus_dir):
+  """Returns the paths of the PDFs under `corpus_dir` that use JBIG2Decode."""
+  paths = []
+  for path in FindPdfs(corpus_dir):
+    with open(path, 'rb') as f:
+      if b'JBIG2Decode' in f.read():
+        paths.append(path)
+  return paths
+
+
+def Measure(pdfium_test_path, pdf_path, scale, repeats):
+  """Returns the fastest of `repeats` renderings, and the page MD5s."""
+  cmd = [pdfium_test_path, '--ppm', '--md5', '--scale=%s' % scale, pdf_path]
+  result = TimeFastest(cmd, repeats, capture_stdout=True)
+  if result is None:
+    return None, None
+  seconds, stdout, _ = result
+  return seconds, GetMd5s(stdout)
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  parser.add_argument(
+      'corpus_dir', help='directory to search for PDFs with JBIG2 images')
+  AddBuildDirArgument(parser)
+  parser.add_argument(
+      '--baseline-build-dir',
+      help='build directory of the pdfium_test to compare against')
+  parser.add_argument(
+      '--scale', type=float, default=1, help='scale passed to pdfium_test')
+  parser.add_argument(
+      '--repeats',
+      type=int,
+      default=3,
+      help='number of runs per file. The fastest run is reported')
+  args = parser.parse_args()
+
+  pdfium_test_path = FindPdfiumTest(args.build_dir)
+  if not pdfium_test_path:
+    return 1
+  baseline_path = None
+  if args.baseline_build_dir:
+    baseline_path = FindPdfiumTest(args.baseline_build_dir,
+                                   '--baseline-build-dir')
+    if not baseline_path:
+      return 1
+  if args.repeats < 1 or args.scale <= 0:
+    PrintErr('--repeats and --scale must be positive.')
+    return 1
+
+  pdf_paths = FindJbig2Pdfs(args.corpus_dir)
+  if not pdf_paths:
+    PrintErr('FAILURE: No PDFs with JBIG2 images in %s' % args.corpus_dir)
+    return 1
+
+  if baseline_path:
+    print('%9s  %9s  %7s  %s' % ('baseline', 'seconds', 'speedup', 'file'))
+  else:
+    print('%9s  %s' % ('seconds', 'file'))
+  total = 0
+  baseline_total = 0
+  mismatches = 0
+  with tempfile.TemporaryDirectory() as temp_dir:
+    for pdf_path in pdf_paths:
+      # pdfium_test writes the pages next to the PDF, so render a copy.
+      name = os.path.relpath(pdf_path, args.corpus_dir)
+      copy_path = os.path.join(temp_dir, os.path.basename(pdf_path))
+      shutil.copyfile(pdf_path, copy_path)
+      seconds, md5s = Measure(pdfium_test_path, copy_path, args.scale,
+                              args.repeats)
+      if seconds is None:
+        return 1
+      total += seconds
+      if not baseline_path:
+        print('%9.3f  %s' % (seconds, name))
+        continue
+
+      baseline_seconds, baseline_md5s = Measure(baseline_path, copy_path,
+                                                args.scale, args.repeats)
+      if baseline_seconds is None:
+        return 1
+      baseline_total += baseline_seconds
+      status = ''
+      if md5s != baseline_md5s:
+        mismatches += 1
+        status = '  MISMATCH'
+      print('%9.3f  %9.3f  %6.2fx  %s%s' %
+            (baseline_seconds, seconds, baseline_seconds / seconds, name,
+             status))
+
+  if not baseline_path:
+    print('%9.3f  total' % total)
+    return 0
+
+  print('%9.3f  %9.3f  %6.2fx  total' %
+        (baseline_total, total, baseline_total / total))
+  if mismatches:
+    PrintErr('FAILURE: %d of %d files render differently from the baseline' %
+             (mismatches, len(pdf_paths)))
+    return 1
+  print('All %d files render identically to the baseline.' % len(pdf_paths))
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
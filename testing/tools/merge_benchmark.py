@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+# Copyright 2026 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures merging pages from many documents into one.
+
+Generates the requested number of small synthetic PDFs, whose pages share a
+font and an image, and merges every page of all of them with pdfium_test
+--merge. This imports all pages with a single FPDF_ImportPagesFromDocuments()
+call. With --merge-separately, pdfium_test imports one page per
+FPDF_ImportPagesByIndex() call instead, which copies the shared font and image
+again for every page. Reports the time to import and to save, the size of the
+merged document and the peak resident set size, and checks that the first
+pages of both merged documents render the same.
+
+Unix only, since peak memory comes from the rusage of the child process.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+from common import (AddBuildDirArgument, FindPdfiumTest, GetMd5s, MakeStream,
+                    PrintErr, TimeCommand, WritePdf)
+
+MERGED_RE = re.compile(rb'^Merged (\d+) pages: (\d+) bytes, ([\d.]+) ms to '
+                       rb'import, ([\d.]+) ms to save$')
+
+# Object 1 is the catalog, 2 the page tree, 3 the font and 4 the image. Each
+# page takes two more objects, the page and its contents.
+IMAGE_SIZE = 64
+
+
+def WriteSyntheticPdf(path, doc_index, page_count):
+  image_data = bytes((doc_index + i) % 256 for i in range(IMAGE_SIZE**2))
+  objects = [
+      b'<< /Type /Catalog /Pages 2 0 R >>',
+      b'<< /Type /Pages /Kids [%s] /Count %d >>' %
+      (b' '.join(b'%d 0 R' % (5 + 2 * i) for i in range(page_count)),
+       page_count),
+      b'<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica >>',
+      MakeStream(
+          image_data, b'/Type /XObject /Subtype /Image /Width %d /Height %d '
+          b'/ColorSpace /DeviceGray /BitsPerComponent 8' %
+          (IMAGE_SIZE, IMAGE_SIZE)),
+  ]
+  for i in range(page_count):
+    content = (b'q 100 0 0 100 50 600 cm /Im1 Do Q '
+               b'BT /F1 24 Tf 50 500 Td (Document %d, page %d) Tj ET' %
+               (doc_index, i))
+    objects.append(b'<< /Type /Page /Parent 2 0 R /MediaBox [0 0 612 792] '
+                   b'/Resources << /Font << /F1 3 0 R >> '
+                   b'/XObject << /Im1 4 0 R >> >> /Contents %d 0 R >>' %
+                   (6 + 2 * i))
+    objects.append(MakeStream(content))
+  WritePdf(path, objects)
+
+
+def Merge(pdfium_test_path, pdf_paths, output_path, separately):
+  """Returns (pages, bytes, import ms, save ms, peak RSS in KiB)."""
+  cmd = [pdfium_test_path, '--merge=%s' % output_path]
+  if separately:
+    cmd.append('--merge-separately')
+  result = TimeCommand(cmd + pdf_paths, capture_stdout=True)
+  if result is None:
+    return None
+  _, stdout, peak_kib = result
+  for line in stdout.splitlines():
+    match = MERGED_RE.match(line)
+    if match:
+      return (int(match.group(1)), int(match.group(2)), float(match.group(3)),
+              float(match.group(4)), peak_kib)
+  PrintErr('FAILURE: %s did not merge' % ' '.join(cmd))
+  return None
+
+
+def GetPageMd5s(pdfium_test_path, pdf_path, page_count):
+  result = subprocess.run([
+      pdfium_test_path, '--ppm', '--md5', '--scale=0.25',
+      '--pages=0-%d' % (page_count - 1), pdf_path
+  ],
+                          stdout=subprocess.PIPE,
+                          stderr=subprocess.DEVNULL)
+  if result.returncode != 0:
+    return None
+  return GetMd5s(result.stdout)
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  AddBuildDirArgument(parser)
+  parser.add_argument(
+      '--documents',
+      type=int,
+      default=10000,
+      help='number of documents to merge')
+  parser.add_argument(
+      '--pages', type=int, default=4, help='number of pages per document')
+  parser.add_argument(
+      '--check-pages',
+      type=int,
+      default=20,
+      help='number of merged pages to render and compare')
+  parser.add_argument(
+      '--keep-dir', help='write the generated PDFs here and keep them')
+  args = parser.parse_args()
+
+  pdfium_test_path = FindPdfiumTest(args.build_dir)
+  if not pdfium_test_path:
+    return 1
+  if args.documents < 1 or args.pages < 1:
+    PrintErr('--documents and --pages must be positive.')
+    return 1
+
+  with tempfile.TemporaryDirectory() as temp_dir:
+    out_dir = args.keep_dir or temp_dir
+    os.makedirs(out_dir, exist_ok=True)
+    pdf_paths = []
+    for i in range(args.documents):
+      pdf_path = os.path.join(out_dir, 'merge_%d.pdf' % i)
+      WriteSyntheticPdf(pdf_path, i, args.pages)
+      pdf_paths.append(pdf_path)
+
+    print('%-10s %8s %12s %10s %10s %12s' %
+          ('mode', 'pages', 'bytes', 'import ms', 'save ms', 'peak KiB'))
+    merged_paths = []
+    for separately in (True, False):
+      mode = 'separate' if separately else 'batch'
+      merged_path = os.path.join(temp_dir, 'merged_%s.pdf' % mode)
+      result = Merge(pdfium_test_path, pdf_paths, merged_path, separately)
+      if result is None:
+        return 1
+      print('%-10s %8d %12d %10.1f %10.1f %12d' % ((mode,) + result))
+      merged_paths.append(merged_path)
+
+    check_pages = min(args.check_pages, args.documents * args.pages)
+    md5s = [
+        GetPageMd5s(pdfium_test_path, path, check_pages)
+        for path in merged_paths
+    ]
+    if md5s[0] is None or md5s[0] != md5s[1]:
+      PrintErr('FAILURE: The merged documents render differently')
+      return 1
+    print('The first %d pages of both merged documents render identically.' %
+          check_pages)
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
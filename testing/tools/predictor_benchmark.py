@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+# Copyright 2026 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures the throughput of undoing FlateDecode predictors.
+
+Generates synthetic PDFs, each with one page showing a large image that is
+encoded with one PNG or TIFF predictor, for 1, 3 and 4 bytes per pixel.
+Renders each with pdfium_test at a small scale, so that the time goes mostly
+into decoding the image, and reports megabytes of image data per second.
+"""
+
+import argparse
+import os
+import sys
+import tempfile
+import zlib
+
+from common import (AddBuildDirArgument, FindPdfiumTest, MakeStream,
+                    MeasureRender, PrintErr, WritePdf)
+
+# Predictor names and their /Predictor values. For PNG predictors, the filter
+# type at the start of each row is what matters, and it is set to match.
+PREDICTORS = (('tiff', 2, None), ('sub', 11, 1), ('up', 12, 2),
+              ('average', 13, 3), ('paeth', 14, 4))
+
+COLOR_SPACES = {1: b'/DeviceGray', 3: b'/DeviceRGB', 4: b'/DeviceCMYK'}
+
+
+def MakeRows(size, colors, png_type):
+  """Returns predictor-encoded rows for a `size` by `size` image.
+
+  The decoder does the same work whatever the bytes are, so the rows are
+  just a compressible pattern.
+  """
+  row = bytes((i * 7) & 0xFF for i in range(size * colors))
+  if png_type is not None:
+    row = bytes([png_type]) + row
+  return row * size
+
+
+def WriteImagePdf(path, size, colors, predictor, png_type):
+  """Writes a one-page PDF showing a `size` by `size` image."""
+  samples = zlib.compress(MakeRows(size, colors, png_type))
+  contents = b'q 100 0 0 100 0 0 cm /Im0 Do Q'
+  objects = [
+      b'<< /Type /Catalog /Pages 2 0 R >>',
+      b'<< /Type /Pages /Kids [3 0 R] /Count 1 >>',
+      b'<< /Type /Page /Parent 2 0 R /MediaBox [0 0 100 100] '
+      b'/Resources << /XObject << /Im0 5 0 R >> >> /Contents 4 0 R >>',
+      MakeStream(contents),
+      MakeStream(
+          samples, b'/Type /XObject /Subtype /Image /Width %d /Height %d '
+          b'/ColorSpace %s /BitsPerComponent 8 /Filter /FlateDecode '
+          b'/DecodeParms << /Predictor %d /Colors %d /BitsPerComponent 8 '
+          b'/Columns %d >>' %
+          (size, size, COLOR_SPACES[colors], predictor, colors, size)),
+  ]
+  WritePdf(path, objects)
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  AddBuildDirArgument(parser)
+  parser.add_argument(
+      '--size',
+      type=int,
+      default=4000,
+      help='width and height of the images, in pixels')
+  parser.add_argument(
+      '--scale',
+      default='0.5',
+      help='scale passed to pdfium_test. Small values keep rasterization '
+      'cheap')
+  parser.add_argument(
+      '--repeats',
+      type=int,
+      default=3,
+      help='number of runs per image. The fastest run is reported')
+  args = parser.parse_args()
+
+  pdfium_test_path = FindPdfiumTest(args.build_dir)
+  if not pdfium_test_path:
+    return 1
+  if args.repeats < 1 or args.size < 1:
+    PrintErr('--repeats and --size must be positive.')
+    return 1
+
+  print('%12s  %8s  %s' % ('MB/s', 'seconds', 'image'))
+  with tempfile.TemporaryDirectory() as temp_dir:
+    for name, predictor, png_type in PREDICTORS:
+      for colors in sorted(COLOR_SPACES):
+        pdf_path = os.path.join(temp_dir, '%s_%d.pdf' % (name, colors))
+        WriteImagePdf(pdf_path, args.size, colors, predictor, png_type)
+        seconds = MeasureRender(pdfium_test_path, pdf_path, args.repeats,
+                                ['--scale=%s' % args.scale])
+        if seconds is None:
+          return 1
+        megabytes = args.size * args.size * colors / 1e6
+        print('%12.1f  %8.3f  %s, %d bpp' %
+              (megabytes / seconds, seconds, name, colors))
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
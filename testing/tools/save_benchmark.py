@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+# Copyright 2026 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Compares the size and speed of PDFs saved with different save flags.
+
+Saves a copy of every PDF in a corpus directory with pdfium_test --save-copy,
+once with the flags of the current writer and once with the flags under test
+(FPDF_COMPRESS_OBJECTS by default), and reports the size of each copy and the
+time saving took. Each copy is loaded again by pdfium_test, which checks that
+both copies render the same MD5 for every page. --threads compares saving on
+several threads against saving on one.
+"""
+
+import argparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+from common import (AddBuildDirArgument, FindPdfiumTest, FindPdfs, GetMd5s,
+                    PrintErr)
+
+# Flag values from public/fpdf_save.h.
+FPDF_NO_INCREMENTAL = 1 << 1
+FPDF_COMPRESS_OBJECTS = 1 << 4
+
+SAVED_COPY_RE = re.compile(rb'^Saved copy: (\d+) bytes in ([\d.]+) ms$')
+
+
+def RunPdfiumTest(pdfium_test_path, args):
+  result = subprocess.run([pdfium_test_path] + args,
+                          stdout=subprocess.PIPE,
+                          stderr=subprocess.DEVNULL)
+  if result.returncode != 0:
+    PrintErr('FAILURE: %s exited with %d' %
+             (' '.join([pdfium_test_path] + args), result.returncode))
+    return None
+  return result.stdout
+
+
+def Save(pdfium_test_path, pdf_path, flags, threads, repeats):
+  """Saves a copy of `pdf_path` with `flags` on `threads` threads `repeats`
+  times.
+
+  Returns the path of the copy, its size, and the fastest time taken to save,
+  in milliseconds.
+  """
+  size = None
+  times = []
+  for _ in range(repeats):
+    output = RunPdfiumTest(
+        pdfium_test_path,
+        [
+            '--save-copy=%d' % flags,
+            '--save-threads=%d' % threads, '--pages=0', '--scale=0.01', pdf_path
+        ])
+    if output is None:
+      return None, None, None
+    for line in output.splitlines():
+      match = SAVED_COPY_RE.match(line)
+      if match:
+        size = int(match.group(1))
+        times.append(float(match.group(2)))
+        break
+    else:
+      PrintErr('FAILURE: pdfium_test did not save a copy of %s' % pdf_path)
+      return None, None, None
+  return pdf_path + '.copy.pdf', size, min(times)
+
+
+def GetPageMd5s(pdfium_test_path, pdf_path):
+  output = RunPdfiumTest(pdfium_test_path, ['--ppm', '--md5', pdf_path])
+  if output is None:
+    return None
+  return GetMd5s(output)
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  parser.add_argument('corpus_dir', help='directory to search for PDFs')
+  AddBuildDirArgument(parser)
+  parser.add_argument(
+      '--baseline-flags',
+      type=int,
+      default=FPDF_NO_INCREMENTAL,
+      help='FPDF_SaveAsCopy() flags of the writer to compare against')
+  parser.add_argument(
+      '--flags',
+      type=int,
+      default=FPDF_NO_INCREMENTAL | FPDF_COMPRESS_OBJECTS,
+      help='FPDF_SaveAsCopy() flags under test')
+  parser.add_argument(
+      '--baseline-threads',
+      type=int,
+      default=1,
+      help='number of threads the writer to compare against saves on')
+  parser.add_argument(
+      '--threads',
+      type=int,
+      default=1,
+      help='number of threads to save on under test')
+  parser.add_argument(
+      '--repeats',
+      type=int,
+      default=3,
+      help='number of saves per file. The fastest save is reported')
+  args = parser.parse_args()
+
+  pdfium_test_path = FindPdfiumTest(args.build_dir)
+  if not pdfium_test_path:
+    return 1
+  if args.repeats < 1:
+    PrintErr('--repeats must be positive.')
+    return 1
+
+  pdf_paths = FindPdfs(args.corpus_dir)
+  if not pdf_paths:
+    PrintErr('FAILURE: No PDFs in %s' % args.corpus_dir)
+    return 1
+
+  print('%10s  %10s  %6s  %9s  %9s  %s' % ('baseline', 'bytes', 'ratio',
+                                          'base ms', 'ms', 'file'))
+  totals = [0, 0, 0.0, 0.0]
+  mismatches = 0
+  with tempfile.TemporaryDirectory() as temp_dir:
+    for pdf_path in pdf_paths:
+      # pdfium_test writes its output next to the PDF, so work on copies.
+      name = os.path.relpath(pdf_path, args.corpus_dir)
+      baseline_path = os.path.join(temp_dir, 'baseline.pdf')
+      test_path = os.path.join(temp_dir, 'test.pdf')
+      shutil.copyfile(pdf_path, baseline_path)
+      shutil.copyfile(pdf_path, test_path)
+
+      baseline_copy, baseline_size, baseline_ms = Save(
+          pdfium_test_path, baseline_path, args.baseline_flags,
+          args.baseline_threads, args.repeats)
+      test_copy, size, ms = Save(pdfium_test_path, test_path, args.flags,
+                                 args.threads, args.repeats)
+      if baseline_copy is None or test_copy is None:
+        return 1
+
+      status = ''
+      if (GetPageMd5s(pdfium_test_path, baseline_copy) != GetPageMd5s(
+          pdfium_test_path, test_copy)):
+        mismatches += 1
+        status = '  MISMATCH'
+      totals[0] += baseline_size
+      totals[1] += size
+      totals[2] += baseline_ms
+      totals[3] += ms
+      print('%10d  %10d  %5.1f%%  %9.3f  %9.3f  %s%s' %
+            (baseline_size, size, 100.0 * size / baseline_size, baseline_ms,
+             ms, name, status))
+
+  print('%10d  %10d  %5.1f%%  %9.3f  %9.3f  total' %
+        (totals[0], totals[1], 100.0 * totals[1] / totals[0], totals[2],
+         totals[3]))
+  if mismatches:
+    PrintErr('FAILURE: %d of %d files render differently once saved' %
+             (mismatches, len(pdf_paths)))
+    return 1
+  print('All %d files render identically once saved.' % len(pdf_paths))
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+# Copyright 2026 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures image resampling time when downscaling scanned pages.
+
+Generates synthetic PDFs, each with one page showing a letter-size image at
+300 dpi: one gray, one RGB, and one RGB with a soft mask. Renders each with
+pdfium_test at scales where the image is resampled from 1x down to 1/16 of
+its size, so the time goes mostly into CStretchEngine.
+"""
+
+import argparse
+import os
+import sys
+import tempfile
+import zlib
+
+from common import (AddBuildDirArgument, FindPdfiumTest, MakeStream,
+                    MeasureRender, PrintErr, WritePdf)
+
+# Letter size in points, and the resolution of the image.
+PAGE_WIDTH = 612
+PAGE_HEIGHT = 792
+IMAGE_DPI = 300
+
+# Image size relative to the source image, for each rendering.
+IMAGE_SCALES = (1, 2, 4, 8, 16)
+
+
+def MakeSamples(width, height, components):
+  """Returns `components` bytes per pixel of smooth gradients with detail."""
+  # Samples repeat every 256 rows, so only make those.
+  rows = []
+  for y in range(min(height, 256)):
+    row = bytearray(width * components)
+    for x in range(width):
+      for c in range(components):
+        row[x * components + c] = (x * (c + 1) + y * (3 - c) + (x ^ y)) & 0xFF
+    rows.append(bytes(row))
+  return b''.join(rows[y % 256] for y in range(height))
+
+
+def WriteImagePdf(path, width, height, components, soft_mask):
+  """Writes a one-page PDF showing a `width` by `height` image."""
+  color_space = b'/DeviceGray' if components == 1 else b'/DeviceRGB'
+  samples = zlib.compress(MakeSamples(width, height, components))
+  contents = b'q %d 0 0 %d 0 0 cm /Im0 Do Q' % (PAGE_WIDTH, PAGE_HEIGHT)
+
+  # Object 1 is the catalog, 2 the page tree, 3 the page, 4 the contents and
+  # 5 the image. The soft mask, if any, is object 6.
+  image_dict = (b'/Type /XObject /Subtype /Image /Width %d /Height %d '
+                b'/ColorSpace %s /BitsPerComponent 8 /Filter /FlateDecode' %
+                (width, height, color_space))
+  if soft_mask:
+    image_dict += b' /SMask 6 0 R'
+  objects = [
+      b'<< /Type /Catalog /Pages 2 0 R >>',
+      b'<< /Type /Pages /Kids [3 0 R] /Count 1 >>',
+      b'<< /Type /Page /Parent 2 0 R /MediaBox [0 0 %d %d] '
+      b'/Resources << /XObject << /Im0 5 0 R >> >> /Contents 4 0 R >>' %
+      (PAGE_WIDTH, PAGE_HEIGHT),
+      MakeStream(contents),
+      MakeStream(samples, image_dict),
+  ]
+  if soft_mask:
+    mask = zlib.compress(MakeSamples(width, height, 1))
+    objects.append(
+        MakeStream(
+            mask, b'/Type /XObject /Subtype /Image /Width %d /Height %d '
+            b'/ColorSpace /DeviceGray /BitsPerComponent 8 '
+            b'/Filter /FlateDecode' % (width, height)))
+  WritePdf(path, objects)
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  AddBuildDirArgument(parser)
+  parser.add_argument(
+      '--repeats',
+      type=int,
+      default=3,
+      help='number of runs per rendering. The fastest run is reported')
+  args = parser.parse_args()
+
+  pdfium_test_path = FindPdfiumTest(args.build_dir)
+  if not pdfium_test_path:
+    return 1
+  if args.repeats < 1:
+    PrintErr('--repeats must be positive.')
+    return 1
+
+  width = PAGE_WIDTH * IMAGE_DPI // 72
+  height = PAGE_HEIGHT * IMAGE_DPI // 72
+  with tempfile.TemporaryDirectory() as temp_dir:
+    pdfs = []
+    for name, components, soft_mask in (('gray', 1, False), ('rgb', 3, False),
+                                        ('rgba', 3, True)):
+      pdf_path = os.path.join(temp_dir, 'stretch_%s.pdf' % name)
+      WriteImagePdf(pdf_path, width, height, components, soft_mask)
+      pdfs.append((name, pdf_path))
+
+    print('%12s  %8s  %s' % ('seconds', 'scale', 'image'))
+    for name, pdf_path in pdfs:
+      for image_scale in IMAGE_SCALES:
+        # pdfium_test renders at 72 dpi for a scale of 1.
+        scale = IMAGE_DPI / 72 / image_scale
+        seconds = MeasureRender(pdfium_test_path, pdf_path, args.repeats,
+                                ['--scale=%s' % scale])
+        if seconds is None:
+          return 1
+        print('%12.3f  %8s  %s' % (seconds, '1/%d' % image_scale, name))
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
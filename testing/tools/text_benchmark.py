@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+# Copyright 2026 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures rendering time for a page densely filled with text.
+
+Generates a synthetic one-page PDF with the requested number of glyphs,
+spread over a few fonts and sizes, and renders it repeatedly with
+pdfium_test. After the first rendering every glyph is in the glyph cache, so
+the numbers are dominated by glyph cache lookups and glyph compositing.
+"""
+
+import argparse
+import os
+import sys
+import tempfile
+
+from common import (AddBuildDirArgument, FindPdfiumTest, MakeStream,
+                    MeasureRender, PrintErr, WritePdf)
+
+DEFAULT_GLYPH_COUNTS = [10000, 100000]
+FONTS = [b'Helvetica', b'Times-Roman', b'Courier']
+FONT_SIZES = [6, 8, 10, 12]
+PAGE_WIDTH = 612
+PAGE_HEIGHT = 792
+TEXT = b'The quick brown fox jumps over the lazy dog. 0123456789 '
+
+
+def WriteTextPdf(path, glyph_count):
+  """Writes a one-page PDF showing about `glyph_count` glyphs."""
+  chars_per_line = 100
+  lines = []
+  for i in range(max(glyph_count // chars_per_line, 1)):
+    font = i % len(FONTS)
+    size = FONT_SIZES[i % len(FONT_SIZES)]
+    y = PAGE_HEIGHT - 10 - (i * 3) % (PAGE_HEIGHT - 20)
+    line = (TEXT * (chars_per_line // len(TEXT) + 1))[:chars_per_line]
+    lines.append(b'BT /F%d %d Tf 10 %d Td (%s) Tj ET' % (font, size, y, line))
+  contents = b'\n'.join(lines)
+
+  font_resources = b' '.join(
+      b'/F%d %d 0 R' % (i, 5 + i) for i in range(len(FONTS)))
+  objects = [
+      b'<< /Type /Catalog /Pages 2 0 R >>',
+      b'<< /Type /Pages /Kids [3 0 R] /Count 1 >>',
+      b'<< /Type /Page /Parent 2 0 R /MediaBox [0 0 %d %d] '
+      b'/Resources << /Font << %s >> >> /Contents 4 0 R >>' %
+      (PAGE_WIDTH, PAGE_HEIGHT, font_resources),
+      MakeStream(contents),
+  ]
+  for font in FONTS:
+    objects.append(b'<< /Type /Font /Subtype /Type1 /BaseFont /%s >>' % font)
+  WritePdf(path, objects)
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  AddBuildDirArgument(parser)
+  parser.add_argument(
+      '--glyphs',
+      type=int,
+      nargs='+',
+      default=DEFAULT_GLYPH_COUNTS,
+      help='glyph counts to measure')
+  parser.add_argument(
+      '--render-repeats',
+      type=int,
+      default=20,
+      help='number of times pdfium_test renders the page per run')
+  parser.add_argument(
+      '--repeats',
+      type=int,
+      default=3,
+      help='number of runs per document. The fastest run is reported')
+  parser.add_argument(
+      '--keep-dir', help='write the generated PDFs here and keep them')
+  args = parser.parse_args()
+
+  pdfium_test_path = FindPdfiumTest(args.build_dir)
+  if not pdfium_test_path:
+    return 1
+  if args.render_repeats < 1 or args.repeats < 1:
+    PrintErr('--render-repeats and --repeats must be positive.')
+    return 1
+
+  with tempfile.TemporaryDirectory() as temp_dir:
+    out_dir = args.keep_dir or temp_dir
+    os.makedirs(out_dir, exist_ok=True)
+    print('%12s %12s %16s' % ('glyphs', 'seconds', 'ms per render'))
+    for glyph_count in args.glyphs:
+      pdf_path = os.path.join(out_dir, 'text_%d.pdf' % glyph_count)
+      WriteTextPdf(pdf_path, glyph_count)
+      seconds = MeasureRender(
+          pdfium_test_path, pdf_path, args.repeats,
+          ['--pages=0', '--render-repeats=%d' % args.render_repeats])
+      if seconds is None:
+        return 1
+      print('%12d %12.3f %16.2f' %
+            (glyph_count, seconds, seconds * 1000 / args.render_repeats))
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
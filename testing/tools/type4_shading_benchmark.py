@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+# Copyright 2026 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures how fast shadings with PostScript calculator functions render.
+
+Generates synthetic PDFs, each with one page filled by an axial, radial or
+function-based shading whose colors come from a Type 4 function like the ones
+that Illustrator, InDesign and Ghostscript write: tint transforms, piecewise
+gradients with `ifelse`, and two-input functions. Renders each with
+pdfium_test at a large scale, so that the time goes mostly into evaluating the
+function, and reports the time per megapixel.
+"""
+
+import argparse
+import os
+import sys
+import tempfile
+
+from common import (AddBuildDirArgument, FindPdfiumTest, MakeStream,
+                    MeasureRender, PrintErr, WritePdf)
+
+# Name, color space, number of inputs and PostScript code of each function.
+FUNCTIONS = (
+    # Tint transform of a spot color into CMYK.
+    ('tint', b'/DeviceCMYK', 1,
+     b'{ dup 0.84 mul exch dup 0 mul exch dup 0.23 mul exch 0.06 mul }'),
+    # Two-segment gradient, as exported in place of a stitching function.
+    ('piecewise', b'/DeviceRGB', 1,
+     b'{ dup 0.5 le { 2 mul dup 1 exch sub exch 0 } '
+     b'{ 0.5 sub 2 mul dup 1 exch sub 0 3 1 roll } ifelse }'),
+    # Hue-like sweep with trigonometry.
+    ('trig', b'/DeviceRGB', 1,
+     b'{ 360 mul dup sin 1 add 2 div exch dup 120 add sin 1 add 2 div '
+     b'exch 240 add sin 1 add 2 div }'),
+    # Two-input function for function-based shadings.
+    ('2d', b'/DeviceRGB', 2,
+     b'{ 2 copy mul 3 1 roll 0.5 sub dup mul exch 0.5 sub dup mul add sqrt '
+     b'dup 360 mul sin 1 add 2 div }'),
+)
+
+
+def MakeShading(shading_type, color_space, function_ref):
+  """Returns the shading dictionary for a 100 by 100 page."""
+  if shading_type == 1:
+    return (b'<< /ShadingType 1 /ColorSpace %s /Domain [0 1 0 1] '
+            b'/Matrix [100 0 0 100 0 0] /Function %s >>' %
+            (color_space, function_ref))
+  if shading_type == 2:
+    coords = b'[0 0 100 100]'
+  else:
+    coords = b'[50 50 0 50 50 70]'
+  return (b'<< /ShadingType %d /ColorSpace %s /Coords %s /Domain [0 1] '
+          b'/Extend [true true] /Function %s >>' %
+          (shading_type, color_space, coords, function_ref))
+
+
+def WriteShadingPdf(path, shading_type, color_space, inputs, code):
+  """Writes a one-page PDF filled with one shading."""
+  contents = b'/Sh0 sh'
+  outputs = 4 if color_space == b'/DeviceCMYK' else 3
+  domain = b' '.join([b'0 1'] * inputs)
+  function_range = b' '.join([b'0 1'] * outputs)
+  objects = [
+      b'<< /Type /Catalog /Pages 2 0 R >>',
+      b'<< /Type /Pages /Kids [3 0 R] /Count 1 >>',
+      b'<< /Type /Page /Parent 2 0 R /MediaBox [0 0 100 100] '
+      b'/Resources << /Shading << /Sh0 5 0 R >> >> /Contents 4 0 R >>',
+      MakeStream(contents),
+      MakeShading(shading_type, color_space, b'6 0 R'),
+      MakeStream(
+          code, b'/FunctionType 4 /Domain [%s] /Range [%s]' %
+          (domain, function_range)),
+  ]
+  WritePdf(path, objects)
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  AddBuildDirArgument(parser)
+  parser.add_argument(
+      '--scale',
+      type=float,
+      default=30,
+      help='scale passed to pdfium_test. The page is 100 points square')
+  parser.add_argument(
+      '--repeats',
+      type=int,
+      default=3,
+      help='number of runs per shading. The fastest run is reported')
+  args = parser.parse_args()
+
+  pdfium_test_path = FindPdfiumTest(args.build_dir)
+  if not pdfium_test_path:
+    return 1
+  if args.repeats < 1 or args.scale <= 0:
+    PrintErr('--repeats and --scale must be positive.')
+    return 1
+
+  megapixels = (100 * args.scale)**2 / 1e6
+  print('%12s  %8s  %s' % ('ms/MP', 'seconds', 'shading'))
+  with tempfile.TemporaryDirectory() as temp_dir:
+    for name, color_space, inputs, code in FUNCTIONS:
+      shading_types = (1,) if inputs == 2 else (2, 3)
+      for shading_type in shading_types:
+        pdf_path = os.path.join(temp_dir, '%s_%d.pdf' % (name, shading_type))
+        WriteShadingPdf(pdf_path, shading_type, color_space, inputs, code)
+        seconds = MeasureRender(pdfium_test_path, pdf_path, args.repeats,
+                                ['--scale=%s' % args.scale])
+        if seconds is None:
+          return 1
+        print('%12.1f  %8.3f  %s, type %d' %
+              (seconds * 1000 / megapixels, seconds, name, shading_type))
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
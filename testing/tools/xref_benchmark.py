@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+# Copyright 2026 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures document open time and memory use for large object counts.
+
+Generates synthetic PDFs whose cross reference tables have the requested
+number of entries, opens each one with pdfium_test and reports the wall time
+and peak resident set size. Only the first page, which is tiny, is rendered,
+so the numbers are dominated by cross reference parsing and object lookup.
+
+Unix only, since peak memory comes from the rusage of the child process.
+"""
+
+import argparse
+import array
+import os
+import sys
+import tempfile
+
+from common import (AddBuildDirArgument, FindPdfiumTest, MakeStream, PrintErr,
+                    TimeFastest)
+
+DEFAULT_OBJECT_COUNTS = [10000, 1000000, 10000000]
+
+# Object 1 is the catalog, 2 the page tree, 3 the page and 4 its contents.
+# Filler objects follow.
+HEADER_OBJECTS = [
+    b'<< /Type /Catalog /Pages 2 0 R >>',
+    b'<< /Type /Pages /Kids [3 0 R] /Count 1 >>',
+    b'<< /Type /Page /Parent 2 0 R /MediaBox [0 0 100 100] '
+    b'/Contents 4 0 R >>',
+    MakeStream(b'0 0 1 rg 10 10 80 80 re f'),
+]
+
+
+def WriteSyntheticPdf(path, object_count, stride):
+  """Writes a PDF with `object_count` objects.
+
+  Filler objects are numbered `stride` apart, so a stride above 1 produces
+  sparse object numbers, with one cross reference subsection per object.
+  """
+  filler_count = max(object_count - len(HEADER_OBJECTS), 0)
+  header_offsets = array.array('q')
+  filler_offsets = array.array('q')
+  with open(path, 'wb') as f:
+    f.write(b'%PDF-1.7\n')
+    for i, body in enumerate(HEADER_OBJECTS):
+      header_offsets.append(f.tell())
+      f.write(b'%d 0 obj\n%s\nendobj\n' % (i + 1, body))
+    first_filler = len(HEADER_OBJECTS) + stride
+    for i in range(filler_count):
+      filler_offsets.append(f.tell())
+      f.write(b'%d 0 obj\n%d\nendobj\n' % (first_filler + i * stride, i))
+
+    xref_offset = f.tell()
+    f.write(b'xref\n0 1\n0000000000 65535 f\r\n')
+    if stride == 1:
+      _WriteSubsection(f, 1, header_offsets + filler_offsets)
+    else:
+      _WriteSubsection(f, 1, header_offsets)
+      for i, offset in enumerate(filler_offsets):
+        _WriteSubsection(f, first_filler + i * stride, [offset])
+    size = first_filler + (filler_count - 1) * stride + 1
+    f.write(b'trailer\n<< /Size %d /Root 1 0 R >>\n' % size)
+    f.write(b'startxref\n%d\n%%%%EOF\n' % xref_offset)
+
+
+def _WriteSubsection(f, start, offsets):
+  f.write(b'%d %d\n' % (start, len(offsets)))
+  f.write(b''.join(b'%010d 00000 n\r\n' % offset for offset in offsets))
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  AddBuildDirArgument(parser)
+  parser.add_argument(
+      '--objects',
+      type=int,
+      nargs='+',
+      default=DEFAULT_OBJECT_COUNTS,
+      help='object counts to measure')
+  parser.add_argument(
+      '--stride',
+      type=int,
+      default=1,
+      help='distance between filler object numbers. Values above 1 produce '
+      'sparse cross reference tables')
+  parser.add_argument(
+      '--repeats',
+      type=int,
+      default=3,
+      help='number of runs per document. The fastest run is reported')
+  parser.add_argument(
+      '--keep-dir', help='write the generated PDFs here and keep them')
+  args = parser.parse_args()
+
+  pdfium_test_path = FindPdfiumTest(args.build_dir)
+  if not pdfium_test_path:
+    return 1
+  if args.stride < 1 or args.repeats < 1:
+    PrintErr('--stride and --repeats must be positive.')
+    return 1
+
+  with tempfile.TemporaryDirectory() as temp_dir:
+    out_dir = args.keep_dir or temp_dir
+    os.makedirs(out_dir, exist_ok=True)
+    print('%12s %12s %12s' % ('objects', 'seconds', 'peak KiB'))
+    for object_count in args.objects:
+      pdf_path = os.path.join(out_dir,
+                              'xref_%d_%d.pdf' % (object_count, args.stride))
+      WriteSyntheticPdf(pdf_path, object_count, args.stride)
+      result = TimeFastest([pdfium_test_path, '--pages=0', pdf_path],
+                           args.repeats)
+      if result is None:
+        return 1
+      seconds, _, peak_kib = result
+      print('%12d %12.3f %12d' % (object_count, seconds, peak_kib))
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -0,0 +1,9 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// An empty list of ThreadSanitizer suppressions, used in place of Chromium's
+// list when `pdf_use_tsan_suppressions = false`. See the "Thread Sanitizer"
+// section of README.md.
+
+char kTSanDefaultSuppressions[] = "# End of suppressions.\n";